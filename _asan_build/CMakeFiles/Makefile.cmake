@@ -0,0 +1,217 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/src/bin/CMakeLists.txt"
+  "/root/repo/src/bin/msquic-config.cmake.in"
+  "/root/repo/src/core/CMakeLists.txt"
+  "/root/repo/src/core/benchmark/CMakeLists.txt"
+  "/root/repo/src/core/unittest/CMakeLists.txt"
+  "/root/repo/src/inc/CMakeLists.txt"
+  "/root/repo/src/perf/bin/CMakeLists.txt"
+  "/root/repo/src/perf/lib/CMakeLists.txt"
+  "/root/repo/src/platform/CMakeLists.txt"
+  "/root/repo/src/platform/unittest/CMakeLists.txt"
+  "/root/repo/src/test/bin/CMakeLists.txt"
+  "/root/repo/src/test/lib/CMakeLists.txt"
+  "/root/repo/src/tools/CMakeLists.txt"
+  "/root/repo/src/tools/attack/CMakeLists.txt"
+  "/root/repo/src/tools/interop/CMakeLists.txt"
+  "/root/repo/src/tools/interopserver/CMakeLists.txt"
+  "/root/repo/src/tools/ip/client/CMakeLists.txt"
+  "/root/repo/src/tools/ip/server/CMakeLists.txt"
+  "/root/repo/src/tools/pcp/CMakeLists.txt"
+  "/root/repo/src/tools/ping/CMakeLists.txt"
+  "/root/repo/src/tools/post/CMakeLists.txt"
+  "/root/repo/src/tools/reach/CMakeLists.txt"
+  "/root/repo/src/tools/ring/CMakeLists.txt"
+  "/root/repo/src/tools/sample/CMakeLists.txt"
+  "/root/repo/src/tools/spin/CMakeLists.txt"
+  "/root/repo/submodules/googletest/CMakeLists.txt"
+  "/root/repo/submodules/googletest/googletest/CMakeLists.txt"
+  "/root/repo/submodules/googletest/googletest/cmake/internal_utils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCCompilerABI.c"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompilerABI.cpp"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCompilerIdDetection.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompileFeatures.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerABI.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerId.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitIncludeInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseLibraryArchitecture.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCompilerCommon.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ADSP-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMCC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/AppleClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Borland-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Bruce-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompilerInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Comeau-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Cray-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Embarcadero-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Fujitsu-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/FujitsuClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GHS-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-FindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IAR-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-C-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-CXX-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Intel-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IntelLLVM-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/MSVC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVHPC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVIDIA-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/OpenWatcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PGI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PathScale-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SCO-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SDCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Tasking-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TinyCC-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Watcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-C-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/FeatureTesting.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-Determine-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/inc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/core/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/platform/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "msquic-config.cmake"
+  "src/bin/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/attack/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/interop/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/interopserver/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/ip/client/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/ip/server/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/pcp/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/ping/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/post/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/reach/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/sample/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/spin/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/tools/ring/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/perf/lib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/perf/bin/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/core/benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "submodules/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "submodules/googletest/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/core/unittest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/platform/unittest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/test/lib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/test/bin/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  "src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  "src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "src/tools/attack/CMakeFiles/quicattack.dir/DependInfo.cmake"
+  "src/tools/interop/CMakeFiles/quicinterop.dir/DependInfo.cmake"
+  "src/tools/interopserver/CMakeFiles/quicinteropserver.dir/DependInfo.cmake"
+  "src/tools/ip/client/CMakeFiles/quicipclient.dir/DependInfo.cmake"
+  "src/tools/ip/server/CMakeFiles/quicipserver.dir/DependInfo.cmake"
+  "src/tools/pcp/CMakeFiles/quicpcp.dir/DependInfo.cmake"
+  "src/tools/ping/CMakeFiles/quicping.dir/DependInfo.cmake"
+  "src/tools/post/CMakeFiles/quicpost.dir/DependInfo.cmake"
+  "src/tools/reach/CMakeFiles/quicreach.dir/DependInfo.cmake"
+  "src/tools/sample/CMakeFiles/quicsample.dir/DependInfo.cmake"
+  "src/tools/spin/CMakeFiles/spinquic.dir/DependInfo.cmake"
+  "src/tools/ring/CMakeFiles/quicring.dir/DependInfo.cmake"
+  "src/perf/lib/CMakeFiles/perflib.dir/DependInfo.cmake"
+  "src/perf/bin/CMakeFiles/quicperf.dir/DependInfo.cmake"
+  "src/perf/bin/CMakeFiles/quicperfsuite.dir/DependInfo.cmake"
+  "src/core/benchmark/CMakeFiles/msquiccorebench.dir/DependInfo.cmake"
+  "submodules/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "submodules/googletest/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "src/core/unittest/CMakeFiles/msquiccoretest.dir/DependInfo.cmake"
+  "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/DependInfo.cmake"
+  "src/test/lib/CMakeFiles/testlib.dir/DependInfo.cmake"
+  "src/test/bin/CMakeFiles/msquictest.dir/DependInfo.cmake"
+  )
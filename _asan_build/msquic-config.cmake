@@ -0,0 +1,4 @@
+include(CMakeFindDependencyMacro)
+get_filename_component(SELF_DIR "${CMAKE_CURRENT_LIST_FILE}" PATH)
+
+include(${SELF_DIR}/msquic.cmake)
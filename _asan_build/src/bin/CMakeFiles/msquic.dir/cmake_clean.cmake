@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/Debug/libmsquic.pdb"
+  "../../bin/Debug/libmsquic.so"
+  "CMakeFiles/msquic.dir/linux/init.c.o"
+  "CMakeFiles/msquic.dir/linux/init.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/msquic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
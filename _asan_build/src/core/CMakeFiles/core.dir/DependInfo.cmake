@@ -0,0 +1,54 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/core/ack_tracker.c" "src/core/CMakeFiles/core.dir/ack_tracker.c.o" "gcc" "src/core/CMakeFiles/core.dir/ack_tracker.c.o.d"
+  "/root/repo/src/core/admission.c" "src/core/CMakeFiles/core.dir/admission.c.o" "gcc" "src/core/CMakeFiles/core.dir/admission.c.o.d"
+  "/root/repo/src/core/api.c" "src/core/CMakeFiles/core.dir/api.c.o" "gcc" "src/core/CMakeFiles/core.dir/api.c.o.d"
+  "/root/repo/src/core/binding.c" "src/core/CMakeFiles/core.dir/binding.c.o" "gcc" "src/core/CMakeFiles/core.dir/binding.c.o.d"
+  "/root/repo/src/core/configuration.c" "src/core/CMakeFiles/core.dir/configuration.c.o" "gcc" "src/core/CMakeFiles/core.dir/configuration.c.o.d"
+  "/root/repo/src/core/congestion_control.c" "src/core/CMakeFiles/core.dir/congestion_control.c.o" "gcc" "src/core/CMakeFiles/core.dir/congestion_control.c.o.d"
+  "/root/repo/src/core/connection.c" "src/core/CMakeFiles/core.dir/connection.c.o" "gcc" "src/core/CMakeFiles/core.dir/connection.c.o.d"
+  "/root/repo/src/core/crypto.c" "src/core/CMakeFiles/core.dir/crypto.c.o" "gcc" "src/core/CMakeFiles/core.dir/crypto.c.o.d"
+  "/root/repo/src/core/crypto_tls.c" "src/core/CMakeFiles/core.dir/crypto_tls.c.o" "gcc" "src/core/CMakeFiles/core.dir/crypto_tls.c.o.d"
+  "/root/repo/src/core/datagram.c" "src/core/CMakeFiles/core.dir/datagram.c.o" "gcc" "src/core/CMakeFiles/core.dir/datagram.c.o.d"
+  "/root/repo/src/core/frame.c" "src/core/CMakeFiles/core.dir/frame.c.o" "gcc" "src/core/CMakeFiles/core.dir/frame.c.o.d"
+  "/root/repo/src/core/inline.c" "src/core/CMakeFiles/core.dir/inline.c.o" "gcc" "src/core/CMakeFiles/core.dir/inline.c.o.d"
+  "/root/repo/src/core/library.c" "src/core/CMakeFiles/core.dir/library.c.o" "gcc" "src/core/CMakeFiles/core.dir/library.c.o.d"
+  "/root/repo/src/core/listener.c" "src/core/CMakeFiles/core.dir/listener.c.o" "gcc" "src/core/CMakeFiles/core.dir/listener.c.o.d"
+  "/root/repo/src/core/lookup.c" "src/core/CMakeFiles/core.dir/lookup.c.o" "gcc" "src/core/CMakeFiles/core.dir/lookup.c.o.d"
+  "/root/repo/src/core/loss_detection.c" "src/core/CMakeFiles/core.dir/loss_detection.c.o" "gcc" "src/core/CMakeFiles/core.dir/loss_detection.c.o.d"
+  "/root/repo/src/core/operation.c" "src/core/CMakeFiles/core.dir/operation.c.o" "gcc" "src/core/CMakeFiles/core.dir/operation.c.o.d"
+  "/root/repo/src/core/packet.c" "src/core/CMakeFiles/core.dir/packet.c.o" "gcc" "src/core/CMakeFiles/core.dir/packet.c.o.d"
+  "/root/repo/src/core/packet_builder.c" "src/core/CMakeFiles/core.dir/packet_builder.c.o" "gcc" "src/core/CMakeFiles/core.dir/packet_builder.c.o.d"
+  "/root/repo/src/core/packet_space.c" "src/core/CMakeFiles/core.dir/packet_space.c.o" "gcc" "src/core/CMakeFiles/core.dir/packet_space.c.o.d"
+  "/root/repo/src/core/path.c" "src/core/CMakeFiles/core.dir/path.c.o" "gcc" "src/core/CMakeFiles/core.dir/path.c.o.d"
+  "/root/repo/src/core/range.c" "src/core/CMakeFiles/core.dir/range.c.o" "gcc" "src/core/CMakeFiles/core.dir/range.c.o.d"
+  "/root/repo/src/core/recv_buffer.c" "src/core/CMakeFiles/core.dir/recv_buffer.c.o" "gcc" "src/core/CMakeFiles/core.dir/recv_buffer.c.o.d"
+  "/root/repo/src/core/registration.c" "src/core/CMakeFiles/core.dir/registration.c.o" "gcc" "src/core/CMakeFiles/core.dir/registration.c.o.d"
+  "/root/repo/src/core/replay_filter.c" "src/core/CMakeFiles/core.dir/replay_filter.c.o" "gcc" "src/core/CMakeFiles/core.dir/replay_filter.c.o.d"
+  "/root/repo/src/core/send.c" "src/core/CMakeFiles/core.dir/send.c.o" "gcc" "src/core/CMakeFiles/core.dir/send.c.o.d"
+  "/root/repo/src/core/send_buffer.c" "src/core/CMakeFiles/core.dir/send_buffer.c.o" "gcc" "src/core/CMakeFiles/core.dir/send_buffer.c.o.d"
+  "/root/repo/src/core/sent_packet_metadata.c" "src/core/CMakeFiles/core.dir/sent_packet_metadata.c.o" "gcc" "src/core/CMakeFiles/core.dir/sent_packet_metadata.c.o.d"
+  "/root/repo/src/core/settings.c" "src/core/CMakeFiles/core.dir/settings.c.o" "gcc" "src/core/CMakeFiles/core.dir/settings.c.o.d"
+  "/root/repo/src/core/stream.c" "src/core/CMakeFiles/core.dir/stream.c.o" "gcc" "src/core/CMakeFiles/core.dir/stream.c.o.d"
+  "/root/repo/src/core/stream_recv.c" "src/core/CMakeFiles/core.dir/stream_recv.c.o" "gcc" "src/core/CMakeFiles/core.dir/stream_recv.c.o.d"
+  "/root/repo/src/core/stream_send.c" "src/core/CMakeFiles/core.dir/stream_send.c.o" "gcc" "src/core/CMakeFiles/core.dir/stream_send.c.o.d"
+  "/root/repo/src/core/stream_set.c" "src/core/CMakeFiles/core.dir/stream_set.c.o" "gcc" "src/core/CMakeFiles/core.dir/stream_set.c.o.d"
+  "/root/repo/src/core/timer_wheel.c" "src/core/CMakeFiles/core.dir/timer_wheel.c.o" "gcc" "src/core/CMakeFiles/core.dir/timer_wheel.c.o.d"
+  "/root/repo/src/core/version_neg.c" "src/core/CMakeFiles/core.dir/version_neg.c.o" "gcc" "src/core/CMakeFiles/core.dir/version_neg.c.o.d"
+  "/root/repo/src/core/worker.c" "src/core/CMakeFiles/core.dir/worker.c.o" "gcc" "src/core/CMakeFiles/core.dir/worker.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,81 @@
+file(REMOVE_RECURSE
+  "../../obj/Debug/libcore.a"
+  "../../obj/Debug/libcore.pdb"
+  "CMakeFiles/core.dir/ack_tracker.c.o"
+  "CMakeFiles/core.dir/ack_tracker.c.o.d"
+  "CMakeFiles/core.dir/admission.c.o"
+  "CMakeFiles/core.dir/admission.c.o.d"
+  "CMakeFiles/core.dir/api.c.o"
+  "CMakeFiles/core.dir/api.c.o.d"
+  "CMakeFiles/core.dir/binding.c.o"
+  "CMakeFiles/core.dir/binding.c.o.d"
+  "CMakeFiles/core.dir/configuration.c.o"
+  "CMakeFiles/core.dir/configuration.c.o.d"
+  "CMakeFiles/core.dir/congestion_control.c.o"
+  "CMakeFiles/core.dir/congestion_control.c.o.d"
+  "CMakeFiles/core.dir/connection.c.o"
+  "CMakeFiles/core.dir/connection.c.o.d"
+  "CMakeFiles/core.dir/crypto.c.o"
+  "CMakeFiles/core.dir/crypto.c.o.d"
+  "CMakeFiles/core.dir/crypto_tls.c.o"
+  "CMakeFiles/core.dir/crypto_tls.c.o.d"
+  "CMakeFiles/core.dir/datagram.c.o"
+  "CMakeFiles/core.dir/datagram.c.o.d"
+  "CMakeFiles/core.dir/frame.c.o"
+  "CMakeFiles/core.dir/frame.c.o.d"
+  "CMakeFiles/core.dir/inline.c.o"
+  "CMakeFiles/core.dir/inline.c.o.d"
+  "CMakeFiles/core.dir/library.c.o"
+  "CMakeFiles/core.dir/library.c.o.d"
+  "CMakeFiles/core.dir/listener.c.o"
+  "CMakeFiles/core.dir/listener.c.o.d"
+  "CMakeFiles/core.dir/lookup.c.o"
+  "CMakeFiles/core.dir/lookup.c.o.d"
+  "CMakeFiles/core.dir/loss_detection.c.o"
+  "CMakeFiles/core.dir/loss_detection.c.o.d"
+  "CMakeFiles/core.dir/operation.c.o"
+  "CMakeFiles/core.dir/operation.c.o.d"
+  "CMakeFiles/core.dir/packet.c.o"
+  "CMakeFiles/core.dir/packet.c.o.d"
+  "CMakeFiles/core.dir/packet_builder.c.o"
+  "CMakeFiles/core.dir/packet_builder.c.o.d"
+  "CMakeFiles/core.dir/packet_space.c.o"
+  "CMakeFiles/core.dir/packet_space.c.o.d"
+  "CMakeFiles/core.dir/path.c.o"
+  "CMakeFiles/core.dir/path.c.o.d"
+  "CMakeFiles/core.dir/range.c.o"
+  "CMakeFiles/core.dir/range.c.o.d"
+  "CMakeFiles/core.dir/recv_buffer.c.o"
+  "CMakeFiles/core.dir/recv_buffer.c.o.d"
+  "CMakeFiles/core.dir/registration.c.o"
+  "CMakeFiles/core.dir/registration.c.o.d"
+  "CMakeFiles/core.dir/replay_filter.c.o"
+  "CMakeFiles/core.dir/replay_filter.c.o.d"
+  "CMakeFiles/core.dir/send.c.o"
+  "CMakeFiles/core.dir/send.c.o.d"
+  "CMakeFiles/core.dir/send_buffer.c.o"
+  "CMakeFiles/core.dir/send_buffer.c.o.d"
+  "CMakeFiles/core.dir/sent_packet_metadata.c.o"
+  "CMakeFiles/core.dir/sent_packet_metadata.c.o.d"
+  "CMakeFiles/core.dir/settings.c.o"
+  "CMakeFiles/core.dir/settings.c.o.d"
+  "CMakeFiles/core.dir/stream.c.o"
+  "CMakeFiles/core.dir/stream.c.o.d"
+  "CMakeFiles/core.dir/stream_recv.c.o"
+  "CMakeFiles/core.dir/stream_recv.c.o.d"
+  "CMakeFiles/core.dir/stream_send.c.o"
+  "CMakeFiles/core.dir/stream_send.c.o.d"
+  "CMakeFiles/core.dir/stream_set.c.o"
+  "CMakeFiles/core.dir/stream_set.c.o.d"
+  "CMakeFiles/core.dir/timer_wheel.c.o"
+  "CMakeFiles/core.dir/timer_wheel.c.o.d"
+  "CMakeFiles/core.dir/version_neg.c.o"
+  "CMakeFiles/core.dir/version_neg.c.o.d"
+  "CMakeFiles/core.dir/worker.c.o"
+  "CMakeFiles/core.dir/worker.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
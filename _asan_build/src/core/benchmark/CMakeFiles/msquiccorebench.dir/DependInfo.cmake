@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/core/benchmark/CryptBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/CryptBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/CryptBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/FrameBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/FrameBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/FrameBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/HashtableBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/HashtableBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/HashtableBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/RangeBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/RangeBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/RangeBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/RecvBufferBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/RecvBufferBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/RecvBufferBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/TimerWheelBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/TimerWheelBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/TimerWheelBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/VarIntBench.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/VarIntBench.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/VarIntBench.cpp.o.d"
+  "/root/repo/src/core/benchmark/main.cpp" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/main.cpp.o" "gcc" "src/core/benchmark/CMakeFiles/msquiccorebench.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_asan_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  "/root/repo/_asan_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/msquiccorebench"
+  "../../../bin/Debug/msquiccorebench.pdb"
+  "CMakeFiles/msquiccorebench.dir/CryptBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/CryptBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/FrameBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/FrameBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/HashtableBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/HashtableBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/RangeBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/RangeBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/RecvBufferBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/RecvBufferBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/TimerWheelBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/TimerWheelBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/VarIntBench.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/VarIntBench.cpp.o.d"
+  "CMakeFiles/msquiccorebench.dir/main.cpp.o"
+  "CMakeFiles/msquiccorebench.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/msquiccorebench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/msquiccoretest"
+  "../../../bin/Debug/msquiccoretest.pdb"
+  "CMakeFiles/msquiccoretest.dir/AdmissionTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/AdmissionTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/FrameTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/FrameTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/LatencyHistogramTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/LatencyHistogramTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/OperationTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/OperationTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/PacketNumberTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/PacketNumberTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/PartitionTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/PartitionTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/RangeTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/RangeTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/RecvBufferTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/RecvBufferTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/ReplayFilterTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/ReplayFilterTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/SpinFrame.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/SpinFrame.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/StreamSetTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/StreamSetTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/TicketTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/TicketTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/TransportParamTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/TransportParamTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/VarIntTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/VarIntTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/VersionNegExtTest.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/VersionNegExtTest.cpp.o.d"
+  "CMakeFiles/msquiccoretest.dir/main.cpp.o"
+  "CMakeFiles/msquiccoretest.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/msquiccoretest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/perf/bin/histogram/hdr_histogram.c" "src/perf/bin/CMakeFiles/quicperf.dir/histogram/hdr_histogram.c.o" "gcc" "src/perf/bin/CMakeFiles/quicperf.dir/histogram/hdr_histogram.c.o.d"
+  "/root/repo/src/perf/bin/appmain.cpp" "src/perf/bin/CMakeFiles/quicperf.dir/appmain.cpp.o" "gcc" "src/perf/bin/CMakeFiles/quicperf.dir/appmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan_build/src/perf/lib/CMakeFiles/perflib.dir/DependInfo.cmake"
+  "/root/repo/_asan_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_asan_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicperf"
+  "../../../bin/Debug/quicperf.pdb"
+  "CMakeFiles/quicperf.dir/appmain.cpp.o"
+  "CMakeFiles/quicperf.dir/appmain.cpp.o.d"
+  "CMakeFiles/quicperf.dir/histogram/hdr_histogram.c.o"
+  "CMakeFiles/quicperf.dir/histogram/hdr_histogram.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/quicperf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
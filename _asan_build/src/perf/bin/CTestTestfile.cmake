@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/perf/bin
+# Build directory: /root/repo/_asan_build/src/perf/bin
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(quicperf_loopback_rps "/root/repo/_asan_build/bin/Debug/quicperf" "-test:rps" "-target:127.0.0.1" "-runtime:2000")
+set_tests_properties(quicperf_loopback_rps PROPERTIES  WORKING_DIRECTORY "/root/repo/_asan_build/bin/Debug" _BACKTRACE_TRIPLES "/root/repo/src/perf/bin/CMakeLists.txt;25;add_test;/root/repo/src/perf/bin/CMakeLists.txt;0;")
@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "../../../obj/Debug/libperflib.a"
+  "../../../obj/Debug/libperflib.pdb"
+  "CMakeFiles/perflib.dir/HpsClient.cpp.o"
+  "CMakeFiles/perflib.dir/HpsClient.cpp.o.d"
+  "CMakeFiles/perflib.dir/IdleClient.cpp.o"
+  "CMakeFiles/perflib.dir/IdleClient.cpp.o.d"
+  "CMakeFiles/perflib.dir/PerfServer.cpp.o"
+  "CMakeFiles/perflib.dir/PerfServer.cpp.o.d"
+  "CMakeFiles/perflib.dir/RpsClient.cpp.o"
+  "CMakeFiles/perflib.dir/RpsClient.cpp.o.d"
+  "CMakeFiles/perflib.dir/Tcp.cpp.o"
+  "CMakeFiles/perflib.dir/Tcp.cpp.o.d"
+  "CMakeFiles/perflib.dir/ThroughputClient.cpp.o"
+  "CMakeFiles/perflib.dir/ThroughputClient.cpp.o.d"
+  "CMakeFiles/perflib.dir/quicmain.cpp.o"
+  "CMakeFiles/perflib.dir/quicmain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/perflib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/platform/cert_stub.c" "src/platform/CMakeFiles/platform.dir/cert_stub.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/cert_stub.c.o.d"
+  "/root/repo/src/platform/datapath_loopback.c" "src/platform/CMakeFiles/platform.dir/datapath_loopback.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/datapath_loopback.c.o.d"
+  "/root/repo/src/platform/hashtable.c" "src/platform/CMakeFiles/platform.dir/hashtable.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/hashtable.c.o.d"
+  "/root/repo/src/platform/inline.c" "src/platform/CMakeFiles/platform.dir/inline.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/inline.c.o.d"
+  "/root/repo/src/platform/pcp.c" "src/platform/CMakeFiles/platform.dir/pcp.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/pcp.c.o.d"
+  "/root/repo/src/platform/platform_posix.c" "src/platform/CMakeFiles/platform.dir/platform_posix.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/platform_posix.c.o.d"
+  "/root/repo/src/platform/selfsign_stub.c" "src/platform/CMakeFiles/platform.dir/selfsign_stub.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/selfsign_stub.c.o.d"
+  "/root/repo/src/platform/storage_posix.c" "src/platform/CMakeFiles/platform.dir/storage_posix.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/storage_posix.c.o.d"
+  "/root/repo/src/platform/tls_stub.c" "src/platform/CMakeFiles/platform.dir/tls_stub.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/tls_stub.c.o.d"
+  "/root/repo/src/platform/toeplitz.c" "src/platform/CMakeFiles/platform.dir/toeplitz.c.o" "gcc" "src/platform/CMakeFiles/platform.dir/toeplitz.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
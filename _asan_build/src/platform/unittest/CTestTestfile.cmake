@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/platform/unittest
+# Build directory: /root/repo/_asan_build/src/platform/unittest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(msquicplatformtest "/root/repo/_asan_build/bin/Debug/msquicplatformtest")
+set_tests_properties(msquicplatformtest PROPERTIES  WORKING_DIRECTORY "/root/repo/_asan_build/bin/Debug" _BACKTRACE_TRIPLES "/root/repo/src/platform/unittest/CMakeLists.txt;24;add_test;/root/repo/src/platform/unittest/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/msquictest"
+  "../../../bin/Debug/msquictest.pdb"
+  "CMakeFiles/msquictest.dir/quic_gtest.cpp.o"
+  "CMakeFiles/msquictest.dir/quic_gtest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/msquictest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
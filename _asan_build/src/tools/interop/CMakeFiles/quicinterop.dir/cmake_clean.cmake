@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicinterop"
+  "../../../bin/Debug/quicinterop.pdb"
+  "CMakeFiles/quicinterop.dir/interop.cpp.o"
+  "CMakeFiles/quicinterop.dir/interop.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicinterop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../../bin/Debug/quicipclient"
+  "../../../../bin/Debug/quicipclient.pdb"
+  "CMakeFiles/quicipclient.dir/quicipclient.cpp.o"
+  "CMakeFiles/quicipclient.dir/quicipclient.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicipclient.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
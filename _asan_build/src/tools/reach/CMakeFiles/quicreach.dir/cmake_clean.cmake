@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicreach"
+  "../../../bin/Debug/quicreach.pdb"
+  "CMakeFiles/quicreach.dir/reach.cpp.o"
+  "CMakeFiles/quicreach.dir/reach.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicreach.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/tools/ring/main.c" "src/tools/ring/CMakeFiles/quicring.dir/main.c.o" "gcc" "src/tools/ring/CMakeFiles/quicring.dir/main.c.o.d"
+  "/root/repo/src/tools/ring/objects.c" "src/tools/ring/CMakeFiles/quicring.dir/objects.c.o" "gcc" "src/tools/ring/CMakeFiles/quicring.dir/objects.c.o.d"
+  "/root/repo/src/tools/ring/reader.c" "src/tools/ring/CMakeFiles/quicring.dir/reader.c.o" "gcc" "src/tools/ring/CMakeFiles/quicring.dir/reader.c.o.d"
+  "/root/repo/src/tools/ring/report.c" "src/tools/ring/CMakeFiles/quicring.dir/report.c.o" "gcc" "src/tools/ring/CMakeFiles/quicring.dir/report.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_asan_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_asan_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_qlog_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("src/inc")
+subdirs("src/core")
+subdirs("src/platform")
+subdirs("src/bin")
+subdirs("src/tools")
+subdirs("src/perf/lib")
+subdirs("src/perf/bin")
+subdirs("src/core/benchmark")
+subdirs("submodules/googletest")
+subdirs("src/core/unittest")
+subdirs("src/platform/unittest")
+subdirs("src/test/lib")
+subdirs("src/test/bin")
@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/core/unittest/AdmissionTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/AdmissionTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/AdmissionTest.cpp.o.d"
+  "/root/repo/src/core/unittest/FrameTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/FrameTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/FrameTest.cpp.o.d"
+  "/root/repo/src/core/unittest/LatencyHistogramTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/LatencyHistogramTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/LatencyHistogramTest.cpp.o.d"
+  "/root/repo/src/core/unittest/OperationTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/OperationTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/OperationTest.cpp.o.d"
+  "/root/repo/src/core/unittest/PacketNumberTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/PacketNumberTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/PacketNumberTest.cpp.o.d"
+  "/root/repo/src/core/unittest/PartitionTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/PartitionTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/PartitionTest.cpp.o.d"
+  "/root/repo/src/core/unittest/RangeTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/RangeTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/RangeTest.cpp.o.d"
+  "/root/repo/src/core/unittest/RecvBufferTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/RecvBufferTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/RecvBufferTest.cpp.o.d"
+  "/root/repo/src/core/unittest/ReplayFilterTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/ReplayFilterTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/ReplayFilterTest.cpp.o.d"
+  "/root/repo/src/core/unittest/SpinFrame.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/SpinFrame.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/SpinFrame.cpp.o.d"
+  "/root/repo/src/core/unittest/StreamSetTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/StreamSetTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/StreamSetTest.cpp.o.d"
+  "/root/repo/src/core/unittest/TicketTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/TicketTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/TicketTest.cpp.o.d"
+  "/root/repo/src/core/unittest/TransportParamTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/TransportParamTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/TransportParamTest.cpp.o.d"
+  "/root/repo/src/core/unittest/VarIntTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/VarIntTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/VarIntTest.cpp.o.d"
+  "/root/repo/src/core/unittest/VersionNegExtTest.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/VersionNegExtTest.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/VersionNegExtTest.cpp.o.d"
+  "/root/repo/src/core/unittest/main.cpp" "src/core/unittest/CMakeFiles/msquiccoretest.dir/main.cpp.o" "gcc" "src/core/unittest/CMakeFiles/msquiccoretest.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_qlog_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/submodules/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/core/unittest
+# Build directory: /root/repo/_qlog_build/src/core/unittest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(msquiccoretest "/root/repo/_qlog_build/bin/Debug/msquiccoretest")
+set_tests_properties(msquiccoretest PROPERTIES  WORKING_DIRECTORY "/root/repo/_qlog_build/bin/Debug" _BACKTRACE_TRIPLES "/root/repo/src/core/unittest/CMakeLists.txt;34;add_test;/root/repo/src/core/unittest/CMakeLists.txt;0;")
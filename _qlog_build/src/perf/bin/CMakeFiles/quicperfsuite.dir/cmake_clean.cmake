@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicperfsuite"
+  "../../../bin/Debug/quicperfsuite.pdb"
+  "CMakeFiles/quicperfsuite.dir/suitemain.cpp.o"
+  "CMakeFiles/quicperfsuite.dir/suitemain.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicperfsuite.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
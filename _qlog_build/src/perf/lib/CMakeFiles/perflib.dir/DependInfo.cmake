@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/perf/lib/HpsClient.cpp" "src/perf/lib/CMakeFiles/perflib.dir/HpsClient.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/HpsClient.cpp.o.d"
+  "/root/repo/src/perf/lib/IdleClient.cpp" "src/perf/lib/CMakeFiles/perflib.dir/IdleClient.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/IdleClient.cpp.o.d"
+  "/root/repo/src/perf/lib/PerfServer.cpp" "src/perf/lib/CMakeFiles/perflib.dir/PerfServer.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/PerfServer.cpp.o.d"
+  "/root/repo/src/perf/lib/RpsClient.cpp" "src/perf/lib/CMakeFiles/perflib.dir/RpsClient.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/RpsClient.cpp.o.d"
+  "/root/repo/src/perf/lib/Tcp.cpp" "src/perf/lib/CMakeFiles/perflib.dir/Tcp.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/Tcp.cpp.o.d"
+  "/root/repo/src/perf/lib/ThroughputClient.cpp" "src/perf/lib/CMakeFiles/perflib.dir/ThroughputClient.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/ThroughputClient.cpp.o.d"
+  "/root/repo/src/perf/lib/quicmain.cpp" "src/perf/lib/CMakeFiles/perflib.dir/quicmain.cpp.o" "gcc" "src/perf/lib/CMakeFiles/perflib.dir/quicmain.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
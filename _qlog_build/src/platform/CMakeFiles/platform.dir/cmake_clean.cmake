@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "../../obj/Debug/libplatform.a"
+  "../../obj/Debug/libplatform.pdb"
+  "CMakeFiles/platform.dir/cert_stub.c.o"
+  "CMakeFiles/platform.dir/cert_stub.c.o.d"
+  "CMakeFiles/platform.dir/datapath_epoll.c.o"
+  "CMakeFiles/platform.dir/datapath_epoll.c.o.d"
+  "CMakeFiles/platform.dir/hashtable.c.o"
+  "CMakeFiles/platform.dir/hashtable.c.o.d"
+  "CMakeFiles/platform.dir/inline.c.o"
+  "CMakeFiles/platform.dir/inline.c.o.d"
+  "CMakeFiles/platform.dir/pcp.c.o"
+  "CMakeFiles/platform.dir/pcp.c.o.d"
+  "CMakeFiles/platform.dir/platform_posix.c.o"
+  "CMakeFiles/platform.dir/platform_posix.c.o.d"
+  "CMakeFiles/platform.dir/selfsign_stub.c.o"
+  "CMakeFiles/platform.dir/selfsign_stub.c.o.d"
+  "CMakeFiles/platform.dir/storage_posix.c.o"
+  "CMakeFiles/platform.dir/storage_posix.c.o.d"
+  "CMakeFiles/platform.dir/tls_stub.c.o"
+  "CMakeFiles/platform.dir/tls_stub.c.o.d"
+  "CMakeFiles/platform.dir/toeplitz.c.o"
+  "CMakeFiles/platform.dir/toeplitz.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/platform.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,26 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/platform/unittest/CryptTest.cpp" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/CryptTest.cpp.o" "gcc" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/CryptTest.cpp.o.d"
+  "/root/repo/src/platform/unittest/DataPathTest.cpp" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/DataPathTest.cpp.o" "gcc" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/DataPathTest.cpp.o.d"
+  "/root/repo/src/platform/unittest/PlatformTest.cpp" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/PlatformTest.cpp.o" "gcc" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/PlatformTest.cpp.o.d"
+  "/root/repo/src/platform/unittest/TlsTest.cpp" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/TlsTest.cpp.o" "gcc" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/TlsTest.cpp.o.d"
+  "/root/repo/src/platform/unittest/main.cpp" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/main.cpp.o" "gcc" "src/platform/unittest/CMakeFiles/msquicplatformtest.dir/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_qlog_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/submodules/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
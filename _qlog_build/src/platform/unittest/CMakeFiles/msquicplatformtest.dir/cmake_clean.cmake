@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/msquicplatformtest"
+  "../../../bin/Debug/msquicplatformtest.pdb"
+  "CMakeFiles/msquicplatformtest.dir/CryptTest.cpp.o"
+  "CMakeFiles/msquicplatformtest.dir/CryptTest.cpp.o.d"
+  "CMakeFiles/msquicplatformtest.dir/DataPathTest.cpp.o"
+  "CMakeFiles/msquicplatformtest.dir/DataPathTest.cpp.o.d"
+  "CMakeFiles/msquicplatformtest.dir/PlatformTest.cpp.o"
+  "CMakeFiles/msquicplatformtest.dir/PlatformTest.cpp.o.d"
+  "CMakeFiles/msquicplatformtest.dir/TlsTest.cpp.o"
+  "CMakeFiles/msquicplatformtest.dir/TlsTest.cpp.o.d"
+  "CMakeFiles/msquicplatformtest.dir/main.cpp.o"
+  "CMakeFiles/msquicplatformtest.dir/main.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/msquicplatformtest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
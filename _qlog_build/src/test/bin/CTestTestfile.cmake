@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/test/bin
+# Build directory: /root/repo/_qlog_build/src/test/bin
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(msquictest "/root/repo/_qlog_build/bin/Debug/msquictest")
+set_tests_properties(msquictest PROPERTIES  WORKING_DIRECTORY "/root/repo/_qlog_build/bin/Debug" _BACKTRACE_TRIPLES "/root/repo/src/test/bin/CMakeLists.txt;20;add_test;/root/repo/src/test/bin/CMakeLists.txt;0;")
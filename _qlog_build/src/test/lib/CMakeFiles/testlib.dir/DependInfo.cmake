@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/test/lib/ApiTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/ApiTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/ApiTest.cpp.o.d"
+  "/root/repo/src/test/lib/BasicTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/BasicTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/BasicTest.cpp.o.d"
+  "/root/repo/src/test/lib/DataTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/DataTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/DataTest.cpp.o.d"
+  "/root/repo/src/test/lib/DatagramTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/DatagramTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/DatagramTest.cpp.o.d"
+  "/root/repo/src/test/lib/DrillDescriptor.cpp" "src/test/lib/CMakeFiles/testlib.dir/DrillDescriptor.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/DrillDescriptor.cpp.o.d"
+  "/root/repo/src/test/lib/EventTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/EventTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/EventTest.cpp.o.d"
+  "/root/repo/src/test/lib/HandshakeTest.cpp" "src/test/lib/CMakeFiles/testlib.dir/HandshakeTest.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/HandshakeTest.cpp.o.d"
+  "/root/repo/src/test/lib/QuicDrill.cpp" "src/test/lib/CMakeFiles/testlib.dir/QuicDrill.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/QuicDrill.cpp.o.d"
+  "/root/repo/src/test/lib/TestConnection.cpp" "src/test/lib/CMakeFiles/testlib.dir/TestConnection.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/TestConnection.cpp.o.d"
+  "/root/repo/src/test/lib/TestListener.cpp" "src/test/lib/CMakeFiles/testlib.dir/TestListener.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/TestListener.cpp.o.d"
+  "/root/repo/src/test/lib/TestStream.cpp" "src/test/lib/CMakeFiles/testlib.dir/TestStream.cpp.o" "gcc" "src/test/lib/CMakeFiles/testlib.dir/TestStream.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
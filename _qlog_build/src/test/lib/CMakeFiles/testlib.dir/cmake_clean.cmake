@@ -0,0 +1,31 @@
+file(REMOVE_RECURSE
+  "../../../obj/Debug/libtestlib.a"
+  "../../../obj/Debug/libtestlib.pdb"
+  "CMakeFiles/testlib.dir/ApiTest.cpp.o"
+  "CMakeFiles/testlib.dir/ApiTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/BasicTest.cpp.o"
+  "CMakeFiles/testlib.dir/BasicTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/DataTest.cpp.o"
+  "CMakeFiles/testlib.dir/DataTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/DatagramTest.cpp.o"
+  "CMakeFiles/testlib.dir/DatagramTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/DrillDescriptor.cpp.o"
+  "CMakeFiles/testlib.dir/DrillDescriptor.cpp.o.d"
+  "CMakeFiles/testlib.dir/EventTest.cpp.o"
+  "CMakeFiles/testlib.dir/EventTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/HandshakeTest.cpp.o"
+  "CMakeFiles/testlib.dir/HandshakeTest.cpp.o.d"
+  "CMakeFiles/testlib.dir/QuicDrill.cpp.o"
+  "CMakeFiles/testlib.dir/QuicDrill.cpp.o.d"
+  "CMakeFiles/testlib.dir/TestConnection.cpp.o"
+  "CMakeFiles/testlib.dir/TestConnection.cpp.o.d"
+  "CMakeFiles/testlib.dir/TestListener.cpp.o"
+  "CMakeFiles/testlib.dir/TestListener.cpp.o.d"
+  "CMakeFiles/testlib.dir/TestStream.cpp.o"
+  "CMakeFiles/testlib.dir/TestStream.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/testlib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,18 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/tools
+# Build directory: /root/repo/_qlog_build/src/tools
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("attack")
+subdirs("interop")
+subdirs("interopserver")
+subdirs("ip/client")
+subdirs("ip/server")
+subdirs("pcp")
+subdirs("ping")
+subdirs("post")
+subdirs("reach")
+subdirs("sample")
+subdirs("spin")
+subdirs("ring")
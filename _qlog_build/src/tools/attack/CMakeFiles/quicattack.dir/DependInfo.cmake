@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/tools/attack/attack.cpp" "src/tools/attack/CMakeFiles/quicattack.dir/attack.cpp.o" "gcc" "src/tools/attack/CMakeFiles/quicattack.dir/attack.cpp.o.d"
+  "/root/repo/src/tools/attack/packet_writer.cpp" "src/tools/attack/CMakeFiles/quicattack.dir/packet_writer.cpp.o" "gcc" "src/tools/attack/CMakeFiles/quicattack.dir/packet_writer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_qlog_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/core/CMakeFiles/core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
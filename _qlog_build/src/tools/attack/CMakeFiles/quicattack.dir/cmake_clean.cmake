@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicattack"
+  "../../../bin/Debug/quicattack.pdb"
+  "CMakeFiles/quicattack.dir/attack.cpp.o"
+  "CMakeFiles/quicattack.dir/attack.cpp.o.d"
+  "CMakeFiles/quicattack.dir/packet_writer.cpp.o"
+  "CMakeFiles/quicattack.dir/packet_writer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicattack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicinteropserver"
+  "../../../bin/Debug/quicinteropserver.pdb"
+  "CMakeFiles/quicinteropserver.dir/InteropServer.cpp.o"
+  "CMakeFiles/quicinteropserver.dir/InteropServer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicinteropserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../../bin/Debug/quicipserver"
+  "../../../../bin/Debug/quicipserver.pdb"
+  "CMakeFiles/quicipserver.dir/quicipserver.cpp.o"
+  "CMakeFiles/quicipserver.dir/quicipserver.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicipserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
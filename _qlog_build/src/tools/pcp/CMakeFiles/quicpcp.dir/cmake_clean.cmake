@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicpcp"
+  "../../../bin/Debug/quicpcp.pdb"
+  "CMakeFiles/quicpcp.dir/pcp.cpp.o"
+  "CMakeFiles/quicpcp.dir/pcp.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicpcp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
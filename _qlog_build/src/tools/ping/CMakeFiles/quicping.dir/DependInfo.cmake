@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/tools/ping/Client.cpp" "src/tools/ping/CMakeFiles/quicping.dir/Client.cpp.o" "gcc" "src/tools/ping/CMakeFiles/quicping.dir/Client.cpp.o.d"
+  "/root/repo/src/tools/ping/PingConnection.cpp" "src/tools/ping/CMakeFiles/quicping.dir/PingConnection.cpp.o" "gcc" "src/tools/ping/CMakeFiles/quicping.dir/PingConnection.cpp.o.d"
+  "/root/repo/src/tools/ping/PingStream.cpp" "src/tools/ping/CMakeFiles/quicping.dir/PingStream.cpp.o" "gcc" "src/tools/ping/CMakeFiles/quicping.dir/PingStream.cpp.o.d"
+  "/root/repo/src/tools/ping/QuicPing.cpp" "src/tools/ping/CMakeFiles/quicping.dir/QuicPing.cpp.o" "gcc" "src/tools/ping/CMakeFiles/quicping.dir/QuicPing.cpp.o.d"
+  "/root/repo/src/tools/ping/Server.cpp" "src/tools/ping/CMakeFiles/quicping.dir/Server.cpp.o" "gcc" "src/tools/ping/CMakeFiles/quicping.dir/Server.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_qlog_build/src/bin/CMakeFiles/msquic.dir/DependInfo.cmake"
+  "/root/repo/_qlog_build/src/platform/CMakeFiles/platform.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicping"
+  "../../../bin/Debug/quicping.pdb"
+  "CMakeFiles/quicping.dir/Client.cpp.o"
+  "CMakeFiles/quicping.dir/Client.cpp.o.d"
+  "CMakeFiles/quicping.dir/PingConnection.cpp.o"
+  "CMakeFiles/quicping.dir/PingConnection.cpp.o.d"
+  "CMakeFiles/quicping.dir/PingStream.cpp.o"
+  "CMakeFiles/quicping.dir/PingStream.cpp.o.d"
+  "CMakeFiles/quicping.dir/QuicPing.cpp.o"
+  "CMakeFiles/quicping.dir/QuicPing.cpp.o.d"
+  "CMakeFiles/quicping.dir/Server.cpp.o"
+  "CMakeFiles/quicping.dir/Server.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicping.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicpost"
+  "../../../bin/Debug/quicpost.pdb"
+  "CMakeFiles/quicpost.dir/post.cpp.o"
+  "CMakeFiles/quicpost.dir/post.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicpost.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicring"
+  "../../../bin/Debug/quicring.pdb"
+  "CMakeFiles/quicring.dir/main.c.o"
+  "CMakeFiles/quicring.dir/main.c.o.d"
+  "CMakeFiles/quicring.dir/objects.c.o"
+  "CMakeFiles/quicring.dir/objects.c.o.d"
+  "CMakeFiles/quicring.dir/reader.c.o"
+  "CMakeFiles/quicring.dir/reader.c.o.d"
+  "CMakeFiles/quicring.dir/report.c.o"
+  "CMakeFiles/quicring.dir/report.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/quicring.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
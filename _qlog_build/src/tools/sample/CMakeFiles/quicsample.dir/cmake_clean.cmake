@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/quicsample"
+  "../../../bin/Debug/quicsample.pdb"
+  "CMakeFiles/quicsample.dir/sample.cpp.o"
+  "CMakeFiles/quicsample.dir/sample.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quicsample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../bin/Debug/spinquic"
+  "../../../bin/Debug/spinquic.pdb"
+  "CMakeFiles/spinquic.dir/spinquic.cpp.o"
+  "CMakeFiles/spinquic.dir/spinquic.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/spinquic.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/submodules/googletest
+# Build directory: /root/repo/_qlog_build/submodules/googletest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("googletest")
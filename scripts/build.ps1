@@ -81,6 +81,15 @@ This script provides helpers for building msquic.
 .PARAMETER EnableTelemetryAsserts
     Enables telemetry asserts in release builds.
 
+.PARAMETER LoopbackDatapath
+    Replaces the OS sockets with an in-process loopback datapath.
+
+.PARAMETER RingTracing
+    Records events into in-memory per-thread ring buffers (Linux only).
+
+.PARAMETER Qlog
+    Enables writing qlog files of connection events.
+
 .EXAMPLE
     build.ps1
 
@@ -167,7 +176,16 @@ param (
     [switch]$TlsSecretsSupport = $false,
 
     [Parameter(Mandatory = $false)]
-    [switch]$EnableTelemetryAsserts = $false
+    [switch]$EnableTelemetryAsserts = $false,
+
+    [Parameter(Mandatory = $false)]
+    [switch]$LoopbackDatapath = $false,
+
+    [Parameter(Mandatory = $false)]
+    [switch]$RingTracing = $false,
+
+    [Parameter(Mandatory = $false)]
+    [switch]$Qlog = $false
 )
 
 Set-StrictMode -Version 'Latest'
@@ -339,6 +357,15 @@ function CMake-Generate {
     if ($EnableTelemetryAsserts) {
         $Arguments += " -DQUIC_TELEMETRY_ASSERTS=on"
     }
+    if ($LoopbackDatapath) {
+        $Arguments += " -DQUIC_LOOPBACK_DATAPATH=on"
+    }
+    if ($RingTracing) {
+        $Arguments += " -DQUIC_ENABLE_RING_TRACING=on"
+    }
+    if ($Qlog) {
+        $Arguments += " -DQUIC_ENABLE_QLOG=on"
+    }
     $Arguments += " ../../.."
 
     CMake-Execute $Arguments
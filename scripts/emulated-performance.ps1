@@ -3,7 +3,7 @@
 .SYNOPSIS
 This script runs performance tests with various emulated network conditions. Note,
 this script requires duonic to be preinstalled on the system and quicperf.exe to
-be in the current directory.
+be in the current directory, unless -Loopback is used.
 
 .PARAMETER Config
     Specifies the build configuration to test.
@@ -43,6 +43,28 @@ be in the current directory.
 .PARAMETER NumIterations
     The number(s) of iterations to run of each test over the emulated network.
 
+.PARAMETER Loopback
+    Emulates the network inside a single quicperf process, using the in-process
+    loopback datapath, instead of duonic. Requires quicperf to be built with
+    -LoopbackDatapath, which is off by default. Always used on Linux, where
+    duonic isn't available.
+
+.PARAMETER JitterMs
+    The maximum random extra delay (without reordering) of each packet. Only
+    supported with -Loopback. Applies to all runs.
+
+.PARAMETER BurstLossDenominator
+    For N > 0, indicates a chance of 1 / N that a packet starts a burst of
+    losses. Only supported with -Loopback. Applies to all runs.
+
+.PARAMETER BurstLossLength
+    The mean number of packets lost in a burst. Only supported with -Loopback.
+
+.PARAMETER RateBucketBytes
+    The size of a token bucket in front of the bottleneck, which lets bursts of
+    up to this many bytes through at line rate after idle periods. Only
+    supported with -Loopback. Applies to all runs.
+
 #>
 
 param (
@@ -90,7 +112,22 @@ param (
 
     [Parameter(Mandatory = $false)]
     [ValidateSet("None", "Datapath.Light", "Datapath.Verbose", "Performance.Light", "Performance.Verbose", "Full.Light", "Full.Verbose")]
-    [string]$LogProfile = "None"
+    [string]$LogProfile = "None",
+
+    [Parameter(Mandatory = $false)]
+    [switch]$Loopback = $false,
+
+    [Parameter(Mandatory = $false)]
+    [Int32]$JitterMs = 0,
+
+    [Parameter(Mandatory = $false)]
+    [Int32]$BurstLossDenominator = 0,
+
+    [Parameter(Mandatory = $false)]
+    [Int32]$BurstLossLength = 1,
+
+    [Parameter(Mandatory = $false)]
+    [Int32]$RateBucketBytes = 0
 )
 
 Set-StrictMode -Version 'Latest'
@@ -173,6 +210,11 @@ if ($LogProfile -ne "None") {
     dir $LogScript | Write-Debug
 }
 
+if (!$IsWindows) {
+    # duonic is Windows only.
+    $Loopback = $true
+}
+
 $Platform = $IsWindows ? "windows" : "linux"
 $PlatformName = (($IsWindows ? "Windows" : "Linux") + "_$($Arch)_$($Tls)")
 
@@ -180,28 +222,35 @@ $PlatformName = (($IsWindows ? "Windows" : "Linux") + "_$($Arch)_$($Tls)")
 $ExeName = $IsWindows ? "quicperf.exe" : "quicperf"
 $QuicPerf = Join-Path $RootDir "artifacts" "bin" $Platform "$($Arch)_$($Config)_$($Tls)" $ExeName
 
-Get-NetAdapter | Write-Debug
-ipconfig -all | Write-Debug
+if (!(Test-Path -Path $QuicPerf)) {
+    Write-Error "Missing file: $QuicPerf"
+}
 
 # Make sure to kill any old processes
 try { Stop-Process -Name quicperf } catch { }
 
-# Start the perf server listening.
-Write-Debug "Starting server..."
-if (!(Test-Path -Path $QuicPerf)) {
-    Write-Error "Missing file: $QuicPerf"
+if (!$Loopback -and ($JitterMs -ne 0 -or $BurstLossDenominator -gt 0 -or $RateBucketBytes -ne 0)) {
+    Write-Error "-JitterMs, -BurstLossDenominator and -RateBucketBytes require -Loopback"
+}
+
+if (!$Loopback) {
+    Get-NetAdapter | Write-Debug
+    ipconfig -all | Write-Debug
+
+    # Start the perf server listening.
+    Write-Debug "Starting server..."
+    $pinfo = New-Object System.Diagnostics.ProcessStartInfo
+    $pinfo.FileName = $QuicPerf
+    $pinfo.UseShellExecute = $false
+    $pinfo.RedirectStandardOutput = $true
+    $pinfo.RedirectStandardError = $true
+    $p = New-Object System.Diagnostics.Process
+    $p.StartInfo = $pinfo
+    $p.Start() | Out-Null
+
+    # Wait for the server(s) to come up.
+    Sleep -Seconds 1
 }
-$pinfo = New-Object System.Diagnostics.ProcessStartInfo
-$pinfo.FileName = $QuicPerf
-$pinfo.UseShellExecute = $false
-$pinfo.RedirectStandardOutput = $true
-$pinfo.RedirectStandardError = $true
-$p = New-Object System.Diagnostics.Process
-$p.StartInfo = $pinfo
-$p.Start() | Out-Null
-
-# Wait for the server(s) to come up.
-Sleep -Seconds 1
 
 $OutputDir = Join-Path $RootDir "artifacts" "PerfDataResults" $Platform "$($Arch)_$($Config)_$($Tls)" "WAN"
 New-Item -Path $OutputDir -ItemType Directory -Force | Out-Null
@@ -214,14 +263,16 @@ for ($i = 0; $i -lt $NumIterations; $i++) {
 }
 Write-Host $Header
 
-# Turn on RDQ for duonic.
-Set-NetAdapterAdvancedProperty duo? -DisplayName RdqEnabled -RegistryValue 1 -NoRestart
+if (!$Loopback) {
+    # Turn on RDQ for duonic.
+    Set-NetAdapterAdvancedProperty duo? -DisplayName RdqEnabled -RegistryValue 1 -NoRestart
 
-# The RDQ buffer limit is by packets and not bytes, so turn off LSO to avoid
-# strange behavior. This makes RDQ behave more like a real middlebox on the
-# network (such a middlebox would only see packets after LSO sends are split
-# into MTU-sized packets).
-Set-NetAdapterLso duo? -IPv4Enabled $false -IPv6Enabled $false -NoRestart
+    # The RDQ buffer limit is by packets and not bytes, so turn off LSO to avoid
+    # strange behavior. This makes RDQ behave more like a real middlebox on the
+    # network (such a middlebox would only see packets after LSO sends are split
+    # into MTU-sized packets).
+    Set-NetAdapterLso duo? -IPv4Enabled $false -IPv6Enabled $false -NoRestart
+}
 
 $RunResults = [Results]::new($PlatformName)
 
@@ -241,18 +292,23 @@ foreach ($ThisReorderDelayDeltaMs in $ReorderDelayDeltaMs) {
     $BDP = [double]($ThisRttMs * $ThisBottleneckMbps) / (1.5 * 8.0)
     $ThisBottleneckBufferPackets = [int]($BDP * $ThisBottleneckQueueRatio * 1.1)
 
-    # Configure duonic for the desired network emulation options.
-    Write-Debug "Configure NIC: Rtt=$ThisRttMs ms, Bottneck=[$ThisBottleneckMbps mbps, $ThisBottleneckBufferPackets packets], RandomLoss=1/$ThisRandomLossDenominator, ReorderDelayDelta=$ThisReorderDelayDeltaMs ms, RandomReorder=1/$ThisRandomReorderDenominator"
     $DelayMs = [convert]::ToInt32([int]($ThisRttMs)/2)
-    Set-NetAdapterAdvancedProperty duo? -DisplayName DelayMs -RegistryValue $DelayMs -NoRestart
-    Set-NetAdapterAdvancedProperty duo? -DisplayName RateLimitMbps -RegistryValue $ThisBottleneckMbps -NoRestart
-    Set-NetAdapterAdvancedProperty duo? -DisplayName QueueLimitPackets -RegistryValue $ThisBottleneckBufferPackets -NoRestart
-    Set-NetAdapterAdvancedProperty duo? -DisplayName RandomLossDenominator -RegistryValue $ThisRandomLossDenominator -NoRestart
-    Set-NetAdapterAdvancedProperty duo? -DisplayName RandomReorderDenominator -RegistryValue $ThisRandomReorderDenominator -NoRestart
-    Set-NetAdapterAdvancedProperty duo? -DisplayName ReorderDelayDeltaMs -RegistryValue $ThisReorderDelayDeltaMs -NoRestart
-    Write-Debug "Restarting NIC"
-    Restart-NetAdapter duo?
-    Start-Sleep 5 # (wait for duonic to restart)
+    if ($Loopback) {
+        # The emulation is configured per quicperf run.
+        $EmulationArgs = "-delay:$DelayMs -ratelimit:$ThisBottleneckMbps -queuelimit:$ThisBottleneckBufferPackets -randomloss:$([Math]::Max($ThisRandomLossDenominator, 0)) -randomreorder:$([Math]::Max($ThisRandomReorderDenominator, 0)) -reorderdelay:$ThisReorderDelayDeltaMs -jitter:$JitterMs -burstloss:$([Math]::Max($BurstLossDenominator, 0)) -burstlen:$BurstLossLength -ratebucket:$RateBucketBytes"
+    } else {
+        # Configure duonic for the desired network emulation options.
+        Write-Debug "Configure NIC: Rtt=$ThisRttMs ms, Bottneck=[$ThisBottleneckMbps mbps, $ThisBottleneckBufferPackets packets], RandomLoss=1/$ThisRandomLossDenominator, ReorderDelayDelta=$ThisReorderDelayDeltaMs ms, RandomReorder=1/$ThisRandomReorderDenominator"
+        Set-NetAdapterAdvancedProperty duo? -DisplayName DelayMs -RegistryValue $DelayMs -NoRestart
+        Set-NetAdapterAdvancedProperty duo? -DisplayName RateLimitMbps -RegistryValue $ThisBottleneckMbps -NoRestart
+        Set-NetAdapterAdvancedProperty duo? -DisplayName QueueLimitPackets -RegistryValue $ThisBottleneckBufferPackets -NoRestart
+        Set-NetAdapterAdvancedProperty duo? -DisplayName RandomLossDenominator -RegistryValue $ThisRandomLossDenominator -NoRestart
+        Set-NetAdapterAdvancedProperty duo? -DisplayName RandomReorderDenominator -RegistryValue $ThisRandomReorderDenominator -NoRestart
+        Set-NetAdapterAdvancedProperty duo? -DisplayName ReorderDelayDeltaMs -RegistryValue $ThisReorderDelayDeltaMs -NoRestart
+        Write-Debug "Restarting NIC"
+        Restart-NetAdapter duo?
+        Start-Sleep 5 # (wait for duonic to restart)
+    }
 
     # Loop over all the test configurations.
     foreach ($ThisProtocol in $Protocol) {
@@ -283,7 +339,11 @@ foreach ($ThisReorderDelayDeltaMs in $ReorderDelayDeltaMs) {
             Write-Debug "Run upload test: Iteration=$($i + 1)"
 
             $Rate = 0
-            $Command = "$QuicPerf -test:tput -tcp:$UseTcp -maxruntime:$MaxRuntimeMs -bind:192.168.1.12 -target:192.168.1.11 -sendbuf:0 -upload:$ThisDurationMs -timed:1 -pacing:$ThisPacing"
+            if ($Loopback) {
+                $Command = "$QuicPerf -test:tput -tcp:$UseTcp -maxruntime:$MaxRuntimeMs -target:127.0.0.1 -sendbuf:0 -upload:$ThisDurationMs -timed:1 -pacing:$ThisPacing $EmulationArgs"
+            } else {
+                $Command = "$QuicPerf -test:tput -tcp:$UseTcp -maxruntime:$MaxRuntimeMs -bind:192.168.1.12 -target:192.168.1.11 -sendbuf:0 -upload:$ThisDurationMs -timed:1 -pacing:$ThisPacing"
+            }
             Write-Debug $Command
             $Output = [string](iex $Command)
             Write-Debug $Output
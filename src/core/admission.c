@@ -0,0 +1,313 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Admission control for new connection attempts (server side).
+
+    Instead of a single cliff (Retry once handshake memory runs low, then
+    dropping whatever the stateless worker can't keep up with), admission
+    control measures the rate of new connection attempts and the CPU time
+    spent processing handshakes, and escalates its response progressively:
+
+        NORMAL - All attempts are accepted.
+
+        RETRY - Attempts without a valid Retry token get a Retry, so spoofed
+        source addresses can't create any state or use any handshake CPU.
+
+        RATE_LIMIT - Additionally, each source prefix (/24 or /48) with a
+        validated address is limited to a share of the configured rate. Each
+        attempt uses more of its prefix's tokens the more CPU the prefix's
+        recent handshakes have used.
+
+        DROP - Attempts without a valid Retry token are dropped; even sending
+        a Retry is too much at this point.
+
+    The level is reevaluated every measurement interval. It escalates
+    immediately, but only steps back down one level at a time, once the load
+    has called for a lower level for several consecutive intervals.
+
+    The per-prefix state is split into shards by the hash of the prefix, each
+    with its own lock, so attempts and handshakes from different prefixes
+    don't contend with each other.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "admission.c.clog.h"
+#endif
+
+CXPLAT_STATIC_ASSERT(
+    QUIC_ADMISSION_SHARD_COUNT <= QUIC_ADMISSION_PREFIX_COUNT &&
+    (QUIC_ADMISSION_PREFIX_COUNT % QUIC_ADMISSION_SHARD_COUNT) == 0,
+    "Prefixes must split evenly into shards");
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAdmissionInitialize(
+    _Out_ QUIC_ADMISSION* Admission
+    )
+{
+    CxPlatZeroMemory(Admission, sizeof(*Admission));
+    CxPlatDispatchLockInitialize(&Admission->Lock);
+    for (uint32_t i = 0; i < QUIC_ADMISSION_SHARD_COUNT; ++i) {
+        CxPlatDispatchLockInitialize(&Admission->Shards[i].Lock);
+    }
+    Admission->Level = QUIC_ADMISSION_LEVEL_NORMAL;
+    Admission->IntervalStartTimeMs = CxPlatTimeMs32();
+    CxPlatRandom(sizeof(Admission->HashSeed), &Admission->HashSeed);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAdmissionUninitialize(
+    _In_ QUIC_ADMISSION* Admission
+    )
+{
+    for (uint32_t i = 0; i < QUIC_ADMISSION_SHARD_COUNT; ++i) {
+        CxPlatDispatchLockUninitialize(&Admission->Shards[i].Lock);
+    }
+    CxPlatDispatchLockUninitialize(&Admission->Lock);
+}
+
+//
+// Writes the family and /24 (IPv4) or /48 (IPv6) prefix of the address and
+// returns its index in the prefix table.
+//
+static
+uint32_t
+QuicAdmissionGetPrefix(
+    _In_ const QUIC_ADMISSION* Admission,
+    _In_ const QUIC_ADDR* Address,
+    _Out_writes_all_(QUIC_ADMISSION_PREFIX_LENGTH)
+        uint8_t* Prefix
+    )
+{
+    CxPlatZeroMemory(Prefix, QUIC_ADMISSION_PREFIX_LENGTH);
+    if (QuicAddrGetFamily(Address) == QUIC_ADDRESS_FAMILY_INET) {
+        Prefix[0] = 4;
+        CxPlatCopyMemory(Prefix + 1, &Address->Ipv4.sin_addr, 3);
+    } else {
+        Prefix[0] = 6;
+        CxPlatCopyMemory(Prefix + 1, &Address->Ipv6.sin6_addr, 6);
+    }
+
+    uint32_t Hash = Admission->HashSeed;
+    for (uint8_t i = 0; i < QUIC_ADMISSION_PREFIX_LENGTH; ++i) {
+        Hash = ((Hash << 5) - Hash) + Prefix[i];
+    }
+    Hash ^= Hash >> 16;
+    return Hash & (QUIC_ADMISSION_PREFIX_COUNT - 1);
+}
+
+//
+// Returns the prefix's table entry, replacing whichever prefix had the entry
+// before, if any, with the entry's shard locked. The caller must release the
+// shard's lock.
+//
+static
+QUIC_ADMISSION_PREFIX*
+QuicAdmissionLookupPrefix(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ const QUIC_ADDR* Address,
+    _In_ uint32_t TokenLimit,
+    _In_ uint32_t TimeMs,
+    _Outptr_ QUIC_ADMISSION_SHARD** Shard
+    )
+{
+    uint8_t Prefix[QUIC_ADMISSION_PREFIX_LENGTH];
+    const uint32_t Index = QuicAdmissionGetPrefix(Admission, Address, Prefix);
+    *Shard = &Admission->Shards[Index / QUIC_ADMISSION_SHARD_PREFIX_COUNT];
+    CxPlatDispatchLockAcquire(&(*Shard)->Lock);
+    QUIC_ADMISSION_PREFIX* Entry =
+        &(*Shard)->Prefixes[Index % QUIC_ADMISSION_SHARD_PREFIX_COUNT];
+    if (memcmp(Entry->Prefix, Prefix, sizeof(Prefix)) != 0) {
+        CxPlatCopyMemory(Entry->Prefix, Prefix, sizeof(Prefix));
+        Entry->Tokens = TokenLimit;
+        Entry->LastRefillTimeMs = TimeMs;
+        Entry->HandshakeCostUs = 0;
+    }
+    return Entry;
+}
+
+//
+// Ends the current measurement interval and reevaluates the admission level.
+// Must be called under the lock.
+//
+static
+void
+QuicAdmissionUpdateLevel(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ uint32_t InitialRate,
+    _In_ uint32_t TimeMs
+    )
+{
+    const uint32_t ElapsedMs = TimeMs - Admission->IntervalStartTimeMs;
+    Admission->IntervalStartTimeMs = TimeMs;
+
+    //
+    // Subtract what was read, rather than resetting to zero, so that updates
+    // racing with this one count towards the next interval.
+    //
+    const int64_t Attempts =
+        InterlockedExchangeAdd64(&Admission->IntervalAttempts, 0);
+    InterlockedExchangeAdd64(&Admission->IntervalAttempts, -Attempts);
+    const int64_t HandshakeCostUs =
+        InterlockedExchangeAdd64(&Admission->IntervalHandshakeCostUs, 0);
+    InterlockedExchangeAdd64(&Admission->IntervalHandshakeCostUs, -HandshakeCostUs);
+
+    const uint64_t AttemptRate = ((uint64_t)Attempts * 1000) / ElapsedMs;
+    Admission->AttemptRate =
+        AttemptRate > UINT32_MAX ? UINT32_MAX : (uint32_t)AttemptRate;
+
+    QUIC_ADMISSION_LEVEL Target;
+    if (AttemptRate < InitialRate) {
+        Target = QUIC_ADMISSION_LEVEL_NORMAL;
+    } else if (AttemptRate < 2 * (uint64_t)InitialRate) {
+        Target = QUIC_ADMISSION_LEVEL_RETRY;
+    } else if (AttemptRate < 4 * (uint64_t)InitialRate) {
+        Target = QUIC_ADMISSION_LEVEL_RATE_LIMIT;
+    } else {
+        Target = QUIC_ADMISSION_LEVEL_DROP;
+    }
+
+    //
+    // Escalate one more level if handshakes are using too much of the
+    // machine's total CPU time (elapsed time across all processors).
+    //
+    const uint64_t AvailableCpuUs =
+        (uint64_t)ElapsedMs * 1000 * CxPlatProcActiveCount();
+    if (Target < QUIC_ADMISSION_LEVEL_DROP &&
+        (uint64_t)HandshakeCostUs * 100 >= AvailableCpuUs * QUIC_ADMISSION_HANDSHAKE_CPU_PERCENT) {
+        Target = (QUIC_ADMISSION_LEVEL)(Target + 1);
+    }
+
+    if (Target >= Admission->Level) {
+        if (Target > Admission->Level) {
+            QuicTraceLogWarning(
+                AdmissionEscalate,
+                "[adm ] Escalating to level %u (%u attempts/s, %llu us handshake CPU)",
+                (uint32_t)Target,
+                Admission->AttemptRate,
+                (uint64_t)HandshakeCostUs);
+            Admission->Level = Target;
+        }
+        Admission->CooldownIntervals = 0;
+
+    } else if (++Admission->CooldownIntervals >= QUIC_ADMISSION_COOLDOWN_INTERVALS) {
+        Admission->Level = (QUIC_ADMISSION_LEVEL)(Admission->Level - 1);
+        Admission->CooldownIntervals = 0;
+        QuicTraceLogInfo(
+            AdmissionDeescalate,
+            "[adm ] De-escalating to level %u (%u attempts/s)",
+            (uint32_t)Admission->Level,
+            Admission->AttemptRate);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_ADMISSION_RESULT
+QuicAdmissionCheck(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ uint32_t InitialRate,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ BOOLEAN Validated,
+    _In_ uint32_t TimeMs
+    )
+{
+    CXPLAT_DBG_ASSERT(InitialRate != 0);
+
+    InterlockedIncrement64(&Admission->IntervalAttempts);
+
+    if ((int32_t)(TimeMs - Admission->IntervalStartTimeMs) >= QUIC_ADMISSION_INTERVAL_MS) {
+        CxPlatDispatchLockAcquire(&Admission->Lock);
+        if ((int32_t)(TimeMs - Admission->IntervalStartTimeMs) >= QUIC_ADMISSION_INTERVAL_MS) {
+            QuicAdmissionUpdateLevel(Admission, InitialRate, TimeMs);
+        }
+        CxPlatDispatchLockRelease(&Admission->Lock);
+    }
+
+    const QUIC_ADMISSION_LEVEL Level = Admission->Level;
+    if (Level == QUIC_ADMISSION_LEVEL_NORMAL) {
+        return QUIC_ADMISSION_ACCEPT;
+    }
+
+    if (!Validated) {
+        return
+            Level == QUIC_ADMISSION_LEVEL_DROP ?
+                QUIC_ADMISSION_DROP : QUIC_ADMISSION_RETRY;
+    }
+
+    if (Level == QUIC_ADMISSION_LEVEL_RETRY) {
+        return QUIC_ADMISSION_ACCEPT;
+    }
+
+    //
+    // The source address is validated, so its prefix is meaningful. Each
+    // prefix gets a share of the configured rate, as a token bucket holding up
+    // to one second's worth of tokens.
+    //
+    uint32_t PrefixRate = InitialRate / QUIC_ADMISSION_PREFIX_RATE_DIVISOR;
+    if (PrefixRate == 0) {
+        PrefixRate = 1;
+    }
+
+    QUIC_ADMISSION_RESULT Result = QUIC_ADMISSION_ACCEPT;
+    QUIC_ADMISSION_SHARD* Shard;
+    QUIC_ADMISSION_PREFIX* Entry =
+        QuicAdmissionLookupPrefix(
+            Admission, RemoteAddress, PrefixRate, TimeMs, &Shard);
+
+    const uint64_t NewTokens =
+        ((uint64_t)CxPlatTimeDiff32(Entry->LastRefillTimeMs, TimeMs) * PrefixRate) / 1000;
+    if (NewTokens != 0) {
+        const uint64_t Tokens = Entry->Tokens + NewTokens;
+        Entry->Tokens = Tokens > PrefixRate ? PrefixRate : (uint32_t)Tokens;
+        Entry->LastRefillTimeMs = TimeMs;
+    } else if (Entry->Tokens > PrefixRate) {
+        Entry->Tokens = PrefixRate; // New entry, or the rate was lowered.
+    }
+
+    uint32_t Cost = 1 + Entry->HandshakeCostUs / QUIC_ADMISSION_HANDSHAKE_COST_UNIT_US;
+    if (Cost > QUIC_ADMISSION_MAX_ATTEMPT_COST) {
+        Cost = QUIC_ADMISSION_MAX_ATTEMPT_COST;
+    }
+    if (Cost > PrefixRate) {
+        Cost = PrefixRate; // Always let an expensive prefix in now and then.
+    }
+
+    if (Entry->Tokens >= Cost) {
+        Entry->Tokens -= Cost;
+    } else {
+        Result = QUIC_ADMISSION_RATE_LIMITED;
+    }
+
+    CxPlatDispatchLockRelease(&Shard->Lock);
+
+    return Result;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAdmissionChargeHandshake(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint32_t CostUs
+    )
+{
+    InterlockedExchangeAdd64(&Admission->IntervalHandshakeCostUs, (int64_t)CostUs);
+
+    QUIC_ADMISSION_SHARD* Shard;
+    QUIC_ADMISSION_PREFIX* Entry =
+        QuicAdmissionLookupPrefix(
+            Admission,
+            RemoteAddress,
+            UINT32_MAX, // Capped to the prefix rate on the next check.
+            CxPlatTimeMs32(),
+            &Shard);
+    Entry->HandshakeCostUs = (Entry->HandshakeCostUs * 7 + CostUs) / 8;
+    CxPlatDispatchLockRelease(&Shard->Lock);
+}
@@ -0,0 +1,184 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+//
+// The levels admission control escalates through as the load of new
+// connection attempts grows.
+//
+typedef enum QUIC_ADMISSION_LEVEL {
+
+    QUIC_ADMISSION_LEVEL_NORMAL,        // All connection attempts are accepted.
+    QUIC_ADMISSION_LEVEL_RETRY,         // Unvalidated attempts must Retry.
+    QUIC_ADMISSION_LEVEL_RATE_LIMIT,    // Validated attempts are rate limited per prefix.
+    QUIC_ADMISSION_LEVEL_DROP           // Unvalidated attempts are dropped.
+
+} QUIC_ADMISSION_LEVEL;
+
+//
+// What to do with a new connection attempt.
+//
+typedef enum QUIC_ADMISSION_RESULT {
+
+    QUIC_ADMISSION_ACCEPT,              // Create the connection.
+    QUIC_ADMISSION_RETRY,               // Respond with a stateless Retry.
+    QUIC_ADMISSION_RATE_LIMITED,        // Drop, because its source prefix is over its rate.
+    QUIC_ADMISSION_DROP                 // Drop, because it isn't validated.
+
+} QUIC_ADMISSION_RESULT;
+
+//
+// The /24 (IPv4) or /48 (IPv6) prefix of a source address, prepended with the
+// address family.
+//
+#define QUIC_ADMISSION_PREFIX_LENGTH    7
+
+typedef struct QUIC_ADMISSION_PREFIX {
+
+    //
+    // The source prefix tracked by this entry. All zero if unused.
+    //
+    uint8_t Prefix[QUIC_ADMISSION_PREFIX_LENGTH];
+
+    //
+    // Rate limit tokens currently available to the prefix.
+    //
+    uint32_t Tokens;
+
+    //
+    // The time (in ms) tokens were last added.
+    //
+    uint32_t LastRefillTimeMs;
+
+    //
+    // Moving average of the handshake CPU time (in us) the prefix's
+    // connections use per TLS call.
+    //
+    uint32_t HandshakeCostUs;
+
+} QUIC_ADMISSION_PREFIX;
+
+#define QUIC_ADMISSION_SHARD_PREFIX_COUNT \
+    (QUIC_ADMISSION_PREFIX_COUNT / QUIC_ADMISSION_SHARD_COUNT)
+
+//
+// A slice of the prefix table with its own lock.
+//
+typedef struct QUIC_ADMISSION_SHARD {
+
+    //
+    // Protects the shard's prefix entries.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // Direct-mapped table of the source prefixes tracked by the shard.
+    //
+    QUIC_ADMISSION_PREFIX Prefixes[QUIC_ADMISSION_SHARD_PREFIX_COUNT];
+
+} QUIC_ADMISSION_SHARD;
+
+//
+// Tracks the rate of new connection attempts and the CPU cost of their
+// handshakes, both overall and per source prefix, to decide how to respond to
+// each new attempt.
+//
+typedef struct QUIC_ADMISSION {
+
+    //
+    // Serializes updates of the level. Only taken once per interval.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // The current admission level. Only written under the lock.
+    //
+    QUIC_ADMISSION_LEVEL Level;
+
+    //
+    // Number of consecutive intervals the measured load called for a lower
+    // level than the current one.
+    //
+    uint32_t CooldownIntervals;
+
+    //
+    // Start time (in ms) of the current measurement interval.
+    //
+    uint32_t IntervalStartTimeMs;
+
+    //
+    // Connection attempts seen in the current measurement interval.
+    //
+    int64_t IntervalAttempts;
+
+    //
+    // Handshake CPU time (in us) used in the current measurement interval.
+    //
+    int64_t IntervalHandshakeCostUs;
+
+    //
+    // The connection attempt rate (per second) of the last full interval.
+    //
+    uint32_t AttemptRate;
+
+    //
+    // Random seed for mapping prefixes to table entries, so attackers can't
+    // pick prefixes that evict each other.
+    //
+    uint32_t HashSeed;
+
+    //
+    // The tracked source prefixes, sharded by the hash of the prefix.
+    //
+    QUIC_ADMISSION_SHARD Shards[QUIC_ADMISSION_SHARD_COUNT];
+
+} QUIC_ADMISSION;
+
+//
+// Initializes the admission control state.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAdmissionInitialize(
+    _Out_ QUIC_ADMISSION* Admission
+    );
+
+//
+// Cleans up the admission control state.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicAdmissionUninitialize(
+    _In_ QUIC_ADMISSION* Admission
+    );
+
+//
+// Records a new connection attempt from the remote address and returns how it
+// should be handled. Validated indicates the attempt carried a valid Retry
+// token. InitialRate is the configured rate (per second) at which admission
+// control starts escalating.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_ADMISSION_RESULT
+QuicAdmissionCheck(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ uint32_t InitialRate,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ BOOLEAN Validated,
+    _In_ uint32_t TimeMs
+    );
+
+//
+// Charges handshake CPU time (in us) spent on a connection from the remote
+// address.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicAdmissionChargeHandshake(
+    _Inout_ QUIC_ADMISSION* Admission,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ uint32_t CostUs
+    );
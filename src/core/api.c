@@ -1105,6 +1105,207 @@ Exit:
     return Status;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QUIC_API
+MsQuicStreamSendBatch(
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    )
+{
+    QUIC_STATUS Status;
+    QUIC_STREAM* Stream;
+    QUIC_CONNECTION* Connection = NULL;
+    uint64_t TotalLength;
+    QUIC_SEND_REQUEST* SendRequest;
+    QUIC_OPERATION* Oper;
+    QUIC_STREAM** Streams;
+    uint32_t StreamCount = 0;
+
+    QuicTraceEvent(
+        ApiEnter,
+        "[ api] Enter %u (%p).",
+        QUIC_TRACE_API_STREAM_SEND_BATCH,
+        Entries);
+
+    if (Entries == NULL || EntryCount == 0) {
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        goto Exit;
+    }
+
+    //
+    // Validate the whole batch up front, so that nothing is queued if any one
+    // entry is malformed.
+    //
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        if (!IS_STREAM_HANDLE(Entries[i].Stream) ||
+            (Entries[i].Buffers == NULL && Entries[i].BufferCount != 0)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+
+#pragma prefast(suppress: __WARNING_25024, "Pointer cast already validated.")
+        Stream = (QUIC_STREAM*)Entries[i].Stream;
+
+        CXPLAT_TEL_ASSERT(!Stream->Flags.HandleClosed);
+        CXPLAT_TEL_ASSERT(!Stream->Flags.Freed);
+
+        if (Connection == NULL) {
+            Connection = Stream->Connection;
+        } else if (Connection != Stream->Connection) {
+            QuicTraceEvent(
+                StreamError,
+                "[strm][%p] ERROR, %s.",
+                Stream,
+                "Send batch spans connections");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+
+        TotalLength = 0;
+        for (uint32_t j = 0; j < Entries[i].BufferCount; ++j) {
+            TotalLength += Entries[i].Buffers[j].Length;
+        }
+
+        if (TotalLength > UINT32_MAX) {
+            QuicTraceEvent(
+                StreamError,
+                "[strm][%p] ERROR, %s.",
+                Stream,
+                "Send request total length exceeds max");
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            goto Error;
+        }
+    }
+
+    CXPLAT_DBG_ASSERT(Connection != NULL);
+    QUIC_CONN_VERIFY(Connection, !Connection->State.Freed);
+    QUIC_CONN_VERIFY(Connection,
+        (Connection->WorkerThreadID == CxPlatCurThreadID()) ||
+        !Connection->State.HandleClosed);
+
+    Streams =
+        CXPLAT_ALLOC_NONPAGED(
+            EntryCount * sizeof(QUIC_STREAM*),
+            QUIC_POOL_SEND_BATCH);
+    if (Streams == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Stream send batch",
+            EntryCount * sizeof(QUIC_STREAM*));
+        goto Error;
+    }
+
+    Oper = QuicOperationAlloc(Connection->Worker, QUIC_OPER_TYPE_API_CALL);
+    if (Oper == NULL) {
+        CXPLAT_FREE(Streams, QUIC_POOL_SEND_BATCH);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "STRM_SEND_BATCH operation",
+            0);
+        goto Error;
+    }
+
+    Status = QUIC_STATUS_PENDING;
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        BOOLEAN QueueFlush = TRUE;
+        Stream = (QUIC_STREAM*)Entries[i].Stream;
+
+        TotalLength = 0;
+        for (uint32_t j = 0; j < Entries[i].BufferCount; ++j) {
+            TotalLength += Entries[i].Buffers[j].Length;
+        }
+
+#pragma prefast(suppress: __WARNING_6014, "Memory is correctly freed (QuicStreamCompleteSendRequest).")
+        SendRequest = CxPlatPoolAlloc(&Connection->Worker->SendRequestPool);
+        if (SendRequest == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "Stream Send request",
+                0);
+            Entries[i].Status = QUIC_STATUS_OUT_OF_MEMORY;
+            if (Status == QUIC_STATUS_PENDING) {
+                Status = Entries[i].Status;
+            }
+            continue;
+        }
+
+        SendRequest->Next = NULL;
+        SendRequest->Buffers = Entries[i].Buffers;
+        SendRequest->BufferCount = Entries[i].BufferCount;
+        SendRequest->Flags = Entries[i].Flags & ~QUIC_SEND_FLAGS_INTERNAL;
+        SendRequest->TotalLength = TotalLength;
+        SendRequest->ClientContext = Entries[i].ClientSendContext;
+
+        CxPlatDispatchLockAcquire(&Stream->ApiSendRequestLock);
+        if (!Stream->Flags.SendEnabled) {
+            Entries[i].Status = QUIC_STATUS_INVALID_STATE;
+        } else {
+            QUIC_SEND_REQUEST** ApiSendRequestsTail = &Stream->ApiSendRequests;
+            while (*ApiSendRequestsTail != NULL) {
+                ApiSendRequestsTail = &((*ApiSendRequestsTail)->Next);
+                QueueFlush = FALSE; // Already pending a flush (possibly by this batch).
+            }
+            *ApiSendRequestsTail = SendRequest;
+            Entries[i].Status = QUIC_STATUS_PENDING;
+        }
+        CxPlatDispatchLockRelease(&Stream->ApiSendRequestLock);
+
+        if (QUIC_FAILED(Entries[i].Status)) {
+            CxPlatPoolFree(&Connection->Worker->SendRequestPool, SendRequest);
+            if (Status == QUIC_STATUS_PENDING) {
+                Status = Entries[i].Status;
+            }
+            continue;
+        }
+
+        if (QueueFlush) {
+            //
+            // Hold a ref on each stream to be flushed until the operation is
+            // processed, just as for a single STRM_SEND operation.
+            //
+            QuicStreamAddRef(Stream, QUIC_STREAM_REF_OPERATION);
+            Streams[StreamCount++] = Stream;
+        }
+    }
+
+    Oper->API_CALL.Context->Type = QUIC_API_TYPE_STRM_SEND_BATCH;
+    Oper->API_CALL.Context->STRM_SEND_BATCH.Streams = Streams;
+    Oper->API_CALL.Context->STRM_SEND_BATCH.StreamCount = StreamCount;
+
+    if (StreamCount == 0) {
+        QuicOperationFree(Connection->Worker, Oper);
+    } else {
+        //
+        // Queue the operation but don't wait for the completion.
+        //
+        QuicConnQueueOper(Connection, Oper);
+    }
+
+    goto Exit;
+
+Error:
+
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        Entries[i].Status = Status;
+    }
+
+Exit:
+
+    QuicTraceEvent(
+        ApiExitStatus,
+        "[ api] Exit %u",
+        Status);
+
+    return Status;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QUIC_API
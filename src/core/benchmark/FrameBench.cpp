@@ -0,0 +1,167 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for frame encoding and decoding.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "FrameBench.cpp.clog.h"
+#endif
+
+#define FRAME_BENCH_FRAME_COUNT 64
+
+//
+// Fills the range with the given number of ACK ranges, as an ACK tracker
+// would look after that many gaps in the received packet numbers.
+//
+static
+bool
+FrameBenchFillAckRanges(
+    _In_ uint32_t RangeCount,
+    _Inout_ QUIC_RANGE* Range
+    )
+{
+    QuicBenchRandom Random;
+    uint64_t Next = 1000;
+    for (uint32_t i = 0; i < RangeCount; ++i) {
+        uint64_t Count = 1 + Random.Next(32);
+        BOOLEAN RangeUpdated;
+        if (QuicRangeAddRange(Range, Next, Count, &RangeUpdated) == NULL) {
+            return false;
+        }
+        Next += Count + 1 + Random.Next(4);
+    }
+    return true;
+}
+
+//
+// Arg is the stream data length per frame. Frames are encoded with explicit
+// offsets and lengths, spread over a handful of streams.
+//
+static
+void
+StreamFrameDecode(
+    QuicBenchState& State
+    )
+{
+    const uint16_t DataLength = (uint16_t)State.Arg;
+    const uint16_t FrameLength = DataLength + 24;
+    std::vector<uint8_t> Buffer((size_t)FrameLength * FRAME_BENCH_FRAME_COUNT);
+    uint64_t StreamOffsets[8] = {0};
+    QuicBenchRandom Random;
+
+    for (uint32_t i = 0; i < FRAME_BENCH_FRAME_COUNT; ++i) {
+        uint32_t Stream = Random.Next(8);
+        QUIC_STREAM_EX Frame = {0};
+        Frame.StreamID = Stream * 4;
+        Frame.Offset = StreamOffsets[Stream];
+        Frame.Length = DataLength;
+        Frame.ExplicitLength = TRUE;
+        StreamOffsets[Stream] += DataLength;
+
+        //
+        // The encoder only writes the header; the payload must already sit
+        // right after it in the same buffer, as it does in the send path.
+        //
+        uint8_t* FrameBuffer = Buffer.data() + (size_t)i * FrameLength;
+        uint8_t* Payload = FrameBuffer + QuicStreamFrameHeaderSize(&Frame);
+        CxPlatZeroMemory(Payload, DataLength);
+        Frame.Data = Payload;
+
+        uint16_t Offset = 0;
+        if (!QuicStreamFrameEncode(&Frame, &Offset, FrameLength, FrameBuffer)) {
+            State.SkipWithError("QuicStreamFrameEncode failed");
+            return;
+        }
+    }
+
+    uint32_t Index = 0;
+    for (auto _ : State) {
+        const uint8_t* Frame = Buffer.data() + (size_t)Index * FrameLength;
+        uint16_t Offset = 1;
+        QUIC_STREAM_EX Decoded;
+        QuicBenchDoNotOptimize(
+            QuicStreamFrameDecode((QUIC_FRAME_TYPE)Frame[0], FrameLength, Frame, &Offset, &Decoded));
+        QuicBenchDoNotOptimize(Decoded);
+        Index = (Index + 1) % FRAME_BENCH_FRAME_COUNT;
+    }
+
+    State.SetItemsProcessed(State.GetIterations());
+}
+
+QUIC_BENCHMARK(StreamFrameDecode)->Arg(64)->Arg(512)->Arg(1200);
+
+//
+// Arg is the number of ACK ranges in the frame.
+//
+static
+void
+AckFrameDecode(
+    QuicBenchState& State
+    )
+{
+    QUIC_RANGE Range, Decoded;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS, &Range);
+    QuicRangeInitialize(QUIC_MAX_RANGE_DECODE_ACKS, &Decoded);
+
+    uint8_t Buffer[MAX_UDP_PAYLOAD_LENGTH];
+    uint16_t Length = 0;
+    if (!FrameBenchFillAckRanges((uint32_t)State.Arg, &Range) ||
+        !QuicAckFrameEncode(&Range, 25, NULL, &Length, sizeof(Buffer), Buffer)) {
+        State.SkipWithError("Failed to build the ACK frame");
+    } else {
+        for (auto _ : State) {
+            uint16_t Offset = 1;
+            BOOLEAN InvalidFrame;
+            QUIC_ACK_ECN_EX Ecn;
+            uint64_t AckDelay;
+            QuicRangeReset(&Decoded);
+            QuicBenchDoNotOptimize(
+                QuicAckFrameDecode(
+                    QUIC_FRAME_ACK, Length, Buffer, &Offset, &InvalidFrame, &Decoded, &Ecn, &AckDelay));
+        }
+        State.SetItemsProcessed(State.GetIterations());
+    }
+
+    QuicRangeUninitialize(&Decoded);
+    QuicRangeUninitialize(&Range);
+}
+
+QUIC_BENCHMARK(AckFrameDecode)->Arg(1)->Arg(4)->Arg(32)->Arg(256);
+
+//
+// Arg is the number of ACK ranges to encode. This is the encoding done by
+// QuicAckTrackerAckFrameEncode, without the packet builder around it.
+//
+static
+void
+AckFrameEncode(
+    QuicBenchState& State
+    )
+{
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS, &Range);
+
+    uint8_t Buffer[MAX_UDP_PAYLOAD_LENGTH];
+    if (!FrameBenchFillAckRanges((uint32_t)State.Arg, &Range)) {
+        State.SkipWithError("Failed to build the ACK ranges");
+    } else {
+        for (auto _ : State) {
+            uint16_t Offset = 0;
+            QuicBenchDoNotOptimize(
+                QuicAckFrameEncode(&Range, 25, NULL, &Offset, sizeof(Buffer), Buffer));
+            QuicBenchDoNotOptimize(Buffer[0]);
+        }
+        State.SetItemsProcessed(State.GetIterations());
+    }
+
+    QuicRangeUninitialize(&Range);
+}
+
+QUIC_BENCHMARK(AckFrameEncode)->Arg(1)->Arg(4)->Arg(32)->Arg(256);
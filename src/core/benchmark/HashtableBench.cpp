@@ -0,0 +1,87 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for the CXPLAT_HASHTABLE, used the way the connection ID
+    lookup uses it.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "HashtableBench.cpp.clog.h"
+#endif
+
+#define HASHTABLE_BENCH_CID_LENGTH 8
+#define HASHTABLE_BENCH_LOOKUP_COUNT 4096
+
+struct HashtableBenchEntry {
+    CXPLAT_HASHTABLE_ENTRY Entry;
+    uint8_t Cid[HASHTABLE_BENCH_CID_LENGTH];
+};
+
+//
+// Arg is the number of entries (connection IDs) in the table. Lookups are for
+// random entries that exist, as for received short header packets.
+//
+static
+void
+HashtableLookup(
+    QuicBenchState& State
+    )
+{
+    QuicBenchRandom Random;
+    std::vector<HashtableBenchEntry> Entries((size_t)State.Arg);
+    CXPLAT_HASHTABLE Table;
+    if (!CxPlatHashtableInitializeEx(&Table, CXPLAT_HASH_MIN_SIZE)) {
+        State.SkipWithError("CxPlatHashtableInitializeEx failed");
+        return;
+    }
+
+    for (auto& Entry : Entries) {
+        uint64_t Cid = Random.Next();
+        CxPlatCopyMemory(Entry.Cid, &Cid, sizeof(Entry.Cid));
+        CxPlatHashtableInsert(
+            &Table,
+            &Entry.Entry,
+            CxPlatHashSimple(sizeof(Entry.Cid), Entry.Cid),
+            NULL);
+    }
+
+    std::vector<const uint8_t*> Lookups;
+    for (uint32_t i = 0; i < HASHTABLE_BENCH_LOOKUP_COUNT; ++i) {
+        Lookups.push_back(Entries[Random.Next((uint32_t)Entries.size())].Cid);
+    }
+
+    uint32_t Index = 0;
+    for (auto _ : State) {
+        const uint8_t* Cid = Lookups[Index];
+        CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
+        CXPLAT_HASHTABLE_ENTRY* TableEntry =
+            CxPlatHashtableLookup(
+                &Table,
+                CxPlatHashSimple(HASHTABLE_BENCH_CID_LENGTH, Cid),
+                &Context);
+        while (TableEntry != NULL) {
+            HashtableBenchEntry* Entry =
+                CXPLAT_CONTAINING_RECORD(TableEntry, HashtableBenchEntry, Entry);
+            if (memcmp(Cid, Entry->Cid, HASHTABLE_BENCH_CID_LENGTH) == 0) {
+                break;
+            }
+            TableEntry = CxPlatHashtableLookupNext(&Table, &Context);
+        }
+        QuicBenchDoNotOptimize(TableEntry);
+        Index = (Index + 1) % HASHTABLE_BENCH_LOOKUP_COUNT;
+    }
+    State.SetItemsProcessed(State.GetIterations());
+
+    for (auto& Entry : Entries) {
+        CxPlatHashtableRemove(&Table, &Entry.Entry, NULL);
+    }
+    CxPlatHashtableUninitialize(&Table);
+}
+
+QUIC_BENCHMARK(HashtableLookup)->Arg(16)->Arg(1024)->Arg(65536);
@@ -0,0 +1,102 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for the QUIC_RANGE multirange tracker.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RangeBench.cpp.clog.h"
+#endif
+
+//
+// Builds a packet number sequence as seen by a receiver's ACK tracker: mostly
+// in order, with 1 in 16 packets lost and 1 in 32 arriving late.
+//
+static
+std::vector<uint64_t>
+RangeBenchPacketNumbers(
+    _In_ uint32_t Count
+    )
+{
+    QuicBenchRandom Random;
+    std::vector<uint64_t> Values;
+    uint64_t Next = 0;
+    while (Values.size() < Count) {
+        if (Random.Next(16) == 0) {
+            Next++; // Lost
+        }
+        if (Random.Next(32) == 0 && Values.size() + 1 < Count) {
+            Values.push_back(Next + 1); // Reordered ahead of Next
+            Values.push_back(Next);
+            Next += 2;
+        } else {
+            Values.push_back(Next++);
+        }
+    }
+    return Values;
+}
+
+//
+// Arg is the number of packet numbers tracked before the range is reset, i.e.
+// roughly how many packets are received between ACK frames being acked.
+//
+static
+void
+RangeAddRange(
+    QuicBenchState& State
+    )
+{
+    std::vector<uint64_t> Values = RangeBenchPacketNumbers((uint32_t)State.Arg);
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ACK_PACKETS, &Range);
+
+    for (auto _ : State) {
+        QuicRangeReset(&Range);
+        for (uint64_t Value : Values) {
+            BOOLEAN RangeUpdated;
+            QuicBenchDoNotOptimize(QuicRangeAddRange(&Range, Value, 1, &RangeUpdated));
+        }
+    }
+
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+    QuicRangeUninitialize(&Range);
+}
+
+QUIC_BENCHMARK(RangeAddRange)->Arg(8)->Arg(64)->Arg(1024);
+
+//
+// Arg is the number of subranges in the range.
+//
+static
+void
+RangeGetMin(
+    QuicBenchState& State
+    )
+{
+    QUIC_RANGE Range;
+    QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &Range);
+    for (uint64_t i = 0; i < State.Arg; ++i) {
+        BOOLEAN RangeUpdated;
+        if (QuicRangeAddRange(&Range, i * 2, 1, &RangeUpdated) == NULL) {
+            State.SkipWithError("QuicRangeAddRange failed");
+            QuicRangeUninitialize(&Range);
+            return;
+        }
+    }
+
+    for (auto _ : State) {
+        uint64_t Value;
+        QuicBenchDoNotOptimize(QuicRangeGetMinSafe(&Range, &Value));
+        QuicBenchDoNotOptimize(Value);
+    }
+
+    QuicRangeUninitialize(&Range);
+}
+
+QUIC_BENCHMARK(RangeGetMin)->Arg(1)->Arg(64);
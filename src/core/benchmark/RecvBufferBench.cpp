@@ -0,0 +1,101 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for the stream receive buffer.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RecvBufferBench.cpp.clog.h"
+#endif
+
+#define RECV_BUFFER_BENCH_CHUNK_SIZE    0x1000
+#define RECV_BUFFER_BENCH_WINDOW        0x10000
+
+//
+// Arg is the stream frame payload length. Frames arrive in order except that
+// 1 in 16 is swapped with the next, and the app reads and drains everything
+// as soon as it is ready, like a stream receiving a bulk transfer.
+//
+static
+void
+RecvBufferWrite(
+    QuicBenchState& State
+    )
+{
+    const uint16_t Length = (uint16_t)State.Arg;
+    std::vector<uint8_t> Data(Length);
+    QuicBenchRandom Random;
+
+    CXPLAT_POOL ChunkPool;
+    CxPlatPoolInitialize(
+        FALSE,
+        sizeof(QUIC_RECV_CHUNK) + RECV_BUFFER_BENCH_CHUNK_SIZE,
+        QUIC_POOL_TEST,
+        &ChunkPool);
+    QUIC_RECV_BUFFER RecvBuffer;
+    if (QUIC_FAILED(
+            QuicRecvBufferInitialize(
+                &RecvBuffer,
+                RECV_BUFFER_BENCH_CHUNK_SIZE,
+                RECV_BUFFER_BENCH_WINDOW,
+                QUIC_RECV_BUF_MODE_CHUNKED,
+                &ChunkPool))) {
+        CxPlatPoolUninitialize(&ChunkPool);
+        State.SkipWithError("QuicRecvBufferInitialize failed");
+        return;
+    }
+
+    uint64_t NextOffset = 0;
+    uint64_t DeferredOffset = UINT64_MAX;
+    for (auto _ : State) {
+        uint64_t Offset;
+        if (DeferredOffset != UINT64_MAX) {
+            Offset = DeferredOffset;
+            DeferredOffset = UINT64_MAX;
+        } else if (Random.Next(16) == 0) {
+            DeferredOffset = NextOffset;
+            Offset = NextOffset + Length;
+            NextOffset += 2 * (uint64_t)Length;
+        } else {
+            Offset = NextOffset;
+            NextOffset += Length;
+        }
+
+        uint64_t WriteLength = UINT64_MAX;
+        BOOLEAN ReadyToRead = FALSE;
+        if (QUIC_FAILED(
+                QuicRecvBufferWrite(
+                    &RecvBuffer, Offset, Length, Data.data(), &WriteLength, &ReadyToRead))) {
+            State.SkipWithError("QuicRecvBufferWrite failed");
+            break;
+        }
+
+        if (ReadyToRead) {
+            QUIC_BUFFER Buffers[3];
+            uint32_t BufferCount = ARRAYSIZE(Buffers);
+            uint64_t ReadOffset;
+            while (QuicRecvBufferRead(&RecvBuffer, &ReadOffset, &BufferCount, Buffers)) {
+                uint64_t ReadLength = 0;
+                for (uint32_t i = 0; i < BufferCount; ++i) {
+                    ReadLength += Buffers[i].Length;
+                }
+                if (QuicRecvBufferDrain(&RecvBuffer, ReadLength)) {
+                    break;
+                }
+                BufferCount = ARRAYSIZE(Buffers);
+            }
+        }
+    }
+    State.SetBytesProcessed(State.GetIterations() * Length);
+
+    QuicRecvBufferUninitialize(&RecvBuffer);
+    CxPlatPoolUninitialize(&ChunkPool);
+}
+
+QUIC_BENCHMARK(RecvBufferWrite)->Arg(64)->Arg(1200)->Arg(8192);
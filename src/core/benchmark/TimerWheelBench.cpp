@@ -0,0 +1,84 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for the connection timer wheel.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "TimerWheelBench.cpp.clog.h"
+#endif
+
+#define TIMER_WHEEL_BENCH_UPDATE_COUNT 4096
+
+//
+// Arg is the number of connections in the wheel. Each iteration reschedules
+// one connection; the new expirations mimic a connection's timers: mostly
+// ACK delay and loss detection timers tens of ms out, some pacing timers a
+// few ms out and the occasional idle timeout.
+//
+static
+void
+TimerWheelUpdateConnection(
+    QuicBenchState& State
+    )
+{
+    QuicBenchRandom Random;
+    const uint32_t ConnectionCount = (uint32_t)State.Arg;
+    QUIC_TIMER_WHEEL TimerWheel;
+    if (QUIC_FAILED(QuicTimerWheelInitialize(&TimerWheel))) {
+        State.SkipWithError("QuicTimerWheelInitialize failed");
+        return;
+    }
+
+    //
+    // Only the timer fields of the connections are touched by the wheel.
+    //
+    QUIC_CONNECTION* Connections =
+        (QUIC_CONNECTION*)CXPLAT_ALLOC_NONPAGED(
+            sizeof(QUIC_CONNECTION) * ConnectionCount,
+            QUIC_POOL_TEST);
+    if (Connections == NULL) {
+        QuicTimerWheelUninitialize(&TimerWheel);
+        State.SkipWithError("Allocation failed");
+        return;
+    }
+    CxPlatZeroMemory(Connections, sizeof(QUIC_CONNECTION) * ConnectionCount);
+
+    uint64_t Now = CxPlatTimeUs64();
+    std::vector<uint64_t> Delays;
+    for (uint32_t i = 0; i < TIMER_WHEEL_BENCH_UPDATE_COUNT; ++i) {
+        uint32_t Roll = Random.Next(100);
+        Delays.push_back(
+            Roll < 70 ? MS_TO_US(10 + Random.Next(40)) :
+            Roll < 95 ? 100 + Random.Next(MS_TO_US(5)) :
+            MS_TO_US(30000));
+    }
+
+    for (uint32_t i = 0; i < ConnectionCount; ++i) {
+        Connections[i].Timers[0].ExpirationTime = Now + Delays[i % Delays.size()];
+        QuicTimerWheelUpdateConnection(&TimerWheel, &Connections[i]);
+    }
+
+    uint32_t Index = 0;
+    for (auto _ : State) {
+        QUIC_CONNECTION* Connection = &Connections[Random.Next(ConnectionCount)];
+        Connection->Timers[0].ExpirationTime = Now + Delays[Index];
+        QuicTimerWheelUpdateConnection(&TimerWheel, Connection);
+        Index = (Index + 1) % TIMER_WHEEL_BENCH_UPDATE_COUNT;
+    }
+    State.SetItemsProcessed(State.GetIterations());
+
+    for (uint32_t i = 0; i < ConnectionCount; ++i) {
+        QuicTimerWheelRemoveConnection(&TimerWheel, &Connections[i]);
+    }
+    CXPLAT_FREE(Connections, QUIC_POOL_TEST);
+    QuicTimerWheelUninitialize(&TimerWheel);
+}
+
+QUIC_BENCHMARK(TimerWheelUpdateConnection)->Arg(64)->Arg(1024)->Arg(16384);
@@ -0,0 +1,97 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmarks for the variable length integer encoding and decoding.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "VarIntBench.cpp.clog.h"
+#endif
+
+#define VARINT_BENCH_COUNT 4096
+
+//
+// Arg is the encoded size of every value (1, 2, 4 or 8), or 0 for a mix
+// resembling frame fields: mostly single byte types and lengths, then packet
+// sized lengths, stream offsets and the occasional large value.
+//
+static
+std::vector<uint64_t>
+VarIntBenchValues(
+    _In_ uint64_t Arg
+    )
+{
+    static const uint64_t Max[] = { 0x3F, 0x3FFF, 0x3FFFFFFF, 0x3FFFFFFFFFFFFFFFull };
+    static const uint64_t Min[] = { 0, 0x40, 0x4000, 0x40000000 };
+    QuicBenchRandom Random;
+    std::vector<uint64_t> Values;
+    for (uint32_t i = 0; i < VARINT_BENCH_COUNT; ++i) {
+        uint32_t Size;
+        if (Arg == 0) {
+            uint32_t Roll = Random.Next(100);
+            Size = Roll < 60 ? 0 : Roll < 85 ? 1 : Roll < 95 ? 2 : 3;
+        } else {
+            Size = Arg == 1 ? 0 : Arg == 2 ? 1 : Arg == 4 ? 2 : 3;
+        }
+        Values.push_back(Min[Size] + Random.Next() % (Max[Size] - Min[Size] + 1));
+    }
+    return Values;
+}
+
+static
+void
+VarIntEncode(
+    QuicBenchState& State
+    )
+{
+    std::vector<uint64_t> Values = VarIntBenchValues(State.Arg);
+    std::vector<uint8_t> Buffer(VARINT_BENCH_COUNT * sizeof(uint64_t));
+
+    for (auto _ : State) {
+        uint8_t* Head = Buffer.data();
+        for (uint64_t Value : Values) {
+            Head = QuicVarIntEncode(Value, Head);
+        }
+        QuicBenchDoNotOptimize(Head);
+    }
+
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+
+QUIC_BENCHMARK(VarIntEncode)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+static
+void
+VarIntDecode(
+    QuicBenchState& State
+    )
+{
+    std::vector<uint64_t> Values = VarIntBenchValues(State.Arg);
+    std::vector<uint8_t> Buffer(VARINT_BENCH_COUNT * sizeof(uint64_t));
+    uint8_t* Head = Buffer.data();
+    for (uint64_t Value : Values) {
+        Head = QuicVarIntEncode(Value, Head);
+    }
+    uint16_t Length = (uint16_t)(Head - Buffer.data());
+
+    for (auto _ : State) {
+        uint16_t Offset = 0;
+        QUIC_VAR_INT Value = 0;
+        while (Offset < Length) {
+            if (!QuicVarIntDecode(Length, Buffer.data(), &Offset, &Value)) {
+                break;
+            }
+        }
+        QuicBenchDoNotOptimize(Value);
+    }
+
+    State.SetItemsProcessed(State.GetIterations() * Values.size());
+}
+
+QUIC_BENCHMARK(VarIntDecode)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
@@ -0,0 +1,203 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmark runner. Each registered benchmark is run once per
+    argument, with the iteration count grown until a run takes at least the
+    minimum time, and reported as time per iteration plus throughput.
+
+--*/
+
+#include <math.h>
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "main.cpp.clog.h"
+#endif
+
+#define QUIC_BENCH_DEFAULT_MIN_TIME_MS  500
+#define QUIC_BENCH_MAX_ITERATIONS       1000000000ull
+
+const void* volatile QuicBenchSink;
+
+static
+std::vector<QuicBenchmark*>&
+QuicBenchmarks(
+    )
+{
+    //
+    // Function-local so registration from other translation units' static
+    // initializers doesn't depend on initialization order.
+    //
+    static std::vector<QuicBenchmark*> Benchmarks;
+    return Benchmarks;
+}
+
+QuicBenchmark*
+QuicBenchRegister(
+    _In_z_ const char* Name,
+    _In_ QUIC_BENCH_FN Function
+    )
+{
+    QuicBenchmark* Benchmark = new QuicBenchmark{Name, Function, {}};
+    QuicBenchmarks().push_back(Benchmark);
+    return Benchmark;
+}
+
+//
+// Runs one benchmark/argument pair, growing the iteration count until a run
+// takes at least MinTimeNs. Returns the last (measured) run.
+//
+static
+QuicBenchState
+QuicBenchRun(
+    _In_ const QuicBenchmark* Benchmark,
+    _In_ uint64_t Arg,
+    _In_ uint64_t MinTimeNs
+    )
+{
+    uint64_t Iterations = 1;
+    while (true) {
+        QuicBenchState State(Arg, Iterations);
+        Benchmark->Function(State);
+        if (State.GetError() != nullptr ||
+            State.GetElapsedNs() >= MinTimeNs ||
+            Iterations >= QUIC_BENCH_MAX_ITERATIONS) {
+            return State;
+        }
+
+        //
+        // Aim 40% past the minimum to avoid landing just short of it, but
+        // never grow more than 10x at a time off of a noisy short run.
+        //
+        double Multiplier =
+            State.GetElapsedNs() == 0 ?
+                10.0 : (double)MinTimeNs * 1.4 / (double)State.GetElapsedNs();
+        if (Multiplier > 10.0) {
+            Multiplier = 10.0;
+        }
+        uint64_t Next = (uint64_t)((double)Iterations * Multiplier);
+        Iterations = Next > Iterations ? Next : Iterations + 1;
+        if (Iterations > QUIC_BENCH_MAX_ITERATIONS) {
+            Iterations = QUIC_BENCH_MAX_ITERATIONS;
+        }
+    }
+}
+
+static
+void
+PrintUsage(
+    )
+{
+    printf(
+        "Usage: msquiccorebench [options]\n"
+        "\n"
+        "  --filter=<substring>      Only runs benchmarks whose name contains the substring.\n"
+        "  --min-time-ms=<####>      The minimum measured time per benchmark. (def:%u)\n"
+        "  --repetitions=<####>      Repeats each benchmark and reports the mean and\n"
+        "                            standard deviation. (def:1)\n"
+        "  --list                    Lists the benchmarks without running them.\n",
+        QUIC_BENCH_DEFAULT_MIN_TIME_MS);
+}
+
+int main(int argc, char** argv) {
+    const char* Filter = nullptr;
+    uint32_t MinTimeMs = QUIC_BENCH_DEFAULT_MIN_TIME_MS;
+    uint32_t Repetitions = 1;
+    bool ListOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--filter=", 9) == 0) {
+            Filter = argv[i] + 9;
+        } else if (strncmp(argv[i], "--min-time-ms=", 14) == 0) {
+            MinTimeMs = (uint32_t)strtoul(argv[i] + 14, nullptr, 10);
+        } else if (strncmp(argv[i], "--repetitions=", 14) == 0) {
+            Repetitions = (uint32_t)strtoul(argv[i] + 14, nullptr, 10);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            ListOnly = true;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (Repetitions == 0) {
+        Repetitions = 1;
+    }
+
+    CxPlatSystemLoad();
+    if (QUIC_FAILED(CxPlatInitialize())) {
+        printf("Platform failed to initialize\n");
+        CxPlatSystemUnload();
+        return 1;
+    }
+
+    int Result = 0;
+    if (!ListOnly) {
+        printf(
+            "%-40s %14s %14s %12s %14s\n",
+            "Benchmark", "Time (ns)", "StdDev (ns)", "Iterations", "Throughput");
+    }
+
+    for (const QuicBenchmark* Benchmark : QuicBenchmarks()) {
+        for (uint64_t Arg : Benchmark->Args) {
+            char Name[128];
+            snprintf(Name, sizeof(Name), "%s/%llu", Benchmark->Name, (unsigned long long)Arg);
+            if (Filter != nullptr && strstr(Name, Filter) == nullptr) {
+                continue;
+            }
+            if (ListOnly) {
+                printf("%s\n", Name);
+                continue;
+            }
+
+            double Sum = 0, SumSquares = 0, BytesPerSecond = 0, ItemsPerSecond = 0;
+            uint64_t Iterations = 0;
+            const char* Error = nullptr;
+            for (uint32_t i = 0; i < Repetitions && Error == nullptr; ++i) {
+                QuicBenchState State =
+                    QuicBenchRun(Benchmark, Arg, MS_TO_US((uint64_t)MinTimeMs) * 1000);
+                Error = State.GetError();
+                if (State.GetElapsedNs() == 0) {
+                    continue;
+                }
+                double NsPerIteration =
+                    (double)State.GetElapsedNs() / (double)State.GetIterations();
+                double Seconds = (double)State.GetElapsedNs() / 1e9;
+                Sum += NsPerIteration;
+                SumSquares += NsPerIteration * NsPerIteration;
+                BytesPerSecond += (double)State.GetBytesProcessed() / Seconds;
+                ItemsPerSecond += (double)State.GetItemsProcessed() / Seconds;
+                Iterations = State.GetIterations();
+            }
+            if (Error != nullptr) {
+                printf("%-40s ERROR: %s\n", Name, Error);
+                Result = 1;
+                continue;
+            }
+
+            double Mean = Sum / Repetitions;
+            double Variance =
+                Repetitions > 1 ? (SumSquares - Sum * Mean) / (Repetitions - 1) : 0;
+            printf(
+                "%-40s %14.1f %14.1f %12llu",
+                Name,
+                Mean,
+                Variance > 0 ? sqrt(Variance) : 0.0,
+                (unsigned long long)Iterations);
+            if (BytesPerSecond != 0) {
+                printf(" %9.3f MB/s", BytesPerSecond / Repetitions / 1e6);
+            } else if (ItemsPerSecond != 0) {
+                printf(" %10.3f M/s", ItemsPerSecond / Repetitions / 1e6);
+            }
+            printf("\n");
+        }
+    }
+
+    CxPlatUninitialize();
+    CxPlatSystemUnload();
+
+    return Result;
+}
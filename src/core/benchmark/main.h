@@ -0,0 +1,159 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Micro-benchmark harness for the core data structures. The interface is
+    modeled after Google Benchmark: a benchmark is a function that runs its
+    measured code in a `for (auto _ : State)` loop, registered once per input
+    size with QUIC_BENCHMARK(Function)->Arg(...).
+
+--*/
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "precomp.h"
+
+#undef min // STL headers conflict with previous definitions of min/max.
+#undef max
+
+class QuicBenchState;
+
+typedef void (*QUIC_BENCH_FN)(QuicBenchState& State);
+
+struct QuicBenchmark {
+    const char* Name;
+    QUIC_BENCH_FN Function;
+    std::vector<uint64_t> Args;
+
+    QuicBenchmark* Arg(uint64_t Value) {
+        Args.push_back(Value);
+        return this;
+    }
+};
+
+QuicBenchmark*
+QuicBenchRegister(
+    _In_z_ const char* Name,
+    _In_ QUIC_BENCH_FN Function
+    );
+
+#define QUIC_BENCH_CONCAT2(a, b) a##b
+#define QUIC_BENCH_CONCAT(a, b) QUIC_BENCH_CONCAT2(a, b)
+
+#define QUIC_BENCHMARK(Function) \
+    [[maybe_unused]] static QuicBenchmark* QUIC_BENCH_CONCAT(Function, _Registration) = \
+        QuicBenchRegister(#Function, Function)
+
+class QuicBenchState {
+public:
+    //
+    // The input size the benchmark was registered with.
+    //
+    const uint64_t Arg;
+
+    QuicBenchState(uint64_t Arg, uint64_t Iterations)
+        : Arg(Arg), Iterations(Iterations) { }
+
+    //
+    // The loop variable's type is marked unused so `for (auto _ : State)`
+    // compiles cleanly.
+    //
+    struct [[maybe_unused]] Value { };
+
+    struct Iterator {
+        QuicBenchState* State;
+        uint64_t Remaining;
+        bool operator!=(const Iterator&) {
+            if (Remaining != 0) {
+                return true;
+            }
+            State->PauseTiming();
+            return false;
+        }
+        void operator++() { --Remaining; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin() {
+        ResumeTiming();
+        return Iterator{this, Iterations};
+    }
+    Iterator end() { return Iterator{this, 0}; }
+
+    //
+    // Excludes per-iteration setup from the measurement. Each call costs a
+    // clock read, so only use these around work that is much slower.
+    //
+    void PauseTiming() {
+        ElapsedNs += NowNs() - StartNs;
+    }
+    void ResumeTiming() {
+        StartNs = NowNs();
+    }
+
+    void SetBytesProcessed(uint64_t Bytes) { BytesProcessed = Bytes; }
+    void SetItemsProcessed(uint64_t Items) { ItemsProcessed = Items; }
+    void SkipWithError(_In_z_ const char* Message) { Error = Message; }
+
+    uint64_t GetIterations() const { return Iterations; }
+    uint64_t GetElapsedNs() const { return ElapsedNs; }
+    uint64_t GetBytesProcessed() const { return BytesProcessed; }
+    uint64_t GetItemsProcessed() const { return ItemsProcessed; }
+    const char* GetError() const { return Error; }
+
+private:
+    static uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const uint64_t Iterations;
+    uint64_t StartNs {0};
+    uint64_t ElapsedNs {0};
+    uint64_t BytesProcessed {0};
+    uint64_t ItemsProcessed {0};
+    const char* Error {nullptr};
+};
+
+//
+// Keeps the compiler from optimizing away a value that is otherwise unused.
+//
+extern const void* volatile QuicBenchSink;
+
+template <class T>
+inline
+void
+QuicBenchDoNotOptimize(
+    T const& Value
+    )
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    QuicBenchSink = &Value;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(Value) : "memory");
+#endif
+}
+
+//
+// Deterministic random numbers, so every run measures the same inputs.
+//
+struct QuicBenchRandom {
+    uint64_t State;
+    QuicBenchRandom(uint64_t Seed = 0x9E3779B97F4A7C15ull) : State(Seed) { }
+    uint64_t Next() {
+        State ^= State >> 12;
+        State ^= State << 25;
+        State ^= State >> 27;
+        return State * 0x2545F4914F6CDD1Dull;
+    }
+    uint32_t Next(uint32_t Bound) {
+        return (uint32_t)(Next() % Bound);
+    }
+};
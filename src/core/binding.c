@@ -68,6 +68,7 @@ QuicBindingInitialize(
     Binding->Connected = RemoteAddress == NULL ? FALSE : TRUE;
     Binding->StatelessOperCount = 0;
     Binding->ResetTokenHash = NULL;
+    CxPlatZeroMemory(&Binding->Stats, sizeof(Binding->Stats));
     CxPlatDispatchRwLockInitialize(&Binding->RwLock);
     CxPlatDispatchLockInitialize(&Binding->ResetTokenLock);
     CxPlatDispatchLockInitialize(&Binding->StatelessOperLock);
@@ -239,6 +240,30 @@ QuicBindingUninitialize(
     CXPLAT_FREE(Binding, QUIC_POOL_BINDING);
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingGetStatistics(
+    _In_ QUIC_BINDING* Binding,
+    _Out_ QUIC_BINDING_STATISTICS* Stats
+    )
+{
+    CxPlatZeroMemory(Stats, sizeof(*Stats));
+    CxPlatSocketGetLocalAddress(Binding->Socket, &Stats->LocalAddress);
+    if (Binding->Connected) {
+        CxPlatSocketGetRemoteAddress(Binding->Socket, &Stats->RemoteAddress);
+    }
+    Stats->Exclusive = Binding->Exclusive;
+    Stats->ServerOwned = Binding->ServerOwned;
+    Stats->Connected = Binding->Connected;
+    Stats->Recv.Datagrams = Binding->Stats.Recv.Datagrams;
+    Stats->Recv.Bytes = Binding->Stats.Recv.Bytes;
+    Stats->Recv.DroppedPackets = Binding->Stats.Recv.DroppedPackets;
+    Stats->Stateless.VersionNegotiation = Binding->Stats.Stateless.VersionNegotiation;
+    Stats->Stateless.StatelessReset = Binding->Stats.Stateless.StatelessReset;
+    Stats->Stateless.Retry = Binding->Stats.Stateless.Retry;
+    Stats->Stateless.DroppedOperations = Binding->Stats.Stateless.DroppedOperations;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicBindingTraceRundown(
@@ -697,23 +722,25 @@ QuicBindingQueueStatelessOperation(
     _In_ CXPLAT_RECV_DATA* Datagram
     )
 {
+    BOOLEAN Queued = FALSE;
+
     if (MsQuicLib.StatelessRegistration == NULL) {
         QuicPacketLogDrop(Binding, CxPlatDataPathRecvDataToRecvPacket(Datagram),
             "NULL stateless registration");
-        return FALSE;
+        goto Exit;
     }
 
     QUIC_WORKER* Worker = QuicLibraryGetWorker(Datagram);
     if (QuicWorkerIsOverloaded(Worker)) {
         QuicPacketLogDrop(Binding, CxPlatDataPathRecvDataToRecvPacket(Datagram),
             "Stateless worker overloaded (stateless oper)");
-        return FALSE;
+        goto Exit;
     }
 
     QUIC_STATELESS_CONTEXT* Context =
         QuicBindingCreateStatelessOperation(Binding, Worker, Datagram);
     if (Context == NULL) {
-        return FALSE;
+        goto Exit;
     }
 
     QUIC_OPERATION* Oper = QuicOperationAlloc(Worker, OperType);
@@ -728,13 +755,20 @@ QuicBindingQueueStatelessOperation(
             CxPlatDataPathRecvDataToRecvPacket(Datagram),
             "Alloc failure for stateless operation");
         QuicBindingReleaseStatelessOperation(Context, FALSE);
-        return FALSE;
+        goto Exit;
     }
 
     Oper->STATELESS.Context = Context;
     QuicWorkerQueueOperation(Worker, Oper);
+    Queued = TRUE;
 
-    return TRUE;
+Exit:
+
+    if (!Queued) {
+        InterlockedIncrement64((int64_t*)&Binding->Stats.Stateless.DroppedOperations);
+    }
+
+    return Queued;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -952,11 +986,12 @@ QuicBindingProcessStatelessOperation(
             CxPlatCopyMemory(Iv, NewDestCid, MsQuicLib.CidTotalLength);
         }
 
-        CxPlatDispatchLockAcquire(&MsQuicLib.StatelessRetryKeysLock);
+        QUIC_LIBRARY_PP* PerProc = &MsQuicLib.PerProc[CxPlatProcCurrentNumber()];
+        CxPlatDispatchLockAcquire(&PerProc->StatelessRetryKeysLock);
 
-        CXPLAT_KEY* StatelessRetryKey = QuicLibraryGetCurrentStatelessRetryKey();
+        CXPLAT_KEY* StatelessRetryKey = QuicLibraryGetCurrentStatelessRetryKey(PerProc);
         if (StatelessRetryKey == NULL) {
-            CxPlatDispatchLockRelease(&MsQuicLib.StatelessRetryKeysLock);
+            CxPlatDispatchLockRelease(&PerProc->StatelessRetryKeysLock);
             goto Exit;
         }
 
@@ -967,7 +1002,7 @@ QuicBindingProcessStatelessOperation(
                 sizeof(Token.Authenticated), (uint8_t*) &Token.Authenticated,
                 sizeof(Token.Encrypted) + sizeof(Token.EncryptionTag), (uint8_t*)&(Token.Encrypted));
 
-        CxPlatDispatchLockRelease(&MsQuicLib.StatelessRetryKeysLock);
+        CxPlatDispatchLockRelease(&PerProc->StatelessRetryKeysLock);
         if (QUIC_FAILED(Status)) {
             goto Exit;
         }
@@ -998,6 +1033,13 @@ QuicBindingProcessStatelessOperation(
         goto Exit;
     }
 
+    InterlockedIncrement64(
+        (int64_t*)(OperationType == QUIC_OPER_TYPE_VERSION_NEGOTIATION ?
+            &Binding->Stats.Stateless.VersionNegotiation :
+         OperationType == QUIC_OPER_TYPE_STATELESS_RESET ?
+            &Binding->Stats.Stateless.StatelessReset :
+            &Binding->Stats.Stateless.Retry));
+
     QuicBindingSend(
         Binding,
         &RecvDatagram->Tuple->LocalAddress,
@@ -1211,6 +1253,9 @@ QuicBindingShouldRetryConnection(
     // connections in the handshake state already. If so, it requests the client
     // to retry its connection attempt to prove source address ownership.
     //
+    // If admission control is enabled, it gets the final say for both
+    // validated and unvalidated connection attempts.
+    //
 
     if (TokenLength != 0) {
         //
@@ -1220,7 +1265,40 @@ QuicBindingShouldRetryConnection(
             Packet->ValidToken = TRUE;
         } else {
             *DropPacket = TRUE;
+            return FALSE;
         }
+    }
+
+    const uint32_t AdmissionInitialRate = MsQuicLib.Settings.AdmissionInitialRate;
+    if (AdmissionInitialRate != 0) {
+        const CXPLAT_RECV_DATA* Datagram =
+            CxPlatDataPathRecvPacketToRecvData(Packet);
+        switch (
+            QuicAdmissionCheck(
+                &MsQuicLib.Admission,
+                AdmissionInitialRate,
+                &Datagram->Tuple->RemoteAddress,
+                Packet->ValidToken,
+                CxPlatTimeMs32())) {
+        case QUIC_ADMISSION_RETRY:
+            QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_ADMIT_RETRY);
+            return TRUE;
+        case QUIC_ADMISSION_RATE_LIMITED:
+            QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_ADMIT_LIMITED);
+            QuicPacketLogDrop(Binding, Packet, "Source prefix over admission rate");
+            *DropPacket = TRUE;
+            return FALSE;
+        case QUIC_ADMISSION_DROP:
+            QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_ADMIT_DROPPED);
+            QuicPacketLogDrop(Binding, Packet, "Unvalidated attempt dropped by admission");
+            *DropPacket = TRUE;
+            return FALSE;
+        default:
+            break;
+        }
+    }
+
+    if (Packet->ValidToken) {
         return FALSE;
     }
 
@@ -1650,6 +1728,8 @@ QuicBindingReceive(
         CxPlatRecvDataReturn(ReleaseChain);
     }
 
+    InterlockedExchangeAdd64((int64_t*)&Binding->Stats.Recv.Datagrams, TotalChainLength);
+    InterlockedExchangeAdd64((int64_t*)&Binding->Stats.Recv.Bytes, TotalDatagramBytes);
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_RECV, TotalChainLength);
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_UDP_RECV_BYTES, TotalDatagramBytes);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_UDP_RECV_EVENTS);
@@ -71,6 +71,13 @@ typedef struct CXPLAT_RECV_PACKET {
     //
     uint16_t PayloadLength;
 
+    //
+    // Number of streams currently indicating payload from this packet in
+    // place to the app. The datagram isn't returned to the datapath until
+    // this drops back to zero.
+    //
+    uint16_t InPlaceRefCount;
+
     //
     // Lengths of the destination and source connection IDs
     //
@@ -145,6 +152,13 @@ typedef struct CXPLAT_RECV_PACKET {
     //
     BOOLEAN HasNonProbingFrame : 1;
 
+    //
+    // Flag indicating the connection is done with the packet, but at least
+    // one stream still holds it in place, so the last stream to complete
+    // its receive must return it.
+    //
+    BOOLEAN ReleaseInPlace : 1;
+
 } CXPLAT_RECV_PACKET;
 
 typedef enum QUIC_BINDING_LOOKUP_TYPE {
@@ -238,12 +252,25 @@ typedef struct QUIC_BINDING {
     CXPLAT_POOL StatelessOperCtxPool;
     uint32_t StatelessOperCount;
 
+    //
+    // Statistics, updated with interlocked operations since receives and
+    // stateless operations are processed concurrently.
+    //
     struct {
 
         struct {
+            uint64_t Datagrams;
+            uint64_t Bytes;
             uint64_t DroppedPackets;
         } Recv;
 
+        struct {
+            uint64_t VersionNegotiation;
+            uint64_t StatelessReset;
+            uint64_t Retry;
+            uint64_t DroppedOperations;
+        } Stateless;
+
     } Stats;
 
 } QUIC_BINDING;
@@ -289,6 +316,16 @@ QuicBindingTraceRundown(
     _In_ QUIC_BINDING* Binding
     );
 
+//
+// Fills in the statistics for the binding.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicBindingGetStatistics(
+    _In_ QUIC_BINDING* Binding,
+    _Out_ QUIC_BINDING_STATISTICS* Stats
+    );
+
 //
 // Looks up the listener based on the ALPN list. Optionally, outputs the
 // first ALPN that matches.
@@ -475,13 +512,15 @@ QuicRetryTokenDecrypt(
         CxPlatCopyMemory(Iv, Packet->DestCid, MsQuicLib.CidTotalLength);
     }
 
-    CxPlatDispatchLockAcquire(&MsQuicLib.StatelessRetryKeysLock);
+    QUIC_LIBRARY_PP* PerProc = &MsQuicLib.PerProc[CxPlatProcCurrentNumber()];
+    CxPlatDispatchLockAcquire(&PerProc->StatelessRetryKeysLock);
 
     CXPLAT_KEY* StatelessRetryKey =
         QuicLibraryGetStatelessRetryKeyForTimestamp(
+            PerProc,
             Token->Authenticated.Timestamp);
     if (StatelessRetryKey == NULL) {
-        CxPlatDispatchLockRelease(&MsQuicLib.StatelessRetryKeysLock);
+        CxPlatDispatchLockRelease(&PerProc->StatelessRetryKeysLock);
         return FALSE;
     }
 
@@ -494,6 +533,6 @@ QuicRetryTokenDecrypt(
             sizeof(Token->Encrypted) + sizeof(Token->EncryptionTag),
             (uint8_t*)&Token->Encrypted);
 
-    CxPlatDispatchLockRelease(&MsQuicLib.StatelessRetryKeysLock);
+    CxPlatDispatchLockRelease(&PerProc->StatelessRetryKeysLock);
     return QUIC_SUCCEEDED(Status);
 }
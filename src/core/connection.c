@@ -107,6 +107,9 @@ QuicConnAlloc(
         Connection,
         IsServer,
         Connection->Stats.CorrelationId);
+#ifdef QUIC_QLOG_SUPPORT
+    Connection->Qlog = QuicQlogOpen(Connection->Stats.CorrelationId, IsServer);
+#endif
 
     Connection->RefCount = 1;
 #if DEBUG
@@ -341,6 +344,7 @@ QuicConnFree(
     }
     if (Connection->Worker != NULL) {
         QuicOperationQueueClear(Connection->Worker, &Connection->OperQ);
+        InterlockedDecrement(&Connection->Worker->ConnectionCount);
     }
     if (Connection->ReceiveQueue != NULL) {
         CXPLAT_RECV_DATA* Datagram = Connection->ReceiveQueue;
@@ -377,6 +381,12 @@ QuicConnFree(
             Connection->HandshakeTP);
         Connection->HandshakeTP = NULL;
     }
+#ifdef QUIC_QLOG_SUPPORT
+    if (Connection->Qlog != NULL) {
+        QuicQlogClose(Connection->Qlog);
+        Connection->Qlog = NULL;
+    }
+#endif
     QuicCryptoTlsCleanupTransportParameters(&Connection->PeerTransportParams);
     if (Connection->ReceivedNegotiationVersions != NULL) {
         CXPLAT_FREE(Connection->ReceivedNegotiationVersions, QUIC_POOL_RECVD_VER_LIST);
@@ -761,6 +771,7 @@ QuicConnUpdateRtt(
     }
 
     Path->LatestRttSample = LatestRtt;
+    QuicLatencyHistogramRecord(QUIC_LATENCY_HISTOGRAM_RTT, LatestRtt);
     if (LatestRtt < Path->MinRtt) {
         Path->MinRtt = LatestRtt;
     }
@@ -2014,7 +2025,8 @@ QuicConnRecvResumptionTicket(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint16_t TicketLength,
     _In_reads_(TicketLength)
-        const uint8_t* Ticket
+        const uint8_t* Ticket,
+    _Inout_opt_ BOOLEAN* EarlyDataAccepted
     )
 {
     BOOLEAN ResumptionAccepted = FALSE;
@@ -2060,6 +2072,29 @@ QuicConnRecvResumptionTicket(
             goto Error;
         }
 
+        //
+        // If the peer offered early data with the ticket, make sure the ticket
+        // hasn't been used for 0-RTT already (i.e. isn't being replayed). TLS
+        // commits to accepting early data along with the ticket, so this can't
+        // wait until the 0-RTT keys are installed. A possible replay only
+        // costs the early data; the handshake still resumes in 1-RTT.
+        //
+        if (EarlyDataAccepted != NULL && *EarlyDataAccepted &&
+            Connection->Settings.ServerResumptionLevel == QUIC_SERVER_RESUME_AND_ZERORTT &&
+            !QuicReplayFilterCheck(
+                &MsQuicLib.ReplayFilter,
+                Ticket + TicketLength - QUIC_TICKET_IDENTITY_LENGTH,
+                CxPlatTimeEpochMs64(),
+                US_TO_MS(CxPlatTimeUs64()))) {
+            QuicTraceEvent(
+                ConnError,
+                "[conn][%p] ERROR, %s.",
+                Connection,
+                "Resumption Ticket possibly replayed or too old for 0-RTT");
+            QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_0RTT_REPLAY_REJECT);
+            *EarlyDataAccepted = FALSE;
+        }
+
         QUIC_CONNECTION_EVENT Event;
         Event.Type = QUIC_CONNECTION_EVENT_RESUMED;
         Event.RESUMED.ResumptionStateLength = (uint16_t)AppDataLength;
@@ -2797,7 +2832,12 @@ QuicConnPeerCertReceived(
         "Indicating QUIC_CONNECTION_EVENT_PEER_CERTIFICATE_RECEIVED (0x%x, 0x%x)",
         DeferredErrorFlags,
         DeferredStatus);
+    const uint32_t CertValidationStart = CxPlatTimeUs32();
     QUIC_STATUS Status = QuicConnIndicateEvent(Connection, &Event);
+    QuicConnAddHandshakeTime(
+        Connection,
+        &Connection->Stats.HandshakeTiming.CertValidation,
+        CertValidationStart);
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             ConnError,
@@ -3229,6 +3269,7 @@ QuicConnRecvRetry(
             Link);
 
     QUIC_STATUS Status;
+    const uint32_t KeyDeriveStart = CxPlatTimeUs32();
     if (QUIC_FAILED(
         Status =
         QuicPacketKeyCreateInitial(
@@ -3241,6 +3282,10 @@ QuicConnRecvRetry(
         QuicConnFatalError(Connection, Status, "Failed to create initial keys");
         return;
     }
+    QuicConnAddHandshakeTime(
+        Connection,
+        &Connection->Stats.HandshakeTiming.KeyDerive,
+        KeyDeriveStart);
 
     Connection->Stats.StatelessRetry = TRUE;
 
@@ -3862,6 +3907,12 @@ QuicConnRecvDecryptAndAuthenticate(
         Packet->PacketNumber,
         Packet->IsShortHeader ? QUIC_TRACE_PACKET_ONE_RTT : (Packet->LH->Type + 1),
         Packet->HeaderLength + Packet->PayloadLength);
+    QuicConnQlog(
+        Connection,
+        PacketReceived,
+        Packet->IsShortHeader ? QUIC_TRACE_PACKET_ONE_RTT : (uint8_t)(Packet->LH->Type + 1),
+        Packet->PacketNumber,
+        Packet->HeaderLength + Packet->PayloadLength);
 
     //
     // Process any connection ID updates as necessary.
@@ -4244,7 +4295,7 @@ QuicConnRecvFrames(
                 QUIC_STATUS Status =
                     QuicStreamRecv(
                         Stream,
-                        Packet->EncryptedWith0Rtt,
+                        Packet,
                         FrameType,
                         PayloadLength,
                         Payload,
@@ -4317,6 +4368,15 @@ QuicConnRecvFrames(
                 break; // Ignore frame if we are closed.
             }
 
+            QuicConnQlog(
+                Connection,
+                FlowControlFrame,
+                FALSE,
+                QUIC_FRAME_MAX_DATA,
+                Packet->PacketNumber,
+                0,
+                Frame.MaximumData);
+
             if (Connection->Send.PeerMaxData < Frame.MaximumData) {
                 Connection->Send.PeerMaxData = Frame.MaximumData;
                 //
@@ -4383,14 +4443,28 @@ QuicConnRecvFrames(
                 break; // Ignore frame if we are closed.
             }
 
-            //
-            // TODO - Should we do anything else with this?
-            //
+            QuicConnQlog(
+                Connection,
+                FlowControlFrame,
+                FALSE,
+                QUIC_FRAME_DATA_BLOCKED,
+                Packet->PacketNumber,
+                0,
+                Frame.DataLimit);
+
             QuicTraceLogConnVerbose(
                 PeerConnFCBlocked,
                 Connection,
                 "Peer Connection FC blocked (%llu)",
                 Frame.DataLimit);
+            if (Frame.DataLimit >= Connection->Send.MaxData) {
+                //
+                // The app hasn't freed up any credit since the last MAX_DATA,
+                // so the one sent now won't unblock the peer. Make sure the
+                // next increase goes out as soon as there is one.
+                //
+                Connection->Send.PeerDataBlocked = TRUE;
+            }
             QuicSendSetSendFlag(&Connection->Send, QUIC_CONN_SEND_FLAG_MAX_DATA);
 
             AckPacketImmediately = TRUE;
@@ -5016,6 +5090,36 @@ QuicConnRecvDatagramBatch(
     }
 }
 
+//
+// Returns a chain of processed datagrams to the datapath. Any datagram still
+// referenced in place by a pending stream receive is unlinked from the chain
+// instead, and returned by the last stream to complete its receive.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicConnReturnRecvDatagrams(
+    _In_ CXPLAT_RECV_DATA* DatagramChain
+    )
+{
+    CXPLAT_RECV_DATA** Link = &DatagramChain;
+    while (*Link != NULL) {
+        CXPLAT_RECV_DATA* Datagram = *Link;
+        CXPLAT_RECV_PACKET* Packet =
+            CxPlatDataPathRecvDataToRecvPacket(Datagram);
+        if (Packet->InPlaceRefCount != 0) {
+            *Link = Datagram->Next;
+            Datagram->Next = NULL;
+            Packet->ReleaseInPlace = TRUE;
+        } else {
+            Link = &Datagram->Next;
+        }
+    }
+
+    if (DatagramChain != NULL) {
+        CxPlatRecvDataReturn(DatagramChain);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicConnRecvDatagrams(
@@ -5222,7 +5326,7 @@ QuicConnRecvDatagrams(
                         &RecvState);
                     BatchCount = 0;
                 }
-                CxPlatRecvDataReturn(ReleaseChain);
+                QuicConnReturnRecvDatagrams(ReleaseChain);
                 ReleaseChain = NULL;
                 ReleaseChainTail = &ReleaseChain;
                 ReleaseChainCount = 0;
@@ -5246,7 +5350,7 @@ QuicConnRecvDatagrams(
     }
 
     if (ReleaseChain != NULL) {
-        CxPlatRecvDataReturn(ReleaseChain);
+        QuicConnReturnRecvDatagrams(ReleaseChain);
     }
 
     if (QuicConnIsServer(Connection) &&
@@ -5962,6 +6066,49 @@ QuicConnParamSet(
     return Status;
 }
 
+//
+// Fills in the connection's (version 1) statistics.
+//
+static
+void
+QuicConnGetStatistics(
+    _In_ const QUIC_CONNECTION* Connection,
+    _Out_ QUIC_STATISTICS* Stats
+    )
+{
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    Stats->CorrelationId = Connection->Stats.CorrelationId;
+    Stats->VersionNegotiation = Connection->Stats.VersionNegotiation;
+    Stats->StatelessRetry = Connection->Stats.StatelessRetry;
+    Stats->ResumptionAttempted = Connection->Stats.ResumptionAttempted;
+    Stats->ResumptionSucceeded = Connection->Stats.ResumptionSucceeded;
+    Stats->Rtt = Path->SmoothedRtt;
+    Stats->MinRtt = Path->MinRtt;
+    Stats->MaxRtt = Path->MaxRtt;
+    Stats->Timing.Start = Connection->Stats.Timing.Start;
+    Stats->Timing.InitialFlightEnd = Connection->Stats.Timing.InitialFlightEnd;
+    Stats->Timing.HandshakeFlightEnd = Connection->Stats.Timing.HandshakeFlightEnd;
+    Stats->Send.PathMtu = Path->Mtu;
+    Stats->Send.TotalPackets = Connection->Stats.Send.TotalPackets;
+    Stats->Send.RetransmittablePackets = Connection->Stats.Send.RetransmittablePackets;
+    Stats->Send.SuspectedLostPackets = Connection->Stats.Send.SuspectedLostPackets;
+    Stats->Send.SpuriousLostPackets = Connection->Stats.Send.SpuriousLostPackets;
+    Stats->Send.TotalBytes = Connection->Stats.Send.TotalBytes;
+    Stats->Send.TotalStreamBytes = Connection->Stats.Send.TotalStreamBytes;
+    Stats->Send.CongestionCount = Connection->Stats.Send.CongestionCount;
+    Stats->Send.PersistentCongestionCount = Connection->Stats.Send.PersistentCongestionCount;
+    Stats->Recv.TotalPackets = Connection->Stats.Recv.TotalPackets;
+    Stats->Recv.ReorderedPackets = Connection->Stats.Recv.ReorderedPackets;
+    Stats->Recv.DroppedPackets = Connection->Stats.Recv.DroppedPackets;
+    Stats->Recv.DuplicatePackets = Connection->Stats.Recv.DuplicatePackets;
+    Stats->Recv.TotalBytes = Connection->Stats.Recv.TotalBytes;
+    Stats->Recv.TotalStreamBytes = Connection->Stats.Recv.TotalStreamBytes;
+    Stats->Recv.DecryptionFailures = Connection->Stats.Recv.DecryptionFailures;
+    Stats->Recv.ValidAckFrames = Connection->Stats.Recv.ValidAckFrames;
+    Stats->Misc.KeyUpdateCount = Connection->Stats.Misc.KeyUpdateCount;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicConnParamGet(
@@ -6117,37 +6264,7 @@ QuicConnParamGet(
         }
 
         QUIC_STATISTICS* Stats = (QUIC_STATISTICS*)Buffer;
-        const QUIC_PATH* Path = &Connection->Paths[0];
-
-        Stats->CorrelationId = Connection->Stats.CorrelationId;
-        Stats->VersionNegotiation = Connection->Stats.VersionNegotiation;
-        Stats->StatelessRetry = Connection->Stats.StatelessRetry;
-        Stats->ResumptionAttempted = Connection->Stats.ResumptionAttempted;
-        Stats->ResumptionSucceeded = Connection->Stats.ResumptionSucceeded;
-        Stats->Rtt = Path->SmoothedRtt;
-        Stats->MinRtt = Path->MinRtt;
-        Stats->MaxRtt = Path->MaxRtt;
-        Stats->Timing.Start = Connection->Stats.Timing.Start;
-        Stats->Timing.InitialFlightEnd = Connection->Stats.Timing.InitialFlightEnd;
-        Stats->Timing.HandshakeFlightEnd = Connection->Stats.Timing.HandshakeFlightEnd;
-        Stats->Send.PathMtu = Path->Mtu;
-        Stats->Send.TotalPackets = Connection->Stats.Send.TotalPackets;
-        Stats->Send.RetransmittablePackets = Connection->Stats.Send.RetransmittablePackets;
-        Stats->Send.SuspectedLostPackets = Connection->Stats.Send.SuspectedLostPackets;
-        Stats->Send.SpuriousLostPackets = Connection->Stats.Send.SpuriousLostPackets;
-        Stats->Send.TotalBytes = Connection->Stats.Send.TotalBytes;
-        Stats->Send.TotalStreamBytes = Connection->Stats.Send.TotalStreamBytes;
-        Stats->Send.CongestionCount = Connection->Stats.Send.CongestionCount;
-        Stats->Send.PersistentCongestionCount = Connection->Stats.Send.PersistentCongestionCount;
-        Stats->Recv.TotalPackets = Connection->Stats.Recv.TotalPackets;
-        Stats->Recv.ReorderedPackets = Connection->Stats.Recv.ReorderedPackets;
-        Stats->Recv.DroppedPackets = Connection->Stats.Recv.DroppedPackets;
-        Stats->Recv.DuplicatePackets = Connection->Stats.Recv.DuplicatePackets;
-        Stats->Recv.TotalBytes = Connection->Stats.Recv.TotalBytes;
-        Stats->Recv.TotalStreamBytes = Connection->Stats.Recv.TotalStreamBytes;
-        Stats->Recv.DecryptionFailures = Connection->Stats.Recv.DecryptionFailures;
-        Stats->Recv.ValidAckFrames = Connection->Stats.Recv.ValidAckFrames;
-        Stats->Misc.KeyUpdateCount = Connection->Stats.Misc.KeyUpdateCount;
+        QuicConnGetStatistics(Connection, Stats);
 
         if (Param == QUIC_PARAM_CONN_STATISTICS_PLAT) {
             Stats->Timing.Start = CxPlatTimeUs64ToPlat(Stats->Timing.Start); // cppcheck-suppress selfAssignment
@@ -6160,6 +6277,34 @@ QuicConnParamGet(
         break;
     }
 
+    case QUIC_PARAM_CONN_STATISTICS_V2: {
+
+        if (*BufferLength < sizeof(QUIC_STATISTICS_V2)) {
+            *BufferLength = sizeof(QUIC_STATISTICS_V2);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QUIC_STATISTICS_V2* Stats = (QUIC_STATISTICS_V2*)Buffer;
+        QuicConnGetStatistics(Connection, &Stats->V1);
+        Stats->HandshakeTiming.TlsProcessTime = Connection->Stats.HandshakeTiming.TlsProcess;
+        Stats->HandshakeTiming.TlsOffloadTime = Connection->Stats.HandshakeTiming.TlsOffload;
+        Stats->HandshakeTiming.CertValidationTime = Connection->Stats.HandshakeTiming.CertValidation;
+        Stats->HandshakeTiming.KeyDeriveTime = Connection->Stats.HandshakeTiming.KeyDerive;
+        Stats->HandshakeTiming.QueueWaitTime = Connection->Stats.HandshakeTiming.QueueWait;
+        Stats->HandshakeTiming.PacingBlockedTime = Connection->Stats.HandshakeTiming.PacingBlocked;
+        Stats->HandshakeTiming.AmplificationBlockedTime = Connection->Stats.HandshakeTiming.AmplificationBlocked;
+
+        *BufferLength = sizeof(QUIC_STATISTICS_V2);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
     case QUIC_PARAM_CONN_SHARE_UDP_BINDING:
 
         if (*BufferLength < sizeof(uint8_t)) {
@@ -6555,6 +6700,12 @@ QuicConnProcessApiOperation(
         QuicDatagramSendFlush(&Connection->Datagram);
         break;
 
+    case QUIC_API_TYPE_STRM_SEND_BATCH:
+        for (uint32_t i = 0; i < ApiCtx->STRM_SEND_BATCH.StreamCount; ++i) {
+            QuicStreamSendFlush(ApiCtx->STRM_SEND_BATCH.Streams[i]);
+        }
+        break;
+
     default:
         CXPLAT_TEL_ASSERT(FALSE);
         Status = QUIC_STATUS_INVALID_PARAMETER;
@@ -6633,6 +6784,7 @@ QuicConnDrainOperations(
         }
     }
 
+    uint64_t OperStartTime = CxPlatTimeUs64();
     while (!Connection->State.HandleClosed &&
            !Connection->State.UpdateWorker &&
            OperationCount++ < MaxOperationCount) {
@@ -6711,6 +6863,16 @@ QuicConnDrainOperations(
 
         Connection->Stats.Schedule.OperationCount++;
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_COMPLETED);
+
+        //
+        // The end of one operation is the start of the next, so only one time
+        // query is needed per operation.
+        //
+        const uint64_t OperEndTime = CxPlatTimeUs64();
+        QuicLatencyHistogramRecord(
+            QUIC_LATENCY_HISTOGRAM_OPER_PROCESSING,
+            CxPlatTimeDiff64(OperStartTime, OperEndTime));
+        OperStartTime = OperEndTime;
     }
 
     if (!Connection->State.ExternalOwner && Connection->State.ClosedLocally) {
@@ -267,16 +267,40 @@ typedef struct QUIC_CONN_STATS {
         uint32_t KeyUpdateCount;        // Count of key updates completed.
     } Misc;
 
+    //
+    // Where the handshake's time went; only accumulated until the handshake
+    // is confirmed.
+    //
+    struct {
+        uint32_t TlsProcess;
+        uint32_t TlsOffload;
+        uint32_t CertValidation;
+        uint32_t KeyDerive;
+        uint32_t QueueWait;
+        uint32_t PacingBlocked;
+        uint32_t AmplificationBlocked;
+
+        uint32_t TlsOffloadStart;       // Time the pending TLS call was offloaded.
+        uint32_t PacingBlockedStart;    // Time sends were blocked by pacing.
+        uint32_t AmplificationBlockedStart; // Time sends were blocked by amplification protection.
+    } HandshakeTiming;
+
 } QUIC_CONN_STATS;
 
 //
 // Connection-specific state.
 //   N.B. In general, all variables should only be written on the QUIC worker
 //        thread.
+//   N.B. This struct dominates the memory cost of idle connections. Keep it
+//        small; see "Idle Connection Scalability" in docs/TEST.md.
 //
 typedef struct QUIC_CONNECTION {
 
+#ifdef __cplusplus
+    struct QUIC_HANDLE _;
+#else
     struct QUIC_HANDLE;
+#endif
 
     //
     // Link into the registrations's list of connections.
@@ -444,6 +468,12 @@ typedef struct QUIC_CONNECTION {
     CXPLAT_RECV_DATA** ReceiveQueueTail;
     CXPLAT_DISPATCH_LOCK ReceiveQueueLock;
 
+    //
+    // Number of streams holding on to a received packet to indicate its
+    // payload in place. Limited to QUIC_MAX_RECV_IN_PLACE_COUNT.
+    //
+    uint32_t RecvInPlaceCount;
+
     //
     // The queue of operations to process.
     //
@@ -556,6 +586,13 @@ typedef struct QUIC_CONNECTION {
     CXPLAT_TLS_SECRETS* TlsSecrets;
 #endif
 
+#ifdef QUIC_QLOG_SUPPORT
+    //
+    // qlog event log, if enabled (QUIC_PARAM_GLOBAL_QLOG_DIR).
+    //
+    QUIC_QLOG* Qlog;
+#endif
+
     //
     // Received version negotiation list from a previous connection attempt.
     //
@@ -569,6 +606,18 @@ typedef struct QUIC_CONNECTION {
 
 } QUIC_CONNECTION;
 
+//
+// The connection is the largest fixed allocation every connection makes, so
+// it must not grow by accident. The ceiling is the current x64 Linux size
+// (any build configuration); lower it as the connection shrinks toward the
+// 2,048 byte target in docs/TEST.md and only raise it along with that doc.
+//
+#if defined(CX_PLATFORM_LINUX) && defined(__x86_64__)
+CXPLAT_STATIC_ASSERT(
+    sizeof(QUIC_CONNECTION) <= 3328,
+    "QUIC_CONNECTION grew; see 'Connection Size' in docs/TEST.md");
+#endif
+
 typedef struct QUIC_SERIALIZED_RESUMPTION_STATE {
 
     uint32_t QuicVersion;
@@ -600,6 +649,20 @@ typedef struct QUIC_SERIALIZED_RESUMPTION_STATE {
 #define QUIC_CONN_VERIFY(Connection, Expr)
 #endif
 
+//
+// Records a qlog event (QuicQlog<Event>) for the connection, if enabled.
+//
+#ifdef QUIC_QLOG_SUPPORT
+#define QuicConnQlog(Connection, Event, ...) \
+    do { \
+        if ((Connection)->Qlog != NULL) { \
+            QuicQlog##Event((Connection)->Qlog, __VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define QuicConnQlog(Connection, Event, ...) do { } while (0)
+#endif
+
 //
 // Helper to determine if a connection is server side.
 //
@@ -720,6 +783,8 @@ QuicConnLogOutFlowStats(
     _In_ const QUIC_CONNECTION* const Connection
     )
 {
+    QuicConnQlog(Connection, MetricsUpdated, Connection);
+
     if (!QuicTraceEventEnabled(ConnOutFlowStats)) {
         return;
     }
@@ -802,6 +867,23 @@ QuicConnLogStatistics(
         Connection->Stats.Recv.DecryptionFailures);
 }
 
+//
+// Adds the time since StartTime (from CxPlatTimeUs32) to one of the
+// connection's handshake timings, if the handshake isn't confirmed yet.
+//
+inline
+void
+QuicConnAddHandshakeTime(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_ uint32_t* Timing,
+    _In_ uint32_t StartTime
+    )
+{
+    if (!Connection->State.HandshakeConfirmed) {
+        *Timing += CxPlatTimeDiff32(StartTime, CxPlatTimeUs32());
+    }
+}
+
 inline
 BOOLEAN
 QuicConnAddOutFlowBlockedReason(
@@ -810,6 +892,14 @@ QuicConnAddOutFlowBlockedReason(
     )
 {
     if (!(Connection->OutFlowBlockedReasons & Reason)) {
+        if (!Connection->State.HandshakeConfirmed) {
+            if (Reason & QUIC_FLOW_BLOCKED_PACING) {
+                Connection->Stats.HandshakeTiming.PacingBlockedStart = CxPlatTimeUs32();
+            }
+            if (Reason & QUIC_FLOW_BLOCKED_AMPLIFICATION_PROT) {
+                Connection->Stats.HandshakeTiming.AmplificationBlockedStart = CxPlatTimeUs32();
+            }
+        }
         Connection->OutFlowBlockedReasons |= Reason;
         QuicTraceEvent(
             ConnOutFlowBlocked,
@@ -829,6 +919,25 @@ QuicConnRemoveOutFlowBlockedReason(
     )
 {
     if ((Connection->OutFlowBlockedReasons & Reason)) {
+        //
+        // Blocked time that started during the handshake is counted in full.
+        //
+        if ((Connection->OutFlowBlockedReasons & Reason & QUIC_FLOW_BLOCKED_PACING) &&
+            Connection->Stats.HandshakeTiming.PacingBlockedStart != 0) {
+            Connection->Stats.HandshakeTiming.PacingBlocked +=
+                CxPlatTimeDiff32(
+                    Connection->Stats.HandshakeTiming.PacingBlockedStart,
+                    CxPlatTimeUs32());
+            Connection->Stats.HandshakeTiming.PacingBlockedStart = 0;
+        }
+        if ((Connection->OutFlowBlockedReasons & Reason & QUIC_FLOW_BLOCKED_AMPLIFICATION_PROT) &&
+            Connection->Stats.HandshakeTiming.AmplificationBlockedStart != 0) {
+            Connection->Stats.HandshakeTiming.AmplificationBlocked +=
+                CxPlatTimeDiff32(
+                    Connection->Stats.HandshakeTiming.AmplificationBlockedStart,
+                    CxPlatTimeUs32());
+            Connection->Stats.HandshakeTiming.AmplificationBlockedStart = 0;
+        }
         Connection->OutFlowBlockedReasons &= ~Reason;
         QuicTraceEvent(
             ConnOutFlowBlocked,
@@ -153,7 +153,7 @@ QuicCryptoInitialize(
             &Crypto->RecvBuffer,
             InitialRecvBufferLength,
             QUIC_DEFAULT_STREAM_FC_WINDOW_SIZE / 2,
-            TRUE,
+            QUIC_RECV_BUF_MODE_CONTIGUOUS,
             NULL);
     if (QUIC_FAILED(Status)) {
         goto Exit;
@@ -183,6 +183,7 @@ QuicCryptoInitialize(
         HandshakeCidLength = DestCid->CID.Length;
     }
 
+    const uint32_t KeyDeriveStart = CxPlatTimeUs32();
     Status =
         QuicPacketKeyCreateInitial(
             QuicConnIsServer(Connection),
@@ -191,6 +192,10 @@ QuicCryptoInitialize(
             HandshakeCid,
             &Crypto->TlsState.ReadKeys[QUIC_PACKET_KEY_INITIAL],
             &Crypto->TlsState.WriteKeys[QUIC_PACKET_KEY_INITIAL]);
+    QuicConnAddHandshakeTime(
+        Connection,
+        &Connection->Stats.HandshakeTiming.KeyDerive,
+        KeyDeriveStart);
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             ConnErrorStatus,
@@ -305,6 +310,7 @@ QuicCryptoInitializeTls(
     if (!QuicConnIsServer(Connection)) {
         TlsConfig.ServerName = Connection->RemoteServerName;
     }
+    TlsConfig.OffloadEnabled = Connection->Settings.TlsOffloadEnabled;
 #ifdef CXPLAT_TLS_SECRETS_SUPPORT
     TlsConfig.TlsSecrets = Connection->TlsSecrets;
 #endif
@@ -426,6 +432,7 @@ QuicCryptoOnVersionChange(
         Crypto->TlsState.WriteKeys[QUIC_PACKET_KEY_INITIAL] = NULL;
     }
 
+    const uint32_t KeyDeriveStart = CxPlatTimeUs32();
     Status =
         QuicPacketKeyCreateInitial(
             QuicConnIsServer(Connection),
@@ -434,6 +441,10 @@ QuicCryptoOnVersionChange(
             HandshakeCid,
             &Crypto->TlsState.ReadKeys[QUIC_PACKET_KEY_INITIAL],
             &Crypto->TlsState.WriteKeys[QUIC_PACKET_KEY_INITIAL]);
+    QuicConnAddHandshakeTime(
+        Connection,
+        &Connection->Stats.HandshakeTiming.KeyDerive,
+        KeyDeriveStart);
     if (QUIC_FAILED(Status)) {
         QuicTraceEvent(
             ConnErrorStatus,
@@ -1518,6 +1529,9 @@ QuicCryptoProcessTlsCompletion(
         //
         Connection->State.Connected = TRUE;
         QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_CONNECTED);
+        QuicLatencyHistogramRecord(
+            QUIC_LATENCY_HISTOGRAM_HANDSHAKE,
+            CxPlatTimeDiff64(Connection->Stats.Timing.Start, CxPlatTimeUs64()));
 
         QuicConnGenerateNewSourceCids(Connection, FALSE);
 
@@ -1614,15 +1628,55 @@ QuicTlsProcessDataCompleteCallback(
     }
 }
 
+//
+// Charges TLS processing time spent on a server's handshake to its source
+// address, for admission control.
+//
+static
+void
+QuicCryptoChargeHandshake(
+    _In_ QUIC_CONNECTION* Connection,
+    _In_ uint32_t CostUs
+    )
+{
+    if (QuicConnIsServer(Connection) &&
+        !Connection->State.Connected &&
+        MsQuicLib.Settings.AdmissionInitialRate != 0) {
+        QuicAdmissionChargeHandshake(
+            &MsQuicLib.Admission,
+            &Connection->Paths[0].RemoteAddress,
+            CostUs);
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicCryptoProcessCompleteOperation(
     _In_ QUIC_CRYPTO* Crypto
     )
 {
+    QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
+    if (Connection->Stats.HandshakeTiming.TlsOffloadStart != 0) {
+        QuicConnAddHandshakeTime(
+            Connection,
+            &Connection->Stats.HandshakeTiming.TlsOffload,
+            Connection->Stats.HandshakeTiming.TlsOffloadStart);
+        Connection->Stats.HandshakeTiming.TlsOffloadStart = 0;
+    }
+
     uint32_t BufferConsumed = 0;
+    uint32_t ProcessTimeUs = 0;
     Crypto->ResultFlags =
-        CxPlatTlsProcessDataComplete(Crypto->TLS, &BufferConsumed);
+        CxPlatTlsProcessDataComplete(Crypto->TLS, &BufferConsumed, &ProcessTimeUs);
+
+    //
+    // The offloaded work used the crypto threads' CPU, which admission control
+    // must see just the same as inline processing.
+    //
+    if (!Connection->State.HandshakeConfirmed) {
+        QuicCryptoChargeHandshake(Connection, ProcessTimeUs);
+    }
+
     QuicCryptoProcessDataComplete(Crypto, BufferConsumed);
 }
 
@@ -1668,6 +1722,7 @@ QuicCryptoProcessData(
     _In_ BOOLEAN IsClientInitial
     )
 {
+    QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
     uint32_t BufferCount = 1;
     QUIC_BUFFER Buffer;
@@ -1691,8 +1746,6 @@ QuicCryptoProcessData(
         CXPLAT_TEL_ASSERT(DataAvailable);
         CXPLAT_DBG_ASSERT(BufferCount == 1);
 
-        QUIC_CONNECTION* Connection = QuicCryptoGetConnection(Crypto);
-
         Buffer.Length =
             QuicCrytpoTlsGetCompleteTlsMessagesLength(
                 Buffer.Buffer, Buffer.Length);
@@ -1779,6 +1832,15 @@ QuicCryptoProcessData(
 
     QuicCryptoValidate(Crypto);
 
+    //
+    // Measure the handshake's TLS processing cost, for the connection's
+    // statistics and the server's admission control. Work offloaded to the
+    // platform's crypto threads is charged to admission control once it
+    // completes (see QuicCryptoProcessCompleteOperation).
+    //
+    const BOOLEAN MeasureTls = !Connection->State.HandshakeConfirmed;
+    const uint32_t TlsStartTime = MeasureTls ? CxPlatTimeUs32() : 0;
+
     Crypto->ResultFlags =
         CxPlatTlsProcessData(
             Crypto->TLS,
@@ -1787,6 +1849,15 @@ QuicCryptoProcessData(
             &Buffer.Length,
             &Crypto->TlsState);
 
+    if (MeasureTls) {
+        const uint32_t TlsCostUs = CxPlatTimeDiff32(TlsStartTime, CxPlatTimeUs32());
+        Connection->Stats.HandshakeTiming.TlsProcess += TlsCostUs;
+        QuicCryptoChargeHandshake(Connection, TlsCostUs);
+        if (Crypto->ResultFlags == CXPLAT_TLS_RESULT_PENDING) {
+            Connection->Stats.HandshakeTiming.TlsOffloadStart = CxPlatTimeUs32();
+        }
+    }
+
     CXPLAT_TEL_ASSERT(
         !IsClientInitial ||
         Crypto->ResultFlags != CXPLAT_TLS_RESULT_PENDING); // TODO - Support async for client Initial?
@@ -2047,7 +2118,8 @@ QuicCryptoEncodeServerTicket(
         QuicVarIntSize(AppDataLength) +
         AlpnLength +
         EncodedTPLength +
-        AppDataLength);
+        AppDataLength +
+        QUIC_TICKET_IDENTITY_LENGTH);
 
     TicketBuffer = CXPLAT_ALLOC_NONPAGED(TotalTicketLength, QUIC_POOL_SERVER_CRYPTO_TICKET);
     if (TicketBuffer == NULL) {
@@ -2070,6 +2142,11 @@ QuicCryptoEncodeServerTicket(
     //   Negotiated ALPN [...]
     //   Transport Parameters [...]
     //   App Ticket (omitted if length is zero) [...]
+    //   Issue Time (ms since the epoch) [8]
+    //   Nonce [8]
+    //
+    // The issue time and nonce make up the ticket's identity, for the 0-RTT
+    // anti-replay filter.
     //
 
     _Analysis_assume_(sizeof(*TicketBuffer) >= 8);
@@ -2087,6 +2164,11 @@ QuicCryptoEncodeServerTicket(
         CxPlatCopyMemory(TicketCursor, AppResumptionData, AppDataLength);
         TicketCursor += AppDataLength;
     }
+    const uint64_t IssueTime = CxPlatTimeEpochMs64();
+    CxPlatCopyMemory(TicketCursor, &IssueTime, sizeof(IssueTime));
+    TicketCursor += sizeof(IssueTime);
+    CxPlatRandom(QUIC_TICKET_IDENTITY_LENGTH - sizeof(IssueTime), TicketCursor);
+    TicketCursor += QUIC_TICKET_IDENTITY_LENGTH - sizeof(IssueTime);
     CXPLAT_DBG_ASSERT(TicketCursor == TicketBuffer + TotalTicketLength);
 
     *Ticket = TicketBuffer;
@@ -2232,7 +2314,7 @@ QuicCryptoDecodeServerTicket(
     }
     Offset += (uint16_t)TPLength;
 
-    if (TicketLength == Offset + AppTicketLength) {
+    if (TicketLength == Offset + AppTicketLength + QUIC_TICKET_IDENTITY_LENGTH) {
         Status = QUIC_STATUS_SUCCESS;
         *AppDataLength = (uint32_t)AppTicketLength;
         if (AppTicketLength > 0) {
@@ -363,6 +363,7 @@ QuicCryptoEncodeServerTicket(
 // AppData contains a pointer to the offset within Ticket, so do not free it.
 // AppData contain NULL if the server application didn't pass any resumption
 // data.
+// The ticket's identity is in its last QUIC_TICKET_IDENTITY_LENGTH bytes.
 // Note: Connection is only used for logging and may be NULL for testing.
 //
 QUIC_STATUS
@@ -179,6 +179,18 @@ QuicPerfCounterTrySnapShot(
     _In_ uint64_t TimeNow
     );
 
+uint32_t
+QuicLatencyHistogramBucketIndex(
+    _In_ uint64_t Value
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicLatencyHistogramRecord(
+    _In_ QUIC_LATENCY_HISTOGRAM_TYPE Type,
+    _In_ uint64_t Value
+    );
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicStreamAddRef(
@@ -587,6 +599,13 @@ QuicConnLogStatistics(
     _In_ const QUIC_CONNECTION* const Connection
     );
 
+void
+QuicConnAddHandshakeTime(
+    _In_ QUIC_CONNECTION* Connection,
+    _Inout_ uint32_t* Timing,
+    _In_ uint32_t StartTime
+    );
+
 BOOLEAN
 QuicPacketBuilderAddFrame(
     _Inout_ QUIC_PACKET_BUILDER* Builder,
@@ -110,6 +110,38 @@ QuicLibrarySumPerfCounters(
     }
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicLibrarySumLatencyHistograms(
+    _Out_writes_(HistogramCount) QUIC_LATENCY_HISTOGRAM* Histograms,
+    _In_ uint32_t HistogramCount
+    )
+{
+    CXPLAT_DBG_ASSERT(HistogramCount <= QUIC_LATENCY_HISTOGRAM_MAX);
+    CxPlatZeroMemory(Histograms, HistogramCount * sizeof(QUIC_LATENCY_HISTOGRAM));
+
+    for (uint32_t ProcIndex = 0; ProcIndex < MsQuicLib.ProcessorCount; ++ProcIndex) {
+        const QUIC_LATENCY_HISTOGRAM* ProcHistograms =
+            MsQuicLib.PerProc[ProcIndex].LatencyHistograms;
+        for (uint32_t Type = 0; Type < HistogramCount; ++Type) {
+            Histograms[Type].Sum += ProcHistograms[Type].Sum;
+            for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+                Histograms[Type].Buckets[i] += ProcHistograms[Type].Buckets[i];
+            }
+        }
+    }
+
+    //
+    // Count is calculated from the buckets so that it's always consistent with
+    // them, even while samples are being concurrently recorded.
+    //
+    for (uint32_t Type = 0; Type < HistogramCount; ++Type) {
+        for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+            Histograms[Type].Count += Histograms[Type].Buckets[i];
+        }
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicLibrarySumPerfCountersExternal(
@@ -184,6 +216,11 @@ MsQuicLibraryOnSettingsChanged(
         (MsQuicLib.Settings.RetryMemoryLimit * CxPlatTotalMemory) / UINT16_MAX;
     QuicLibraryEvaluateSendRetryState();
 
+    QuicReplayFilterConfigure(
+        &MsQuicLib.ReplayFilter,
+        MsQuicLib.Settings.ZeroRttReplayFilterSize,
+        MsQuicLib.Settings.ZeroRttReplayWindowMs);
+
     if (UpdateRegistrations) {
         CxPlatLockAcquire(&MsQuicLib.Lock);
 
@@ -248,6 +285,11 @@ MsQuicLibraryInitialize(
     CxPlatRandom(sizeof(MsQuicLib.ToeplitzHash.HashKey), MsQuicLib.ToeplitzHash.HashKey);
     CxPlatToeplitzHashInitialize(&MsQuicLib.ToeplitzHash);
 
+    QuicReplayFilterInitialize(&MsQuicLib.ReplayFilter);
+#ifdef QUIC_QLOG_SUPPORT
+    QuicQlogInitialize();
+#endif
+
     CxPlatZeroMemory(&MsQuicLib.Settings, sizeof(MsQuicLib.Settings));
     Status =
         CxPlatStorageOpen(
@@ -265,8 +307,9 @@ MsQuicLibraryInitialize(
 
     MsQuicLibraryReadSettings(NULL); // NULL means don't update registrations.
 
+    QuicAdmissionInitialize(&MsQuicLib.Admission);
     CxPlatDispatchLockInitialize(&MsQuicLib.StatelessRetryKeysLock);
-    CxPlatZeroMemory(&MsQuicLib.StatelessRetryKeys, sizeof(MsQuicLib.StatelessRetryKeys));
+    CxPlatZeroMemory(&MsQuicLib.StatelessRetryKeyMaterial, sizeof(MsQuicLib.StatelessRetryKeyMaterial));
     CxPlatZeroMemory(&MsQuicLib.StatelessRetryKeysExpiration, sizeof(MsQuicLib.StatelessRetryKeysExpiration));
 
     uint32_t CompatibilityListByteLength = 0;
@@ -350,6 +393,17 @@ MsQuicLibraryInitialize(
         CxPlatZeroMemory(
             &MsQuicLib.PerProc[i].PerfCounters,
             sizeof(MsQuicLib.PerProc[i].PerfCounters));
+        CxPlatZeroMemory(
+            &MsQuicLib.PerProc[i].LatencyHistograms,
+            sizeof(MsQuicLib.PerProc[i].LatencyHistograms));
+        CxPlatDispatchLockInitialize(&MsQuicLib.PerProc[i].StatelessRetryKeysLock);
+        CxPlatZeroMemory(
+            &MsQuicLib.PerProc[i].StatelessRetryKeys,
+            sizeof(MsQuicLib.PerProc[i].StatelessRetryKeys));
+        CxPlatZeroMemory(
+            &MsQuicLib.PerProc[i].StatelessRetryKeysExpiration,
+            sizeof(MsQuicLib.PerProc[i].StatelessRetryKeysExpiration));
+        MsQuicLib.PerProc[i].CurrentStatelessRetryKey = FALSE;
     }
 
     Status =
@@ -397,6 +451,7 @@ Error:
                 CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].ConnectionPool);
                 CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].TransportParamPool);
                 CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].PacketSpacePool);
+                CxPlatDispatchLockUninitialize(&MsQuicLib.PerProc[i].StatelessRetryKeysLock);
             }
             CXPLAT_FREE(MsQuicLib.PerProc, QUIC_POOL_PERPROC);
             MsQuicLib.PerProc = NULL;
@@ -406,6 +461,10 @@ Error:
             MsQuicLib.Storage = NULL;
         }
         if (PlatformInitialized) {
+            QuicReplayFilterUninitialize(&MsQuicLib.ReplayFilter);
+#ifdef QUIC_QLOG_SUPPORT
+            QuicQlogUninitialize();
+#endif
             CxPlatUninitialize();
         }
     }
@@ -485,15 +544,24 @@ MsQuicLibraryUninitialize(
         CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].ConnectionPool);
         CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].TransportParamPool);
         CxPlatPoolUninitialize(&MsQuicLib.PerProc[i].PacketSpacePool);
+        for (size_t j = 0; j < ARRAYSIZE(MsQuicLib.PerProc[i].StatelessRetryKeys); ++j) {
+            CxPlatKeyFree(MsQuicLib.PerProc[i].StatelessRetryKeys[j]);
+            MsQuicLib.PerProc[i].StatelessRetryKeys[j] = NULL;
+        }
+        CxPlatDispatchLockUninitialize(&MsQuicLib.PerProc[i].StatelessRetryKeysLock);
     }
     CXPLAT_FREE(MsQuicLib.PerProc, QUIC_POOL_PERPROC);
     MsQuicLib.PerProc = NULL;
 
-    for (size_t i = 0; i < ARRAYSIZE(MsQuicLib.StatelessRetryKeys); ++i) {
-        CxPlatKeyFree(MsQuicLib.StatelessRetryKeys[i]);
-        MsQuicLib.StatelessRetryKeys[i] = NULL;
-    }
+    CxPlatSecureZeroMemory(
+        &MsQuicLib.StatelessRetryKeyMaterial,
+        sizeof(MsQuicLib.StatelessRetryKeyMaterial));
     CxPlatDispatchLockUninitialize(&MsQuicLib.StatelessRetryKeysLock);
+    QuicAdmissionUninitialize(&MsQuicLib.Admission);
+    QuicReplayFilterUninitialize(&MsQuicLib.ReplayFilter);
+#ifdef QUIC_QLOG_SUPPORT
+    QuicQlogUninitialize();
+#endif
 
     QuicSettingsCleanup(&MsQuicLib.Settings);
 
@@ -775,6 +843,80 @@ QuicLibrarySetGlobalParam(
         break;
 #endif
 
+#ifdef QUIC_LOOPBACK_DATAPATH
+    case QUIC_PARAM_GLOBAL_LOOPBACK_EMULATION:
+
+        if (BufferLength != sizeof(CXPLAT_DATAPATH_EMULATION)) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (MsQuicLib.Datapath == NULL) {
+            Status = QUIC_STATUS_INVALID_STATE;
+            break;
+        }
+
+        CxPlatDataPathSetEmulation(
+            MsQuicLib.Datapath,
+            (const CXPLAT_DATAPATH_EMULATION*)Buffer);
+        QuicTraceLogInfo(
+            LibraryLoopbackEmulationSet,
+            "[ lib] Updated loopback emulation, delay=%u ms, rate=%u Mbps",
+            ((const CXPLAT_DATAPATH_EMULATION*)Buffer)->DelayMs,
+            ((const CXPLAT_DATAPATH_EMULATION*)Buffer)->RateLimitMbps);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+#endif
+
+#ifdef QUIC_EVENTS_RING
+    case QUIC_PARAM_GLOBAL_TRACE_RING_DUMP:
+
+        if (BufferLength != 0 && ((const char*)Buffer)[BufferLength - 1] != '\0') {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Run down all objects first, so the dump describes them even if their
+        // creation events were already overwritten.
+        //
+        QuicTraceRundown();
+        Status =
+            QuicTraceRingDump(
+                BufferLength <= 1 ? NULL : (const char*)Buffer);
+        break;
+#endif
+
+#ifdef QUIC_QLOG_SUPPORT
+    case QUIC_PARAM_GLOBAL_QLOG_DIR:
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        Status = QuicQlogSetDirectory((const char*)Buffer, BufferLength);
+        if (QUIC_SUCCEEDED(Status)) {
+            QuicTraceLogInfo(
+                LibraryQlogDirSet,
+                "[ lib] Updated qlog directory, %s",
+                (const char*)Buffer);
+        }
+        break;
+
+    case QUIC_PARAM_GLOBAL_QLOG_WRITER_PAUSED:
+
+        if (BufferLength != sizeof(BOOLEAN) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        QuicQlogSetWriterPaused(*(const BOOLEAN*)Buffer);
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+#endif
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -883,6 +1025,104 @@ QuicLibraryGetGlobalParam(
         break;
     }
 
+    case QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS: {
+
+        if (*BufferLength < sizeof(QUIC_LATENCY_HISTOGRAM)) {
+            *BufferLength = sizeof(QUIC_LATENCY_HISTOGRAM) * QUIC_LATENCY_HISTOGRAM_MAX;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // Copy as many histograms as will fit completely in the buffer.
+        //
+        uint32_t HistogramCount = *BufferLength / sizeof(QUIC_LATENCY_HISTOGRAM);
+        if (HistogramCount > QUIC_LATENCY_HISTOGRAM_MAX) {
+            HistogramCount = QUIC_LATENCY_HISTOGRAM_MAX;
+        }
+        *BufferLength = HistogramCount * sizeof(QUIC_LATENCY_HISTOGRAM);
+
+        QuicLibrarySumLatencyHistograms(
+            (QUIC_LATENCY_HISTOGRAM*)Buffer, HistogramCount);
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_PROCESSOR_PERF_COUNTERS: {
+
+        //
+        // Unlike the summed counters, these are returned raw, so counters
+        // tracking current values may be negative on a processor that only
+        // decremented them.
+        //
+        const uint32_t CountersLength =
+            MsQuicLib.ProcessorCount * sizeof(MsQuicLib.PerProc[0].PerfCounters);
+        if (*BufferLength < CountersLength) {
+            *BufferLength = CountersLength;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = CountersLength;
+        int64_t* Counters = (int64_t*)Buffer;
+        for (uint32_t ProcIndex = 0; ProcIndex < MsQuicLib.ProcessorCount; ++ProcIndex) {
+            CxPlatCopyMemory(
+                Counters + ProcIndex * QUIC_PERF_COUNTER_MAX,
+                MsQuicLib.PerProc[ProcIndex].PerfCounters,
+                sizeof(MsQuicLib.PerProc[ProcIndex].PerfCounters));
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+    }
+
+    case QUIC_PARAM_GLOBAL_BINDING_STATISTICS: {
+
+        CxPlatDispatchLockAcquire(&MsQuicLib.DatapathLock);
+
+        uint32_t BindingCount = 0;
+        for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Bindings.Flink;
+            Link != &MsQuicLib.Bindings;
+            Link = Link->Flink) {
+            BindingCount++;
+        }
+
+        const uint32_t StatsLength = BindingCount * sizeof(QUIC_BINDING_STATISTICS);
+        if (*BufferLength < StatsLength) {
+            *BufferLength = StatsLength;
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+
+        } else if (Buffer == NULL && StatsLength != 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+
+        } else {
+            *BufferLength = StatsLength;
+            QUIC_BINDING_STATISTICS* Stats = (QUIC_BINDING_STATISTICS*)Buffer;
+            for (CXPLAT_LIST_ENTRY* Link = MsQuicLib.Bindings.Flink;
+                Link != &MsQuicLib.Bindings;
+                Link = Link->Flink) {
+                QuicBindingGetStatistics(
+                    CXPLAT_CONTAINING_RECORD(Link, QUIC_BINDING, Link),
+                    Stats++);
+            }
+            Status = QUIC_STATUS_SUCCESS;
+        }
+
+        CxPlatDispatchLockRelease(&MsQuicLib.DatapathLock);
+        break;
+    }
+
     case QUIC_PARAM_GLOBAL_SETTINGS:
 
         if (*BufferLength < sizeof(QUIC_SETTINGS)) {
@@ -1245,6 +1485,8 @@ MsQuicOpen(
 
     Api->DatagramSend = MsQuicDatagramSend;
 
+    Api->StreamSendBatch = MsQuicStreamSendBatch;
+
     *QuicApi = Api;
 
 Error:
@@ -1634,32 +1876,113 @@ QuicTraceRundown(
     CxPlatLockRelease(&MsQuicLib.Lock);
 }
 
+//
+// Brings the processor's stateless retry keys up to date with the library's
+// key material, first rotating the material if it doesn't cover the key
+// interval beginning at StartTime. The caller must hold the processor's
+// StatelessRetryKeysLock.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+static
+void
+QuicLibraryRefreshStatelessRetryKeys(
+    _In_ QUIC_LIBRARY_PP* PerProc,
+    _In_ int64_t StartTime
+    )
+{
+    uint8_t KeyMaterial[2][CXPLAT_AEAD_AES_256_GCM_SIZE];
+    int64_t Expiration[2];
+    BOOLEAN CurrentKey;
+
+    CxPlatDispatchLockAcquire(&MsQuicLib.StatelessRetryKeysLock);
+    if (StartTime >= MsQuicLib.StatelessRetryKeysExpiration[MsQuicLib.CurrentStatelessRetryKey]) {
+        //
+        // If the start time for the current key interval is greater-than-or-equal
+        // to the expiration time of the latest stateless retry key material,
+        // generate new material, and rotate the old.
+        //
+        const BOOLEAN NextKey = !MsQuicLib.CurrentStatelessRetryKey;
+        CxPlatRandom(
+            sizeof(MsQuicLib.StatelessRetryKeyMaterial[NextKey]),
+            MsQuicLib.StatelessRetryKeyMaterial[NextKey]);
+        MsQuicLib.StatelessRetryKeysExpiration[NextKey] =
+            StartTime + QUIC_STATELESS_RETRY_KEY_LIFETIME_MS;
+        MsQuicLib.CurrentStatelessRetryKey = NextKey;
+    }
+    CxPlatCopyMemory(KeyMaterial, MsQuicLib.StatelessRetryKeyMaterial, sizeof(KeyMaterial));
+    CxPlatCopyMemory(Expiration, MsQuicLib.StatelessRetryKeysExpiration, sizeof(Expiration));
+    CurrentKey = MsQuicLib.CurrentStatelessRetryKey;
+    CxPlatDispatchLockRelease(&MsQuicLib.StatelessRetryKeysLock);
+
+    for (uint32_t i = 0; i < ARRAYSIZE(PerProc->StatelessRetryKeys); ++i) {
+        if (PerProc->StatelessRetryKeysExpiration[i] == Expiration[i]) {
+            continue; // Already created from this material.
+        }
+
+        CxPlatKeyFree(PerProc->StatelessRetryKeys[i]);
+        PerProc->StatelessRetryKeys[i] = NULL;
+        PerProc->StatelessRetryKeysExpiration[i] = 0;
+        if (Expiration[i] == 0) {
+            continue; // No material generated for this slot yet.
+        }
+
+        QUIC_STATUS Status =
+            CxPlatKeyCreate(
+                CXPLAT_AEAD_AES_256_GCM,
+                KeyMaterial[i],
+                &PerProc->StatelessRetryKeys[i]);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "Create stateless retry key");
+            PerProc->StatelessRetryKeys[i] = NULL;
+            continue; // Retried on the next refresh.
+        }
+        PerProc->StatelessRetryKeysExpiration[i] = Expiration[i];
+    }
+    PerProc->CurrentStatelessRetryKey = CurrentKey;
+
+    CxPlatSecureZeroMemory(KeyMaterial, sizeof(KeyMaterial));
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Ret_maybenull_
 CXPLAT_KEY*
 QuicLibraryGetStatelessRetryKeyForTimestamp(
+    _In_ QUIC_LIBRARY_PP* PerProc,
     _In_ int64_t Timestamp
     )
 {
-    if (Timestamp < MsQuicLib.StatelessRetryKeysExpiration[!MsQuicLib.CurrentStatelessRetryKey] - QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) {
+    if (Timestamp >= PerProc->StatelessRetryKeysExpiration[PerProc->CurrentStatelessRetryKey]) {
+        //
+        // The token may have been generated on another processor, with key
+        // material this processor hasn't picked up yet. Tokens claiming to be
+        // from the future can't be valid, so they don't get to force a refresh.
+        //
+        int64_t Now = CxPlatTimeEpochMs64();
+        if (Timestamp > Now) {
+            return NULL;
+        }
+        QuicLibraryRefreshStatelessRetryKeys(
+            PerProc,
+            (Now / QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) * QUIC_STATELESS_RETRY_KEY_LIFETIME_MS);
+    }
+
+    if (Timestamp < PerProc->StatelessRetryKeysExpiration[!PerProc->CurrentStatelessRetryKey] - QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) {
         //
         // Timestamp is before the beginning of the previous key's validity window.
         //
         return NULL;
     }
 
-    if (Timestamp < MsQuicLib.StatelessRetryKeysExpiration[!MsQuicLib.CurrentStatelessRetryKey]) {
-        if (MsQuicLib.StatelessRetryKeys[!MsQuicLib.CurrentStatelessRetryKey] == NULL) {
-            return NULL;
-        }
-        return MsQuicLib.StatelessRetryKeys[!MsQuicLib.CurrentStatelessRetryKey];
+    if (Timestamp < PerProc->StatelessRetryKeysExpiration[!PerProc->CurrentStatelessRetryKey]) {
+        return PerProc->StatelessRetryKeys[!PerProc->CurrentStatelessRetryKey];
     }
 
-    if (Timestamp < MsQuicLib.StatelessRetryKeysExpiration[MsQuicLib.CurrentStatelessRetryKey]) {
-        if (MsQuicLib.StatelessRetryKeys[MsQuicLib.CurrentStatelessRetryKey] == NULL) {
-            return NULL;
-        }
-        return MsQuicLib.StatelessRetryKeys[MsQuicLib.CurrentStatelessRetryKey];
+    if (Timestamp < PerProc->StatelessRetryKeysExpiration[PerProc->CurrentStatelessRetryKey]) {
+        return PerProc->StatelessRetryKeys[PerProc->CurrentStatelessRetryKey];
     }
 
     //
@@ -1672,47 +1995,26 @@ _IRQL_requires_max_(DISPATCH_LEVEL)
 _Ret_maybenull_
 CXPLAT_KEY*
 QuicLibraryGetCurrentStatelessRetryKey(
-    void
+    _In_ QUIC_LIBRARY_PP* PerProc
     )
 {
     int64_t Now = CxPlatTimeEpochMs64();
     int64_t StartTime = (Now / QUIC_STATELESS_RETRY_KEY_LIFETIME_MS) * QUIC_STATELESS_RETRY_KEY_LIFETIME_MS;
 
-    if (StartTime < MsQuicLib.StatelessRetryKeysExpiration[MsQuicLib.CurrentStatelessRetryKey]) {
-        return MsQuicLib.StatelessRetryKeys[MsQuicLib.CurrentStatelessRetryKey];
+    if (StartTime < PerProc->StatelessRetryKeysExpiration[PerProc->CurrentStatelessRetryKey]) {
+        //
+        // Fast path: this processor's current key still covers the interval,
+        // so the library's key material doesn't need to be touched.
+        //
+        return PerProc->StatelessRetryKeys[PerProc->CurrentStatelessRetryKey];
     }
 
-    //
-    // If the start time for the current key interval is greater-than-or-equal
-    // to the expiration time of the latest stateless retry key, generate a new
-    // key, and rotate the old.
-    //
-
-    int64_t ExpirationTime = StartTime + QUIC_STATELESS_RETRY_KEY_LIFETIME_MS;
+    QuicLibraryRefreshStatelessRetryKeys(PerProc, StartTime);
 
-    CXPLAT_KEY* NewKey;
-    uint8_t RawKey[CXPLAT_AEAD_AES_256_GCM_SIZE];
-    CxPlatRandom(sizeof(RawKey), RawKey);
-    QUIC_STATUS Status =
-        CxPlatKeyCreate(
-            CXPLAT_AEAD_AES_256_GCM,
-            RawKey,
-            &NewKey);
-    if (QUIC_FAILED(Status)) {
-        QuicTraceEvent(
-            LibraryErrorStatus,
-            "[ lib] ERROR, %u, %s.",
-            Status,
-            "Create stateless retry key");
-        return NULL;
+    if (StartTime >= PerProc->StatelessRetryKeysExpiration[PerProc->CurrentStatelessRetryKey]) {
+        return NULL; // Failed to create the key.
     }
-
-    MsQuicLib.StatelessRetryKeysExpiration[!MsQuicLib.CurrentStatelessRetryKey] = ExpirationTime;
-    CxPlatKeyFree(MsQuicLib.StatelessRetryKeys[!MsQuicLib.CurrentStatelessRetryKey]);
-    MsQuicLib.StatelessRetryKeys[!MsQuicLib.CurrentStatelessRetryKey] = NewKey;
-    MsQuicLib.CurrentStatelessRetryKey = !MsQuicLib.CurrentStatelessRetryKey;
-
-    return NewKey;
+    return PerProc->StatelessRetryKeys[PerProc->CurrentStatelessRetryKey];
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
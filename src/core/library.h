@@ -61,6 +61,30 @@ typedef struct QUIC_CACHEALIGN QUIC_LIBRARY_PP {
     //
     int64_t PerfCounters[QUIC_PERF_COUNTER_MAX];
 
+    //
+    // Per-processor latency histograms. Count is only calculated when queried.
+    //
+    QUIC_LATENCY_HISTOGRAM LatencyHistograms[QUIC_LATENCY_HISTOGRAM_MAX];
+
+    //
+    // Controls access to this processor's stateless retry keys. Threads only
+    // use the keys of the processor they're running on, so it's normally
+    // uncontended.
+    //
+    CXPLAT_DISPATCH_LOCK StatelessRetryKeysLock;
+
+    //
+    // This processor's keys for encryption of stateless retry tokens, created
+    // from the library's key material, and the expiration of that material.
+    //
+    CXPLAT_KEY* StatelessRetryKeys[2];
+    int64_t StatelessRetryKeysExpiration[2];
+
+    //
+    // Index for this processor's current stateless retry token key.
+    //
+    BOOLEAN CurrentStatelessRetryKey;
+
 } QUIC_LIBRARY_PP;
 
 //
@@ -93,7 +117,7 @@ typedef struct QUIC_LIBRARY {
     BOOLEAN SendRetryEnabled;
 
     //
-    // Index for the current stateless retry token key.
+    // Index for the current stateless retry token key material.
     //
     BOOLEAN CurrentStatelessRetryKey;
 
@@ -171,6 +195,16 @@ typedef struct QUIC_LIBRARY {
     //
     uint64_t CurrentHandshakeMemoryUsage;
 
+    //
+    // Admission control state for new connection attempts.
+    //
+    QUIC_ADMISSION Admission;
+
+    //
+    // Remembers the resumption tickets 0-RTT has been accepted with.
+    //
+    QUIC_REPLAY_FILTER ReplayFilter;
+
     //
     // Handle to global persistent storage (registry).
     //
@@ -203,17 +237,20 @@ typedef struct QUIC_LIBRARY {
     QUIC_LIBRARY_PP* PerProc;
 
     //
-    // Controls access to the stateless retry keys when rotated.
+    // Controls access to the stateless retry key material when rotated. It's
+    // only acquired when a processor's keys need to pick up new material, so
+    // about once per key lifetime per processor.
     //
     CXPLAT_DISPATCH_LOCK StatelessRetryKeysLock;
 
     //
-    // Keys used for encryption of stateless retry tokens.
+    // Material for the keys used for encryption of stateless retry tokens.
+    // Each processor creates its own keys from it (see QUIC_LIBRARY_PP).
     //
-    CXPLAT_KEY* StatelessRetryKeys[2];
+    uint8_t StatelessRetryKeyMaterial[2][CXPLAT_AEAD_AES_256_GCM_SIZE];
 
     //
-    // Timestamp when the current stateless retry key expires.
+    // Timestamp when the current stateless retry key material expires.
     //
     int64_t StatelessRetryKeysExpiration[2];
 
@@ -340,6 +377,61 @@ QuicPerfCounterAdd(
 #define QuicPerfCounterIncrement(Type) QuicPerfCounterAdd(Type, 1)
 #define QuicPerfCounterDecrement(Type) QuicPerfCounterAdd(Type, -1)
 
+//
+// Returns the log-linear bucket a latency value (in microseconds) is counted
+// in. See QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT for the bucket layout.
+//
+inline
+uint32_t
+QuicLatencyHistogramBucketIndex(
+    _In_ uint64_t Value
+    )
+{
+    const uint32_t SubBuckets = 1 << QUIC_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    if (Value < 2 * SubBuckets) {
+        return (uint32_t)Value;
+    }
+    if (Value > UINT32_MAX) {
+        return QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1;
+    }
+
+    uint32_t Remaining = (uint32_t)Value;
+    uint32_t Log2 = 0;
+    if (Remaining >= 0x10000) { Remaining >>= 16; Log2 += 16; }
+    if (Remaining >= 0x100) { Remaining >>= 8; Log2 += 8; }
+    if (Remaining >= 0x10) { Remaining >>= 4; Log2 += 4; }
+    if (Remaining >= 0x4) { Remaining >>= 2; Log2 += 2; }
+    if (Remaining >= 0x2) { Log2 += 1; }
+
+    const uint32_t Shift = Log2 - QUIC_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    return
+        (Shift + 1) * SubBuckets +
+        ((uint32_t)(Value >> Shift) & (SubBuckets - 1));
+}
+
+//
+// Records a latency sample (in microseconds) in the current processor's
+// histogram. Only interlocked adds on per-processor memory, so it's cheap
+// enough to always be on.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+inline
+void
+QuicLatencyHistogramRecord(
+    _In_ QUIC_LATENCY_HISTOGRAM_TYPE Type,
+    _In_ uint64_t Value
+    )
+{
+    CXPLAT_DBG_ASSERT(Type >= 0 && Type < QUIC_LATENCY_HISTOGRAM_MAX);
+    uint32_t ProcIndex = CxPlatProcCurrentNumber();
+    CXPLAT_DBG_ASSERT(ProcIndex < (uint32_t)MsQuicLib.PartitionCount);
+    QUIC_LATENCY_HISTOGRAM* Histogram =
+        &MsQuicLib.PerProc[ProcIndex].LatencyHistograms[Type];
+    InterlockedIncrement64(
+        (int64_t*)&Histogram->Buckets[QuicLatencyHistogramBucketIndex(Value)]);
+    InterlockedExchangeAdd64((int64_t*)&Histogram->Sum, (int64_t)Value);
+}
+
 #define QUIC_PERF_SAMPLE_INTERVAL_S    30 // 30 seconds
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -525,22 +617,25 @@ QuicLibraryGetWorker(
     );
 
 //
-// Returns the current stateless retry key.
+// Returns the processor's current stateless retry key. The caller must hold
+// the processor's StatelessRetryKeysLock.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Ret_maybenull_
 CXPLAT_KEY*
 QuicLibraryGetCurrentStatelessRetryKey(
-    void
+    _In_ QUIC_LIBRARY_PP* PerProc
     );
 
 //
-// Returns the stateless retry key for that timestamp.
+// Returns the processor's stateless retry key for that timestamp. The caller
+// must hold the processor's StatelessRetryKeysLock.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 _Ret_maybenull_
 CXPLAT_KEY*
 QuicLibraryGetStatelessRetryKeyForTimestamp(
+    _In_ QUIC_LIBRARY_PP* PerProc,
     _In_ int64_t Timestamp
     );
 
@@ -923,6 +923,12 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         Packet->PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_FACK);
+                    QuicConnQlog(
+                        Connection,
+                        PacketLost,
+                        QuicPacketTraceType(Packet),
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_FACK);
                 }
             } else if (Packet->PacketNumber < LossDetection->LargestAck &&
                         CxPlatTimeAtOrBefore32(Packet->SentTime + TimeReorderThreshold, TimeNow)) {
@@ -940,6 +946,12 @@ QuicLossDetectionDetectAndHandleLostPackets(
                         Packet->PacketNumber,
                         QuicPacketTraceType(Packet),
                         QUIC_TRACE_PACKET_LOSS_RACK);
+                    QuicConnQlog(
+                        Connection,
+                        PacketLost,
+                        QuicPacketTraceType(Packet),
+                        Packet->PacketNumber,
+                        QUIC_TRACE_PACKET_LOSS_RACK);
                 }
             } else {
                 break;
@@ -1513,17 +1525,25 @@ QuicLossDetectionScheduleProbe(
 
     if (Connection->Crypto.TlsState.WriteKey == QUIC_PACKET_KEY_1_RTT) {
         //
-        // Check to see if any streams have fresh data to send out.
+        // Check to see if any streams have fresh data to send out. Flow
+        // control blocked streams are parked on their own list, so walk it
+        // too.
         //
-        for (CXPLAT_LIST_ENTRY* Entry = Connection->Send.SendStreams.Flink;
-            Entry != &Connection->Send.SendStreams;
-            Entry = Entry->Flink) {
-
-            QUIC_STREAM* Stream =
-                CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
-            if (QuicStreamCanSendNow(Stream, FALSE)) {
-                if (--NumPackets == 0) {
-                    return;
+        CXPLAT_LIST_ENTRY* StreamLists[] = {
+            &Connection->Send.SendStreams,
+            &Connection->Send.BlockedStreams
+        };
+        for (uint32_t i = 0; i < ARRAYSIZE(StreamLists); ++i) {
+            for (CXPLAT_LIST_ENTRY* Entry = StreamLists[i]->Flink;
+                Entry != StreamLists[i];
+                Entry = Entry->Flink) {
+
+                QUIC_STREAM* Stream =
+                    CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+                if (QuicStreamCanSendNow(Stream, FALSE)) {
+                    if (--NumPackets == 0) {
+                        return;
+                    }
                 }
             }
         }
@@ -1548,6 +1568,12 @@ QuicLossDetectionScheduleProbe(
                 Packet->PacketNumber,
                 QuicPacketTraceType(Packet),
                 QUIC_TRACE_PACKET_LOSS_PROBE);
+            QuicConnQlog(
+                Connection,
+                PacketLost,
+                QuicPacketTraceType(Packet),
+                Packet->PacketNumber,
+                QUIC_TRACE_PACKET_LOSS_PROBE);
             if (QuicLossDetectionRetransmitFrames(LossDetection, Packet, FALSE) &&
                 --NumPackets == 0) {
                 return;
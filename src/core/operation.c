@@ -23,10 +23,21 @@ Abstract:
 --*/
 
 #include "precomp.h"
+#include "quic_trace_ring.h"
 #ifdef QUIC_CLOG
 #include "operation.c.clog.h"
 #endif
 
+CXPLAT_STATIC_ASSERT(
+    QUIC_OPER_TYPE_RETRY + 1 == QUIC_TRACE_RING_OPER_TYPE_COUNT,
+    "Update the ring decoder's operation names");
+CXPLAT_STATIC_ASSERT(
+    QUIC_API_TYPE_STRM_SEND_BATCH + 1 == QUIC_TRACE_RING_API_TYPE_COUNT,
+    "Update the ring decoder's API call names");
+CXPLAT_STATIC_ASSERT(
+    QUIC_CONN_TIMER_COUNT == QUIC_TRACE_RING_TIMER_TYPE_COUNT,
+    "Update the ring decoder's timer names");
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicOperationQueueInitialize(
@@ -34,8 +45,11 @@ QuicOperationQueueInitialize(
     )
 {
     OperQ->ActivelyProcessing = FALSE;
+    OperQ->PriorityQueued = FALSE;
     CxPlatDispatchLockInitialize(&OperQ->Lock);
     CxPlatListInitializeHead(&OperQ->List);
+    CxPlatListInitializeHead(&OperQ->PriorityList);
+    CxPlatListInitializeHead(&OperQ->ProcessList);
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -46,6 +60,8 @@ QuicOperationQueueUninitialize(
 {
     UNREFERENCED_PARAMETER(OperQ);
     CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->List));
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->PriorityList));
+    CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&OperQ->ProcessList));
     CxPlatDispatchLockUninitialize(&OperQ->Lock);
 }
 
@@ -111,6 +127,12 @@ QuicOperationFree(
             QuicStreamRelease(ApiCtx->STRM_SHUTDOWN.Stream, QUIC_STREAM_REF_OPERATION);
         } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND) {
             QuicStreamRelease(ApiCtx->STRM_SEND.Stream, QUIC_STREAM_REF_OPERATION);
+        } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_SEND_BATCH) {
+            for (uint32_t i = 0; i < ApiCtx->STRM_SEND_BATCH.StreamCount; ++i) {
+                QuicStreamRelease(
+                    ApiCtx->STRM_SEND_BATCH.Streams[i], QUIC_STREAM_REF_OPERATION);
+            }
+            CXPLAT_FREE(ApiCtx->STRM_SEND_BATCH.Streams, QUIC_POOL_SEND_BATCH);
         } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_RECV_COMPLETE) {
             QuicStreamRelease(ApiCtx->STRM_RECV_COMPLETE.Stream, QUIC_STREAM_REF_OPERATION);
         } else if (ApiCtx->Type == QUIC_API_TYPE_STRM_RECV_SET_ENABLED) {
@@ -139,7 +161,10 @@ QuicOperationEnqueue(
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
+    StartProcessing =
+        CxPlatListIsEmpty(&OperQ->List) &&
+        CxPlatListIsEmpty(&OperQ->PriorityList) &&
+        !OperQ->ActivelyProcessing;
     CxPlatListInsertTail(&OperQ->List, &Oper->Link);
     CxPlatDispatchLockRelease(&OperQ->Lock);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUED);
@@ -159,8 +184,12 @@ QuicOperationEnqueueFront(
 #if DEBUG
     CXPLAT_DBG_ASSERT(Oper->Link.Flink == NULL);
 #endif
-    StartProcessing = CxPlatListIsEmpty(&OperQ->List) && !OperQ->ActivelyProcessing;
-    CxPlatListInsertHead(&OperQ->List, &Oper->Link);
+    StartProcessing =
+        CxPlatListIsEmpty(&OperQ->List) &&
+        CxPlatListIsEmpty(&OperQ->PriorityList) &&
+        !OperQ->ActivelyProcessing;
+    CxPlatListInsertHead(&OperQ->PriorityList, &Oper->Link);
+    (void)InterlockedFetchAndSetBoolean(&OperQ->PriorityQueued);
     CxPlatDispatchLockRelease(&OperQ->Lock);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUED);
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
@@ -174,24 +203,44 @@ QuicOperationDequeue(
     )
 {
     QUIC_OPERATION* Oper;
-    CxPlatDispatchLockAcquire(&OperQ->Lock);
-    if (CxPlatListIsEmpty(&OperQ->List)) {
-        OperQ->ActivelyProcessing = FALSE;
+
+    //
+    // Other threads set the flag under the lock, so it is tested and cleared
+    // atomically here. Only the lock protects PriorityList itself, so that is
+    // what decides whether anything is actually moved.
+    //
+    if (CxPlatListIsEmpty(&OperQ->ProcessList) ||
+        InterlockedFetchAndClearBoolean(&OperQ->PriorityQueued)) {
+        CxPlatDispatchLockAcquire(&OperQ->Lock);
+        if (!CxPlatListIsEmpty(&OperQ->PriorityList)) {
+            //
+            // Priority operations go ahead of everything already taken off
+            // the queue.
+            //
+            CXPLAT_LIST_ENTRY OldProcessList;
+            CxPlatListInitializeHead(&OldProcessList);
+            CxPlatListMoveItems(&OperQ->ProcessList, &OldProcessList);
+            CxPlatListMoveItems(&OperQ->PriorityList, &OperQ->ProcessList);
+            CxPlatListMoveItems(&OldProcessList, &OperQ->ProcessList);
+            (void)InterlockedFetchAndClearBoolean(&OperQ->PriorityQueued);
+        }
+        CxPlatListMoveItems(&OperQ->List, &OperQ->ProcessList);
+        OperQ->ActivelyProcessing = !CxPlatListIsEmpty(&OperQ->ProcessList);
+        CxPlatDispatchLockRelease(&OperQ->Lock);
+    }
+
+    if (CxPlatListIsEmpty(&OperQ->ProcessList)) {
         Oper = NULL;
     } else {
-        OperQ->ActivelyProcessing = TRUE;
         Oper =
             CXPLAT_CONTAINING_RECORD(
-                CxPlatListRemoveHead(&OperQ->List), QUIC_OPERATION, Link);
+                CxPlatListRemoveHead(&OperQ->ProcessList), QUIC_OPERATION, Link);
 #if DEBUG
         Oper->Link.Flink = NULL;
 #endif
-    }
-    CxPlatDispatchLockRelease(&OperQ->Lock);
-
-    if (Oper != NULL) {
         QuicPerfCounterDecrement(QUIC_PERF_COUNTER_CONN_OPER_QUEUE_DEPTH);
     }
+
     return Oper;
 }
 
@@ -205,8 +254,11 @@ QuicOperationQueueClear(
     CXPLAT_LIST_ENTRY OldList;
     CxPlatListInitializeHead(&OldList);
 
+    CxPlatListMoveItems(&OperQ->ProcessList, &OldList);
     CxPlatDispatchLockAcquire(&OperQ->Lock);
     OperQ->ActivelyProcessing = FALSE;
+    (void)InterlockedFetchAndClearBoolean(&OperQ->PriorityQueued);
+    CxPlatListMoveItems(&OperQ->PriorityList, &OldList);
     CxPlatListMoveItems(&OperQ->List, &OldList);
     CxPlatDispatchLockRelease(&OperQ->Lock);
 
@@ -60,6 +60,7 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_GET_PARAM,
 
     QUIC_API_TYPE_DATAGRAM_SEND,
+    QUIC_API_TYPE_STRM_SEND_BATCH,
 
 } QUIC_API_TYPE;
 
@@ -133,6 +134,10 @@ typedef struct QUIC_API_CONTEXT {
         struct {
             QUIC_STREAM* Stream;
         } STRM_SEND;
+        struct {
+            QUIC_STREAM** Streams;
+            uint32_t StreamCount;
+        } STRM_SEND_BATCH;
         struct {
             QUIC_STREAM* Stream;
             uint64_t BufferLength;
@@ -276,10 +281,26 @@ typedef struct QUIC_OPERATION_QUEUE {
     BOOLEAN ActivelyProcessing;
 
     //
-    // Queue of pending operations.
+    // Set when an operation is added to PriorityList. Only ever changed with
+    // the Interlocked*Boolean helpers, since the draining thread tests and
+    // clears it without the lock so that it can take operations off
+    // ProcessList without the lock.
+    //
+    BOOLEAN volatile PriorityQueued;
+
+    //
+    // Queues of pending operations. Operations queued at the front go on
+    // PriorityList and are processed before all others.
     //
     CXPLAT_DISPATCH_LOCK Lock;
     CXPLAT_LIST_ENTRY List;
+    CXPLAT_LIST_ENTRY PriorityList;
+
+    //
+    // Operations moved off the lists in bulk, to be processed in order. Only
+    // used by the draining thread, without the lock.
+    //
+    CXPLAT_LIST_ENTRY ProcessList;
 
 } QUIC_OPERATION_QUEUE;
 
@@ -344,7 +365,9 @@ QuicOperationEnqueueFront(
     );
 
 //
-// Dequeues an operation. Returns NULL if the queue is empty.
+// Dequeues an operation. Returns NULL if the queue is empty. Only to be called
+// by the thread draining the queue. All pending operations are taken from the
+// queue at once, so that most calls don't need the lock.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_OPERATION*
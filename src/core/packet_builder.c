@@ -822,6 +822,12 @@ QuicPacketBuilderFinalize(
         Builder->Metadata->PacketNumber,
         QuicPacketTraceType(Builder->Metadata),
         Builder->Metadata->PacketLength);
+    QuicConnQlog(
+        Connection,
+        PacketSent,
+        QuicPacketTraceType(Builder->Metadata),
+        Builder->Metadata->PacketNumber,
+        Builder->Metadata->PacketLength);
     if (QUIC_FAILED(
         QuicLossDetectionOnPacketSent(
             &Connection->LossDetection,
@@ -46,6 +46,8 @@ extern "C" {
 #include "lookup.h"
 #include "timer_wheel.h"
 #include "settings.h"
+#include "admission.h"
+#include "replay_filter.h"
 #include "library.h"
 #include "operation.h"
 #include "binding.h"
@@ -62,6 +64,7 @@ extern "C" {
 #include "ack_tracker.h"
 #include "packet_space.h"
 #include "congestion_control.h"
+#include "qlog.h"
 #include "loss_detection.h"
 #include "send.h"
 #include "crypto.h"
@@ -0,0 +1,892 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Optional qlog (JSON-SEQ) log of connection events (QUIC_QLOG_SUPPORT).
+
+    When a directory is set (QUIC_PARAM_GLOBAL_QLOG_DIR), each new connection
+    gets a log, written to "<dir>/<pid>_<CorrelationId>_<client|server>.sqlog".
+    Correlation IDs restart at 0 in every process, so the process ID keeps
+    runs that share a directory from overwriting each other's logs.
+
+    The connection's worker only appends fixed size binary records to a
+    single producer, single consumer ring in the log. A background writer
+    thread periodically drains the rings of all logs, formats the records as
+    qlog events and writes them out. If the writer falls behind and a ring
+    fills up, new records are dropped and a warning event with the number of
+    dropped records is written instead, once there is room again or the
+    connection is done with the log.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "qlog.c.clog.h"
+#endif
+
+#include <stdio.h>
+
+#ifdef QUIC_QLOG_SUPPORT
+
+//
+// The number of records in each log's ring. Must be a power of 2.
+//
+#define QUIC_QLOG_RING_SIZE             4096
+
+//
+// How often the writer drains the rings if no ring gets half full first.
+//
+#define QUIC_QLOG_FLUSH_INTERVAL_MS     100
+
+//
+// The maximum number of sent frames written out with one packet_sent event.
+//
+#define QUIC_QLOG_MAX_PENDING_FRAMES    8
+
+#define QUIC_QLOG_MAX_PATH              260
+
+typedef enum QUIC_QLOG_EVENT {
+    QUIC_QLOG_EVENT_PACKET_SENT,
+    QUIC_QLOG_EVENT_PACKET_RECEIVED,
+    QUIC_QLOG_EVENT_PACKET_LOST,
+    QUIC_QLOG_EVENT_METRICS_UPDATED,
+    QUIC_QLOG_EVENT_FRAME_SENT,
+    QUIC_QLOG_EVENT_FRAME_RECEIVED,
+    QUIC_QLOG_EVENT_DROPPED
+} QUIC_QLOG_EVENT;
+
+typedef enum QUIC_QLOG_CC_STATE {
+    QUIC_QLOG_CC_SLOW_START,
+    QUIC_QLOG_CC_CONGESTION_AVOIDANCE,
+    QUIC_QLOG_CC_RECOVERY,
+    QUIC_QLOG_CC_PERSISTENT_CONGESTION  // Recovery, after persistent congestion.
+} QUIC_QLOG_CC_STATE;
+
+typedef struct QUIC_QLOG_METRICS {
+    uint32_t CongestionWindow;
+    uint32_t BytesInFlight;
+    uint32_t SlowStartThreshold;
+    uint32_t SmoothedRtt;               // Microseconds. 0 until the first sample.
+    uint32_t MinRtt;
+    uint32_t LatestRtt;
+    uint32_t RttVariance;
+    uint32_t State;                     // QUIC_QLOG_CC_STATE
+} QUIC_QLOG_METRICS;
+
+typedef struct QUIC_QLOG_RECORD {
+    uint64_t TimeUs;
+    uint8_t Type;                       // QUIC_QLOG_EVENT
+    uint8_t PacketType;                 // QUIC_TRACE_PACKET_TYPE
+    uint8_t Reason;                     // QUIC_TRACE_PACKET_LOSS_REASON
+    uint8_t FrameType;                  // QUIC_FRAME_TYPE
+    uint32_t Length;
+    union {
+        struct {
+            uint64_t PacketNumber;
+            uint64_t StreamId;
+            uint64_t Value;
+        } Packet;
+        QUIC_QLOG_METRICS Metrics;
+    };
+} QUIC_QLOG_RECORD;
+
+typedef struct QUIC_QLOG {
+
+    //
+    // Link in the writer's list of logs.
+    //
+    CXPLAT_LIST_ENTRY Link;
+
+    //
+    // Set once the connection is done with the log.
+    //
+    int64_t volatile Closed;
+
+    //
+    // Producer state, only used by the connection's worker (and by the writer,
+    // once the log is closed).
+    //
+    int64_t CachedTail;
+    uint64_t Dropped;
+    QUIC_QLOG_METRICS LastMetrics;
+
+    //
+    // Writer state, only used by the writer thread.
+    //
+    FILE* File;
+    BOOLEAN OpenFailed;
+    BOOLEAN MetricsWritten;
+    QUIC_QLOG_METRICS WrittenMetrics;
+    uint8_t PendingFrameCount;
+    QUIC_QLOG_RECORD PendingFrames[QUIC_QLOG_MAX_PENDING_FRAMES];
+
+    BOOLEAN IsServer;
+    uint64_t CorrelationId;
+    uint64_t StartTimeUs;
+    int64_t StartTimeEpochMs;
+    char Path[QUIC_QLOG_MAX_PATH];
+
+    //
+    // Ring of records. Head is only written by the producer and Tail only by
+    // the writer.
+    //
+    int64_t volatile Head;
+    int64_t volatile Tail;
+    QUIC_QLOG_RECORD Records[QUIC_QLOG_RING_SIZE];
+
+} QUIC_QLOG;
+
+typedef struct QUIC_QLOG_WRITER {
+
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // Protected by Lock.
+    //
+    BOOLEAN ThreadStarted;
+    char Directory[QUIC_QLOG_MAX_PATH - 64];
+    CXPLAT_LIST_ENTRY NewLogs;
+
+    //
+    // Only used by the writer thread.
+    //
+    CXPLAT_LIST_ENTRY Logs;
+
+    uint32_t ProcessId;
+    BOOLEAN volatile Enabled;
+    BOOLEAN volatile Paused;
+    BOOLEAN volatile ShuttingDown;
+    CXPLAT_EVENT Wake;
+    CXPLAT_THREAD Thread;
+
+} QUIC_QLOG_WRITER;
+
+static QUIC_QLOG_WRITER QuicQlogWriter;
+
+static const char* const QuicQlogPacketTypes[] = {
+    "version_negotiation",
+    "initial",
+    "0RTT",
+    "handshake",
+    "retry",
+    "1RTT"
+};
+
+static const char* const QuicQlogLossTriggers[] = {
+    "time_threshold",       // QUIC_TRACE_PACKET_LOSS_RACK
+    "reordering_threshold", // QUIC_TRACE_PACKET_LOSS_FACK
+    "pto_expired"           // QUIC_TRACE_PACKET_LOSS_PROBE
+};
+
+static const char* const QuicQlogCcStates[] = {
+    "slow_start",
+    "congestion_avoidance",
+    "recovery",
+    "recovery"
+};
+
+CXPLAT_THREAD_CALLBACK(QuicQlogWriterThread, Context);
+
+//
+// Interlocked (full barrier) read of a value the other side of the ring
+// writes.
+//
+#define QuicQlogRead(Value) InterlockedExchangeAdd64(&(Value), 0)
+
+static
+QUIC_QLOG_RECORD*
+QuicQlogAppend(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t Type
+    )
+{
+    int64_t Head = Qlog->Head;
+    uint32_t Needed = Qlog->Dropped != 0 ? 2 : 1;
+    if (Head - Qlog->CachedTail + Needed > QUIC_QLOG_RING_SIZE) {
+        Qlog->CachedTail = QuicQlogRead(Qlog->Tail);
+        if (Head - Qlog->CachedTail + Needed > QUIC_QLOG_RING_SIZE) {
+            Qlog->Dropped++;
+            return NULL;
+        }
+    }
+
+    uint64_t TimeUs = CxPlatTimeUs64();
+    QUIC_QLOG_RECORD* Record;
+    if (Qlog->Dropped != 0) {
+        Record = &Qlog->Records[Head & (QUIC_QLOG_RING_SIZE - 1)];
+        Record->TimeUs = TimeUs;
+        Record->Type = QUIC_QLOG_EVENT_DROPPED;
+        Record->Packet.Value = Qlog->Dropped;
+        InterlockedIncrement64(&Qlog->Head);
+        Qlog->Dropped = 0;
+        ++Head;
+    }
+
+    Record = &Qlog->Records[Head & (QUIC_QLOG_RING_SIZE - 1)];
+    Record->TimeUs = TimeUs;
+    Record->Type = Type;
+    return Record;
+}
+
+static
+void
+QuicQlogCommit(
+    _In_ QUIC_QLOG* Qlog
+    )
+{
+    //
+    // Wake up the writer early every half ring, so busy connections don't
+    // have to wait for the flush interval.
+    //
+    if ((InterlockedIncrement64(&Qlog->Head) & (QUIC_QLOG_RING_SIZE / 2 - 1)) == 0) {
+        CxPlatEventSet(QuicQlogWriter.Wake);
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogInitialize(
+    void
+    )
+{
+    CxPlatZeroMemory(&QuicQlogWriter, sizeof(QuicQlogWriter));
+    CxPlatDispatchLockInitialize(&QuicQlogWriter.Lock);
+    CxPlatListInitializeHead(&QuicQlogWriter.NewLogs);
+    CxPlatListInitializeHead(&QuicQlogWriter.Logs);
+    CxPlatEventInitialize(&QuicQlogWriter.Wake, FALSE, FALSE);
+#ifdef _WIN32
+    QuicQlogWriter.ProcessId = GetCurrentProcessId();
+#else
+    QuicQlogWriter.ProcessId = (uint32_t)getpid();
+#endif
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicQlogSetDirectory(
+    _In_reads_bytes_(BufferLength)
+        const char* Buffer,
+    _In_ uint32_t BufferLength
+    )
+{
+    if (BufferLength == 0 ||
+        Buffer[BufferLength - 1] != '\0' ||
+        BufferLength > sizeof(QuicQlogWriter.Directory)) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    CxPlatDispatchLockAcquire(&QuicQlogWriter.Lock);
+
+    if (BufferLength > 1 && !QuicQlogWriter.ThreadStarted) {
+        CXPLAT_THREAD_CONFIG ThreadConfig = {
+            0,
+            0,
+            "quic_qlog",
+            QuicQlogWriterThread,
+            NULL
+        };
+        Status = CxPlatThreadCreate(&ThreadConfig, &QuicQlogWriter.Thread);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatThreadCreate (qlog)");
+            goto Exit;
+        }
+        QuicQlogWriter.ThreadStarted = TRUE;
+    }
+
+    CxPlatCopyMemory(QuicQlogWriter.Directory, Buffer, BufferLength);
+    QuicQlogWriter.Enabled = BufferLength > 1;
+
+Exit:
+
+    CxPlatDispatchLockRelease(&QuicQlogWriter.Lock);
+
+    return Status;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogSetWriterPaused(
+    _In_ BOOLEAN Paused
+    )
+{
+    QuicQlogWriter.Paused = Paused;
+    CxPlatEventSet(QuicQlogWriter.Wake);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogUninitialize(
+    void
+    )
+{
+    QuicQlogWriter.Enabled = FALSE;
+    if (QuicQlogWriter.ThreadStarted) {
+        QuicQlogWriter.ShuttingDown = TRUE;
+        CxPlatEventSet(QuicQlogWriter.Wake);
+        CxPlatThreadWait(&QuicQlogWriter.Thread);
+        CxPlatThreadDelete(&QuicQlogWriter.Thread);
+    }
+
+    CxPlatEventUninitialize(QuicQlogWriter.Wake);
+    CxPlatDispatchLockUninitialize(&QuicQlogWriter.Lock);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_QLOG*
+QuicQlogOpen(
+    _In_ uint64_t CorrelationId,
+    _In_ BOOLEAN IsServer
+    )
+{
+    if (!QuicQlogWriter.Enabled) {
+        return NULL;
+    }
+
+    QUIC_QLOG* Qlog = CXPLAT_ALLOC_NONPAGED(sizeof(QUIC_QLOG), QUIC_POOL_QLOG);
+    if (Qlog == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "qlog",
+            sizeof(QUIC_QLOG));
+        return NULL;
+    }
+
+    //
+    // Only the header is initialized; the records are written before use.
+    //
+    CxPlatZeroMemory(Qlog, FIELD_OFFSET(QUIC_QLOG, Records));
+    Qlog->IsServer = IsServer;
+    Qlog->CorrelationId = CorrelationId;
+    Qlog->StartTimeUs = CxPlatTimeUs64();
+    Qlog->StartTimeEpochMs = CxPlatTimeEpochMs64();
+
+    CxPlatDispatchLockAcquire(&QuicQlogWriter.Lock);
+    if (QuicQlogWriter.Enabled) {
+        snprintf(
+            Qlog->Path,
+            sizeof(Qlog->Path),
+            "%s/%u_%llu_%s.sqlog",
+            QuicQlogWriter.Directory,
+            QuicQlogWriter.ProcessId,
+            (unsigned long long)CorrelationId,
+            IsServer ? "server" : "client");
+        CxPlatListInsertTail(&QuicQlogWriter.NewLogs, &Qlog->Link);
+    } else {
+        CXPLAT_FREE(Qlog, QUIC_POOL_QLOG);
+        Qlog = NULL;
+    }
+    CxPlatDispatchLockRelease(&QuicQlogWriter.Lock);
+
+    return Qlog;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogClose(
+    _In_ QUIC_QLOG* Qlog
+    )
+{
+    InterlockedIncrement64(&Qlog->Closed);
+    CxPlatEventSet(QuicQlogWriter.Wake);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketSent(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t PacketNumber,
+    _In_ uint16_t Length
+    )
+{
+    QUIC_QLOG_RECORD* Record = QuicQlogAppend(Qlog, QUIC_QLOG_EVENT_PACKET_SENT);
+    if (Record != NULL) {
+        Record->PacketType = PacketType;
+        Record->Length = Length;
+        Record->Packet.PacketNumber = PacketNumber;
+        QuicQlogCommit(Qlog);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketReceived(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t PacketNumber,
+    _In_ uint16_t Length
+    )
+{
+    QUIC_QLOG_RECORD* Record = QuicQlogAppend(Qlog, QUIC_QLOG_EVENT_PACKET_RECEIVED);
+    if (Record != NULL) {
+        Record->PacketType = PacketType;
+        Record->Length = Length;
+        Record->Packet.PacketNumber = PacketNumber;
+        QuicQlogCommit(Qlog);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketLost(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,
+    _In_ uint64_t PacketNumber,
+    _In_ uint8_t Reason
+    )
+{
+    QUIC_QLOG_RECORD* Record = QuicQlogAppend(Qlog, QUIC_QLOG_EVENT_PACKET_LOST);
+    if (Record != NULL) {
+        Record->PacketType = PacketType;
+        Record->Reason = Reason;
+        Record->Packet.PacketNumber = PacketNumber;
+        QuicQlogCommit(Qlog);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogMetricsUpdated(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ const QUIC_CONNECTION* Connection
+    )
+{
+    const QUIC_CONGESTION_CONTROL* Cc = &Connection->CongestionControl;
+    const QUIC_PATH* Path = &Connection->Paths[0];
+
+    if (Cc->CongestionWindow == 0) {
+        return; // Not initialized yet.
+    }
+
+    QUIC_QLOG_METRICS Metrics;
+    Metrics.CongestionWindow = Cc->CongestionWindow;
+    Metrics.BytesInFlight = Cc->BytesInFlight;
+    Metrics.SlowStartThreshold = Cc->SlowStartThreshold;
+    if (Path->GotFirstRttSample) {
+        Metrics.SmoothedRtt = Path->SmoothedRtt;
+        Metrics.MinRtt = Path->MinRtt;
+        Metrics.LatestRtt = Path->LatestRttSample;
+        Metrics.RttVariance = Path->RttVariance;
+    } else {
+        Metrics.SmoothedRtt = Metrics.MinRtt = Metrics.LatestRtt = Metrics.RttVariance = 0;
+    }
+    if (Cc->IsInPersistentCongestion) {
+        Metrics.State = QUIC_QLOG_CC_PERSISTENT_CONGESTION;
+    } else if (Cc->IsInRecovery) {
+        Metrics.State = QUIC_QLOG_CC_RECOVERY;
+    } else if (Cc->CongestionWindow < Cc->SlowStartThreshold) {
+        Metrics.State = QUIC_QLOG_CC_SLOW_START;
+    } else {
+        Metrics.State = QUIC_QLOG_CC_CONGESTION_AVOIDANCE;
+    }
+
+    if (memcmp(&Metrics, &Qlog->LastMetrics, sizeof(Metrics)) == 0) {
+        return;
+    }
+
+    QUIC_QLOG_RECORD* Record = QuicQlogAppend(Qlog, QUIC_QLOG_EVENT_METRICS_UPDATED);
+    if (Record != NULL) {
+        Record->Metrics = Metrics;
+        Qlog->LastMetrics = Metrics;
+        QuicQlogCommit(Qlog);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogFlowControlFrame(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ BOOLEAN IsSend,
+    _In_ uint8_t FrameType,
+    _In_ uint64_t PacketNumber,
+    _In_ uint64_t StreamId,
+    _In_ uint64_t Value
+    )
+{
+    QUIC_QLOG_RECORD* Record =
+        QuicQlogAppend(
+            Qlog,
+            IsSend ? QUIC_QLOG_EVENT_FRAME_SENT : QUIC_QLOG_EVENT_FRAME_RECEIVED);
+    if (Record != NULL) {
+        Record->FrameType = FrameType;
+        Record->Packet.PacketNumber = PacketNumber;
+        Record->Packet.StreamId = StreamId;
+        Record->Packet.Value = Value;
+        QuicQlogCommit(Qlog);
+    }
+}
+
+//
+// Writer thread.
+//
+
+static
+void
+QuicQlogWriteTime(
+    _In_ const QUIC_QLOG* Qlog,
+    _In_ const QUIC_QLOG_RECORD* Record,
+    _In_z_ const char* Name
+    )
+{
+    uint64_t TimeUs = Record->TimeUs - Qlog->StartTimeUs;
+    fprintf(
+        Qlog->File,
+        "\x1e{\"time\":%llu.%03u,\"name\":\"%s\",\"data\":{",
+        (unsigned long long)(TimeUs / 1000),
+        (uint32_t)(TimeUs % 1000),
+        Name);
+}
+
+static
+void
+QuicQlogWriteMs(
+    _In_ FILE* File,
+    _In_z_ const char* Name,
+    _In_ uint32_t TimeUs,
+    _Inout_ BOOLEAN* First
+    )
+{
+    fprintf(
+        File,
+        "%s\"%s\":%u.%03u",
+        *First ? "" : ",",
+        Name,
+        TimeUs / 1000,
+        TimeUs % 1000);
+    *First = FALSE;
+}
+
+static
+void
+QuicQlogWriteHeader(
+    _In_ FILE* File,
+    _In_ const QUIC_QLOG_RECORD* Record
+    )
+{
+    fprintf(
+        File,
+        "\"header\":{\"packet_type\":\"%s\",\"packet_number\":%llu}",
+        Record->PacketType < ARRAYSIZE(QuicQlogPacketTypes) ?
+            QuicQlogPacketTypes[Record->PacketType] : "unknown",
+        (unsigned long long)Record->Packet.PacketNumber);
+}
+
+static
+void
+QuicQlogWriteFrame(
+    _In_ FILE* File,
+    _In_ const QUIC_QLOG_RECORD* Record
+    )
+{
+    switch (Record->FrameType) {
+    case QUIC_FRAME_MAX_DATA:
+        fprintf(
+            File,
+            "{\"frame_type\":\"max_data\",\"maximum\":%llu}",
+            (unsigned long long)Record->Packet.Value);
+        break;
+    case QUIC_FRAME_MAX_STREAM_DATA:
+        fprintf(
+            File,
+            "{\"frame_type\":\"max_stream_data\",\"stream_id\":%llu,\"maximum\":%llu}",
+            (unsigned long long)Record->Packet.StreamId,
+            (unsigned long long)Record->Packet.Value);
+        break;
+    case QUIC_FRAME_DATA_BLOCKED:
+        fprintf(
+            File,
+            "{\"frame_type\":\"data_blocked\",\"limit\":%llu}",
+            (unsigned long long)Record->Packet.Value);
+        break;
+    case QUIC_FRAME_STREAM_DATA_BLOCKED:
+        fprintf(
+            File,
+            "{\"frame_type\":\"stream_data_blocked\",\"stream_id\":%llu,\"limit\":%llu}",
+            (unsigned long long)Record->Packet.StreamId,
+            (unsigned long long)Record->Packet.Value);
+        break;
+    default:
+        fprintf(File, "{\"frame_type\":\"unknown\",\"raw_frame_type\":%u}", Record->FrameType);
+        break;
+    }
+}
+
+static
+void
+QuicQlogWriteMetrics(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ const QUIC_QLOG_RECORD* Record
+    )
+{
+    const QUIC_QLOG_METRICS* New = &Record->Metrics;
+    const QUIC_QLOG_METRICS* Old = &Qlog->WrittenMetrics;
+    BOOLEAN All = !Qlog->MetricsWritten;
+
+    //
+    // Like the spec asks for, only the metrics that changed are written.
+    //
+    if (All ||
+        New->CongestionWindow != Old->CongestionWindow ||
+        New->BytesInFlight != Old->BytesInFlight ||
+        New->SlowStartThreshold != Old->SlowStartThreshold ||
+        New->SmoothedRtt != Old->SmoothedRtt ||
+        New->MinRtt != Old->MinRtt ||
+        New->LatestRtt != Old->LatestRtt ||
+        New->RttVariance != Old->RttVariance) {
+
+        BOOLEAN First = TRUE;
+        QuicQlogWriteTime(Qlog, Record, "recovery:metrics_updated");
+        if (All || New->CongestionWindow != Old->CongestionWindow) {
+            fprintf(Qlog->File, "\"congestion_window\":%u", New->CongestionWindow);
+            First = FALSE;
+        }
+        if (All || New->BytesInFlight != Old->BytesInFlight) {
+            fprintf(Qlog->File, "%s\"bytes_in_flight\":%u", First ? "" : ",", New->BytesInFlight);
+            First = FALSE;
+        }
+        if ((All || New->SlowStartThreshold != Old->SlowStartThreshold) &&
+            New->SlowStartThreshold != UINT32_MAX) {
+            fprintf(Qlog->File, "%s\"ssthresh\":%u", First ? "" : ",", New->SlowStartThreshold);
+            First = FALSE;
+        }
+        if (New->SmoothedRtt != 0) {
+            if (All || New->SmoothedRtt != Old->SmoothedRtt) {
+                QuicQlogWriteMs(Qlog->File, "smoothed_rtt", New->SmoothedRtt, &First);
+            }
+            if (All || New->MinRtt != Old->MinRtt) {
+                QuicQlogWriteMs(Qlog->File, "min_rtt", New->MinRtt, &First);
+            }
+            if (All || New->LatestRtt != Old->LatestRtt) {
+                QuicQlogWriteMs(Qlog->File, "latest_rtt", New->LatestRtt, &First);
+            }
+            if (All || New->RttVariance != Old->RttVariance) {
+                QuicQlogWriteMs(Qlog->File, "rtt_variance", New->RttVariance, &First);
+            }
+        }
+        fprintf(Qlog->File, "}}\n");
+    }
+
+    if (All || New->State != Old->State) {
+        QuicQlogWriteTime(Qlog, Record, "recovery:congestion_state_updated");
+        if (!All) {
+            fprintf(Qlog->File, "\"old\":\"%s\",", QuicQlogCcStates[Old->State]);
+        }
+        fprintf(Qlog->File, "\"new\":\"%s\"", QuicQlogCcStates[New->State]);
+        if (New->State == QUIC_QLOG_CC_PERSISTENT_CONGESTION) {
+            fprintf(Qlog->File, ",\"trigger\":\"persistent_congestion\"");
+        }
+        fprintf(Qlog->File, "}}\n");
+    }
+
+    Qlog->WrittenMetrics = *New;
+    Qlog->MetricsWritten = TRUE;
+}
+
+static
+void
+QuicQlogWriteRecord(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ const QUIC_QLOG_RECORD* Record
+    )
+{
+    FILE* File = Qlog->File;
+
+    switch (Record->Type) {
+    case QUIC_QLOG_EVENT_PACKET_SENT:
+        QuicQlogWriteTime(Qlog, Record, "transport:packet_sent");
+        QuicQlogWriteHeader(File, Record);
+        fprintf(File, ",\"raw\":{\"length\":%u}", Record->Length);
+        if (Qlog->PendingFrameCount != 0 &&
+            Qlog->PendingFrames[0].Packet.PacketNumber == Record->Packet.PacketNumber) {
+            fprintf(File, ",\"frames\":[");
+            for (uint8_t i = 0; i < Qlog->PendingFrameCount; ++i) {
+                if (i != 0) {
+                    fprintf(File, ",");
+                }
+                QuicQlogWriteFrame(File, &Qlog->PendingFrames[i]);
+            }
+            fprintf(File, "]");
+        }
+        Qlog->PendingFrameCount = 0;
+        fprintf(File, "}}\n");
+        break;
+
+    case QUIC_QLOG_EVENT_PACKET_RECEIVED:
+        QuicQlogWriteTime(Qlog, Record, "transport:packet_received");
+        QuicQlogWriteHeader(File, Record);
+        fprintf(File, ",\"raw\":{\"length\":%u}}}\n", Record->Length);
+        break;
+
+    case QUIC_QLOG_EVENT_PACKET_LOST:
+        QuicQlogWriteTime(Qlog, Record, "recovery:packet_lost");
+        QuicQlogWriteHeader(File, Record);
+        fprintf(
+            File,
+            ",\"trigger\":\"%s\"}}\n",
+            Record->Reason < ARRAYSIZE(QuicQlogLossTriggers) ?
+                QuicQlogLossTriggers[Record->Reason] : "unknown");
+        break;
+
+    case QUIC_QLOG_EVENT_METRICS_UPDATED:
+        QuicQlogWriteMetrics(Qlog, Record);
+        break;
+
+    case QUIC_QLOG_EVENT_FRAME_SENT:
+        //
+        // The packet_sent event of the packet the frame is in comes next.
+        //
+        if (Qlog->PendingFrameCount != 0 &&
+            Qlog->PendingFrames[0].Packet.PacketNumber != Record->Packet.PacketNumber) {
+            Qlog->PendingFrameCount = 0;
+        }
+        if (Qlog->PendingFrameCount < QUIC_QLOG_MAX_PENDING_FRAMES) {
+            Qlog->PendingFrames[Qlog->PendingFrameCount++] = *Record;
+        }
+        break;
+
+    case QUIC_QLOG_EVENT_FRAME_RECEIVED:
+        QuicQlogWriteTime(Qlog, Record, "transport:frames_processed");
+        fprintf(File, "\"frames\":[");
+        QuicQlogWriteFrame(File, Record);
+        fprintf(
+            File,
+            "],\"packet_number\":%llu}}\n",
+            (unsigned long long)Record->Packet.PacketNumber);
+        break;
+
+    case QUIC_QLOG_EVENT_DROPPED:
+        QuicQlogWriteTime(Qlog, Record, "loglevel:warning");
+        fprintf(
+            File,
+            "\"message\":\"%llu events dropped, the qlog writer fell behind\"}}\n",
+            (unsigned long long)Record->Packet.Value);
+        break;
+
+    default:
+        CXPLAT_DBG_ASSERT(FALSE);
+        break;
+    }
+}
+
+static
+void
+QuicQlogOpenFile(
+    _In_ QUIC_QLOG* Qlog
+    )
+{
+    Qlog->File = fopen(Qlog->Path, "w");
+    if (Qlog->File == NULL) {
+        QuicTraceLogWarning(
+            QlogOpenFailed,
+            "[qlog] Failed to open %s",
+            Qlog->Path);
+        Qlog->OpenFailed = TRUE;
+        return;
+    }
+
+    fprintf(
+        Qlog->File,
+        "\x1e{\"qlog_version\":\"0.3\",\"qlog_format\":\"JSON-SEQ\",\"title\":\"msquic\","
+        "\"trace\":{\"vantage_point\":{\"name\":\"msquic\",\"type\":\"%s\"},"
+        "\"common_fields\":{\"group_id\":\"%llu\",\"protocol_type\":[\"QUIC\"],"
+        "\"time_format\":\"relative\",\"reference_time\":%lld}}}\n",
+        Qlog->IsServer ? "server" : "client",
+        (unsigned long long)Qlog->CorrelationId,
+        (long long)Qlog->StartTimeEpochMs);
+}
+
+//
+// Writes out all the records in the log's ring. For the last drain of a
+// closed log, this includes the warning for any records dropped since the
+// ring last had room.
+//
+static
+void
+QuicQlogDrain(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ BOOLEAN Closed
+    )
+{
+    if (Qlog->File == NULL && !Qlog->OpenFailed) {
+        QuicQlogOpenFile(Qlog);
+    }
+
+    int64_t Tail = Qlog->Tail;
+    const int64_t Head = QuicQlogRead(Qlog->Head);
+    if (Qlog->File != NULL) {
+        for (; Tail != Head; ++Tail) {
+            QuicQlogWriteRecord(Qlog, &Qlog->Records[Tail & (QUIC_QLOG_RING_SIZE - 1)]);
+        }
+        if (Closed && Qlog->Dropped != 0) {
+            QUIC_QLOG_RECORD Record;
+            Record.TimeUs = CxPlatTimeUs64();
+            Record.Type = QUIC_QLOG_EVENT_DROPPED;
+            Record.Packet.Value = Qlog->Dropped;
+            QuicQlogWriteRecord(Qlog, &Record);
+        }
+        fflush(Qlog->File);
+    }
+    InterlockedExchangeAdd64(&Qlog->Tail, Head - Qlog->Tail);
+}
+
+CXPLAT_THREAD_CALLBACK(QuicQlogWriterThread, Context)
+{
+    UNREFERENCED_PARAMETER(Context);
+
+    BOOLEAN ShuttingDown;
+    do {
+        CxPlatEventWaitWithTimeout(QuicQlogWriter.Wake, QUIC_QLOG_FLUSH_INTERVAL_MS);
+        ShuttingDown = QuicQlogWriter.ShuttingDown;
+
+        CxPlatDispatchLockAcquire(&QuicQlogWriter.Lock);
+        CxPlatListMoveItems(&QuicQlogWriter.NewLogs, &QuicQlogWriter.Logs);
+        CxPlatDispatchLockRelease(&QuicQlogWriter.Lock);
+
+        if (QuicQlogWriter.Paused && !ShuttingDown) {
+            continue;
+        }
+
+        CXPLAT_LIST_ENTRY* Entry = QuicQlogWriter.Logs.Flink;
+        while (Entry != &QuicQlogWriter.Logs) {
+            QUIC_QLOG* Qlog = CXPLAT_CONTAINING_RECORD(Entry, QUIC_QLOG, Link);
+            Entry = Entry->Flink;
+
+            //
+            // Closed is read before draining, so that nothing can be appended
+            // after the last drain of a closed log.
+            //
+            const BOOLEAN Closed = QuicQlogRead(Qlog->Closed) != 0;
+            QuicQlogDrain(Qlog, Closed);
+
+            //
+            // All connections are gone by the time the library shuts down, so
+            // every log should be closed by then too.
+            //
+            CXPLAT_DBG_ASSERT(Closed || !ShuttingDown);
+            if (Closed || ShuttingDown) {
+                CxPlatListEntryRemove(&Qlog->Link);
+                if (Qlog->File != NULL) {
+                    fclose(Qlog->File);
+                    Qlog->File = NULL;
+                }
+                if (Closed) {
+                    CXPLAT_FREE(Qlog, QUIC_POOL_QLOG);
+                }
+            }
+        }
+    } while (!ShuttingDown);
+
+    CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
+}
+
+#endif // QUIC_QLOG_SUPPORT
@@ -0,0 +1,132 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Optional qlog (JSON-SEQ) log of connection events, for use with qvis.
+
+--*/
+
+#ifdef QUIC_QLOG_SUPPORT
+
+typedef struct QUIC_QLOG QUIC_QLOG;
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogInitialize(
+    void
+    );
+
+//
+// Sets the directory new connections write their qlog files to. An empty
+// string disables logging for new connections.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+QuicQlogSetDirectory(
+    _In_reads_bytes_(BufferLength)
+        const char* Buffer,
+    _In_ uint32_t BufferLength
+    );
+
+//
+// While paused, the writer thread doesn't write anything out, so the rings
+// fill up and events get dropped. Only meant for testing.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogSetWriterPaused(
+    _In_ BOOLEAN Paused
+    );
+
+//
+// Stops the writer thread, once all logs are written out.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicQlogUninitialize(
+    void
+    );
+
+//
+// Returns NULL if logging is disabled (or on allocation failure).
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_QLOG*
+QuicQlogOpen(
+    _In_ uint64_t CorrelationId,
+    _In_ BOOLEAN IsServer
+    );
+
+//
+// Hands the log over to the writer thread, which frees it once everything
+// has been written out.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogClose(
+    _In_ QUIC_QLOG* Qlog
+    );
+
+//
+// The event functions below only append a binary record to the log's ring;
+// they must only be called from the connection's worker. The writer thread
+// formats the records as JSON later.
+//
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketSent(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,        // QUIC_TRACE_PACKET_TYPE
+    _In_ uint64_t PacketNumber,
+    _In_ uint16_t Length
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketReceived(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,        // QUIC_TRACE_PACKET_TYPE
+    _In_ uint64_t PacketNumber,
+    _In_ uint16_t Length
+    );
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogPacketLost(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ uint8_t PacketType,        // QUIC_TRACE_PACKET_TYPE
+    _In_ uint64_t PacketNumber,
+    _In_ uint8_t Reason             // QUIC_TRACE_PACKET_LOSS_REASON
+    );
+
+//
+// Records the congestion control and RTT state, if it changed since the last
+// call.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogMetricsUpdated(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ const QUIC_CONNECTION* Connection
+    );
+
+//
+// Records a MAX_DATA, MAX_STREAM_DATA, DATA_BLOCKED or STREAM_DATA_BLOCKED
+// frame. Sent frames are written as part of their packet's packet_sent event.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicQlogFlowControlFrame(
+    _In_ QUIC_QLOG* Qlog,
+    _In_ BOOLEAN IsSend,
+    _In_ uint8_t FrameType,         // QUIC_FRAME_TYPE
+    _In_ uint64_t PacketNumber,
+    _In_ uint64_t StreamId,         // Ignored for connection frames.
+    _In_ uint64_t Value
+    );
+
+#endif // QUIC_QLOG_SUPPORT
@@ -150,6 +150,86 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_STATELESS_OPERATION_EXPIRATION_MS  100
 
+//
+// The default rate (per second) of new connection attempts at which admission
+// control starts requiring address validation. Per-prefix rate limiting kicks
+// in at twice this rate and dropping unvalidated attempts at four times. Zero
+// disables admission control.
+//
+#define QUIC_DEFAULT_ADMISSION_INITIAL_RATE     0
+
+//
+// The interval over which admission control measures the connection attempt
+// rate and handshake CPU cost, and reevaluates its level.
+//
+#define QUIC_ADMISSION_INTERVAL_MS              100
+
+//
+// The number of consecutive intervals the measured load must call for a lower
+// level before admission control steps down one level.
+//
+#define QUIC_ADMISSION_COOLDOWN_INTERVALS       10
+
+//
+// The number of source prefixes (/24 for IPv4, /48 for IPv6) admission control
+// tracks. Must be a power of 2.
+//
+#define QUIC_ADMISSION_PREFIX_COUNT             256
+
+//
+// The number of independently locked shards the tracked source prefixes are
+// split into, so that connection attempts and handshakes from different
+// prefixes don't serialize on a single lock. Must be a power of 2, no larger
+// than QUIC_ADMISSION_PREFIX_COUNT.
+//
+#define QUIC_ADMISSION_SHARD_COUNT              16
+
+//
+// Each source prefix may use 1/Nth of the admission rate once per-prefix rate
+// limiting is in effect.
+//
+#define QUIC_ADMISSION_PREFIX_RATE_DIVISOR      16
+
+//
+// The handshake CPU cost (in microseconds) that makes a connection attempt
+// from a source prefix use one more token of the prefix's rate limit, and the
+// most tokens a single attempt may use.
+//
+#define QUIC_ADMISSION_HANDSHAKE_COST_UNIT_US   1000
+#define QUIC_ADMISSION_MAX_ATTEMPT_COST         8
+
+//
+// The percent of the machine's CPU time spent processing handshakes at which
+// admission control goes one level beyond what the connection attempt rate
+// calls for.
+//
+#define QUIC_ADMISSION_HANDSHAKE_CPU_PERCENT    50
+
+//
+// The default memory (in bytes) for the server's 0-RTT anti-replay filter.
+// Zero disables the filter, and 0-RTT is accepted without replay protection.
+//
+#define QUIC_DEFAULT_ZERO_RTT_REPLAY_FILTER_SIZE    0
+
+//
+// The default window (in milliseconds) the 0-RTT anti-replay filter remembers
+// tickets for. 0-RTT is only accepted with tickets issued within the window.
+//
+#define QUIC_DEFAULT_ZERO_RTT_REPLAY_WINDOW_MS      (60 * 60 * 1000)
+
+//
+// The 0-RTT anti-replay filter is split into independently locked shards,
+// each made up of time buckets that are cleared in turn as the window moves.
+// Must be powers of 2.
+//
+#define QUIC_REPLAY_FILTER_SHARD_COUNT          16
+#define QUIC_REPLAY_FILTER_BUCKET_COUNT         4
+
+//
+// The number of bits set in a replay filter bucket for each ticket.
+//
+#define QUIC_REPLAY_FILTER_HASH_COUNT           4
+
 //
 // The maximum number of operations a connection will drain from its queue per
 // call to QuicConnDrainOperations.
@@ -169,6 +249,27 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_STREAM_SEND_BATCH_COUNT            8
 
+//
+// The send priority a stream starts with. Streams with a higher priority are
+// always scheduled before streams with a lower one.
+//
+#define QUIC_DEFAULT_STREAM_PRIORITY            0x7FFF
+
+//
+// The send weight a stream starts with. With round robin scheduling, each turn
+// of a stream sends up to its weight times QUIC_STREAM_SEND_BATCH_COUNT
+// packets.
+//
+#define QUIC_DEFAULT_STREAM_WEIGHT              1
+
+//
+// The initial and maximum number of entries in each stream type's sliding
+// window of open streams. Streams that don't fit in the window are kept in the
+// stream set's hash table instead. Both must be powers of two.
+//
+#define QUIC_STREAM_WINDOW_INITIAL_SIZE         8
+#define QUIC_STREAM_WINDOW_MAX_SIZE             4096
+
 //
 // The maximum number of received packets to batch process at a time.
 //
@@ -185,6 +286,13 @@ typedef struct QUIC_PATH QUIC_PATH;
 //
 #define QUIC_MAX_RECEIVE_QUEUE_COUNT            0x1000      // 4096
 
+//
+// The maximum number of received packets a single connection may hold on to
+// for in place stream receive indications. Beyond this, stream data is copied
+// into the receive buffer as usual.
+//
+#define QUIC_MAX_RECV_IN_PLACE_COUNT            16
+
 //
 // The maximum number of pending datagrams we will hold on to, per connection,
 // per packet number space. We base our max on the expected initial window size
@@ -208,10 +316,19 @@ typedef struct QUIC_PATH QUIC_PATH;
 #define QUIC_DEFAULT_STREAM_FC_WINDOW_SIZE      0x8000  // 32768
 
 //
-// The initial stream receive buffer allocation size.
+// The initial stream receive buffer allocation size. Stream receive buffers
+// grow in chunks of this size.
 //
 #define QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE    0x1000  // 4096
 
+//
+// The number of buffers a stream receive event can indicate without
+// allocating. Receive events indicate all the contiguous data available, so
+// data spanning more receive buffer chunks than this (i.e. more than 32 KB
+// with default chunks) is indicated from a temporary, allocated array.
+//
+#define QUIC_MAX_RECV_INDICATION_BUFFER_COUNT   8
+
 //
 // The default connection flow control window value, in bytes.
 //
@@ -388,6 +505,18 @@ CXPLAT_STATIC_ASSERT(
 //
 #define QUIC_DEFAULT_DATAGRAM_RECEIVE_ENABLED   FALSE
 
+//
+// The default value for indicating in-order stream data to the app directly
+// from the received packet, instead of copying it into the receive buffer.
+//
+#define QUIC_DEFAULT_STREAM_RECV_IN_PLACE_ENABLED   FALSE
+
+//
+// The default value for offloading the server's TLS handshake processing to
+// the platform's crypto thread pool, instead of running it on the worker.
+//
+#define QUIC_DEFAULT_TLS_OFFLOAD_ENABLED        FALSE
+
 //
 // The default max_datagram_frame_length transport parameter value we send. Set
 // to max uint16 to not explicitly limit the length of datagrams.
@@ -404,7 +533,7 @@ CXPLAT_STATIC_ASSERT(
 // Version of the wire-format for resumption tickets.
 // This needs to be incremented for each change in order or count of fields.
 //
-#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      1
+#define CXPLAT_TLS_RESUMPTION_TICKET_VERSION      2
 
 //
 // Version of the blob for client resumption tickets.
@@ -435,12 +564,17 @@ CXPLAT_STATIC_ASSERT(
 #define QUIC_SETTING_LOAD_BALANCING_MODE            "LoadBalancingMode"
 #define QUIC_SETTING_MAX_WORKER_QUEUE_DELAY         "MaxWorkerQueueDelayMs"
 #define QUIC_SETTING_MAX_STATELESS_OPERATIONS       "MaxStatelessOperations"
+#define QUIC_SETTING_ADMISSION_INITIAL_RATE         "AdmissionInitialRate"
+#define QUIC_SETTING_ZERO_RTT_REPLAY_FILTER_SIZE    "ZeroRttReplayFilterSize"
+#define QUIC_SETTING_ZERO_RTT_REPLAY_WINDOW         "ZeroRttReplayWindowMs"
 #define QUIC_SETTING_MAX_OPERATIONS_PER_DRAIN       "MaxOperationsPerDrain"
 
 #define QUIC_SETTING_SEND_BUFFERING_DEFAULT         "SendBufferingDefault"
 #define QUIC_SETTING_SEND_PACING_DEFAULT            "SendPacingDefault"
 #define QUIC_SETTING_MIGRATION_ENABLED              "MigrationEnabled"
 #define QUIC_SETTING_DATAGRAM_RECEIVE_ENABLED       "DatagramReceiveEnabled"
+#define QUIC_SETTING_STREAM_RECV_IN_PLACE_ENABLED   "StreamRecvInPlaceEnabled"
+#define QUIC_SETTING_TLS_OFFLOAD_ENABLED            "TlsOffloadEnabled"
 
 #define QUIC_SETTING_INITIAL_WINDOW_PACKETS         "InitialWindowPackets"
 #define QUIC_SETTING_SEND_IDLE_TIMEOUT_MS           "SendIdleTimeoutMs"
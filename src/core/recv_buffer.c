@@ -5,13 +5,24 @@
 
 Abstract:
 
-    The receive buffer is a dynamically sized circular buffer for reassembling
-    stream data and holding it until it's delivered to the client.
-
-    When the buffer is resized, all bytes in the buffer are copied to a new
-    backing memory of the requested size. The client must keep this in mind and
-    only resize the buffer infrequently, for instance by resizing exponentially,
-    or try to resize when few bytes are buffered.
+    The receive buffer is a dynamically sized buffer for reassembling stream
+    data and holding it until it's delivered to the client.
+
+    The backing memory is a ring of chunks. In chunked mode (used for streams)
+    every chunk is the same fixed size, and is normally allocated from a pool
+    shared by all the streams on the worker. The buffer grows by appending
+    chunks to the end of the ring, and chunks are freed from the front of the
+    ring as they are drained, so bytes are never copied once they have been
+    written, no matter how large the buffer gets. Since every chunk is the same
+    size, the chunk holding any offset is found by indexing the ring directly.
+    As the data may span several chunks, reads can return more than one buffer.
+
+    In contiguous mode (used for crypto, which needs all the data in a single
+    buffer) there is only ever one chunk. Draining just moves the start of the
+    buffer forward. When a write doesn't fit in what's left at the end, the
+    remaining bytes are moved back to the front if that makes enough room, and
+    otherwise they are copied to a new chunk of double the size. The client
+    must keep this in mind and try to only grow the buffer infrequently.
 
     There are two size variables, AllocBufferLength and VirtualBufferLength.
     The first indicates the length of the physical buffer that has been
@@ -23,8 +34,8 @@ Abstract:
     the queued up buffer.
 
     When physical buffer space runs out, assuming more 'virtual' space is
-    available, the physical buffer will be reallocated and copied over.
-    Physical buffer space always doubles in size as it grows.
+    available, more chunks are appended (or, in contiguous mode, the chunk is
+    reallocated and copied over, doubling in size).
 
     The VirtualBufferLength is what is used to report the maximum allowed
     stream offset to the peer. Again, if the application drains at a fast
@@ -48,13 +59,76 @@ Abstract:
 #endif
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
-QUIC_STATUS // TODO - Can only fail if PreallocatedBuffer == NULL
+_Success_(return != NULL)
+QUIC_RECV_CHUNK*
+QuicRecvBufferAllocChunk(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t ChunkLength
+    )
+{
+    QUIC_RECV_CHUNK* Chunk;
+    if (RecvBuffer->ChunkPool != NULL) {
+        CXPLAT_DBG_ASSERT(ChunkLength == RecvBuffer->ChunkLength);
+        Chunk = CxPlatPoolAlloc(RecvBuffer->ChunkPool);
+    } else {
+        Chunk =
+            CXPLAT_ALLOC_NONPAGED(
+                sizeof(QUIC_RECV_CHUNK) + ChunkLength,
+                QUIC_POOL_RECVBUF);
+    }
+
+    if (Chunk == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer chunk",
+            sizeof(QUIC_RECV_CHUNK) + ChunkLength);
+    } else {
+        Chunk->AllocLength = ChunkLength;
+    }
+
+    return Chunk;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferFreeChunk(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ __drv_freesMem(Mem) QUIC_RECV_CHUNK* Chunk
+    )
+{
+    if (RecvBuffer->ChunkPool != NULL) {
+        CxPlatPoolFree(RecvBuffer->ChunkPool, Chunk);
+    } else {
+        CXPLAT_FREE(Chunk, QUIC_POOL_RECVBUF);
+    }
+}
+
+//
+// Returns the chunk at the given index in the ring, counting from the first
+// chunk.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_RECV_CHUNK*
+QuicRecvBufferGetChunkAt(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint32_t Index
+    )
+{
+    CXPLAT_DBG_ASSERT(Index < RecvBuffer->ChunkCount);
+    return
+        RecvBuffer->Chunks[
+            (RecvBuffer->FirstChunk + Index) & (RecvBuffer->ChunkArrayLength - 1)];
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
 QuicRecvBufferInitialize(
     _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
-    _In_ BOOLEAN CopyOnDrain,
-    _In_opt_ uint8_t* PreallocatedBuffer
+    _In_ QUIC_RECV_BUF_MODE Mode,
+    _In_opt_ CXPLAT_POOL* ChunkPool
     )
 {
     QUIC_STATUS Status;
@@ -62,33 +136,32 @@ QuicRecvBufferInitialize(
     CXPLAT_DBG_ASSERT(AllocBufferLength != 0 && (AllocBufferLength & (AllocBufferLength - 1)) == 0);       // Power of 2
     CXPLAT_DBG_ASSERT(VirtualBufferLength != 0 && (VirtualBufferLength & (VirtualBufferLength - 1)) == 0); // Power of 2
     CXPLAT_DBG_ASSERT(AllocBufferLength <= VirtualBufferLength);
-
-    if (PreallocatedBuffer != NULL) {
-        RecvBuffer->PreallocatedBuffer = PreallocatedBuffer;
-        RecvBuffer->Buffer = PreallocatedBuffer;
-    } else {
-        RecvBuffer->PreallocatedBuffer = NULL;
-        RecvBuffer->Buffer = CXPLAT_ALLOC_NONPAGED(AllocBufferLength, QUIC_POOL_RECVBUF);
-        if (RecvBuffer->Buffer == NULL) {
-            QuicTraceEvent(
-                AllocFailure,
-                "Allocation of '%s' failed. (%llu bytes)",
-                "recv_buffer",
-                AllocBufferLength);
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Error;
-        }
+    CXPLAT_DBG_ASSERT(Mode == QUIC_RECV_BUF_MODE_CHUNKED || ChunkPool == NULL);
+
+    RecvBuffer->Mode = Mode;
+    RecvBuffer->ChunkPool = ChunkPool;
+    RecvBuffer->ChunkLength = AllocBufferLength;
+    RecvBuffer->Chunks = RecvBuffer->PreallocChunks;
+    RecvBuffer->ChunkArrayLength = ARRAYSIZE(RecvBuffer->PreallocChunks);
+    RecvBuffer->FirstChunk = 0;
+    RecvBuffer->ChunkCount = 0;
+
+    QUIC_RECV_CHUNK* Chunk = QuicRecvBufferAllocChunk(RecvBuffer, AllocBufferLength);
+    if (Chunk == NULL) {
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Error;
     }
+    RecvBuffer->Chunks[0] = Chunk;
 
     QuicRangeInitialize(QUIC_MAX_RANGE_ALLOC_SIZE, &RecvBuffer->WrittenRanges);
 
+    RecvBuffer->ChunkCount = 1;
     RecvBuffer->AllocBufferLength = AllocBufferLength;
     RecvBuffer->VirtualBufferLength = VirtualBufferLength;
     RecvBuffer->BufferStart = 0;
     RecvBuffer->BaseOffset = 0;
-    RecvBuffer->CopyOnDrain = CopyOnDrain;
     RecvBuffer->ExternalBufferReference = FALSE;
-    RecvBuffer->OldBuffer = NULL;
+    RecvBuffer->RetiredChunk = NULL;
     Status = QUIC_STATUS_SUCCESS;
 
 Error:
@@ -103,15 +176,20 @@ QuicRecvBufferUninitialize(
     )
 {
     QuicRangeUninitialize(&RecvBuffer->WrittenRanges);
-    if (RecvBuffer->Buffer != RecvBuffer->PreallocatedBuffer) {
-        CXPLAT_FREE(RecvBuffer->Buffer, QUIC_POOL_RECVBUF);
+    for (uint32_t i = 0; i < RecvBuffer->ChunkCount; ++i) {
+        QuicRecvBufferFreeChunk(RecvBuffer, QuicRecvBufferGetChunkAt(RecvBuffer, i));
+    }
+    if (RecvBuffer->Chunks != RecvBuffer->PreallocChunks) {
+        CXPLAT_FREE(RecvBuffer->Chunks, QUIC_POOL_RECVBUF);
+        RecvBuffer->Chunks = RecvBuffer->PreallocChunks;
+        RecvBuffer->ChunkArrayLength = ARRAYSIZE(RecvBuffer->PreallocChunks);
     }
-    RecvBuffer->Buffer = NULL;
-    if (RecvBuffer->OldBuffer != NULL &&
-        RecvBuffer->OldBuffer != RecvBuffer->PreallocatedBuffer) {
-        CXPLAT_FREE(RecvBuffer->OldBuffer, QUIC_POOL_RECVBUF);
+    RecvBuffer->ChunkCount = 0;
+    RecvBuffer->AllocBufferLength = 0;
+    if (RecvBuffer->RetiredChunk != NULL) {
+        QuicRecvBufferFreeChunk(RecvBuffer, RecvBuffer->RetiredChunk);
+        RecvBuffer->RetiredChunk = NULL;
     }
-    RecvBuffer->OldBuffer = NULL;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -144,8 +222,8 @@ QuicRecvBufferGetSpan(
 }
 
 //
-// Allocates a new contiguous buffer of the target size and copies the bytes
-// into it.
+// Allocates a new contiguous chunk of the target size and copies the bytes
+// into it. Only used in contiguous mode.
 //
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
@@ -156,6 +234,9 @@ QuicRecvBufferResize(
 {
     QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
 
+    CXPLAT_DBG_ASSERT(RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CONTIGUOUS);
+    CXPLAT_DBG_ASSERT(RecvBuffer->ChunkCount == 1);
+
     //
     // First check whether there is any work to do (since shrinks
     // can be deferred, a shrink request might be followed immediately
@@ -163,39 +244,28 @@ QuicRecvBufferResize(
     //
     if (TargetBufferLength != RecvBuffer->AllocBufferLength) {
 
-        uint32_t Span = QuicRecvBufferGetSpan(RecvBuffer);
-
-        uint8_t* NewBuffer = CXPLAT_ALLOC_NONPAGED(TargetBufferLength, QUIC_POOL_RECVBUF);
-        if (NewBuffer == NULL) {
+        QUIC_RECV_CHUNK* NewChunk =
+            QuicRecvBufferAllocChunk(RecvBuffer, TargetBufferLength);
+        if (NewChunk == NULL) {
             Status = QUIC_STATUS_OUT_OF_MEMORY;
             goto Error;
         }
 
-        uint32_t LengthTillWrap = RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart;
+        QUIC_RECV_CHUNK* OldChunk = RecvBuffer->Chunks[RecvBuffer->FirstChunk];
 
-        if (Span <= LengthTillWrap) {
-            CxPlatCopyMemory(
-                NewBuffer,
-                RecvBuffer->Buffer + RecvBuffer->BufferStart,
-                Span);
-        } else {
-            CxPlatCopyMemory(
-                NewBuffer,
-                RecvBuffer->Buffer + RecvBuffer->BufferStart,
-                LengthTillWrap);
-            CxPlatCopyMemory(
-                NewBuffer + LengthTillWrap,
-                RecvBuffer->Buffer,
-                Span - LengthTillWrap);
-        }
+        CxPlatCopyMemory(
+            NewChunk->Buffer,
+            OldChunk->Buffer + RecvBuffer->BufferStart,
+            QuicRecvBufferGetSpan(RecvBuffer));
 
-        if (RecvBuffer->ExternalBufferReference && RecvBuffer->OldBuffer == NULL) {
-            RecvBuffer->OldBuffer = RecvBuffer->Buffer;
-        } else if (RecvBuffer->Buffer != RecvBuffer->PreallocatedBuffer) {
-            CXPLAT_FREE(RecvBuffer->Buffer, QUIC_POOL_RECVBUF);
+        if (RecvBuffer->ExternalBufferReference && RecvBuffer->RetiredChunk == NULL) {
+            RecvBuffer->RetiredChunk = OldChunk;
+        } else {
+            QuicRecvBufferFreeChunk(RecvBuffer, OldChunk);
         }
 
-        RecvBuffer->Buffer = NewBuffer;
+        RecvBuffer->Chunks[RecvBuffer->FirstChunk] = NewChunk;
+        RecvBuffer->ChunkLength = TargetBufferLength;
         RecvBuffer->AllocBufferLength = TargetBufferLength;
         RecvBuffer->BufferStart = 0;
     }
@@ -205,6 +275,101 @@ Error:
     return Status;
 }
 
+//
+// Doubles the size of the chunk ring, unwrapping it so the first chunk is at
+// index zero again.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferGrowChunkArray(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    uint32_t NewArrayLength = RecvBuffer->ChunkArrayLength << 1;
+    QUIC_RECV_CHUNK** NewChunks =
+        CXPLAT_ALLOC_NONPAGED(
+            NewArrayLength * sizeof(QUIC_RECV_CHUNK*),
+            QUIC_POOL_RECVBUF);
+    if (NewChunks == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "recv_buffer chunk array",
+            NewArrayLength * sizeof(QUIC_RECV_CHUNK*));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    for (uint32_t i = 0; i < RecvBuffer->ChunkCount; ++i) {
+        NewChunks[i] = QuicRecvBufferGetChunkAt(RecvBuffer, i);
+    }
+    if (RecvBuffer->Chunks != RecvBuffer->PreallocChunks) {
+        CXPLAT_FREE(RecvBuffer->Chunks, QUIC_POOL_RECVBUF);
+    }
+
+    RecvBuffer->Chunks = NewChunks;
+    RecvBuffer->ChunkArrayLength = NewArrayLength;
+    RecvBuffer->FirstChunk = 0;
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Appends fixed-size chunks until the buffer can hold bytes up to the given
+// stream offset. Only used in chunked mode.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+QuicRecvBufferAppendChunks(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t AbsoluteLength
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CHUNKED);
+
+    while (AbsoluteLength >
+           RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart) {
+        if (RecvBuffer->ChunkCount == RecvBuffer->ChunkArrayLength) {
+            QUIC_STATUS Status = QuicRecvBufferGrowChunkArray(RecvBuffer);
+            if (QUIC_FAILED(Status)) {
+                return Status;
+            }
+        }
+        QUIC_RECV_CHUNK* Chunk =
+            QuicRecvBufferAllocChunk(RecvBuffer, RecvBuffer->ChunkLength);
+        if (Chunk == NULL) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+        RecvBuffer->Chunks[
+            (RecvBuffer->FirstChunk + RecvBuffer->ChunkCount) &
+            (RecvBuffer->ChunkArrayLength - 1)] = Chunk;
+        RecvBuffer->ChunkCount++;
+        RecvBuffer->AllocBufferLength += RecvBuffer->ChunkLength;
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Moves the unread bytes back to the front of the chunk, reclaiming the space
+// drained ahead of them. Only used in contiguous mode.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferCompact(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer
+    )
+{
+    CXPLAT_DBG_ASSERT(RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CONTIGUOUS);
+    CXPLAT_DBG_ASSERT(!RecvBuffer->ExternalBufferReference);
+
+    QUIC_RECV_CHUNK* Chunk = RecvBuffer->Chunks[RecvBuffer->FirstChunk];
+    CxPlatMoveMemory(
+        Chunk->Buffer,
+        Chunk->Buffer + RecvBuffer->BufferStart,
+        QuicRecvBufferGetSpan(RecvBuffer));
+    RecvBuffer->BufferStart = 0;
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 void
 QuicRecvBufferSetVirtualBufferLength(
@@ -225,13 +390,60 @@ QuicRecvBufferHasUnreadData(
     return QuicRecvBufferGetTotalLength(RecvBuffer) > RecvBuffer->BaseOffset;
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferCopyIn(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t BufferOffset,
+    _In_ uint16_t BufferLength,
+    _In_reads_bytes_(BufferLength) uint8_t const* Buffer
+    )
+{
+    CXPLAT_DBG_ASSERT(BufferOffset >= RecvBuffer->BaseOffset);
+    CXPLAT_DBG_ASSERT(
+        BufferOffset + BufferLength <=
+        RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart);
+
+    //
+    // Find where in the chunks we will start writing to.
+    //
+    uint32_t Position =
+        RecvBuffer->BufferStart + (uint32_t)(BufferOffset - RecvBuffer->BaseOffset);
+    uint32_t ChunkIndex = Position / RecvBuffer->ChunkLength;
+    uint32_t ChunkOffset = Position % RecvBuffer->ChunkLength;
+
+    //
+    // Copy the data, splitting it across chunk boundaries as necessary.
+    //
+    while (TRUE) {
+        uint16_t CopyLength = BufferLength;
+        if (CopyLength > RecvBuffer->ChunkLength - ChunkOffset) {
+            CopyLength = (uint16_t)(RecvBuffer->ChunkLength - ChunkOffset);
+        }
+
+        CxPlatCopyMemory(
+            QuicRecvBufferGetChunkAt(RecvBuffer, ChunkIndex)->Buffer + ChunkOffset,
+            Buffer,
+            CopyLength);
+
+        BufferLength -= CopyLength;
+        if (BufferLength == 0) {
+            break;
+        }
+
+        Buffer += CopyLength;
+        ChunkIndex++;
+        ChunkOffset = 0;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicRecvBufferWrite(
     _In_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint64_t BufferOffset,
     _In_ uint16_t BufferLength,
-    _In_reads_bytes_(BufferLength) uint8_t const* Buffer,
+    _In_reads_bytes_opt_(BufferLength) uint8_t const* Buffer,
     _Inout_ uint64_t* WriteLength,
     _Out_ BOOLEAN* ReadyToRead
     )
@@ -247,9 +459,6 @@ QuicRecvBufferWrite(
     //
     *ReadyToRead = FALSE;
 
-    uint32_t RelativeOffset;
-    uint32_t WriteBufferStart;
-
     uint64_t AbsoluteLength = BufferOffset + BufferLength;
 
     //
@@ -290,18 +499,32 @@ QuicRecvBufferWrite(
     // Check to see if the input buffer is trying to write beyond the
     // currently allocated length.
     //
-    if (AbsoluteLength > RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength) {
+    if (AbsoluteLength >
+        RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart) {
 
         //
         // Make room for the new data.
         //
 
-        uint32_t NewBufferLength = RecvBuffer->AllocBufferLength << 1;
-        while (AbsoluteLength > RecvBuffer->BaseOffset + NewBufferLength) {
-            NewBufferLength <<= 1;
-        }
+        if (RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CHUNKED) {
+            Status = QuicRecvBufferAppendChunks(RecvBuffer, AbsoluteLength);
+
+        } else if (!RecvBuffer->ExternalBufferReference &&
+                   AbsoluteLength <= RecvBuffer->BaseOffset + RecvBuffer->AllocBufferLength) {
+            //
+            // There's enough room once the drained bytes are reclaimed.
+            //
+            QuicRecvBufferCompact(RecvBuffer);
+            Status = QUIC_STATUS_SUCCESS;
 
-        Status = QuicRecvBufferResize(RecvBuffer, NewBufferLength);
+        } else {
+            uint32_t NewBufferLength = RecvBuffer->AllocBufferLength << 1;
+            while (AbsoluteLength > RecvBuffer->BaseOffset + NewBufferLength) {
+                NewBufferLength <<= 1;
+            }
+
+            Status = QuicRecvBufferResize(RecvBuffer, NewBufferLength);
+        }
 
         if (QUIC_FAILED(Status)) {
             goto Error;
@@ -333,60 +556,19 @@ QuicRecvBufferWrite(
         goto Error;
     }
 
-    //
-    // Calculate the relative offset from the stream buffer's current base offset.
-    //
-    if (BufferOffset < RecvBuffer->BaseOffset) {
-        uint16_t Diff = (uint16_t)(RecvBuffer->BaseOffset - BufferOffset);
-        BufferLength -= Diff;
-        Buffer += Diff;
-        RelativeOffset = 0;
-    } else {
-        RelativeOffset = (uint32_t)(BufferOffset - RecvBuffer->BaseOffset);
-    }
-
-    //
-    // Calculate the actual starting point in the buffer that we will write to,
-    // accounting for wrap around.
-    //
-    WriteBufferStart = (RecvBuffer->BufferStart + RelativeOffset) % RecvBuffer->AllocBufferLength;
-
-    //
-    // Copy the data; but make sure to account for wrap around on the circular buffer.
-    //
-    if (WriteBufferStart + BufferLength > RecvBuffer->AllocBufferLength) {
-
+    if (Buffer != NULL) {
         //
-        // The copy must be split into two parts.
+        // Skip any bytes before the stream buffer's current base offset, which
+        // have already been written.
         //
-        uint16_t Part1Len = (uint16_t)(RecvBuffer->AllocBufferLength - WriteBufferStart);
-        uint16_t Part2Len = BufferLength - Part1Len;
-
-        //
-        // Copy the first part, which is at the end of the circular buffer.
-        //
-        CxPlatCopyMemory(
-            RecvBuffer->Buffer + WriteBufferStart,
-            Buffer,
-            Part1Len);
-
-        //
-        // Copy the second part, which is at the beginning of the circular buffer.
-        //
-        CxPlatCopyMemory(
-            RecvBuffer->Buffer,
-            Buffer + Part1Len,
-            Part2Len);
-
-    } else {
+        if (BufferOffset < RecvBuffer->BaseOffset) {
+            uint16_t Diff = (uint16_t)(RecvBuffer->BaseOffset - BufferOffset);
+            BufferLength -= Diff;
+            Buffer += Diff;
+            BufferOffset = RecvBuffer->BaseOffset;
+        }
 
-        //
-        // Single copy case, because it doesn't overlap the end.
-        //
-        CxPlatCopyMemory(
-            RecvBuffer->Buffer + WriteBufferStart,
-            Buffer,
-            BufferLength);
+        QuicRecvBufferCopyIn(RecvBuffer, BufferOffset, BufferLength, Buffer);
     }
 
     //
@@ -438,22 +620,34 @@ QuicRecvBufferRead(
     RecvBuffer->ExternalBufferReference = TRUE;
     *BufferOffset = RecvBuffer->BaseOffset;
 
-    if (RecvBuffer->BufferStart + WrittenRangeLength > RecvBuffer->AllocBufferLength) {
-        //
-        // Circular buffer wrap around case.
-        //
-        CXPLAT_DBG_ASSERT(*BufferCount >= 2);
-        *BufferCount = 2;
-        Buffers[0].Length = (uint32_t)(RecvBuffer->AllocBufferLength - RecvBuffer->BufferStart);
-        Buffers[0].Buffer = RecvBuffer->Buffer + RecvBuffer->BufferStart;
-        Buffers[1].Length = (uint32_t)WrittenRangeLength - Buffers[0].Length;
-        Buffers[1].Buffer = RecvBuffer->Buffer;
+    CXPLAT_DBG_ASSERT(*BufferCount >= 1);
 
-    } else {
-        CXPLAT_DBG_ASSERT(*BufferCount >= 1);
+    if (RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CONTIGUOUS) {
         *BufferCount = 1;
         Buffers[0].Length = (uint32_t)WrittenRangeLength;
-        Buffers[0].Buffer = RecvBuffer->Buffer + RecvBuffer->BufferStart;
+        Buffers[0].Buffer =
+            RecvBuffer->Chunks[RecvBuffer->FirstChunk]->Buffer + RecvBuffer->BufferStart;
+
+    } else {
+        //
+        // Return one buffer per chunk, up to the number of buffers the caller
+        // has room for.
+        //
+        uint32_t Count = 0;
+        uint32_t ChunkOffset = RecvBuffer->BufferStart;
+        while (WrittenRangeLength != 0 && Count < *BufferCount) {
+            uint32_t Length = RecvBuffer->ChunkLength - ChunkOffset;
+            if (Length > WrittenRangeLength) {
+                Length = (uint32_t)WrittenRangeLength;
+            }
+            Buffers[Count].Length = Length;
+            Buffers[Count].Buffer =
+                QuicRecvBufferGetChunkAt(RecvBuffer, Count)->Buffer + ChunkOffset;
+            Count++;
+            WrittenRangeLength -= Length;
+            ChunkOffset = 0;
+        }
+        *BufferCount = Count;
     }
 
     return TRUE;
@@ -469,11 +663,9 @@ QuicRecvBufferDrain(
     CXPLAT_DBG_ASSERT(RecvBuffer->ExternalBufferReference);
     RecvBuffer->ExternalBufferReference = FALSE;
 
-    if (RecvBuffer->OldBuffer != NULL) {
-        if (RecvBuffer->OldBuffer != RecvBuffer->PreallocatedBuffer) {
-            CXPLAT_FREE(RecvBuffer->OldBuffer, QUIC_POOL_RECVBUF);
-        }
-        RecvBuffer->OldBuffer = NULL;
+    if (RecvBuffer->RetiredChunk != NULL) {
+        QuicRecvBufferFreeChunk(RecvBuffer, RecvBuffer->RetiredChunk);
+        RecvBuffer->RetiredChunk = NULL;
     }
 
     if (BufferLength == 0) {
@@ -483,30 +675,48 @@ QuicRecvBufferDrain(
     RecvBuffer->BaseOffset += BufferLength;
     uint64_t TotalWrittenLength = QuicRangeGetMax(&RecvBuffer->WrittenRanges) + 1;
 
-    if (RecvBuffer->BaseOffset == TotalWrittenLength) {
-        //
-        // All buffer has been drained. Just reset start back to beginning.
-        //
-        RecvBuffer->BufferStart = 0;
-        return TRUE;
-    }
+    if (RecvBuffer->Mode == QUIC_RECV_BUF_MODE_CHUNKED) {
+        RecvBuffer->BufferStart += (uint32_t)BufferLength;
 
-    if (RecvBuffer->CopyOnDrain) {
-        CXPLAT_DBG_ASSERT(RecvBuffer->BufferStart == 0);
         //
-        // Copy remaining bytes in the buffer to the beginning.
+        // Free all the chunks that have been completely drained, keeping at
+        // least one around for the next write. If nothing is left at all, the
+        // first chunk can just start over from the beginning.
         //
-        CxPlatMoveMemory(
-            RecvBuffer->Buffer,
-            RecvBuffer->Buffer + BufferLength,
-            (size_t)(TotalWrittenLength - RecvBuffer->BaseOffset));
+        BOOLEAN Empty = RecvBuffer->BaseOffset == TotalWrittenLength;
+        while (RecvBuffer->ChunkCount > 1 &&
+               (Empty || RecvBuffer->BufferStart >= RecvBuffer->ChunkLength)) {
+            QuicRecvBufferFreeChunk(
+                RecvBuffer, RecvBuffer->Chunks[RecvBuffer->FirstChunk]);
+            RecvBuffer->FirstChunk =
+                (RecvBuffer->FirstChunk + 1) & (RecvBuffer->ChunkArrayLength - 1);
+            RecvBuffer->ChunkCount--;
+            RecvBuffer->AllocBufferLength -= RecvBuffer->ChunkLength;
+            if (RecvBuffer->BufferStart >= RecvBuffer->ChunkLength) {
+                RecvBuffer->BufferStart -= RecvBuffer->ChunkLength;
+            }
+        }
+
+        if (Empty) {
+            RecvBuffer->BufferStart = 0;
+            return TRUE;
+        }
+
     } else {
+        if (RecvBuffer->BaseOffset == TotalWrittenLength) {
+            //
+            // All buffer has been drained, so the next write can start over
+            // from the beginning.
+            //
+            RecvBuffer->BufferStart = 0;
+            return TRUE;
+        }
+
         //
-        // Increment the buffer start, making sure to account for circular
-        // buffer wrap around.
+        // Leave the remaining bytes where they are. The drained space is only
+        // reclaimed once a write doesn't fit in what's left after them.
         //
-        RecvBuffer->BufferStart =
-            (uint32_t)(RecvBuffer->BufferStart + BufferLength) % RecvBuffer->AllocBufferLength;
+        RecvBuffer->BufferStart += (uint32_t)BufferLength;
     }
 
     //
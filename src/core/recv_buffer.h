@@ -5,13 +5,52 @@
 
 --*/
 
+typedef enum QUIC_RECV_BUF_MODE {
+
+    //
+    // A single buffer holding all the unread bytes back to back. It grows by
+    // reallocating and copying, and drains by just moving the start forward;
+    // the drained space is only reclaimed when a write needs it. Used where
+    // the reader needs all the data in one contiguous buffer (i.e. crypto).
+    //
+    QUIC_RECV_BUF_MODE_CONTIGUOUS,
+
+    //
+    // A ring of fixed-size chunks. It grows by appending chunks and drains by
+    // freeing the chunks at the front, so bytes are never copied once they
+    // have been written. Data may be read out as multiple buffers.
+    //
+    QUIC_RECV_BUF_MODE_CHUNKED
+
+} QUIC_RECV_BUF_MODE;
+
+//
+// Number of chunk pointers held inline in the receive buffer. Only buffers
+// that grow past this need to allocate a separate chunk array.
+//
+#define QUIC_RECV_BUFFER_PREALLOC_CHUNKS 2
+
+typedef struct QUIC_RECV_CHUNK {
+
+    //
+    // Length of the chunk's bytes, i.e. the receive buffer's ChunkLength at
+    // the time it was allocated.
+    //
+    uint32_t AllocLength;
+
+    //
+    // The chunk's bytes.
+    //
+    uint8_t Buffer[0];
+
+} QUIC_RECV_CHUNK;
+
 typedef struct QUIC_RECV_BUFFER {
 
     //
-    // Flag to indicate that after a drain, copy any remaining bytes to the
-    // front of the buffer or reset the pointers to 0.
+    // How the backing memory is laid out and grown.
     //
-    BOOLEAN CopyOnDrain : 1;
+    QUIC_RECV_BUF_MODE Mode;
 
     //
     // Flag to indicate that some external code is currently referencing the
@@ -21,23 +60,47 @@ typedef struct QUIC_RECV_BUFFER {
     BOOLEAN ExternalBufferReference : 1;
 
     //
-    // Previous buffer that needs to be freed as soon as the external reference
-    // is released.
+    // Previous (contiguous mode) chunk that needs to be freed as soon as the
+    // external reference is released.
     //
-    uint8_t * OldBuffer;
+    QUIC_RECV_CHUNK* RetiredChunk;
 
     //
-    // Circular buffer used for storing the writes.
+    // Ring of the chunks used for storing the writes, in stream offset order,
+    // starting at FirstChunk. Points to PreallocChunks until more chunks are
+    // needed than fit there.
     //
-    uint8_t * Buffer;
+    QUIC_RECV_CHUNK** Chunks;
 
     //
-    // Optional, preallocated initial buffer.
+    // Number of entries in Chunks. Always a power of 2.
     //
-    uint8_t * PreallocatedBuffer;
+    uint32_t ChunkArrayLength;
 
     //
-    // Length of memory allocated for 'Buffer'. Dynamically grows up to
+    // Index in Chunks of the chunk holding BufferStart.
+    //
+    uint32_t FirstChunk;
+
+    //
+    // Optional pool that chunks are allocated from. If set, every chunk must
+    // be ChunkLength bytes, matching the pool's entry size.
+    //
+    CXPLAT_POOL* ChunkPool;
+
+    //
+    // Length of each chunk. In contiguous mode there is only ever one chunk,
+    // and this doubles each time it is reallocated.
+    //
+    uint32_t ChunkLength;
+
+    //
+    // Number of chunks in the ring.
+    //
+    uint32_t ChunkCount;
+
+    //
+    // Length of memory allocated for all the chunks. Dynamically grows up to
     // VirtualBufferLength.
     //
     uint32_t AllocBufferLength;
@@ -53,10 +116,15 @@ typedef struct QUIC_RECV_BUFFER {
     uint64_t BaseOffset;
 
     //
-    // Start of the head in the circular 'Buffer'.
+    // Offset of the head in the first chunk.
     //
     uint32_t BufferStart;
 
+    //
+    // Inline storage for the chunk ring.
+    //
+    QUIC_RECV_CHUNK* PreallocChunks[QUIC_RECV_BUFFER_PREALLOC_CHUNKS];
+
     //
     // The ranges that currently have bytes written to them.
     //
@@ -70,8 +138,8 @@ QuicRecvBufferInitialize(
     _Inout_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint32_t AllocBufferLength,
     _In_ uint32_t VirtualBufferLength,
-    _In_ BOOLEAN CopyOnDrain,
-    _In_opt_ uint8_t* PreallocatedBuffer
+    _In_ QUIC_RECV_BUF_MODE Mode,
+    _In_opt_ CXPLAT_POOL* ChunkPool
     );
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -114,20 +182,38 @@ QuicRecvBufferHasUnreadData(
 // Returns TRUE if in-order bytes are ready to be delivered
 // to the client.
 //
+// If Buffer is NULL, the range is only marked as written and no bytes are
+// copied. The caller is then responsible for either draining the range or
+// filling it in with QuicRecvBufferCopyIn before it is read.
+//
 _IRQL_requires_max_(DISPATCH_LEVEL)
 QUIC_STATUS
 QuicRecvBufferWrite(
     _In_ QUIC_RECV_BUFFER* RecvBuffer,
     _In_ uint64_t BufferOffset,
     _In_ uint16_t BufferLength,
-    _In_reads_bytes_(BufferLength) uint8_t const* Buffer,
+    _In_reads_bytes_opt_(BufferLength) uint8_t const* Buffer,
     _Inout_ uint64_t* WriteLength,
     _Out_ BOOLEAN* ReadyToRead
     );
 
 //
-// Returns a pointer into the buffer for data ready to be delivered
-// to the client.
+// Copies bytes into a range previously marked as written (by passing a NULL
+// buffer to QuicRecvBufferWrite) that has not been drained yet.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicRecvBufferCopyIn(
+    _In_ QUIC_RECV_BUFFER* RecvBuffer,
+    _In_ uint64_t BufferOffset,
+    _In_ uint16_t BufferLength,
+    _In_reads_bytes_(BufferLength) uint8_t const* Buffer
+    );
+
+//
+// Returns pointers into the buffer for data ready to be delivered
+// to the client. In chunked mode, this may be less than all the
+// contiguous data available if it spans more than BufferCount chunks.
 //
 // Since this returns an internal pointer, the caller must retain
 // exclusive access to the buffer until it calls QuicRecvBufferDrain.
@@ -450,5 +450,26 @@ QuicRegistrationParamGet(
         return QUIC_STATUS_SUCCESS;
     }
 
+    if (Param == QUIC_PARAM_REGISTRATION_WORKER_STATISTICS) {
+
+        const uint32_t StatsLength =
+            Registration->WorkerPool->WorkerCount * sizeof(QUIC_WORKER_STATISTICS);
+        if (*BufferLength < StatsLength) {
+            *BufferLength = StatsLength;
+            return QUIC_STATUS_BUFFER_TOO_SMALL;
+        }
+
+        if (Buffer == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+
+        *BufferLength = StatsLength;
+        QuicWorkerPoolGetStatistics(
+            Registration->WorkerPool,
+            (QUIC_WORKER_STATISTICS*)Buffer);
+
+        return QUIC_STATUS_SUCCESS;
+    }
+
     return QUIC_STATUS_INVALID_PARAMETER;
 }
@@ -0,0 +1,240 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    0-RTT anti-replay filter (server side).
+
+    0-RTT data can be replayed by an attacker that captured it, by sending the
+    same client Initial again. To prevent that, the server only accepts 0-RTT
+    once per resumption ticket: each ticket carries a unique identity (its
+    issue time and a random nonce), which is recorded in this filter the
+    first time 0-RTT is accepted with it.
+
+    Memory use is bounded by recording identities in Bloom filters, and by
+    only remembering them for a window of time. Tickets issued before the
+    window are too old for the filter to say whether they were used, so 0-RTT
+    is rejected for them. False positives only cost a full handshake.
+
+    The window is split into QUIC_REPLAY_FILTER_BUCKET_COUNT - 1 intervals,
+    each of which gets its own bucket (Bloom filter). A ticket is recorded in
+    the current interval's bucket, and looked up in all of them. The oldest
+    bucket is cleared and reused once a new interval starts, which still
+    leaves the whole window covered.
+
+    The filter is also split into shards by identity hash, each with its own
+    lock and buckets, so that connections on different threads rarely
+    contend.
+
+    The filter is per process, so a ticket may still be replayed to another
+    server (or process) that accepts tickets with the same keys.
+
+--*/
+
+#include "precomp.h"
+#ifdef QUIC_CLOG
+#include "replay_filter.c.clog.h"
+#endif
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterInitialize(
+    _Out_ QUIC_REPLAY_FILTER* Filter
+    )
+{
+    CxPlatZeroMemory(Filter, sizeof(*Filter));
+    CxPlatDispatchRwLockInitialize(&Filter->Lock);
+    for (uint32_t i = 0; i < QUIC_REPLAY_FILTER_SHARD_COUNT; ++i) {
+        CxPlatDispatchLockInitialize(&Filter->Shards[i].Lock);
+    }
+    CxPlatRandom(sizeof(Filter->HashSeed), &Filter->HashSeed);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterUninitialize(
+    _In_ QUIC_REPLAY_FILTER* Filter
+    )
+{
+    if (Filter->Bits != NULL) {
+        CXPLAT_FREE(Filter->Bits, QUIC_POOL_REPLAY_FILTER);
+    }
+    for (uint32_t i = 0; i < QUIC_REPLAY_FILTER_SHARD_COUNT; ++i) {
+        CxPlatDispatchLockUninitialize(&Filter->Shards[i].Lock);
+    }
+    CxPlatDispatchRwLockUninitialize(&Filter->Lock);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterConfigure(
+    _Inout_ QUIC_REPLAY_FILTER* Filter,
+    _In_ uint32_t FilterSize,
+    _In_ uint32_t WindowMs
+    )
+{
+    const BOOLEAN Enabled = FilterSize != 0;
+    uint32_t BucketLength =
+        FilterSize / (QUIC_REPLAY_FILTER_SHARD_COUNT * QUIC_REPLAY_FILTER_BUCKET_COUNT);
+    if (Enabled && BucketLength == 0) {
+        BucketLength = 1;
+    }
+    if (WindowMs == 0) {
+        WindowMs = 1;
+    }
+
+    if (Enabled == Filter->Enabled &&
+        BucketLength == Filter->BucketLength &&
+        WindowMs == Filter->WindowMs) {
+        return; // No change.
+    }
+
+    uint8_t* Bits = NULL;
+    if (Enabled) {
+        const size_t BitsLength =
+            (size_t)BucketLength * QUIC_REPLAY_FILTER_SHARD_COUNT * QUIC_REPLAY_FILTER_BUCKET_COUNT;
+        Bits = CXPLAT_ALLOC_NONPAGED(BitsLength, QUIC_POOL_REPLAY_FILTER);
+        if (Bits == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "replay filter",
+                BitsLength);
+        } else {
+            CxPlatZeroMemory(Bits, BitsLength);
+        }
+    }
+
+    CxPlatDispatchRwLockAcquireExclusive(&Filter->Lock);
+    uint8_t* OldBits = Filter->Bits;
+    Filter->Enabled = Enabled;
+    Filter->WindowMs = WindowMs;
+    Filter->IntervalMs =
+        (WindowMs + QUIC_REPLAY_FILTER_BUCKET_COUNT - 2) / (QUIC_REPLAY_FILTER_BUCKET_COUNT - 1);
+    Filter->BucketLength = Bits != NULL ? BucketLength : 0;
+    Filter->Bits = Bits;
+    for (uint32_t i = 0; i < QUIC_REPLAY_FILTER_SHARD_COUNT; ++i) {
+        CxPlatZeroMemory(
+            Filter->Shards[i].BucketInterval,
+            sizeof(Filter->Shards[i].BucketInterval));
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Filter->Lock);
+
+    if (OldBits != NULL) {
+        CXPLAT_FREE(OldBits, QUIC_POOL_REPLAY_FILTER);
+    }
+
+    QuicTraceLogInfo(
+        ReplayFilterConfigured,
+        "[rply] Configured with %u bytes per bucket, %u ms window",
+        Filter->BucketLength,
+        WindowMs);
+}
+
+//
+// 64-bit finalizer from MurmurHash3.
+//
+static
+uint64_t
+QuicReplayFilterMix(
+    _In_ uint64_t Value
+    )
+{
+    Value ^= Value >> 33;
+    Value *= 0xff51afd7ed558ccdull;
+    Value ^= Value >> 33;
+    Value *= 0xc4ceb9fe1a85ec53ull;
+    Value ^= Value >> 33;
+    return Value;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicReplayFilterCheck(
+    _In_ QUIC_REPLAY_FILTER* Filter,
+    _In_reads_(QUIC_TICKET_IDENTITY_LENGTH)
+        const uint8_t* Identity,
+    _In_ uint64_t NowEpochMs,
+    _In_ uint64_t NowMs
+    )
+{
+    uint64_t IssueTimeMs, Nonce;
+    CxPlatCopyMemory(&IssueTimeMs, Identity, sizeof(IssueTimeMs));
+    CxPlatCopyMemory(&Nonce, Identity + sizeof(IssueTimeMs), sizeof(Nonce));
+
+    BOOLEAN Accept = FALSE;
+    CxPlatDispatchRwLockAcquireShared(&Filter->Lock);
+
+    if (!Filter->Enabled) {
+        Accept = TRUE;
+        goto Exit;
+    }
+
+    if (Filter->Bits == NULL) {
+        goto Exit; // Couldn't allocate the filter, so nothing is safe.
+    }
+
+    if (IssueTimeMs + Filter->WindowMs < NowEpochMs ||
+        IssueTimeMs > NowEpochMs + Filter->WindowMs) {
+        goto Exit; // Issued outside the window (or the clocks disagree).
+    }
+
+    const uint64_t Hash1 = QuicReplayFilterMix(Filter->HashSeed ^ Nonce);
+    const uint64_t Hash2 = QuicReplayFilterMix(Hash1 ^ IssueTimeMs) | 1;
+    const uint32_t BucketBits = Filter->BucketLength * 8;
+    const uint64_t Interval = NowMs / Filter->IntervalMs;
+    const uint32_t CurrentBucket = (uint32_t)(Interval % QUIC_REPLAY_FILTER_BUCKET_COUNT);
+
+    const uint32_t ShardIndex =
+        (uint32_t)(Hash1 >> 32) & (QUIC_REPLAY_FILTER_SHARD_COUNT - 1);
+    QUIC_REPLAY_FILTER_SHARD* Shard = &Filter->Shards[ShardIndex];
+    uint8_t* ShardBits =
+        Filter->Bits +
+        (size_t)ShardIndex * QUIC_REPLAY_FILTER_BUCKET_COUNT * Filter->BucketLength;
+
+    CxPlatDispatchLockAcquire(&Shard->Lock);
+
+    //
+    // Start the current interval's bucket over, if it's from an old interval.
+    //
+    if (Shard->BucketInterval[CurrentBucket] != Interval) {
+        Shard->BucketInterval[CurrentBucket] = Interval;
+        CxPlatZeroMemory(
+            ShardBits + (size_t)CurrentBucket * Filter->BucketLength,
+            Filter->BucketLength);
+    }
+
+    Accept = TRUE;
+    for (uint32_t i = 0; i < QUIC_REPLAY_FILTER_BUCKET_COUNT && Accept; ++i) {
+        if (Interval - Shard->BucketInterval[i] >= QUIC_REPLAY_FILTER_BUCKET_COUNT) {
+            continue; // Expired.
+        }
+        const uint8_t* Bucket = ShardBits + (size_t)i * Filter->BucketLength;
+        BOOLEAN Found = TRUE;
+        for (uint32_t j = 0; j < QUIC_REPLAY_FILTER_HASH_COUNT && Found; ++j) {
+            const uint32_t Bit = (uint32_t)((Hash1 + j * Hash2) % BucketBits);
+            Found = (Bucket[Bit / 8] & (1 << (Bit % 8))) != 0;
+        }
+        if (Found) {
+            Accept = FALSE;
+        }
+    }
+
+    if (Accept) {
+        uint8_t* Bucket = ShardBits + (size_t)CurrentBucket * Filter->BucketLength;
+        for (uint32_t j = 0; j < QUIC_REPLAY_FILTER_HASH_COUNT; ++j) {
+            const uint32_t Bit = (uint32_t)((Hash1 + j * Hash2) % BucketBits);
+            Bucket[Bit / 8] |= (uint8_t)(1 << (Bit % 8));
+        }
+    }
+
+    CxPlatDispatchLockRelease(&Shard->Lock);
+
+Exit:
+
+    CxPlatDispatchRwLockReleaseShared(&Filter->Lock);
+
+    return Accept;
+}
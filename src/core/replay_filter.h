@@ -0,0 +1,117 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+//
+// The length of the identity a server resumption ticket is recorded with: the
+// time it was issued followed by a random nonce.
+//
+#define QUIC_TICKET_IDENTITY_LENGTH     16
+
+typedef struct QUIC_REPLAY_FILTER_SHARD {
+
+    //
+    // Protects the shard's buckets.
+    //
+    CXPLAT_DISPATCH_LOCK Lock;
+
+    //
+    // The time interval each bucket currently holds tickets for.
+    //
+    uint64_t BucketInterval[QUIC_REPLAY_FILTER_BUCKET_COUNT];
+
+} QUIC_REPLAY_FILTER_SHARD;
+
+//
+// Remembers the server resumption tickets 0-RTT has been accepted with, so
+// that replays of them can be rejected. Memory use is fixed, at the cost of
+// occasional false positives.
+//
+typedef struct QUIC_REPLAY_FILTER {
+
+    //
+    // Protects the configuration and the Bits allocation. Held shared while
+    // checking tickets.
+    //
+    CXPLAT_DISPATCH_RW_LOCK Lock;
+
+    //
+    // Indicates the filter is enabled. If it is but Bits couldn't be
+    // allocated, all tickets are rejected.
+    //
+    BOOLEAN Enabled;
+
+    //
+    // How long (in ms) tickets are remembered for, and the length of each
+    // bucket's time interval.
+    //
+    uint32_t WindowMs;
+    uint32_t IntervalMs;
+
+    //
+    // The length (in bytes) of each bucket's Bloom filter.
+    //
+    uint32_t BucketLength;
+
+    //
+    // Random seed for hashing ticket identities.
+    //
+    uint64_t HashSeed;
+
+    //
+    // The Bloom filter bits of every bucket of every shard.
+    //
+    uint8_t* Bits;
+
+    QUIC_REPLAY_FILTER_SHARD Shards[QUIC_REPLAY_FILTER_SHARD_COUNT];
+
+} QUIC_REPLAY_FILTER;
+
+//
+// Initializes the replay filter, disabled.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterInitialize(
+    _Out_ QUIC_REPLAY_FILTER* Filter
+    );
+
+//
+// Cleans up the replay filter.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterUninitialize(
+    _In_ QUIC_REPLAY_FILTER* Filter
+    );
+
+//
+// Sets the filter's memory size (in bytes, zero to disable) and window. The
+// filter is cleared if either changes.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicReplayFilterConfigure(
+    _Inout_ QUIC_REPLAY_FILTER* Filter,
+    _In_ uint32_t FilterSize,
+    _In_ uint32_t WindowMs
+    );
+
+//
+// Returns TRUE if 0-RTT may be accepted with the ticket, and records it so
+// that it won't be again. Tickets issued outside the window are rejected.
+// IssueTimeMs and NowEpochMs are wall clock times (ms since the epoch) and
+// NowMs is the current monotonic time (in ms).
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicReplayFilterCheck(
+    _In_ QUIC_REPLAY_FILTER* Filter,
+    _In_reads_(QUIC_TICKET_IDENTITY_LENGTH)
+        const uint8_t* Identity,
+    _In_ uint64_t NowEpochMs,
+    _In_ uint64_t NowMs
+    );
@@ -33,9 +33,298 @@ QuicSendInitialize(
     )
 {
     CxPlatListInitializeHead(&Send->SendStreams);
+    CxPlatListInitializeHead(&Send->BlockedStreams);
     Send->MaxData = Settings->ConnFlowControlWindow;
 }
 
+//
+// Empties one of the stream lists, releasing the send reference on each stream.
+//
+static
+void
+QuicSendReleaseStreamList(
+    _In_ CXPLAT_LIST_ENTRY* StreamList
+    )
+{
+    while (!CxPlatListIsEmpty(StreamList)) {
+
+        QUIC_STREAM* Stream =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(StreamList), QUIC_STREAM, SendLink);
+
+        CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
+        Stream->SendFlags = 0;
+        Stream->SendLink.Flink = NULL;
+        Stream->SendLevelHeight = 0;
+        Stream->Flags.SendFlowBlocked = FALSE;
+
+        QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
+    }
+}
+
+static
+void
+QuicSendReleaseStreams(
+    _In_ QUIC_SEND* Send
+    )
+{
+    QuicSendReleaseStreamList(&Send->SendStreams);
+    QuicSendReleaseStreamList(&Send->BlockedStreams);
+    Send->SendLevelRoot = NULL;
+}
+
+//
+// The tree of priority levels is an AVL tree, made of the streams' level
+// nodes. Its height is at most ~1.44 * log2(65536), so the recursion below is
+// bounded to a couple dozen calls.
+//
+
+#define QUIC_SEND_LEVEL_LOWER   0
+#define QUIC_SEND_LEVEL_HIGHER  1
+
+static
+uint8_t
+QuicSendLevelHeight(
+    _In_opt_ const QUIC_STREAM* Node
+    )
+{
+    return Node == NULL ? 0 : Node->SendLevelHeight;
+}
+
+static
+void
+QuicSendLevelUpdateHeight(
+    _In_ QUIC_STREAM* Node
+    )
+{
+    const uint8_t Lower = QuicSendLevelHeight(Node->SendLevelChildren[QUIC_SEND_LEVEL_LOWER]);
+    const uint8_t Higher = QuicSendLevelHeight(Node->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER]);
+    Node->SendLevelHeight = (uint8_t)(max(Lower, Higher) + 1);
+}
+
+//
+// Lifts the node's child on the other side of Direction into its place, and
+// returns it.
+//
+static
+QUIC_STREAM*
+QuicSendLevelRotate(
+    _In_ QUIC_STREAM* Node,
+    _In_ uint8_t Direction
+    )
+{
+    QUIC_STREAM* Child = Node->SendLevelChildren[!Direction];
+    Node->SendLevelChildren[!Direction] = Child->SendLevelChildren[Direction];
+    Child->SendLevelChildren[Direction] = Node;
+    QuicSendLevelUpdateHeight(Node);
+    QuicSendLevelUpdateHeight(Child);
+    return Child;
+}
+
+//
+// Restores the balance of a subtree after one of its children's heights
+// changed by one, and returns the new root of the subtree.
+//
+static
+QUIC_STREAM*
+QuicSendLevelBalance(
+    _In_ QUIC_STREAM* Node
+    )
+{
+    QuicSendLevelUpdateHeight(Node);
+    const int Difference =
+        (int)QuicSendLevelHeight(Node->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER]) -
+        (int)QuicSendLevelHeight(Node->SendLevelChildren[QUIC_SEND_LEVEL_LOWER]);
+    if (Difference > 1 || Difference < -1) {
+        const uint8_t Heavy = Difference > 0;
+        QUIC_STREAM* Child = Node->SendLevelChildren[Heavy];
+        if (QuicSendLevelHeight(Child->SendLevelChildren[!Heavy]) >
+            QuicSendLevelHeight(Child->SendLevelChildren[Heavy])) {
+            Node->SendLevelChildren[Heavy] = QuicSendLevelRotate(Child, Heavy);
+        }
+        Node = QuicSendLevelRotate(Node, !Heavy);
+    }
+    return Node;
+}
+
+//
+// Adds the stream as the node of a new priority level.
+//
+static
+QUIC_STREAM*
+QuicSendLevelInsert(
+    _In_opt_ QUIC_STREAM* Root,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Root == NULL) {
+        Stream->SendLevelChildren[QUIC_SEND_LEVEL_LOWER] = NULL;
+        Stream->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER] = NULL;
+        Stream->SendLevelHeight = 1;
+        return Stream;
+    }
+    CXPLAT_DBG_ASSERT(Root->SendPriority != Stream->SendPriority);
+    const uint8_t Direction = Stream->SendPriority > Root->SendPriority;
+    Root->SendLevelChildren[Direction] =
+        QuicSendLevelInsert(Root->SendLevelChildren[Direction], Stream);
+    return QuicSendLevelBalance(Root);
+}
+
+//
+// Removes the node of a priority level that has no more streams queued.
+//
+static
+QUIC_STREAM*
+QuicSendLevelRemove(
+    _In_ QUIC_STREAM* Root,
+    _In_ uint16_t Priority
+    )
+{
+    CXPLAT_DBG_ASSERT(Root != NULL);
+    if (Root->SendPriority != Priority) {
+        const uint8_t Direction = Priority > Root->SendPriority;
+        Root->SendLevelChildren[Direction] =
+            QuicSendLevelRemove(Root->SendLevelChildren[Direction], Priority);
+        return QuicSendLevelBalance(Root);
+    }
+
+    QUIC_STREAM* Lower = Root->SendLevelChildren[QUIC_SEND_LEVEL_LOWER];
+    QUIC_STREAM* Higher = Root->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER];
+    Root->SendLevelHeight = 0;
+    if (Lower == NULL) {
+        return Higher;
+    }
+    if (Higher == NULL) {
+        return Lower;
+    }
+
+    //
+    // Replace the node with the lowest priority node of its higher subtree.
+    //
+    QUIC_STREAM* Next = Higher;
+    while (Next->SendLevelChildren[QUIC_SEND_LEVEL_LOWER] != NULL) {
+        Next = Next->SendLevelChildren[QUIC_SEND_LEVEL_LOWER];
+    }
+    Next->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER] =
+        QuicSendLevelRemove(Higher, Next->SendPriority);
+    Next->SendLevelChildren[QUIC_SEND_LEVEL_LOWER] = Lower;
+    return QuicSendLevelBalance(Next);
+}
+
+//
+// Hands a level's node over to another stream of the same priority.
+//
+static
+QUIC_STREAM*
+QuicSendLevelReplace(
+    _In_ QUIC_STREAM* Root,
+    _In_ QUIC_STREAM* Old,
+    _In_ QUIC_STREAM* New
+    )
+{
+    CXPLAT_DBG_ASSERT(Root != NULL);
+    if (Root == Old) {
+        New->SendLevelChildren[QUIC_SEND_LEVEL_LOWER] = Old->SendLevelChildren[QUIC_SEND_LEVEL_LOWER];
+        New->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER] = Old->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER];
+        New->SendLevelHeight = Old->SendLevelHeight;
+        Old->SendLevelHeight = 0;
+        return New;
+    }
+    const uint8_t Direction = Old->SendPriority > Root->SendPriority;
+    Root->SendLevelChildren[Direction] =
+        QuicSendLevelReplace(Root->SendLevelChildren[Direction], Old, New);
+    return Root;
+}
+
+//
+// Returns the node of the priority level, or NULL if no stream of that
+// priority is queued. Also returns the node of the next lower priority level
+// that is queued, if any.
+//
+static
+QUIC_STREAM*
+QuicSendLevelFind(
+    _In_ const QUIC_SEND* Send,
+    _In_ uint16_t Priority,
+    _Out_ QUIC_STREAM** Lower
+    )
+{
+    QUIC_STREAM* Node = Send->SendLevelRoot;
+    *Lower = NULL;
+    while (Node != NULL) {
+        if (Node->SendPriority < Priority) {
+            *Lower = Node;
+            Node = Node->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER];
+        } else if (Node->SendPriority > Priority) {
+            Node = Node->SendLevelChildren[QUIC_SEND_LEVEL_LOWER];
+        } else {
+            QUIC_STREAM* Child = Node->SendLevelChildren[QUIC_SEND_LEVEL_LOWER];
+            if (Child != NULL) {
+                while (Child->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER] != NULL) {
+                    Child = Child->SendLevelChildren[QUIC_SEND_LEVEL_HIGHER];
+                }
+                *Lower = Child;
+            }
+            return Node;
+        }
+    }
+    return NULL;
+}
+
+//
+// Inserts the stream into the send list behind all streams of the same or
+// higher priority. The node of each level is the level's first stream in the
+// send list, so that is just before the next lower level's node.
+//
+static
+void
+QuicSendInsertStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CXPLAT_DBG_ASSERT(Stream->SendLevelHeight == 0);
+
+    QUIC_STREAM* Lower;
+    QUIC_STREAM* Level = QuicSendLevelFind(Send, Stream->SendPriority, &Lower);
+
+    if (Lower == NULL) {
+        CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+    } else {
+        CxPlatListInsertTail(&Lower->SendLink, &Stream->SendLink);
+    }
+
+    if (Level == NULL) {
+        Send->SendLevelRoot = QuicSendLevelInsert(Send->SendLevelRoot, Stream);
+    }
+}
+
+//
+// Removes the stream from the send list, handing its level's node over to the
+// next stream of the same priority if the stream holds it.
+//
+static
+void
+QuicSendRemoveStream(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    if (Stream->SendLevelHeight != 0) {
+        QUIC_STREAM* Next = NULL;
+        if (Stream->SendLink.Flink != &Send->SendStreams) {
+            Next = CXPLAT_CONTAINING_RECORD(Stream->SendLink.Flink, QUIC_STREAM, SendLink);
+        }
+        if (Next != NULL && Next->SendPriority == Stream->SendPriority) {
+            Send->SendLevelRoot = QuicSendLevelReplace(Send->SendLevelRoot, Stream, Next);
+        } else {
+            Send->SendLevelRoot = QuicSendLevelRemove(Send->SendLevelRoot, Stream->SendPriority);
+        }
+    }
+    CxPlatListEntryRemove(&Stream->SendLink);
+    Stream->SendTurnPacketsLeft = 0;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicSendUninitialize(
@@ -52,19 +341,7 @@ QuicSendUninitialize(
     //
     // Release all the stream refs.
     //
-    CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
-    while (Entry != &Send->SendStreams) {
-
-        QUIC_STREAM* Stream =
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
-        CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
-
-        Entry = Entry->Flink;
-        Stream->SendFlags = 0;
-        Stream->SendLink.Flink = NULL;
-
-        QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
-    }
+    QuicSendReleaseStreams(Send);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -147,10 +424,11 @@ QuicSendQueueFlushForStream(
 {
     if (!WasPreviouslyQueued) {
         //
-        // Not previously queued, so add the stream to the end of the queue.
+        // Not previously queued, so add the stream to the end of the queue
+        // for its priority.
         //
         CXPLAT_DBG_ASSERT(Stream->SendLink.Flink == NULL);
-        CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
+        QuicSendInsertStream(Send, Stream);
         QuicStreamAddRef(Stream, QUIC_STREAM_REF_SEND);
     }
 
@@ -250,18 +528,7 @@ QuicSendSetSendFlag(
         //
         // Remove any queued up streams.
         //
-        while (!CxPlatListIsEmpty(&Send->SendStreams)) {
-
-            QUIC_STREAM* Stream =
-                CXPLAT_CONTAINING_RECORD(
-                    CxPlatListRemoveHead(&Send->SendStreams), QUIC_STREAM, SendLink);
-
-            CXPLAT_DBG_ASSERT(Stream->SendFlags != 0);
-            Stream->SendFlags = 0;
-            Stream->SendLink.Flink = NULL;
-
-            QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
-        }
+        QuicSendReleaseStreams(Send);
     }
 
     QuicSendValidate(Send);
@@ -386,6 +653,17 @@ QuicSendSetStreamSendFlag(
         Stream->SendFlags |= SendFlags;
     }
 
+    if (Stream->Flags.SendFlowBlocked &&
+        ((SendFlags & ~QUIC_STREAM_SEND_FLAG_DATA) != 0 ||
+         RECOV_WINDOW_OPEN(Stream))) {
+        //
+        // New control frames or lost data to retransmit aren't subject to
+        // stream flow control, so the stream must be scheduled again. New
+        // data alone is still blocked, so the stream stays parked.
+        //
+        QuicSendStreamFlowUnblocked(Stream);
+    }
+
     return SendFlags != 0;
 }
 
@@ -397,8 +675,6 @@ QuicSendClearStreamSendFlag(
     _In_ uint32_t SendFlags
     )
 {
-    UNREFERENCED_PARAMETER(Send);
-
     if (Stream->SendFlags & SendFlags) {
 
         QuicTraceLogStreamVerbose(
@@ -417,7 +693,12 @@ QuicSendClearStreamSendFlag(
             // Since there are no flags left, remove the stream from the queue.
             //
             CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
-            CxPlatListEntryRemove(&Stream->SendLink);
+            if (Stream->Flags.SendFlowBlocked) {
+                CxPlatListEntryRemove(&Stream->SendLink);
+                Stream->Flags.SendFlowBlocked = FALSE;
+            } else {
+                QuicSendRemoveStream(Send, Stream);
+            }
             Stream->SendLink.Flink = NULL;
             QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
         }
@@ -588,6 +869,14 @@ QuicSendWriteFrames(
                     Builder->Datagram->Buffer)) {
 
                 Send->SendFlags &= ~QUIC_CONN_SEND_FLAG_DATA_BLOCKED;
+                QuicConnQlog(
+                    Connection,
+                    FlowControlFrame,
+                    TRUE,
+                    QUIC_FRAME_DATA_BLOCKED,
+                    Builder->Metadata->PacketNumber,
+                    0,
+                    Frame.DataLimit);
                 if (QuicPacketBuilderAddFrame(Builder, QUIC_FRAME_DATA_BLOCKED, TRUE)) {
                     return TRUE;
                 }
@@ -607,6 +896,14 @@ QuicSendWriteFrames(
                     Builder->Datagram->Buffer)) {
 
                 Send->SendFlags &= ~QUIC_CONN_SEND_FLAG_MAX_DATA;
+                QuicConnQlog(
+                    Connection,
+                    FlowControlFrame,
+                    TRUE,
+                    QUIC_FRAME_MAX_DATA,
+                    Builder->Metadata->PacketNumber,
+                    0,
+                    Frame.MaximumData);
                 if (QuicPacketBuilderAddFrame(Builder, QUIC_FRAME_MAX_DATA, TRUE)) {
                     return TRUE;
                 }
@@ -845,12 +1142,8 @@ QuicSendGetNextStream(
     CXPLAT_LIST_ENTRY* Entry = Send->SendStreams.Flink;
     while (Entry != &Send->SendStreams) {
 
-        //
-        // TODO: performance: We currently search through blocked
-        // streams repeatedly as we loop.
-        //
-
         QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
+        Entry = Entry->Flink;
 
         //
         // Make sure, given the current state of the connection and the stream,
@@ -860,12 +1153,17 @@ QuicSendGetNextStream(
 
             if (Connection->State.UseRoundRobinStreamScheduling) {
                 //
-                // Move the stream to the end of the queue.
+                // Weighted round robin within the stream's priority. A turn
+                // is carried over if the previous flush ended part way through
+                // it, so the weights hold even when sends are congestion
+                // limited. The stream moves to the end of its priority once
+                // it has used up its turn (see QuicSendFlush).
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
-                CxPlatListInsertTail(&Send->SendStreams, &Stream->SendLink);
-
-                *PacketCount = QUIC_STREAM_SEND_BATCH_COUNT;
+                if (Stream->SendTurnPacketsLeft == 0) {
+                    Stream->SendTurnPacketsLeft =
+                        (uint16_t)Stream->SendWeight * QUIC_STREAM_SEND_BATCH_COUNT;
+                }
+                *PacketCount = Stream->SendTurnPacketsLeft;
 
             } else { // FIFO prioritization scheme
                 *PacketCount = UINT32_MAX;
@@ -874,12 +1172,60 @@ QuicSendGetNextStream(
             return Stream;
         }
 
-        Entry = Entry->Flink;
+        if (QuicStreamIsSendFlowBlocked(Stream)) {
+            //
+            // The stream can't send until the peer raises its flow control
+            // limit, so park it instead of searching through it again on
+            // every call.
+            //
+            QuicTraceLogStreamVerbose(
+                SendFlowBlockedParked,
+                Stream,
+                "Parking flow control blocked stream");
+            QuicSendRemoveStream(Send, Stream);
+            CxPlatListInsertTail(&Send->BlockedStreams, &Stream->SendLink);
+            Stream->Flags.SendFlowBlocked = TRUE;
+        }
     }
 
     return NULL;
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamFlowUnblocked(
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    CXPLAT_DBG_ASSERT(Stream->Flags.SendFlowBlocked);
+    CXPLAT_DBG_ASSERT(Stream->SendLink.Flink != NULL);
+
+    QuicTraceLogStreamVerbose(
+        SendFlowBlockedUnparked,
+        Stream,
+        "Unparking flow control blocked stream");
+    Stream->Flags.SendFlowBlocked = FALSE;
+    CxPlatListEntryRemove(&Stream->SendLink);
+    QuicSendInsertStream(&Stream->Connection->Send, Stream);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamPriority(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Priority
+    )
+{
+    if (Stream->SendLink.Flink == NULL || Stream->Flags.SendFlowBlocked) {
+        Stream->SendPriority = Priority;
+        return; // Position is (re)computed when the stream is next queued.
+    }
+    QuicSendRemoveStream(Send, Stream);
+    Stream->SendPriority = Priority;
+    QuicSendInsertStream(Send, Stream);
+}
+
 //
 // This function sends a path challenge frame out on all paths that currently
 // need one sent.
@@ -998,6 +1344,7 @@ QuicSendFlush(
 
     CXPLAT_DBG_ASSERT(QuicSendCanSendFlagsNow(Send));
 
+    const uint64_t FlushStartTime = CxPlatTimeUs64();
     QUIC_SEND_RESULT Result = QUIC_SEND_INCOMPLETE;
     QUIC_STREAM* Stream = NULL;
     uint32_t StreamPacketCount = 0;
@@ -1128,17 +1475,30 @@ QuicSendFlush(
                 // If the stream no longer has anything to send, remove it from the
                 // list and release Send's reference on it.
                 //
-                CxPlatListEntryRemove(&Stream->SendLink);
+                QuicSendRemoveStream(Send, Stream);
                 Stream->SendLink.Flink = NULL;
                 QuicStreamRelease(Stream, QUIC_STREAM_REF_SEND);
                 Stream = NULL;
 
-            } else if ((WrotePacketFrames && --StreamPacketCount == 0) ||
-                !QuicSendCanSendStreamNow(Stream)) {
-                //
-                // Try a new stream next loop iteration.
-                //
-                Stream = NULL;
+            } else {
+                if (WrotePacketFrames &&
+                    Connection->State.UseRoundRobinStreamScheduling &&
+                    --Stream->SendTurnPacketsLeft == 0) {
+                    //
+                    // The stream used up its turn. Move it to the end of the
+                    // queue for its priority.
+                    //
+                    QuicSendRemoveStream(Send, Stream);
+                    QuicSendInsertStream(Send, Stream);
+                }
+
+                if ((WrotePacketFrames && --StreamPacketCount == 0) ||
+                    !QuicSendCanSendStreamNow(Stream)) {
+                    //
+                    // Try a new stream next loop iteration.
+                    //
+                    Stream = NULL;
+                }
             }
 
         } else if (SendFlags == QUIC_CONN_SEND_FLAG_PMTUD) {
@@ -1200,6 +1560,10 @@ QuicSendFlush(
 
     QuicPacketBuilderCleanup(&Builder);
 
+    QuicLatencyHistogramRecord(
+        QUIC_LATENCY_HISTOGRAM_SEND_FLUSH,
+        CxPlatTimeDiff64(FlushStartTime, CxPlatTimeUs64()));
+
     QuicTraceLogConnVerbose(
         SendFlushComplete,
         Connection,
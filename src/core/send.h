@@ -182,6 +182,13 @@ typedef struct QUIC_SEND {
     //
     BOOLEAN TailLossProbeNeeded : 1;
 
+    //
+    // Indicates the peer is blocked on the MaxData we last sent, so the next
+    // increase must be sent right away instead of waiting for the drain
+    // threshold.
+    //
+    BOOLEAN PeerDataBlocked : 1;
+
     //
     // The next packet number to use.
     //
@@ -220,10 +227,26 @@ typedef struct QUIC_SEND {
     uint32_t SendFlags;
 
     //
-    // List of streams with data or control frames to send.
+    // List of streams with data or control frames to send, ordered by
+    // descending stream priority.
     //
     CXPLAT_LIST_ENTRY SendStreams;
 
+    //
+    // Root of an AVL tree, keyed by priority, with one stream of each priority
+    // level in SendStreams. Lets a stream be queued behind its level in time
+    // logarithmic in the number of distinct priorities in use, independent of
+    // the number of queued streams.
+    //
+    QUIC_STREAM* SendLevelRoot;
+
+    //
+    // List of streams with data queued that can't send anything until the
+    // peer raises a stream level flow control limit. Keeping these off
+    // SendStreams means they aren't rescanned each time a stream is picked.
+    //
+    CXPLAT_LIST_ENTRY BlockedStreams;
+
     //
     // The current token to send with an Initial packet.
     //
@@ -310,6 +333,27 @@ QuicSendQueueFlushForStream(
     _In_ BOOLEAN DelaySend
     );
 
+//
+// Moves a stream from the blocked list back onto the send list, after the peer
+// raised the flow control limit it was blocked on.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendStreamFlowUnblocked(
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Updates a stream's priority, repositioning it if it is queued.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicSendUpdateStreamPriority(
+    _In_ QUIC_SEND* Send,
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint16_t Priority
+    );
+
 //
 // Tries to drain all queued data that needs to be sent. Returns TRUE if all the
 // data was drained.
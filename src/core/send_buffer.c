@@ -144,12 +144,26 @@ QuicSendBufferFill(
     //
 
     QUIC_SEND_REQUEST* Req;
+    CXPLAT_LIST_ENTRY* StreamList = &Connection->Send.SendStreams;
     CXPLAT_LIST_ENTRY* Entry;
 
     CXPLAT_DBG_ASSERT(Connection->Settings.SendBufferingEnabled);
 
-    Entry = Connection->Send.SendStreams.Flink;
-    while (QuicSendBufferHasSpace(&Connection->SendBuffer) && Entry != &(Connection->Send.SendStreams)) {
+    Entry = StreamList->Flink;
+    while (QuicSendBufferHasSpace(&Connection->SendBuffer)) {
+
+        if (Entry == StreamList) {
+            //
+            // Flow control blocked streams still get their requests buffered
+            // (and completed), once the sendable streams have had theirs.
+            //
+            if (StreamList != &Connection->Send.SendStreams) {
+                break;
+            }
+            StreamList = &Connection->Send.BlockedStreams;
+            Entry = StreamList->Flink;
+            continue;
+        }
 
         QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, SendLink);
         Entry = Entry->Flink;
@@ -178,6 +192,15 @@ QuicSendBufferFill(
         // Buffer as many requests as we can before moving to the next stream.
         //
         while (Req != NULL && QuicSendBufferHasSpace(&Connection->SendBuffer)) {
+            if (Req->Flags & QUIC_SEND_FLAG_NO_BUFFERING) {
+                //
+                // The app opted out of buffering for this request, so its
+                // buffers are sent from directly and held until ACKed. To
+                // preserve completion order, nothing queued after it on this
+                // stream is buffered until it completes.
+                //
+                break;
+            }
             if (QUIC_FAILED(QuicStreamSendBufferRequest(Stream, Req))) {
                 return;
             }
@@ -252,8 +275,7 @@ QuicSendBufferConnectionAdjust(
     _In_ QUIC_CONNECTION* Connection
     )
 {
-    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE ||
-        Connection->Streams.StreamTable == NULL) {
+    if (Connection->SendBuffer.IdealBytes == QUIC_MAX_IDEAL_SEND_BUFFER_SIZE) {
         return; // Nothing to do.
     }
 
@@ -267,16 +289,15 @@ QuicSendBufferConnectionAdjust(
     if (NewIdealBytes > Connection->SendBuffer.IdealBytes) {
         Connection->SendBuffer.IdealBytes = NewIdealBytes;
 
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(Connection->Streams.StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(Connection->Streams.StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+        QUIC_STREAM_SET_ENUMERATOR Enumerator;
+        QUIC_STREAM* Stream;
+        QuicStreamSetEnumerateBegin(&Connection->Streams, &Enumerator);
+        while ((Stream = QuicStreamSetEnumerateNext(&Connection->Streams, &Enumerator)) != NULL) {
             if (Stream->Flags.SendEnabled) {
                 QuicSendBufferStreamAdjust(Stream);
             }
         }
-        CxPlatHashtableEnumerateEnd(Connection->Streams.StreamTable, &Enumerator);
+        QuicStreamSetEnumerateEnd(&Connection->Streams, &Enumerator);
 
         if (Connection->Settings.SendBufferingEnabled) {
             QuicSendBufferFill(Connection);
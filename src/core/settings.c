@@ -32,6 +32,12 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.DatagramReceiveEnabled) {
         Settings->DatagramReceiveEnabled = QUIC_DEFAULT_DATAGRAM_RECEIVE_ENABLED;
     }
+    if (!Settings->IsSet.StreamRecvInPlaceEnabled) {
+        Settings->StreamRecvInPlaceEnabled = QUIC_DEFAULT_STREAM_RECV_IN_PLACE_ENABLED;
+    }
+    if (!Settings->IsSet.TlsOffloadEnabled) {
+        Settings->TlsOffloadEnabled = QUIC_DEFAULT_TLS_OFFLOAD_ENABLED;
+    }
     if (!Settings->IsSet.MaxOperationsPerDrain) {
         Settings->MaxOperationsPerDrain = QUIC_MAX_OPERATIONS_PER_DRAIN;
     }
@@ -47,6 +53,15 @@ QuicSettingsSetDefault(
     if (!Settings->IsSet.MaxStatelessOperations) {
         Settings->MaxStatelessOperations = QUIC_MAX_STATELESS_OPERATIONS;
     }
+    if (!Settings->IsSet.AdmissionInitialRate) {
+        Settings->AdmissionInitialRate = QUIC_DEFAULT_ADMISSION_INITIAL_RATE;
+    }
+    if (!Settings->IsSet.ZeroRttReplayFilterSize) {
+        Settings->ZeroRttReplayFilterSize = QUIC_DEFAULT_ZERO_RTT_REPLAY_FILTER_SIZE;
+    }
+    if (!Settings->IsSet.ZeroRttReplayWindowMs) {
+        Settings->ZeroRttReplayWindowMs = QUIC_DEFAULT_ZERO_RTT_REPLAY_WINDOW_MS;
+    }
     if (!Settings->IsSet.InitialWindowPackets) {
         Settings->InitialWindowPackets = QUIC_INITIAL_WINDOW_PACKETS;
     }
@@ -122,6 +137,12 @@ QuicSettingsCopy(
     if (!Destination->IsSet.DatagramReceiveEnabled) {
         Destination->DatagramReceiveEnabled = Source->DatagramReceiveEnabled;
     }
+    if (!Destination->IsSet.StreamRecvInPlaceEnabled) {
+        Destination->StreamRecvInPlaceEnabled = Source->StreamRecvInPlaceEnabled;
+    }
+    if (!Destination->IsSet.TlsOffloadEnabled) {
+        Destination->TlsOffloadEnabled = Source->TlsOffloadEnabled;
+    }
     if (!Destination->IsSet.MaxOperationsPerDrain) {
         Destination->MaxOperationsPerDrain = Source->MaxOperationsPerDrain;
     }
@@ -137,6 +158,15 @@ QuicSettingsCopy(
     if (!Destination->IsSet.MaxStatelessOperations) {
         Destination->MaxStatelessOperations = Source->MaxStatelessOperations;
     }
+    if (!Destination->IsSet.AdmissionInitialRate) {
+        Destination->AdmissionInitialRate = Source->AdmissionInitialRate;
+    }
+    if (!Destination->IsSet.ZeroRttReplayFilterSize) {
+        Destination->ZeroRttReplayFilterSize = Source->ZeroRttReplayFilterSize;
+    }
+    if (!Destination->IsSet.ZeroRttReplayWindowMs) {
+        Destination->ZeroRttReplayWindowMs = Source->ZeroRttReplayWindowMs;
+    }
     if (!Destination->IsSet.InitialWindowPackets) {
         Destination->InitialWindowPackets = Source->InitialWindowPackets;
     }
@@ -224,6 +254,14 @@ QuicSettingApply(
         Destination->DatagramReceiveEnabled = Source->DatagramReceiveEnabled;
         Destination->IsSet.DatagramReceiveEnabled = TRUE;
     }
+    if (Source->IsSet.StreamRecvInPlaceEnabled && (!Destination->IsSet.StreamRecvInPlaceEnabled || OverWrite)) {
+        Destination->StreamRecvInPlaceEnabled = Source->StreamRecvInPlaceEnabled;
+        Destination->IsSet.StreamRecvInPlaceEnabled = TRUE;
+    }
+    if (Source->IsSet.TlsOffloadEnabled && (!Destination->IsSet.TlsOffloadEnabled || OverWrite)) {
+        Destination->TlsOffloadEnabled = Source->TlsOffloadEnabled;
+        Destination->IsSet.TlsOffloadEnabled = TRUE;
+    }
     if (Source->IsSet.MaxOperationsPerDrain && (!Destination->IsSet.MaxOperationsPerDrain || OverWrite)) {
         Destination->MaxOperationsPerDrain = Source->MaxOperationsPerDrain;
         Destination->IsSet.MaxOperationsPerDrain = TRUE;
@@ -247,6 +285,18 @@ QuicSettingApply(
         Destination->MaxStatelessOperations = Source->MaxStatelessOperations;
         Destination->IsSet.MaxStatelessOperations = TRUE;
     }
+    if (Source->IsSet.AdmissionInitialRate && (!Destination->IsSet.AdmissionInitialRate || OverWrite)) {
+        Destination->AdmissionInitialRate = Source->AdmissionInitialRate;
+        Destination->IsSet.AdmissionInitialRate = TRUE;
+    }
+    if (Source->IsSet.ZeroRttReplayFilterSize && (!Destination->IsSet.ZeroRttReplayFilterSize || OverWrite)) {
+        Destination->ZeroRttReplayFilterSize = Source->ZeroRttReplayFilterSize;
+        Destination->IsSet.ZeroRttReplayFilterSize = TRUE;
+    }
+    if (Source->IsSet.ZeroRttReplayWindowMs && (!Destination->IsSet.ZeroRttReplayWindowMs || OverWrite)) {
+        Destination->ZeroRttReplayWindowMs = Source->ZeroRttReplayWindowMs;
+        Destination->IsSet.ZeroRttReplayWindowMs = TRUE;
+    }
     if (Source->IsSet.InitialWindowPackets && (!Destination->IsSet.InitialWindowPackets || OverWrite)) {
         Destination->InitialWindowPackets = Source->InitialWindowPackets;
         Destination->IsSet.InitialWindowPackets = TRUE;
@@ -467,6 +517,28 @@ QuicSettingsLoad(
         Settings->DatagramReceiveEnabled = !!Value;
     }
 
+    if (!Settings->IsSet.StreamRecvInPlaceEnabled) {
+        Value = QUIC_DEFAULT_STREAM_RECV_IN_PLACE_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_STREAM_RECV_IN_PLACE_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->StreamRecvInPlaceEnabled = !!Value;
+    }
+
+    if (!Settings->IsSet.TlsOffloadEnabled) {
+        Value = QUIC_DEFAULT_TLS_OFFLOAD_ENABLED;
+        ValueLen = sizeof(Value);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_TLS_OFFLOAD_ENABLED,
+            (uint8_t*)&Value,
+            &ValueLen);
+        Settings->TlsOffloadEnabled = !!Value;
+    }
+
     if (!Settings->IsSet.MaxOperationsPerDrain) {
         Value = QUIC_MAX_OPERATIONS_PER_DRAIN;
         ValueLen = sizeof(Value);
@@ -527,6 +599,33 @@ QuicSettingsLoad(
             &ValueLen);
     }
 
+    if (!Settings->IsSet.AdmissionInitialRate) {
+        ValueLen = sizeof(Settings->AdmissionInitialRate);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ADMISSION_INITIAL_RATE,
+            (uint8_t*)&Settings->AdmissionInitialRate,
+            &ValueLen);
+    }
+
+    if (!Settings->IsSet.ZeroRttReplayFilterSize) {
+        ValueLen = sizeof(Settings->ZeroRttReplayFilterSize);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ZERO_RTT_REPLAY_FILTER_SIZE,
+            (uint8_t*)&Settings->ZeroRttReplayFilterSize,
+            &ValueLen);
+    }
+
+    if (!Settings->IsSet.ZeroRttReplayWindowMs) {
+        ValueLen = sizeof(Settings->ZeroRttReplayWindowMs);
+        CxPlatStorageReadValue(
+            Storage,
+            QUIC_SETTING_ZERO_RTT_REPLAY_WINDOW,
+            (uint8_t*)&Settings->ZeroRttReplayWindowMs,
+            &ValueLen);
+    }
+
     if (!Settings->IsSet.InitialWindowPackets) {
         ValueLen = sizeof(Settings->InitialWindowPackets);
         CxPlatStorageReadValue(
@@ -723,10 +822,15 @@ QuicSettingsDump(
     QuicTraceLogVerbose(SettingDumpPacingEnabled,           "[sett] PacingEnabled          = %hhu", Settings->PacingEnabled);
     QuicTraceLogVerbose(SettingDumpMigrationEnabled,        "[sett] MigrationEnabled       = %hhu", Settings->MigrationEnabled);
     QuicTraceLogVerbose(SettingDumpDatagramReceiveEnabled,  "[sett] DatagramReceiveEnabled = %hhu", Settings->DatagramReceiveEnabled);
+    QuicTraceLogVerbose(SettingDumpStreamRecvInPlaceEnabled,"[sett] StreamRecvInPlace      = %hhu", Settings->StreamRecvInPlaceEnabled);
+    QuicTraceLogVerbose(SettingDumpTlsOffloadEnabled,       "[sett] TlsOffloadEnabled      = %hhu", Settings->TlsOffloadEnabled);
     QuicTraceLogVerbose(SettingDumpMaxOperationsPerDrain,   "[sett] MaxOperationsPerDrain  = %hhu", Settings->MaxOperationsPerDrain);
     QuicTraceLogVerbose(SettingDumpRetryMemoryLimit,        "[sett] RetryMemoryLimit       = %hu", Settings->RetryMemoryLimit);
     QuicTraceLogVerbose(SettingDumpLoadBalancingMode,       "[sett] LoadBalancingMode      = %hu", Settings->LoadBalancingMode);
     QuicTraceLogVerbose(SettingDumpMaxStatelessOperations,  "[sett] MaxStatelessOperations = %u", Settings->MaxStatelessOperations);
+    QuicTraceLogVerbose(SettingDumpAdmissionInitialRate,    "[sett] AdmissionInitialRate   = %u", Settings->AdmissionInitialRate);
+    QuicTraceLogVerbose(SettingDumpZeroRttReplayFilterSize, "[sett] ZeroRttReplayFilterSize = %u", Settings->ZeroRttReplayFilterSize);
+    QuicTraceLogVerbose(SettingDumpZeroRttReplayWindowMs,   "[sett] ZeroRttReplayWindowMs  = %u", Settings->ZeroRttReplayWindowMs);
     QuicTraceLogVerbose(SettingDumpMaxWorkerQueueDelayUs,   "[sett] MaxWorkerQueueDelayUs  = %u", Settings->MaxWorkerQueueDelayUs);
     QuicTraceLogVerbose(SettingDumpInitialWindowPackets,    "[sett] InitialWindowPackets   = %u", Settings->InitialWindowPackets);
     QuicTraceLogVerbose(SettingDumpSendIdleTimeoutMs,       "[sett] SendIdleTimeoutMs      = %u", Settings->SendIdleTimeoutMs);
@@ -770,6 +874,12 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.DatagramReceiveEnabled) {
         QuicTraceLogVerbose(SettingDumpDatagramReceiveEnabled,      "[sett] DatagramReceiveEnabled = %hhu", Settings->DatagramReceiveEnabled);
     }
+    if (Settings->IsSet.StreamRecvInPlaceEnabled) {
+        QuicTraceLogVerbose(SettingDumpStreamRecvInPlaceEnabled,    "[sett] StreamRecvInPlace      = %hhu", Settings->StreamRecvInPlaceEnabled);
+    }
+    if (Settings->IsSet.TlsOffloadEnabled) {
+        QuicTraceLogVerbose(SettingDumpTlsOffloadEnabled,           "[sett] TlsOffloadEnabled      = %hhu", Settings->TlsOffloadEnabled);
+    }
     if (Settings->IsSet.MaxOperationsPerDrain) {
         QuicTraceLogVerbose(SettingDumpMaxOperationsPerDrain,       "[sett] MaxOperationsPerDrain  = %hhu", Settings->MaxOperationsPerDrain);
     }
@@ -782,6 +892,15 @@ QuicSettingsDumpNew(
     if (Settings->IsSet.MaxStatelessOperations) {
         QuicTraceLogVerbose(SettingDumpMaxStatelessOperations,      "[sett] MaxStatelessOperations = %u", Settings->MaxStatelessOperations);
     }
+    if (Settings->IsSet.AdmissionInitialRate) {
+        QuicTraceLogVerbose(SettingDumpAdmissionInitialRate,        "[sett] AdmissionInitialRate   = %u", Settings->AdmissionInitialRate);
+    }
+    if (Settings->IsSet.ZeroRttReplayFilterSize) {
+        QuicTraceLogVerbose(SettingDumpZeroRttReplayFilterSize,     "[sett] ZeroRttReplayFilterSize = %u", Settings->ZeroRttReplayFilterSize);
+    }
+    if (Settings->IsSet.ZeroRttReplayWindowMs) {
+        QuicTraceLogVerbose(SettingDumpZeroRttReplayWindowMs,       "[sett] ZeroRttReplayWindowMs  = %u", Settings->ZeroRttReplayWindowMs);
+    }
     if (Settings->IsSet.MaxWorkerQueueDelayUs) {
         QuicTraceLogVerbose(SettingDumpMaxWorkerQueueDelayUs,       "[sett] MaxWorkerQueueDelayUs  = %u", Settings->MaxWorkerQueueDelayUs);
     }
@@ -28,7 +28,7 @@ QuicStreamInitialize(
 {
     QUIC_STATUS Status;
     QUIC_STREAM* Stream;
-    uint8_t* PreallocatedRecvBuffer = NULL;
+    CXPLAT_POOL* RecvChunkPool = NULL;
     uint32_t InitialRecvBufferLength;
     QUIC_WORKER* Worker = Connection->Worker;
 
@@ -48,6 +48,8 @@ QuicStreamInitialize(
     Stream->Flags.SendEnabled = TRUE;
     Stream->Flags.ReceiveEnabled = TRUE;
     Stream->RecvMaxLength = UINT64_MAX;
+    Stream->SendPriority = QUIC_DEFAULT_STREAM_PRIORITY;
+    Stream->SendWeight = QUIC_DEFAULT_STREAM_WEIGHT;
     Stream->RefCount = 1;
     Stream->SendRequestsTail = &Stream->SendRequests;
     CxPlatDispatchLockInitialize(&Stream->ApiSendRequestLock);
@@ -100,11 +102,7 @@ QuicStreamInitialize(
 
     InitialRecvBufferLength = Connection->Settings.StreamRecvBufferDefault;
     if (InitialRecvBufferLength == QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE) {
-        PreallocatedRecvBuffer = CxPlatPoolAlloc(&Worker->DefaultReceiveBufferPool);
-        if (PreallocatedRecvBuffer == NULL) {
-            Status = QUIC_STATUS_OUT_OF_MEMORY;
-            goto Exit;
-        }
+        RecvChunkPool = &Worker->DefaultReceiveBufferPool;
     }
 
     Status =
@@ -112,8 +110,8 @@ QuicStreamInitialize(
             &Stream->RecvBuffer,
             InitialRecvBufferLength,
             Connection->Settings.StreamRecvWindowDefault,
-            FALSE,
-            PreallocatedRecvBuffer);
+            QUIC_RECV_BUF_MODE_CHUNKED,
+            RecvChunkPool);
     if (QUIC_FAILED(Status)) {
         goto Exit;
     }
@@ -130,7 +128,6 @@ QuicStreamInitialize(
     Stream->Flags.Initialized = TRUE;
     *NewStream = Stream;
     Stream = NULL;
-    PreallocatedRecvBuffer = NULL;
     QuicPerfCounterIncrement(QUIC_PERF_COUNTER_STRM_ACTIVE);
 
 Exit:
@@ -140,9 +137,6 @@ Exit:
         Stream->Flags.Freed = TRUE;
         CxPlatPoolFree(&Worker->StreamPool, Stream);
     }
-    if (PreallocatedRecvBuffer) {
-        CxPlatPoolFree(&Worker->DefaultReceiveBufferPool, PreallocatedRecvBuffer);
-    }
 
     return Status;
 }
@@ -174,17 +168,14 @@ QuicStreamFree(
     CxPlatDispatchLockRelease(&Connection->Streams.AllStreamsLock);
 #endif
 
+    if (Stream->RecvInPlaceData != NULL) {
+        QuicStreamRecvReleaseInPlace(Stream, Stream->RecvInPlaceLength);
+    }
     QuicRecvBufferUninitialize(&Stream->RecvBuffer);
     QuicRangeUninitialize(&Stream->SparseAckRanges);
     CxPlatDispatchLockUninitialize(&Stream->ApiSendRequestLock);
     CxPlatRefUninitialize(&Stream->RefCount);
 
-    if (Stream->RecvBuffer.PreallocatedBuffer) {
-        CxPlatPoolFree(
-            &Worker->DefaultReceiveBufferPool,
-            Stream->RecvBuffer.PreallocatedBuffer);
-    }
-
     Stream->Flags.Freed = TRUE;
     CxPlatPoolFree(&Worker->StreamPool, Stream);
 
@@ -536,11 +527,62 @@ QuicStreamParamSet(
         const void* Buffer
     )
 {
-    UNREFERENCED_PARAMETER(Stream);
-    UNREFERENCED_PARAMETER(Param);
-    UNREFERENCED_PARAMETER(BufferLength);
-    UNREFERENCED_PARAMETER(Buffer);
-    return QUIC_STATUS_INVALID_PARAMETER;
+    QUIC_STATUS Status;
+
+    switch (Param)
+    {
+    case QUIC_PARAM_STREAM_PRIORITY:
+
+        if (BufferLength != sizeof(Stream->SendPriority) || Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        if (Stream->SendPriority != *(uint16_t*)Buffer) {
+            QuicSendUpdateStreamPriority(
+                &Stream->Connection->Send, Stream, *(uint16_t*)Buffer);
+
+            QuicTraceLogStreamInfo(
+                UpdatePriority,
+                Stream,
+                "New send priority = %hu",
+                Stream->SendPriority);
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_STREAM_WEIGHT:
+
+        if (BufferLength != sizeof(Stream->SendWeight) || Buffer == NULL ||
+            *(uint8_t*)Buffer == 0) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        //
+        // The weight is read each time the stream is scheduled, so its place
+        // in the send list doesn't change.
+        //
+        if (Stream->SendWeight != *(uint8_t*)Buffer) {
+            Stream->SendWeight = *(uint8_t*)Buffer;
+
+            QuicTraceLogStreamInfo(
+                UpdateWeight,
+                Stream,
+                "New send weight = %hhu",
+                Stream->SendWeight);
+        }
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    default:
+        Status = QUIC_STATUS_INVALID_PARAMETER;
+        break;
+    }
+
+    return Status;
 }
 
 QUIC_STATUS
@@ -625,6 +667,44 @@ QuicStreamParamGet(
         Status = QUIC_STATUS_SUCCESS;
         break;
 
+    case QUIC_PARAM_STREAM_PRIORITY:
+
+        if (*BufferLength < sizeof(Stream->SendPriority)) {
+            *BufferLength = sizeof(Stream->SendPriority);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(Stream->SendPriority);
+        *(uint16_t*)Buffer = Stream->SendPriority;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
+    case QUIC_PARAM_STREAM_WEIGHT:
+
+        if (*BufferLength < sizeof(Stream->SendWeight)) {
+            *BufferLength = sizeof(Stream->SendWeight);
+            Status = QUIC_STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        if (Buffer == NULL) {
+            Status = QUIC_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        *BufferLength = sizeof(Stream->SendWeight);
+        *(uint8_t*)Buffer = Stream->SendWeight;
+
+        Status = QUIC_STATUS_SUCCESS;
+        break;
+
     default:
         Status = QUIC_STATUS_INVALID_PARAMETER;
         break;
@@ -136,6 +136,8 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN ReceiveDataPending      : 1;    // Data (or FIN) is queued and ready for delivery.
         BOOLEAN ReceiveCallPending      : 1;    // There is an uncompleted receive to the app.
         BOOLEAN SendDelayed             : 1;    // A delayed send is currently queued.
+        BOOLEAN SendFlowBlocked         : 1;    // Parked on the blocked list until the peer
+                                                // raises a stream flow control limit.
 
         BOOLEAN HandleSendShutdown      : 1;    // Send shutdown complete callback delivered.
         BOOLEAN HandleShutdown          : 1;    // Shutdown callback delivered.
@@ -186,7 +188,11 @@ typedef enum QUIC_STREAM_REF {
 //
 typedef struct QUIC_STREAM {
 
+#ifdef __cplusplus
+    struct QUIC_HANDLE _;
+#else
     struct QUIC_HANDLE;
+#endif
 
     //
     // Number of references to the handle.
@@ -199,7 +205,8 @@ typedef struct QUIC_STREAM {
 
     union {
         //
-        // The entry in the connection's hashtable of streams.
+        // The entry in the connection's hashtable of streams, for streams
+        // that don't fit in their type's window.
         //
         CXPLAT_HASHTABLE_ENTRY TableEntry;
 
@@ -210,10 +217,18 @@ typedef struct QUIC_STREAM {
     };
 
     //
-    // The list entry in the output module's send list.
+    // The list entry in the output module's send list (or blocked list, if
+    // Flags.SendFlowBlocked is set).
     //
     CXPLAT_LIST_ENTRY SendLink;
 
+    //
+    // The stream's node in the output module's tree of priority levels (lower
+    // and higher priority subtrees). Only one stream of each priority in the
+    // send list is in the tree; see SendLevelHeight.
+    //
+    struct QUIC_STREAM* SendLevelChildren[2];
+
 #if DEBUG
     //
     // The list entry in the stream set's list of all allocated streams.
@@ -242,11 +257,34 @@ typedef struct QUIC_STREAM {
     //
     uint16_t SendFlags;
 
+    //
+    // The send priority of the stream. Higher values are scheduled first.
+    //
+    uint16_t SendPriority;
+
     //
     // Set of current reasons sending more packets is currently blocked.
     //
     uint8_t OutFlowBlockedReasons; // Set of QUIC_FLOW_BLOCKED_* flags
 
+    //
+    // The send weight of the stream, relative to other streams of the same
+    // priority. Only used with round robin scheduling.
+    //
+    uint8_t SendWeight;
+
+    //
+    // The height of the stream's subtree in the tree of priority levels, or
+    // zero if the stream isn't in the tree.
+    //
+    uint8_t SendLevelHeight;
+
+    //
+    // The number of packets left in the stream's current round robin turn.
+    // Zero if the stream isn't in the middle of a turn.
+    //
+    uint16_t SendTurnPacketsLeft;
+
     //
     // Send State
     //
@@ -376,6 +414,16 @@ typedef struct QUIC_STREAM {
     //
     uint64_t RecvPendingLength;
 
+    //
+    // The payload to indicate to the app directly from the decrypted packet,
+    // rather than copying it into RecvBuffer first. It always starts at
+    // RecvBuffer.BaseOffset. RecvInPlacePacket is held until the receive
+    // completes (or the stream is freed).
+    //
+    CXPLAT_RECV_PACKET* RecvInPlacePacket;
+    const uint8_t* RecvInPlaceData;
+    uint16_t RecvInPlaceLength;
+
     //
     // The handler for the API client's callbacks.
     //
@@ -436,6 +484,15 @@ QuicStreamCanSendNow(
     _In_ BOOLEAN ZeroRtt
     );
 
+//
+// Returns TRUE if the stream can't send anything until the peer raises one of
+// its stream level flow control limits (MAX_STREAMS or MAX_STREAM_DATA).
+//
+BOOLEAN
+QuicStreamIsSendFlowBlocked(
+    _In_ const QUIC_STREAM* Stream
+    );
+
 inline
 uint64_t
 QuicStreamGetInitialMaxDataFromTP(
@@ -675,6 +732,11 @@ QuicStreamRemoveOutFlowBlockedReason(
             "[strm][%p] Send Blocked Flags: %hhu",
             Stream,
             Stream->OutFlowBlockedReasons);
+        if (Stream->Flags.SendFlowBlocked &&
+            (Reason & (QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL |
+                       QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL))) {
+            QuicSendStreamFlowUnblocked(Stream);
+        }
         return TRUE;
     }
     return FALSE;
@@ -799,6 +861,17 @@ QuicStreamReceiveCompletePending(
     _In_ uint64_t BufferLength
     );
 
+//
+// Releases any payload indicated in place to the app, copying the bytes the
+// app didn't consume into the receive buffer.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvReleaseInPlace(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t BufferLength
+    );
+
 //
 // Processes a received frame for the given stream.
 //
@@ -806,7 +879,7 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamRecv(
     _In_ QUIC_STREAM* Stream,
-    _In_ BOOLEAN EncryptedWith0Rtt,
+    _In_ CXPLAT_RECV_PACKET* Packet,
     _In_ QUIC_FRAME_TYPE FrameType,
     _In_ uint16_t BufferLength,
     _In_reads_bytes_(BufferLength)
@@ -261,6 +261,74 @@ QuicStreamProcessStopSendingFrame(
     }
 }
 
+//
+// Indicates a receive event to the app and handles its response. Returns TRUE
+// if the receive was completed inline and there is more data ready to deliver.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+BOOLEAN
+QuicStreamRecvIndicate(
+    _In_ QUIC_STREAM* Stream,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    Stream->Flags.ReceiveEnabled = FALSE;
+    Stream->Flags.ReceiveCallPending = TRUE;
+    Stream->RecvPendingLength = Event->RECEIVE.TotalBufferLength;
+
+    QuicTraceLogStreamVerbose(
+        IndicateReceive,
+        Stream,
+        "Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]",
+        Event->RECEIVE.TotalBufferLength,
+        Event->RECEIVE.BufferCount,
+        Event->RECEIVE.Flags);
+
+    QUIC_STATUS Status = QuicStreamIndicateEvent(Stream, Event);
+    if (Status == QUIC_STATUS_PENDING) {
+        if (Stream->Flags.ReceiveCallPending) {
+            //
+            // If the pending call wasn't completed inline, then receive
+            // callbacks MUST be disabled still.
+            //
+            CXPLAT_TEL_ASSERTMSG_ARGS(
+                !Stream->Flags.ReceiveEnabled,
+                "App pended recv AND enabled additional recv callbacks",
+                Stream->Connection->Registration->AppName,
+                0, 0);
+            Stream->Flags.ReceiveEnabled = FALSE;
+        }
+        return FALSE;
+    }
+
+    if (Status == QUIC_STATUS_CONTINUE) {
+        //
+        // The app has explicitly indicated it wants to continue to
+        // receive callbacks, even if all the data wasn't drained.
+        //
+        Stream->Flags.ReceiveEnabled = TRUE;
+
+    } else {
+        //
+        // All other failure status returns are ignored and shouldn't be
+        // used by the app.
+        //
+        CXPLAT_TEL_ASSERTMSG_ARGS(
+            QUIC_SUCCEEDED(Status),
+            "App failed recv callback",
+            Stream->Connection->Registration->AppName,
+            Status, 0);
+    }
+
+    CXPLAT_TEL_ASSERTMSG_ARGS(
+        Stream->Flags.ReceiveCallPending,
+        "App completed async recv without pending it",
+        Stream->Connection->Registration->AppName,
+        0, 0);
+
+    return QuicStreamReceiveComplete(Stream, Event->RECEIVE.TotalBufferLength);
+}
+
 //
 // Processes a STREAM frame.
 //
@@ -268,12 +336,13 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamProcessStreamFrame(
     _In_ QUIC_STREAM* Stream,
-    _In_ BOOLEAN EncryptedWith0Rtt,
+    _In_ CXPLAT_RECV_PACKET* Packet,
     _In_ const QUIC_STREAM_EX* Frame
     )
 {
     QUIC_STATUS Status;
     BOOLEAN ReadyToDeliver = FALSE;
+    BOOLEAN DeliverInPlace = FALSE;
     uint64_t EndOffset = Frame->Offset + Frame->Length;
 
     if (Stream->Flags.RemoteNotAllowed) {
@@ -345,7 +414,31 @@ QuicStreamProcessStreamFrame(
             Stream->Connection->Send.OrderedStreamBytesReceived;
 
         //
-        // Write any nonduplicate data to the receive buffer.
+        // If the frame is exactly the next data the app is waiting on, and the
+        // app is ready to take it, then the payload can be indicated straight
+        // out of the decrypted packet instead of being copied into the receive
+        // buffer first. The packet is held until then, so only short header
+        // packets are eligible, since they are the only ones that are the last
+        // packet in their datagram. The number of packets a connection holds
+        // is capped, so a slow app can't pin down the datapath's receive
+        // buffers.
+        //
+        DeliverInPlace =
+            Stream->Connection->Settings.StreamRecvInPlaceEnabled &&
+            Packet->IsShortHeader &&
+            Frame->Length != 0 &&
+            Frame->Offset == Stream->RecvBuffer.BaseOffset &&
+            !QuicRecvBufferHasUnreadData(&Stream->RecvBuffer) &&
+            Stream->RecvInPlaceData == NULL &&
+            Stream->Connection->RecvInPlaceCount < QUIC_MAX_RECV_IN_PLACE_COUNT &&
+            Stream->Flags.ReceiveEnabled &&
+            !Stream->Flags.ReceiveCallPending &&
+            !Stream->Flags.ReceiveFlushQueued &&
+            !Stream->Flags.ReceiveDataPending;
+
+        //
+        // Write any nonduplicate data to the receive buffer. (When delivering
+        // in place, the range is only marked as written.)
         // QuicRecvBufferWrite will indicate if there is data to deliver.
         //
         Status =
@@ -353,7 +446,7 @@ QuicStreamProcessStreamFrame(
                 &Stream->RecvBuffer,
                 Frame->Offset,
                 (uint16_t)Frame->Length,
-                Frame->Data,
+                DeliverInPlace ? NULL : Frame->Data,
                 &WriteLength,
                 &ReadyToDeliver);
         if (QUIC_FAILED(Status)) {
@@ -364,7 +457,7 @@ QuicStreamProcessStreamFrame(
         // Keep track of the total ordered bytes received.
         //
         Stream->Connection->Send.OrderedStreamBytesReceived += WriteLength;
-        CXPLAT_DBG_ASSERT(Stream->Connection->Send.OrderedStreamBytesReceived < Stream->Connection->Send.MaxData);
+        CXPLAT_DBG_ASSERT(Stream->Connection->Send.OrderedStreamBytesReceived <= Stream->Connection->Send.MaxData);
         CXPLAT_DBG_ASSERT(Stream->Connection->Send.OrderedStreamBytesReceived >= WriteLength);
 
         if (QuicRecvBufferGetTotalLength(&Stream->RecvBuffer) == Stream->MaxAllowedRecvOffset) {
@@ -374,7 +467,7 @@ QuicStreamProcessStreamFrame(
                 "Flow control window exhausted!");
         }
 
-        if (EncryptedWith0Rtt) {
+        if (Packet->EncryptedWith0Rtt) {
             //
             // Keep track of the maximum length of the 0-RTT payload so that we
             // can indicate that appropriately to the API client.
@@ -397,11 +490,6 @@ QuicStreamProcessStreamFrame(
         }
     }
 
-    if (ReadyToDeliver) {
-        Stream->Flags.ReceiveDataPending = TRUE;
-        QuicStreamRecvQueueFlush(Stream);
-    }
-
     QuicTraceLogStreamVerbose(
         Receive,
         Stream,
@@ -410,6 +498,22 @@ QuicStreamProcessStreamFrame(
         Frame->Offset,
         ReadyToDeliver);
 
+    if (ReadyToDeliver) {
+        Stream->Flags.ReceiveDataPending = TRUE;
+        if (DeliverInPlace) {
+            //
+            // Hold on to the packet so the connection doesn't return it to the
+            // datapath before the queued flush indicates the payload.
+            //
+            Stream->RecvInPlacePacket = Packet;
+            Stream->RecvInPlaceData = Frame->Data;
+            Stream->RecvInPlaceLength = (uint16_t)Frame->Length;
+            Packet->InPlaceRefCount++;
+            Stream->Connection->RecvInPlaceCount++;
+        }
+        QuicStreamRecvQueueFlush(Stream);
+    }
+
 Error:
 
     if (Status == QUIC_STATUS_INVALID_PARAMETER) {
@@ -433,7 +537,7 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 QuicStreamRecv(
     _In_ QUIC_STREAM* Stream,
-    _In_ BOOLEAN EncryptedWith0Rtt,
+    _In_ CXPLAT_RECV_PACKET* Packet,
     _In_ QUIC_FRAME_TYPE FrameType,
     _In_ uint16_t BufferLength,
     _In_reads_bytes_(BufferLength)
@@ -478,6 +582,15 @@ QuicStreamRecv(
             return QUIC_STATUS_INVALID_PARAMETER;
         }
 
+        QuicConnQlog(
+            Stream->Connection,
+            FlowControlFrame,
+            FALSE,
+            QUIC_FRAME_MAX_STREAM_DATA,
+            Packet->PacketNumber,
+            Stream->ID,
+            Frame.MaximumData);
+
         if (Stream->MaxAllowedSendOffset < Frame.MaximumData) {
             Stream->MaxAllowedSendOffset = Frame.MaximumData;
             *UpdatedFlowControl = TRUE;
@@ -524,6 +637,15 @@ QuicStreamRecv(
             return QUIC_STATUS_INVALID_PARAMETER;
         }
 
+        QuicConnQlog(
+            Stream->Connection,
+            FlowControlFrame,
+            FALSE,
+            QUIC_FRAME_STREAM_DATA_BLOCKED,
+            Packet->PacketNumber,
+            Stream->ID,
+            Frame.StreamDataLimit);
+
         QuicTraceLogStreamVerbose(
             RemoteBlocked,
             Stream,
@@ -548,7 +670,7 @@ QuicStreamRecv(
 
         Status =
             QuicStreamProcessStreamFrame(
-                Stream, EncryptedWith0Rtt, &Frame);
+                Stream, Packet, &Frame);
 
         break;
     }
@@ -630,15 +752,18 @@ QuicStreamOnBytesDelivered(
         Stream->RecvWindowLastUpdate = TimeNow;
         Stream->RecvWindowBytesDelivered = 0;
 
-    } else if (!(Stream->Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_ACK)) {
+    } else if (!(Stream->Connection->Send.SendFlags & QUIC_CONN_SEND_FLAG_ACK) &&
+               !Stream->Connection->Send.PeerDataBlocked) {
         //
         // We haven't hit the drain limit AND we don't have any ACKs to send
-        // immediately, so we don't need to immediately update the max data
-        // values.
+        // immediately AND the peer isn't blocked on the connection window, so
+        // we don't need to immediately update the max data values.
         //
         return;
     }
 
+    Stream->Connection->Send.PeerDataBlocked = FALSE;
+
     //
     // Advance MaxAllowedRecvOffset.
     //
@@ -677,6 +802,13 @@ QuicStreamRecvFlush(
             IgnoreRecvFlush,
             Stream,
             "Ignoring recv flush (recv disabled)");
+        if (Stream->RecvInPlaceData != NULL && !Stream->Flags.ReceiveCallPending) {
+            //
+            // Don't hold on to the packet for however long the app keeps
+            // receives disabled.
+            //
+            QuicStreamRecvReleaseInPlace(Stream, 0);
+        }
         return;
     }
 
@@ -686,21 +818,61 @@ QuicStreamRecvFlush(
     BOOLEAN FlushRecv = TRUE;
     while (FlushRecv) {
 
-        QUIC_BUFFER RecvBuffers[2];
+        QUIC_BUFFER StackRecvBuffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+        QUIC_BUFFER* RecvBuffers = StackRecvBuffers;
         QUIC_STREAM_EVENT Event = {0};
         Event.Type = QUIC_STREAM_EVENT_RECEIVE;
-        Event.RECEIVE.BufferCount = 2;
-        Event.RECEIVE.Buffers = RecvBuffers;
+        Event.RECEIVE.BufferCount = ARRAYSIZE(StackRecvBuffers);
 
-        //
-        // Try to read the next available buffers.
-        //
-        BOOLEAN DataAvailable =
-            QuicRecvBufferRead(
-                &Stream->RecvBuffer,
-                &Event.RECEIVE.AbsoluteOffset,
-                &Event.RECEIVE.BufferCount,
-                RecvBuffers);
+        BOOLEAN DataAvailable;
+        if (Stream->RecvInPlaceData != NULL) {
+            //
+            // The next bytes are still in the received packet, so indicate
+            // them from there. The range is owned by the app now, exactly as
+            // if it had been read out of the receive buffer. Anything buffered
+            // after it is indicated once this receive completes.
+            //
+            CXPLAT_DBG_ASSERT(!Stream->RecvBuffer.ExternalBufferReference);
+            Stream->RecvBuffer.ExternalBufferReference = TRUE;
+            Event.RECEIVE.AbsoluteOffset = Stream->RecvBuffer.BaseOffset;
+            Event.RECEIVE.BufferCount = 1;
+            RecvBuffers[0].Buffer = (uint8_t*)Stream->RecvInPlaceData;
+            RecvBuffers[0].Length = Stream->RecvInPlaceLength;
+            DataAvailable = TRUE;
+
+        } else {
+            if (Stream->RecvBuffer.ChunkCount > ARRAYSIZE(StackRecvBuffers)) {
+                //
+                // The readable data may span more chunks than fit on the
+                // stack. Indicate all of it at once, with a buffer per chunk,
+                // or as much as fits on the stack if that can't be allocated.
+                //
+                QUIC_BUFFER* ChunkBuffers =
+                    CXPLAT_ALLOC_NONPAGED(
+                        Stream->RecvBuffer.ChunkCount * sizeof(QUIC_BUFFER),
+                        QUIC_POOL_TMP_ALLOC);
+                if (ChunkBuffers != NULL) {
+                    RecvBuffers = ChunkBuffers;
+                    Event.RECEIVE.BufferCount = Stream->RecvBuffer.ChunkCount;
+                } else {
+                    QuicTraceEvent(
+                        AllocFailure,
+                        "Allocation of '%s' failed. (%llu bytes)",
+                        "Recv indication buffers",
+                        Stream->RecvBuffer.ChunkCount * sizeof(QUIC_BUFFER));
+                }
+            }
+
+            //
+            // Try to read the next available buffers.
+            //
+            DataAvailable =
+                QuicRecvBufferRead(
+                    &Stream->RecvBuffer,
+                    &Event.RECEIVE.AbsoluteOffset,
+                    &Event.RECEIVE.BufferCount,
+                    RecvBuffers);
+        }
 
         if (DataAvailable) {
             for (uint32_t i = 0; i < Event.RECEIVE.BufferCount; ++i) {
@@ -735,61 +907,12 @@ QuicStreamRecvFlush(
             Event.RECEIVE.Flags |= QUIC_RECEIVE_FLAG_FIN; // TODO - 0-RTT flag?
         }
 
-        Stream->Flags.ReceiveEnabled = FALSE;
-        Stream->Flags.ReceiveCallPending = TRUE;
-        Stream->RecvPendingLength = Event.RECEIVE.TotalBufferLength;
-
-        QuicTraceLogStreamVerbose(
-            IndicateReceive,
-            Stream,
-            "Indicating QUIC_STREAM_EVENT_RECEIVE [%llu bytes, %u buffers, 0x%x flags]",
-            Event.RECEIVE.TotalBufferLength,
-            Event.RECEIVE.BufferCount,
-            Event.RECEIVE.Flags);
-
-        QUIC_STATUS Status = QuicStreamIndicateEvent(Stream, &Event);
-        if (Status == QUIC_STATUS_PENDING) {
-            if (Stream->Flags.ReceiveCallPending) {
-                //
-                // If the pending call wasn't completed inline, then receive
-                // callbacks MUST be disabled still.
-                //
-                CXPLAT_TEL_ASSERTMSG_ARGS(
-                    !Stream->Flags.ReceiveEnabled,
-                    "App pended recv AND enabled additional recv callbacks",
-                    Stream->Connection->Registration->AppName,
-                    0, 0);
-                Stream->Flags.ReceiveEnabled = FALSE;
-            }
-            break;
-        }
-
-        if (Status == QUIC_STATUS_CONTINUE) {
-            //
-            // The app has explicitly indicated it wants to continue to
-            // receive callbacks, even if all the data wasn't drained.
-            //
-            Stream->Flags.ReceiveEnabled = TRUE;
+        Event.RECEIVE.Buffers = RecvBuffers;
+        FlushRecv = QuicStreamRecvIndicate(Stream, &Event);
 
-        } else {
-            //
-            // All other failure status returns are ignored and shouldn't be
-            // used by the app.
-            //
-            CXPLAT_TEL_ASSERTMSG_ARGS(
-                QUIC_SUCCEEDED(Status),
-                "App failed recv callback",
-                Stream->Connection->Registration->AppName,
-                Status, 0);
+        if (RecvBuffers != StackRecvBuffers) {
+            CXPLAT_FREE(RecvBuffers, QUIC_POOL_TMP_ALLOC);
         }
-
-        CXPLAT_TEL_ASSERTMSG_ARGS(
-            Stream->Flags.ReceiveCallPending,
-            "App completed async recv without pending it",
-            Stream->Connection->Registration->AppName,
-            0, 0);
-
-        FlushRecv = QuicStreamReceiveComplete(Stream, Event.RECEIVE.TotalBufferLength);
     }
 }
 
@@ -805,6 +928,45 @@ QuicStreamReceiveCompletePending(
     }
 }
 
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamRecvReleaseInPlace(
+    _In_ QUIC_STREAM* Stream,
+    _In_ uint64_t BufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(Stream->RecvInPlaceData != NULL);
+
+    if (BufferLength < Stream->RecvInPlaceLength) {
+        //
+        // The app didn't consume everything, so the rest has to be copied into
+        // the receive buffer before the packet goes away.
+        //
+        QuicRecvBufferCopyIn(
+            &Stream->RecvBuffer,
+            Stream->RecvBuffer.BaseOffset + BufferLength,
+            (uint16_t)(Stream->RecvInPlaceLength - BufferLength),
+            Stream->RecvInPlaceData + BufferLength);
+    }
+
+    CXPLAT_RECV_PACKET* Packet = Stream->RecvInPlacePacket;
+    Stream->RecvInPlacePacket = NULL;
+    Stream->RecvInPlaceData = NULL;
+    Stream->RecvInPlaceLength = 0;
+
+    CXPLAT_DBG_ASSERT(Stream->Connection->RecvInPlaceCount != 0);
+    Stream->Connection->RecvInPlaceCount--;
+
+    CXPLAT_DBG_ASSERT(Packet->InPlaceRefCount != 0);
+    if (--Packet->InPlaceRefCount == 0 && Packet->ReleaseInPlace) {
+        //
+        // The connection already finished with the packet, so this was the
+        // last thing holding on to it.
+        //
+        CxPlatRecvDataReturn(CxPlatDataPathRecvPacketToRecvData(Packet));
+    }
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 BOOLEAN
 QuicStreamReceiveComplete(
@@ -829,6 +991,10 @@ QuicStreamReceiveComplete(
         "Recv complete (%llu bytes)",
         BufferLength);
 
+    if (Stream->RecvInPlaceData != NULL) {
+        QuicStreamRecvReleaseInPlace(Stream, BufferLength);
+    }
+
     //
     // Reclaim any buffer space comsumed by the app.
     //
@@ -357,6 +357,35 @@ QuicStreamCanSendNow(
     return FALSE;
 }
 
+BOOLEAN
+QuicStreamIsSendFlowBlocked(
+    _In_ const QUIC_STREAM* Stream
+    )
+{
+    if (!QuicStreamAllowedByPeer(Stream)) {
+        //
+        // Nothing can be sent until the peer allows more streams.
+        //
+        return
+            !!(Stream->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL);
+    }
+
+    if (HasStreamControlFrames(Stream->SendFlags) ||
+        (Stream->SendFlags & QUIC_STREAM_SEND_FLAG_OPEN) ||
+        RECOV_WINDOW_OPEN(Stream)) {
+        return FALSE;
+    }
+
+    //
+    // Only unsent data is queued, and all of it is beyond the peer's
+    // MAX_STREAM_DATA limit.
+    //
+    return
+        (Stream->OutFlowBlockedReasons & QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL) &&
+        Stream->NextSendOffset < Stream->QueuedSendOffset &&
+        Stream->NextSendOffset >= Stream->MaxAllowedSendOffset;
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 void
 QuicStreamCompleteSendRequest(
@@ -1047,6 +1076,14 @@ QuicStreamSendWrite(
                 Builder->Datagram->Buffer)) {
 
             Stream->SendFlags &= ~QUIC_STREAM_SEND_FLAG_MAX_DATA;
+            QuicConnQlog(
+                Stream->Connection,
+                FlowControlFrame,
+                TRUE,
+                QUIC_FRAME_MAX_STREAM_DATA,
+                Builder->Metadata->PacketNumber,
+                Stream->ID,
+                Frame.MaximumData);
             if (QuicPacketBuilderAddStreamFrame(Builder, Stream, QUIC_FRAME_MAX_STREAM_DATA)) {
                 return TRUE;
             }
@@ -1131,6 +1168,14 @@ QuicStreamSendWrite(
                 Builder->Datagram->Buffer)) {
 
             Stream->SendFlags &= ~QUIC_STREAM_SEND_FLAG_DATA_BLOCKED;
+            QuicConnQlog(
+                Stream->Connection,
+                FlowControlFrame,
+                TRUE,
+                QUIC_FRAME_STREAM_DATA_BLOCKED,
+                Builder->Metadata->PacketNumber,
+                Stream->ID,
+                Frame.StreamDataLimit);
             if (QuicPacketBuilderAddStreamFrame(Builder, Stream, QUIC_FRAME_STREAM_DATA_BLOCKED)) {
                 return TRUE;
             }
@@ -23,20 +23,16 @@ QuicStreamSetValidate(
     _In_ QUIC_STREAM_SET* StreamSet
     )
 {
-    if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created.
-    }
     QUIC_CONNECTION* Connection = QuicStreamSetGetConnection(StreamSet);
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        const QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
         CXPLAT_DBG_ASSERT(Stream->Type == QUIC_HANDLE_TYPE_STREAM);
         CXPLAT_DBG_ASSERT(Stream->Connection == Connection);
-        UNREFERENCED_PARAMETER(Stream);
+        UNREFERENCED_PARAMETER(Connection);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 #else
 #define QuicStreamSetValidate(StreamSet)
@@ -61,6 +57,11 @@ QuicStreamSetUninitialize(
     _Inout_ QUIC_STREAM_SET* StreamSet
     )
 {
+    for (uint8_t i = 0; i < NUMBER_OF_STREAM_TYPES; ++i) {
+        if (StreamSet->Types[i].Window != NULL) {
+            CXPLAT_FREE(StreamSet->Types[i].Window, QUIC_POOL_STREAM_WINDOW);
+        }
+    }
     if (StreamSet->StreamTable != NULL) {
         CxPlatHashtableUninitialize(StreamSet->StreamTable);
     }
@@ -75,18 +76,154 @@ QuicStreamSetTraceRundown(
     _In_ QUIC_STREAM_SET* StreamSet
     )
 {
-    if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created yet.
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
+        QuicStreamTraceRundown(Stream);
+    }
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateBegin(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Out_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    )
+{
+    Enumerator->Type = 0;
+    Enumerator->Index = 0;
+    Enumerator->StreamTable = StreamSet->StreamTable;
+    if (Enumerator->StreamTable != NULL) {
+        CxPlatHashtableEnumerateBegin(
+            Enumerator->StreamTable, &Enumerator->TableEnumerator);
+    }
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetEnumerateNext(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    )
+{
+    //
+    // Walk each type's window first. The enumeration state is a logical stream
+    // index rather than a slot, so it stays valid if the window slides or
+    // grows in the meantime.
+    //
+    while (Enumerator->Type < NUMBER_OF_STREAM_TYPES) {
+        const QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Enumerator->Type];
+        if (Enumerator->Index < Info->WindowBase) {
+            Enumerator->Index = Info->WindowBase;
+        }
+        uint64_t End = Info->WindowBase + Info->WindowSize;
+        if (End > Info->TotalStreamCount) {
+            End = Info->TotalStreamCount;
+        }
+        while (Enumerator->Index < End) {
+            QUIC_STREAM* Stream =
+                Info->Window[Enumerator->Index & (Info->WindowSize - 1)];
+            Enumerator->Index++;
+            if (Stream != NULL) {
+                return Stream;
+            }
+        }
+        Enumerator->Type++;
+        Enumerator->Index = 0;
+    }
+
+    if (Enumerator->StreamTable != NULL) {
+        CXPLAT_HASHTABLE_ENTRY* Entry =
+            CxPlatHashtableEnumerateNext(
+                Enumerator->StreamTable, &Enumerator->TableEnumerator);
+        if (Entry != NULL) {
+            return CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
+        }
     }
 
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        QuicStreamTraceRundown(
-            CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry));
+    return NULL;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateEnd(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    )
+{
+    UNREFERENCED_PARAMETER(StreamSet);
+    if (Enumerator->StreamTable != NULL) {
+        CxPlatHashtableEnumerateEnd(
+            Enumerator->StreamTable, &Enumerator->TableEnumerator);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+}
+
+//
+// Tries to place the stream in its type's window, sliding the window forward
+// past released streams or growing it as necessary. Returns FALSE if the
+// stream doesn't fit, in which case it goes in the hash table instead.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+BOOLEAN
+QuicStreamSetWindowInsert(
+    _Inout_ QUIC_STREAM_TYPE_INFO* Info,
+    _In_ QUIC_STREAM* Stream
+    )
+{
+    const uint64_t Index = Stream->ID >> 2;
+
+    if (Info->WindowSize == 0) {
+        Info->WindowBase = Index;
+    } else if (Index < Info->WindowBase) {
+        return FALSE;
+    }
+
+    while (Index - Info->WindowBase >= Info->WindowSize &&
+           Info->WindowSize != 0 &&
+           Info->Window[Info->WindowBase & (Info->WindowSize - 1)] == NULL) {
+        Info->WindowBase++;
+    }
+
+    if (Index - Info->WindowBase >= Info->WindowSize) {
+        uint32_t NewWindowSize =
+            Info->WindowSize == 0 ? QUIC_STREAM_WINDOW_INITIAL_SIZE : Info->WindowSize;
+        while (Index - Info->WindowBase >= NewWindowSize) {
+            if (NewWindowSize >= QUIC_STREAM_WINDOW_MAX_SIZE) {
+                return FALSE;
+            }
+            NewWindowSize <<= 1;
+        }
+
+        QUIC_STREAM** NewWindow =
+            CXPLAT_ALLOC_NONPAGED(
+                NewWindowSize * sizeof(QUIC_STREAM*), QUIC_POOL_STREAM_WINDOW);
+        if (NewWindow == NULL) {
+            QuicTraceEvent(
+                AllocFailure,
+                "Allocation of '%s' failed. (%llu bytes)",
+                "streamset window",
+                NewWindowSize * sizeof(QUIC_STREAM*));
+            return FALSE;
+        }
+        CxPlatZeroMemory(NewWindow, NewWindowSize * sizeof(QUIC_STREAM*));
+
+        for (uint64_t i = Info->WindowBase; i < Info->WindowBase + Info->WindowSize; ++i) {
+            NewWindow[i & (NewWindowSize - 1)] =
+                Info->Window[i & (Info->WindowSize - 1)];
+        }
+        if (Info->Window != NULL) {
+            CXPLAT_FREE(Info->Window, QUIC_POOL_STREAM_WINDOW);
+        }
+        Info->Window = NewWindow;
+        Info->WindowSize = NewWindowSize;
+    }
+
+    CXPLAT_DBG_ASSERT(Info->Window[Index & (Info->WindowSize - 1)] == NULL);
+    Info->Window[Index & (Info->WindowSize - 1)] = Stream;
+    return TRUE;
 }
 
 _IRQL_requires_max_(DISPATCH_LEVEL)
@@ -97,6 +234,11 @@ QuicStreamSetInsertStream(
     _In_ QUIC_STREAM* Stream
     )
 {
+    if (QuicStreamSetWindowInsert(
+            &StreamSet->Types[Stream->ID & STREAM_ID_MASK], Stream)) {
+        return TRUE;
+    }
+
     if (StreamSet->StreamTable == NULL) {
         //
         // Lazily initialize the hash table.
@@ -126,8 +268,18 @@ QuicStreamSetLookupStream(
     _In_ uint64_t ID
     )
 {
+    const QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[ID & STREAM_ID_MASK];
+    const uint64_t Index = ID >> 2;
+    if (Index - Info->WindowBase < Info->WindowSize) {
+        QUIC_STREAM* Stream = Info->Window[Index & (Info->WindowSize - 1)];
+        if (Stream != NULL) {
+            CXPLAT_DBG_ASSERT(Stream->ID == ID);
+            return Stream;
+        }
+    }
+
     if (StreamSet->StreamTable == NULL) {
-        return NULL; // No streams have been created yet.
+        return NULL; // No streams outside the windows.
     }
 
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT Context;
@@ -150,16 +302,10 @@ QuicStreamSetShutdown(
     _Inout_ QUIC_STREAM_SET* StreamSet
     )
 {
-    if (StreamSet->StreamTable == NULL) {
-        return; // No streams have been created.
-    }
-
-    CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-    CXPLAT_HASHTABLE_ENTRY* Entry;
-    CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-    while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-        QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
         QuicStreamShutdown(
             Stream,
             QUIC_STREAM_SHUTDOWN_FLAG_ABORT_SEND |
@@ -167,7 +313,7 @@ QuicStreamSetShutdown(
             QUIC_STREAM_SHUTDOWN_SILENT,
             0);
     }
-    CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -177,15 +323,25 @@ QuicStreamSetReleaseStream(
     _In_ QUIC_STREAM* Stream
     )
 {
+    uint8_t Flags = (uint8_t)(Stream->ID & STREAM_ID_MASK);
+    QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Flags];
+
     //
-    // Remove the stream from the list of open streams.
+    // Remove the stream from the set of open streams.
     //
-    CxPlatHashtableRemove(StreamSet->StreamTable, &Stream->TableEntry, NULL);
+    const uint64_t Index = Stream->ID >> 2;
+    if (Index - Info->WindowBase < Info->WindowSize &&
+        Info->Window[Index & (Info->WindowSize - 1)] == Stream) {
+        Info->Window[Index & (Info->WindowSize - 1)] = NULL;
+        while (Info->WindowBase < Info->TotalStreamCount &&
+               Info->Window[Info->WindowBase & (Info->WindowSize - 1)] == NULL) {
+            Info->WindowBase++;
+        }
+    } else {
+        CxPlatHashtableRemove(StreamSet->StreamTable, &Stream->TableEntry, NULL);
+    }
     CxPlatListInsertTail(&StreamSet->ClosedStreams, &Stream->ClosedLink);
 
-    uint8_t Flags = (uint8_t)(Stream->ID & STREAM_ID_MASK);
-    QUIC_STREAM_TYPE_INFO* Info = &StreamSet->Types[Flags];
-
     CXPLAT_DBG_ASSERT(Info->CurrentStreamCount != 0);
     Info->CurrentStreamCount--;
 
@@ -281,44 +437,41 @@ QuicStreamSetInitializeTransportParameters(
         UpdateAvailableStreams = TRUE;
     }
 
-    if (StreamSet->StreamTable != NULL) {
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-            uint8_t FlowBlockedFlagsToRemove = 0;
-
-            uint64_t StreamType = Stream->ID & STREAM_ID_MASK;
-            uint64_t StreamCount = (Stream->ID >> 2) + 1;
-            const QUIC_STREAM_TYPE_INFO* Info =
-                &Stream->Connection->Streams.Types[StreamType];
-            if (Info->MaxTotalStreamCount >= StreamCount) {
-                FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL;
-            }
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
 
-            uint64_t NewMaxAllowedSendOffset =
-                QuicStreamGetInitialMaxDataFromTP(
-                    Stream->ID,
-                    QuicConnIsServer(Connection),
-                    &Connection->PeerTransportParams);
+        uint8_t FlowBlockedFlagsToRemove = 0;
 
-            if (Stream->MaxAllowedSendOffset < NewMaxAllowedSendOffset) {
-                Stream->MaxAllowedSendOffset = NewMaxAllowedSendOffset;
-                FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL;
-                Stream->SendWindow = (uint32_t)min(Stream->MaxAllowedSendOffset, UINT32_MAX);
-            }
+        uint64_t StreamType = Stream->ID & STREAM_ID_MASK;
+        uint64_t StreamCount = (Stream->ID >> 2) + 1;
+        const QUIC_STREAM_TYPE_INFO* Info =
+            &Stream->Connection->Streams.Types[StreamType];
+        if (Info->MaxTotalStreamCount >= StreamCount) {
+            FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL;
+        }
 
-            if (FlowBlockedFlagsToRemove) {
-                QuicStreamRemoveOutFlowBlockedReason(
-                    Stream, FlowBlockedFlagsToRemove);
-                QuicStreamSendDumpState(Stream);
-                MightBeUnblocked = TRUE;
-            }
+        uint64_t NewMaxAllowedSendOffset =
+            QuicStreamGetInitialMaxDataFromTP(
+                Stream->ID,
+                QuicConnIsServer(Connection),
+                &Connection->PeerTransportParams);
+
+        if (Stream->MaxAllowedSendOffset < NewMaxAllowedSendOffset) {
+            Stream->MaxAllowedSendOffset = NewMaxAllowedSendOffset;
+            FlowBlockedFlagsToRemove |= QUIC_FLOW_BLOCKED_STREAM_FLOW_CONTROL;
+            Stream->SendWindow = (uint32_t)min(Stream->MaxAllowedSendOffset, UINT32_MAX);
+        }
+
+        if (FlowBlockedFlagsToRemove) {
+            QuicStreamRemoveOutFlowBlockedReason(
+                Stream, FlowBlockedFlagsToRemove);
+            QuicStreamSendDumpState(Stream);
+            MightBeUnblocked = TRUE;
         }
-        CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
     }
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 
     if (UpdateAvailableStreams) {
         QuicStreamSetIndicateStreamsAvailable(StreamSet);
@@ -372,25 +525,23 @@ QuicStreamSetUpdateMaxStreams(
             MaxStreams);
 
         BOOLEAN FlushSend = FALSE;
-        if (StreamSet->StreamTable != NULL) {
-
-            CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-            CXPLAT_HASHTABLE_ENTRY* Entry;
-            CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-            while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-                QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-                uint64_t Count = (Stream->ID >> 2) + 1;
-
-                if ((Stream->ID & STREAM_ID_MASK) == Mask &&
-                    Count > Info->MaxTotalStreamCount &&
-                    Count <= MaxStreams) {
-                    FlushSend = TRUE;
-                    QuicStreamRemoveOutFlowBlockedReason(
-                        Stream, QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL);
-                }
+
+        //
+        // Only the streams opened since the old limit was reached can have
+        // been blocked on it, so look those up directly.
+        //
+        uint64_t EndCount = MaxStreams;
+        if (EndCount > Info->TotalStreamCount) {
+            EndCount = Info->TotalStreamCount;
+        }
+        for (uint64_t Count = Info->MaxTotalStreamCount + 1; Count <= EndCount; ++Count) {
+            QUIC_STREAM* Stream =
+                QuicStreamSetLookupStream(StreamSet, ((Count - 1) << 2) | Mask);
+            if (Stream != NULL) {
+                FlushSend = TRUE;
+                QuicStreamRemoveOutFlowBlockedReason(
+                    Stream, QUIC_FLOW_BLOCKED_STREAM_ID_FLOW_CONTROL);
             }
-            CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
         }
 
         Info->MaxTotalStreamCount = MaxStreams;
@@ -467,27 +618,24 @@ QuicStreamSetGetFlowControlSummary(
     *FcAvailable = 0;
     *SendWindow = 0;
 
-    if (StreamSet->StreamTable != NULL) {
-        CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
-        CXPLAT_HASHTABLE_ENTRY* Entry;
-        CxPlatHashtableEnumerateBegin(StreamSet->StreamTable, &Enumerator);
-        while ((Entry = CxPlatHashtableEnumerateNext(StreamSet->StreamTable, &Enumerator)) != NULL) {
-            QUIC_STREAM* Stream = CXPLAT_CONTAINING_RECORD(Entry, QUIC_STREAM, TableEntry);
-
-            if ((UINT64_MAX - *FcAvailable) >= (Stream->MaxAllowedSendOffset - Stream->NextSendOffset)) {
-                *FcAvailable += Stream->MaxAllowedSendOffset - Stream->NextSendOffset;
-            } else {
-                *FcAvailable = UINT64_MAX;
-            }
+    QUIC_STREAM_SET_ENUMERATOR Enumerator;
+    QUIC_STREAM* Stream;
+    QuicStreamSetEnumerateBegin(StreamSet, &Enumerator);
+    while ((Stream = QuicStreamSetEnumerateNext(StreamSet, &Enumerator)) != NULL) {
 
-            if ((UINT64_MAX - *SendWindow) >= Stream->SendWindow) {
-                *SendWindow += Stream->SendWindow;
-            } else {
-                *SendWindow = UINT64_MAX;
-            }
+        if ((UINT64_MAX - *FcAvailable) >= (Stream->MaxAllowedSendOffset - Stream->NextSendOffset)) {
+            *FcAvailable += Stream->MaxAllowedSendOffset - Stream->NextSendOffset;
+        } else {
+            *FcAvailable = UINT64_MAX;
+        }
+
+        if ((UINT64_MAX - *SendWindow) >= Stream->SendWindow) {
+            *SendWindow += Stream->SendWindow;
+        } else {
+            *SendWindow = UINT64_MAX;
         }
-        CxPlatHashtableEnumerateEnd(StreamSet->StreamTable, &Enumerator);
     }
+    QuicStreamSetEnumerateEnd(StreamSet, &Enumerator);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
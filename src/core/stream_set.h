@@ -32,6 +32,24 @@ typedef struct QUIC_STREAM_TYPE_INFO {
     //
     uint16_t CurrentStreamCount;
 
+    //
+    // The number of entries in Window. Always zero or a power of two.
+    //
+    uint32_t WindowSize;
+
+    //
+    // The lowest stream count (stream ID >> 2) Window currently covers. Only
+    // moves forward, past streams that have been released.
+    //
+    uint64_t WindowBase;
+
+    //
+    // Sliding window of open streams, indexed by (stream ID >> 2) modulo
+    // WindowSize. Stream IDs are assigned densely, so nearly every open stream
+    // lives here; any that don't fit fall back to the stream set's hash table.
+    //
+    QUIC_STREAM** Window;
+
 } QUIC_STREAM_TYPE_INFO;
 
 typedef struct QUIC_STREAM_SET {
@@ -42,7 +60,7 @@ typedef struct QUIC_STREAM_SET {
     QUIC_STREAM_TYPE_INFO Types[NUMBER_OF_STREAM_TYPES];
 
     //
-    // The hash table of all active streams.
+    // The hash table of active streams that don't fit in their type's Window.
     //
     CXPLAT_HASHTABLE* StreamTable;
 
@@ -61,6 +79,19 @@ typedef struct QUIC_STREAM_SET {
 
 } QUIC_STREAM_SET;
 
+//
+// State for enumerating all the open streams in a stream set. Streams may be
+// released while the enumeration is in progress.
+//
+typedef struct QUIC_STREAM_SET_ENUMERATOR {
+
+    uint8_t Type;
+    uint64_t Index;
+    CXPLAT_HASHTABLE* StreamTable;
+    CXPLAT_HASHTABLE_ENUMERATOR TableEnumerator;
+
+} QUIC_STREAM_SET_ENUMERATOR;
+
 //
 // Initializes the stream set.
 //
@@ -88,6 +119,60 @@ QuicStreamSetTraceRundown(
     _In_ QUIC_STREAM_SET* StreamSet
     );
 
+//
+// Starts an enumeration of all open streams.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateBegin(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Out_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
+//
+// Returns the next open stream, or NULL when the enumeration is complete.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetEnumerateNext(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
+//
+// Cleans up the state of an enumeration.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+void
+QuicStreamSetEnumerateEnd(
+    _In_ const QUIC_STREAM_SET* StreamSet,
+    _Inout_ QUIC_STREAM_SET_ENUMERATOR* Enumerator
+    );
+
+//
+// Adds an open stream to the set, in its type's window if it fits there and
+// in the hash table otherwise.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Success_(return != FALSE)
+BOOLEAN
+QuicStreamSetInsertStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ QUIC_STREAM* Stream
+    );
+
+//
+// Finds an open stream by its stream ID.
+//
+_IRQL_requires_max_(DISPATCH_LEVEL)
+_Ret_maybenull_
+QUIC_STREAM*
+QuicStreamSetLookupStream(
+    _Inout_ QUIC_STREAM_SET* StreamSet,
+    _In_ uint64_t ID
+    );
+
 //
 // Shuts down (silent, abortive) all streams.
 //
@@ -0,0 +1,178 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_ADMISSION interface.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "AdmissionTest.cpp.clog.h"
+#endif
+
+#define TEST_INITIAL_RATE 1000
+#define TEST_PREFIX_RATE (TEST_INITIAL_RATE / QUIC_ADMISSION_PREFIX_RATE_DIVISOR)
+
+struct Admission {
+    QUIC_ADMISSION State;
+    uint32_t TimeMs;
+    Admission() {
+        QuicAdmissionInitialize(&State);
+        TimeMs = State.IntervalStartTimeMs;
+    }
+    ~Admission() {
+        QuicAdmissionUninitialize(&State);
+    }
+    QUIC_ADMISSION_RESULT Check(
+        _In_z_ const char* Address,
+        _In_ bool Validated = false
+        ) {
+        QUIC_ADDR Addr;
+        EXPECT_TRUE(QuicAddrFromString(Address, 443, &Addr));
+        return
+            QuicAdmissionCheck(
+                &State,
+                TEST_INITIAL_RATE,
+                &Addr,
+                Validated ? TRUE : FALSE,
+                TimeMs);
+    }
+    void Charge(
+        _In_z_ const char* Address,
+        _In_ uint32_t CostUs
+        ) {
+        QUIC_ADDR Addr;
+        EXPECT_TRUE(QuicAddrFromString(Address, 443, &Addr));
+        QuicAdmissionChargeHandshake(&State, &Addr, CostUs);
+    }
+    //
+    // Generates unvalidated connection attempts at the given rate (per second)
+    // for whole measurement intervals. Each interval is evaluated by the first
+    // attempt of the next one.
+    //
+    void Load(
+        _In_ uint32_t Rate,
+        _In_ uint32_t Intervals = 1
+        ) {
+        uint32_t Count = (Rate * QUIC_ADMISSION_INTERVAL_MS) / 1000;
+        if (Count == 0) {
+            Count = 1;
+        }
+        for (uint32_t i = 0; i < Intervals; ++i) {
+            for (uint32_t j = 0; j < Count; ++j) {
+                (void)Check("192.0.2.1");
+            }
+            TimeMs += QUIC_ADMISSION_INTERVAL_MS;
+        }
+    }
+};
+
+TEST(AdmissionTest, AcceptBelowRate)
+{
+    Admission Admission;
+    Admission.Load(TEST_INITIAL_RATE / 2, 3);
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_NORMAL, Admission.State.Level);
+}
+
+TEST(AdmissionTest, RetryAboveRate)
+{
+    Admission Admission;
+    Admission.Load(TEST_INITIAL_RATE + TEST_INITIAL_RATE / 2);
+    ASSERT_EQ(QUIC_ADMISSION_RETRY, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_RETRY, Admission.State.Level);
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.100.1", true));
+}
+
+TEST(AdmissionTest, RateLimitPerPrefix)
+{
+    Admission Admission;
+    Admission.Load(2 * TEST_INITIAL_RATE + TEST_INITIAL_RATE / 2);
+    ASSERT_EQ(QUIC_ADMISSION_RETRY, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_RATE_LIMIT, Admission.State.Level);
+
+    //
+    // Validated attempts from the same /24 share one limit.
+    //
+    char Address[32];
+    for (uint32_t i = 0; i < TEST_PREFIX_RATE; ++i) {
+        sprintf_s(Address, sizeof(Address), "198.51.100.%u", i % 250 + 1);
+        ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check(Address, true));
+    }
+    ASSERT_EQ(QUIC_ADMISSION_RATE_LIMITED, Admission.Check("198.51.100.251", true));
+
+    //
+    // Other prefixes are unaffected.
+    //
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.101.1", true));
+
+    //
+    // The prefix's tokens refill over time.
+    //
+    Admission.TimeMs += 1000 / TEST_PREFIX_RATE + 1;
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.100.1", true));
+}
+
+TEST(AdmissionTest, ExpensivePrefixLimitedSooner)
+{
+    Admission Admission;
+    Admission.Load(2 * TEST_INITIAL_RATE + TEST_INITIAL_RATE / 2);
+    ASSERT_EQ(QUIC_ADMISSION_RETRY, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_RATE_LIMIT, Admission.State.Level);
+
+    for (uint32_t i = 0; i < 32; ++i) {
+        Admission.Charge("203.0.113.1", 4 * QUIC_ADMISSION_HANDSHAKE_COST_UNIT_US);
+    }
+
+    uint32_t Accepted = 0;
+    while (Admission.Check("203.0.113.1", true) == QUIC_ADMISSION_ACCEPT) {
+        ASSERT_LE(++Accepted, (uint32_t)TEST_PREFIX_RATE);
+    }
+    ASSERT_LT(Accepted, (uint32_t)TEST_PREFIX_RATE / 2);
+    ASSERT_NE(0u, Accepted);
+}
+
+TEST(AdmissionTest, DropAboveFourTimesRate)
+{
+    Admission Admission;
+    Admission.Load(5 * TEST_INITIAL_RATE);
+    ASSERT_EQ(QUIC_ADMISSION_DROP, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_DROP, Admission.State.Level);
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.100.1", true));
+}
+
+TEST(AdmissionTest, DeescalateOneLevelAtATime)
+{
+    Admission Admission;
+    Admission.Load(5 * TEST_INITIAL_RATE);
+    ASSERT_EQ(QUIC_ADMISSION_DROP, Admission.Check("198.51.100.1"));
+
+    //
+    // One quiet interval isn't enough to step down.
+    //
+    Admission.Load(0);
+    ASSERT_EQ(QUIC_ADMISSION_DROP, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_DROP, Admission.State.Level);
+
+    Admission.Load(0, QUIC_ADMISSION_COOLDOWN_INTERVALS - 1);
+    ASSERT_EQ(QUIC_ADMISSION_RETRY, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_RATE_LIMIT, Admission.State.Level);
+
+    Admission.Load(0, QUIC_ADMISSION_COOLDOWN_INTERVALS);
+    ASSERT_EQ(QUIC_ADMISSION_RETRY, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_RETRY, Admission.State.Level);
+
+    Admission.Load(0, QUIC_ADMISSION_COOLDOWN_INTERVALS);
+    ASSERT_EQ(QUIC_ADMISSION_ACCEPT, Admission.Check("198.51.100.1"));
+    ASSERT_EQ(QUIC_ADMISSION_LEVEL_NORMAL, Admission.State.Level);
+
+    //
+    // Escalation is immediate though.
+    //
+    Admission.Load(5 * TEST_INITIAL_RATE);
+    ASSERT_EQ(QUIC_ADMISSION_DROP, Admission.Check("198.51.100.1"));
+}
@@ -0,0 +1,80 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the latency histogram bucket layout.
+
+--*/
+
+#include "msquichelper.h" // Before main.h, which removes the min/max macros it uses.
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "LatencyHistogramTest.cpp.clog.h"
+#endif
+
+TEST(LatencyHistogramTest, SmallValuesHaveOwnBucket)
+{
+    for (uint32_t Value = 0; Value < 16; ++Value) {
+        ASSERT_EQ(Value, QuicLatencyHistogramBucketIndex(Value));
+        ASSERT_EQ(Value, QuicLatencyHistogramBucketLowerBound(Value));
+    }
+}
+
+TEST(LatencyHistogramTest, BucketBoundaries)
+{
+    ASSERT_EQ(16u, QuicLatencyHistogramBucketIndex(16));
+    ASSERT_EQ(16u, QuicLatencyHistogramBucketIndex(17));
+    ASSERT_EQ(17u, QuicLatencyHistogramBucketIndex(18));
+    ASSERT_EQ(23u, QuicLatencyHistogramBucketIndex(31));
+    ASSERT_EQ(24u, QuicLatencyHistogramBucketIndex(32));
+    ASSERT_EQ(
+        (uint32_t)QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1,
+        QuicLatencyHistogramBucketIndex(UINT32_MAX));
+    ASSERT_EQ(
+        (uint32_t)QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1,
+        QuicLatencyHistogramBucketIndex(UINT64_MAX));
+}
+
+TEST(LatencyHistogramTest, LowerBoundsMatchIndex)
+{
+    uint64_t PrevLowerBound = 0;
+    for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+        const uint64_t LowerBound = QuicLatencyHistogramBucketLowerBound(i);
+        ASSERT_EQ(i, QuicLatencyHistogramBucketIndex(LowerBound));
+        if (i != 0) {
+            ASSERT_GT(LowerBound, PrevLowerBound);
+            ASSERT_EQ(i - 1, QuicLatencyHistogramBucketIndex(LowerBound - 1));
+            //
+            // Buckets are never more than 12.5% wider than their lower bound.
+            //
+            ASSERT_LE((LowerBound - PrevLowerBound) * 8, PrevLowerBound < 16 ? 8 : PrevLowerBound);
+        }
+        PrevLowerBound = LowerBound;
+    }
+}
+
+TEST(LatencyHistogramTest, Percentile)
+{
+    QUIC_LATENCY_HISTOGRAM Histogram;
+    CxPlatZeroMemory(&Histogram, sizeof(Histogram));
+    ASSERT_EQ(0ull, QuicLatencyHistogramPercentile(&Histogram, 99));
+
+    for (uint64_t Value = 1; Value <= 1000; ++Value) {
+        Histogram.Buckets[QuicLatencyHistogramBucketIndex(Value)]++;
+        Histogram.Sum += Value;
+        Histogram.Count++;
+    }
+
+    const uint64_t P50 = QuicLatencyHistogramPercentile(&Histogram, 50);
+    ASSERT_LE(P50, 501ull);
+    ASSERT_GE(P50 * 9, 501ull * 8);
+    const uint64_t P99 = QuicLatencyHistogramPercentile(&Histogram, 99);
+    ASSERT_LE(P99, 991ull);
+    ASSERT_GE(P99 * 9, 991ull * 8);
+    ASSERT_EQ(
+        QuicLatencyHistogramBucketLowerBound(QuicLatencyHistogramBucketIndex(1000)),
+        QuicLatencyHistogramPercentile(&Histogram, 100));
+}
@@ -0,0 +1,155 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_OPERATION_QUEUE ordering.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "OperationTest.cpp.clog.h"
+#endif
+
+#define TEST_OPER_COUNT 4
+
+struct OperationQueue {
+    QUIC_OPERATION_QUEUE OperQ;
+    //
+    // The operations come from a worker's pool, like a connection's do.
+    //
+    QUIC_WORKER Worker;
+    QUIC_OPERATION* Opers[TEST_OPER_COUNT];
+    QUIC_OPERATION* PriorityOpers[TEST_OPER_COUNT];
+    //
+    // The queue updates the perf counters in the library's per-processor
+    // state, which only exists once the library is initialized. Allocate it
+    // the way the library does if it isn't.
+    //
+    bool OwnsPerProc;
+    OperationQueue() : OwnsPerProc(MsQuicLib.PerProc == nullptr) {
+        if (OwnsPerProc) {
+            MsQuicLib.ProcessorCount = (uint16_t)CxPlatProcActiveCount();
+            MsQuicLib.PartitionCount = MsQuicLib.ProcessorCount;
+            MsQuicLib.PerProc =
+                (QUIC_LIBRARY_PP*)CXPLAT_ALLOC_NONPAGED(
+                    MsQuicLib.ProcessorCount * sizeof(QUIC_LIBRARY_PP),
+                    QUIC_POOL_PERPROC);
+            CXPLAT_FRE_ASSERT(MsQuicLib.PerProc != nullptr);
+            CxPlatZeroMemory(
+                MsQuicLib.PerProc,
+                MsQuicLib.ProcessorCount * sizeof(QUIC_LIBRARY_PP));
+        }
+        CxPlatZeroMemory(&Worker, sizeof(Worker));
+        CxPlatPoolInitialize(FALSE, sizeof(QUIC_OPERATION), QUIC_POOL_OPER, &Worker.OperPool);
+        QuicOperationQueueInitialize(&OperQ);
+        for (uint32_t i = 0; i < TEST_OPER_COUNT; ++i) {
+            Opers[i] = QuicOperationAlloc(&Worker, QUIC_OPER_TYPE_FLUSH_SEND);
+            CXPLAT_FRE_ASSERT(Opers[i] != nullptr);
+            PriorityOpers[i] = QuicOperationAlloc(&Worker, QUIC_OPER_TYPE_TIMER_EXPIRED);
+            CXPLAT_FRE_ASSERT(PriorityOpers[i] != nullptr);
+        }
+    }
+    ~OperationQueue() {
+        QuicOperationQueueUninitialize(&OperQ);
+        for (uint32_t i = 0; i < TEST_OPER_COUNT; ++i) {
+            QuicOperationFree(&Worker, Opers[i]);
+            QuicOperationFree(&Worker, PriorityOpers[i]);
+        }
+        CxPlatPoolUninitialize(&Worker.OperPool);
+        if (OwnsPerProc) {
+            CXPLAT_FREE(MsQuicLib.PerProc, QUIC_POOL_PERPROC);
+            MsQuicLib.PerProc = nullptr;
+            MsQuicLib.PartitionCount = 0;
+            MsQuicLib.ProcessorCount = 0;
+        }
+    }
+    bool Enqueue(uint32_t i) {
+        return QuicOperationEnqueue(&OperQ, Opers[i]) != FALSE;
+    }
+    bool EnqueueFront(uint32_t i) {
+        return QuicOperationEnqueueFront(&OperQ, PriorityOpers[i]) != FALSE;
+    }
+    QUIC_OPERATION* Dequeue() {
+        return QuicOperationDequeue(&OperQ);
+    }
+};
+
+TEST(OperationTest, Fifo)
+{
+    OperationQueue Queue;
+    ASSERT_TRUE(Queue.Enqueue(0));
+    for (uint32_t i = 1; i < TEST_OPER_COUNT; ++i) {
+        ASSERT_FALSE(Queue.Enqueue(i));
+    }
+    for (uint32_t i = 0; i < TEST_OPER_COUNT; ++i) {
+        ASSERT_EQ(Queue.Opers[i], Queue.Dequeue());
+    }
+    ASSERT_EQ(nullptr, Queue.Dequeue());
+    ASSERT_FALSE(Queue.OperQ.ActivelyProcessing);
+
+    //
+    // Once drained, the next operation must start processing again.
+    //
+    ASSERT_TRUE(Queue.Enqueue(0));
+    ASSERT_EQ(Queue.Opers[0], Queue.Dequeue());
+    ASSERT_EQ(nullptr, Queue.Dequeue());
+}
+
+TEST(OperationTest, PriorityOnIdleQueue)
+{
+    OperationQueue Queue;
+    ASSERT_TRUE(Queue.EnqueueFront(0));
+    ASSERT_FALSE(Queue.Enqueue(0));
+    ASSERT_FALSE(Queue.EnqueueFront(1));
+    ASSERT_TRUE(Queue.OperQ.PriorityQueued);
+
+    //
+    // Priority operations are processed most recent first, ahead of all
+    // normal ones.
+    //
+    ASSERT_EQ(Queue.PriorityOpers[1], Queue.Dequeue());
+    ASSERT_FALSE(Queue.OperQ.PriorityQueued);
+    ASSERT_EQ(Queue.PriorityOpers[0], Queue.Dequeue());
+    ASSERT_EQ(Queue.Opers[0], Queue.Dequeue());
+    ASSERT_EQ(nullptr, Queue.Dequeue());
+    ASSERT_TRUE(CxPlatListIsEmpty(&Queue.OperQ.PriorityList));
+}
+
+TEST(OperationTest, PriorityAheadOfProcessList)
+{
+    OperationQueue Queue;
+    ASSERT_TRUE(Queue.Enqueue(0));
+    ASSERT_FALSE(Queue.Enqueue(1));
+    ASSERT_FALSE(Queue.Enqueue(2));
+
+    //
+    // The first dequeue takes everything off the queue, so the rest is
+    // waiting on ProcessList.
+    //
+    ASSERT_EQ(Queue.Opers[0], Queue.Dequeue());
+    ASSERT_FALSE(CxPlatListIsEmpty(&Queue.OperQ.ProcessList));
+    ASSERT_TRUE(CxPlatListIsEmpty(&Queue.OperQ.List));
+
+    ASSERT_FALSE(Queue.EnqueueFront(0));
+    ASSERT_FALSE(Queue.Enqueue(3));
+
+    ASSERT_EQ(Queue.PriorityOpers[0], Queue.Dequeue());
+    ASSERT_FALSE(Queue.OperQ.PriorityQueued);
+    ASSERT_EQ(Queue.Opers[1], Queue.Dequeue());
+
+    //
+    // A priority operation queued in the middle of ProcessList still jumps
+    // ahead of what's left of it.
+    //
+    ASSERT_FALSE(Queue.EnqueueFront(1));
+    ASSERT_EQ(Queue.PriorityOpers[1], Queue.Dequeue());
+    ASSERT_EQ(Queue.Opers[2], Queue.Dequeue());
+    ASSERT_EQ(Queue.Opers[3], Queue.Dequeue());
+    ASSERT_EQ(nullptr, Queue.Dequeue());
+    ASSERT_FALSE(Queue.OperQ.ActivelyProcessing);
+    ASSERT_FALSE(Queue.OperQ.PriorityQueued);
+}
@@ -0,0 +1,368 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_RECV_BUFFER interface.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "RecvBufferTest.cpp.clog.h"
+#endif
+
+#define DEF_TEST_BUFFER_LENGTH 64
+#define DEF_VIRTUAL_BUFFER_LENGTH 0x1000
+
+struct RecvBuffer {
+    QUIC_RECV_BUFFER RecvBuf {};
+    CXPLAT_POOL ChunkPool;
+    bool PoolInitialized {false};
+    ~RecvBuffer() {
+        QuicRecvBufferUninitialize(&RecvBuf);
+        if (PoolInitialized) {
+            CxPlatPoolUninitialize(&ChunkPool);
+        }
+    }
+    QUIC_STATUS Initialize(
+        _In_ QUIC_RECV_BUF_MODE Mode,
+        _In_ bool UsePool = false,
+        _In_ uint32_t AllocBufferLength = DEF_TEST_BUFFER_LENGTH,
+        _In_ uint32_t VirtualBufferLength = DEF_VIRTUAL_BUFFER_LENGTH
+        ) {
+        if (UsePool) {
+            CxPlatPoolInitialize(
+                FALSE,
+                sizeof(QUIC_RECV_CHUNK) + AllocBufferLength,
+                QUIC_POOL_TEST,
+                &ChunkPool);
+            PoolInitialized = true;
+        }
+        return
+            QuicRecvBufferInitialize(
+                &RecvBuf,
+                AllocBufferLength,
+                VirtualBufferLength,
+                Mode,
+                UsePool ? &ChunkPool : NULL);
+    }
+    QUIC_STATUS Write(
+        _In_ uint64_t WriteOffset,
+        _In_ uint16_t WriteLength,
+        _Out_ BOOLEAN* ReadyToRead,
+        _In_ bool MarkOnly = false
+        ) {
+        uint8_t Buffer[0x1000];
+        for (uint16_t i = 0; i < WriteLength; ++i) {
+            Buffer[i] = (uint8_t)(WriteOffset + i);
+        }
+        uint64_t InOutWriteLength = UINT64_MAX;
+        return
+            QuicRecvBufferWrite(
+                &RecvBuf,
+                WriteOffset,
+                WriteLength,
+                MarkOnly ? nullptr : Buffer,
+                &InOutWriteLength,
+                ReadyToRead);
+    }
+    void CopyIn(
+        _In_ uint64_t Offset,
+        _In_ uint16_t Length
+        ) {
+        uint8_t Buffer[0x1000];
+        for (uint16_t i = 0; i < Length; ++i) {
+            Buffer[i] = (uint8_t)(Offset + i);
+        }
+        QuicRecvBufferCopyIn(&RecvBuf, Offset, Length, Buffer);
+    }
+    //
+    // Reads all available data and validates its contents. Returns the total
+    // length read.
+    //
+    uint64_t Read(
+        _Inout_ uint32_t* BufferCount,
+        _Out_writes_all_(*BufferCount) QUIC_BUFFER* Buffers
+        ) {
+        uint64_t BufferOffset = 0;
+        if (!QuicRecvBufferRead(&RecvBuf, &BufferOffset, BufferCount, Buffers)) {
+            return 0;
+        }
+        uint64_t Offset = BufferOffset;
+        for (uint32_t i = 0; i < *BufferCount; ++i) {
+            for (uint32_t j = 0; j < Buffers[i].Length; ++j) {
+                EXPECT_EQ((uint8_t)Offset, Buffers[i].Buffer[j]);
+                Offset++;
+            }
+        }
+        return Offset - BufferOffset;
+    }
+    bool Drain(_In_ uint64_t DrainLength) {
+        return QuicRecvBufferDrain(&RecvBuf, DrainLength) != FALSE;
+    }
+};
+
+struct WithMode : public ::testing::TestWithParam<QUIC_RECV_BUF_MODE> {
+};
+
+std::ostream& operator << (std::ostream& o, const QUIC_RECV_BUF_MODE& mode) {
+    return o << (mode == QUIC_RECV_BUF_MODE_CHUNKED ? "Chunked" : "Contiguous");
+}
+
+TEST_P(WithMode, InOrderWriteReadDrain)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 20, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(20, 20, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+
+    QUIC_BUFFER Buffers[4];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(40ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(1u, BufferCount);
+    ASSERT_TRUE(RecvBuf.Drain(40));
+    ASSERT_FALSE(QuicRecvBufferHasUnreadData(&RecvBuf.RecvBuf));
+}
+
+TEST_P(WithMode, OutOfOrderWrite)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(20, 20, &ReadyToRead));
+    ASSERT_FALSE(ReadyToRead);
+
+    QUIC_BUFFER Buffers[4];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(0ull, RecvBuf.Read(&BufferCount, Buffers));
+
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 20, &ReadyToRead));
+    ASSERT_TRUE(ReadyToRead);
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(40ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_TRUE(RecvBuf.Drain(40));
+}
+
+TEST_P(WithMode, PartialDrain)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 50, &ReadyToRead));
+
+    QUIC_BUFFER Buffers[4];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(50ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_FALSE(RecvBuf.Drain(30));
+
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(50, 50, &ReadyToRead));
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(70ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_TRUE(RecvBuf.Drain(70));
+}
+
+TEST_P(WithMode, Grow)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    for (uint16_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(i * 40, 40, &ReadyToRead));
+    }
+    ASSERT_LE(400u, RecvBuf.RecvBuf.AllocBufferLength);
+
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(400ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_TRUE(RecvBuf.Drain(400));
+}
+
+TEST_P(WithMode, WriteBeyondVirtualLength)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        RecvBuf.Write(DEF_VIRTUAL_BUFFER_LENGTH - 10, 20, &ReadyToRead));
+}
+
+TEST_P(WithMode, MarkOnlyWriteThenCopyIn)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(GetParam()));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 100, &ReadyToRead, true));
+    ASSERT_TRUE(ReadyToRead);
+    RecvBuf.CopyIn(0, 100);
+
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(100ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_TRUE(RecvBuf.Drain(100));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    RecvBufferTest,
+    WithMode,
+    ::testing::Values(QUIC_RECV_BUF_MODE_CONTIGUOUS, QUIC_RECV_BUF_MODE_CHUNKED));
+
+TEST(RecvBufferTest, ChunkedReadSpansChunks)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_CHUNKED, true));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 3 * DEF_TEST_BUFFER_LENGTH, &ReadyToRead));
+    ASSERT_EQ(3u, RecvBuf.RecvBuf.ChunkCount);
+
+    //
+    // Limiting the buffer count limits how much is read.
+    //
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint32_t BufferCount = 2;
+    ASSERT_EQ(2ull * DEF_TEST_BUFFER_LENGTH, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(2u, BufferCount);
+    ASSERT_FALSE(RecvBuf.Drain(2 * DEF_TEST_BUFFER_LENGTH));
+    ASSERT_EQ(1u, RecvBuf.RecvBuf.ChunkCount);
+
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ((uint64_t)DEF_TEST_BUFFER_LENGTH, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(1u, BufferCount);
+    ASSERT_TRUE(RecvBuf.Drain(DEF_TEST_BUFFER_LENGTH));
+}
+
+TEST(RecvBufferTest, ChunkedUnalignedReads)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_CHUNKED, true));
+    BOOLEAN ReadyToRead = FALSE;
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint64_t Written = 0, Read = 0;
+    for (uint32_t i = 0; i < 50; ++i) {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(Written, 37, &ReadyToRead));
+        Written += 37;
+        uint32_t BufferCount = ARRAYSIZE(Buffers);
+        uint64_t Length = RecvBuf.Read(&BufferCount, Buffers);
+        ASSERT_EQ(Written - Read, Length);
+        //
+        // Only drain part of it each time, to move the read start around.
+        //
+        RecvBuf.Drain(Length / 2 + 1);
+        Read += Length / 2 + 1;
+        ASSERT_LE(
+            (uint64_t)RecvBuf.RecvBuf.ChunkCount,
+            (Written - Read) / DEF_TEST_BUFFER_LENGTH + 2);
+    }
+}
+
+TEST(RecvBufferTest, ChunkedGrowDoesNotMoveReadData)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_CHUNKED));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 40, &ReadyToRead));
+
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(40ull, RecvBuf.Read(&BufferCount, Buffers));
+    uint8_t* ReadBuffer = Buffers[0].Buffer;
+
+    //
+    // Writing well past the current allocation while the app holds the read
+    // buffers must not move them.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(40, 400, &ReadyToRead));
+    for (uint32_t i = 0; i < 40; ++i) {
+        ASSERT_EQ((uint8_t)i, ReadBuffer[i]);
+    }
+    ASSERT_FALSE(RecvBuf.Drain(40));
+
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(400ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_TRUE(RecvBuf.Drain(400));
+    ASSERT_EQ(1u, RecvBuf.RecvBuf.ChunkCount);
+    ASSERT_EQ(0u, RecvBuf.RecvBuf.BufferStart);
+}
+
+TEST(RecvBufferTest, ChunkedRingWrapsAndGrows)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_CHUNKED, true));
+    BOOLEAN ReadyToRead = FALSE;
+    QUIC_BUFFER Buffers[QUIC_MAX_RECV_INDICATION_BUFFER_COUNT];
+    uint32_t BufferCount;
+
+    //
+    // Drain a chunk at a time while keeping two written, so the ring keeps
+    // wrapping around its inline entries.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, DEF_TEST_BUFFER_LENGTH, &ReadyToRead));
+    uint64_t Written = DEF_TEST_BUFFER_LENGTH;
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(Written, DEF_TEST_BUFFER_LENGTH, &ReadyToRead));
+        Written += DEF_TEST_BUFFER_LENGTH;
+        ASSERT_EQ(2u, RecvBuf.RecvBuf.ChunkCount);
+        ASSERT_EQ(
+            (uint32_t)QUIC_RECV_BUFFER_PREALLOC_CHUNKS,
+            RecvBuf.RecvBuf.ChunkArrayLength);
+        BufferCount = 1;
+        ASSERT_EQ((uint64_t)DEF_TEST_BUFFER_LENGTH, RecvBuf.Read(&BufferCount, Buffers));
+        ASSERT_FALSE(RecvBuf.Drain(DEF_TEST_BUFFER_LENGTH));
+    }
+
+    //
+    // Growing past the inline entries while wrapped must keep the chunks in
+    // order.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(Written, 5 * DEF_TEST_BUFFER_LENGTH, &ReadyToRead));
+    Written += 5 * DEF_TEST_BUFFER_LENGTH;
+    ASSERT_EQ(6u, RecvBuf.RecvBuf.ChunkCount);
+    ASSERT_LE(6u, RecvBuf.RecvBuf.ChunkArrayLength);
+
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(6ull * DEF_TEST_BUFFER_LENGTH, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(6u, BufferCount);
+    ASSERT_TRUE(RecvBuf.Drain(6 * DEF_TEST_BUFFER_LENGTH));
+    ASSERT_EQ(1u, RecvBuf.RecvBuf.ChunkCount);
+}
+
+TEST(RecvBufferTest, ContiguousDrainDoesNotMoveData)
+{
+    RecvBuffer RecvBuf;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Initialize(QUIC_RECV_BUF_MODE_CONTIGUOUS));
+    BOOLEAN ReadyToRead = FALSE;
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(0, 40, &ReadyToRead));
+
+    QUIC_BUFFER Buffers[1];
+    uint32_t BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(40ull, RecvBuf.Read(&BufferCount, Buffers));
+    uint8_t* ReadBuffer = Buffers[0].Buffer;
+    ASSERT_FALSE(RecvBuf.Drain(10));
+
+    //
+    // The remaining bytes stay where they were.
+    //
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(30ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(ReadBuffer + 10, Buffers[0].Buffer);
+    ASSERT_FALSE(RecvBuf.Drain(10));
+
+    //
+    // A write that only fits once the drained space is reclaimed moves them
+    // back to the front without growing the buffer.
+    //
+    ASSERT_EQ(QUIC_STATUS_SUCCESS, RecvBuf.Write(40, 40, &ReadyToRead));
+    ASSERT_EQ((uint32_t)DEF_TEST_BUFFER_LENGTH, RecvBuf.RecvBuf.AllocBufferLength);
+    ASSERT_EQ(0u, RecvBuf.RecvBuf.BufferStart);
+
+    BufferCount = ARRAYSIZE(Buffers);
+    ASSERT_EQ(60ull, RecvBuf.Read(&BufferCount, Buffers));
+    ASSERT_EQ(ReadBuffer, Buffers[0].Buffer);
+    ASSERT_TRUE(RecvBuf.Drain(60));
+}
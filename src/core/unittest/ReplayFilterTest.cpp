@@ -0,0 +1,147 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_REPLAY_FILTER interface.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "ReplayFilterTest.cpp.clog.h"
+#endif
+
+#define TEST_FILTER_SIZE    (64 * 1024)
+#define TEST_WINDOW_MS      30000
+#define TEST_EPOCH_MS       1600000000000ull
+
+struct ReplayFilter {
+    QUIC_REPLAY_FILTER State;
+    uint64_t NowEpochMs {TEST_EPOCH_MS};
+    uint64_t NowMs {1000000};
+    ReplayFilter(
+        _In_ uint32_t FilterSize = TEST_FILTER_SIZE,
+        _In_ uint32_t WindowMs = TEST_WINDOW_MS
+        ) {
+        QuicReplayFilterInitialize(&State);
+        QuicReplayFilterConfigure(&State, FilterSize, WindowMs);
+    }
+    ~ReplayFilter() {
+        QuicReplayFilterUninitialize(&State);
+    }
+    bool Check(
+        _In_ uint64_t Nonce,
+        _In_ uint64_t IssueTimeMs = TEST_EPOCH_MS
+        ) {
+        uint8_t Identity[QUIC_TICKET_IDENTITY_LENGTH];
+        CxPlatCopyMemory(Identity, &IssueTimeMs, sizeof(IssueTimeMs));
+        CxPlatCopyMemory(Identity + sizeof(IssueTimeMs), &Nonce, sizeof(Nonce));
+        return
+            QuicReplayFilterCheck(
+                &State,
+                Identity,
+                NowEpochMs,
+                NowMs) != FALSE;
+    }
+};
+
+TEST(ReplayFilterTest, DisabledAcceptsAll)
+{
+    ReplayFilter Filter(0);
+    ASSERT_TRUE(Filter.Check(1));
+    ASSERT_TRUE(Filter.Check(1));
+    ASSERT_TRUE(Filter.Check(1, 0));
+}
+
+TEST(ReplayFilterTest, RejectReplay)
+{
+    ReplayFilter Filter;
+    ASSERT_TRUE(Filter.Check(1));
+    ASSERT_FALSE(Filter.Check(1));
+    ASSERT_TRUE(Filter.Check(2));
+    ASSERT_FALSE(Filter.Check(2));
+
+    //
+    // Same nonce, but a different ticket.
+    //
+    ASSERT_TRUE(Filter.Check(1, TEST_EPOCH_MS - 1));
+}
+
+TEST(ReplayFilterTest, RejectOutsideWindow)
+{
+    ReplayFilter Filter;
+    ASSERT_FALSE(Filter.Check(1, TEST_EPOCH_MS - TEST_WINDOW_MS - 1));
+    ASSERT_FALSE(Filter.Check(2, TEST_EPOCH_MS + TEST_WINDOW_MS + 1));
+    ASSERT_TRUE(Filter.Check(3, TEST_EPOCH_MS - TEST_WINDOW_MS));
+    ASSERT_TRUE(Filter.Check(4, TEST_EPOCH_MS + TEST_WINDOW_MS));
+}
+
+TEST(ReplayFilterTest, RememberForWholeWindow)
+{
+    ReplayFilter Filter;
+    ASSERT_TRUE(Filter.Check(1));
+
+    //
+    // The ticket is remembered for as long as it is within the window, even
+    // as old buckets are cleared and reused.
+    //
+    for (uint32_t i = 0; i < TEST_WINDOW_MS; i += TEST_WINDOW_MS / 10) {
+        Filter.NowMs += TEST_WINDOW_MS / 10;
+        Filter.NowEpochMs += TEST_WINDOW_MS / 10;
+        ASSERT_TRUE(Filter.Check(100 + i, Filter.NowEpochMs));
+        ASSERT_FALSE(Filter.Check(1));
+    }
+
+    //
+    // After which it's rejected for being too old anyway.
+    //
+    Filter.NowMs += TEST_WINDOW_MS;
+    Filter.NowEpochMs += TEST_WINDOW_MS;
+    ASSERT_FALSE(Filter.Check(1));
+}
+
+TEST(ReplayFilterTest, ForgetAfterWindow)
+{
+    ReplayFilter Filter;
+    ASSERT_TRUE(Filter.Check(1));
+
+    //
+    // With the wall clock standing still, the ticket is still in the window,
+    // but the filter no longer remembers it. Memory use stays bounded.
+    //
+    Filter.NowMs += 2 * TEST_WINDOW_MS;
+    ASSERT_TRUE(Filter.Check(1));
+    ASSERT_FALSE(Filter.Check(1));
+}
+
+TEST(ReplayFilterTest, FalsePositiveRate)
+{
+    const uint64_t Count = 2000;
+    ReplayFilter Filter;
+    for (uint64_t i = 0; i < Count; ++i) {
+        (void)Filter.Check(i);
+    }
+
+    uint64_t FalsePositives = 0;
+    for (uint64_t i = Count; i < 2 * Count; ++i) {
+        if (!Filter.Check(i)) {
+            ++FalsePositives;
+        }
+    }
+    ASSERT_LT(FalsePositives, Count / 100);
+}
+
+TEST(ReplayFilterTest, ReconfigureClears)
+{
+    ReplayFilter Filter;
+    ASSERT_TRUE(Filter.Check(1));
+    QuicReplayFilterConfigure(&Filter.State, 2 * TEST_FILTER_SIZE, TEST_WINDOW_MS);
+    ASSERT_TRUE(Filter.Check(1));
+    ASSERT_FALSE(Filter.Check(1));
+
+    QuicReplayFilterConfigure(&Filter.State, 0, TEST_WINDOW_MS);
+    ASSERT_TRUE(Filter.Check(1));
+}
@@ -0,0 +1,185 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Unit test for the QUIC_STREAM_SET per-type stream windows.
+
+--*/
+
+#include "main.h"
+#ifdef QUIC_CLOG
+#include "StreamSetTest.cpp.clog.h"
+#endif
+
+#define TEST_STREAM_COUNT 16
+
+//
+// Holds a client connection's stream set along with some locally opened
+// (client, bidirectional) streams. Only the fields the stream set looks at
+// are filled in.
+//
+struct StreamSet {
+    QUIC_CONNECTION* Connection;
+    QUIC_STREAM* Streams;
+    QUIC_STREAM_SET* Set;
+    QUIC_STREAM_TYPE_INFO* Info;
+    StreamSet() {
+        Connection = (QUIC_CONNECTION*)new uint8_t[sizeof(QUIC_CONNECTION)]();
+        ((QUIC_HANDLE*)Connection)->Type = QUIC_HANDLE_TYPE_CONNECTION_CLIENT;
+        Streams = (QUIC_STREAM*)new uint8_t[TEST_STREAM_COUNT * sizeof(QUIC_STREAM)]();
+        Set = &Connection->Streams;
+        Info = &Set->Types[STREAM_ID_FLAG_IS_CLIENT | STREAM_ID_FLAG_IS_BI_DIR];
+        QuicStreamSetInitialize(Set);
+    }
+    ~StreamSet() {
+        QuicStreamSetUninitialize(Set);
+        delete [] (uint8_t*)Streams;
+        delete [] (uint8_t*)Connection;
+    }
+    //
+    // Opens the given stream with the given stream count (ID >> 2).
+    //
+    bool Insert(uint32_t i, uint64_t Index) {
+        Streams[i].ID = Index << 2;
+        Streams[i].Connection = Connection;
+        if (!QuicStreamSetInsertStream(Set, &Streams[i])) {
+            return false;
+        }
+        Info->CurrentStreamCount++;
+        if (Info->TotalStreamCount <= Index) {
+            Info->TotalStreamCount = Index + 1;
+        }
+        return true;
+    }
+    void Release(uint32_t i) {
+        QuicStreamSetReleaseStream(Set, &Streams[i]);
+        CxPlatListEntryRemove(&Streams[i].ClosedLink);
+    }
+    QUIC_STREAM* Lookup(uint64_t Index) {
+        return QuicStreamSetLookupStream(Set, Index << 2);
+    }
+    uint32_t Enumerate() {
+        uint32_t Count = 0;
+        QUIC_STREAM_SET_ENUMERATOR Enumerator;
+        QuicStreamSetEnumerateBegin(Set, &Enumerator);
+        while (QuicStreamSetEnumerateNext(Set, &Enumerator) != NULL) {
+            Count++;
+        }
+        QuicStreamSetEnumerateEnd(Set, &Enumerator);
+        return Count;
+    }
+};
+
+TEST(StreamSetTest, WindowSlides)
+{
+    StreamSet Set;
+    for (uint32_t i = 0; i < QUIC_STREAM_WINDOW_INITIAL_SIZE; ++i) {
+        ASSERT_TRUE(Set.Insert(i, i));
+    }
+    ASSERT_EQ((uint32_t)QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Info->WindowSize);
+    ASSERT_EQ(0ull, Set.Info->WindowBase);
+
+    //
+    // Releasing the oldest streams moves the window forward, so the next
+    // streams reuse their slots instead of growing the window.
+    //
+    for (uint32_t i = 0; i < QUIC_STREAM_WINDOW_INITIAL_SIZE / 2; ++i) {
+        Set.Release(i);
+        ASSERT_EQ(nullptr, Set.Lookup(i));
+    }
+    ASSERT_EQ((uint64_t)QUIC_STREAM_WINDOW_INITIAL_SIZE / 2, Set.Info->WindowBase);
+
+    for (uint32_t i = 0; i < QUIC_STREAM_WINDOW_INITIAL_SIZE / 2; ++i) {
+        ASSERT_TRUE(Set.Insert(i, QUIC_STREAM_WINDOW_INITIAL_SIZE + i));
+    }
+    ASSERT_EQ((uint32_t)QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Info->WindowSize);
+    ASSERT_EQ(nullptr, Set.Set->StreamTable);
+
+    for (uint32_t i = 0; i < QUIC_STREAM_WINDOW_INITIAL_SIZE; ++i) {
+        ASSERT_EQ(&Set.Streams[i], Set.Lookup(Set.Streams[i].ID >> 2));
+    }
+    ASSERT_EQ((uint32_t)QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Enumerate());
+
+    //
+    // A stream released out of order leaves a hole but doesn't move the
+    // window until everything before it is released too.
+    //
+    Set.Release(6);
+    ASSERT_EQ((uint64_t)QUIC_STREAM_WINDOW_INITIAL_SIZE / 2, Set.Info->WindowBase);
+    ASSERT_EQ(nullptr, Set.Lookup(6));
+    Set.Release(4);
+    Set.Release(5);
+    ASSERT_EQ(7ull, Set.Info->WindowBase);
+    ASSERT_EQ(&Set.Streams[7], Set.Lookup(7));
+}
+
+TEST(StreamSetTest, WindowGrowsToMax)
+{
+    StreamSet Set;
+    ASSERT_TRUE(Set.Insert(0, 0));
+    ASSERT_TRUE(Set.Insert(1, QUIC_STREAM_WINDOW_INITIAL_SIZE));
+    ASSERT_EQ(2u * QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Info->WindowSize);
+
+    //
+    // While the oldest stream is still open, the window grows to cover the
+    // newest one, up to the max.
+    //
+    ASSERT_TRUE(Set.Insert(2, QUIC_STREAM_WINDOW_MAX_SIZE - 1));
+    ASSERT_EQ((uint32_t)QUIC_STREAM_WINDOW_MAX_SIZE, Set.Info->WindowSize);
+    ASSERT_EQ(0ull, Set.Info->WindowBase);
+    ASSERT_EQ(nullptr, Set.Set->StreamTable);
+
+    ASSERT_EQ(&Set.Streams[0], Set.Lookup(0));
+    ASSERT_EQ(&Set.Streams[1], Set.Lookup(QUIC_STREAM_WINDOW_INITIAL_SIZE));
+    ASSERT_EQ(&Set.Streams[2], Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE - 1));
+    ASSERT_EQ(nullptr, Set.Lookup(1));
+    ASSERT_EQ(3u, Set.Enumerate());
+
+    //
+    // Releasing the oldest stream slides the window up to the next open one.
+    //
+    Set.Release(0);
+    ASSERT_EQ((uint64_t)QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Info->WindowBase);
+    ASSERT_EQ(2u, Set.Enumerate());
+}
+
+TEST(StreamSetTest, HashTableFallback)
+{
+    StreamSet Set;
+    ASSERT_TRUE(Set.Insert(0, 0));
+    ASSERT_TRUE(Set.Insert(1, 1));
+
+    //
+    // A stream too far ahead of the oldest open one to fit in a max size
+    // window goes in the hash table instead.
+    //
+    ASSERT_TRUE(Set.Insert(2, QUIC_STREAM_WINDOW_MAX_SIZE));
+    ASSERT_NE(nullptr, Set.Set->StreamTable);
+    ASSERT_EQ((uint32_t)QUIC_STREAM_WINDOW_INITIAL_SIZE, Set.Info->WindowSize);
+    ASSERT_EQ(0ull, Set.Info->WindowBase);
+
+    ASSERT_EQ(&Set.Streams[0], Set.Lookup(0));
+    ASSERT_EQ(&Set.Streams[1], Set.Lookup(1));
+    ASSERT_EQ(&Set.Streams[2], Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE));
+    ASSERT_EQ(3u, Set.Enumerate());
+
+    //
+    // Once the old streams are gone, newer streams go back in the window,
+    // while the one in the hash table stays there until released.
+    //
+    Set.Release(0);
+    Set.Release(1);
+    ASSERT_TRUE(Set.Insert(3, QUIC_STREAM_WINDOW_MAX_SIZE + 1));
+    ASSERT_EQ((uint64_t)QUIC_STREAM_WINDOW_MAX_SIZE + 1, Set.Info->WindowBase);
+    ASSERT_EQ(&Set.Streams[3], Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE + 1));
+    ASSERT_EQ(&Set.Streams[2], Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE));
+    ASSERT_EQ(2u, Set.Enumerate());
+
+    Set.Release(2);
+    ASSERT_EQ(nullptr, Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE));
+    ASSERT_EQ(&Set.Streams[3], Set.Lookup(QUIC_STREAM_WINDOW_MAX_SIZE + 1));
+    ASSERT_EQ(1u, Set.Enumerate());
+}
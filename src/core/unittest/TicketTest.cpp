@@ -512,7 +512,32 @@ TEST(ResumptionTicketTest, ServerEncDec)
     ASSERT_TRUE(memcmp(AppData, DecodedAppData, sizeof(AppData)) == 0);
     CompareTransportParameters(&ServerTP, &DecodedTP);
 
+    //
+    // Every ticket gets a unique identity, even with the same contents.
+    //
+    uint8_t* EncodedServerTicket2 = nullptr;
+    uint32_t EncodedServerTicketLength2 = 0;
+    TEST_QUIC_SUCCEEDED(
+        QuicCryptoEncodeServerTicket(
+            nullptr,
+            QUIC_VERSION_LATEST,
+            sizeof(AppData),
+            AppData,
+            &ServerTP,
+            NegotiatedAlpn[0],
+            NegotiatedAlpn + 1,
+            &EncodedServerTicket2,
+            &EncodedServerTicketLength2));
+    ASSERT_EQ(EncodedServerTicketLength, EncodedServerTicketLength2);
+    ASSERT_NE(
+        0,
+        memcmp(
+            EncodedServerTicket + EncodedServerTicketLength - QUIC_TICKET_IDENTITY_LENGTH,
+            EncodedServerTicket2 + EncodedServerTicketLength2 - QUIC_TICKET_IDENTITY_LENGTH,
+            QUIC_TICKET_IDENTITY_LENGTH));
+
     CXPLAT_FREE(EncodedServerTicket, QUIC_POOL_SERVER_CRYPTO_TICKET);
+    CXPLAT_FREE(EncodedServerTicket2, QUIC_POOL_SERVER_CRYPTO_TICKET);
 }
 
 TEST(ResumptionTicketTest, ServerEncDecNoAppData)
@@ -584,7 +609,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     const uint8_t* DecodedAppData = nullptr;
     uint32_t DecodedAppDataLength = 0;
 
-    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData)] = {
+    uint8_t InputTicketBuffer[8 + TransportParametersLength + sizeof(Alpn) + sizeof(AppData) + QUIC_TICKET_IDENTITY_LENGTH] = {
         CXPLAT_TLS_RESUMPTION_TICKET_VERSION,
         0,0,0,1,                    // QUIC version
         4,                          // ALPN length
@@ -639,7 +664,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
     TEST_QUIC_SUCCEEDED(
         QuicCryptoDecodeServerTicket(
             nullptr,
-            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData),
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_TICKET_IDENTITY_LENGTH,
             InputTicketBuffer,
             AlpnList,
             sizeof(AlpnList),
@@ -801,13 +826,37 @@ TEST(ResumptionTicketTest, ServerDecFail)
             &DecodedAppData,
             &DecodedAppDataLength));
 
+    // Not enough room for the ticket identity
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicCryptoDecodeServerTicket(
+            nullptr,
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData),
+            InputTicketBuffer,
+            AlpnList,
+            sizeof(AlpnList),
+            &DecodedTP,
+            &DecodedAppData,
+            &DecodedAppDataLength));
+    ASSERT_EQ(
+        QUIC_STATUS_INVALID_PARAMETER,
+        QuicCryptoDecodeServerTicket(
+            nullptr,
+            8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_TICKET_IDENTITY_LENGTH - 1,
+            InputTicketBuffer,
+            AlpnList,
+            sizeof(AlpnList),
+            &DecodedTP,
+            &DecodedAppData,
+            &DecodedAppDataLength));
+
     //
     // Invalidate some of the fields of the ticket to ensure
     // decoding fails
     //
 
     const uint16_t ActualEncodedTicketLength =
-        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData);
+        8 + (uint16_t)sizeof(Alpn) + (uint16_t)(EncodedTPLength - CxPlatTlsTPHeaderSize) + (uint16_t)sizeof(AppData) + QUIC_TICKET_IDENTITY_LENGTH;
 
     // Incorrect ticket version
     InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_TICKET_VERSION + 1;
@@ -822,7 +871,7 @@ TEST(ResumptionTicketTest, ServerDecFail)
             &DecodedTP,
             &DecodedAppData,
             &DecodedAppDataLength));
-    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_CLIENT_TICKET_VERSION;
+    InputTicketBuffer[0] = CXPLAT_TLS_RESUMPTION_TICKET_VERSION;
 
     // Unsupported QUIC version
     InputTicketBuffer[1] = 1;
@@ -55,12 +55,14 @@ QuicWorkerInitialize(
 
     Worker->Enabled = TRUE;
     Worker->IdealProcessor = IdealProcessor;
+    Worker->Stats.StartTime = CxPlatTimeUs64();
+    Worker->Stats.LastActiveTime = Worker->Stats.StartTime;
     CxPlatDispatchLockInitialize(&Worker->Lock);
     CxPlatEventInitialize(&Worker->Ready, FALSE, FALSE);
     CxPlatListInitializeHead(&Worker->Connections);
     CxPlatListInitializeHead(&Worker->Operations);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_STREAM), QUIC_POOL_STREAM, &Worker->StreamPool);
-    CxPlatPoolInitialize(FALSE, QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE, QUIC_POOL_SBUF, &Worker->DefaultReceiveBufferPool);
+    CxPlatPoolInitialize(FALSE, sizeof(QUIC_RECV_CHUNK) + QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE, QUIC_POOL_SBUF, &Worker->DefaultReceiveBufferPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_SEND_REQUEST), QUIC_POOL_SEND_REQUEST, &Worker->SendRequestPool);
     QuicSentPacketPoolInitialize(&Worker->SentPacketPool);
     CxPlatPoolInitialize(FALSE, sizeof(QUIC_API_CONTEXT), QUIC_POOL_API_CTX, &Worker->ApiContextPool);
@@ -153,7 +155,11 @@ QuicWorkerAssignConnection(
     )
 {
     CXPLAT_DBG_ASSERT(Connection->Worker != Worker);
+    if (Connection->Worker != NULL) {
+        InterlockedDecrement(&Connection->Worker->ConnectionCount);
+    }
     Connection->Worker = Worker;
+    InterlockedIncrement(&Worker->ConnectionCount);
     QuicTraceEvent(
         ConnAssignWorker,
         "[conn][%p] Assigned worker: %p",
@@ -194,6 +200,7 @@ QuicWorkerQueueConnection(
             QUIC_SCHEDULE_QUEUED);
         QuicConnAddRef(Connection, QUIC_CONN_REF_WORKER);
         CxPlatListInsertTail(&Worker->Connections, &Connection->WorkerLink);
+        Worker->ConnectionQueueDepth++;
         ConnectionQueued = TRUE;
     } else {
         WakeWorkerThread = FALSE;
@@ -234,6 +241,7 @@ QuicWorkerMoveConnection(
             QUIC_SCHEDULE_QUEUED);
         QuicConnAddRef(Connection, QUIC_CONN_REF_WORKER);
         CxPlatListInsertTail(&Worker->Connections, &Connection->WorkerLink);
+        Worker->ConnectionQueueDepth++;
     }
 
     CxPlatDispatchLockRelease(&Worker->Lock);
@@ -292,6 +300,13 @@ QuicWorkerToggleActivityState(
     )
 {
     Worker->IsActive = !Worker->IsActive;
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    if (Worker->IsActive) {
+        Worker->Stats.LastActiveTime = TimeNow;
+    } else {
+        Worker->Stats.ActiveTime +=
+            CxPlatTimeDiff64(Worker->Stats.LastActiveTime, TimeNow);
+    }
     QuicTraceEvent(
         WorkerActivityStateUpdated,
         "[wrkr][%p] IsActive = %hhu, Arg = %u",
@@ -308,6 +323,7 @@ QuicWorkerUpdateQueueDelay(
     )
 {
     Worker->AverageQueueDelay = (7 * Worker->AverageQueueDelay + TimeInQueueUs) / 8;
+    QuicLatencyHistogramRecord(QUIC_LATENCY_HISTOGRAM_WORKER_QUEUE_DELAY, TimeInQueueUs);
     QuicTraceEvent(
         WorkerQueueDelayUpdated,
         "[wrkr][%p] QueueDelay = %u",
@@ -350,6 +366,7 @@ QuicWorkerGetNextConnection(
             CXPLAT_DBG_ASSERT(Connection->HasQueuedWork);
             Connection->HasQueuedWork = FALSE;
             Connection->WorkerProcessing = TRUE;
+            Worker->ConnectionQueueDepth--;
             QuicPerfCounterDecrement(QUIC_PERF_COUNTER_CONN_QUEUE_DEPTH);
         }
 
@@ -422,7 +439,11 @@ QuicWorkerProcessTimers(
         QuicConnTimerExpired(Connection, TimeNow);
         QuicConfigurationDetachSilo();
         Connection->WorkerThreadID = 0;
+        Worker->Stats.TimerExpirations++;
     }
+
+    Worker->Stats.TimerTicks++;
+    Worker->Stats.TimerTime += CxPlatTimeDiff64(TimeNow, CxPlatTimeUs64());
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -440,11 +461,14 @@ QuicWorkerProcessConnection(
     QuicConfigurationAttachSilo(Connection->Configuration);
 
     if (Connection->Stats.Schedule.LastQueueTime != 0) {
-        QuicWorkerUpdateQueueDelay(
-            Worker,
+        const uint32_t TimeInQueueUs =
             CxPlatTimeDiff32(
                 Connection->Stats.Schedule.LastQueueTime,
-                CxPlatTimeUs32()));
+                CxPlatTimeUs32());
+        QuicWorkerUpdateQueueDelay(Worker, TimeInQueueUs);
+        if (!Connection->State.HandshakeConfirmed) {
+            Connection->Stats.HandshakeTiming.QueueWait += TimeInQueueUs;
+        }
     }
 
     //
@@ -484,8 +508,11 @@ QuicWorkerProcessConnection(
     //
     // Process some operations.
     //
+    const uint64_t OperationCount = Connection->Stats.Schedule.OperationCount;
     BOOLEAN StillHasWorkToDo =
         QuicConnDrainOperations(Connection) | Connection->State.UpdateWorker;
+    Worker->Stats.ConnectionOperations +=
+        Connection->Stats.Schedule.OperationCount - OperationCount;
     Connection->WorkerThreadID = 0;
 
     //
@@ -500,6 +527,7 @@ QuicWorkerProcessConnection(
         if (Connection->HasQueuedWork) {
             Connection->Stats.Schedule.LastQueueTime = CxPlatTimeUs32();
             CxPlatListInsertTail(&Worker->Connections, &Connection->WorkerLink);
+            Worker->ConnectionQueueDepth++;
             QuicTraceEvent(
                 ConnScheduleState,
                 "[conn][%p] Scheduling: %u",
@@ -582,6 +610,7 @@ CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
                 Operation->Type,
                 Operation->STATELESS.Context);
             QuicOperationFree(Worker, Operation);
+            Worker->Stats.StatelessOperations++;
             QuicPerfCounterIncrement(QUIC_PERF_COUNTER_WORK_OPER_COMPLETED);
         }
 
@@ -671,6 +700,7 @@ CXPLAT_THREAD_CALLBACK(QuicWorkerThread, Context)
         QuicConnRelease(Connection, QUIC_CONN_REF_WORKER);
         --Dequeue;
     }
+    Worker->ConnectionQueueDepth = 0;
     QuicPerfCounterAdd(QUIC_PERF_COUNTER_CONN_QUEUE_DEPTH, Dequeue);
 
     Dequeue = 0;
@@ -762,6 +792,45 @@ QuicWorkerPoolUninitialize(
     CXPLAT_FREE(WorkerPool, QUIC_POOL_WORKER);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerPoolGetStatistics(
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _Out_writes_(WorkerPool->WorkerCount) QUIC_WORKER_STATISTICS* Stats
+    )
+{
+    const uint64_t TimeNow = CxPlatTimeUs64();
+    for (uint16_t i = 0; i < WorkerPool->WorkerCount; ++i) {
+        QUIC_WORKER* Worker = &WorkerPool->Workers[i];
+        CxPlatZeroMemory(&Stats[i], sizeof(Stats[i]));
+
+        CxPlatDispatchLockAcquire(&Worker->Lock);
+        Stats[i].ConnectionQueueDepth = Worker->ConnectionQueueDepth;
+        Stats[i].OperationQueueDepth = Worker->OperationCount;
+        Stats[i].DroppedOperations = Worker->DroppedOperationCount;
+        CxPlatDispatchLockRelease(&Worker->Lock);
+
+        //
+        // The rest are only written by the worker thread, so these reads may
+        // be slightly stale, which is fine for statistics.
+        //
+        Stats[i].IdealProcessor = Worker->IdealProcessor;
+        Stats[i].AverageQueueDelayUs = Worker->AverageQueueDelay;
+        Stats[i].ConnectionCount = (uint32_t)Worker->ConnectionCount;
+        Stats[i].ConnectionOperations = Worker->Stats.ConnectionOperations;
+        Stats[i].StatelessOperations = Worker->Stats.StatelessOperations;
+        Stats[i].ActiveTimeUs = Worker->Stats.ActiveTime;
+        if (Worker->IsActive) {
+            Stats[i].ActiveTimeUs +=
+                CxPlatTimeDiff64(Worker->Stats.LastActiveTime, TimeNow);
+        }
+        Stats[i].TotalTimeUs = CxPlatTimeDiff64(Worker->Stats.StartTime, TimeNow);
+        Stats[i].TimerTicks = Worker->Stats.TimerTicks;
+        Stats[i].TimerExpirations = Worker->Stats.TimerExpirations;
+        Stats[i].TimerTimeUs = Worker->Stats.TimerTime;
+    }
+}
+
 _IRQL_requires_max_(DISPATCH_LEVEL)
 BOOLEAN
 QuicWorkerPoolIsOverloaded(
@@ -40,6 +40,25 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     //
     uint32_t AverageQueueDelay;
 
+    //
+    // The number of connections currently assigned to the worker.
+    //
+    long ConnectionCount;
+
+    //
+    // Statistics, only updated by the worker thread.
+    //
+    struct {
+        uint64_t ConnectionOperations;
+        uint64_t StatelessOperations;
+        uint64_t StartTime;         // When the thread started, in microseconds.
+        uint64_t ActiveTime;        // Time spent active, up to LastActiveTime.
+        uint64_t LastActiveTime;    // When the worker last became active.
+        uint64_t TimerTicks;        // Times expired timers were processed.
+        uint64_t TimerExpirations;  // Connections indicated an expired timer.
+        uint64_t TimerTime;         // Time spent processing expired timers.
+    } Stats;
+
     //
     // Timers for the worker's connections.
     //
@@ -59,6 +78,7 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     // Queue of connections with operations to be processed.
     //
     CXPLAT_LIST_ENTRY Connections;
+    uint32_t ConnectionQueueDepth;
 
     //
     // Queue of stateless operations to be processed.
@@ -68,7 +88,7 @@ typedef struct QUIC_CACHEALIGN QUIC_WORKER {
     uint64_t DroppedOperationCount;
 
     CXPLAT_POOL StreamPool; // QUIC_STREAM
-    CXPLAT_POOL DefaultReceiveBufferPool; // QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
+    CXPLAT_POOL DefaultReceiveBufferPool; // QUIC_RECV_CHUNK + QUIC_DEFAULT_STREAM_RECV_BUFFER_SIZE
     CXPLAT_POOL SendRequestPool; // QUIC_SEND_REQUEST
     QUIC_SENT_PACKET_POOL SentPacketPool; // QUIC_SENT_PACKET_METADATA
     CXPLAT_POOL ApiContextPool; // QUIC_API_CONTEXT
@@ -114,6 +134,16 @@ QuicWorkerIsOverloaded(
     return Worker->AverageQueueDelay > MsQuicLib.Settings.MaxWorkerQueueDelayUs;
 }
 
+//
+// Fills in the statistics of all the workers in the pool.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+QuicWorkerPoolGetStatistics(
+    _In_ QUIC_WORKER_POOL* WorkerPool,
+    _Out_writes_(WorkerPool->WorkerCount) QUIC_WORKER_STATISTICS* Stats
+    );
+
 //
 // Initializes the worker pool.
 //
@@ -182,6 +182,7 @@ typedef enum QUIC_SEND_FLAGS {
     QUIC_SEND_FLAG_FIN                      = 0x0004,   // Indicates the request is the one last sent on the stream.
     QUIC_SEND_FLAG_DGRAM_PRIORITY           = 0x0008,   // Indicates the datagram is higher priority than others.
     QUIC_SEND_FLAG_DELAY_SEND               = 0x0010,   // Indicates the send should be delayed because more will be queued soon.
+    QUIC_SEND_FLAG_NO_BUFFERING             = 0x0020,   // Bypasses send buffering; buffers are held until SEND_COMPLETE.
 } QUIC_SEND_FLAGS;
 
 DEFINE_ENUM_FLAG_OPERATORS(QUIC_SEND_FLAGS)
@@ -388,6 +389,24 @@ typedef struct QUIC_STATISTICS {
     } Misc;
 } QUIC_STATISTICS;
 
+//
+// QUIC_STATISTICS plus a breakdown of where the handshake's time went. All
+// times are in microseconds, and are only accumulated until the handshake is
+// confirmed.
+//
+typedef struct QUIC_STATISTICS_V2 {
+    QUIC_STATISTICS V1;
+    struct {
+        uint64_t TlsProcessTime;            // In inline TLS processing; includes key derivation, signing and cert validation done by TLS
+        uint64_t TlsOffloadTime;            // Waiting for TLS processing offloaded to the crypto threads
+        uint64_t CertValidationTime;        // In the app's peer certificate validation; also counted in TlsProcessTime
+        uint64_t KeyDeriveTime;             // Deriving the Initial packet keys; TLS derives the others
+        uint64_t QueueWaitTime;             // Waiting in the worker's queue
+        uint64_t PacingBlockedTime;         // Sends blocked by pacing
+        uint64_t AmplificationBlockedTime;  // Sends blocked by the anti-amplification limit
+    } HandshakeTiming;
+} QUIC_STATISTICS_V2;
+
 typedef struct QUIC_LISTENER_STATISTICS {
 
     uint64_t TotalAcceptedConnections;
@@ -400,6 +419,41 @@ typedef struct QUIC_LISTENER_STATISTICS {
     } Binding;
 } QUIC_LISTENER_STATISTICS;
 
+typedef struct QUIC_WORKER_STATISTICS {
+    uint16_t IdealProcessor;
+    uint32_t AverageQueueDelayUs;           // Moving average of the time connections wait in the queue.
+    uint32_t ConnectionQueueDepth;          // Connections currently queued for processing.
+    uint32_t OperationQueueDepth;           // Stateless operations currently queued.
+    uint32_t ConnectionCount;               // Connections currently owned by the worker.
+    uint64_t ConnectionOperations;          // Total connection operations processed.
+    uint64_t StatelessOperations;           // Total stateless operations processed.
+    uint64_t DroppedOperations;             // Total stateless operations dropped because the queue was full.
+    uint64_t ActiveTimeUs;                  // Total time spent processing, instead of waiting for work.
+    uint64_t TotalTimeUs;                   // Total time since the worker started.
+    uint64_t TimerTicks;                    // Total times expired timers were processed.
+    uint64_t TimerExpirations;              // Total connections indicated an expired timer.
+    uint64_t TimerTimeUs;                   // Total time spent processing expired timers.
+} QUIC_WORKER_STATISTICS;
+
+typedef struct QUIC_BINDING_STATISTICS {
+    QUIC_ADDR LocalAddress;
+    QUIC_ADDR RemoteAddress;                // Only set if Connected.
+    uint8_t Exclusive;                      // Owned by a single connection.
+    uint8_t ServerOwned;                    // Used by listeners and server connections.
+    uint8_t Connected;                      // Only receives from a single remote address.
+    struct {
+        uint64_t Datagrams;                 // Total UDP datagrams received.
+        uint64_t Bytes;                     // Total UDP payload bytes received.
+        uint64_t DroppedPackets;            // Total packets dropped by the binding.
+    } Recv;
+    struct {
+        uint64_t VersionNegotiation;        // Total version negotiation packets sent.
+        uint64_t StatelessReset;            // Total stateless reset packets sent.
+        uint64_t Retry;                     // Total retry packets sent.
+        uint64_t DroppedOperations;         // Total stateless responses not sent because of limits.
+    } Stateless;
+} QUIC_BINDING_STATISTICS;
+
 typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_CONN_CREATED,         // Total connections ever allocated.
     QUIC_PERF_COUNTER_CONN_HANDSHAKE_FAIL,  // Total connections that failed during handshake.
@@ -428,9 +482,38 @@ typedef enum QUIC_PERFORMANCE_COUNTERS {
     QUIC_PERF_COUNTER_WORK_OPER_QUEUE_DEPTH,// Current worker operations queued.
     QUIC_PERF_COUNTER_WORK_OPER_QUEUED,     // Total worker operations queued ever.
     QUIC_PERF_COUNTER_WORK_OPER_COMPLETED,  // Total worker operations processed ever.
+    QUIC_PERF_COUNTER_CONN_ADMIT_RETRY,     // Total connection attempts sent a Retry by admission control.
+    QUIC_PERF_COUNTER_CONN_ADMIT_LIMITED,   // Total connection attempts dropped by per-prefix rate limits.
+    QUIC_PERF_COUNTER_CONN_ADMIT_DROPPED,   // Total unvalidated connection attempts dropped by admission control.
+    QUIC_PERF_COUNTER_CONN_0RTT_REPLAY_REJECT, // Total 0-RTT attempts rejected by the anti-replay filter.
     QUIC_PERF_COUNTER_MAX,
 } QUIC_PERFORMANCE_COUNTERS;
 
+typedef enum QUIC_LATENCY_HISTOGRAM_TYPE {
+    QUIC_LATENCY_HISTOGRAM_WORKER_QUEUE_DELAY,  // Time connections wait in a worker's queue.
+    QUIC_LATENCY_HISTOGRAM_OPER_PROCESSING,     // Time to process a single connection operation.
+    QUIC_LATENCY_HISTOGRAM_SEND_FLUSH,          // Time to build and send packets in one send flush.
+    QUIC_LATENCY_HISTOGRAM_RTT,                 // Connection RTT samples.
+    QUIC_LATENCY_HISTOGRAM_HANDSHAKE,           // Time from connection start to handshake completion.
+    QUIC_LATENCY_HISTOGRAM_MAX,
+} QUIC_LATENCY_HISTOGRAM_TYPE;
+
+//
+// Latency histograms have log-linear buckets of microsecond values. Values
+// below 16 each have their own bucket. Above that, each power of two range is
+// split into 8 equally sized buckets, so a bucket is at most 12.5% wider than
+// its lower bound. Values of 2^32 us (over an hour) or more are counted in the
+// last bucket.
+//
+#define QUIC_LATENCY_HISTOGRAM_SUB_BUCKET_BITS  3
+#define QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT     240
+
+typedef struct QUIC_LATENCY_HISTOGRAM {
+    uint64_t Count;                                         // Total samples.
+    uint64_t Sum;                                           // Sum of all samples (us).
+    uint64_t Buckets[QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT];  // Samples per bucket.
+} QUIC_LATENCY_HISTOGRAM;
+
 typedef struct QUIC_SETTINGS {
 
     union {
@@ -464,7 +547,12 @@ typedef struct QUIC_SETTINGS {
             uint64_t ServerResumptionLevel          : 1;
             uint64_t DesiredVersionsList            : 1;
             uint64_t VersionNegotiationExtEnabled   : 1;
-            uint64_t RESERVED                       : 36;
+            uint64_t StreamRecvInPlaceEnabled       : 1;
+            uint64_t TlsOffloadEnabled              : 1;
+            uint64_t AdmissionInitialRate           : 1;
+            uint64_t ZeroRttReplayFilterSize        : 1;
+            uint64_t ZeroRttReplayWindowMs          : 1;
+            uint64_t RESERVED                       : 31;
         } IsSet;
     };
 
@@ -495,9 +583,13 @@ typedef struct QUIC_SETTINGS {
     uint8_t DatagramReceiveEnabled          : 1;
     uint8_t ServerResumptionLevel           : 2;    // QUIC_SERVER_RESUMPTION_LEVEL
     uint8_t VersionNegotiationExtEnabled    : 1;
-    uint8_t RESERVED                        : 1;
+    uint8_t StreamRecvInPlaceEnabled        : 1;
+    uint8_t TlsOffloadEnabled               : 1;
     const uint32_t* DesiredVersionsList;
     uint32_t DesiredVersionsListLength;
+    uint32_t AdmissionInitialRate;          // Global only
+    uint32_t ZeroRttReplayFilterSize;       // Global only
+    uint32_t ZeroRttReplayWindowMs;         // Global only
 
 } QUIC_SETTINGS;
 
@@ -558,11 +650,15 @@ typedef enum QUIC_PARAM_LEVEL {
 #define QUIC_PARAM_GLOBAL_LOAD_BALACING_MODE            2   // uint16_t - QUIC_LOAD_BALANCING_MODE
 #define QUIC_PARAM_GLOBAL_PERF_COUNTERS                 3   // uint64_t[] - Array size is QUIC_PERF_COUNTER_MAX
 #define QUIC_PARAM_GLOBAL_SETTINGS                      4   // QUIC_SETTINGS
+#define QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS            5   // QUIC_LATENCY_HISTOGRAM[] - Array size is QUIC_LATENCY_HISTOGRAM_MAX
+#define QUIC_PARAM_GLOBAL_PROCESSOR_PERF_COUNTERS       6   // int64_t[] - QUIC_PERF_COUNTER_MAX counters per processor
+#define QUIC_PARAM_GLOBAL_BINDING_STATISTICS            7   // QUIC_BINDING_STATISTICS[]
 
 //
 // Parameters for QUIC_PARAM_LEVEL_REGISTRATION.
 //
 #define QUIC_PARAM_REGISTRATION_CID_PREFIX              0   // uint8_t[]
+#define QUIC_PARAM_REGISTRATION_WORKER_STATISTICS       1   // QUIC_WORKER_STATISTICS[]
 
 //
 // Parameters for QUIC_PARAM_LEVEL_CONFIGURATION.
@@ -599,6 +695,7 @@ typedef enum QUIC_PARAM_LEVEL {
 #endif
 #define QUIC_PARAM_CONN_RESUMPTION_TICKET               16  // uint8_t[]
 #define QUIC_PARAM_CONN_PEER_CERTIFICATE_VALID          17  // uint8_t (BOOLEAN)
+#define QUIC_PARAM_CONN_STATISTICS_V2                   18  // QUIC_STATISTICS_V2
 
 //
 // Parameters for QUIC_PARAM_LEVEL_TLS.
@@ -619,6 +716,8 @@ typedef struct QUIC_SCHANNEL_CONTEXT_ATTRIBUTE_W {
 #define QUIC_PARAM_STREAM_ID                            0   // QUIC_UINT62
 #define QUIC_PARAM_STREAM_0RTT_LENGTH                   1   // uint64_t
 #define QUIC_PARAM_STREAM_IDEAL_SEND_BUFFER_SIZE        2   // uint64_t - bytes
+#define QUIC_PARAM_STREAM_PRIORITY                      3   // uint16_t - 0 (low) to 0xFFFF (high) - 0x7FFF (default)
+#define QUIC_PARAM_STREAM_WEIGHT                        4   // uint8_t - 1 to 0xFF - 1 (default)
 
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1127,6 +1226,34 @@ QUIC_STATUS
     _In_opt_ void* ClientSendContext
     );
 
+//
+// A single send in a batch of sends. Status is set on return of the batch
+// call: QUIC_STATUS_PENDING if the send was queued, otherwise the error for
+// that send alone.
+//
+typedef struct QUIC_STREAM_SEND_BATCH_ENTRY {
+    HQUIC Stream;
+    const QUIC_BUFFER* Buffers;
+    uint32_t BufferCount;
+    QUIC_SEND_FLAGS Flags;
+    void* ClientSendContext;
+    QUIC_STATUS Status;
+} QUIC_STREAM_SEND_BATCH_ENTRY;
+
+//
+// Sends data on a set of open streams, all on the same connection, with a
+// single operation queued to the connection. Each entry behaves as a call to
+// StreamSend; streams may be started by the send with QUIC_SEND_FLAG_START.
+//
+typedef
+_IRQL_requires_max_(DISPATCH_LEVEL)
+QUIC_STATUS
+(QUIC_API * QUIC_STREAM_SEND_BATCH_FN)(
+    _Inout_updates_(EntryCount) _Pre_defensive_
+        QUIC_STREAM_SEND_BATCH_ENTRY* Entries,
+    _In_ uint32_t EntryCount
+    );
+
 //
 // Completes a previously pended receive callback.
 //
@@ -1213,6 +1340,8 @@ typedef struct QUIC_API_TABLE {
 
     QUIC_DATAGRAM_SEND_FN               DatagramSend;
 
+    QUIC_STREAM_SEND_BATCH_FN           StreamSendBatch;
+
 } QUIC_API_TABLE;
 
 //
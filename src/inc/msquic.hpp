@@ -229,7 +229,12 @@ public:
         const QUIC_REGISTRATION_CONFIG RegConfig = { AppName, Profile };
         InitStatus = MsQuic->RegistrationOpen(&RegConfig, &Handle);
     }
-    ~MsQuicRegistration() noexcept {
+    ~MsQuicRegistration() noexcept { Close(); }
+    //
+    // Blocks until all the registration's connections have been closed. Any
+    // configurations and listeners on it must already be closed.
+    //
+    void Close() noexcept {
         if (Handle != nullptr) {
             if (CloseAllConnectionsOnDelete) {
                 MsQuic->RegistrationShutdown(
@@ -238,6 +243,7 @@ public:
                     1);
             }
             MsQuic->RegistrationClose(Handle);
+            Handle = nullptr;
         }
     }
     QUIC_STATUS GetInitStatus() const noexcept { return InitStatus; }
@@ -279,6 +285,8 @@ public:
     MsQuicSettings& SetPacingEnabled(bool Value) { PacingEnabled = Value; IsSet.PacingEnabled = TRUE; return *this; }
     MsQuicSettings& SetMigrationEnabled(bool Value) { MigrationEnabled = Value; IsSet.MigrationEnabled = TRUE; return *this; }
     MsQuicSettings& SetDatagramReceiveEnabled(bool Value) { DatagramReceiveEnabled = Value; IsSet.DatagramReceiveEnabled = TRUE; return *this; }
+    MsQuicSettings& SetStreamRecvInPlaceEnabled(bool Value) { StreamRecvInPlaceEnabled = Value; IsSet.StreamRecvInPlaceEnabled = TRUE; return *this; }
+    MsQuicSettings& SetTlsOffloadEnabled(bool Value) { TlsOffloadEnabled = Value; IsSet.TlsOffloadEnabled = TRUE; return *this; }
     MsQuicSettings& SetServerResumptionLevel(QUIC_SERVER_RESUMPTION_LEVEL Value) { ServerResumptionLevel = Value; IsSet.ServerResumptionLevel = TRUE; return *this; }
     MsQuicSettings& SetInitialRttMs(uint32_t Value) { InitialRttMs = Value; IsSet.InitialRttMs = TRUE; return *this; }
     MsQuicSettings& SetIdleTimeoutMs(uint64_t Value) { IdleTimeoutMs = Value; IsSet.IdleTimeoutMs = TRUE; return *this; }
@@ -288,6 +296,7 @@ public:
     MsQuicSettings& SetPeerUnidiStreamCount(uint16_t Value) { PeerUnidiStreamCount = Value; IsSet.PeerUnidiStreamCount = TRUE; return *this; }
     MsQuicSettings& SetMaxBytesPerKey(uint64_t Value) { MaxBytesPerKey = Value; IsSet.MaxBytesPerKey = TRUE; return *this; }
     MsQuicSettings& SetMaxAckDelayMs(uint32_t Value) { MaxAckDelayMs = Value; IsSet.MaxAckDelayMs = TRUE; return *this; }
+    MsQuicSettings& SetKeepAliveIntervalMs(uint32_t Value) { KeepAliveIntervalMs = Value; IsSet.KeepAliveIntervalMs = TRUE; return *this; }
     MsQuicSettings& SetDesiredVersionsList(const uint32_t* DesiredVersions, uint32_t Length) {
         DesiredVersionsList = DesiredVersions; DesiredVersionsListLength = Length; IsSet.DesiredVersionsList = TRUE; return *this; }
     MsQuicSettings& SetVersionNegotiationExtEnabled(bool Value) { VersionNegotiationExtEnabled = Value; IsSet.VersionNegotiationExtEnabled = TRUE; return *this; }
@@ -385,9 +394,11 @@ public:
             InitStatus = LoadCredential(&CredConfig);
         }
     }
-    ~MsQuicConfiguration() noexcept {
+    ~MsQuicConfiguration() noexcept { Close(); }
+    void Close() noexcept {
         if (Handle != nullptr) {
             MsQuic->ConfigurationClose(Handle);
+            Handle = nullptr;
         }
     }
     QUIC_STATUS GetInitStatus() const noexcept { return InitStatus; }
@@ -446,12 +457,15 @@ struct MsQuicListener {
             Handle = nullptr;
         }
     }
-    ~MsQuicListener() noexcept {
+    ~MsQuicListener() noexcept { Close(); }
+    void Close() noexcept {
         if (Handler != nullptr) {
             MsQuic->ListenerStop(Handle);
+            Handler = nullptr;
         }
         if (Handle) {
             MsQuic->ListenerClose(Handle);
+            Handle = nullptr;
         }
     }
 
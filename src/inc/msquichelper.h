@@ -194,6 +194,91 @@ DumpMsQuicPerfCounters(
     printf("  WORK_OPER_QUEUE_DEPTH: %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_OPER_QUEUE_DEPTH]);
     printf("  WORK_OPER_QUEUED:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_OPER_QUEUED]);
     printf("  WORK_OPER_COMPLETED:   %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_WORK_OPER_COMPLETED]);
+    printf("  CONN_ADMIT_RETRY:      %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_ADMIT_RETRY]);
+    printf("  CONN_ADMIT_LIMITED:    %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_ADMIT_LIMITED]);
+    printf("  CONN_ADMIT_DROPPED:    %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_ADMIT_DROPPED]);
+    printf("  CONN_0RTT_REPLAY_REJECT: %llu\n", (unsigned long long)Counters[QUIC_PERF_COUNTER_CONN_0RTT_REPLAY_REJECT]);
+}
+
+//
+// Returns the smallest latency value (in microseconds) counted in the given
+// latency histogram bucket.
+//
+inline
+uint64_t
+QuicLatencyHistogramBucketLowerBound(
+    _In_ uint32_t Index
+    )
+{
+    const uint32_t SubBuckets = 1 << QUIC_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    if (Index < 2 * SubBuckets) {
+        return Index;
+    }
+    const uint32_t Shift = Index / SubBuckets - 1;
+    return (uint64_t)(SubBuckets + Index % SubBuckets) << Shift;
+}
+
+//
+// Returns the latency (in microseconds) below which the given percentile of
+// the histogram's samples fall, e.g. 99.9 for p999. The result is the lower
+// bound of the bucket the percentile falls in.
+//
+inline
+uint64_t
+QuicLatencyHistogramPercentile(
+    _In_ const QUIC_LATENCY_HISTOGRAM* Histogram,
+    _In_ double Percentile
+    )
+{
+    if (Histogram->Count == 0) {
+        return 0;
+    }
+    uint64_t Rank = (uint64_t)(Histogram->Count * Percentile / 100.0);
+    if (Rank >= Histogram->Count) {
+        Rank = Histogram->Count - 1;
+    }
+    uint64_t Seen = 0;
+    for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++i) {
+        Seen += Histogram->Buckets[i];
+        if (Seen > Rank) {
+            return QuicLatencyHistogramBucketLowerBound(i);
+        }
+    }
+    return QuicLatencyHistogramBucketLowerBound(QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT - 1);
+}
+
+inline
+void
+DumpMsQuicLatencyHistograms(
+    _In_ const QUIC_API_TABLE* MsQuic
+    )
+{
+    const char* const Names[QUIC_LATENCY_HISTOGRAM_MAX] = {
+        "WORKER_QUEUE_DELAY", "OPER_PROCESSING", "SEND_FLUSH", "RTT", "HANDSHAKE"
+    };
+    QUIC_LATENCY_HISTOGRAM Histograms[QUIC_LATENCY_HISTOGRAM_MAX];
+    uint32_t Length = sizeof(Histograms);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            NULL,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS,
+            &Length,
+            Histograms))) {
+        return;
+    }
+    printf("Latency Histograms (us):\n");
+    printf("  %-20s %12s %10s %10s %10s %10s\n", "", "Count", "Mean", "p50", "p99", "p999");
+    for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_MAX; ++i) {
+        const QUIC_LATENCY_HISTOGRAM* Histogram = &Histograms[i];
+        printf("  %-20s %12llu %10llu %10llu %10llu %10llu\n",
+            Names[i],
+            (unsigned long long)Histogram->Count,
+            (unsigned long long)(Histogram->Count == 0 ? 0 : Histogram->Sum / Histogram->Count),
+            (unsigned long long)QuicLatencyHistogramPercentile(Histogram, 50),
+            (unsigned long long)QuicLatencyHistogramPercentile(Histogram, 99),
+            (unsigned long long)QuicLatencyHistogramPercentile(Histogram, 99.9));
+    }
 }
 
 //
@@ -89,11 +89,41 @@ typedef struct CXPLAT_TLS_SECRETS {
     uint8_t ServerTrafficSecret0[CXPLAT_TLS_SECRETS_MAX_SECRET_LEN];
 } CXPLAT_TLS_SECRETS;
 
+//
+// Network conditions emulated by the in-process loopback datapath (built with
+// QUIC_LOOPBACK_DATAPATH). The knobs match the ones of the duonic driver used
+// by scripts/emulated-performance.ps1, plus a few only the loopback datapath
+// supports (jitter, bursty loss and a token bucket). Zero disables each of
+// them.
+//
+typedef struct CXPLAT_DATAPATH_EMULATION {
+    uint32_t DelayMs;                   // One-way delay added to each datagram.
+    uint32_t RateLimitMbps;             // Bottleneck rate of each sender.
+    uint32_t QueueLimitPackets;         // Bottleneck queue length. Requires RateLimitMbps.
+    uint32_t RandomLossDenominator;     // Drops 1 in N datagrams at random.
+    uint32_t RandomReorderDenominator;  // Delays 1 in N datagrams by ReorderDelayDeltaMs.
+    uint32_t ReorderDelayDeltaMs;
+    uint32_t JitterMs;                  // Random extra delay, up to JitterMs. Keeps order.
+    uint32_t BurstLossDenominator;      // Starts a loss burst on 1 in N datagrams.
+    uint32_t BurstLossLength;           // Mean datagrams lost per burst. Requires BurstLossDenominator.
+    uint32_t RateBucketBytes;           // Bytes sent at line rate after idle. Requires RateLimitMbps.
+} CXPLAT_DATAPATH_EMULATION;
+
 //
 // The different private parameters for QUIC_PARAM_LEVEL_GLOBAL.
 //
 
 #define QUIC_PARAM_GLOBAL_TEST_DATAPATH_HOOKS           0x80000001  // QUIC_TEST_DATAPATH_HOOKS*
+#ifdef QUIC_LOOPBACK_DATAPATH
+#define QUIC_PARAM_GLOBAL_LOOPBACK_EMULATION            0x80000002  // CXPLAT_DATAPATH_EMULATION
+#endif
+#ifdef QUIC_EVENTS_RING
+#define QUIC_PARAM_GLOBAL_TRACE_RING_DUMP               0x80000003  // char[] - Dump file path, or empty for the default
+#endif
+#ifdef QUIC_QLOG_SUPPORT
+#define QUIC_PARAM_GLOBAL_QLOG_DIR                      0x80000004  // char[] - qlog directory for new connections, or empty to disable
+#define QUIC_PARAM_GLOBAL_QLOG_WRITER_PAUSED            0x80000005  // BOOLEAN - Stops writing out qlog events, so they pile up (for tests)
+#endif
 
 //
 // The different private parameters for QUIC_PARAM_LEVEL_CONNECTION.
@@ -344,6 +344,73 @@ CxPlatDataPathUninitialize(
     _In_ CXPLAT_DATAPATH* datapath
     );
 
+#ifdef QUIC_LOOPBACK_DATAPATH
+typedef struct CXPLAT_DATAPATH_EMULATION CXPLAT_DATAPATH_EMULATION;
+
+//
+// Sets the network conditions emulated by the in-process loopback datapath.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathSetEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const CXPLAT_DATAPATH_EMULATION* Emulation
+    );
+
+//
+// The emulated path of the datagrams sent on one loopback socket. Exposed so
+// the emulation can be tested without real time passing.
+//
+typedef struct CXPLAT_EMULATED_LINK {
+
+    //
+    // The time (in nanoseconds) at which the emulated bottleneck finishes
+    // transmitting everything sent on the link so far.
+    //
+    uint64_t FreeTimeNs;
+
+    //
+    // The latest delivery time (in microseconds) of a datagram sent on the
+    // link, excluding reordered ones. Jitter never delivers before it.
+    //
+    uint64_t LastDeliveryTimeUs;
+
+    //
+    // State of the random generator used for loss, jitter and reordering.
+    //
+    uint64_t RandomState;
+
+    //
+    // Whether datagrams are currently lost in a burst (the "bad" state of a
+    // Gilbert-Elliott loss model).
+    //
+    BOOLEAN InLossBurst;
+
+} CXPLAT_EMULATED_LINK;
+
+//
+// Initializes an idle link with a random generator seed.
+//
+void
+CxPlatEmulatedLinkInitialize(
+    _Out_ CXPLAT_EMULATED_LINK* Link
+    );
+
+//
+// Applies the network emulation to a datagram of Length bytes sent on Link at
+// TimeNowUs. Returns FALSE if the datagram is lost, otherwise sets the time it
+// may be delivered. Not synchronized.
+//
+BOOLEAN
+CxPlatEmulatedLinkSend(
+    _Inout_ CXPLAT_EMULATED_LINK* Link,
+    _In_ const CXPLAT_DATAPATH_EMULATION* Emulation,
+    _In_ uint64_t TimeNowUs,
+    _In_ uint32_t Length,
+    _Out_ uint64_t* DeliveryTimeUs
+    );
+#endif
+
 #define CXPLAT_DATAPATH_FEATURE_RECV_SIDE_SCALING     0x0001
 #define CXPLAT_DATAPATH_FEATURE_RECV_COALESCING       0x0002
 #define CXPLAT_DATAPATH_FEATURE_SEND_SEGMENTATION     0x0004
@@ -132,6 +132,12 @@ typedef struct CXPLAT_SLIST_ENTRY {
 #define QUIC_POOL_TLS_TMP_TP                '44cQ' // Qc44 - QUIC Platform TLS Temporary TP storage
 #define QUIC_POOL_PCP                       '54cQ' // Qc45 - QUIC PCP
 #define QUIC_POOL_DATAPATH_ADDRESSES        '64cQ' // Qc46 - QUIC Datapath Addresses
+#define QUIC_POOL_STREAM_WINDOW             '74cQ' // Qc47 - QUIC Stream Set Window
+#define QUIC_POOL_TLS_OFFLOAD               '84cQ' // Qc48 - QUIC Platform TLS Offload
+#define QUIC_POOL_TLS_TICKET_KEYS           '94cQ' // Qc49 - QUIC Platform TLS Ticket Keys
+#define QUIC_POOL_REPLAY_FILTER             'A4cQ' // Qc4A - QUIC 0-RTT Replay Filter
+#define QUIC_POOL_SEND_BATCH                'C4cQ' // Qc4C - QUIC Stream Send Batch
+#define QUIC_POOL_QLOG                      'D4cQ' // Qc4D - QUIC qlog Event Log
 
 typedef enum CXPLAT_THREAD_FLAGS {
     CXPLAT_THREAD_FLAG_NONE               = 0x0000,
@@ -441,6 +441,11 @@ typedef SRWLOCK CXPLAT_DISPATCH_RW_LOCK;
 #define QuicReadLongPtrNoFence ReadNoFence
 #endif
 
+#define InterlockedFetchAndClearBoolean(Target) \
+    (BOOLEAN)InterlockedAnd8((char volatile*)(Target), 0)
+#define InterlockedFetchAndSetBoolean(Target) \
+    (BOOLEAN)InterlockedOr8((char volatile*)(Target), 1)
+
 typedef LONG_PTR CXPLAT_REF_COUNT;
 
 inline
@@ -81,6 +81,9 @@ typedef CXPLAT_TLS_RECEIVE_TP_CALLBACK *CXPLAT_TLS_RECEIVE_TP_CALLBACK_HANDLER;
 //
 // Callback for indicating received resumption ticket. Callback always happens
 // in the context of a QuicTlsProcessData call; not on a separate thread.
+// On the server, EarlyDataAccepted is TRUE if the peer offered early data with
+// the ticket, and the callback may set it to FALSE to reject just the early
+// data while still accepting the ticket. It is NULL on the client.
 //
 typedef
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -88,7 +91,8 @@ BOOLEAN
 (CXPLAT_TLS_RECEIVE_TICKET_CALLBACK)(
     _In_ QUIC_CONNECTION* Connection,
     _In_ uint32_t TicketLength,
-    _In_reads_(TicketLength) const uint8_t* Ticket
+    _In_reads_(TicketLength) const uint8_t* Ticket,
+    _Inout_opt_ BOOLEAN* EarlyDataAccepted
     );
 
 typedef CXPLAT_TLS_RECEIVE_TICKET_CALLBACK *CXPLAT_TLS_RECEIVE_TICKET_CALLBACK_HANDLER;
@@ -182,6 +186,13 @@ typedef struct CXPLAT_TLS_CONFIG {
     const uint8_t* LocalTPBuffer;
     uint32_t LocalTPLength;
 
+    //
+    // Allows the server's handshake processing to be offloaded to a separate
+    // thread pool. Completion is then indicated via the ProcessComplete
+    // callback. Ignored by TLS providers that don't support it.
+    //
+    BOOLEAN OffloadEnabled;
+
 #ifdef CXPLAT_TLS_SECRETS_SUPPORT
     //
     // Storage for TLS traffic secrets when CXPLAT_TLS_SECRETS_SUPPORT is enabled,
@@ -409,13 +420,15 @@ CxPlatTlsProcessData(
     );
 
 //
-// Called when in response to receiving a process completed callback.
+// Called when in response to receiving a process completed callback. Also
+// returns the time (in us) the pending call spent processing the data.
 //
 _IRQL_requires_max_(PASSIVE_LEVEL)
 CXPLAT_TLS_RESULT_FLAGS
 CxPlatTlsProcessDataComplete(
     _In_ CXPLAT_TLS* TlsContext,
-    _Out_ uint32_t * ConsumedBuffer
+    _Out_ uint32_t * ConsumedBuffer,
+    _Out_ uint32_t * ProcessTimeUs
     );
 
 //
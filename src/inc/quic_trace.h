@@ -21,6 +21,7 @@ Abstract:
 
     QUIC_EVENTS_STUB            No-op all Events
     QUIC_EVENTS_MANIFEST_ETW    Write to Windows ETW framework
+    QUIC_EVENTS_RING            Write to in-memory, per-thread ring buffers
 
     QUIC_LOGS_STUB              No-op all Logs
     QUIC_LOGS_MANIFEST_ETW      Write to Windows ETW framework
@@ -32,7 +33,7 @@ Abstract:
 #pragma once
 
 #if !defined(QUIC_CLOG)
-#if !defined(QUIC_EVENTS_STUB) && !defined(QUIC_EVENTS_MANIFEST_ETW)
+#if !defined(QUIC_EVENTS_STUB) && !defined(QUIC_EVENTS_MANIFEST_ETW) && !defined(QUIC_EVENTS_RING)
 #error "Must define one QUIC_EVENTS_*"
 #endif
 
@@ -94,6 +95,7 @@ typedef enum QUIC_TRACE_API_TYPE {
     QUIC_TRACE_API_STREAM_RECEIVE_COMPLETE,
     QUIC_TRACE_API_STREAM_RECEIVE_SET_ENABLED,
     QUIC_TRACE_API_DATAGRAM_SEND,
+    QUIC_TRACE_API_STREAM_SEND_BATCH,
     QUIC_TRACE_API_COUNT // Must be last
 } QUIC_TRACE_API_TYPE;
 
@@ -141,6 +143,44 @@ QuicTraceEventStubVarArgs(
 
 #endif // QUIC_EVENTS_STUB
 
+#ifdef QUIC_EVENTS_RING
+
+//
+// Events are recorded into per-thread ring buffers, which only hold the most
+// recent events, and are written out with QuicTraceRingDump. See
+// quic_trace_ring.h. The rings live in libmsquic, which exports these
+// functions so that every module in the process records into them.
+//
+#define QuicTraceEventEnabled(Name) TRUE
+
+#ifdef __cplusplus
+extern "C"
+#endif
+void
+QuicTraceRingWrite(
+    _In_z_ const char* Name,
+    _In_z_ const char* Format,
+    ...
+    );
+
+//
+// Writes all rings to a file. Path defaults to the QUIC_TRACE_RING_FILE
+// environment variable, or msquic.<pid>.ring.
+//
+#ifdef __cplusplus
+extern "C"
+#endif
+QUIC_STATUS
+QuicTraceRingDump(
+    _In_opt_z_ const char* Path
+    );
+
+#define QuicTraceEvent(Name, ...) QuicTraceRingWrite(#Name, __VA_ARGS__)
+
+#define CLOG_BYTEARRAY(Len, Data) (uint32_t)(Len), (const void*)(Data)
+
+#endif // QUIC_EVENTS_RING
+
 #ifdef QUIC_EVENTS_MANIFEST_ETW
 
 #include <evntprov.h>
@@ -0,0 +1,218 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Binary format of the event ring tracing backend (QUIC_EVENTS_RING).
+
+    Each thread that raises an event gets its own ring buffer, which only that
+    thread ever writes to. An event is appended to the ring as a compact
+    record: a small header followed by the packed argument values. The
+    argument layout isn't stored in the record; it is derived from the event's
+    printf style format string, which is kept once per event in the event
+    table. Rings continuously overwrite their oldest records (flight recorder).
+
+    A dump file (QuicTraceRingDump) contains a file header, the event table and
+    a raw copy of every ring. Rings are copied while their threads keep
+    writing, so each record carries the low bits of its logical ring offset,
+    which lets readers skip anything overwritten during the copy and
+    resynchronize on the next intact record.
+
+    This header is shared by the in-process writer and the offline decoder.
+
+--*/
+
+#pragma once
+
+#define QUIC_TRACE_RING_FILE_SIGNATURE      "QUICRING"
+#define QUIC_TRACE_RING_FILE_VERSION        1
+
+#define QUIC_TRACE_RING_MAX_ARGS            16
+#define QUIC_TRACE_RING_MAX_STRING          128     // Longer strings are truncated.
+#define QUIC_TRACE_RING_MAX_BYTES           255     // Longer byte arrays are truncated.
+#define QUIC_TRACE_RING_MAX_RECORD          1024    // Arguments that don't fit are dropped.
+
+#define QUIC_TRACE_RING_ALIGN(Length)       (((Length) + 7) & ~7)
+
+//
+// The number of QUIC_OPERATION_TYPE, QUIC_API_TYPE and QUIC_CONN_TIMER_TYPE
+// values carried by the ConnExec*Oper events. The core asserts these match
+// its enums, so the decoder's operation names can't silently fall behind.
+//
+#define QUIC_TRACE_RING_OPER_TYPE_COUNT     11
+#define QUIC_TRACE_RING_API_TYPE_COUNT      15
+#define QUIC_TRACE_RING_TIMER_TYPE_COUNT    6
+
+typedef struct QUIC_TRACE_RING_FILE_HEADER {
+    char Signature[8];
+    uint32_t Version;
+    uint32_t ProcessId;
+    uint32_t EventCount;
+    uint32_t RingCount;
+    uint64_t DumpTimeNs;
+} QUIC_TRACE_RING_FILE_HEADER;
+
+//
+// Followed by Name[NameLength] and Format[FormatLength], neither of which is
+// null terminated.
+//
+typedef struct QUIC_TRACE_RING_FILE_EVENT {
+    uint16_t EventId;
+    uint16_t NameLength;
+    uint16_t FormatLength;
+    uint16_t Reserved;
+} QUIC_TRACE_RING_FILE_EVENT;
+
+//
+// Followed by Buffer[Size]. Head is the logical (ever increasing) write
+// offset read before copying the buffer and HeadAfterCopy the one read after.
+//
+typedef struct QUIC_TRACE_RING_FILE_RING {
+    uint32_t ThreadId;
+    uint32_t Size;
+    uint64_t Head;
+    uint64_t HeadAfterCopy;
+} QUIC_TRACE_RING_FILE_RING;
+
+//
+// Records start on 8 byte boundaries. A record with EventId 0 is padding
+// that fills the end of the buffer, and only has Offset and Length valid.
+//
+typedef struct QUIC_TRACE_RING_RECORD {
+    uint32_t Offset;    // Low 32 bits of the logical offset of the record.
+    uint16_t Length;    // Of the header and payload, before alignment.
+    uint16_t EventId;
+    uint64_t TimeNs;    // CLOCK_MONOTONIC.
+    // uint8_t Payload[];
+} QUIC_TRACE_RING_RECORD;
+
+//
+// How each format specifier's argument is stored in the payload. Integers
+// are stored little endian at their natural size, without alignment.
+//
+typedef enum QUIC_TRACE_RING_ARG_TYPE {
+    QUIC_TRACE_RING_ARG_U8      = 1,    // %hhu, %c
+    QUIC_TRACE_RING_ARG_U16     = 2,    // %hu
+    QUIC_TRACE_RING_ARG_U32     = 3,    // %u, %d, %x
+    QUIC_TRACE_RING_ARG_U64     = 4,    // %llu, %lu, %zu
+    QUIC_TRACE_RING_ARG_PTR     = 5,    // %p, stored as 8 bytes
+    QUIC_TRACE_RING_ARG_STRING  = 6,    // %s, uint8_t length and characters
+    QUIC_TRACE_RING_ARG_BYTES   = 7,    // %!NAME! (CLOG_BYTEARRAY), uint8_t length and bytes
+} QUIC_TRACE_RING_ARG_TYPE;
+
+//
+// Returns the number of arguments Format consumes (at most
+// QUIC_TRACE_RING_MAX_ARGS) and writes each one's QUIC_TRACE_RING_ARG_TYPE.
+//
+inline
+uint8_t
+QuicTraceRingParseFormat(
+    _In_z_ const char* Format,
+    _Out_writes_to_(QUIC_TRACE_RING_MAX_ARGS, return)
+        uint8_t* ArgTypes
+    )
+{
+    uint8_t ArgCount = 0;
+    for (const char* p = Format; *p != '\0'; ++p) {
+        if (*p != '%') {
+            continue;
+        }
+        ++p;
+        if (*p == '%') {
+            continue;
+        }
+
+        uint8_t Type;
+        if (*p == '!') {
+            do {
+                ++p;
+            } while (*p != '\0' && *p != '!');
+            Type = QUIC_TRACE_RING_ARG_BYTES;
+
+        } else {
+            while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '.' ||
+                   (*p >= '0' && *p <= '9')) {
+                ++p;
+            }
+            Type = QUIC_TRACE_RING_ARG_U32;
+            if (p[0] == 'h' && p[1] == 'h') {
+                Type = QUIC_TRACE_RING_ARG_U8;
+                p += 2;
+            } else if (p[0] == 'h') {
+                Type = QUIC_TRACE_RING_ARG_U16;
+                p++;
+            } else if (p[0] == 'l' && p[1] == 'l') {
+                Type = QUIC_TRACE_RING_ARG_U64;
+                p += 2;
+            } else if (p[0] == 'l' || p[0] == 'z' || p[0] == 'j') {
+                Type = QUIC_TRACE_RING_ARG_U64;
+                p++;
+            } else if (p[0] == 'I' && p[1] == '6' && p[2] == '4') {
+                Type = QUIC_TRACE_RING_ARG_U64;
+                p += 3;
+            }
+            if (*p == 'p') {
+                Type = QUIC_TRACE_RING_ARG_PTR;
+            } else if (*p == 's') {
+                Type = QUIC_TRACE_RING_ARG_STRING;
+            } else if (*p == 'c') {
+                Type = QUIC_TRACE_RING_ARG_U8;
+            }
+        }
+
+        if (*p == '\0') {
+            break;
+        }
+        if (ArgCount < QUIC_TRACE_RING_MAX_ARGS) {
+            ArgTypes[ArgCount++] = Type;
+        }
+    }
+    return ArgCount;
+}
+
+//
+// Finds the next intact record of a dumped ring, starting at the logical
+// offset *Offset (initially 0), and advances *Offset past it. Returns NULL
+// when no records are left. Size must be a power of 2.
+//
+inline
+const QUIC_TRACE_RING_RECORD*
+QuicTraceRingNextRecord(
+    _In_ const QUIC_TRACE_RING_FILE_RING* Ring,
+    _In_reads_bytes_(Ring->Size)
+        const uint8_t* Buffer,
+    _Inout_ uint64_t* Offset
+    )
+{
+    //
+    // While the buffer was being copied, the thread may have written up to a
+    // padding record and a full record past HeadAfterCopy, overwriting the
+    // oldest part of the copy.
+    //
+    const uint64_t Overwritten = Ring->HeadAfterCopy + 2 * QUIC_TRACE_RING_MAX_RECORD;
+    if (Overwritten > Ring->Size &&
+        *Offset < QUIC_TRACE_RING_ALIGN(Overwritten - Ring->Size)) {
+        *Offset = QUIC_TRACE_RING_ALIGN(Overwritten - Ring->Size);
+    }
+
+    while (*Offset + 8 <= Ring->Head) {
+        const uint32_t Position = (uint32_t)(*Offset & (Ring->Size - 1));
+        const QUIC_TRACE_RING_RECORD* Record =
+            (const QUIC_TRACE_RING_RECORD*)(Buffer + Position);
+        if (Record->Offset != (uint32_t)*Offset ||
+            Record->Length < 8 ||
+            Position + Record->Length > Ring->Size ||
+            *Offset + Record->Length > Ring->Head) {
+            *Offset += 8; // Not a record boundary, resynchronize.
+            continue;
+        }
+
+        *Offset += QUIC_TRACE_RING_ALIGN(Record->Length);
+        if (Record->EventId != 0 && Record->Length >= sizeof(QUIC_TRACE_RING_RECORD)) {
+            return Record;
+        }
+    }
+    return NULL;
+}
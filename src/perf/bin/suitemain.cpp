@@ -0,0 +1,817 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Perf regression suite. Runs a fixed matrix of perf scenarios against
+    an in-process server, reports the rate and CPU cost of each as JSON and
+    optionally compares them against the JSON of a previous (baseline) run.
+
+--*/
+
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "PerfHelpers.h"
+#include "PerfServer.h"
+#include "ThroughputClient.h"
+#include "RpsClient.h"
+#include "HpsClient.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+extern "C" _IRQL_requires_max_(PASSIVE_LEVEL) void QuicTraceRundown(void) { }
+
+#define PERF_SUITE_DEFAULT_ITERATIONS       5
+#define PERF_SUITE_DEFAULT_WARMUP           1
+#define PERF_SUITE_DEFAULT_RUN_TIME         5000
+#define PERF_SUITE_DEFAULT_THRESHOLD        2   // Percent
+#define PERF_SUITE_DEFAULT_CONFIDENCE       95  // Percent
+#define PERF_SUITE_TPUT_TIMEOUT_SLACK       (10 * 1000)
+#define PERF_SUITE_DEFAULT_OUTPUT           "quicperfsuite.json"
+
+struct PerfSuiteScenario {
+    const char* Name;
+    PerfTestType Type;
+    //
+    // The argument that receives the run time, in ms.
+    //
+    const char* RunTimeArg;
+    const char* Args;
+};
+
+//
+// The scenario matrix. Throughput runs are timed so every scenario takes
+// roughly the same wall time.
+//
+static const PerfSuiteScenario Scenarios[] = {
+    { "tput-up",                PerfTestType::ThroughputClient, "upload",   "-timed:1" },
+    { "tput-up-noencrypt",      PerfTestType::ThroughputClient, "upload",   "-timed:1 -encrypt:0" },
+    { "tput-down",              PerfTestType::ThroughputClient, "download", "-timed:1" },
+    { "tput-down-noencrypt",    PerfTestType::ThroughputClient, "download", "-timed:1 -encrypt:0" },
+    { "rps-64b",                PerfTestType::RpsClient,        "runtime",  "-conns:16 -requests:64 -request:64 -response:64" },
+    { "rps-4kb",                PerfTestType::RpsClient,        "runtime",  "-conns:16 -requests:64 -request:4096 -response:4096" },
+    { "rps-64kb",               PerfTestType::RpsClient,        "runtime",  "-conns:16 -requests:64 -request:65536 -response:65536" },
+    { "rps-streams",            PerfTestType::RpsClient,        "runtime",  "-conns:4 -requests:4000 -request:64 -response:64" },
+    { "hps",                    PerfTestType::HpsClient,        "runtime",  "" },
+};
+
+struct PerfSuiteMetric {
+    std::string Scenario;
+    std::string Name;
+    std::string Unit;
+    bool HigherIsBetter;
+    std::vector<double> Samples;
+
+    double Mean() const {
+        double Sum = 0;
+        for (double Sample : Samples) {
+            Sum += Sample;
+        }
+        return Samples.empty() ? 0 : Sum / Samples.size();
+    }
+
+    double Variance() const {
+        if (Samples.size() < 2) {
+            return 0;
+        }
+        double Avg = Mean();
+        double Sum = 0;
+        for (double Sample : Samples) {
+            Sum += (Sample - Avg) * (Sample - Avg);
+        }
+        return Sum / (Samples.size() - 1);
+    }
+};
+
+enum class PerfSuiteVerdict {
+    Unchanged,
+    Improvement,
+    Regression
+};
+
+static
+void
+PrintHelp(
+    ) {
+    WriteOutput(
+        "\n"
+        "quicperfsuite usage:\n"
+        "\n"
+        "  quicperfsuite [options]\n"
+        "\n"
+        "  -filter:<substring>         Only runs scenarios whose name contains the substring.\n"
+        "  -iterations:<####>          The measured runs per scenario. (def:%u)\n"
+        "  -warmup:<####>              The discarded runs per scenario. (def:%u)\n"
+        "  -runtime:<####>             The length of each run, in ms. (def:%u)\n"
+        "  -port:<####>                The UDP port of the in-process server. (def:%u)\n"
+        "  -out:<file>                 The JSON results file. (def:%s)\n"
+        "  -baseline:<file>            A previous results file to compare against.\n"
+        "  -threshold:<####>           The change, in percent, that counts as a regression. (def:%u)\n"
+        "  -confidence:<####>          The statistical confidence, in percent, required to\n"
+        "                              report a change. (def:%u)\n"
+        "\n"
+        "Scenarios:\n"
+        "\n",
+        PERF_SUITE_DEFAULT_ITERATIONS,
+        PERF_SUITE_DEFAULT_WARMUP,
+        PERF_SUITE_DEFAULT_RUN_TIME,
+        PERF_DEFAULT_PORT,
+        PERF_SUITE_DEFAULT_OUTPUT,
+        PERF_SUITE_DEFAULT_THRESHOLD,
+        PERF_SUITE_DEFAULT_CONFIDENCE);
+    for (const auto& Scenario : Scenarios) {
+        WriteOutput("  %-24s %s\n", Scenario.Name, Scenario.Args);
+    }
+    WriteOutput("\n");
+}
+
+//
+// Returns the user plus kernel CPU time of the whole process, in us. Since
+// the server runs in-process, this covers both ends of the connection.
+//
+static
+uint64_t
+PerfSuiteProcessCpuTimeUs(
+    ) {
+#ifdef _WIN32
+    FILETIME Creation, Exit, Kernel, User;
+    if (!GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User)) {
+        return 0;
+    }
+    ULARGE_INTEGER KernelTime, UserTime;
+    KernelTime.LowPart = Kernel.dwLowDateTime;
+    KernelTime.HighPart = Kernel.dwHighDateTime;
+    UserTime.LowPart = User.dwLowDateTime;
+    UserTime.HighPart = User.dwHighDateTime;
+    return (KernelTime.QuadPart + UserTime.QuadPart) / 10; // 100ns units
+#else
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+        return 0;
+    }
+    return
+        S_TO_US((uint64_t)Usage.ru_utime.tv_sec) + (uint64_t)Usage.ru_utime.tv_usec +
+        S_TO_US((uint64_t)Usage.ru_stime.tv_sec) + (uint64_t)Usage.ru_stime.tv_usec;
+#endif
+}
+
+static
+FILE*
+PerfSuiteOpenFile(
+    _In_z_ const char* FileName,
+    _In_z_ const char* Mode
+    ) {
+    FILE* File = nullptr;
+#ifdef _WIN32
+    if (fopen_s(&File, FileName, Mode) != 0) {
+        File = nullptr;
+    }
+#else
+    File = fopen(FileName, Mode);
+#endif
+    return File;
+}
+
+//
+// Runs one client iteration of the scenario and returns the work it completed
+// and the CPU time it took.
+//
+static
+QUIC_STATUS
+PerfSuiteRunOnce(
+    _In_ const PerfSuiteScenario* Scenario,
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_ uint32_t RunTime,
+    _Out_ PerfRunResult* Result,
+    _Out_ uint64_t* CpuTimeUs
+    ) {
+    UniquePtr<PerfBase> Client;
+    switch (Scenario->Type) {
+    case PerfTestType::ThroughputClient:
+        Client.reset(new(std::nothrow) ThroughputClient);
+        break;
+    case PerfTestType::RpsClient:
+        Client.reset(new(std::nothrow) RpsClient);
+        break;
+    default:
+        Client.reset(new(std::nothrow) HpsClient);
+        break;
+    }
+    if (Client.get() == nullptr) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    QUIC_STATUS Status = Client->Init(argc, argv);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Scenario %s failed to initialize: 0x%x\n", Scenario->Name, Status);
+        return Status;
+    }
+
+    EventScope StopEvent {true};
+    uint64_t CpuStart = PerfSuiteProcessCpuTimeUs();
+    Status = Client->Start(&StopEvent.Handle);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Scenario %s failed to start: 0x%x\n", Scenario->Name, Status);
+        return Status;
+    }
+
+    //
+    // RPS and HPS stop themselves after their run time; throughput runs stop
+    // when the transfer completes, so only bound them in case of a stall.
+    //
+    int Timeout =
+        Scenario->Type == PerfTestType::ThroughputClient ?
+            (int)(RunTime + PERF_SUITE_TPUT_TIMEOUT_SLACK) : 0;
+    Status = Client->Wait(Timeout);
+    *CpuTimeUs = PerfSuiteProcessCpuTimeUs() - CpuStart;
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Scenario %s failed to complete: 0x%x\n", Scenario->Name, Status);
+        return Status;
+    }
+
+    Client->GetRunResult(Result);
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Runs all iterations of a scenario and appends its metrics. Returns false if
+// any iteration completed no work.
+//
+static
+bool
+PerfSuiteRunScenario(
+    _In_ const PerfSuiteScenario* Scenario,
+    _In_z_ const char* PortArg,
+    _In_ uint32_t RunTime,
+    _In_ uint32_t Warmup,
+    _In_ uint32_t Iterations,
+    _Inout_ std::vector<PerfSuiteMetric>& Metrics
+    ) {
+    //
+    // Build the client command line: the fixed scenario args plus the run time
+    // and server address.
+    //
+    char RunTimeArg[64];
+    snprintf(RunTimeArg, sizeof(RunTimeArg), "-%s:%u", Scenario->RunTimeArg, RunTime);
+    std::string Args = Scenario->Args;
+    std::vector<std::string> Tokens;
+    size_t Offset = 0;
+    while (Offset < Args.size()) {
+        size_t End = Args.find(' ', Offset);
+        if (End == std::string::npos) {
+            End = Args.size();
+        }
+        if (End > Offset) {
+            Tokens.push_back(Args.substr(Offset, End - Offset));
+        }
+        Offset = End + 1;
+    }
+    Tokens.push_back(RunTimeArg);
+    Tokens.push_back(PortArg);
+    Tokens.push_back("-target:localhost");
+    std::vector<char*> Argv;
+    for (auto& Token : Tokens) {
+        Argv.push_back(&Token[0]);
+    }
+
+    PerfSuiteMetric Rate, CpuCost;
+    Rate.Scenario = CpuCost.Scenario = Scenario->Name;
+    Rate.HigherIsBetter = true;
+    CpuCost.HigherIsBetter = false;
+    switch (Scenario->Type) {
+    case PerfTestType::ThroughputClient:
+        Rate.Name = "Throughput"; Rate.Unit = "Mbps";
+        CpuCost.Name = "CpuPerByte"; CpuCost.Unit = "ns";
+        break;
+    case PerfTestType::RpsClient:
+        Rate.Name = "RPS"; Rate.Unit = "requests/s";
+        CpuCost.Name = "CpuPerRequest"; CpuCost.Unit = "us";
+        break;
+    default:
+        Rate.Name = "HPS"; Rate.Unit = "handshakes/s";
+        CpuCost.Name = "CpuPerHandshake"; CpuCost.Unit = "us";
+        break;
+    }
+
+    WriteOutput("Running %s (%u warmup, %u measured)\n", Scenario->Name, Warmup, Iterations);
+    for (uint32_t i = 0; i < Warmup + Iterations; ++i) {
+        PerfRunResult Result;
+        uint64_t CpuTimeUs = 0;
+        if (QUIC_FAILED(
+                PerfSuiteRunOnce(
+                    Scenario, (int)Argv.size(), Argv.data(), RunTime, &Result, &CpuTimeUs))) {
+            return false;
+        }
+
+        uint64_t Units =
+            Scenario->Type == PerfTestType::ThroughputClient ? Result.Bytes :
+            Scenario->Type == PerfTestType::RpsClient ? Result.Requests : Result.Handshakes;
+        if (Units == 0 || Result.ElapsedMicroseconds == 0) {
+            WriteOutput("Scenario %s completed no work\n", Scenario->Name);
+            return false;
+        }
+        if (i < Warmup) {
+            continue;
+        }
+
+        if (Scenario->Type == PerfTestType::ThroughputClient) {
+            Rate.Samples.push_back((double)Units * 8 / Result.ElapsedMicroseconds);
+            CpuCost.Samples.push_back((double)CpuTimeUs * 1000 / Units);
+        } else {
+            Rate.Samples.push_back((double)Units * 1000000 / Result.ElapsedMicroseconds);
+            CpuCost.Samples.push_back((double)CpuTimeUs / Units);
+        }
+    }
+
+    Metrics.push_back(Rate);
+    Metrics.push_back(CpuCost);
+    return true;
+}
+
+//
+// A minimal JSON reader, only as much as is needed to load a baseline.
+//
+struct PerfSuiteJson {
+    enum class Kind { Null, Bool, Number, String, Array, Object } Type {Kind::Null};
+    double Number {0};
+    std::string String;
+    std::vector<std::string> Keys;      // Object member names.
+    std::vector<PerfSuiteJson> Items;   // Array elements or object member values.
+
+    const PerfSuiteJson* Get(_In_z_ const char* Key) const {
+        for (size_t i = 0; i < Keys.size(); ++i) {
+            if (Keys[i] == Key) {
+                return &Items[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static void SkipSpace(const char*& p) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            ++p;
+        }
+    }
+
+    static bool ParseString(const char*& p, std::string& Out) {
+        if (*p != '"') {
+            return false;
+        }
+        ++p;
+        while (*p != '"') {
+            if (*p == '\0') {
+                return false;
+            }
+            if (*p == '\\') {
+                ++p;
+                switch (*p) {
+                case 'n': Out.push_back('\n'); break;
+                case 't': Out.push_back('\t'); break;
+                case 'r': Out.push_back('\r'); break;
+                case 'b': Out.push_back('\b'); break;
+                case 'f': Out.push_back('\f'); break;
+                case 'u':
+                    for (int i = 0; i < 4; ++i) {
+                        if (*++p == '\0') {
+                            return false;
+                        }
+                    }
+                    Out.push_back('?'); // Only ASCII names are expected.
+                    break;
+                case '\0': return false;
+                default: Out.push_back(*p); break;
+                }
+            } else {
+                Out.push_back(*p);
+            }
+            ++p;
+        }
+        ++p;
+        return true;
+    }
+
+    bool Parse(const char*& p, uint32_t Depth = 0) {
+        if (Depth > 32) {
+            return false;
+        }
+        SkipSpace(p);
+        if (*p == '{' || *p == '[') {
+            bool IsObject = *p == '{';
+            char Close = IsObject ? '}' : ']';
+            Type = IsObject ? Kind::Object : Kind::Array;
+            ++p;
+            SkipSpace(p);
+            if (*p == Close) {
+                ++p;
+                return true;
+            }
+            while (true) {
+                if (IsObject) {
+                    SkipSpace(p);
+                    Keys.emplace_back();
+                    if (!ParseString(p, Keys.back())) {
+                        return false;
+                    }
+                    SkipSpace(p);
+                    if (*p++ != ':') {
+                        return false;
+                    }
+                }
+                Items.emplace_back();
+                if (!Items.back().Parse(p, Depth + 1)) {
+                    return false;
+                }
+                SkipSpace(p);
+                if (*p == ',') {
+                    ++p;
+                } else if (*p == Close) {
+                    ++p;
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        }
+        if (*p == '"') {
+            Type = Kind::String;
+            return ParseString(p, String);
+        }
+        if (strncmp(p, "true", 4) == 0 || strncmp(p, "null", 4) == 0) {
+            Type = *p == 't' ? Kind::Bool : Kind::Null;
+            Number = *p == 't' ? 1 : 0;
+            p += 4;
+            return true;
+        }
+        if (strncmp(p, "false", 5) == 0) {
+            Type = Kind::Bool;
+            p += 5;
+            return true;
+        }
+        char* End;
+        Number = strtod(p, &End);
+        if (End == p) {
+            return false;
+        }
+        Type = Kind::Number;
+        p = End;
+        return true;
+    }
+};
+
+static
+bool
+PerfSuiteLoadBaseline(
+    _In_z_ const char* FileName,
+    _Inout_ std::vector<PerfSuiteMetric>& Metrics
+    ) {
+    FILE* File = PerfSuiteOpenFile(FileName, "rb");
+    if (File == nullptr) {
+        WriteOutput("Failed to open baseline %s\n", FileName);
+        return false;
+    }
+    std::string Contents;
+    char Chunk[4096];
+    size_t Read;
+    while ((Read = fread(Chunk, 1, sizeof(Chunk), File)) != 0) {
+        Contents.append(Chunk, Read);
+    }
+    fclose(File);
+
+    PerfSuiteJson Root;
+    const char* p = Contents.c_str();
+    const PerfSuiteJson* Results;
+    if (!Root.Parse(p) ||
+        (Results = Root.Get("Results")) == nullptr ||
+        Results->Type != PerfSuiteJson::Kind::Array) {
+        WriteOutput("Baseline %s is not a quicperfsuite results file\n", FileName);
+        return false;
+    }
+
+    for (const auto& Result : Results->Items) {
+        const PerfSuiteJson* Scenario = Result.Get("Scenario");
+        const PerfSuiteJson* Name = Result.Get("Metric");
+        const PerfSuiteJson* Samples = Result.Get("Samples");
+        if (Scenario == nullptr || Name == nullptr || Samples == nullptr ||
+            Samples->Type != PerfSuiteJson::Kind::Array) {
+            continue;
+        }
+        PerfSuiteMetric Metric;
+        Metric.Scenario = Scenario->String;
+        Metric.Name = Name->String;
+        for (const auto& Sample : Samples->Items) {
+            Metric.Samples.push_back(Sample.Number);
+        }
+        Metrics.push_back(Metric);
+    }
+    return true;
+}
+
+//
+// Continued fraction for the regularized incomplete beta function, evaluated
+// with the modified Lentz method.
+//
+static
+double
+PerfSuiteBetaContinuedFraction(
+    double a,
+    double b,
+    double x
+    ) {
+    const double Tiny = 1e-300;
+    double c = 1;
+    double d = 1 - (a + b) * x / (a + 1);
+    if (fabs(d) < Tiny) d = Tiny;
+    d = 1 / d;
+    double h = d;
+    for (int m = 1; m <= 300; ++m) {
+        double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1) * (a + m2));
+        d = 1 + aa * d;
+        if (fabs(d) < Tiny) d = Tiny;
+        c = 1 + aa / c;
+        if (fabs(c) < Tiny) c = Tiny;
+        d = 1 / d;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1));
+        d = 1 + aa * d;
+        if (fabs(d) < Tiny) d = Tiny;
+        c = 1 + aa / c;
+        if (fabs(c) < Tiny) c = Tiny;
+        d = 1 / d;
+        double Delta = d * c;
+        h *= Delta;
+        if (fabs(Delta - 1) < 1e-12) {
+            break;
+        }
+    }
+    return h;
+}
+
+static
+double
+PerfSuiteIncompleteBeta(
+    double a,
+    double b,
+    double x
+    ) {
+    if (x <= 0) return 0;
+    if (x >= 1) return 1;
+    double Front =
+        exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1 - x));
+    if (x < (a + 1) / (a + b + 2)) {
+        return Front * PerfSuiteBetaContinuedFraction(a, b, x) / a;
+    }
+    return 1 - Front * PerfSuiteBetaContinuedFraction(b, a, 1 - x) / b;
+}
+
+//
+// Two-sided p-value of Welch's t-test for a difference in means.
+//
+static
+double
+PerfSuiteWelchPValue(
+    _In_ const PerfSuiteMetric& A,
+    _In_ const PerfSuiteMetric& B
+    ) {
+    double na = (double)A.Samples.size(), nb = (double)B.Samples.size();
+    double va = A.Variance() / na, vb = B.Variance() / nb;
+    double Diff = A.Mean() - B.Mean();
+    if (va + vb == 0) {
+        return Diff == 0 ? 1 : 0;
+    }
+    double t = Diff / sqrt(va + vb);
+    double Df = (va + vb) * (va + vb) / (va * va / (na - 1) + vb * vb / (nb - 1));
+    return PerfSuiteIncompleteBeta(Df / 2, 0.5, Df / (Df + t * t));
+}
+
+static
+const char*
+PerfSuiteVerdictName(
+    PerfSuiteVerdict Verdict
+    ) {
+    switch (Verdict) {
+    case PerfSuiteVerdict::Improvement: return "improvement";
+    case PerfSuiteVerdict::Regression: return "regression";
+    default: return "unchanged";
+    }
+}
+
+int
+QUIC_MAIN_EXPORT
+main(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    ) {
+    argc--; argv++; // Skip app name
+
+    if (argc != 0 && (IsArg(argv[0], "?") || IsArg(argv[0], "help"))) {
+        PrintHelp();
+        return 0;
+    }
+
+    const char* Filter = nullptr;
+    const char* OutputFile = PERF_SUITE_DEFAULT_OUTPUT;
+    const char* BaselineFile = nullptr;
+    uint32_t Iterations = PERF_SUITE_DEFAULT_ITERATIONS;
+    uint32_t Warmup = PERF_SUITE_DEFAULT_WARMUP;
+    uint32_t RunTime = PERF_SUITE_DEFAULT_RUN_TIME;
+    uint32_t Threshold = PERF_SUITE_DEFAULT_THRESHOLD;
+    uint32_t Confidence = PERF_SUITE_DEFAULT_CONFIDENCE;
+    uint16_t Port = PERF_DEFAULT_PORT;
+    TryGetValue(argc, argv, "filter", &Filter);
+    TryGetValue(argc, argv, "out", &OutputFile);
+    TryGetValue(argc, argv, "baseline", &BaselineFile);
+    TryGetValue(argc, argv, "iterations", &Iterations);
+    TryGetValue(argc, argv, "warmup", &Warmup);
+    TryGetValue(argc, argv, "runtime", &RunTime);
+    TryGetValue(argc, argv, "threshold", &Threshold);
+    TryGetValue(argc, argv, "confidence", &Confidence);
+    TryGetValue(argc, argv, "port", &Port);
+    if (Iterations == 0 || RunTime == 0 || Confidence == 0 || Confidence >= 100) {
+        PrintHelp();
+        return 1;
+    }
+
+    std::vector<PerfSuiteMetric> Baseline;
+    if (BaselineFile != nullptr && !PerfSuiteLoadBaseline(BaselineFile, Baseline)) {
+        return 1;
+    }
+
+    CxPlatSystemLoad();
+    if (QUIC_FAILED(CxPlatInitialize())) {
+        WriteOutput("Platform failed to initialize\n");
+        CxPlatSystemUnload();
+        return 1;
+    }
+
+    int RetVal = 1;
+    std::vector<PerfSuiteMetric> Metrics;
+    uint32_t FailedScenarios = 0;
+    char PortArg[32];
+    snprintf(PortArg, sizeof(PortArg), "-port:%hu", Port);
+    char* ServerArgv[] = { PortArg };
+    PerfServer* Server = nullptr;
+    EventScope ServerStopEvent {true};
+
+    const QUIC_CREDENTIAL_CONFIG* SelfSignedCredConfig =
+        CxPlatGetSelfSignedCert(CXPLAT_SELF_SIGN_CERT_USER, FALSE);
+    if (SelfSignedCredConfig == nullptr) {
+        WriteOutput("Creating self signed certificate failed\n");
+        goto Exit;
+    }
+
+    MsQuic = new(std::nothrow) MsQuicApi;
+    if (MsQuic == nullptr || QUIC_FAILED(MsQuic->GetInitStatus())) {
+        WriteOutput("MsQuic Failed To Initialize\n");
+        goto Exit;
+    }
+
+    Server = new(std::nothrow) PerfServer(SelfSignedCredConfig);
+    if (Server == nullptr ||
+        QUIC_FAILED(Server->Init(ARRAYSIZE(ServerArgv), ServerArgv)) ||
+        QUIC_FAILED(Server->Start(&ServerStopEvent.Handle))) {
+        WriteOutput("Server Failed To Start\n");
+        goto Exit;
+    }
+
+    for (const auto& Scenario : Scenarios) {
+        if (Filter != nullptr && strstr(Scenario.Name, Filter) == nullptr) {
+            continue;
+        }
+        if (!PerfSuiteRunScenario(&Scenario, PortArg, RunTime, Warmup, Iterations, Metrics)) {
+            ++FailedScenarios;
+        }
+    }
+
+    RetVal = FailedScenarios == 0 ? 0 : 1;
+
+    {
+        FILE* File = PerfSuiteOpenFile(OutputFile, "w");
+        if (File == nullptr) {
+            WriteOutput("Failed to open %s\n", OutputFile);
+            RetVal = 1;
+            goto Exit;
+        }
+
+        const double Alpha = 1 - Confidence / 100.0;
+        uint32_t Regressions = 0;
+        fprintf(File, "{\n  \"Version\": 1,\n");
+        fprintf(File, "  \"ProcessorCount\": %u,\n", CxPlatProcActiveCount());
+        fprintf(File, "  \"RunTimeMs\": %u,\n", RunTime);
+        fprintf(File, "  \"Iterations\": %u,\n", Iterations);
+        fprintf(File, "  \"FailedScenarios\": %u,\n", FailedScenarios);
+        fprintf(File, "  \"Results\": [");
+        WriteOutput("\n%-24s %-16s %14s %10s", "Scenario", "Metric", "Mean", "StdDev");
+        if (BaselineFile != nullptr) {
+            WriteOutput(" %14s %8s %8s  %s", "Baseline", "Change", "p", "Verdict");
+        }
+        WriteOutput("\n");
+
+        for (size_t i = 0; i < Metrics.size(); ++i) {
+            const PerfSuiteMetric& Metric = Metrics[i];
+            double Mean = Metric.Mean();
+            double StdDev = sqrt(Metric.Variance());
+            fprintf(
+                File,
+                "%s\n    {\"Scenario\": \"%s\", \"Metric\": \"%s\", \"Unit\": \"%s\", "
+                "\"HigherIsBetter\": %s, \"Mean\": %.9g, \"StdDev\": %.9g, \"Samples\": [",
+                i == 0 ? "" : ",",
+                Metric.Scenario.c_str(),
+                Metric.Name.c_str(),
+                Metric.Unit.c_str(),
+                Metric.HigherIsBetter ? "true" : "false",
+                Mean,
+                StdDev);
+            for (size_t j = 0; j < Metric.Samples.size(); ++j) {
+                fprintf(File, "%s%.9g", j == 0 ? "" : ", ", Metric.Samples[j]);
+            }
+            fprintf(File, "]");
+            WriteOutput(
+                "%-24s %-16s %14.3f %10.3f",
+                Metric.Scenario.c_str(),
+                Metric.Name.c_str(),
+                Mean,
+                StdDev);
+
+            const PerfSuiteMetric* Base = nullptr;
+            for (const auto& Candidate : Baseline) {
+                if (Candidate.Scenario == Metric.Scenario && Candidate.Name == Metric.Name) {
+                    Base = &Candidate;
+                    break;
+                }
+            }
+
+            if (Base != nullptr && Base->Samples.size() >= 2 && Metric.Samples.size() >= 2 &&
+                Base->Mean() != 0) {
+                //
+                // A change is only reported when it is both larger than the
+                // threshold and statistically significant; either alone is
+                // most likely noise.
+                //
+                double BaseMean = Base->Mean();
+                double Change = (Mean - BaseMean) / BaseMean * 100;
+                double PValue = PerfSuiteWelchPValue(Metric, *Base);
+                double Worse = Metric.HigherIsBetter ? -Change : Change;
+                PerfSuiteVerdict Verdict = PerfSuiteVerdict::Unchanged;
+                if (PValue < Alpha && Worse > (double)Threshold) {
+                    Verdict = PerfSuiteVerdict::Regression;
+                    ++Regressions;
+                } else if (PValue < Alpha && -Worse > (double)Threshold) {
+                    Verdict = PerfSuiteVerdict::Improvement;
+                }
+                fprintf(
+                    File,
+                    ", \"Baseline\": {\"Mean\": %.9g, \"StdDev\": %.9g, \"ChangePercent\": %.4f, "
+                    "\"PValue\": %.6g, \"Verdict\": \"%s\"}",
+                    BaseMean,
+                    sqrt(Base->Variance()),
+                    Change,
+                    PValue,
+                    PerfSuiteVerdictName(Verdict));
+                WriteOutput(
+                    " %14.3f %+7.2f%% %8.4f  %s",
+                    BaseMean,
+                    Change,
+                    PValue,
+                    PerfSuiteVerdictName(Verdict));
+            }
+            fprintf(File, "}");
+            WriteOutput("\n");
+        }
+
+        fprintf(File, "\n  ],\n  \"Regressions\": %u\n}\n", Regressions);
+        fclose(File);
+
+        WriteOutput("\nResults written to %s\n", OutputFile);
+        if (Regressions != 0) {
+            WriteOutput("%u metric(s) regressed by more than %u%%\n", Regressions, Threshold);
+            RetVal = 1;
+        }
+        if (FailedScenarios != 0) {
+            WriteOutput("%u scenario(s) failed to run\n", FailedScenarios);
+        }
+    }
+
+Exit:
+    if (Server != nullptr) {
+        CxPlatEventSet(ServerStopEvent.Handle);
+        Server->Wait(0);
+        delete Server;
+    }
+    delete MsQuic;
+    MsQuic = nullptr;
+    if (SelfSignedCredConfig) {
+        CxPlatFreeSelfSignedCert(SelfSignedCredConfig);
+    }
+    CxPlatUninitialize();
+    CxPlatSystemUnload();
+
+    return RetVal;
+}
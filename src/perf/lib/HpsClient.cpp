@@ -170,6 +170,17 @@ HpsClient::Wait(
     } else {
         WriteOutput("Result: %u HPS\n", HPS);
     }
+    if (StatsConnections != 0) {
+        WriteOutput(
+            "Handshake (avg us): TLS %llu, TLS offload %llu, cert validation %llu, key derive %llu, queue wait %llu, pacing blocked %llu, amplification blocked %llu\n",
+            (unsigned long long)(HandshakeTiming[0] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[1] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[2] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[3] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[4] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[5] / StatsConnections),
+            (unsigned long long)(HandshakeTiming[6] / StatsConnections));
+    }
     //WriteOutput("Result: %u HPS (%ull create, %ull start, %ull complete)\n",
     //    HPS, CreatedConnections, StartedConnections, CompletedConnections);
     Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT, 0);
@@ -196,21 +207,93 @@ HpsClient::GetExtraData(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+HpsClient::GetRunResult(
+    _Out_ PerfRunResult* Result
+    )
+{
+    CxPlatZeroMemory(Result, sizeof(*Result));
+    Result->Handshakes = CompletedConnections;
+    Result->ElapsedMicroseconds = MS_TO_US((uint64_t)RunTime);
+}
+
+//
+// Saves an address of a connected connection, unless another connection
+// already has. Only called from the connection's own callback, so the handle
+// is known to still be valid.
+//
+static
+void
+HpsCaptureAddr(
+    _In_ HQUIC ConnectionHandle,
+    _In_ uint32_t Param,
+    _Inout_ HpsCapturedAddr* Captured
+    )
+{
+    if (InterlockedCompareExchange16(
+            &Captured->State, HPS_ADDR_CAPTURING, HPS_ADDR_UNSET) != HPS_ADDR_UNSET) {
+        return;
+    }
+    uint32_t AddrLen = sizeof(QUIC_ADDR);
+    QUIC_STATUS Status =
+        MsQuic->GetParam(
+            ConnectionHandle,
+            QUIC_PARAM_LEVEL_CONNECTION,
+            Param,
+            &AddrLen,
+            &Captured->Addr);
+    InterlockedCompareExchange16(
+        &Captured->State,
+        QUIC_SUCCEEDED(Status) ? HPS_ADDR_SET : HPS_ADDR_UNSET,
+        HPS_ADDR_CAPTURING);
+}
+
 QUIC_STATUS
 HpsClient::ConnectionCallback(
-    _In_ HpsWorkerContext* Context,
+    _In_ HpsBindingContext* Binding,
     _In_ HQUIC ConnectionHandle,
     _Inout_ QUIC_CONNECTION_EVENT* Event
     ) {
+    HpsWorkerContext* Context = Binding->Worker;
     switch (Event->Type) {
-    case QUIC_CONNECTION_EVENT_CONNECTED:
+    case QUIC_CONNECTION_EVENT_CONNECTED: {
         InterlockedIncrement64((int64_t*)&CompletedConnections);
+        //
+        // Remember the binding and server address so later connections on
+        // this binding share the UDP socket and skip name resolution.
+        //
+        HpsCaptureAddr(ConnectionHandle, QUIC_PARAM_CONN_LOCAL_ADDRESS, &Binding->LocalAddr);
+        HpsCaptureAddr(ConnectionHandle, QUIC_PARAM_CONN_REMOTE_ADDRESS, &Context->RemoteAddr);
+        QUIC_STATISTICS_V2 Stats;
+        uint32_t StatsLength = sizeof(Stats);
+        if (QUIC_SUCCEEDED(
+            MsQuic->GetParam(
+                ConnectionHandle,
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_STATISTICS_V2,
+                &StatsLength,
+                &Stats))) {
+            const uint64_t Timing[ARRAYSIZE(HandshakeTiming)] = {
+                Stats.HandshakeTiming.TlsProcessTime,
+                Stats.HandshakeTiming.TlsOffloadTime,
+                Stats.HandshakeTiming.CertValidationTime,
+                Stats.HandshakeTiming.KeyDeriveTime,
+                Stats.HandshakeTiming.QueueWaitTime,
+                Stats.HandshakeTiming.PacingBlockedTime,
+                Stats.HandshakeTiming.AmplificationBlockedTime
+            };
+            for (uint32_t i = 0; i < ARRAYSIZE(HandshakeTiming); ++i) {
+                InterlockedExchangeAdd64((int64_t*)&HandshakeTiming[i], (int64_t)Timing[i]);
+            }
+            InterlockedIncrement64((int64_t*)&StatsConnections);
+        }
         MsQuic->ConnectionShutdown(ConnectionHandle, QUIC_CONNECTION_SHUTDOWN_FLAG_NONE, 0);
         InterlockedDecrement(&Context->OutstandingConnections);
         if (!Shutdown) {
             CxPlatEventSet(Context->WakeEvent);
         }
         break;
+    }
     case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
         if (!Shutdown && !Event->SHUTDOWN_COMPLETE.HandshakeCompleted) {
             InterlockedDecrement(&Context->OutstandingConnections);
@@ -246,18 +329,21 @@ HpsClient::StartConnection(
 
     QUIC_CONNECTION_CALLBACK_HANDLER Handler =
         [](HQUIC Conn, void* Context, QUIC_CONNECTION_EVENT* Event) -> QUIC_STATUS {
-            return ((HpsWorkerContext*)Context)->pThis->
+            return ((HpsBindingContext*)Context)->Worker->pThis->
                 ConnectionCallback(
-                    (HpsWorkerContext*)Context,
+                    (HpsBindingContext*)Context,
                     Conn,
                     Event);
         };
 
+    HpsBindingContext* Binding = &Context->Bindings[Context->NextBinding];
+    Context->NextBinding = (Context->NextBinding + 1) % HPS_BINDINGS_PER_WORKER;
+
     QUIC_STATUS Status =
         MsQuic->ConnectionOpen(
             Registration,
             Handler,
-            Context,
+            Binding,
             &Scope.Connection);
     if (QUIC_FAILED(Status)) {
         if (!Shutdown) {
@@ -283,15 +369,14 @@ HpsClient::StartConnection(
         return;
     }
 
-    bool LocalAddrSet = QuicAddrGetPort(&Context->LocalAddrs[Context->NextLocalAddr]) != 0;
-    if (LocalAddrSet) {
+    if (Binding->LocalAddr.IsSet()) {
         Status =
             MsQuic->SetParam(
                 Scope.Connection,
                 QUIC_PARAM_LEVEL_CONNECTION,
                 QUIC_PARAM_CONN_LOCAL_ADDRESS,
                 sizeof(QUIC_ADDR),
-                &Context->LocalAddrs[Context->NextLocalAddr]);
+                &Binding->LocalAddr.Addr);
         if (QUIC_FAILED(Status)) {
             if (!Shutdown) {
                 WriteOutput("SetParam(CONN_LOCAL_ADDRESS) failed, 0x%x\n", Status);
@@ -300,14 +385,14 @@ HpsClient::StartConnection(
         }
     }
 
-    if (Context->RemoteAddrSet) {
+    if (Context->RemoteAddr.IsSet()) {
         Status =
             MsQuic->SetParam(
                 Scope.Connection,
                 QUIC_PARAM_LEVEL_CONNECTION,
                 QUIC_PARAM_CONN_REMOTE_ADDRESS,
                 sizeof(QUIC_ADDR),
-                &Context->RemoteAddr);
+                &Context->RemoteAddr.Addr);
         if (QUIC_FAILED(Status)) {
             if (!Shutdown) {
                 WriteOutput("SetParam(CONN_REMOTE_ADDRESS) failed, 0x%x\n", Status);
@@ -330,40 +415,10 @@ HpsClient::StartConnection(
         return;
     }
 
-    if (!LocalAddrSet) {
-        uint32_t AddrLen = sizeof(QUIC_ADDR);
-        Status =
-            MsQuic->GetParam(
-                Scope.Connection,
-                QUIC_PARAM_LEVEL_CONNECTION,
-                QUIC_PARAM_CONN_LOCAL_ADDRESS,
-                &AddrLen,
-                &Context->LocalAddrs[Context->NextLocalAddr]);
-        if (QUIC_FAILED(Status)) {
-            if (!Shutdown) {
-                WriteOutput("GetParam(CONN_LOCAL_ADDRESS) failed, 0x%x\n", Status);
-            }
-        }
-    }
-
-    if (!Context->RemoteAddrSet) {
-        uint32_t AddrLen = sizeof(QUIC_ADDR);
-        Status =
-            MsQuic->GetParam(
-                Scope.Connection,
-                QUIC_PARAM_LEVEL_CONNECTION,
-                QUIC_PARAM_CONN_REMOTE_ADDRESS,
-                &AddrLen,
-                &Context->RemoteAddr);
-        if (QUIC_FAILED(Status)) {
-            if (!Shutdown) {
-                WriteOutput("GetParam(CONN_REMOTE_ADDRESS) failed, 0x%x\n", Status);
-            }
-        }
-        Context->RemoteAddrSet = true;
-    }
-
-    Context->NextLocalAddr = (Context->NextLocalAddr + 1) % HPS_BINDINGS_PER_WORKER;
+    //
+    // The connection belongs to its callback from here on, and may already be
+    // closed, so don't touch the handle again.
+    //
     InterlockedIncrement64((int64_t*)&StartedConnections);
     Scope.Connection = nullptr;
 }
@@ -17,20 +17,48 @@ Abstract:
 #include "PerfBase.h"
 #include "PerfCommon.h"
 
+//
+// State of an address learned from a connected connection. The address is
+// only read by the worker once it is HPS_ADDR_SET.
+//
+#define HPS_ADDR_UNSET      0
+#define HPS_ADDR_CAPTURING  1
+#define HPS_ADDR_SET        2
+
+struct HpsCapturedAddr {
+    QUIC_ADDR Addr;
+    short volatile State {HPS_ADDR_UNSET};
+    HpsCapturedAddr() {
+        CxPlatZeroMemory(&Addr, sizeof(Addr));
+    }
+    bool IsSet() {
+        return InterlockedCompareExchange16(&State, HPS_ADDR_SET, HPS_ADDR_SET) == HPS_ADDR_SET;
+    }
+};
+
+//
+// One of the local UDP bindings a worker cycles through. It is the context of
+// every connection started on it.
+//
+struct HpsBindingContext {
+    struct HpsWorkerContext* Worker {nullptr};
+    HpsCapturedAddr LocalAddr;
+};
+
 struct HpsWorkerContext {
     class HpsClient* pThis {nullptr};
-    QUIC_ADDR RemoteAddr;
-    QUIC_ADDR LocalAddrs[HPS_BINDINGS_PER_WORKER];
+    HpsCapturedAddr RemoteAddr;
+    HpsBindingContext Bindings[HPS_BINDINGS_PER_WORKER];
     uint16_t Processor {0};
     long OutstandingConnections {0};
-    uint32_t NextLocalAddr {0};
+    uint32_t NextBinding {0};
     CXPLAT_EVENT WakeEvent;
     CXPLAT_THREAD Thread;
-    bool RemoteAddrSet {false};
     bool ThreadStarted {false};
     HpsWorkerContext() {
-        CxPlatZeroMemory(&RemoteAddr, sizeof(RemoteAddr));
-        CxPlatZeroMemory(&LocalAddrs, sizeof(LocalAddrs));
+        for (uint32_t i = 0; i < HPS_BINDINGS_PER_WORKER; ++i) {
+            Bindings[i].Worker = this;
+        }
         CxPlatEventInitialize(&WakeEvent, FALSE, TRUE);
     }
     ~HpsWorkerContext() {
@@ -82,9 +110,14 @@ public:
         _Inout_ uint32_t* Length
         ) override;
 
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) override;
+
     QUIC_STATUS
     ConnectionCallback(
-        _In_ HpsWorkerContext* Context,
+        _In_ HpsBindingContext* Binding,
         _In_ HQUIC ConnectionHandle,
         _Inout_ QUIC_CONNECTION_EVENT* Event
         );
@@ -111,5 +144,7 @@ public:
     uint64_t CreatedConnections {0};
     uint64_t StartedConnections {0};
     uint64_t CompletedConnections {0};
+    uint64_t StatsConnections {0};
+    uint64_t HandshakeTiming[7] {0}; // Sums of QUIC_STATISTICS_V2.HandshakeTiming
     bool Shutdown {false};
 };
@@ -0,0 +1,498 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Perf Idle Client Implementation. Opens a large number of connections
+    that stay idle apart from keep-alives, and reports what holding them costs:
+    resident memory per connection, timer processing per worker tick and CPU
+    per keep-alive.
+
+--*/
+
+#include "IdleClient.h"
+
+#ifdef QUIC_CLOG
+#include "IdleClient.cpp.clog.h"
+#endif
+
+#ifdef _WIN32
+#include <psapi.h>
+#elif defined(CX_PLATFORM_DARWIN)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+static
+void
+PrintHelp(
+    ) {
+    WriteOutput(
+        "\n"
+        "Idle Client options:\n"
+        "\n"
+        "  -target:<####>              The target server to connect to.\n"
+        "  -runtime:<####>             The time (in ms) to stay idle once connected. (def:%u)\n"
+        "  -port:<####>                The UDP port of the server. (def:%u)\n"
+        "  -conns:<####>               The number of connections to open. (def:%u, max:%u)\n"
+        "  -keepalive:<####>           The keep-alive interval (in ms). Must be below the server's idle timeout. (def:%u)\n"
+        "  -parallel:<####>            The maximum number of handshakes in progress. (def:%u)\n"
+        "\n",
+        IDLE_DEFAULT_RUN_TIME,
+        PERF_DEFAULT_PORT,
+        IDLE_DEFAULT_CONNECTION_COUNT,
+        IDLE_MAX_CONNECTION_COUNT,
+        IDLE_DEFAULT_KEEP_ALIVE,
+        IDLE_DEFAULT_PARALLEL_COUNT
+        );
+}
+
+//
+// Returns the resident set (working set) size of the process, in bytes. With
+// the loopback datapath the server runs in-process, so this covers both ends
+// of the connections.
+//
+static
+uint64_t
+IdleProcessResidentBytes(
+    ) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS Counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters))) {
+        return 0;
+    }
+    return Counters.WorkingSetSize;
+#elif defined(CX_PLATFORM_DARWIN)
+    mach_task_basic_info_data_t Info;
+    mach_msg_type_number_t Count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(
+            mach_task_self(),
+            MACH_TASK_BASIC_INFO,
+            (task_info_t)&Info,
+            &Count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return Info.resident_size;
+#else
+    FILE* File = fopen("/proc/self/statm", "r");
+    if (File == nullptr) {
+        return 0;
+    }
+    unsigned long long TotalPages = 0, ResidentPages = 0;
+    const int Count = fscanf(File, "%llu %llu", &TotalPages, &ResidentPages);
+    fclose(File);
+    if (Count != 2) {
+        return 0;
+    }
+    return ResidentPages * (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+//
+// Returns the user plus kernel CPU time of the whole process, in us.
+//
+static
+uint64_t
+IdleProcessCpuTimeUs(
+    ) {
+#ifdef _WIN32
+    FILETIME Creation, Exit, Kernel, User;
+    if (!GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User)) {
+        return 0;
+    }
+    ULARGE_INTEGER KernelTime, UserTime;
+    KernelTime.LowPart = Kernel.dwLowDateTime;
+    KernelTime.HighPart = Kernel.dwHighDateTime;
+    UserTime.LowPart = User.dwLowDateTime;
+    UserTime.HighPart = User.dwHighDateTime;
+    return (KernelTime.QuadPart + UserTime.QuadPart) / 10; // 100ns units
+#else
+    struct rusage Usage;
+    if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+        return 0;
+    }
+    return
+        S_TO_US((uint64_t)Usage.ru_utime.tv_sec) + (uint64_t)Usage.ru_utime.tv_usec +
+        S_TO_US((uint64_t)Usage.ru_stime.tv_sec) + (uint64_t)Usage.ru_stime.tv_usec;
+#endif
+}
+
+QUIC_STATUS
+IdleClient::Init(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    ) {
+    if (argc > 0 && (IsArg(argv[0], "?") || IsArg(argv[0], "help"))) {
+        PrintHelp();
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    if (!Registration.IsValid()) {
+        return Registration.GetInitStatus();
+    }
+
+    const char* target;
+    if (!TryGetValue(argc, argv, "target", &target)) {
+        WriteOutput("Must specify '-target' argument!\n");
+        PrintHelp();
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    size_t Len = strlen(target);
+    Target.reset(new(std::nothrow) char[Len + 1]);
+    if (!Target.get()) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatCopyMemory(Target.get(), target, Len);
+    Target[Len] = '\0';
+
+    TryGetValue(argc, argv, "runtime", &RunTime);
+    TryGetValue(argc, argv, "port", &Port);
+    TryGetValue(argc, argv, "conns", &ConnectionCount);
+    TryGetValue(argc, argv, "keepalive", &KeepAliveMs);
+    TryGetValue(argc, argv, "parallel", &Parallel);
+
+    if (ConnectionCount == 0 || ConnectionCount > IDLE_MAX_CONNECTION_COUNT ||
+        KeepAliveMs == 0 || KeepAliveMs >= PERF_DEFAULT_IDLE_TIMEOUT ||
+        Parallel == 0) {
+        PrintHelp();
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    Configuration.reset(
+        new(std::nothrow) MsQuicConfiguration(
+            Registration,
+            MsQuicAlpn(PERF_ALPN),
+            MsQuicSettings()
+                .SetDisconnectTimeoutMs(PERF_DEFAULT_DISCONNECT_TIMEOUT)
+                .SetIdleTimeoutMs(PERF_DEFAULT_IDLE_TIMEOUT)
+                .SetKeepAliveIntervalMs(KeepAliveMs),
+            MsQuicCredentialConfig(
+                QUIC_CREDENTIAL_FLAG_CLIENT |
+                QUIC_CREDENTIAL_FLAG_NO_CERTIFICATE_VALIDATION)));
+    if (!Configuration.get()) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    if (!Configuration->IsValid()) {
+        return Configuration->GetInitStatus();
+    }
+
+    //
+    // Allocated up front, so it isn't counted as connection memory.
+    //
+    Connections.reset(new(std::nothrow) HQUIC[ConnectionCount]);
+    if (!Connections.get()) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(Connections.get(), sizeof(HQUIC) * ConnectionCount);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+IdleClient::Start(
+    _In_ CXPLAT_EVENT* StopEvent
+    ) {
+    CompletionEvent = StopEvent;
+
+    TakeSnapshot(&Baseline);
+
+    //
+    // Open the connections, with at most Parallel handshakes in progress at
+    // a time. Give up if none completes for IDLE_CONNECT_STALL_TIMEOUT.
+    //
+    uint32_t Started = 0;
+    while (Started < ConnectionCount) {
+        if ((uint32_t)OutstandingConnections >= Parallel) {
+            if (!CxPlatEventWaitWithTimeout(WakeEvent, IDLE_CONNECT_STALL_TIMEOUT)) {
+                WriteOutput("Connecting stalled!\n");
+                break;
+            }
+            continue;
+        }
+        InterlockedIncrement(&OutstandingConnections);
+        QUIC_STATUS Status = StartConnection(Started);
+        if (QUIC_FAILED(Status)) {
+            InterlockedDecrement(&OutstandingConnections);
+            return Status;
+        }
+        ++Started;
+    }
+
+    while (OutstandingConnections != 0) {
+        if (!CxPlatEventWaitWithTimeout(WakeEvent, IDLE_CONNECT_STALL_TIMEOUT)) {
+            WriteOutput("Connecting stalled!\n");
+            break;
+        }
+    }
+
+    ConnectTimeUs = CxPlatTimeDiff64(Baseline.TimeUs, CxPlatTimeUs64());
+    if (ConnectedConnections == 0) {
+        WriteOutput("Failed to connect to the server\n");
+        return QUIC_STATUS_CONNECTION_TIMEOUT;
+    }
+    if ((uint32_t)ConnectedConnections != ConnectionCount) {
+        WriteOutput(
+            "WARNING: Only %u (of %u) connections connected successfully.\n",
+            (uint32_t)ConnectedConnections,
+            ConnectionCount);
+    }
+
+    //
+    // Let the handshakes' trailing packets (acknowledgements, tickets,
+    // retired CIDs) settle before measuring the idle state.
+    //
+    WriteOutput("All Connected! Waiting for idle.\n");
+    CxPlatSleep(IDLE_SETTLE_TIME);
+    TakeSnapshot(&IdleStart);
+    WriteOutput("Idle...\n");
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+IdleClient::Wait(
+    _In_ int Timeout
+    ) {
+    if (Timeout == 0) {
+        Timeout = RunTime;
+    }
+
+    CxPlatEventWaitWithTimeout(*CompletionEvent, Timeout);
+
+    IdleSnapshot IdleEnd;
+    TakeSnapshot(&IdleEnd);
+
+    const uint64_t Connected = (uint64_t)ConnectedConnections;
+    const uint64_t IdleTimeUs = CxPlatTimeDiff64(IdleStart.TimeUs, IdleEnd.TimeUs);
+    const uint64_t ResidentBytes =
+        IdleEnd.ResidentBytes > Baseline.ResidentBytes ?
+            IdleEnd.ResidentBytes - Baseline.ResidentBytes : 0;
+    const uint64_t TimerTicks = IdleEnd.TimerTicks - IdleStart.TimerTicks;
+    const uint64_t TimerExpirations = IdleEnd.TimerExpirations - IdleStart.TimerExpirations;
+    const uint64_t TimerTimeUs = IdleEnd.TimerTimeUs - IdleStart.TimerTimeUs;
+    const uint64_t CpuTimeUs = IdleEnd.CpuTimeUs - IdleStart.CpuTimeUs;
+
+    //
+    // Every connection sends a PING each keep-alive interval when idle.
+    //
+    const uint64_t KeepAlives = Connected * IdleTimeUs / MS_TO_US((uint64_t)KeepAliveMs);
+
+    WriteOutput(
+        "Result: %u connections (%u failed) in %llu ms, %u lost while idle\n",
+        (uint32_t)ConnectedConnections,
+        (uint32_t)FailedConnections,
+        (unsigned long long)US_TO_MS(ConnectTimeUs),
+        (uint32_t)LostConnections);
+    WriteOutput(
+        "Memory: %llu bytes resident per connection (%llu MB in total)\n",
+        (unsigned long long)(ResidentBytes / Connected),
+        (unsigned long long)(ResidentBytes / (1024 * 1024)));
+    WriteOutput(
+        "Timers: %llu ticks, %llu ns per tick, %llu expirations per tick\n",
+        (unsigned long long)TimerTicks,
+        (unsigned long long)(TimerTicks == 0 ? 0 : TimerTimeUs * 1000 / TimerTicks),
+        (unsigned long long)(TimerTicks == 0 ? 0 : TimerExpirations / TimerTicks));
+    WriteOutput(
+        "Keep-alive: %llu sent, %llu datagrams, %llu ns CPU per keep-alive (%llu%% of a core)\n",
+        (unsigned long long)KeepAlives,
+        (unsigned long long)(IdleEnd.UdpSends - IdleStart.UdpSends),
+        (unsigned long long)(KeepAlives == 0 ? 0 : CpuTimeUs * 1000 / KeepAlives),
+        (unsigned long long)(IdleTimeUs == 0 ? 0 : CpuTimeUs * 100 / IdleTimeUs));
+
+    Shutdown = true;
+    Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT, 0);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+IdleClient::GetExtraDataMetadata(
+    _Out_ PerfExtraDataMetadata* Result
+    )
+{
+    Result->TestType = PerfTestType::IdleClient;
+    Result->ExtraDataLength = 0;
+}
+
+QUIC_STATUS
+IdleClient::GetExtraData(
+    _Out_writes_bytes_(*Length) uint8_t*,
+    _Inout_ uint32_t* Length
+    )
+{
+    *Length = 0;
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+IdleClient::GetRunResult(
+    _Out_ PerfRunResult* Result
+    )
+{
+    CxPlatZeroMemory(Result, sizeof(*Result));
+    Result->Handshakes = (uint64_t)ConnectedConnections;
+    Result->ElapsedMicroseconds = MS_TO_US((uint64_t)RunTime);
+}
+
+QUIC_STATUS
+IdleClient::ConnectionCallback(
+    _In_ HQUIC /* ConnectionHandle */,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    ) {
+    switch (Event->Type) {
+    case QUIC_CONNECTION_EVENT_CONNECTED:
+        InterlockedIncrement(&ConnectedConnections);
+        InterlockedDecrement(&OutstandingConnections);
+        CxPlatEventSet(WakeEvent);
+        break;
+    case QUIC_CONNECTION_EVENT_SHUTDOWN_COMPLETE:
+        //
+        // The handles are closed when the test is cleaned up.
+        //
+        if (!Event->SHUTDOWN_COMPLETE.HandshakeCompleted) {
+            InterlockedIncrement(&FailedConnections);
+            InterlockedDecrement(&OutstandingConnections);
+            CxPlatEventSet(WakeEvent);
+        } else if (!Shutdown) {
+            InterlockedIncrement(&LostConnections);
+        }
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+IdleClient::StartConnection(
+    uint32_t Index
+    ) {
+    QUIC_STATUS Status =
+        MsQuic->ConnectionOpen(
+            Registration,
+            [](HQUIC Conn, void* Context, QUIC_CONNECTION_EVENT* Event) -> QUIC_STATUS {
+                return ((IdleClient*)Context)->ConnectionCallback(Conn, Event);
+            },
+            this,
+            &Connections[Index]);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("ConnectionOpen failed, 0x%x\n", Status);
+        return Status;
+    }
+
+    //
+    // Spread the connections over a fixed number of shared UDP bindings, so
+    // that the number of connections isn't limited by local ports.
+    //
+    BOOLEAN Opt = TRUE;
+    Status =
+        MsQuic->SetParam(
+            Connections[Index],
+            QUIC_PARAM_LEVEL_CONNECTION,
+            QUIC_PARAM_CONN_SHARE_UDP_BINDING,
+            sizeof(Opt),
+            &Opt);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("SetParam(CONN_SHARE_UDP_BINDING) failed, 0x%x\n", Status);
+        return Status;
+    }
+
+    QUIC_ADDR* LocalAddr = &LocalAddrs[Index % IDLE_BINDING_COUNT];
+    const bool LocalAddrSet = Index >= IDLE_BINDING_COUNT;
+    if (LocalAddrSet) {
+        Status =
+            MsQuic->SetParam(
+                Connections[Index],
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                sizeof(QUIC_ADDR),
+                LocalAddr);
+        if (QUIC_FAILED(Status)) {
+            WriteOutput("SetParam(CONN_LOCAL_ADDRESS) failed, 0x%x\n", Status);
+            return Status;
+        }
+    }
+
+    Status =
+        MsQuic->ConnectionStart(
+            Connections[Index],
+            *Configuration,
+            QUIC_ADDRESS_FAMILY_UNSPEC,
+            Target.get(),
+            Port);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("ConnectionStart failed, 0x%x\n", Status);
+        return Status;
+    }
+
+    if (!LocalAddrSet) {
+        uint32_t AddrLen = sizeof(QUIC_ADDR);
+        Status =
+            MsQuic->GetParam(
+                Connections[Index],
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_LOCAL_ADDRESS,
+                &AddrLen,
+                LocalAddr);
+        if (QUIC_FAILED(Status)) {
+            WriteOutput("GetParam(CONN_LOCAL_ADDRESS) failed, 0x%x\n", Status);
+            return Status;
+        }
+    }
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+IdleClient::TakeSnapshot(
+    _Out_ IdleSnapshot* Snapshot
+    ) {
+    CxPlatZeroMemory(Snapshot, sizeof(*Snapshot));
+    Snapshot->TimeUs = CxPlatTimeUs64();
+    Snapshot->ResidentBytes = IdleProcessResidentBytes();
+    Snapshot->CpuTimeUs = IdleProcessCpuTimeUs();
+
+    uint64_t Counters[QUIC_PERF_COUNTER_MAX];
+    uint32_t BufferLength = sizeof(Counters);
+    if (QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_PERF_COUNTERS,
+            &BufferLength,
+            Counters))) {
+        Snapshot->UdpSends = Counters[QUIC_PERF_COUNTER_UDP_SEND];
+    }
+
+    BufferLength = 0;
+    if (MsQuic->GetParam(
+            Registration,
+            QUIC_PARAM_LEVEL_REGISTRATION,
+            QUIC_PARAM_REGISTRATION_WORKER_STATISTICS,
+            &BufferLength,
+            nullptr) != QUIC_STATUS_BUFFER_TOO_SMALL) {
+        return;
+    }
+    UniquePtr<QUIC_WORKER_STATISTICS[]> WorkerStats(
+        new(std::nothrow) QUIC_WORKER_STATISTICS[BufferLength / sizeof(QUIC_WORKER_STATISTICS)]);
+    if (WorkerStats.get() != nullptr &&
+        QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            Registration,
+            QUIC_PARAM_LEVEL_REGISTRATION,
+            QUIC_PARAM_REGISTRATION_WORKER_STATISTICS,
+            &BufferLength,
+            WorkerStats.get()))) {
+        for (uint32_t i = 0; i < BufferLength / sizeof(QUIC_WORKER_STATISTICS); ++i) {
+            Snapshot->TimerTicks += WorkerStats[i].TimerTicks;
+            Snapshot->TimerExpirations += WorkerStats[i].TimerExpirations;
+            Snapshot->TimerTimeUs += WorkerStats[i].TimerTimeUs;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC Perf Idle Client declaration. Defines the functions and
+    variables used in the IdleClient class.
+
+--*/
+
+
+#pragma once
+
+#include "PerfHelpers.h"
+#include "PerfBase.h"
+#include "PerfCommon.h"
+
+//
+// The process wide measurements the idle client compares before and after
+// connecting, and over the idle period.
+//
+struct IdleSnapshot {
+    uint64_t TimeUs;
+    uint64_t ResidentBytes;
+    uint64_t CpuTimeUs;
+    uint64_t UdpSends;
+    uint64_t TimerTicks;        // Sums over the client's workers.
+    uint64_t TimerExpirations;
+    uint64_t TimerTimeUs;
+};
+
+class IdleClient : public PerfBase {
+public:
+    IdleClient() {
+        CxPlatZeroMemory(&LocalAddrs, sizeof(LocalAddrs));
+        CxPlatEventInitialize(&WakeEvent, FALSE, FALSE);
+    }
+
+    ~IdleClient() override {
+        Shutdown = true;
+        if (Connections.get() != nullptr) {
+            Registration.Shutdown(QUIC_CONNECTION_SHUTDOWN_FLAG_SILENT, 0);
+            for (uint32_t i = 0; i < ConnectionCount; ++i) {
+                if (Connections[i] != nullptr) {
+                    MsQuic->ConnectionClose(Connections[i]);
+                }
+            }
+        }
+        CxPlatEventUninitialize(WakeEvent);
+    }
+
+    QUIC_STATUS
+    Init(
+        _In_ int argc,
+        _In_reads_(argc) _Null_terminated_ char* argv[]
+        ) override;
+
+    QUIC_STATUS
+    Start(
+        _In_ CXPLAT_EVENT* StopEvent
+        ) override;
+
+    QUIC_STATUS
+    Wait(
+        _In_ int Timeout
+        ) override;
+
+    void
+    GetExtraDataMetadata(
+        _Out_ PerfExtraDataMetadata* Result
+        ) override;
+
+    QUIC_STATUS
+    GetExtraData(
+        _Out_writes_bytes_(*Length) uint8_t* Data,
+        _Inout_ uint32_t* Length
+        ) override;
+
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) override;
+
+    QUIC_STATUS
+    ConnectionCallback(
+        _In_ HQUIC ConnectionHandle,
+        _Inout_ QUIC_CONNECTION_EVENT* Event
+        );
+
+private:
+
+    QUIC_STATUS StartConnection(uint32_t Index);
+
+    void TakeSnapshot(IdleSnapshot* Snapshot);
+
+    MsQuicRegistration Registration;
+    UniquePtr<MsQuicConfiguration> Configuration;
+    UniquePtr<HQUIC[]> Connections;
+    QUIC_ADDR LocalAddrs[IDLE_BINDING_COUNT];
+    uint16_t Port {PERF_DEFAULT_PORT};
+    UniquePtr<char[]> Target;
+    uint32_t RunTime {IDLE_DEFAULT_RUN_TIME};
+    uint32_t ConnectionCount {IDLE_DEFAULT_CONNECTION_COUNT};
+    uint32_t KeepAliveMs {IDLE_DEFAULT_KEEP_ALIVE};
+    uint32_t Parallel {IDLE_DEFAULT_PARALLEL_COUNT};
+    CXPLAT_EVENT* CompletionEvent {nullptr};
+    CXPLAT_EVENT WakeEvent;
+    long OutstandingConnections {0};
+    long ConnectedConnections {0};
+    long FailedConnections {0};
+    long LostConnections {0};       // Shut down after connecting.
+    uint64_t ConnectTimeUs {0};
+    IdleSnapshot Baseline;          // Before connecting.
+    IdleSnapshot IdleStart;
+    bool Shutdown {false};
+};
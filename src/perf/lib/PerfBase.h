@@ -19,7 +19,8 @@ enum class PerfTestType {
     Server,
     ThroughputClient,
     RpsClient,
-    HpsClient
+    HpsClient,
+    IdleClient
 };
 
 struct PerfExtraDataMetadata {
@@ -27,6 +28,17 @@ struct PerfExtraDataMetadata {
     uint32_t ExtraDataLength;
 };
 
+//
+// The work completed by a client run. Only the counters that apply to the
+// test type are non-zero.
+//
+struct PerfRunResult {
+    uint64_t Bytes;
+    uint64_t Requests;
+    uint64_t Handshakes;
+    uint64_t ElapsedMicroseconds;
+};
+
 struct PerfBase {
     //
     // Virtual destructor so we can destruct the base class
@@ -83,4 +95,13 @@ struct PerfBase {
         _Out_writes_(Length) uint8_t* Data,
         _Inout_ uint32_t* Length
         ) = 0;
+
+    //
+    // Get the work completed by the run. Only valid after Wait returns.
+    //
+    virtual
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) = 0;
 };
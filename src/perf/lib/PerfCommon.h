@@ -32,8 +32,18 @@ Abstract:
 #define RPS_DEFAULT_RESPONSE_LENGTH         0
 #define RPS_ALL_CONNECT_TIMEOUT             10000
 #define RPS_IDLE_WAIT                       2000
+#define RPS_MAX_BATCH_SIZE                  64
 
 #define HPS_DEFAULT_RUN_TIME                (10 * 1000)
 #define HPS_DEFAULT_IDLE_TIMEOUT            (5 * 1000)
 #define HPS_DEFAULT_PARALLEL_COUNT          100
 #define HPS_BINDINGS_PER_WORKER             10
+
+#define IDLE_DEFAULT_RUN_TIME               (30 * 1000)
+#define IDLE_DEFAULT_CONNECTION_COUNT       10000
+#define IDLE_MAX_CONNECTION_COUNT           (1000 * 1000)
+#define IDLE_DEFAULT_KEEP_ALIVE             (10 * 1000) // Must be below PERF_DEFAULT_IDLE_TIMEOUT
+#define IDLE_DEFAULT_PARALLEL_COUNT         1000
+#define IDLE_BINDING_COUNT                  64
+#define IDLE_CONNECT_STALL_TIMEOUT          (10 * 1000)
+#define IDLE_SETTLE_TIME                    2000
@@ -97,6 +97,14 @@ PerfServer::GetExtraData(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+PerfServer::GetRunResult(
+    _Out_ PerfRunResult* Result
+    )
+{
+    CxPlatZeroMemory(Result, sizeof(*Result));
+}
+
 QUIC_STATUS
 PerfServer::ListenerCallback(
     _In_ HQUIC /*ListenerHandle*/,
@@ -28,6 +28,14 @@ public:
     }
 
     ~PerfServer() override {
+        //
+        // Server side connections may still be closing, and their stream
+        // callbacks use the stream context pool and the data buffer. Closing
+        // the registration waits for them, so do it before freeing either.
+        //
+        Listener.Close();
+        Configuration.Close();
+        Registration.Close();
         if (DataBuffer) {
             CXPLAT_FREE(DataBuffer, QUIC_POOL_PERF);
         }
@@ -60,6 +68,11 @@ public:
         _Inout_ uint32_t* Length
         ) override;
 
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) override;
+
 private:
 
     struct StreamContext {
@@ -111,6 +124,7 @@ private:
         );
 
     QUIC_STATUS InitStatus;
+    QuicPoolAllocator<StreamContext> StreamContextAllocator;
     MsQuicRegistration Registration {true};
     MsQuicAlpn Alpn {PERF_ALPN};
     MsQuicConfiguration Configuration {
@@ -125,7 +139,6 @@ private:
     uint16_t Port {PERF_DEFAULT_PORT};
     CXPLAT_EVENT* StopEvent {nullptr};
     QUIC_BUFFER* DataBuffer {nullptr};
-    QuicPoolAllocator<StreamContext> StreamContextAllocator;
 
     TcpEngine Engine;
     TcpServer Server;
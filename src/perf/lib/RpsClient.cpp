@@ -32,12 +32,14 @@ PrintHelp(
         "  -response:<####>            The length of request payloads. (def:%u)\n"
         "  -threads:<####>             The number of threads to use. Defaults and capped to number of cores\n"
         "  -affinitize:<0/1>           Affinitizes threads to a core. (def:0)\n"
+        "  -batch:<####>               Queues up to this many requests per connection with a single StreamSendBatch call. (def:0, max:%u)\n"
         "\n",
         RPS_DEFAULT_RUN_TIME,
         PERF_DEFAULT_PORT,
         RPS_DEFAULT_CONNECTION_COUNT,
         RPS_DEFAULT_REQUEST_LENGTH,
-        RPS_DEFAULT_RESPONSE_LENGTH
+        RPS_DEFAULT_RESPONSE_LENGTH,
+        RPS_MAX_BATCH_SIZE
         );
 }
 
@@ -77,6 +79,10 @@ RpsClient::Init(
     TryGetValue(argc, argv, "requests", &RequestCount);
     TryGetValue(argc, argv, "request", &RequestLength);
     TryGetValue(argc, argv, "response", &ResponseLength);
+    TryGetValue(argc, argv, "batch", &BatchSize);
+    if (BatchSize > RPS_MAX_BATCH_SIZE) {
+        BatchSize = RPS_MAX_BATCH_SIZE;
+    }
 
     uint32_t Affinitize;
     if (TryGetValue(argc, argv, "affinitize", &Affinitize)) {
@@ -133,7 +139,16 @@ CXPLAT_THREAD_CALLBACK(RpsWorkerThread, Context)
             InterlockedDecrement((long*)&Worker->RequestCount);
             auto Connection = Worker->GetConnection();
             if (!Connection) break; // Means we're shutting down
-            Connection->SendRequest(Worker->RequestCount != 0);
+            if (Worker->Client->BatchSize != 0) {
+                uint32_t Count = 1;
+                while (Count < Worker->Client->BatchSize && Worker->RequestCount != 0) {
+                    InterlockedDecrement((long*)&Worker->RequestCount);
+                    ++Count;
+                }
+                Connection->SendRequests(Count);
+            } else {
+                Connection->SendRequest(Worker->RequestCount != 0);
+            }
         }
         CxPlatEventWaitForever(Worker->WakeEvent);
     }
@@ -340,6 +355,17 @@ RpsClient::GetExtraData(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+RpsClient::GetRunResult(
+    _Out_ PerfRunResult* Result
+    )
+{
+    CxPlatZeroMemory(Result, sizeof(*Result));
+    Result->Requests = CachedCompletedRequests;
+    Result->Bytes = CachedCompletedRequests * ((uint64_t)RequestLength + ResponseLength);
+    Result->ElapsedMicroseconds = MS_TO_US((uint64_t)RunTime);
+}
+
 QUIC_STATUS
 RpsClient::ConnectionCallback(
     _In_ HQUIC /* ConnectionHandle */,
@@ -448,6 +474,65 @@ RpsConnectionContext::SendRequest(bool DelaySend) {
     }
 }
 
+void
+RpsConnectionContext::SendRequests(uint32_t Count) {
+
+    QUIC_STREAM_CALLBACK_HANDLER Handler =
+        [](HQUIC Stream, void* Context, QUIC_STREAM_EVENT* Event) -> QUIC_STATUS {
+            StreamContext* Ctx = reinterpret_cast<StreamContext*>(Context);
+            return Ctx->Connection->
+                StreamCallback(
+                    Ctx,
+                    Stream,
+                    Event);
+        };
+
+    CXPLAT_DBG_ASSERT(Count <= RPS_MAX_BATCH_SIZE);
+    QUIC_STREAM_SEND_BATCH_ENTRY Entries[RPS_MAX_BATCH_SIZE];
+    StreamContext* StrmContexts[RPS_MAX_BATCH_SIZE];
+    uint32_t EntryCount = 0;
+
+    uint64_t StartTime = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Count; ++i) {
+        StreamContext* StrmContext = Worker->Client->StreamContextAllocator.Alloc(this, StartTime);
+        HQUIC Stream = nullptr;
+        if (QUIC_FAILED(
+            MsQuic->StreamOpen(
+                Handle,
+                QUIC_STREAM_OPEN_FLAG_NONE,
+                Handler,
+                StrmContext,
+                &Stream))) {
+            Worker->Client->StreamContextAllocator.Free(StrmContext);
+            continue;
+        }
+        InterlockedIncrement64((int64_t*)&Worker->Client->StartedRequests);
+        Entries[EntryCount].Stream = Stream;
+        Entries[EntryCount].Buffers = Worker->Client->RequestBuffer;
+        Entries[EntryCount].BufferCount = 1;
+        Entries[EntryCount].Flags = QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN;
+        Entries[EntryCount].ClientSendContext = nullptr;
+        StrmContexts[EntryCount] = StrmContext;
+        ++EntryCount;
+    }
+
+    if (EntryCount == 0) {
+        return;
+    }
+
+    //
+    // All the streams are opened, started and sent on with one operation on
+    // the connection.
+    //
+    (void)MsQuic->StreamSendBatch(Entries, EntryCount);
+    for (uint32_t i = 0; i < EntryCount; ++i) {
+        if (QUIC_FAILED(Entries[i].Status)) {
+            MsQuic->StreamClose(Entries[i].Stream);
+            Worker->Client->StreamContextAllocator.Free(StrmContexts[i]);
+        }
+    }
+}
+
 void
 RpsWorkerContext::QueueSendRequest() {
     if (Client->Running) {
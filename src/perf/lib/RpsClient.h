@@ -46,6 +46,7 @@ struct RpsConnectionContext {
         _Inout_ QUIC_STREAM_EVENT* Event
         );
     void SendRequest(bool DelaySend);
+    void SendRequests(uint32_t Count);
 };
 
 struct RpsWorkerContext {
@@ -143,6 +144,11 @@ public:
         _Inout_ uint32_t* Length
         ) override;
 
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) override;
+
     QUIC_STATUS
     ConnectionCallback(
         _In_ HQUIC ConnectionHandle,
@@ -168,6 +174,7 @@ public:
     uint32_t RequestCount {RPS_DEFAULT_CONNECTION_COUNT * 2};
     uint32_t RequestLength {RPS_DEFAULT_REQUEST_LENGTH};
     uint32_t ResponseLength {RPS_DEFAULT_RESPONSE_LENGTH};
+    uint32_t BatchSize {0};
 
     struct QuicBufferScopeQuicAlloc {
         QUIC_BUFFER* Buffer;
@@ -480,7 +480,8 @@ BOOLEAN
 TcpConnection::TlsReceiveTicketCallback(
     _In_ QUIC_CONNECTION* /* Context */,
     _In_ uint32_t TicketLength,
-    _In_reads_(TicketLength) const uint8_t* /* Ticket */
+    _In_reads_(TicketLength) const uint8_t* /* Ticket */,
+    _Inout_opt_ BOOLEAN* /* EarlyDataAccepted */
     )
 {
     UNREFERENCED_PARAMETER(TicketLength);
@@ -239,7 +239,8 @@ class TcpConnection {
     TlsReceiveTicketCallback(
         _In_ QUIC_CONNECTION* Connection,
         _In_ uint32_t TicketLength,
-        _In_reads_(TicketLength) const uint8_t* Ticket
+        _In_reads_(TicketLength) const uint8_t* Ticket,
+        _Inout_opt_ BOOLEAN* EarlyDataAccepted
         );
     ~TcpConnection();
     void Queue() { Worker->QueueConnection(this); }
@@ -216,6 +216,16 @@ ThroughputClient::GetExtraData(
     return QUIC_STATUS_SUCCESS;
 }
 
+void
+ThroughputClient::GetRunResult(
+    _Out_ PerfRunResult* Result
+    )
+{
+    CxPlatZeroMemory(Result, sizeof(*Result));
+    Result->Bytes = CompletedBytes;
+    Result->ElapsedMicroseconds = CompletedMicroseconds;
+}
+
 QUIC_STATUS
 ThroughputClient::StartQuic()
 {
@@ -470,6 +480,8 @@ ThroughputClient::OnStreamShutdownComplete(
     StrmContext->EndTime = CxPlatTimeUs64();
     uint64_t ElapsedMicroseconds = StrmContext->EndTime - StrmContext->StartTime;
     uint32_t SendRate = (uint32_t)((StrmContext->BytesCompleted * 1000 * 1000 * 8) / (1000 * ElapsedMicroseconds));
+    CompletedBytes = StrmContext->BytesCompleted;
+    CompletedMicroseconds = ElapsedMicroseconds;
 
     if (StrmContext->Complete) {
         WriteOutput(
@@ -58,6 +58,11 @@ public:
         _Inout_ uint32_t* Length
         ) override;
 
+    void
+    GetRunResult(
+        _Out_ PerfRunResult* Result
+        ) override;
+
 private:
 
     struct StreamContext {
@@ -130,6 +135,8 @@ private:
     uint64_t UploadLength {0};
     uint64_t DownloadLength {0};
     uint32_t IoSize {0};
+    uint64_t CompletedBytes {0};
+    uint64_t CompletedMicroseconds {0};
 
     TcpEngine Engine;
     CXPLAT_LOCK TcpLock;
@@ -14,6 +14,9 @@ Abstract:
 #include "ThroughputClient.h"
 #include "RpsClient.h"
 #include "HpsClient.h"
+#ifndef _KERNEL_MODE
+#include "IdleClient.h"
+#endif
 
 #ifdef QUIC_CLOG
 #include "quicmain.cpp.clog.h"
@@ -72,6 +75,84 @@ public:
 
 QuicPerfWatchdog* Watchdog;
 
+#ifdef QUIC_LOOPBACK_DATAPATH
+//
+// With the loopback datapath, the client can only reach a server in the same
+// process, so client mode runs one alongside.
+//
+PerfServer* LoopbackServer;
+CXPLAT_EVENT LoopbackServerStopEvent;
+
+static
+QUIC_STATUS
+LoopbackStart(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[],
+    _In_ const QUIC_CREDENTIAL_CONFIG* SelfSignedCredConfig
+    ) {
+    CXPLAT_DATAPATH_EMULATION Emulation;
+    CxPlatZeroMemory(&Emulation, sizeof(Emulation));
+    TryGetValue(argc, argv, "delay", &Emulation.DelayMs);
+    TryGetValue(argc, argv, "ratelimit", &Emulation.RateLimitMbps);
+    TryGetValue(argc, argv, "queuelimit", &Emulation.QueueLimitPackets);
+    TryGetValue(argc, argv, "randomloss", &Emulation.RandomLossDenominator);
+    TryGetValue(argc, argv, "randomreorder", &Emulation.RandomReorderDenominator);
+    TryGetValue(argc, argv, "reorderdelay", &Emulation.ReorderDelayDeltaMs);
+    TryGetValue(argc, argv, "jitter", &Emulation.JitterMs);
+    TryGetValue(argc, argv, "burstloss", &Emulation.BurstLossDenominator);
+    TryGetValue(argc, argv, "burstlen", &Emulation.BurstLossLength);
+    TryGetValue(argc, argv, "ratebucket", &Emulation.RateBucketBytes);
+
+    QUIC_STATUS Status =
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_LOOPBACK_EMULATION,
+            sizeof(Emulation),
+            &Emulation);
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Failed to configure loopback emulation: %d\n", Status);
+        return Status;
+    }
+
+    if (ServerMode) {
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    LoopbackServer = new(std::nothrow) PerfServer(SelfSignedCredConfig);
+    if (LoopbackServer == nullptr) {
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatEventInitialize(&LoopbackServerStopEvent, TRUE, FALSE);
+    Status = LoopbackServer->Init(argc, argv);
+    if (QUIC_SUCCEEDED(Status)) {
+        Status = LoopbackServer->Start(&LoopbackServerStopEvent);
+    }
+    if (QUIC_FAILED(Status)) {
+        WriteOutput("Loopback Server Failed To Start: %d\n", Status);
+        delete LoopbackServer;
+        LoopbackServer = nullptr;
+        CxPlatEventUninitialize(LoopbackServerStopEvent);
+    }
+
+    return Status;
+}
+
+static
+void
+LoopbackStop(
+    ) {
+    if (LoopbackServer != nullptr) {
+        CxPlatEventSet(LoopbackServerStopEvent);
+        LoopbackServer->Wait(0);
+        delete LoopbackServer;
+        LoopbackServer = nullptr;
+        CxPlatEventUninitialize(LoopbackServerStopEvent);
+    }
+}
+#endif
+
 static
 void
 PrintHelp(
@@ -84,10 +165,27 @@ PrintHelp(
         "\n"
         "  -port:<####>                The UDP port of the server. (def:%u)\n"
         "\n"
-        "Client: quicperf -TestName:<Throughput|RPS|HPS> [options]\n"
+        "Client: quicperf -TestName:<Throughput|RPS|HPS|Idle> [options]\n"
         "\n",
         PERF_DEFAULT_PORT
         );
+#ifdef QUIC_LOOPBACK_DATAPATH
+    WriteOutput(
+        "Loopback datapath (client mode also runs the server in-process):\n"
+        "\n"
+        "  -delay:<####>               The emulated one-way delay, in ms. (def:0)\n"
+        "  -ratelimit:<####>           The emulated bottleneck rate, in Mbps. (def:0 - unlimited)\n"
+        "  -queuelimit:<####>          The emulated bottleneck queue length, in packets. (def:0 - unlimited)\n"
+        "  -randomloss:<####>          Drops 1 in N packets at random. (def:0 - none)\n"
+        "  -randomreorder:<####>       Reorders 1 in N packets at random. (def:0 - none)\n"
+        "  -reorderdelay:<####>        The extra delay of reordered packets, in ms. (def:0)\n"
+        "  -jitter:<####>              The maximum random extra delay, in ms. Doesn't reorder. (def:0)\n"
+        "  -burstloss:<####>           Starts a burst of losses on 1 in N packets. (def:0 - none)\n"
+        "  -burstlen:<####>            The mean number of packets lost per burst. (def:1)\n"
+        "  -ratebucket:<####>          The token bucket size of the bottleneck, in bytes. (def:0 - none)\n"
+        "\n"
+        );
+#endif
 }
 
 QUIC_STATUS
@@ -158,6 +256,16 @@ QuicMainStart(
         return Status;
     }
 
+#ifdef QUIC_LOOPBACK_DATAPATH
+    if (QUIC_FAILED(Status = LoopbackStart(argc, argv, SelfSignedCredConfig))) {
+        delete MsQuic;
+        MsQuic = nullptr;
+        delete Watchdog;
+        Watchdog = nullptr;
+        return Status;
+    }
+#endif
+
     if (ServerMode) {
         TestToRun = new(std::nothrow) PerfServer(SelfSignedCredConfig);
     } else {
@@ -167,6 +275,10 @@ QuicMainStart(
             TestToRun = new(std::nothrow) RpsClient;
         } else if (IsValue(TestName, "HPS")) {
             TestToRun = new(std::nothrow) HpsClient;
+#ifndef _KERNEL_MODE
+        } else if (IsValue(TestName, "Idle")) {
+            TestToRun = new(std::nothrow) IdleClient;
+#endif
         } else {
             PrintHelp();
             delete MsQuic;
@@ -196,6 +308,9 @@ QuicMainStart(
 
     delete TestToRun;
     TestToRun = nullptr;
+#ifdef QUIC_LOOPBACK_DATAPATH
+    LoopbackStop();
+#endif
     delete MsQuic;
     MsQuic = nullptr;
     delete Watchdog;
@@ -215,6 +330,9 @@ QuicMainFree(
 {
     delete TestToRun;
     TestToRun = nullptr;
+#ifdef QUIC_LOOPBACK_DATAPATH
+    LoopbackStop();
+#endif
     delete MsQuic;
     MsQuic = nullptr;
 
@@ -0,0 +1,1540 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    QUIC in-process loopback datapath. Instead of using OS sockets, every UDP
+    socket is an entry in a per-datapath port table and sends are handed
+    directly to the receiving socket's delivery worker through a bounded,
+    lock-free ring. This allows client and server to run in the same process
+    with deterministic, network-free performance.
+
+    Optionally, the datapath emulates a network path (see
+    CXPLAT_DATAPATH_EMULATION): a fixed one-way delay, a bottleneck rate with a
+    tail-drop queue, random loss and random reordering. These mirror the knobs
+    of the duonic driver used by scripts/emulated-performance.ps1. On top of
+    those, it can add jitter, bursty (Gilbert-Elliott) loss and a token bucket
+    in front of the bottleneck.
+
+    Only UDP is supported. Delivery timers have millisecond granularity, so
+    emulated delays may be overshot by up to a millisecond (plus scheduler
+    latency).
+
+Environment:
+
+    Any user mode
+
+--*/
+
+#include "platform_internal.h"
+#ifdef QUIC_CLOG
+#include "datapath_loopback.c.clog.h"
+#endif
+
+//
+// The maximum number of datagrams in a single send context.
+//
+#define CXPLAT_MAX_BATCH_SEND 16
+
+//
+// The maximum number of datagrams indicated in a single receive upcall.
+//
+#define CXPLAT_MAX_RECV_CHAIN 32
+
+//
+// The number of slots in each delivery worker's ring. Must be a power of 2.
+// A full ring drops the datagram, like an overflowing NIC receive ring.
+//
+#define CXPLAT_LOOPBACK_RING_SIZE 4096
+
+//
+// The range of ports used for sockets bound to port 0.
+//
+#define CXPLAT_LOOPBACK_EPHEMERAL_PORT_START 49152
+#define CXPLAT_LOOPBACK_EPHEMERAL_PORT_COUNT (UINT16_MAX - CXPLAT_LOOPBACK_EPHEMERAL_PORT_START + 1)
+
+//
+// The number of ports in the port table.
+//
+#define CXPLAT_LOOPBACK_PORT_COUNT (UINT16_MAX + 1)
+
+CXPLAT_STATIC_ASSERT(
+    (CXPLAT_LOOPBACK_RING_SIZE & (CXPLAT_LOOPBACK_RING_SIZE - 1)) == 0,
+    "Ring size must be a power of 2");
+
+typedef struct CXPLAT_DATAPATH_WORKER CXPLAT_DATAPATH_WORKER;
+
+//
+// A single datagram. It is allocated by the sender as a send buffer and, on
+// send, handed as is to the receiving socket, so the payload is never copied.
+//
+typedef struct CXPLAT_DATAPATH_RECV_BLOCK {
+
+    //
+    // The pool owning this block.
+    //
+    CXPLAT_POOL* OwningPool;
+
+    //
+    // Link in the delivery worker's time-sorted pending list.
+    //
+    CXPLAT_LIST_ENTRY Link;
+
+    //
+    // The destination socket. Holds a rundown reference until delivered or
+    // dropped.
+    //
+    CXPLAT_SOCKET* Socket;
+
+    //
+    // The time (in microseconds) at which the datagram may be delivered.
+    //
+    uint64_t DeliveryTimeUs;
+
+    //
+    // The receive data indicated to the upper layer.
+    //
+    CXPLAT_RECV_DATA RecvData;
+
+    //
+    // The addresses of the datagram.
+    //
+    CXPLAT_TUPLE Tuple;
+
+    //
+    // The UDP payload.
+    //
+    uint8_t Buffer[MAX_UDP_PAYLOAD_LENGTH];
+
+    //
+    // This follows the recv block.
+    //
+    // CXPLAT_RECV_PACKET RecvContext;
+
+} CXPLAT_DATAPATH_RECV_BLOCK;
+
+//
+// Send context.
+//
+typedef struct CXPLAT_SEND_DATA {
+
+    //
+    // The worker whose pools back this send context.
+    //
+    CXPLAT_DATAPATH_WORKER* Owner;
+
+    //
+    // The type of ECN markings needed for send.
+    //
+    CXPLAT_ECN_TYPE ECN;
+
+    //
+    // The number of buffers in use.
+    //
+    uint8_t BufferCount;
+
+    //
+    // The send buffers and the blocks backing them.
+    //
+    QUIC_BUFFER Buffers[CXPLAT_MAX_BATCH_SEND];
+    CXPLAT_DATAPATH_RECV_BLOCK* Blocks[CXPLAT_MAX_BATCH_SEND];
+
+} CXPLAT_SEND_DATA;
+
+//
+// A slot in a delivery ring. Sequence tracks which lap of the ring the slot is
+// ready for, which lets producers claim slots with a single compare-exchange.
+//
+typedef struct CXPLAT_LOOPBACK_RING_SLOT {
+
+    int64_t volatile Sequence;
+    CXPLAT_DATAPATH_RECV_BLOCK* Block;
+
+} CXPLAT_LOOPBACK_RING_SLOT;
+
+//
+// Bounded multi-producer, single-consumer ring of datagrams.
+//
+typedef struct CXPLAT_LOOPBACK_RING {
+
+    //
+    // The next position to be claimed by a producer.
+    //
+    int64_t volatile EnqueuePosition;
+
+    //
+    // The next position to be consumed. Only used by the delivery worker.
+    //
+    int64_t DequeuePosition;
+
+    CXPLAT_LOOPBACK_RING_SLOT Slots[CXPLAT_LOOPBACK_RING_SIZE];
+
+} CXPLAT_LOOPBACK_RING;
+
+//
+// A delivery worker. Each worker owns a thread that indicates datagrams to
+// the sockets assigned to it, in delivery time order.
+//
+typedef struct CXPLAT_DATAPATH_WORKER {
+
+    //
+    // A pointer to the datapath.
+    //
+    CXPLAT_DATAPATH* Datapath;
+
+    //
+    // The index of the worker in the datapath's array. Used as the partition
+    // index of the datagrams it delivers.
+    //
+    uint32_t Index;
+
+    //
+    // Set while the worker is (about to be) blocked on WakeEvent.
+    //
+    short volatile Sleeping;
+
+    //
+    // Set when a socket was deleted and its pending datagrams must be dropped.
+    //
+    short volatile PurgeNeeded;
+
+    //
+    // Signaled to wake the worker.
+    //
+    CXPLAT_EVENT WakeEvent;
+
+    //
+    // The delivery thread.
+    //
+    CXPLAT_THREAD Thread;
+
+    //
+    // Datagrams drained from the ring, sorted by delivery time. Only used by
+    // the delivery thread.
+    //
+    CXPLAT_LIST_ENTRY PendingList;
+
+    //
+    // Pool of datagram blocks, allocated for send buffers.
+    //
+    CXPLAT_POOL RecvBlockPool;
+
+    //
+    // Pool of send contexts.
+    //
+    CXPLAT_POOL SendDataPool;
+
+    //
+    // Datagrams queued for delivery by this worker.
+    //
+    CXPLAT_LOOPBACK_RING Ring;
+
+} CXPLAT_DATAPATH_WORKER;
+
+//
+// Loopback socket.
+//
+typedef struct CXPLAT_SOCKET {
+
+    //
+    // Synchronization mechanism for cleanup. Every datagram in flight to this
+    // socket holds a reference.
+    //
+    CXPLAT_RUNDOWN_REF Rundown;
+
+    //
+    // A pointer to datapath object.
+    //
+    CXPLAT_DATAPATH* Datapath;
+
+    //
+    // The client context for this socket.
+    //
+    void* ClientContext;
+
+    //
+    // The local address for the socket.
+    //
+    QUIC_ADDR LocalAddress;
+
+    //
+    // The remote address for the socket.
+    //
+    QUIC_ADDR RemoteAddress;
+
+    //
+    // Indicates the socket is shut down.
+    //
+    BOOLEAN volatile Shutdown;
+
+    //
+    // Flag indicates the socket has a default remote destination.
+    //
+    BOOLEAN HasFixedRemoteAddress;
+
+    //
+    // Flag indicates the socket is being used for PCP.
+    //
+    BOOLEAN PcpBinding;
+
+    //
+    // The MTU for this socket.
+    //
+    uint16_t Mtu;
+
+    //
+    // The worker delivering to this socket, if it has a fixed remote address.
+    //
+    uint32_t WorkerIndex;
+
+    //
+    // Protects Link.
+    //
+    CXPLAT_DISPATCH_LOCK LinkLock;
+
+    //
+    // The emulated path for datagrams sent on this socket.
+    //
+    CXPLAT_EMULATED_LINK Link;
+
+} CXPLAT_SOCKET;
+
+//
+// Represents a datapath object.
+//
+typedef struct CXPLAT_DATAPATH {
+
+    //
+    // A reference rundown on the datapath sockets.
+    //
+    CXPLAT_RUNDOWN_REF SocketsRundown;
+
+    //
+    // If datapath is shutting down.
+    //
+    BOOLEAN volatile Shutdown;
+
+    //
+    // UDP handlers.
+    //
+    CXPLAT_UDP_DATAPATH_CALLBACKS UdpHandlers;
+
+    //
+    // The length of recv context used by MsQuic.
+    //
+    uint32_t ClientRecvContextLength;
+
+    //
+    // The network emulation settings.
+    //
+    CXPLAT_DATAPATH_EMULATION Emulation;
+
+    //
+    // Protects the port table.
+    //
+    CXPLAT_DISPATCH_RW_LOCK PortsLock;
+
+    //
+    // The next ephemeral port to try.
+    //
+    uint16_t NextEphemeralPort;
+
+    //
+    // The sockets bound to each port.
+    //
+    CXPLAT_SOCKET** Ports;
+
+    //
+    // The delivery workers.
+    //
+    uint32_t WorkerCount;
+    CXPLAT_DATAPATH_WORKER Workers[];
+
+} CXPLAT_DATAPATH;
+
+CXPLAT_THREAD_CALLBACK(CxPlatDataPathWorkerThread, Context);
+
+//
+// Adds a datagram to a worker's ring. Returns FALSE if the ring is full.
+//
+static
+BOOLEAN
+CxPlatLoopbackRingEnqueue(
+    _Inout_ CXPLAT_LOOPBACK_RING* Ring,
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* Block
+    )
+{
+    int64_t Position = Ring->EnqueuePosition;
+    CXPLAT_LOOPBACK_RING_SLOT* Slot;
+    for (;;) {
+        Slot = &Ring->Slots[Position & (CXPLAT_LOOPBACK_RING_SIZE - 1)];
+        const int64_t Difference = Slot->Sequence - Position;
+        if (Difference == 0) {
+            const int64_t Current =
+                InterlockedCompareExchange64(
+                    &Ring->EnqueuePosition, Position + 1, Position);
+            if (Current == Position) {
+                break;
+            }
+            Position = Current;
+        } else if (Difference < 0) {
+            return FALSE; // Full
+        } else {
+            Position = Ring->EnqueuePosition;
+        }
+    }
+
+    Slot->Block = Block;
+
+    //
+    // Publishes the slot to the consumer (Sequence: Position -> Position + 1).
+    //
+    InterlockedExchangeAdd64(&Slot->Sequence, 1);
+    return TRUE;
+}
+
+//
+// Removes the next datagram from a worker's ring, or returns NULL if empty.
+// Must only be called by the worker's delivery thread.
+//
+static
+CXPLAT_DATAPATH_RECV_BLOCK*
+CxPlatLoopbackRingDequeue(
+    _Inout_ CXPLAT_LOOPBACK_RING* Ring
+    )
+{
+    const int64_t Position = Ring->DequeuePosition;
+    CXPLAT_LOOPBACK_RING_SLOT* Slot =
+        &Ring->Slots[Position & (CXPLAT_LOOPBACK_RING_SIZE - 1)];
+    if (InterlockedExchangeAdd64(&Slot->Sequence, 0) != Position + 1) {
+        return NULL; // Empty
+    }
+
+    CXPLAT_DATAPATH_RECV_BLOCK* Block = Slot->Block;
+    Ring->DequeuePosition = Position + 1;
+
+    //
+    // Releases the slot for the next lap of the ring
+    // (Sequence: Position + 1 -> Position + RING_SIZE).
+    //
+    InterlockedExchangeAdd64(&Slot->Sequence, CXPLAT_LOOPBACK_RING_SIZE - 1);
+    return Block;
+}
+
+static
+BOOLEAN
+CxPlatLoopbackRingIsEmpty(
+    _In_ CXPLAT_LOOPBACK_RING* Ring
+    )
+{
+    const int64_t Position = Ring->DequeuePosition;
+    CXPLAT_LOOPBACK_RING_SLOT* Slot =
+        &Ring->Slots[Position & (CXPLAT_LOOPBACK_RING_SIZE - 1)];
+    return InterlockedExchangeAdd64(&Slot->Sequence, 0) != Position + 1;
+}
+
+static
+void
+CxPlatDataPathWorkerWake(
+    _In_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    if (Worker->Sleeping &&
+        InterlockedCompareExchange16(&Worker->Sleeping, 0, 1) == 1) {
+        CxPlatEventSet(Worker->WakeEvent);
+    }
+}
+
+static
+QUIC_STATUS
+CxPlatDataPathWorkerInitialize(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ uint32_t Index,
+    _Out_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    Worker->Datapath = Datapath;
+    Worker->Index = Index;
+    Worker->Sleeping = 0;
+    Worker->PurgeNeeded = 0;
+    CxPlatListInitializeHead(&Worker->PendingList);
+    Worker->Ring.EnqueuePosition = 0;
+    Worker->Ring.DequeuePosition = 0;
+    for (int64_t i = 0; i < CXPLAT_LOOPBACK_RING_SIZE; ++i) {
+        Worker->Ring.Slots[i].Sequence = i;
+        Worker->Ring.Slots[i].Block = NULL;
+    }
+
+    CxPlatPoolInitialize(
+        FALSE,
+        sizeof(CXPLAT_DATAPATH_RECV_BLOCK) + Datapath->ClientRecvContextLength,
+        QUIC_POOL_DATA,
+        &Worker->RecvBlockPool);
+    CxPlatPoolInitialize(
+        FALSE,
+        sizeof(CXPLAT_SEND_DATA),
+        QUIC_POOL_PLATFORM_SENDCTX,
+        &Worker->SendDataPool);
+    CxPlatEventInitialize(&Worker->WakeEvent, FALSE, FALSE);
+
+    CXPLAT_THREAD_CONFIG Config = {
+        CXPLAT_THREAD_FLAG_SET_IDEAL_PROC,
+        (uint16_t)Index,
+        "cxplat_loopback",
+        CxPlatDataPathWorkerThread,
+        Worker
+    };
+    QUIC_STATUS Status = CxPlatThreadCreate(&Config, &Worker->Thread);
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            Status,
+            "CxPlatThreadCreate");
+        CxPlatEventUninitialize(Worker->WakeEvent);
+        CxPlatPoolUninitialize(&Worker->SendDataPool);
+        CxPlatPoolUninitialize(&Worker->RecvBlockPool);
+    }
+
+    return Status;
+}
+
+static
+void
+CxPlatDataPathWorkerUninitialize(
+    _In_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    CxPlatEventSet(Worker->WakeEvent);
+    CxPlatThreadWait(&Worker->Thread);
+    CxPlatThreadDelete(&Worker->Thread);
+    CxPlatEventUninitialize(Worker->WakeEvent);
+    CxPlatPoolUninitialize(&Worker->SendDataPool);
+    CxPlatPoolUninitialize(&Worker->RecvBlockPool);
+}
+
+QUIC_STATUS
+CxPlatDataPathInitialize(
+    _In_ uint32_t ClientRecvContextLength,
+    _In_opt_ const CXPLAT_UDP_DATAPATH_CALLBACKS* UdpCallbacks,
+    _In_opt_ const CXPLAT_TCP_DATAPATH_CALLBACKS* TcpCallbacks,
+    _Out_ CXPLAT_DATAPATH** NewDataPath
+    )
+{
+    UNREFERENCED_PARAMETER(TcpCallbacks);
+    if (NewDataPath == NULL) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+    if (UdpCallbacks != NULL) {
+        if (UdpCallbacks->Receive == NULL || UdpCallbacks->Unreachable == NULL) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+    const uint32_t WorkerCount = CxPlatProcMaxCount();
+    const size_t DatapathLength =
+        sizeof(CXPLAT_DATAPATH) + WorkerCount * sizeof(CXPLAT_DATAPATH_WORKER);
+
+    CXPLAT_DATAPATH* Datapath =
+        (CXPLAT_DATAPATH*)CXPLAT_ALLOC_NONPAGED(DatapathLength, QUIC_POOL_DATAPATH);
+    if (Datapath == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_DATAPATH",
+            DatapathLength);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    CxPlatZeroMemory(Datapath, sizeof(CXPLAT_DATAPATH));
+    Datapath->Ports =
+        (CXPLAT_SOCKET**)CXPLAT_ALLOC_NONPAGED(
+            CXPLAT_LOOPBACK_PORT_COUNT * sizeof(CXPLAT_SOCKET*),
+            QUIC_POOL_DATAPATH);
+    if (Datapath->Ports == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Loopback port table",
+            CXPLAT_LOOPBACK_PORT_COUNT * sizeof(CXPLAT_SOCKET*));
+        CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(Datapath->Ports, CXPLAT_LOOPBACK_PORT_COUNT * sizeof(CXPLAT_SOCKET*));
+
+    if (UdpCallbacks) {
+        Datapath->UdpHandlers = *UdpCallbacks;
+    }
+    Datapath->ClientRecvContextLength = ClientRecvContextLength;
+    Datapath->NextEphemeralPort = CXPLAT_LOOPBACK_EPHEMERAL_PORT_START;
+    Datapath->WorkerCount = WorkerCount;
+    CxPlatDispatchRwLockInitialize(&Datapath->PortsLock);
+    CxPlatRundownInitialize(&Datapath->SocketsRundown);
+
+    for (uint32_t i = 0; i < WorkerCount; i++) {
+        Status = CxPlatDataPathWorkerInitialize(Datapath, i, &Datapath->Workers[i]);
+        if (QUIC_FAILED(Status)) {
+            Datapath->Shutdown = TRUE;
+            for (uint32_t j = 0; j < i; j++) {
+                CxPlatDataPathWorkerUninitialize(&Datapath->Workers[j]);
+            }
+            CxPlatRundownUninitialize(&Datapath->SocketsRundown);
+            CxPlatDispatchRwLockUninitialize(&Datapath->PortsLock);
+            CXPLAT_FREE(Datapath->Ports, QUIC_POOL_DATAPATH);
+            CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+            return Status;
+        }
+    }
+
+    *NewDataPath = Datapath;
+    return QUIC_STATUS_SUCCESS;
+}
+
+void
+CxPlatDataPathUninitialize(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    if (Datapath == NULL) {
+        return;
+    }
+
+    CxPlatRundownReleaseAndWait(&Datapath->SocketsRundown);
+
+    Datapath->Shutdown = TRUE;
+    for (uint32_t i = 0; i < Datapath->WorkerCount; i++) {
+        CxPlatDataPathWorkerUninitialize(&Datapath->Workers[i]);
+    }
+
+    CxPlatRundownUninitialize(&Datapath->SocketsRundown);
+    CxPlatDispatchRwLockUninitialize(&Datapath->PortsLock);
+    CXPLAT_FREE(Datapath->Ports, QUIC_POOL_DATAPATH);
+    CXPLAT_FREE(Datapath, QUIC_POOL_DATAPATH);
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatDataPathSetEmulation(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_ const CXPLAT_DATAPATH_EMULATION* Emulation
+    )
+{
+    //
+    // Sends read the settings without synchronization, so changing them while
+    // traffic is flowing may briefly apply a mix of old and new values.
+    //
+    Datapath->Emulation = *Emulation;
+}
+
+_IRQL_requires_max_(DISPATCH_LEVEL)
+uint32_t
+CxPlatDataPathGetSupportedFeatures(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    return 0;
+}
+
+BOOLEAN
+CxPlatDataPathIsPaddingPreferred(
+    _In_ CXPLAT_DATAPATH* Datapath
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    return FALSE;
+}
+
+QUIC_STATUS
+CxPlatDataPathGetGatewayAddresses(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _Outptr_ _At_(*GatewayAddresses, __drv_allocatesMem(Mem))
+        QUIC_ADDR** GatewayAddresses,
+    _Out_ uint32_t* GatewayAddressesCount
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    *GatewayAddresses = NULL;
+    *GatewayAddressesCount = 0;
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+QUIC_STATUS
+CxPlatDataPathResolveAddress(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_z_ const char* HostName,
+    _Inout_ QUIC_ADDR* Address
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+
+    //
+    // Numeric addresses are used as is. Everything is reachable through the
+    // loopback datapath, so any host name resolves to loopback.
+    //
+    QUIC_ADDR Resolved = {0};
+    if (!QuicAddrFromString(HostName, 0, &Resolved)) {
+        QUIC_ADDRESS_FAMILY Family = QuicAddrGetFamily(Address);
+        if (Family == QUIC_ADDRESS_FAMILY_UNSPEC) {
+            Family = QUIC_ADDRESS_FAMILY_INET;
+        }
+        QuicAddrSetFamily(&Resolved, Family);
+        QuicAddrSetToLoopback(&Resolved);
+    }
+
+    *Address = Resolved;
+    return QUIC_STATUS_SUCCESS;
+}
+
+QUIC_STATUS
+CxPlatSocketCreateUdp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_opt_ const QUIC_ADDR* RemoteAddress,
+    _In_opt_ void* RecvCallbackContext,
+    _In_ uint32_t InternalFlags,
+    _Out_ CXPLAT_SOCKET** NewSocket
+    )
+{
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    CXPLAT_DBG_ASSERT(Datapath->UdpHandlers.Receive != NULL || InternalFlags & CXPLAT_SOCKET_FLAG_PCP);
+
+    CXPLAT_SOCKET* Socket =
+        (CXPLAT_SOCKET*)CXPLAT_ALLOC_NONPAGED(sizeof(CXPLAT_SOCKET), QUIC_POOL_SOCKET);
+    if (Socket == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SOCKET",
+            sizeof(CXPLAT_SOCKET));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    QuicTraceEvent(
+        DatapathCreated,
+        "[data][%p] Created, local=%!ADDR!, remote=%!ADDR!",
+        Socket,
+        CLOG_BYTEARRAY(LocalAddress ? sizeof(*LocalAddress) : 0, LocalAddress),
+        CLOG_BYTEARRAY(RemoteAddress ? sizeof(*RemoteAddress) : 0, RemoteAddress));
+
+    CxPlatZeroMemory(Socket, sizeof(CXPLAT_SOCKET));
+    Socket->Datapath = Datapath;
+    Socket->ClientContext = RecvCallbackContext;
+    Socket->HasFixedRemoteAddress = (RemoteAddress != NULL);
+    Socket->PcpBinding = (InternalFlags & CXPLAT_SOCKET_FLAG_PCP) != 0;
+    Socket->Mtu = CXPLAT_MAX_MTU;
+    Socket->WorkerIndex = CxPlatProcCurrentNumber() % Datapath->WorkerCount;
+    CxPlatRundownInitialize(&Socket->Rundown);
+    CxPlatDispatchLockInitialize(&Socket->LinkLock);
+    CxPlatEmulatedLinkInitialize(&Socket->Link);
+
+    if (LocalAddress != NULL) {
+        Socket->LocalAddress = *LocalAddress;
+    }
+    if (RemoteAddress != NULL) {
+        Socket->RemoteAddress = *RemoteAddress;
+        if (LocalAddress == NULL || QuicAddrIsWildCard(LocalAddress)) {
+            //
+            // Like a connected OS socket, pick the loopback address of the
+            // remote's family as the local address.
+            //
+            const uint16_t Port = QuicAddrGetPort(&Socket->LocalAddress);
+            CxPlatZeroMemory(&Socket->LocalAddress, sizeof(Socket->LocalAddress));
+            QuicAddrSetFamily(&Socket->LocalAddress, QuicAddrGetFamily(RemoteAddress));
+            QuicAddrSetToLoopback(&Socket->LocalAddress);
+            QuicAddrSetPort(&Socket->LocalAddress, Port);
+        }
+    }
+    if (QuicAddrGetFamily(&Socket->LocalAddress) == QUIC_ADDRESS_FAMILY_UNSPEC) {
+        QuicAddrSetFamily(&Socket->LocalAddress, QUIC_ADDRESS_FAMILY_INET6);
+    }
+
+    uint16_t Port = QuicAddrGetPort(&Socket->LocalAddress);
+    CxPlatDispatchRwLockAcquireExclusive(&Datapath->PortsLock);
+    if (Port == 0) {
+        for (uint32_t i = 0; i < CXPLAT_LOOPBACK_EPHEMERAL_PORT_COUNT; ++i) {
+            const uint16_t Candidate = Datapath->NextEphemeralPort;
+            Datapath->NextEphemeralPort =
+                Candidate == UINT16_MAX ?
+                    CXPLAT_LOOPBACK_EPHEMERAL_PORT_START : Candidate + 1;
+            if (Datapath->Ports[Candidate] == NULL) {
+                Port = Candidate;
+                break;
+            }
+        }
+    }
+    if (Port == 0 || Datapath->Ports[Port] != NULL) {
+        Status = QUIC_STATUS_ADDRESS_IN_USE;
+    } else {
+        Datapath->Ports[Port] = Socket;
+        QuicAddrSetPort(&Socket->LocalAddress, Port);
+    }
+    CxPlatDispatchRwLockReleaseExclusive(&Datapath->PortsLock);
+
+    if (QUIC_FAILED(Status)) {
+        QuicTraceEvent(
+            DatapathErrorStatus,
+            "[data][%p] ERROR, %u, %s.",
+            Socket,
+            Status,
+            "bind");
+        QuicTraceEvent(
+            DatapathDestroyed,
+            "[data][%p] Destroyed",
+            Socket);
+        CxPlatDispatchLockUninitialize(&Socket->LinkLock);
+        CxPlatRundownUninitialize(&Socket->Rundown);
+        CXPLAT_FREE(Socket, QUIC_POOL_SOCKET);
+        return Status;
+    }
+
+    CxPlatRundownAcquire(&Datapath->SocketsRundown);
+    *NewSocket = Socket;
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketCreateTcp(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_opt_ void* CallbackContext,
+    _Out_ CXPLAT_SOCKET** Socket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(RemoteAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+QUIC_STATUS
+CxPlatSocketCreateTcpListener(
+    _In_ CXPLAT_DATAPATH* Datapath,
+    _In_opt_ const QUIC_ADDR* LocalAddress,
+    _In_opt_ void* CallbackContext,
+    _Out_ CXPLAT_SOCKET** Socket
+    )
+{
+    UNREFERENCED_PARAMETER(Datapath);
+    UNREFERENCED_PARAMETER(LocalAddress);
+    UNREFERENCED_PARAMETER(CallbackContext);
+    UNREFERENCED_PARAMETER(Socket);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+void
+CxPlatSocketDelete(
+    _Inout_ CXPLAT_SOCKET* Socket
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    QuicTraceEvent(
+        DatapathDestroyed,
+        "[data][%p] Destroyed",
+        Socket);
+
+    CXPLAT_DATAPATH* Datapath = Socket->Datapath;
+
+    //
+    // Once the socket is out of the port table, no new datagrams can be sent
+    // to it. Any already in flight are dropped by the workers, which release
+    // their rundown references.
+    //
+    CxPlatDispatchRwLockAcquireExclusive(&Datapath->PortsLock);
+    Datapath->Ports[QuicAddrGetPort(&Socket->LocalAddress)] = NULL;
+    Socket->Shutdown = TRUE;
+    CxPlatDispatchRwLockReleaseExclusive(&Datapath->PortsLock);
+
+    for (uint32_t i = 0; i < Datapath->WorkerCount; ++i) {
+        CXPLAT_DATAPATH_WORKER* Worker = &Datapath->Workers[i];
+        InterlockedCompareExchange16(&Worker->PurgeNeeded, 1, 0);
+        CxPlatDataPathWorkerWake(Worker);
+    }
+
+    CxPlatRundownReleaseAndWait(&Socket->Rundown);
+    CxPlatRundownRelease(&Datapath->SocketsRundown);
+
+    CxPlatRundownUninitialize(&Socket->Rundown);
+    CxPlatDispatchLockUninitialize(&Socket->LinkLock);
+    CXPLAT_FREE(Socket, QUIC_POOL_SOCKET);
+}
+
+uint16_t
+CxPlatSocketGetLocalMtu(
+    _In_ CXPLAT_SOCKET* Socket
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    return Socket->Mtu;
+}
+
+void
+CxPlatSocketGetLocalAddress(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    *Address = Socket->LocalAddress;
+}
+
+void
+CxPlatSocketGetRemoteAddress(
+    _In_ CXPLAT_SOCKET* Socket,
+    _Out_ QUIC_ADDR* Address
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+    *Address = Socket->RemoteAddress;
+}
+
+QUIC_STATUS
+CxPlatSocketSetParam(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint32_t Param,
+    _In_ uint32_t BufferLength,
+    _In_reads_bytes_(BufferLength) const uint8_t * Buffer
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Param);
+    UNREFERENCED_PARAMETER(BufferLength);
+    UNREFERENCED_PARAMETER(Buffer);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+QUIC_STATUS
+CxPlatSocketGetParam(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ uint32_t Param,
+    _Inout_ uint32_t* BufferLength,
+    _Out_writes_bytes_opt_(*BufferLength) uint8_t * Buffer
+    )
+{
+    UNREFERENCED_PARAMETER(Socket);
+    UNREFERENCED_PARAMETER(Param);
+    UNREFERENCED_PARAMETER(BufferLength);
+    UNREFERENCED_PARAMETER(Buffer);
+    return QUIC_STATUS_NOT_SUPPORTED;
+}
+
+CXPLAT_RECV_DATA*
+CxPlatDataPathRecvPacketToRecvData(
+    _In_ const CXPLAT_RECV_PACKET* const Packet
+    )
+{
+    CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+        (CXPLAT_DATAPATH_RECV_BLOCK*)
+            ((char *)Packet - sizeof(CXPLAT_DATAPATH_RECV_BLOCK));
+
+    return &RecvBlock->RecvData;
+}
+
+CXPLAT_RECV_PACKET*
+CxPlatDataPathRecvDataToRecvPacket(
+    _In_ const CXPLAT_RECV_DATA* const RecvData
+    )
+{
+    CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+        CXPLAT_CONTAINING_RECORD(RecvData, CXPLAT_DATAPATH_RECV_BLOCK, RecvData);
+
+    return (CXPLAT_RECV_PACKET*)(RecvBlock + 1);
+}
+
+void
+CxPlatRecvDataReturn(
+    _In_opt_ CXPLAT_RECV_DATA* RecvDataChain
+    )
+{
+    CXPLAT_RECV_DATA* Datagram;
+    while ((Datagram = RecvDataChain) != NULL) {
+        RecvDataChain = RecvDataChain->Next;
+        CXPLAT_DATAPATH_RECV_BLOCK* RecvBlock =
+            CXPLAT_CONTAINING_RECORD(Datagram, CXPLAT_DATAPATH_RECV_BLOCK, RecvData);
+        CxPlatPoolFree(RecvBlock->OwningPool, RecvBlock);
+    }
+}
+
+CXPLAT_SEND_DATA*
+CxPlatSendDataAlloc(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ CXPLAT_ECN_TYPE ECN,
+    _In_ uint16_t MaxPacketSize
+    )
+{
+    UNREFERENCED_PARAMETER(MaxPacketSize);
+    CXPLAT_DBG_ASSERT(Socket != NULL);
+
+    CXPLAT_DATAPATH_WORKER* Worker =
+        &Socket->Datapath->Workers[CxPlatProcCurrentNumber() % Socket->Datapath->WorkerCount];
+    CXPLAT_SEND_DATA* SendData = CxPlatPoolAlloc(&Worker->SendDataPool);
+    if (SendData == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_SEND_DATA",
+            0);
+        return NULL;
+    }
+
+    SendData->Owner = Worker;
+    SendData->ECN = ECN;
+    SendData->BufferCount = 0;
+    return SendData;
+}
+
+void
+CxPlatSendDataFree(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    for (uint8_t i = 0; i < SendData->BufferCount; ++i) {
+        if (SendData->Blocks[i] != NULL) {
+            CxPlatPoolFree(&SendData->Owner->RecvBlockPool, SendData->Blocks[i]);
+        }
+    }
+
+    CxPlatPoolFree(&SendData->Owner->SendDataPool, SendData);
+}
+
+QUIC_BUFFER*
+CxPlatSendDataAllocBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ uint16_t MaxBufferLength
+    )
+{
+    CXPLAT_DBG_ASSERT(SendData != NULL);
+    CXPLAT_DBG_ASSERT(MaxBufferLength <= MAX_UDP_PAYLOAD_LENGTH);
+
+    if (SendData->BufferCount == CXPLAT_MAX_BATCH_SEND) {
+        QuicTraceEvent(
+            LibraryError,
+            "[ lib] ERROR, %s.",
+            "Max batch size limit hit");
+        return NULL;
+    }
+
+    CXPLAT_DATAPATH_RECV_BLOCK* Block =
+        CxPlatPoolAlloc(&SendData->Owner->RecvBlockPool);
+    if (Block == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "Send Buffer",
+            0);
+        return NULL;
+    }
+
+    Block->OwningPool = &SendData->Owner->RecvBlockPool;
+    Block->Socket = NULL;
+
+    QUIC_BUFFER* Buffer = &SendData->Buffers[SendData->BufferCount];
+    Buffer->Buffer = Block->Buffer;
+    Buffer->Length = MaxBufferLength;
+    SendData->Blocks[SendData->BufferCount] = Block;
+    ++SendData->BufferCount;
+
+    return Buffer;
+}
+
+void
+CxPlatSendDataFreeBuffer(
+    _In_ CXPLAT_SEND_DATA* SendData,
+    _In_ QUIC_BUFFER* Buffer
+    )
+{
+    CXPLAT_DBG_ASSERT(Buffer == &SendData->Buffers[SendData->BufferCount - 1]);
+    UNREFERENCED_PARAMETER(Buffer);
+
+    --SendData->BufferCount;
+    CxPlatPoolFree(
+        &SendData->Owner->RecvBlockPool,
+        SendData->Blocks[SendData->BufferCount]);
+    SendData->Blocks[SendData->BufferCount] = NULL;
+}
+
+BOOLEAN
+CxPlatSendDataIsFull(
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    return SendData->BufferCount == CXPLAT_MAX_BATCH_SEND;
+}
+
+void
+CxPlatEmulatedLinkInitialize(
+    _Out_ CXPLAT_EMULATED_LINK* Link
+    )
+{
+    CxPlatZeroMemory(Link, sizeof(*Link));
+    CxPlatRandom(sizeof(Link->RandomState), &Link->RandomState);
+    Link->RandomState |= 1; // xorshift requires a non-zero state.
+}
+
+static
+uint32_t
+CxPlatEmulatedLinkRandom(
+    _Inout_ CXPLAT_EMULATED_LINK* Link
+    )
+{
+    //
+    // xorshift64*
+    //
+    uint64_t X = Link->RandomState;
+    X ^= X >> 12;
+    X ^= X << 25;
+    X ^= X >> 27;
+    Link->RandomState = X;
+    return (uint32_t)((X * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+BOOLEAN
+CxPlatEmulatedLinkSend(
+    _Inout_ CXPLAT_EMULATED_LINK* Link,
+    _In_ const CXPLAT_DATAPATH_EMULATION* Emulation,
+    _In_ uint64_t TimeNowUs,
+    _In_ uint32_t Length,
+    _Out_ uint64_t* DeliveryTimeUs
+    )
+{
+    BOOLEAN Delivered = TRUE;
+    uint64_t DepartureTimeUs = TimeNowUs;
+
+    if (Emulation->RandomLossDenominator != 0 &&
+        CxPlatEmulatedLinkRandom(Link) % Emulation->RandomLossDenominator == 0) {
+        Delivered = FALSE;
+        goto Exit;
+    }
+
+    if (Emulation->BurstLossDenominator != 0) {
+        //
+        // Two state (Gilbert-Elliott) model: a burst starts on 1 in
+        // BurstLossDenominator datagrams, and each datagram lost in it ends
+        // the burst with a probability of 1 / BurstLossLength, so bursts are
+        // BurstLossLength datagrams long on average.
+        //
+        if (!Link->InLossBurst) {
+            Link->InLossBurst =
+                CxPlatEmulatedLinkRandom(Link) % Emulation->BurstLossDenominator == 0;
+        } else if (Emulation->BurstLossLength <= 1 ||
+            CxPlatEmulatedLinkRandom(Link) % Emulation->BurstLossLength == 0) {
+            Link->InLossBurst = FALSE;
+        }
+        if (Link->InLossBurst) {
+            Delivered = FALSE;
+            goto Exit;
+        }
+    }
+
+    if (Emulation->RateLimitMbps != 0) {
+        //
+        // The bottleneck serializes datagrams (including their IP and UDP
+        // headers) at the configured rate. Datagrams arriving when the queue
+        // already holds QueueLimitPackets full-sized packets are tail dropped.
+        //
+        // With RateBucketBytes, the link is a token bucket instead: credit for
+        // up to that many bytes accumulates while it is idle, and is spent at
+        // line rate (i.e. without serialization delay) by the next datagrams.
+        //
+        const uint64_t TimeNowNs = TimeNowUs * 1000;
+        const uint64_t BucketNs =
+            (uint64_t)Emulation->RateBucketBytes * 8000 / Emulation->RateLimitMbps;
+        const uint64_t LinkCreditTimeNs =
+            TimeNowNs > BucketNs ? TimeNowNs - BucketNs : 0;
+        if (Link->FreeTimeNs < LinkCreditTimeNs) {
+            Link->FreeTimeNs = LinkCreditTimeNs;
+        } else if (Emulation->QueueLimitPackets != 0 &&
+            Link->FreeTimeNs > TimeNowNs &&
+            Link->FreeTimeNs - TimeNowNs >=
+                (uint64_t)Emulation->QueueLimitPackets * CXPLAT_MAX_MTU * 8000 /
+                    Emulation->RateLimitMbps) {
+            Delivered = FALSE;
+            goto Exit;
+        }
+        const uint64_t WireLength =
+            Length + CXPLAT_MIN_IPV4_HEADER_SIZE + CXPLAT_UDP_HEADER_SIZE;
+        Link->FreeTimeNs += WireLength * 8000 / Emulation->RateLimitMbps;
+        if (Link->FreeTimeNs > TimeNowNs) {
+            DepartureTimeUs = Link->FreeTimeNs / 1000;
+        }
+    }
+
+    *DeliveryTimeUs = DepartureTimeUs + (uint64_t)Emulation->DelayMs * 1000;
+
+    if (Emulation->JitterMs != 0) {
+        //
+        // Like a real path (and unlike netem's default), jitter alone doesn't
+        // reorder: a datagram is never delivered before the previous one.
+        //
+        *DeliveryTimeUs +=
+            CxPlatEmulatedLinkRandom(Link) % ((uint64_t)Emulation->JitterMs * 1000 + 1);
+        if (*DeliveryTimeUs < Link->LastDeliveryTimeUs) {
+            *DeliveryTimeUs = Link->LastDeliveryTimeUs;
+        }
+    }
+    Link->LastDeliveryTimeUs = *DeliveryTimeUs;
+
+    if (Emulation->RandomReorderDenominator != 0 &&
+        CxPlatEmulatedLinkRandom(Link) % Emulation->RandomReorderDenominator == 0) {
+        *DeliveryTimeUs += (uint64_t)Emulation->ReorderDelayDeltaMs * 1000;
+    }
+
+Exit:
+
+    return Delivered;
+}
+
+//
+// Returns a datagram that won't be delivered and releases its reference on
+// the destination socket.
+//
+static
+void
+CxPlatDataPathDropBlock(
+    _In_ CXPLAT_DATAPATH_RECV_BLOCK* Block
+    )
+{
+    CXPLAT_SOCKET* Socket = Block->Socket;
+    CxPlatPoolFree(Block->OwningPool, Block);
+    CxPlatRundownRelease(&Socket->Rundown);
+}
+
+QUIC_STATUS
+CxPlatSocketSend(
+    _In_ CXPLAT_SOCKET* Socket,
+    _In_ const QUIC_ADDR* LocalAddress,
+    _In_ const QUIC_ADDR* RemoteAddress,
+    _In_ CXPLAT_SEND_DATA* SendData
+    )
+{
+    CXPLAT_DBG_ASSERT(Socket != NULL && RemoteAddress != NULL && SendData != NULL);
+    CXPLAT_DATAPATH* Datapath = Socket->Datapath;
+
+    QuicTraceEvent(
+        DatapathSend,
+        "[data][%p] Send %u bytes in %hhu buffers (segment=%hu) Dst=%!ADDR!, Src=%!ADDR!",
+        Socket,
+        SendData->BufferCount != 0 ? (uint32_t)SendData->Buffers[0].Length : 0,
+        SendData->BufferCount,
+        SendData->BufferCount != 0 ? (uint16_t)SendData->Buffers[0].Length : 0,
+        CLOG_BYTEARRAY(sizeof(*RemoteAddress), RemoteAddress),
+        CLOG_BYTEARRAY(LocalAddress ? sizeof(*LocalAddress) : 0, LocalAddress));
+
+    //
+    // Figure out the source address the receiver sees.
+    //
+    QUIC_ADDR SourceAddress;
+    if (LocalAddress != NULL && !QuicAddrIsWildCard(LocalAddress)) {
+        SourceAddress = *LocalAddress;
+    } else {
+        SourceAddress = Socket->LocalAddress;
+    }
+    if (QuicAddrIsWildCard(&SourceAddress) ||
+        QuicAddrGetFamily(&SourceAddress) != QuicAddrGetFamily(RemoteAddress)) {
+        CxPlatZeroMemory(&SourceAddress, sizeof(SourceAddress));
+        QuicAddrSetFamily(&SourceAddress, QuicAddrGetFamily(RemoteAddress));
+        QuicAddrSetToLoopback(&SourceAddress);
+    }
+    QuicAddrSetPort(&SourceAddress, QuicAddrGetPort(&Socket->LocalAddress));
+
+    //
+    // Look up the destination and take a reference for each datagram.
+    //
+    CxPlatDispatchRwLockAcquireShared(&Datapath->PortsLock);
+    CXPLAT_SOCKET* Destination = Datapath->Ports[QuicAddrGetPort(RemoteAddress)];
+    if (Destination != NULL) {
+        for (uint8_t i = 0; i < SendData->BufferCount; ++i) {
+            CXPLAT_FRE_ASSERT(CxPlatRundownAcquire(&Destination->Rundown));
+        }
+    }
+    CxPlatDispatchRwLockReleaseShared(&Datapath->PortsLock);
+
+    if (Destination == NULL) {
+        //
+        // Nothing is bound to the port. Indicate the equivalent of an ICMP
+        // port unreachable.
+        //
+        if (!Socket->PcpBinding) {
+            Datapath->UdpHandlers.Unreachable(
+                Socket,
+                Socket->ClientContext,
+                RemoteAddress);
+        }
+        CxPlatSendDataFree(SendData);
+        return QUIC_STATUS_SUCCESS;
+    }
+
+    //
+    // Connected sockets are always delivered to by the worker of the
+    // processor they were created on. Others spread peers across workers by
+    // source port, similar to RSS.
+    //
+    CXPLAT_DATAPATH_WORKER* Worker =
+        &Datapath->Workers[
+            Destination->HasFixedRemoteAddress ?
+                Destination->WorkerIndex :
+                QuicAddrGetPort(&SourceAddress) % Datapath->WorkerCount];
+
+    const CXPLAT_DATAPATH_EMULATION* Emulation = &Datapath->Emulation;
+    const BOOLEAN EmulationEnabled =
+        Emulation->DelayMs != 0 ||
+        Emulation->RateLimitMbps != 0 ||
+        Emulation->RandomLossDenominator != 0 ||
+        Emulation->RandomReorderDenominator != 0 ||
+        Emulation->JitterMs != 0 ||
+        Emulation->BurstLossDenominator != 0;
+    const uint64_t TimeNowUs = EmulationEnabled ? CxPlatTimeUs64() : 0;
+
+    for (uint8_t i = 0; i < SendData->BufferCount; ++i) {
+        CXPLAT_DATAPATH_RECV_BLOCK* Block = SendData->Blocks[i];
+        SendData->Blocks[i] = NULL;
+
+        Block->Socket = Destination;
+        Block->DeliveryTimeUs = 0;
+        Block->Tuple.LocalAddress = *RemoteAddress;
+        Block->Tuple.RemoteAddress = SourceAddress;
+        Block->RecvData.Next = NULL;
+        Block->RecvData.Tuple = &Block->Tuple;
+        Block->RecvData.Buffer = Block->Buffer;
+        Block->RecvData.BufferLength = (uint16_t)SendData->Buffers[i].Length;
+        Block->RecvData.PartitionIndex = (uint16_t)Worker->Index;
+        Block->RecvData.TypeOfService = (uint8_t)SendData->ECN;
+        Block->RecvData.Allocated = TRUE;
+        Block->RecvData.QueuedOnConnection = FALSE;
+
+        if (EmulationEnabled) {
+            CxPlatDispatchLockAcquire(&Socket->LinkLock);
+            const BOOLEAN Delivered =
+                CxPlatEmulatedLinkSend(
+                    &Socket->Link,
+                    Emulation,
+                    TimeNowUs,
+                    Block->RecvData.BufferLength,
+                    &Block->DeliveryTimeUs);
+            CxPlatDispatchLockRelease(&Socket->LinkLock);
+            if (!Delivered) {
+                CxPlatDataPathDropBlock(Block);
+                continue;
+            }
+        }
+
+        if (!CxPlatLoopbackRingEnqueue(&Worker->Ring, Block)) {
+            QuicTraceEvent(
+                LibraryError,
+                "[ lib] ERROR, %s.",
+                "Loopback delivery ring full");
+            CxPlatDataPathDropBlock(Block);
+        }
+    }
+
+    CxPlatDataPathWorkerWake(Worker);
+    CxPlatSendDataFree(SendData);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Moves all queued datagrams from the ring to the time-sorted pending list.
+//
+static
+void
+CxPlatDataPathWorkerDrainRing(
+    _In_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    CXPLAT_DATAPATH_RECV_BLOCK* Block;
+    while ((Block = CxPlatLoopbackRingDequeue(&Worker->Ring)) != NULL) {
+        if (Block->Socket->Shutdown) {
+            CxPlatDataPathDropBlock(Block);
+            continue;
+        }
+
+        //
+        // Datagrams mostly arrive in delivery time order, so search from the
+        // tail.
+        //
+        CXPLAT_LIST_ENTRY* Entry = Worker->PendingList.Blink;
+        while (Entry != &Worker->PendingList &&
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_DATAPATH_RECV_BLOCK, Link)->DeliveryTimeUs >
+                Block->DeliveryTimeUs) {
+            Entry = Entry->Blink;
+        }
+        CxPlatListInsertHead(Entry, &Block->Link);
+    }
+}
+
+//
+// Drops all pending datagrams to sockets that are shutting down.
+//
+static
+void
+CxPlatDataPathWorkerPurge(
+    _In_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    CXPLAT_LIST_ENTRY* Entry = Worker->PendingList.Flink;
+    while (Entry != &Worker->PendingList) {
+        CXPLAT_DATAPATH_RECV_BLOCK* Block =
+            CXPLAT_CONTAINING_RECORD(Entry, CXPLAT_DATAPATH_RECV_BLOCK, Link);
+        Entry = Entry->Flink;
+        if (Block->Socket->Shutdown) {
+            CxPlatListEntryRemove(&Block->Link);
+            CxPlatDataPathDropBlock(Block);
+        }
+    }
+}
+
+//
+// Indicates all due datagrams. Returns the number of microseconds until the
+// next pending datagram is due, or UINT64_MAX if there are none.
+//
+static
+uint64_t
+CxPlatDataPathWorkerDeliver(
+    _In_ CXPLAT_DATAPATH_WORKER* Worker
+    )
+{
+    CXPLAT_DATAPATH* Datapath = Worker->Datapath;
+    uint64_t TimeNowUs = 0;
+    BOOLEAN TimeNowValid = FALSE;
+
+    while (!CxPlatListIsEmpty(&Worker->PendingList)) {
+        CXPLAT_DATAPATH_RECV_BLOCK* Block =
+            CXPLAT_CONTAINING_RECORD(
+                Worker->PendingList.Flink, CXPLAT_DATAPATH_RECV_BLOCK, Link);
+        if (Block->DeliveryTimeUs != 0) {
+            if (!TimeNowValid) {
+                TimeNowUs = CxPlatTimeUs64();
+                TimeNowValid = TRUE;
+            }
+            if (Block->DeliveryTimeUs > TimeNowUs) {
+                return Block->DeliveryTimeUs - TimeNowUs;
+            }
+        }
+
+        //
+        // Chain up consecutive due datagrams for the same socket.
+        //
+        CXPLAT_SOCKET* Socket = Block->Socket;
+        CXPLAT_RECV_DATA* Chain = NULL;
+        CXPLAT_RECV_DATA** Tail = &Chain;
+        uint32_t ChainLength = 0;
+        while (ChainLength < CXPLAT_MAX_RECV_CHAIN) {
+            CxPlatListEntryRemove(&Block->Link);
+            *Tail = &Block->RecvData;
+            Tail = &Block->RecvData.Next;
+            ++ChainLength;
+
+            if (CxPlatListIsEmpty(&Worker->PendingList)) {
+                break;
+            }
+            Block =
+                CXPLAT_CONTAINING_RECORD(
+                    Worker->PendingList.Flink, CXPLAT_DATAPATH_RECV_BLOCK, Link);
+            if (Block->Socket != Socket ||
+                (Block->DeliveryTimeUs != 0 && Block->DeliveryTimeUs > TimeNowUs)) {
+                break;
+            }
+        }
+
+        if (Socket->Shutdown) {
+            CxPlatRecvDataReturn(Chain);
+        } else {
+            QuicTraceEvent(
+                DatapathRecv,
+                "[data][%p] Recv %u bytes (segment=%hu) Src=%!ADDR! Dst=%!ADDR!",
+                Socket,
+                (uint32_t)Chain->BufferLength,
+                (uint32_t)Chain->BufferLength,
+                CLOG_BYTEARRAY(sizeof(Chain->Tuple->LocalAddress), &Chain->Tuple->LocalAddress),
+                CLOG_BYTEARRAY(sizeof(Chain->Tuple->RemoteAddress), &Chain->Tuple->RemoteAddress));
+            if (!Socket->PcpBinding) {
+                Datapath->UdpHandlers.Receive(Socket, Socket->ClientContext, Chain);
+            } else {
+                CxPlatPcpRecvCallback(Socket, Socket->ClientContext, Chain);
+            }
+        }
+
+        while (ChainLength-- > 0) {
+            CxPlatRundownRelease(&Socket->Rundown);
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+CXPLAT_THREAD_CALLBACK(CxPlatDataPathWorkerThread, Context)
+{
+    CXPLAT_DATAPATH_WORKER* Worker = (CXPLAT_DATAPATH_WORKER*)Context;
+    CXPLAT_DATAPATH* Datapath = Worker->Datapath;
+
+    QuicTraceLogInfo(
+        DatapathWorkerThreadStart,
+        "[data][%p] Worker start",
+        Worker);
+
+    while (!Datapath->Shutdown) {
+        CxPlatDataPathWorkerDrainRing(Worker);
+        if (Worker->PurgeNeeded &&
+            InterlockedCompareExchange16(&Worker->PurgeNeeded, 0, 1) == 1) {
+            CxPlatDataPathWorkerPurge(Worker);
+        }
+
+        const uint64_t WaitUs = CxPlatDataPathWorkerDeliver(Worker);
+        if (WaitUs == 0) {
+            continue;
+        }
+
+        //
+        // Announce the intent to sleep, then check again for work that raced
+        // with the announcement before actually waiting.
+        //
+        InterlockedCompareExchange16(&Worker->Sleeping, 1, 0);
+        if (Datapath->Shutdown ||
+            Worker->PurgeNeeded ||
+            !CxPlatLoopbackRingIsEmpty(&Worker->Ring)) {
+            InterlockedCompareExchange16(&Worker->Sleeping, 0, 1);
+            continue;
+        }
+
+        if (WaitUs == UINT64_MAX) {
+            CxPlatEventWaitForever(Worker->WakeEvent);
+        } else {
+            const uint64_t WaitMs =
+                (WaitUs + CXPLAT_MICROSEC_PER_MS - 1) / CXPLAT_MICROSEC_PER_MS;
+            CxPlatEventWaitWithTimeout(
+                Worker->WakeEvent,
+                WaitMs > UINT32_MAX ? UINT32_MAX : (uint32_t)WaitMs);
+        }
+        InterlockedCompareExchange16(&Worker->Sleeping, 0, 1);
+    }
+
+    //
+    // Drop everything still in flight.
+    //
+    CxPlatDataPathWorkerDrainRing(Worker);
+    while (!CxPlatListIsEmpty(&Worker->PendingList)) {
+        CXPLAT_DATAPATH_RECV_BLOCK* Block =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Worker->PendingList),
+                CXPLAT_DATAPATH_RECV_BLOCK,
+                Link);
+        CxPlatDataPathDropBlock(Block);
+    }
+
+    QuicTraceLogInfo(
+        DatapathWorkerThreadStop,
+        "[data][%p] Worker stop",
+        Worker);
+
+    CXPLAT_THREAD_RETURN(QUIC_STATUS_SUCCESS);
+}
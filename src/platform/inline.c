@@ -16,6 +16,7 @@ Abstract:
 --*/
 
 #include "platform_internal.h"
+#include "quic_trace_ring.h"
 #ifdef QUIC_CLOG
 #include "inline.c.clog.h"
 #endif
@@ -341,3 +342,18 @@ CxPlatInternalEventWaitWithTimeout(
     _Inout_ CXPLAT_EVENT* Event,
     _In_ uint32_t TimeoutMs
     );
+
+uint8_t
+QuicTraceRingParseFormat(
+    _In_z_ const char* Format,
+    _Out_writes_to_(QUIC_TRACE_RING_MAX_ARGS, return)
+        uint8_t* ArgTypes
+    );
+
+const QUIC_TRACE_RING_RECORD*
+QuicTraceRingNextRecord(
+    _In_ const QUIC_TRACE_RING_FILE_RING* Ring,
+    _In_reads_bytes_(Ring->Size)
+        const uint8_t* Buffer,
+    _Inout_ uint64_t* Offset
+    );
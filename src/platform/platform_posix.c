@@ -154,6 +154,14 @@ CxPlatInitialize(
     }
 #endif
 
+    QUIC_STATUS Status = CxPlatTlsLibraryInitialize();
+    if (QUIC_FAILED(Status)) {
+#ifndef CX_PLATFORM_DISPATCH_TABLE
+        close(RandomFd);
+#endif
+        return Status;
+    }
+
     CxPlatTotalMemory = 0x40000000; // TODO - Hard coded at 1 GB. Query real value.
 
     return QUIC_STATUS_SUCCESS;
@@ -164,6 +172,7 @@ CxPlatUninitialize(
     void
     )
 {
+    CxPlatTlsLibraryUninitialize();
 #ifndef CX_PLATFORM_DISPATCH_TABLE
     close(RandomFd);
 #endif
@@ -768,4 +777,7 @@ CxPlatLogAssert(
         (uint32_t)Line,
         File,
         Expr);
+#ifdef QUIC_EVENTS_RING
+    (void)QuicTraceRingDump(NULL);
+#endif
 }
@@ -843,9 +843,11 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 CXPLAT_TLS_RESULT_FLAGS
 CxPlatTlsProcessDataComplete(
     _In_ CXPLAT_TLS* TlsContext,
-    _Out_ uint32_t * BufferConsumed
+    _Out_ uint32_t * BufferConsumed,
+    _Out_ uint32_t * ProcessTimeUs
     )
 {
+    const uint32_t StartTimeUs = CxPlatTimeUs32();
     CXPLAT_TLS_RESULT_FLAGS ResultFlags = 0;
     CXPLAT_TLS_PROCESS_STATE* State = TlsContext->State;
 
@@ -986,9 +988,11 @@ CxPlatTlsProcessDataComplete(
                         break;
                     }
                     CXPLAT_FRE_ASSERT(TicketLen <= UINT32_MAX);
+                    BOOLEAN EarlyDataAccepted = TRUE;
                     if (!TlsContext->SecConfig->Callbacks.ReceiveTicket(
                             TlsContext->Connection,
-                            (uint32_t)TicketLen, Ticket)) {
+                            (uint32_t)TicketLen, Ticket,
+                            &EarlyDataAccepted)) {
                         //
                         // QUIC or the app rejected the resumption ticket.
                         // Abandon the early data and continue the handshake.
@@ -997,6 +1001,14 @@ CxPlatTlsProcessDataComplete(
                         ResultFlags |= CXPLAT_TLS_RESULT_EARLY_DATA_REJECT;
                         State->EarlyDataState = CXPLAT_TLS_EARLY_DATA_REJECTED;
                         State->SessionResumed = FALSE;
+                    } else if (!EarlyDataAccepted) {
+                        //
+                        // Only the early data was rejected (e.g. a possible
+                        // replay). Abandon it but keep the resumption.
+                        //
+                        ResultFlags &= ~CXPLAT_TLS_RESULT_EARLY_DATA_ACCEPT;
+                        ResultFlags |= CXPLAT_TLS_RESULT_EARLY_DATA_REJECT;
+                        State->EarlyDataState = CXPLAT_TLS_EARLY_DATA_REJECTED;
                     }
                     if (Cookie) {
                         FFI_mitls_global_free(Cookie);
@@ -1175,6 +1187,7 @@ CxPlatTlsProcessDataComplete(
     TlsContext->BufferLength = 0;
     TlsContext->Buffer = NULL;
     *BufferConsumed = BufferOffset;
+    *ProcessTimeUs = CxPlatTimeDiff32(StartTimeUs, CxPlatTimeUs32());
 
     QuicTraceLogConnVerbose(
         miTlsFfiProcesComplete,
@@ -1669,7 +1682,8 @@ CxPlatTlsOnTicketReady(
     (void)TlsContext->SecConfig->Callbacks.ReceiveTicket(
         TlsContext->Connection,
         TotalSize,
-        (uint8_t*)SerializedTicket);
+        (uint8_t*)SerializedTicket,
+        NULL);
 
     CXPLAT_FREE(SerializedTicket, QUIC_POOL_PLATFORM_TMP_ALLOC);
 }
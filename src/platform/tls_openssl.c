@@ -16,9 +16,11 @@ Abstract:
 #pragma warning(push)
 #pragma warning(disable:4100) // Unreferenced parameter errcode in inline function
 #endif
+#include "openssl/core_names.h"
 #include "openssl/err.h"
 #include "openssl/hmac.h"
 #include "openssl/kdf.h"
+#include "openssl/params.h"
 #include "openssl/pem.h"
 #include "openssl/rsa.h"
 #include "openssl/ssl.h"
@@ -34,6 +36,21 @@ uint16_t CxPlatTlsTPHeaderSize = 0;
 
 const size_t OpenSslFilePrefixLength = sizeof("..\\..\\..\\..\\..\\..\\submodules");
 
+//
+// A session ticket protection key (server side). The AES and HMAC keys are
+// derived from the key material, and the AES key schedules expanded, only once
+// when the keys are set. Each ticket then just copies the cipher context and
+// sets its IV, instead of deriving and expanding the keys again.
+//
+typedef struct CXPLAT_TLS_TICKET_KEY {
+
+    uint8_t Id[16];
+    EVP_CIPHER_CTX* EncryptCtx;
+    EVP_CIPHER_CTX* DecryptCtx;
+    uint8_t HmacKey[32];
+
+} CXPLAT_TLS_TICKET_KEY;
+
 //
 // The QUIC sec config object. Created once per listener on server side and
 // once per connection on client side.
@@ -56,6 +73,20 @@ typedef struct CXPLAT_SEC_CONFIG {
     //
     QUIC_CREDENTIAL_FLAGS Flags;
 
+    //
+    // The session ticket keys (server side), shared by all connections using
+    // the sec config. The first key encrypts new tickets; all of them decrypt.
+    //
+    CXPLAT_DISPATCH_RW_LOCK TicketKeysLock;
+    CXPLAT_TLS_TICKET_KEY* TicketKeys;
+    uint8_t TicketKeyCount;
+
+    //
+    // One reference for the owner, and one for each offloaded call the pool
+    // hasn't finished yet, since the owner may delete the config meanwhile.
+    //
+    CXPLAT_REF_COUNT RefCount;
+
 } CXPLAT_SEC_CONFIG;
 
 //
@@ -117,8 +148,113 @@ typedef struct CXPLAT_TLS {
     CXPLAT_TLS_SECRETS* TlsSecrets;
 #endif
 
+    //
+    // Indicates the server's handshake processing may be offloaded to the
+    // crypto thread pool.
+    //
+    BOOLEAN OffloadEnabled;
+
+    //
+    // Indicates a call has been offloaded. Only the first flight ever is.
+    //
+    BOOLEAN OffloadStarted;
+
+    //
+    // Indicates the offloaded call hasn't been completed by
+    // CxPlatTlsProcessDataComplete yet. Only accessed on the worker thread.
+    //
+    BOOLEAN OffloadPending;
+
+    //
+    // Indicates the offloaded call is still queued to the pool. Protected by
+    // the pool lock.
+    //
+    BOOLEAN OffloadQueued;
+
+    //
+    // Indicates the context was uninitialized while the offloaded call was
+    // running, so the call must not call back into the connection any more.
+    // Protected by OffloadLock.
+    //
+    BOOLEAN OffloadCanceled;
+
+    //
+    // Indicates the current call is running on a crypto thread. Only accessed
+    // by that thread.
+    //
+    BOOLEAN OffloadRunning;
+
+    //
+    // Held by an offloaded call for each of its callbacks into the connection,
+    // and by uninitialization to cancel the call, so that no callback can run
+    // once the connection is gone.
+    //
+    CXPLAT_LOCK OffloadLock;
+
+    //
+    // One reference for the owner, and one for an offloaded call the pool
+    // hasn't finished yet, so that uninitializing never waits on the pool.
+    //
+    CXPLAT_REF_COUNT RefCount;
+
+    //
+    // Link in the crypto thread pool's queue.
+    //
+    CXPLAT_LIST_ENTRY OffloadLink;
+
+    //
+    // Copy of the received data for the offloaded call, and how much of it
+    // was consumed.
+    //
+    uint8_t* OffloadBuffer;
+    uint32_t OffloadBufferLength;
+
+    //
+    // The time (in us) the crypto thread spent processing the offloaded call.
+    //
+    uint32_t OffloadProcessTimeUs;
+
+    //
+    // Private TLS state the offloaded call writes its output to. It is only
+    // merged into the connection's state (OffloadTarget) back on the worker
+    // thread, because the connection keeps sending from that state while the
+    // call is pending. It has its own copy of the negotiated ALPN, since the
+    // connection's may be freed while a canceled call is still running.
+    //
+    CXPLAT_TLS_PROCESS_STATE* OffloadTarget;
+    CXPLAT_TLS_PROCESS_STATE OffloadState;
+
 } CXPLAT_TLS;
 
+//
+// The pool of threads the server's handshake processing is offloaded to, so
+// that certificate signing and key exchange don't stall the other connections
+// on the worker.
+//
+typedef struct CXPLAT_TLS_OFFLOAD_POOL {
+
+    CXPLAT_LOCK Lock;
+
+    //
+    // Queue of TLS contexts with a pending process call.
+    //
+    CXPLAT_LIST_ENTRY Queue;
+
+    //
+    // Signaled when work is queued (or the pool is stopping).
+    //
+    CXPLAT_EVENT Ready;
+
+    BOOLEAN Started;
+    BOOLEAN Stopping;
+
+    uint32_t ThreadCount;
+    CXPLAT_THREAD* Threads;
+
+} CXPLAT_TLS_OFFLOAD_POOL;
+
+CXPLAT_TLS_OFFLOAD_POOL CxPlatTlsOffloadPool;
+
 typedef struct CXPLAT_HP_KEY {
     EVP_CIPHER_CTX* CipherCtx;
     CXPLAT_AEAD_TYPE Aead;
@@ -139,6 +275,11 @@ typedef struct CXPLAT_HP_KEY {
 //
 #define CXPLAT_TLS_DEFAULT_VERIFY_DEPTH  10
 
+//
+// The minimum ticket key material length; enough for AES-256.
+//
+#define CXPLAT_TLS_TICKET_KEY_MIN_MATERIAL  32
+
 QUIC_STATUS
 CxPlatTlsLibraryInitialize(
     void
@@ -163,6 +304,10 @@ CxPlatTlsLibraryInitialize(
     // LINUX_TODO:Add Check for openssl library QUIC support.
     //
 
+    CxPlatLockInitialize(&CxPlatTlsOffloadPool.Lock);
+    CxPlatListInitializeHead(&CxPlatTlsOffloadPool.Queue);
+    CxPlatEventInitialize(&CxPlatTlsOffloadPool.Ready, FALSE, FALSE);
+
     return QUIC_STATUS_SUCCESS;
 }
 
@@ -171,6 +316,195 @@ CxPlatTlsLibraryUninitialize(
     void
     )
 {
+    CXPLAT_TLS_OFFLOAD_POOL* Pool = &CxPlatTlsOffloadPool;
+
+    if (Pool->Started) {
+        CxPlatLockAcquire(&Pool->Lock);
+        CXPLAT_DBG_ASSERT(CxPlatListIsEmpty(&Pool->Queue));
+        Pool->Stopping = TRUE;
+        CxPlatLockRelease(&Pool->Lock);
+        CxPlatEventSet(Pool->Ready);
+
+        for (uint32_t i = 0; i < Pool->ThreadCount; ++i) {
+            CxPlatThreadWait(&Pool->Threads[i]);
+            CxPlatThreadDelete(&Pool->Threads[i]);
+        }
+        CXPLAT_FREE(Pool->Threads, QUIC_POOL_TLS_OFFLOAD);
+        Pool->Threads = NULL;
+        Pool->ThreadCount = 0;
+        Pool->Stopping = FALSE;
+        Pool->Started = FALSE;
+    }
+
+    CxPlatEventUninitialize(Pool->Ready);
+    CxPlatLockUninitialize(&Pool->Lock);
+}
+
+static
+void
+CxPlatTlsOffloadProcess(
+    _In_ CXPLAT_TLS* TlsContext
+    );
+
+static
+void
+CxPlatTlsOffloadCleanup(
+    _In_ CXPLAT_TLS* TlsContext
+    );
+
+static
+void
+CxPlatTlsRelease(
+    _In_ CXPLAT_TLS* TlsContext
+    );
+
+static
+void
+CxPlatTlsOffloadRelease(
+    _In_ CXPLAT_TLS* TlsContext
+    );
+
+//
+// Brackets a callback into the connection. On a crypto thread, this fails once
+// the context has been uninitialized, and otherwise holds off uninitialization
+// until CxPlatTlsCallbackExit.
+//
+static
+BOOLEAN
+CxPlatTlsCallbackEnter(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    if (!TlsContext->OffloadRunning) {
+        return TRUE;
+    }
+    CxPlatLockAcquire(&TlsContext->OffloadLock);
+    if (TlsContext->OffloadCanceled) {
+        CxPlatLockRelease(&TlsContext->OffloadLock);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static
+void
+CxPlatTlsCallbackExit(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    if (TlsContext->OffloadRunning) {
+        CxPlatLockRelease(&TlsContext->OffloadLock);
+    }
+}
+
+CXPLAT_THREAD_CALLBACK(CxPlatTlsOffloadThread, Context)
+{
+    CXPLAT_TLS_OFFLOAD_POOL* Pool = (CXPLAT_TLS_OFFLOAD_POOL*)Context;
+
+    CxPlatLockAcquire(&Pool->Lock);
+    while (!Pool->Stopping) {
+        if (CxPlatListIsEmpty(&Pool->Queue)) {
+            CxPlatLockRelease(&Pool->Lock);
+            CxPlatEventWaitForever(Pool->Ready);
+            CxPlatLockAcquire(&Pool->Lock);
+            continue;
+        }
+
+        CXPLAT_TLS* TlsContext =
+            CXPLAT_CONTAINING_RECORD(
+                CxPlatListRemoveHead(&Pool->Queue),
+                CXPLAT_TLS,
+                OffloadLink);
+        TlsContext->OffloadQueued = FALSE;
+        if (!CxPlatListIsEmpty(&Pool->Queue)) {
+            CxPlatEventSet(Pool->Ready); // Wake another thread for the rest.
+        }
+        CxPlatLockRelease(&Pool->Lock);
+
+        CxPlatTlsOffloadProcess(TlsContext);
+
+        CxPlatLockAcquire(&Pool->Lock);
+    }
+    CxPlatLockRelease(&Pool->Lock);
+
+    CxPlatEventSet(Pool->Ready); // Wake the next thread so it stops too.
+
+    CXPLAT_THREAD_RETURN(0);
+}
+
+//
+// Starts the crypto thread pool, if it isn't already running.
+//
+static
+QUIC_STATUS
+CxPlatTlsOffloadPoolStart(
+    void
+    )
+{
+    CXPLAT_TLS_OFFLOAD_POOL* Pool = &CxPlatTlsOffloadPool;
+    QUIC_STATUS Status = QUIC_STATUS_SUCCESS;
+
+    CxPlatLockAcquire(&Pool->Lock);
+    if (Pool->Started) {
+        goto Exit;
+    }
+
+    //
+    // Leave at least half the processors to the workers.
+    //
+    uint32_t ThreadCount = CxPlatProcActiveCount() / 2;
+    if (ThreadCount == 0) {
+        ThreadCount = 1;
+    }
+
+    Pool->Threads =
+        CXPLAT_ALLOC_NONPAGED(
+            sizeof(CXPLAT_THREAD) * ThreadCount,
+            QUIC_POOL_TLS_OFFLOAD);
+    if (Pool->Threads == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "TLS offload threads",
+            sizeof(CXPLAT_THREAD) * ThreadCount);
+        Status = QUIC_STATUS_OUT_OF_MEMORY;
+        goto Exit;
+    }
+
+    CXPLAT_THREAD_CONFIG ThreadConfig = {
+        CXPLAT_THREAD_FLAG_NONE,
+        0,
+        "quic_tls",
+        CxPlatTlsOffloadThread,
+        Pool
+    };
+
+    for (Pool->ThreadCount = 0; Pool->ThreadCount < ThreadCount; ++Pool->ThreadCount) {
+        Status = CxPlatThreadCreate(&ThreadConfig, &Pool->Threads[Pool->ThreadCount]);
+        if (QUIC_FAILED(Status)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                Status,
+                "CxPlatThreadCreate");
+            break;
+        }
+    }
+
+    if (Pool->ThreadCount == 0) {
+        CXPLAT_FREE(Pool->Threads, QUIC_POOL_TLS_OFFLOAD);
+        Pool->Threads = NULL;
+        goto Exit;
+    }
+
+    Status = QUIC_STATUS_SUCCESS; // Run with the threads that did start.
+    Pool->Started = TRUE;
+
+Exit:
+
+    CxPlatLockRelease(&Pool->Lock);
+
+    return Status;
 }
 
 static
@@ -233,19 +567,26 @@ CxPlatTlsCertificateVerifyCallback(
         return FALSE;
     }
 
-    if ((TlsContext->SecConfig->Flags & QUIC_CREDENTIAL_FLAG_INDICATE_CERTIFICATE_RECEIVED) &&
-        !TlsContext->SecConfig->Callbacks.CertificateReceived(
-            TlsContext->Connection,
-            x509_ctx,
-            0,
-            0)) {
-        QuicTraceEvent(
-            TlsError,
-            "[ tls][%p] ERROR, %s.",
-            TlsContext->Connection,
-            "Indicate certificate received failed");
-        X509_STORE_CTX_set_error(x509_ctx, X509_V_ERR_CERT_REJECTED);
-        return FALSE;
+    if (TlsContext->SecConfig->Flags & QUIC_CREDENTIAL_FLAG_INDICATE_CERTIFICATE_RECEIVED) {
+        BOOLEAN Accepted = FALSE;
+        if (CxPlatTlsCallbackEnter(TlsContext)) {
+            Accepted =
+                TlsContext->SecConfig->Callbacks.CertificateReceived(
+                    TlsContext->Connection,
+                    x509_ctx,
+                    0,
+                    0);
+            CxPlatTlsCallbackExit(TlsContext);
+        }
+        if (!Accepted) {
+            QuicTraceEvent(
+                TlsError,
+                "[ tls][%p] ERROR, %s.",
+                TlsContext->Connection,
+                "Indicate certificate received failed");
+            X509_STORE_CTX_set_error(x509_ctx, X509_V_ERR_CERT_REJECTED);
+            return FALSE;
+        }
     }
 
     return TRUE;
@@ -345,7 +686,10 @@ CxPlatTlsSetEncryptionSecretsCallback(
         TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_READ_KEY_UPDATED;
     }
 #ifdef CXPLAT_TLS_SECRETS_SUPPORT
-    if (TlsContext->TlsSecrets != NULL) {
+    //
+    // The secrets are written to the connection's memory.
+    //
+    if (TlsContext->TlsSecrets != NULL && CxPlatTlsCallbackEnter(TlsContext)) {
         TlsContext->TlsSecrets->SecretLength = (uint8_t)SecretLen;
         switch (KeyType) {
         case QUIC_PACKET_KEY_HANDSHAKE:
@@ -383,6 +727,7 @@ CxPlatTlsSetEncryptionSecretsCallback(
         default:
             break;
         }
+        CxPlatTlsCallbackExit(TlsContext);
     }
 #endif
 
@@ -545,7 +890,224 @@ CxPlatTlsClientHelloCallback(
         return SSL_CLIENT_HELLO_ERROR;
     }
 
-    return SSL_CLIENT_HELLO_SUCCESS;
+    return SSL_CLIENT_HELLO_SUCCESS;
+}
+
+//
+// Frees an array of session ticket keys, including partially initialized ones.
+//
+static
+void
+CxPlatTlsTicketKeysFree(
+    _In_reads_(KeyCount) _Frees_ptr_opt_ CXPLAT_TLS_TICKET_KEY* Keys,
+    _In_ uint8_t KeyCount
+    )
+{
+    if (Keys == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < KeyCount; ++i) {
+        if (Keys[i].EncryptCtx != NULL) {
+            EVP_CIPHER_CTX_free(Keys[i].EncryptCtx);
+        }
+        if (Keys[i].DecryptCtx != NULL) {
+            EVP_CIPHER_CTX_free(Keys[i].DecryptCtx);
+        }
+    }
+    CxPlatSecureZeroMemory(Keys, KeyCount * sizeof(CXPLAT_TLS_TICKET_KEY));
+    CXPLAT_FREE(Keys, QUIC_POOL_TLS_TICKET_KEYS);
+}
+
+//
+// Derives the AES and HMAC keys from the key material and initializes their
+// contexts.
+//
+static
+QUIC_STATUS
+CxPlatTlsTicketKeyInitialize(
+    _Out_ CXPLAT_TLS_TICKET_KEY* Key,
+    _In_ const QUIC_TICKET_KEY_CONFIG* KeyConfig
+    )
+{
+    static const char AesLabel[] = "msquic ticket aes";
+    static const char HmacLabel[] = "msquic ticket hmac";
+    uint8_t AesKey[32];
+    unsigned int Length = sizeof(AesKey);
+    QUIC_STATUS Status = QUIC_STATUS_TLS_ERROR;
+
+    CxPlatCopyMemory(Key->Id, KeyConfig->Id, sizeof(Key->Id));
+    Key->EncryptCtx = EVP_CIPHER_CTX_new();
+    Key->DecryptCtx = EVP_CIPHER_CTX_new();
+    if (Key->EncryptCtx == NULL || Key->DecryptCtx == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "ticket key contexts",
+            0);
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+
+    if (HMAC(
+            EVP_sha256(),
+            KeyConfig->Material,
+            KeyConfig->MaterialLength,
+            (const uint8_t*)AesLabel,
+            sizeof(AesLabel) - 1,
+            AesKey,
+            &Length) == NULL ||
+        HMAC(
+            EVP_sha256(),
+            KeyConfig->Material,
+            KeyConfig->MaterialLength,
+            (const uint8_t*)HmacLabel,
+            sizeof(HmacLabel) - 1,
+            Key->HmacKey,
+            &Length) == NULL) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            ERR_get_error(),
+            "HMAC (ticket key derivation) failed");
+        goto Exit;
+    }
+
+    if (EVP_EncryptInit_ex(Key->EncryptCtx, EVP_aes_256_cbc(), NULL, AesKey, NULL) != 1 ||
+        EVP_DecryptInit_ex(Key->DecryptCtx, EVP_aes_256_cbc(), NULL, AesKey, NULL) != 1) {
+        QuicTraceEvent(
+            LibraryErrorStatus,
+            "[ lib] ERROR, %u, %s.",
+            ERR_get_error(),
+            "EVP_CipherInit_ex (ticket key) failed");
+        goto Exit;
+    }
+
+    Status = QUIC_STATUS_SUCCESS;
+
+Exit:
+
+    CxPlatSecureZeroMemory(AesKey, sizeof(AesKey));
+
+    return Status;
+}
+
+//
+// Replaces the sec config's session ticket keys. Connections using the
+// previous keys finish with them before they are freed.
+//
+static
+QUIC_STATUS
+CxPlatTlsTicketKeysSet(
+    _In_ CXPLAT_SEC_CONFIG* SecurityConfig,
+    _In_reads_(KeyCount) const QUIC_TICKET_KEY_CONFIG* KeyConfig,
+    _In_ uint8_t KeyCount
+    )
+{
+    CXPLAT_TLS_TICKET_KEY* Keys =
+        CXPLAT_ALLOC_NONPAGED(KeyCount * sizeof(CXPLAT_TLS_TICKET_KEY), QUIC_POOL_TLS_TICKET_KEYS);
+    if (Keys == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "CXPLAT_TLS_TICKET_KEY",
+            KeyCount * sizeof(CXPLAT_TLS_TICKET_KEY));
+        return QUIC_STATUS_OUT_OF_MEMORY;
+    }
+    CxPlatZeroMemory(Keys, KeyCount * sizeof(CXPLAT_TLS_TICKET_KEY));
+
+    for (uint8_t i = 0; i < KeyCount; ++i) {
+        QUIC_STATUS Status = CxPlatTlsTicketKeyInitialize(&Keys[i], &KeyConfig[i]);
+        if (QUIC_FAILED(Status)) {
+            CxPlatTlsTicketKeysFree(Keys, KeyCount);
+            return Status;
+        }
+    }
+
+    CxPlatDispatchRwLockAcquireExclusive(&SecurityConfig->TicketKeysLock);
+    CXPLAT_TLS_TICKET_KEY* OldKeys = SecurityConfig->TicketKeys;
+    uint8_t OldKeyCount = SecurityConfig->TicketKeyCount;
+    SecurityConfig->TicketKeys = Keys;
+    SecurityConfig->TicketKeyCount = KeyCount;
+    CxPlatDispatchRwLockReleaseExclusive(&SecurityConfig->TicketKeysLock);
+
+    CxPlatTlsTicketKeysFree(OldKeys, OldKeyCount);
+
+    return QUIC_STATUS_SUCCESS;
+}
+
+//
+// Sets the HMAC key (and SHA-256) on the MAC context OpenSSL passes in.
+//
+static
+BOOLEAN
+CxPlatTlsTicketKeyMacInit(
+    _In_ const CXPLAT_TLS_TICKET_KEY* Key,
+    _Inout_ EVP_MAC_CTX* MacCtx
+    )
+{
+    OSSL_PARAM Params[2];
+    Params[0] =
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0);
+    Params[1] = OSSL_PARAM_construct_end();
+    return EVP_MAC_init(MacCtx, Key->HmacKey, sizeof(Key->HmacKey), Params) == 1;
+}
+
+//
+// Called by OpenSSL to set up the cipher and MAC contexts to encrypt (Enc)
+// or decrypt a session ticket, from the sec config's cached keys.
+//
+int
+CxPlatTlsTicketKeyCallback(
+    _In_ SSL *Ssl,
+    _Inout_updates_bytes_(16) uint8_t* KeyName,
+    _Inout_ uint8_t* Iv,
+    _Inout_ EVP_CIPHER_CTX* CipherCtx,
+    _Inout_ EVP_MAC_CTX* MacCtx,
+    _In_ int Enc
+    )
+{
+    CXPLAT_TLS* TlsContext = SSL_get_app_data(Ssl);
+    CXPLAT_SEC_CONFIG* SecurityConfig = TlsContext->SecConfig;
+    int Result = 0;
+
+    CxPlatDispatchRwLockAcquireShared(&SecurityConfig->TicketKeysLock);
+
+    if (Enc) {
+        const CXPLAT_TLS_TICKET_KEY* Key = &SecurityConfig->TicketKeys[0];
+        const int IvLength = EVP_CIPHER_CTX_iv_length(Key->EncryptCtx);
+        if (QUIC_SUCCEEDED(CxPlatRandom(IvLength, Iv)) &&
+            EVP_CIPHER_CTX_copy(CipherCtx, Key->EncryptCtx) == 1 &&
+            EVP_EncryptInit_ex(CipherCtx, NULL, NULL, NULL, Iv) == 1 &&
+            CxPlatTlsTicketKeyMacInit(Key, MacCtx)) {
+            CxPlatCopyMemory(KeyName, Key->Id, sizeof(Key->Id));
+            Result = 1;
+        } else {
+            Result = -1;
+        }
+
+    } else {
+        for (uint8_t i = 0; i < SecurityConfig->TicketKeyCount; ++i) {
+            const CXPLAT_TLS_TICKET_KEY* Key = &SecurityConfig->TicketKeys[i];
+            if (memcmp(KeyName, Key->Id, sizeof(Key->Id)) != 0) {
+                continue;
+            }
+            if (EVP_CIPHER_CTX_copy(CipherCtx, Key->DecryptCtx) == 1 &&
+                EVP_DecryptInit_ex(CipherCtx, NULL, NULL, NULL, Iv) == 1 &&
+                CxPlatTlsTicketKeyMacInit(Key, MacCtx)) {
+                //
+                // Tickets from older keys are still accepted, but are renewed
+                // with the current key.
+                //
+                Result = i == 0 ? 1 : 2;
+            } else {
+                Result = -1;
+            }
+            break;
+        }
+    }
+
+    CxPlatDispatchRwLockReleaseShared(&SecurityConfig->TicketKeysLock);
+
+    return Result;
 }
 
 SSL_QUIC_METHOD OpenSslQuicCallbacks = {
@@ -649,6 +1211,10 @@ CxPlatTlsSecConfigCreate(
 
     SecurityConfig->Callbacks = *TlsCallbacks;
     SecurityConfig->Flags = CredConfig->Flags;
+    CxPlatRefInitialize(&SecurityConfig->RefCount);
+    CxPlatDispatchRwLockInitialize(&SecurityConfig->TicketKeysLock);
+    SecurityConfig->TicketKeys = NULL;
+    SecurityConfig->TicketKeyCount = 0;
 
     //
     // Create the a SSL context for the security config.
@@ -857,8 +1423,69 @@ CxPlatTlsSecConfigCreate(
             goto Exit;
         }
 
+        //
+        // Without an explicit chain, OpenSSL builds one from the cert store
+        // (including a full verification) on every handshake. Build it once
+        // here instead, and have each handshake reuse it.
+        //
+        STACK_OF(X509)* ChainCerts = NULL;
+        SSL_CTX_get0_chain_certs(SecurityConfig->SSLCtx, &ChainCerts);
+        if (ChainCerts == NULL || sk_X509_num(ChainCerts) == 0) {
+            Ret =
+                SSL_CTX_build_cert_chain(
+                    SecurityConfig->SSLCtx,
+                    SSL_BUILD_CHAIN_FLAG_IGNORE_ERROR | SSL_BUILD_CHAIN_FLAG_CLEAR_ERROR);
+            if (Ret <= 0) {
+                QuicTraceEvent(
+                    LibraryErrorStatus,
+                    "[ lib] ERROR, %u, %s.",
+                    ERR_get_error(),
+                    "SSL_CTX_build_cert_chain failed");
+                Status = QUIC_STATUS_TLS_ERROR;
+                goto Exit;
+            }
+        }
+        SSL_CTX_set_mode(SecurityConfig->SSLCtx, SSL_MODE_NO_AUTO_CHAIN);
+
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L && !defined(OPENSSL_NO_COMP_ALG)
+        //
+        // Compress the chain (RFC 8879) once up front, for the clients that
+        // support it. A smaller server flight is less likely to hit the
+        // anti-amplification limit before the client's address is validated.
+        // Failure just means the chain is sent uncompressed.
+        //
+        if (!SSL_CTX_compress_certs(SecurityConfig->SSLCtx, 0)) {
+            QuicTraceEvent(
+                LibraryErrorStatus,
+                "[ lib] ERROR, %u, %s.",
+                ERR_get_error(),
+                "SSL_CTX_compress_certs failed");
+            ERR_clear_error();
+        }
+#endif
+
         SSL_CTX_set_max_early_data(SecurityConfig->SSLCtx, UINT32_MAX);
         SSL_CTX_set_client_hello_cb(SecurityConfig->SSLCtx, CxPlatTlsClientHelloCallback, NULL);
+
+        //
+        // Start with a random ticket key, like OpenSSL would by default, until
+        // the app sets its own.
+        //
+        QUIC_TICKET_KEY_CONFIG KeyConfig;
+        CxPlatZeroMemory(&KeyConfig, sizeof(KeyConfig));
+        KeyConfig.MaterialLength = sizeof(KeyConfig.Material);
+        Status = CxPlatRandom(sizeof(KeyConfig.Id), KeyConfig.Id);
+        if (QUIC_SUCCEEDED(Status)) {
+            Status = CxPlatRandom(sizeof(KeyConfig.Material), KeyConfig.Material);
+        }
+        if (QUIC_SUCCEEDED(Status)) {
+            Status = CxPlatTlsTicketKeysSet(SecurityConfig, &KeyConfig, 1);
+        }
+        CxPlatSecureZeroMemory(&KeyConfig, sizeof(KeyConfig));
+        if (QUIC_FAILED(Status)) {
+            goto Exit;
+        }
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(SecurityConfig->SSLCtx, CxPlatTlsTicketKeyCallback);
     }
 
     //
@@ -891,21 +1518,38 @@ Exit:
     return Status;
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
+static
 void
-CxPlatTlsSecConfigDelete(
-    __drv_freesMem(ServerConfig) _Frees_ptr_ _In_
-        CXPLAT_SEC_CONFIG* SecurityConfig
+CxPlatTlsSecConfigRelease(
+    _In_ CXPLAT_SEC_CONFIG* SecurityConfig
     )
 {
+    if (!CxPlatRefDecrement(&SecurityConfig->RefCount)) {
+        return;
+    }
+
     if (SecurityConfig->SSLCtx != NULL) {
         SSL_CTX_free(SecurityConfig->SSLCtx);
         SecurityConfig->SSLCtx = NULL;
     }
 
+    CxPlatTlsTicketKeysFree(SecurityConfig->TicketKeys, SecurityConfig->TicketKeyCount);
+    CxPlatDispatchRwLockUninitialize(&SecurityConfig->TicketKeysLock);
+
+    CxPlatRefUninitialize(&SecurityConfig->RefCount);
     CXPLAT_FREE(SecurityConfig, QUIC_POOL_TLS_SECCONF);
 }
 
+_IRQL_requires_max_(PASSIVE_LEVEL)
+void
+CxPlatTlsSecConfigDelete(
+    __drv_freesMem(ServerConfig) _Frees_ptr_ _In_
+        CXPLAT_SEC_CONFIG* SecurityConfig
+    )
+{
+    CxPlatTlsSecConfigRelease(SecurityConfig);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 QUIC_STATUS
 CxPlatTlsSecConfigSetTicketKeys(
@@ -914,10 +1558,24 @@ CxPlatTlsSecConfigSetTicketKeys(
     _In_ uint8_t KeyCount
     )
 {
-    UNREFERENCED_PARAMETER(SecurityConfig);
-    UNREFERENCED_PARAMETER(KeyConfig);
-    UNREFERENCED_PARAMETER(KeyCount);
-    return QUIC_STATUS_NOT_SUPPORTED;
+    CXPLAT_DBG_ASSERT(KeyCount >= 1);
+
+    if (SecurityConfig->Flags & QUIC_CREDENTIAL_FLAG_CLIENT) {
+        return QUIC_STATUS_NOT_SUPPORTED;
+    }
+
+    if (KeyCount > QUIC_MAX_TICKET_KEY_COUNT) {
+        return QUIC_STATUS_INVALID_PARAMETER;
+    }
+
+    for (uint8_t i = 0; i < KeyCount; ++i) {
+        if (KeyConfig[i].MaterialLength < CXPLAT_TLS_TICKET_KEY_MIN_MATERIAL ||
+            KeyConfig[i].MaterialLength > sizeof(KeyConfig[i].Material)) {
+            return QUIC_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    return CxPlatTlsTicketKeysSet(SecurityConfig, KeyConfig, KeyCount);
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -944,6 +1602,8 @@ CxPlatTlsInitialize(
     }
 
     CxPlatZeroMemory(TlsContext, sizeof(CXPLAT_TLS));
+    CxPlatRefInitialize(&TlsContext->RefCount);
+    CxPlatLockInitialize(&TlsContext->OffloadLock);
 
     TlsContext->Connection = Config->Connection;
     TlsContext->IsServer = Config->IsServer;
@@ -955,6 +1615,14 @@ CxPlatTlsInitialize(
     TlsContext->TlsSecrets = Config->TlsSecrets;
 #endif
 
+    if (Config->IsServer && Config->OffloadEnabled) {
+        //
+        // If the pool can't be started, the handshake is just processed
+        // inline instead.
+        //
+        TlsContext->OffloadEnabled = QUIC_SUCCEEDED(CxPlatTlsOffloadPoolStart());
+    }
+
     QuicTraceLogConnVerbose(
         OpenSslContextCreated,
         TlsContext->Connection,
@@ -1061,25 +1729,68 @@ CxPlatTlsUninitialize(
             TlsContext->Connection,
             "Cleaning up");
 
-        if (TlsContext->SNI != NULL) {
-            CXPLAT_FREE(TlsContext->SNI, QUIC_POOL_TLS_SNI);
-            TlsContext->SNI = NULL;
+        if (TlsContext->OffloadStarted) {
+            //
+            // The pool may still be using the context. A queued call is just
+            // pulled from the queue. A running one is canceled instead, and
+            // drops its references itself when it finishes. Taking the offload
+            // lock waits out any callback into the connection it is making
+            // right now; it makes none after that.
+            //
+            BOOLEAN Dequeued = FALSE;
+            CxPlatLockAcquire(&CxPlatTlsOffloadPool.Lock);
+            if (TlsContext->OffloadQueued) {
+                CxPlatListEntryRemove(&TlsContext->OffloadLink);
+                TlsContext->OffloadQueued = FALSE;
+                Dequeued = TRUE;
+            }
+            CxPlatLockRelease(&CxPlatTlsOffloadPool.Lock);
+            if (Dequeued) {
+                CxPlatTlsOffloadRelease(TlsContext);
+            } else {
+                CxPlatLockAcquire(&TlsContext->OffloadLock);
+                TlsContext->OffloadCanceled = TRUE;
+                CxPlatLockRelease(&TlsContext->OffloadLock);
+            }
         }
 
-        if (TlsContext->Ssl != NULL) {
-            SSL_free(TlsContext->Ssl);
-            TlsContext->Ssl = NULL;
-        }
+        CxPlatTlsRelease(TlsContext);
+    }
+}
+
+static
+void
+CxPlatTlsRelease(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    if (!CxPlatRefDecrement(&TlsContext->RefCount)) {
+        return;
+    }
+
+    if (TlsContext->OffloadEnabled) {
+        CxPlatTlsOffloadCleanup(TlsContext);
+    }
+
+    if (TlsContext->SNI != NULL) {
+        CXPLAT_FREE(TlsContext->SNI, QUIC_POOL_TLS_SNI);
+        TlsContext->SNI = NULL;
+    }
 
-        CXPLAT_FREE(TlsContext, QUIC_POOL_TLS_CTX);
+    if (TlsContext->Ssl != NULL) {
+        SSL_free(TlsContext->Ssl);
+        TlsContext->Ssl = NULL;
     }
+
+    CxPlatLockUninitialize(&TlsContext->OffloadLock);
+    CxPlatRefUninitialize(&TlsContext->RefCount);
+    CXPLAT_FREE(TlsContext, QUIC_POOL_TLS_CTX);
 }
 
-_IRQL_requires_max_(PASSIVE_LEVEL)
+static
 CXPLAT_TLS_RESULT_FLAGS
-CxPlatTlsProcessData(
+CxPlatTlsProcessDataInternal(
     _In_ CXPLAT_TLS* TlsContext,
-    _In_ CXPLAT_TLS_DATA_TYPE DataType,
     _In_reads_bytes_(*BufferLength)
         const uint8_t* Buffer,
     _Inout_ uint32_t* BufferLength,
@@ -1089,19 +1800,6 @@ CxPlatTlsProcessData(
     int Ret = 0;
     int Err = 0;
 
-    CXPLAT_DBG_ASSERT(Buffer != NULL || *BufferLength == 0);
-
-    if (DataType == CXPLAT_TLS_TICKET_DATA) {
-        TlsContext->ResultFlags = CXPLAT_TLS_RESULT_ERROR;
-
-        QuicTraceLogConnVerbose(
-            OpenSsslIgnoringTicket,
-            TlsContext->Connection,
-            "Ignoring %u ticket bytes",
-            *BufferLength);
-        goto Exit;
-    }
-
     TlsContext->State = State;
     TlsContext->ResultFlags = 0;
 
@@ -1223,10 +1921,16 @@ CxPlatTlsProcessData(
                 TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
                 goto Exit;
             }
-            if (!TlsContext->SecConfig->Callbacks.ReceiveTP(
-                    TlsContext->Connection,
-                    (uint16_t)TransportParamLen,
-                    TransportParams)) {
+            BOOLEAN Accepted = FALSE;
+            if (CxPlatTlsCallbackEnter(TlsContext)) {
+                Accepted =
+                    TlsContext->SecConfig->Callbacks.ReceiveTP(
+                        TlsContext->Connection,
+                        (uint16_t)TransportParamLen,
+                        TransportParams);
+                CxPlatTlsCallbackExit(TlsContext);
+            }
+            if (!Accepted) {
                 TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
                 goto Exit;
             }
@@ -1294,16 +1998,330 @@ Exit:
     return TlsContext->ResultFlags;
 }
 
+//
+// Queues the process call to the crypto thread pool. Returns FALSE if the call
+// should just be processed inline instead.
+//
+static
+BOOLEAN
+CxPlatTlsOffloadQueue(
+    _In_ CXPLAT_TLS* TlsContext,
+    _In_reads_bytes_(BufferLength)
+        const uint8_t* Buffer,
+    _In_ uint32_t BufferLength,
+    _In_ CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    CXPLAT_TLS_OFFLOAD_POOL* Pool = &CxPlatTlsOffloadPool;
+    CXPLAT_TLS_PROCESS_STATE* OffloadState = &TlsContext->OffloadState;
+
+    //
+    // The received data is copied, since the connection's receive buffer may
+    // change while the call is pending.
+    //
+    TlsContext->OffloadBuffer = CXPLAT_ALLOC_NONPAGED(BufferLength, QUIC_POOL_TLS_OFFLOAD);
+    if (TlsContext->OffloadBuffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "TLS offload buffer",
+            BufferLength);
+        return FALSE;
+    }
+
+    OffloadState->Buffer = CXPLAT_ALLOC_NONPAGED(State->BufferAllocLength, QUIC_POOL_TLS_BUFFER);
+    if (OffloadState->Buffer == NULL) {
+        QuicTraceEvent(
+            AllocFailure,
+            "Allocation of '%s' failed. (%llu bytes)",
+            "TLS offload crypto buffer",
+            State->BufferAllocLength);
+        CXPLAT_FREE(TlsContext->OffloadBuffer, QUIC_POOL_TLS_OFFLOAD);
+        TlsContext->OffloadBuffer = NULL;
+        return FALSE;
+    }
+
+    CxPlatCopyMemory(TlsContext->OffloadBuffer, Buffer, BufferLength);
+    TlsContext->OffloadBufferLength = BufferLength;
+
+    //
+    // The offloaded call starts from a snapshot of the connection's state, but
+    // with no keys or buffered data, so that everything it produces is new.
+    //
+    OffloadState->HandshakeComplete = State->HandshakeComplete;
+    OffloadState->SessionResumed = State->SessionResumed;
+    OffloadState->EarlyDataState = State->EarlyDataState;
+    OffloadState->ReadKey = State->ReadKey;
+    OffloadState->WriteKey = State->WriteKey;
+    OffloadState->BufferLength = 0;
+    OffloadState->BufferAllocLength = State->BufferAllocLength;
+    OffloadState->BufferTotalLength = State->BufferTotalLength;
+    OffloadState->BufferOffsetHandshake = State->BufferOffsetHandshake;
+    OffloadState->BufferOffset1Rtt = State->BufferOffset1Rtt;
+    OffloadState->NegotiatedAlpn = NULL;
+    if (State->NegotiatedAlpn != NULL) {
+        const uint16_t AlpnLength = 1 + (uint16_t)State->NegotiatedAlpn[0];
+        uint8_t* Alpn = OffloadState->SmallAlpnBuffer;
+        if (AlpnLength > sizeof(OffloadState->SmallAlpnBuffer)) {
+            Alpn = CXPLAT_ALLOC_NONPAGED(AlpnLength, QUIC_POOL_ALPN);
+            if (Alpn == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "TLS offload ALPN",
+                    AlpnLength);
+                CxPlatTlsOffloadCleanup(TlsContext);
+                return FALSE;
+            }
+        }
+        CxPlatCopyMemory(Alpn, State->NegotiatedAlpn, AlpnLength);
+        OffloadState->NegotiatedAlpn = Alpn;
+    }
+    TlsContext->OffloadTarget = State;
+
+    QuicTraceLogConnVerbose(
+        OpenSslProcessDataOffload,
+        TlsContext->Connection,
+        "Offloading %u received bytes",
+        BufferLength);
+
+    TlsContext->OffloadStarted = TRUE;
+    TlsContext->OffloadPending = TRUE;
+    CxPlatRefIncrement(&TlsContext->RefCount);
+    CxPlatRefIncrement(&TlsContext->SecConfig->RefCount);
+
+    CxPlatLockAcquire(&Pool->Lock);
+    TlsContext->OffloadQueued = TRUE;
+    CxPlatListInsertTail(&Pool->Queue, &TlsContext->OffloadLink);
+    CxPlatLockRelease(&Pool->Lock);
+    CxPlatEventSet(Pool->Ready);
+
+    return TRUE;
+}
+
+static
+void
+CxPlatTlsOffloadProcess(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    const uint32_t StartTimeUs = CxPlatTimeUs32();
+    TlsContext->OffloadRunning = TRUE;
+    (void)CxPlatTlsProcessDataInternal(
+        TlsContext,
+        TlsContext->OffloadBuffer,
+        &TlsContext->OffloadBufferLength,
+        &TlsContext->OffloadState);
+    TlsContext->OffloadProcessTimeUs =
+        CxPlatTimeDiff32(StartTimeUs, CxPlatTimeUs32());
+
+    if (CxPlatTlsCallbackEnter(TlsContext)) {
+        TlsContext->SecConfig->Callbacks.ProcessComplete(TlsContext->Connection);
+        CxPlatTlsCallbackExit(TlsContext);
+    }
+    TlsContext->OffloadRunning = FALSE;
+
+    CxPlatTlsOffloadRelease(TlsContext);
+}
+
+//
+// Drops the references an offloaded call holds, once it is finished or was
+// never run.
+//
+static
+void
+CxPlatTlsOffloadRelease(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    CXPLAT_SEC_CONFIG* SecConfig = TlsContext->SecConfig;
+    CxPlatTlsRelease(TlsContext);
+    CxPlatTlsSecConfigRelease(SecConfig);
+}
+
+static
+void
+CxPlatTlsOffloadCleanup(
+    _In_ CXPLAT_TLS* TlsContext
+    )
+{
+    CXPLAT_TLS_PROCESS_STATE* OffloadState = &TlsContext->OffloadState;
+
+    if (TlsContext->OffloadBuffer != NULL) {
+        CXPLAT_FREE(TlsContext->OffloadBuffer, QUIC_POOL_TLS_OFFLOAD);
+        TlsContext->OffloadBuffer = NULL;
+    }
+    if (OffloadState->Buffer != NULL) {
+        CXPLAT_FREE(OffloadState->Buffer, QUIC_POOL_TLS_BUFFER);
+        OffloadState->Buffer = NULL;
+    }
+    if (OffloadState->NegotiatedAlpn != NULL &&
+        OffloadState->NegotiatedAlpn != OffloadState->SmallAlpnBuffer) {
+        CXPLAT_FREE(OffloadState->NegotiatedAlpn, QUIC_POOL_ALPN);
+    }
+    OffloadState->NegotiatedAlpn = NULL;
+    for (uint32_t i = 0; i < QUIC_PACKET_KEY_COUNT; ++i) {
+        QuicPacketKeyFree(OffloadState->ReadKeys[i]);
+        OffloadState->ReadKeys[i] = NULL;
+        QuicPacketKeyFree(OffloadState->WriteKeys[i]);
+        OffloadState->WriteKeys[i] = NULL;
+    }
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+CXPLAT_TLS_RESULT_FLAGS
+CxPlatTlsProcessData(
+    _In_ CXPLAT_TLS* TlsContext,
+    _In_ CXPLAT_TLS_DATA_TYPE DataType,
+    _In_reads_bytes_(*BufferLength)
+        const uint8_t* Buffer,
+    _Inout_ uint32_t* BufferLength,
+    _Inout_ CXPLAT_TLS_PROCESS_STATE* State
+    )
+{
+    CXPLAT_DBG_ASSERT(Buffer != NULL || *BufferLength == 0);
+    CXPLAT_DBG_ASSERT(!TlsContext->OffloadPending);
+
+    if (DataType == CXPLAT_TLS_TICKET_DATA) {
+        TlsContext->ResultFlags = CXPLAT_TLS_RESULT_ERROR;
+
+        QuicTraceLogConnVerbose(
+            OpenSsslIgnoringTicket,
+            TlsContext->Connection,
+            "Ignoring %u ticket bytes",
+            *BufferLength);
+        return TlsContext->ResultFlags;
+    }
+
+    //
+    // Only the server's first flight is offloaded, since that is where the
+    // certificate signature and key exchange happen. Everything after it is
+    // cheap enough to process inline.
+    //
+    if (TlsContext->OffloadEnabled &&
+        !TlsContext->OffloadStarted &&
+        *BufferLength != 0 &&
+        State->WriteKeys[QUIC_PACKET_KEY_HANDSHAKE] == NULL &&
+        CxPlatTlsOffloadQueue(TlsContext, Buffer, *BufferLength, State)) {
+        return CXPLAT_TLS_RESULT_PENDING;
+    }
+
+    return CxPlatTlsProcessDataInternal(TlsContext, Buffer, BufferLength, State);
+}
+
 _IRQL_requires_max_(PASSIVE_LEVEL)
 CXPLAT_TLS_RESULT_FLAGS
 CxPlatTlsProcessDataComplete(
     _In_ CXPLAT_TLS* TlsContext,
-    _Out_ uint32_t * ConsumedBuffer
+    _Out_ uint32_t * ConsumedBuffer,
+    _Out_ uint32_t * ProcessTimeUs
     )
 {
-    UNREFERENCED_PARAMETER(TlsContext);
-    *ConsumedBuffer = 0;
-    return CXPLAT_TLS_RESULT_ERROR;
+    if (!TlsContext->OffloadPending) {
+        *ConsumedBuffer = 0;
+        *ProcessTimeUs = 0;
+        return CXPLAT_TLS_RESULT_ERROR;
+    }
+
+    *ProcessTimeUs = TlsContext->OffloadProcessTimeUs;
+
+    CXPLAT_TLS_PROCESS_STATE* State = TlsContext->OffloadTarget;
+    CXPLAT_TLS_PROCESS_STATE* OffloadState = &TlsContext->OffloadState;
+
+    TlsContext->OffloadPending = FALSE;
+    TlsContext->State = State;
+
+    //
+    // Merge the offloaded call's output into the connection's state. Nothing
+    // but the TLS layer writes the state's crypto data and keys, so the
+    // connection's state can only have shrunk (as data was acknowledged) in
+    // the meantime.
+    //
+    CXPLAT_DBG_ASSERT(
+        State->BufferTotalLength + OffloadState->BufferLength ==
+        OffloadState->BufferTotalLength);
+
+    uint32_t Length = (uint32_t)State->BufferLength + OffloadState->BufferLength;
+    if (Length > 0xF000) {
+        QuicTraceEvent(
+            TlsError,
+            "[ tls][%p] ERROR, %s.",
+            TlsContext->Connection,
+            "Too much handshake data");
+        TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
+
+    } else if (OffloadState->BufferLength != 0) {
+        if (Length > (uint32_t)State->BufferAllocLength) {
+            uint32_t NewBufferAllocLength = State->BufferAllocLength;
+            while (Length > NewBufferAllocLength) {
+                NewBufferAllocLength <<= 1;
+            }
+            if (NewBufferAllocLength > 0xF000) {
+                NewBufferAllocLength = 0xF000;
+            }
+
+            uint8_t* NewBuffer = CXPLAT_ALLOC_NONPAGED(NewBufferAllocLength, QUIC_POOL_TLS_BUFFER);
+            if (NewBuffer == NULL) {
+                QuicTraceEvent(
+                    AllocFailure,
+                    "Allocation of '%s' failed. (%llu bytes)",
+                    "New crypto buffer",
+                    NewBufferAllocLength);
+                TlsContext->ResultFlags |= CXPLAT_TLS_RESULT_ERROR;
+                goto Exit;
+            }
+
+            CxPlatCopyMemory(NewBuffer, State->Buffer, State->BufferLength);
+            CXPLAT_FREE(State->Buffer, QUIC_POOL_TLS_BUFFER);
+            State->Buffer = NewBuffer;
+            State->BufferAllocLength = (uint16_t)NewBufferAllocLength;
+        }
+
+        CxPlatCopyMemory(
+            State->Buffer + State->BufferLength,
+            OffloadState->Buffer,
+            OffloadState->BufferLength);
+        State->BufferLength += OffloadState->BufferLength;
+        State->BufferTotalLength += OffloadState->BufferLength;
+    }
+
+    if (State->BufferOffsetHandshake == 0) {
+        State->BufferOffsetHandshake = OffloadState->BufferOffsetHandshake;
+    }
+    if (State->BufferOffset1Rtt == 0) {
+        State->BufferOffset1Rtt = OffloadState->BufferOffset1Rtt;
+    }
+
+    State->HandshakeComplete = OffloadState->HandshakeComplete;
+    State->SessionResumed = OffloadState->SessionResumed;
+    State->EarlyDataState = OffloadState->EarlyDataState;
+    State->ReadKey = OffloadState->ReadKey;
+    State->WriteKey = OffloadState->WriteKey;
+    State->AlertCode = OffloadState->AlertCode;
+
+Exit:
+
+    //
+    // Any new keys are moved over even on failure, so they are cleaned up
+    // with the rest of the connection's keys.
+    //
+    for (uint32_t i = 0; i < QUIC_PACKET_KEY_COUNT; ++i) {
+        if (OffloadState->ReadKeys[i] != NULL) {
+            CXPLAT_DBG_ASSERT(State->ReadKeys[i] == NULL);
+            State->ReadKeys[i] = OffloadState->ReadKeys[i];
+            OffloadState->ReadKeys[i] = NULL;
+        }
+        if (OffloadState->WriteKeys[i] != NULL) {
+            CXPLAT_DBG_ASSERT(State->WriteKeys[i] == NULL);
+            State->WriteKeys[i] = OffloadState->WriteKeys[i];
+            OffloadState->WriteKeys[i] = NULL;
+        }
+    }
+
+    *ConsumedBuffer = TlsContext->OffloadBufferLength;
+    CxPlatTlsOffloadCleanup(TlsContext);
+
+    return TlsContext->ResultFlags;
 }
 
 _IRQL_requires_max_(PASSIVE_LEVEL)
@@ -1391,6 +2409,13 @@ CxPlatTlsParamGet(
 {
     QUIC_STATUS Status;
 
+    if (TlsContext->OffloadPending) {
+        //
+        // The SSL object is in use by the crypto thread pool.
+        //
+        return QUIC_STATUS_INVALID_STATE;
+    }
+
     switch (Param) {
 
         case QUIC_PARAM_TLS_HANDSHAKE_INFO: {
@@ -2603,6 +2603,7 @@ CxPlatTlsProcessData(
         (void)TlsContext->SecConfig->Callbacks.ReceiveTicket(
             TlsContext->Connection,
             0,
+            NULL,
             NULL);
     }
 
@@ -2644,11 +2645,13 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 CXPLAT_TLS_RESULT_FLAGS
 CxPlatTlsProcessDataComplete(
     _In_ CXPLAT_TLS* TlsContext,
-    _Out_ uint32_t * BufferConsumed
+    _Out_ uint32_t * BufferConsumed,
+    _Out_ uint32_t * ProcessTimeUs
     )
 {
     UNREFERENCED_PARAMETER(TlsContext);
     *BufferConsumed = 0;
+    *ProcessTimeUs = 0;
     return CXPLAT_TLS_RESULT_ERROR;
 }
 
@@ -164,6 +164,7 @@ typedef struct QUIC_FAKE_TLS_MESSAGE {
         struct {
             uint8_t Success : 1;
             uint8_t EarlyDataAccepted : 1;
+            uint8_t SessionResumed : 1;
             uint8_t HandshakeSecret[32];
         } SERVER_INITIAL;
         struct {
@@ -555,12 +556,17 @@ CxPlatTlsServerProcess(
             }
             case TlsExt_SessionTicket: {
                 TlsContext->EarlyDataAttempted = TRUE;
+                BOOLEAN EarlyDataAccepted = TRUE;
                 if (TlsContext->SecConfig->Callbacks.ReceiveTicket(
                         TlsContext->Connection,
                         ExtLength,
-                        ((CXPLAT_TLS_SESSION_TICKET_EXT*)ExtList)->Ticket)) {
+                        ((CXPLAT_TLS_SESSION_TICKET_EXT*)ExtList)->Ticket,
+                        &EarlyDataAccepted)) {
                     State->SessionResumed = TRUE;
-                    State->EarlyDataState = CXPLAT_TLS_EARLY_DATA_ACCEPTED;
+                    State->EarlyDataState =
+                        EarlyDataAccepted ?
+                            CXPLAT_TLS_EARLY_DATA_ACCEPTED :
+                            CXPLAT_TLS_EARLY_DATA_REJECTED;
                 } else {
                     State->SessionResumed = FALSE;
                     State->EarlyDataState = CXPLAT_TLS_EARLY_DATA_REJECTED;
@@ -608,6 +614,7 @@ CxPlatTlsServerProcess(
         ServerMessage->Type = CXPLAT_TLS_MESSAGE_SERVER_INITIAL;
         ServerMessage->SERVER_INITIAL.EarlyDataAccepted =
             State->EarlyDataState == CXPLAT_TLS_EARLY_DATA_ACCEPTED;
+        ServerMessage->SERVER_INITIAL.SessionResumed = State->SessionResumed;
         memcpy(ServerMessage->SERVER_INITIAL.HandshakeSecret, HandshakeSecret, CXPLAT_AEAD_AES_256_GCM_SIZE);
 
         State->BufferLength = MessageLength;
@@ -855,7 +862,7 @@ CxPlatTlsClientProcess(
         if (ServerMessage->Type == CXPLAT_TLS_MESSAGE_SERVER_INITIAL) {
 
             if (TlsContext->EarlyDataAttempted) {
-                State->SessionResumed = ServerMessage->SERVER_INITIAL.EarlyDataAccepted;
+                State->SessionResumed = ServerMessage->SERVER_INITIAL.SessionResumed;
                 State->EarlyDataState =
                     ServerMessage->SERVER_INITIAL.EarlyDataAccepted ?
                         CXPLAT_TLS_EARLY_DATA_ACCEPTED :
@@ -1045,7 +1052,8 @@ CxPlatTlsClientProcess(
         (void)TlsContext->SecConfig->Callbacks.ReceiveTicket(
             TlsContext->Connection,
             ServerMessageLength,
-            ServerMessage->TICKET.Ticket);
+            ServerMessage->TICKET.Ticket,
+            NULL);
 
         DrainLength = (uint16_t)ServerMessageLength + 4;
         break;
@@ -1192,11 +1200,13 @@ _IRQL_requires_max_(PASSIVE_LEVEL)
 CXPLAT_TLS_RESULT_FLAGS
 CxPlatTlsProcessDataComplete(
     _In_ CXPLAT_TLS* TlsContext,
-    _Out_ uint32_t * BufferConsumed
+    _Out_ uint32_t * BufferConsumed,
+    _Out_ uint32_t * ProcessTimeUs
     )
 {
     UNREFERENCED_PARAMETER(TlsContext);
     UNREFERENCED_PARAMETER(BufferConsumed);
+    *ProcessTimeUs = 0;
     return CXPLAT_TLS_RESULT_ERROR;
 }
 
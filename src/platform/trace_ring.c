@@ -0,0 +1,426 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Event ring tracing backend (QUIC_EVENTS_RING). Events are appended, as
+    compact binary records, to a ring buffer owned by the calling thread, so
+    recording an event takes no locks and makes no system calls. The rings
+    always hold the most recent events (flight recorder) and are written to a
+    file on demand (QUIC_PARAM_GLOBAL_TRACE_RING_DUMP) or on assert. See
+    quic_trace_ring.h for the format and src/tools/ring for the decoder.
+
+    Unlike the rest of the platform layer, this file is only built into
+    libmsquic, which exports QuicTraceRingWrite and QuicTraceRingDump. Apps
+    and tests that also link the platform (and core) libraries statically
+    resolve them from libmsquic, so a process only ever has one set of rings
+    and an assert in either copy dumps all of them.
+
+    Environment variables:
+
+    QUIC_TRACE_RING_KB      Size of each thread's ring (default 1024). Zero
+                            disables recording.
+    QUIC_TRACE_RING_FILE    File written on assert (default
+                            msquic.<pid>.ring in the working directory).
+
+Environment:
+
+    Linux
+
+--*/
+
+#include "platform_internal.h"
+#include "quic_trace_ring.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define QUIC_TRACE_RING_DEFAULT_KB      1024
+#define QUIC_TRACE_RING_MIN_SIZE        (16 * 1024)
+#define QUIC_TRACE_RING_EVENT_TABLE     4096 // Power of 2, must fit a uint16_t EventId.
+
+typedef struct QUIC_TRACE_RING {
+
+    //
+    // Link in the global list of rings. Rings are never freed, so a dump
+    // includes threads that have already exited.
+    //
+    struct QUIC_TRACE_RING* Next;
+
+    //
+    // Logical offset of the next record. Only written by the owning thread,
+    // and published after the record is written.
+    //
+    uint64_t Head;
+
+    CXPLAT_THREAD_ID ThreadId;
+
+    //
+    // Cleared when the owning thread exits, so the ring can be given to a new
+    // thread instead of allocating another one.
+    //
+    uint32_t InUse;
+
+    uint32_t Size;
+
+    uint64_t Buffer[0];
+
+} QUIC_TRACE_RING;
+
+typedef struct QUIC_TRACE_RING_EVENT {
+
+    //
+    // The format and name strings are the key of the event table (identical
+    // formats may be pooled across events). The format is published last.
+    //
+    const char* Format;
+    const char* Name;
+    uint8_t ArgCount;
+    uint8_t ArgTypes[QUIC_TRACE_RING_MAX_ARGS];
+
+} QUIC_TRACE_RING_EVENT;
+
+static QUIC_TRACE_RING_EVENT QuicTraceRingEvents[QUIC_TRACE_RING_EVENT_TABLE];
+static pthread_mutex_t QuicTraceRingEventLock = PTHREAD_MUTEX_INITIALIZER;
+
+static QUIC_TRACE_RING* QuicTraceRings;
+static uint32_t QuicTraceRingSize;
+static pthread_once_t QuicTraceRingOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t QuicTraceRingKey;
+
+static __thread QUIC_TRACE_RING* QuicTraceRingCurrent;
+
+static
+void
+QuicTraceRingRelease(
+    _In_ void* Context
+    )
+{
+    QUIC_TRACE_RING* Ring = (QUIC_TRACE_RING*)Context;
+    QuicTraceRingCurrent = NULL;
+    __atomic_store_n(&Ring->InUse, 0, __ATOMIC_RELEASE);
+}
+
+static
+void
+QuicTraceRingInitialize(
+    void
+    )
+{
+    uint32_t SizeKb = QUIC_TRACE_RING_DEFAULT_KB;
+    const char* Value = getenv("QUIC_TRACE_RING_KB");
+    if (Value != NULL) {
+        SizeKb = (uint32_t)strtoul(Value, NULL, 10);
+    }
+    if (SizeKb == 0 || SizeKb > 1024 * 1024 ||
+        pthread_key_create(&QuicTraceRingKey, QuicTraceRingRelease) != 0) {
+        return;
+    }
+
+    uint32_t Size = QUIC_TRACE_RING_MIN_SIZE;
+    while (Size < SizeKb * 1024) {
+        Size <<= 1;
+    }
+    QuicTraceRingSize = Size;
+}
+
+//
+// Gives the calling thread a ring, reusing one from an exited thread if
+// possible.
+//
+static
+QUIC_TRACE_RING*
+QuicTraceRingAcquire(
+    void
+    )
+{
+    pthread_once(&QuicTraceRingOnce, QuicTraceRingInitialize);
+    if (QuicTraceRingSize == 0) {
+        return NULL;
+    }
+
+    QUIC_TRACE_RING* Ring = __atomic_load_n(&QuicTraceRings, __ATOMIC_ACQUIRE);
+    for (; Ring != NULL; Ring = Ring->Next) {
+        uint32_t InUse = 0;
+        if (__atomic_compare_exchange_n(
+                &Ring->InUse, &InUse, 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&Ring->Head, 0, __ATOMIC_RELEASE);
+            break;
+        }
+    }
+
+    if (Ring == NULL) {
+        //
+        // Not from the platform allocator; rings outlive the library.
+        //
+        Ring = malloc(sizeof(QUIC_TRACE_RING) + QuicTraceRingSize);
+        if (Ring == NULL) {
+            return NULL;
+        }
+        Ring->Head = 0;
+        Ring->InUse = 1;
+        Ring->Size = QuicTraceRingSize;
+        Ring->Next = __atomic_load_n(&QuicTraceRings, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(
+                &QuicTraceRings, &Ring->Next, Ring, FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        }
+    }
+
+    Ring->ThreadId = CxPlatCurThreadID();
+    pthread_setspecific(QuicTraceRingKey, Ring);
+    QuicTraceRingCurrent = Ring;
+    return Ring;
+}
+
+static
+const QUIC_TRACE_RING_EVENT*
+QuicTraceRingGetEvent(
+    _In_z_ const char* Name,
+    _In_z_ const char* Format
+    )
+{
+    uint32_t Index =
+        ((uint32_t)(((uintptr_t)Format ^ (uintptr_t)Name) >> 3) * 0x9E3779B1u) &
+        (QUIC_TRACE_RING_EVENT_TABLE - 1);
+
+    for (uint32_t i = 0; i < QUIC_TRACE_RING_EVENT_TABLE; ++i) {
+        QUIC_TRACE_RING_EVENT* Event = &QuicTraceRingEvents[Index];
+        const char* Key = __atomic_load_n(&Event->Format, __ATOMIC_ACQUIRE);
+        if (Key == Format && Event->Name == Name) {
+            return Event;
+        }
+
+        if (Key == NULL) {
+            //
+            // First time this event is raised. Inserts are serialized, so
+            // check again whether another thread took the slot meanwhile.
+            //
+            pthread_mutex_lock(&QuicTraceRingEventLock);
+            Key = Event->Format;
+            if (Key == NULL) {
+                Event->Name = Name;
+                Event->ArgCount = QuicTraceRingParseFormat(Format, Event->ArgTypes);
+                __atomic_store_n(&Event->Format, Format, __ATOMIC_RELEASE);
+                Key = Format;
+            }
+            pthread_mutex_unlock(&QuicTraceRingEventLock);
+            if (Key == Format && Event->Name == Name) {
+                return Event;
+            }
+        }
+
+        Index = (Index + 1) & (QUIC_TRACE_RING_EVENT_TABLE - 1);
+    }
+
+    return NULL;
+}
+
+void
+QuicTraceRingWrite(
+    _In_z_ const char* Name,
+    _In_z_ const char* Format,
+    ...
+    )
+{
+    QUIC_TRACE_RING* Ring = QuicTraceRingCurrent;
+    if (Ring == NULL && (Ring = QuicTraceRingAcquire()) == NULL) {
+        return;
+    }
+
+    const QUIC_TRACE_RING_EVENT* Event = QuicTraceRingGetEvent(Name, Format);
+    if (Event == NULL) {
+        return;
+    }
+
+    uint64_t RecordBuffer[QUIC_TRACE_RING_MAX_RECORD / sizeof(uint64_t)];
+    QUIC_TRACE_RING_RECORD* Record = (QUIC_TRACE_RING_RECORD*)RecordBuffer;
+    uint8_t* Payload = (uint8_t*)RecordBuffer;
+    uint32_t Length = sizeof(QUIC_TRACE_RING_RECORD);
+
+    va_list Args;
+    va_start(Args, Format);
+    for (uint8_t i = 0; i < Event->ArgCount; ++i) {
+        uint64_t Value = 0;
+        const void* Data = NULL;
+        uint32_t DataLength = 0;
+        uint32_t ValueLength = 0;
+
+        switch (Event->ArgTypes[i]) {
+        case QUIC_TRACE_RING_ARG_U8:
+            Value = (uint8_t)va_arg(Args, unsigned int);
+            ValueLength = sizeof(uint8_t);
+            break;
+        case QUIC_TRACE_RING_ARG_U16:
+            Value = (uint16_t)va_arg(Args, unsigned int);
+            ValueLength = sizeof(uint16_t);
+            break;
+        case QUIC_TRACE_RING_ARG_U32:
+            Value = va_arg(Args, unsigned int);
+            ValueLength = sizeof(uint32_t);
+            break;
+        case QUIC_TRACE_RING_ARG_U64:
+            Value = va_arg(Args, uint64_t);
+            ValueLength = sizeof(uint64_t);
+            break;
+        case QUIC_TRACE_RING_ARG_PTR:
+            Value = (uint64_t)(uintptr_t)va_arg(Args, const void*);
+            ValueLength = sizeof(uint64_t);
+            break;
+        case QUIC_TRACE_RING_ARG_STRING:
+            Data = va_arg(Args, const char*);
+            if (Data != NULL) {
+                DataLength = (uint32_t)strnlen((const char*)Data, QUIC_TRACE_RING_MAX_STRING);
+            }
+            break;
+        default: // QUIC_TRACE_RING_ARG_BYTES
+            DataLength = va_arg(Args, uint32_t);
+            Data = va_arg(Args, const void*);
+            if (DataLength > QUIC_TRACE_RING_MAX_BYTES) {
+                DataLength = QUIC_TRACE_RING_MAX_BYTES;
+            }
+            if (Data == NULL) {
+                DataLength = 0;
+            }
+            break;
+        }
+
+        if (ValueLength != 0) {
+            if (Length + ValueLength > QUIC_TRACE_RING_MAX_RECORD) {
+                break;
+            }
+            CxPlatCopyMemory(Payload + Length, &Value, ValueLength);
+            Length += ValueLength;
+        } else {
+            if (Length + 1 + DataLength > QUIC_TRACE_RING_MAX_RECORD) {
+                break;
+            }
+            Payload[Length++] = (uint8_t)DataLength;
+            if (DataLength != 0) {
+                CxPlatCopyMemory(Payload + Length, Data, DataLength);
+                Length += DataLength;
+            }
+        }
+    }
+    va_end(Args);
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    Record->TimeNs = (uint64_t)Now.tv_sec * 1000000000ull + (uint64_t)Now.tv_nsec;
+    Record->Length = (uint16_t)Length;
+    Record->EventId = (uint16_t)(Event - QuicTraceRingEvents + 1);
+
+    //
+    // Records never wrap around the end of the buffer; the rest of it is
+    // filled with a padding record instead.
+    //
+    uint8_t* Buffer = (uint8_t*)Ring->Buffer;
+    uint64_t Head = Ring->Head;
+    uint32_t Position = (uint32_t)(Head & (Ring->Size - 1));
+    if (Ring->Size - Position < QUIC_TRACE_RING_ALIGN(Length)) {
+        QUIC_TRACE_RING_RECORD* Padding = (QUIC_TRACE_RING_RECORD*)(Buffer + Position);
+        Padding->Offset = (uint32_t)Head;
+        Padding->Length = (uint16_t)(Ring->Size - Position);
+        Padding->EventId = 0;
+        Head += Ring->Size - Position;
+        Position = 0;
+    }
+
+    Record->Offset = (uint32_t)Head;
+    CxPlatCopyMemory(Buffer + Position, Record, Length);
+    __atomic_store_n(&Ring->Head, Head + QUIC_TRACE_RING_ALIGN(Length), __ATOMIC_RELEASE);
+}
+
+QUIC_STATUS
+QuicTraceRingDump(
+    _In_opt_z_ const char* Path
+    )
+{
+    char DefaultPath[64];
+    if (Path == NULL) {
+        Path = getenv("QUIC_TRACE_RING_FILE");
+    }
+    if (Path == NULL) {
+        snprintf(DefaultPath, sizeof(DefaultPath), "msquic.%d.ring", (int)getpid());
+        Path = DefaultPath;
+    }
+
+    QUIC_TRACE_RING_FILE_HEADER Header;
+    CxPlatZeroMemory(&Header, sizeof(Header));
+    CxPlatCopyMemory(Header.Signature, QUIC_TRACE_RING_FILE_SIGNATURE, sizeof(Header.Signature));
+    Header.Version = QUIC_TRACE_RING_FILE_VERSION;
+    Header.ProcessId = (uint32_t)getpid();
+
+    for (uint32_t i = 0; i < QUIC_TRACE_RING_EVENT_TABLE; ++i) {
+        if (__atomic_load_n(&QuicTraceRingEvents[i].Format, __ATOMIC_ACQUIRE) != NULL) {
+            Header.EventCount++;
+        }
+    }
+    QUIC_TRACE_RING* Rings = __atomic_load_n(&QuicTraceRings, __ATOMIC_ACQUIRE);
+    for (QUIC_TRACE_RING* Ring = Rings; Ring != NULL; Ring = Ring->Next) {
+        Header.RingCount++;
+    }
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    Header.DumpTimeNs = (uint64_t)Now.tv_sec * 1000000000ull + (uint64_t)Now.tv_nsec;
+
+    uint8_t* Copy = NULL;
+    if (Rings != NULL) {
+        Copy = malloc(QuicTraceRingSize);
+        if (Copy == NULL) {
+            return QUIC_STATUS_OUT_OF_MEMORY;
+        }
+    }
+
+    FILE* File = fopen(Path, "wb");
+    if (File == NULL) {
+        QUIC_STATUS Status = (QUIC_STATUS)errno;
+        free(Copy);
+        return Status;
+    }
+
+    BOOLEAN Success = fwrite(&Header, sizeof(Header), 1, File) == 1;
+
+    uint32_t EventCount = 0;
+    for (uint32_t i = 0; Success && i < QUIC_TRACE_RING_EVENT_TABLE; ++i) {
+        const QUIC_TRACE_RING_EVENT* Event = &QuicTraceRingEvents[i];
+        const char* Format = __atomic_load_n(&Event->Format, __ATOMIC_ACQUIRE);
+        if (Format == NULL || EventCount == Header.EventCount) {
+            continue; // Not counted in the header.
+        }
+        QUIC_TRACE_RING_FILE_EVENT FileEvent;
+        FileEvent.EventId = (uint16_t)(i + 1);
+        FileEvent.NameLength = (uint16_t)strnlen(Event->Name, UINT16_MAX);
+        FileEvent.FormatLength = (uint16_t)strnlen(Format, UINT16_MAX);
+        FileEvent.Reserved = 0;
+        Success =
+            fwrite(&FileEvent, sizeof(FileEvent), 1, File) == 1 &&
+            fwrite(Event->Name, FileEvent.NameLength, 1, File) <= 1 &&
+            fwrite(Format, FileEvent.FormatLength, 1, File) <= 1;
+        EventCount++;
+    }
+
+    for (QUIC_TRACE_RING* Ring = Rings; Success && Ring != NULL; Ring = Ring->Next) {
+        QUIC_TRACE_RING_FILE_RING FileRing;
+        FileRing.ThreadId = (uint32_t)Ring->ThreadId;
+        FileRing.Size = Ring->Size;
+        FileRing.Head = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+        CxPlatCopyMemory(Copy, Ring->Buffer, Ring->Size);
+        FileRing.HeadAfterCopy = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE);
+        if (FileRing.HeadAfterCopy < FileRing.Head) {
+            FileRing.Head = 0; // Reassigned to a new thread; drop it.
+        }
+        Success =
+            fwrite(&FileRing, sizeof(FileRing), 1, File) == 1 &&
+            fwrite(Copy, Ring->Size, 1, File) == 1;
+    }
+
+    if (fclose(File) != 0) {
+        Success = FALSE;
+    }
+    free(Copy);
+
+    return Success ? QUIC_STATUS_SUCCESS : QUIC_STATUS_INTERNAL_ERROR;
+}
@@ -13,6 +13,7 @@ Abstract:
 #include "quic_datapath.h"
 
 #include "msquic.h"
+#include "msquicp.h"
 #ifdef QUIC_CLOG
 #include "DataPathTest.cpp.clog.h"
 #endif
@@ -1191,3 +1192,151 @@ TEST_P(DataPathTest, TcpDataServer)
 }
 
 INSTANTIATE_TEST_SUITE_P(DataPathTest, DataPathTest, ::testing::Values(4, 6), testing::PrintToStringParamName());
+
+#ifdef QUIC_LOOPBACK_DATAPATH
+
+//
+// Datagram length that takes 1000 bytes on the wire (with IPv4 and UDP headers).
+//
+#define EMULATED_DATAGRAM_LENGTH \
+    (1000 - CXPLAT_MIN_IPV4_HEADER_SIZE - CXPLAT_UDP_HEADER_SIZE)
+
+struct EmulatedLink : public CXPLAT_EMULATED_LINK {
+    CXPLAT_DATAPATH_EMULATION Emulation;
+    EmulatedLink() {
+        CxPlatEmulatedLinkInitialize(this);
+        RandomState = 0x0123456789ABCDEFull; // Fixed seed for repeatable runs.
+        CxPlatZeroMemory(&Emulation, sizeof(Emulation));
+    }
+    //
+    // Returns the delivery time, or UINT64_MAX if the datagram was lost.
+    //
+    uint64_t Send(uint64_t TimeNowUs) {
+        uint64_t DeliveryTimeUs;
+        if (!CxPlatEmulatedLinkSend(
+                this, &Emulation, TimeNowUs, EMULATED_DATAGRAM_LENGTH, &DeliveryTimeUs)) {
+            return UINT64_MAX;
+        }
+        return DeliveryTimeUs;
+    }
+};
+
+TEST(EmulatedLinkTest, BurstLoss)
+{
+    EmulatedLink Link;
+    Link.Emulation.BurstLossDenominator = 10;
+    Link.Emulation.BurstLossLength = 4;
+
+    //
+    // Bursts start on 1 in 10 good datagrams and end with a probability of
+    // 1/4 per datagram, so they are 4 datagrams long on average and the long
+    // run loss rate is (1/10) / (1/10 + 1/4) = 2/7.
+    //
+    const uint32_t Count = 100000;
+    uint32_t Lost = 0, Bursts = 0, RunLength = 0;
+    for (uint32_t i = 0; i < Count; ++i) {
+        if (Link.Send(1000) == UINT64_MAX) {
+            ++Lost;
+            if (RunLength++ == 0) {
+                ++Bursts;
+            }
+        } else {
+            RunLength = 0;
+        }
+    }
+    ASSERT_NE(0u, Bursts);
+    const double MeanBurst = (double)Lost / Bursts;
+    const double LossRate = (double)Lost / Count;
+    ASSERT_GT(MeanBurst, 3.5);
+    ASSERT_LT(MeanBurst, 4.5);
+    ASSERT_GT(LossRate, 0.25);
+    ASSERT_LT(LossRate, 0.32);
+}
+
+TEST(EmulatedLinkTest, BurstLossSingleDatagram)
+{
+    EmulatedLink Link;
+    Link.Emulation.BurstLossDenominator = 3;
+    Link.Emulation.BurstLossLength = 1;
+
+    //
+    // Bursts of length 1 always end on the next datagram, so no two datagrams
+    // in a row are lost.
+    //
+    bool PrevLost = false;
+    uint32_t Lost = 0;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        const bool IsLost = Link.Send(1000) == UINT64_MAX;
+        ASSERT_FALSE(IsLost && PrevLost);
+        Lost += IsLost ? 1 : 0;
+        PrevLost = IsLost;
+    }
+    ASSERT_NE(0u, Lost);
+
+    //
+    // Without the denominator, nothing is lost.
+    //
+    Link.Emulation.BurstLossDenominator = 0;
+    Link.InLossBurst = TRUE;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_NE(UINT64_MAX, Link.Send(1000));
+    }
+}
+
+TEST(EmulatedLinkTest, TokenBucket)
+{
+    //
+    // At 8 Mbps, a 1000 byte (wire) datagram takes 1 ms to serialize, and a
+    // 10000 byte bucket holds 10 datagrams worth of credit.
+    //
+    const uint64_t Start = 1000000;
+    EmulatedLink Link;
+    Link.Emulation.RateLimitMbps = 8;
+    Link.Emulation.RateBucketBytes = 10000;
+
+    //
+    // After being idle, the bucket is full: the first 10 datagrams leave at
+    // line rate, after which the link serializes them again.
+    //
+    for (uint32_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(Start, Link.Send(Start));
+    }
+    ASSERT_EQ(Start + 1000, Link.Send(Start));
+    ASSERT_EQ(Start + 2000, Link.Send(Start));
+
+    //
+    // The link is busy until Start + 2 ms. Five ms later it has only earned
+    // five datagrams of credit back.
+    //
+    const uint64_t Later = Start + 7000;
+    for (uint32_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(Later, Link.Send(Later));
+    }
+    ASSERT_EQ(Later + 1000, Link.Send(Later));
+
+    //
+    // The credit never exceeds the bucket, however long the link is idle.
+    //
+    const uint64_t Idle = Later + 60 * 1000000ull;
+    for (uint32_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(Idle, Link.Send(Idle));
+    }
+    ASSERT_EQ(Idle + 1000, Link.Send(Idle));
+}
+
+TEST(EmulatedLinkTest, NoTokenBucket)
+{
+    const uint64_t Start = 1000000;
+    EmulatedLink Link;
+    Link.Emulation.RateLimitMbps = 8;
+    Link.Emulation.DelayMs = 5;
+
+    //
+    // Without a bucket, every datagram waits for its own serialization.
+    //
+    for (uint32_t i = 1; i <= 3; ++i) {
+        ASSERT_EQ(Start + i * 1000 + 5000, Link.Send(Start));
+    }
+}
+
+#endif // QUIC_LOOPBACK_DATAPATH
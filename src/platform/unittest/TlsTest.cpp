@@ -11,6 +11,11 @@
 #ifdef _WIN32
 #include <wincrypt.h>
 #endif
+#ifdef QUIC_TLS_OPENSSL
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#endif
 #ifdef QUIC_CLOG
 #include "TlsTest.cpp.clog.h"
 #endif
@@ -362,7 +367,8 @@ protected:
                     &State);
             if (Result & CXPLAT_TLS_RESULT_PENDING) {
                 CxPlatEventWaitForever(ProcessCompleteEvent);
-                Result = CxPlatTlsProcessDataComplete(Ptr, BufferLength);
+                uint32_t ProcessTimeUs;
+                Result = CxPlatTlsProcessDataComplete(Ptr, BufferLength, &ProcessTimeUs);
             }
 
             if (!ExpectError) {
@@ -509,9 +515,11 @@ protected:
         OnRecvTicketServer(
             _In_ QUIC_CONNECTION* Connection,
             _In_ uint32_t TicketLength,
-            _In_reads_(TicketLength) const uint8_t* Ticket
+            _In_reads_(TicketLength) const uint8_t* Ticket,
+            _Inout_opt_ BOOLEAN* EarlyDataAccepted
             )
         {
+            UNREFERENCED_PARAMETER(EarlyDataAccepted);
             UNREFERENCED_PARAMETER(Connection);
             UNREFERENCED_PARAMETER(TicketLength);
             UNREFERENCED_PARAMETER(Ticket);
@@ -522,9 +530,11 @@ protected:
         OnRecvTicketClient(
             _In_ QUIC_CONNECTION* Connection,
             _In_ uint32_t TicketLength,
-            _In_reads_(TicketLength) const uint8_t* Ticket
+            _In_reads_(TicketLength) const uint8_t* Ticket,
+            _Inout_opt_ BOOLEAN* EarlyDataAccepted
             )
         {
+            UNREFERENCED_PARAMETER(EarlyDataAccepted);
             auto Context = (TlsContext*)Connection;
             if (Context->ResumptionTicket.Buffer == nullptr) {
                 Context->ResumptionTicket.Buffer =
@@ -942,6 +952,239 @@ TEST_F(TlsTest, HandshakeResumption)
 }
 #endif
 
+#ifdef QUIC_TLS_OPENSSL
+//
+// The OpenSSL provider's session ticket key callback. The server seals a
+// ticket with it on every handshake, but the provider doesn't resume sessions
+// on the client side, so the open path is only reachable by driving it
+// directly.
+//
+extern "C"
+int
+CxPlatTlsTicketKeyCallback(
+    _In_ SSL *Ssl,
+    _Inout_updates_bytes_(16) uint8_t* KeyName,
+    _Inout_ uint8_t* Iv,
+    _Inout_ EVP_CIPHER_CTX* CipherCtx,
+    _Inout_ EVP_MAC_CTX* MacCtx,
+    _In_ int Enc
+    );
+
+//
+// Seals and opens ticket bodies the way OpenSSL does, with the cipher and MAC
+// contexts the ticket key callback sets up for a server TLS context. Like
+// OpenSSL, it uses a new MAC context for every ticket.
+//
+struct TicketSealer {
+    SSL_CTX* SslCtx;
+    SSL* Ssl;
+    EVP_CIPHER_CTX* CipherCtx;
+    EVP_MAC* Hmac;
+    EVP_MAC_CTX* MacCtx {nullptr};
+
+    uint8_t KeyName[16];
+    uint8_t Iv[EVP_MAX_IV_LENGTH];
+    uint8_t Ciphertext[256];
+    int CiphertextLength {0};
+    uint8_t Mac[EVP_MAX_MD_SIZE];
+    size_t MacLength {0};
+
+    TicketSealer(CXPLAT_TLS* TlsContext) {
+        SslCtx = SSL_CTX_new(TLS_method());
+        Ssl = SSL_new(SslCtx);
+        SSL_set_app_data(Ssl, TlsContext); // All the callback uses.
+        CipherCtx = EVP_CIPHER_CTX_new();
+        Hmac = EVP_MAC_fetch(NULL, OSSL_MAC_NAME_HMAC, NULL);
+    }
+
+    ~TicketSealer() {
+        EVP_MAC_CTX_free(MacCtx);
+        EVP_MAC_free(Hmac);
+        EVP_CIPHER_CTX_free(CipherCtx);
+        SSL_free(Ssl);
+        SSL_CTX_free(SslCtx);
+    }
+
+    void
+    Reset() {
+        EVP_CIPHER_CTX_reset(CipherCtx);
+        EVP_MAC_CTX_free(MacCtx);
+        MacCtx = EVP_MAC_CTX_new(Hmac);
+    }
+
+    void
+    Authenticate(
+        _Out_writes_(EVP_MAX_MD_SIZE) uint8_t* Output,
+        _Out_ size_t* OutputLength
+        ) {
+        ASSERT_EQ(1, EVP_MAC_update(MacCtx, KeyName, sizeof(KeyName)));
+        ASSERT_EQ(1, EVP_MAC_update(MacCtx, Iv, EVP_CIPHER_CTX_iv_length(CipherCtx)));
+        ASSERT_EQ(1, EVP_MAC_update(MacCtx, Ciphertext, CiphertextLength));
+        ASSERT_EQ(1, EVP_MAC_final(MacCtx, Output, OutputLength, EVP_MAX_MD_SIZE));
+    }
+
+    //
+    // Encrypts a new ticket body with the current key.
+    //
+    void
+    Seal(
+        _In_reads_(Length) const uint8_t* Plaintext,
+        _In_ int Length
+        ) {
+        Reset();
+        ASSERT_EQ(1, CxPlatTlsTicketKeyCallback(Ssl, KeyName, Iv, CipherCtx, MacCtx, 1));
+        int Final = 0;
+        ASSERT_EQ(1, EVP_EncryptUpdate(CipherCtx, Ciphertext, &CiphertextLength, Plaintext, Length));
+        ASSERT_EQ(1, EVP_EncryptFinal_ex(CipherCtx, Ciphertext + CiphertextLength, &Final));
+        CiphertextLength += Final;
+        Authenticate(Mac, &MacLength);
+    }
+
+    //
+    // Decrypts the last sealed ticket body and checks it matches Plaintext.
+    // Returns the callback's result: 0 if the key is unknown, 1 if the ticket
+    // is from the current key and 2 if it should be renewed.
+    //
+    int
+    Open(
+        _In_reads_(Length) const uint8_t* Plaintext,
+        _In_ int Length
+        ) {
+        Reset();
+        int Result = CxPlatTlsTicketKeyCallback(Ssl, KeyName, Iv, CipherCtx, MacCtx, 0);
+        if (Result <= 0) {
+            return Result;
+        }
+
+        uint8_t ExpectedMac[EVP_MAX_MD_SIZE];
+        size_t ExpectedMacLength = 0;
+        Authenticate(ExpectedMac, &ExpectedMacLength);
+        EXPECT_EQ(MacLength, ExpectedMacLength);
+        EXPECT_EQ(0, memcmp(Mac, ExpectedMac, MacLength));
+
+        uint8_t Decrypted[sizeof(Ciphertext)];
+        int DecryptedLength = 0, Final = 0;
+        EXPECT_EQ(1, EVP_DecryptUpdate(CipherCtx, Decrypted, &DecryptedLength, Ciphertext, CiphertextLength));
+        EXPECT_EQ(1, EVP_DecryptFinal_ex(CipherCtx, Decrypted + DecryptedLength, &Final));
+        EXPECT_EQ(Length, DecryptedLength + Final);
+        EXPECT_EQ(0, memcmp(Plaintext, Decrypted, Length));
+        return Result;
+    }
+};
+
+static
+QUIC_TICKET_KEY_CONFIG
+TestTicketKey(
+    _In_ uint8_t Seed
+    )
+{
+    QUIC_TICKET_KEY_CONFIG Key;
+    for (uint8_t i = 0; i < sizeof(Key.Id); ++i) {
+        Key.Id[i] = Seed;
+    }
+    for (uint8_t i = 0; i < sizeof(Key.Material); ++i) {
+        Key.Material[i] = (uint8_t)(Seed + i);
+    }
+    Key.MaterialLength = sizeof(Key.Material);
+    return Key;
+}
+
+TEST_F(TlsTest, TicketKeyCache)
+{
+    const uint8_t Plaintext[] = "session ticket contents";
+    TlsContext ServerContext;
+    ServerContext.InitializeServer(ServerSecConfig);
+    TicketSealer Sealer(ServerContext.Ptr);
+
+    QUIC_TICKET_KEY_CONFIG Keys[2] = { TestTicketKey(1) };
+    VERIFY_QUIC_SUCCESS(CxPlatTlsSecConfigSetTicketKeys(ServerSecConfig, Keys, 1));
+
+    //
+    // Tickets are sealed with, and open with, the current key.
+    //
+    Sealer.Seal(Plaintext, sizeof(Plaintext));
+    ASSERT_EQ(0, memcmp(Sealer.KeyName, Keys[0].Id, sizeof(Sealer.KeyName)));
+    ASSERT_EQ(1, Sealer.Open(Plaintext, sizeof(Plaintext)));
+    ASSERT_EQ(1, Sealer.Open(Plaintext, sizeof(Plaintext))); // Cached contexts are reusable.
+
+    //
+    // After a rotation, tickets from the previous key still open, but must be
+    // renewed. New tickets use the new key.
+    //
+    Keys[1] = Keys[0];
+    Keys[0] = TestTicketKey(2);
+    VERIFY_QUIC_SUCCESS(CxPlatTlsSecConfigSetTicketKeys(ServerSecConfig, Keys, 2));
+    ASSERT_EQ(2, Sealer.Open(Plaintext, sizeof(Plaintext)));
+    Sealer.Seal(Plaintext, sizeof(Plaintext));
+    ASSERT_EQ(0, memcmp(Sealer.KeyName, Keys[0].Id, sizeof(Sealer.KeyName)));
+    ASSERT_EQ(1, Sealer.Open(Plaintext, sizeof(Plaintext)));
+
+    //
+    // Unknown key IDs are rejected, including ones that were rotated out.
+    //
+    Sealer.KeyName[0] ^= 0xFF;
+    ASSERT_EQ(0, Sealer.Open(Plaintext, sizeof(Plaintext)));
+    Sealer.KeyName[0] ^= 0xFF;
+
+    Keys[0] = TestTicketKey(3);
+    VERIFY_QUIC_SUCCESS(CxPlatTlsSecConfigSetTicketKeys(ServerSecConfig, Keys, 1));
+    ASSERT_EQ(0, Sealer.Open(Plaintext, sizeof(Plaintext)));
+}
+
+TEST_F(TlsTest, TicketKeyCacheThroughput)
+{
+    const uint32_t Iterations = 100000;
+    uint8_t Plaintext[128];
+    for (uint8_t i = 0; i < sizeof(Plaintext); ++i) {
+        Plaintext[i] = i;
+    }
+
+    TlsContext ServerContext;
+    ServerContext.InitializeServer(ServerSecConfig);
+    TicketSealer Sealer(ServerContext.Ptr);
+
+    QUIC_TICKET_KEY_CONFIG Key = TestTicketKey(1);
+    VERIFY_QUIC_SUCCESS(CxPlatTlsSecConfigSetTicketKeys(ServerSecConfig, &Key, 1));
+
+    uint64_t SealTimeUs = 0;
+    uint64_t OpenTimeUs = 0;
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        uint64_t Start = CxPlatTimeUs64();
+        Sealer.Seal(Plaintext, sizeof(Plaintext));
+        uint64_t End = CxPlatTimeUs64();
+        SealTimeUs += CxPlatTimeDiff64(Start, End);
+
+        Start = End;
+        ASSERT_EQ(1, Sealer.Open(Plaintext, sizeof(Plaintext)));
+        OpenTimeUs += CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+    }
+
+    //
+    // For comparison, the cost of setting up the AES and HMAC keys for every
+    // ticket, as happens without the cache.
+    //
+    uint8_t AesKey[32] = {0}, HmacKey[32] = {0};
+    OSSL_PARAM Params[2] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char*)"SHA256", 0),
+        OSSL_PARAM_construct_end()
+    };
+    uint64_t Start = CxPlatTimeUs64();
+    for (uint32_t i = 0; i < Iterations; ++i) {
+        Sealer.Reset();
+        ASSERT_EQ(1, EVP_EncryptInit_ex(Sealer.CipherCtx, EVP_aes_256_cbc(), NULL, AesKey, Sealer.Iv));
+        ASSERT_EQ(1, EVP_MAC_init(Sealer.MacCtx, HmacKey, sizeof(HmacKey), Params));
+    }
+    const uint64_t KeySetupTimeUs = CxPlatTimeDiff64(Start, CxPlatTimeUs64());
+
+    //
+    // Report the throughput (tickets per second) along with the results.
+    //
+    RecordProperty("SealsPerSecond", (int)((Iterations * 1000000ull) / (SealTimeUs + 1)));
+    RecordProperty("OpensPerSecond", (int)((Iterations * 1000000ull) / (OpenTimeUs + 1)));
+    RecordProperty("UncachedKeySetupsPerSecond", (int)((Iterations * 1000000ull) / (KeySetupTimeUs + 1)));
+}
+#endif // QUIC_TLS_OPENSSL
+
 TEST_F(TlsTest, HandshakeMultiAlpnServer)
 {
     TlsContext ServerContext, ClientContext;
@@ -0,0 +1,357 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Event ring tracing (QUIC_EVENTS_RING) writer and decoder tests.
+
+--*/
+
+#include "main.h"
+
+#ifdef QUIC_EVENTS_RING
+
+extern "C" {
+#include "quicring.h"
+}
+#include <unistd.h>
+#include <algorithm>
+
+//
+// Dumps the process's rings and loads the dump with the quicring decoder.
+//
+struct TraceRingDump {
+    char Path[64];
+    RING_TRACE* Trace;
+    TraceRingDump() : Trace(new RING_TRACE()) {
+        snprintf(Path, sizeof(Path), "msquicplatformtest.%d.ring", (int)getpid());
+    }
+    ~TraceRingDump() {
+        RingTraceClose(Trace);
+        delete Trace;
+        remove(Path);
+    }
+    bool Load() {
+        return
+            QUIC_SUCCEEDED(QuicTraceRingDump(Path)) &&
+            RingTraceOpen(Path, Trace);
+    }
+    //
+    // Returns the events of one type that the calling thread raised.
+    //
+    uint64_t GetEvents(const char* Name, const RING_EVENT** Events, uint64_t MaxCount) {
+        const uint32_t ThreadId = (uint32_t)CxPlatCurThreadID();
+        uint64_t Count = 0;
+        for (uint64_t i = 0; i < Trace->EventCount; ++i) {
+            const RING_EVENT* Event = &Trace->Events[i];
+            if (Event->ThreadId == ThreadId &&
+                Event->Type != nullptr &&
+                strcmp(Event->Type->Name, Name) == 0) {
+                if (Count < MaxCount) {
+                    Events[Count] = Event;
+                }
+                ++Count;
+            }
+        }
+        return Count;
+    }
+};
+
+TEST(TraceRingTest, ParseFormat)
+{
+    uint8_t ArgTypes[QUIC_TRACE_RING_MAX_ARGS];
+    const uint8_t Expected[] = {
+        QUIC_TRACE_RING_ARG_PTR,
+        QUIC_TRACE_RING_ARG_U8,
+        QUIC_TRACE_RING_ARG_U16,
+        QUIC_TRACE_RING_ARG_U32,
+        QUIC_TRACE_RING_ARG_U32,
+        QUIC_TRACE_RING_ARG_U64,
+        QUIC_TRACE_RING_ARG_U64,
+        QUIC_TRACE_RING_ARG_U64,
+        QUIC_TRACE_RING_ARG_STRING,
+        QUIC_TRACE_RING_ARG_BYTES,
+        QUIC_TRACE_RING_ARG_U8,
+    };
+    ASSERT_EQ(
+        sizeof(Expected),
+        QuicTraceRingParseFormat(
+            "[test][%p] %hhu %hu %u %-8x 100%% %llu %zu %I64u %s %!CID! %c",
+            ArgTypes));
+    for (uint8_t i = 0; i < sizeof(Expected); ++i) {
+        ASSERT_EQ(Expected[i], ArgTypes[i]);
+    }
+
+    //
+    // Arguments past the maximum are not recorded.
+    //
+    ASSERT_EQ(
+        QUIC_TRACE_RING_MAX_ARGS,
+        QuicTraceRingParseFormat(
+            "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u",
+            ArgTypes));
+}
+
+TEST(TraceRingTest, WriteAndDecode)
+{
+    char LongString[QUIC_TRACE_RING_MAX_STRING * 2];
+    CxPlatZeroMemory(LongString, sizeof(LongString));
+    memset(LongString, 'x', sizeof(LongString) - 1);
+    uint8_t Bytes[QUIC_TRACE_RING_MAX_BYTES + 45];
+    for (uint32_t i = 0; i < sizeof(Bytes); ++i) {
+        Bytes[i] = (uint8_t)i;
+    }
+
+    QuicTraceRingWrite(
+        "TraceRingTestArgs",
+        "[test][%p] %hhu %hu %u %d %llu %s %s %!BYTES! %c",
+        (void*)0x1234,
+        (uint8_t)7,
+        (uint16_t)0xBEEF,
+        0xDEADBEEFu,
+        -5,
+        0x123456789ABCull,
+        "short",
+        LongString,
+        CLOG_BYTEARRAY(sizeof(Bytes), Bytes),
+        'q');
+
+    TraceRingDump Dump;
+    ASSERT_TRUE(Dump.Load());
+    ASSERT_EQ((uint32_t)getpid(), Dump.Trace->Header.ProcessId);
+    ASSERT_NE(nullptr, RingTraceGetThread(Dump.Trace, (uint32_t)CxPlatCurThreadID()));
+
+    const RING_EVENT* Event = nullptr;
+    ASSERT_EQ(1ull, Dump.GetEvents("TraceRingTestArgs", &Event, 1));
+
+    RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+    ASSERT_EQ(10, RingEventGetArgs(Event, Args));
+    ASSERT_EQ(QUIC_TRACE_RING_ARG_PTR, Args[0].Type);
+    ASSERT_EQ(0x1234ull, Args[0].Value);
+    ASSERT_EQ(7ull, Args[1].Value);
+    ASSERT_EQ(0xBEEFull, Args[2].Value);
+    ASSERT_EQ(0xDEADBEEFull, Args[3].Value);
+    ASSERT_EQ((uint32_t)-5, Args[4].Value);
+    ASSERT_EQ(0x123456789ABCull, Args[5].Value);
+    ASSERT_EQ(5, Args[6].Length);
+    ASSERT_EQ(0, memcmp("short", Args[6].Data, 5));
+    ASSERT_EQ(QUIC_TRACE_RING_MAX_STRING, Args[7].Length);
+    ASSERT_EQ(0, memcmp(LongString, Args[7].Data, QUIC_TRACE_RING_MAX_STRING));
+    ASSERT_EQ(QUIC_TRACE_RING_MAX_BYTES, Args[8].Length);
+    ASSERT_EQ(0, memcmp(Bytes, Args[8].Data, QUIC_TRACE_RING_MAX_BYTES));
+    ASSERT_EQ((uint64_t)'q', Args[9].Value);
+
+    char Expected[2048];
+    int Offset =
+        snprintf(
+            Expected, sizeof(Expected),
+            "[test][0x1234] 7 48879 3735928559 -5 20015998343868 short %.*s ",
+            QUIC_TRACE_RING_MAX_STRING, LongString);
+    for (uint32_t i = 0; i < QUIC_TRACE_RING_MAX_BYTES; ++i) {
+        Offset += snprintf(Expected + Offset, sizeof(Expected) - Offset, "%02x", Bytes[i]);
+    }
+    snprintf(Expected + Offset, sizeof(Expected) - Offset, " q");
+
+    char Message[2048];
+    RingEventFormat(Event, Message, sizeof(Message));
+    ASSERT_STREQ(Expected, Message);
+}
+
+TEST(TraceRingTest, FullRecord)
+{
+    char LongString[QUIC_TRACE_RING_MAX_STRING + 1];
+    memset(LongString, 'y', sizeof(LongString) - 1);
+    LongString[QUIC_TRACE_RING_MAX_STRING] = '\0';
+
+    //
+    // Only the arguments that fit in QUIC_TRACE_RING_MAX_RECORD are recorded,
+    // and the rest are printed as missing.
+    //
+    QuicTraceRingWrite(
+        "TraceRingTestFull",
+        "%s %s %s %s %s %s %s %s %u",
+        LongString, LongString, LongString, LongString,
+        LongString, LongString, LongString, LongString, 1u);
+
+    TraceRingDump Dump;
+    ASSERT_TRUE(Dump.Load());
+
+    const RING_EVENT* Event = nullptr;
+    ASSERT_EQ(1ull, Dump.GetEvents("TraceRingTestFull", &Event, 1));
+    ASSERT_LE(Event->Record->Length, QUIC_TRACE_RING_MAX_RECORD);
+
+    const uint8_t Recorded =
+        (QUIC_TRACE_RING_MAX_RECORD - sizeof(QUIC_TRACE_RING_RECORD)) /
+        (QUIC_TRACE_RING_MAX_STRING + 1);
+    RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+    ASSERT_EQ(Recorded, RingEventGetArgs(Event, Args));
+
+    char Message[2048];
+    RingEventFormat(Event, Message, sizeof(Message));
+    ASSERT_NE(nullptr, strstr(Message, "<?> <?>"));
+}
+
+TEST(TraceRingTest, Wrap)
+{
+    //
+    // Write several times the ring's default size. The dump must hold an
+    // unbroken run of the most recent events.
+    //
+    const uint32_t WriteCount = 200000;
+    for (uint32_t i = 0; i < WriteCount; ++i) {
+        QuicTraceRingWrite("TraceRingTestWrap", "[test] %u", i);
+    }
+
+    TraceRingDump Dump;
+    ASSERT_TRUE(Dump.Load());
+
+    const uint64_t Count = Dump.GetEvents("TraceRingTestWrap", nullptr, 0);
+    ASSERT_NE(0ull, Count);
+    ASSERT_LE(Count, (uint64_t)WriteCount);
+    const RING_EVENT** Events = new const RING_EVENT*[Count];
+    Dump.GetEvents("TraceRingTestWrap", Events, Count);
+
+    uint32_t* Values = new uint32_t[Count];
+    for (uint64_t i = 0; i < Count; ++i) {
+        RING_ARG Arg;
+        ASSERT_EQ(1, RingEventGetArgs(Events[i], &Arg));
+        Values[i] = (uint32_t)Arg.Value;
+    }
+    std::sort(Values, Values + Count);
+    for (uint64_t i = 0; i < Count; ++i) {
+        ASSERT_EQ(WriteCount - Count + i, Values[i]);
+    }
+
+    const RING_THREAD* Thread =
+        RingTraceGetThread(Dump.Trace, (uint32_t)CxPlatCurThreadID());
+    ASSERT_NE(nullptr, Thread);
+    if ((uint64_t)WriteCount * QUIC_TRACE_RING_ALIGN(sizeof(QUIC_TRACE_RING_RECORD) + 4) >
+        Thread->RingSize) {
+        ASSERT_LT(Count, (uint64_t)WriteCount);
+    }
+
+    delete [] Values;
+    delete [] Events;
+}
+
+//
+// Builds a dumped ring the way the writer fills it, so the decoder can be
+// tested against overwritten and torn records.
+//
+struct TraceRingTestRing {
+    static const uint32_t Size = 16 * 1024;
+    QUIC_TRACE_RING_FILE_RING File;
+    alignas(8) uint8_t Buffer[Size];
+    uint64_t Head;
+    TraceRingTestRing() : Head(0) {
+        CxPlatZeroMemory(&File, sizeof(File));
+        CxPlatZeroMemory(Buffer, sizeof(Buffer));
+        File.Size = Size;
+    }
+    void Append(uint32_t Value) {
+        const uint16_t Length = sizeof(QUIC_TRACE_RING_RECORD) + sizeof(Value);
+        uint32_t Position = (uint32_t)(Head & (Size - 1));
+        if (Size - Position < QUIC_TRACE_RING_ALIGN(Length)) {
+            QUIC_TRACE_RING_RECORD* Padding = (QUIC_TRACE_RING_RECORD*)(Buffer + Position);
+            Padding->Offset = (uint32_t)Head;
+            Padding->Length = (uint16_t)(Size - Position);
+            Padding->EventId = 0;
+            Head += Size - Position;
+            Position = 0;
+        }
+        QUIC_TRACE_RING_RECORD* Record = (QUIC_TRACE_RING_RECORD*)(Buffer + Position);
+        Record->Offset = (uint32_t)Head;
+        Record->Length = Length;
+        Record->EventId = 1;
+        Record->TimeNs = Value;
+        CxPlatCopyMemory(Record + 1, &Value, sizeof(Value));
+        Head += QUIC_TRACE_RING_ALIGN(Length);
+    }
+    QUIC_TRACE_RING_RECORD* At(uint64_t Offset) {
+        return (QUIC_TRACE_RING_RECORD*)(Buffer + (Offset & (Size - 1)));
+    }
+    //
+    // Returns the values of the records the decoder finds.
+    //
+    uint32_t Read(uint32_t* Values, uint32_t MaxCount) {
+        uint64_t Offset = 0;
+        uint32_t Count = 0;
+        const QUIC_TRACE_RING_RECORD* Record;
+        while ((Record = QuicTraceRingNextRecord(&File, Buffer, &Offset)) != nullptr) {
+            if (Count < MaxCount) {
+                CxPlatCopyMemory(&Values[Count], Record + 1, sizeof(uint32_t));
+            }
+            ++Count;
+        }
+        return Count;
+    }
+};
+
+TEST(TraceRingTest, DecodeTornRecords)
+{
+    TraceRingTestRing Ring;
+    for (uint32_t i = 0; i < 10; ++i) {
+        Ring.Append(i);
+    }
+    Ring.File.Head = Ring.File.HeadAfterCopy = Ring.Head;
+
+    uint32_t Values[16];
+    ASSERT_EQ(10u, Ring.Read(Values, 16));
+    for (uint32_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(i, Values[i]);
+    }
+
+    //
+    // A record whose offset doesn't match its position (partially
+    // overwritten) is skipped, and decoding resumes on the next record.
+    //
+    const uint64_t RecordSize = QUIC_TRACE_RING_ALIGN(sizeof(QUIC_TRACE_RING_RECORD) + 4);
+    Ring.At(4 * RecordSize)->Offset ^= 0x100;
+    ASSERT_EQ(9u, Ring.Read(Values, 16));
+    ASSERT_EQ(3u, Values[3]);
+    ASSERT_EQ(5u, Values[4]);
+
+    //
+    // Neither is a record that would extend past the head.
+    //
+    Ring.At(4 * RecordSize)->Offset ^= 0x100;
+    Ring.File.Head -= RecordSize / 2;
+    ASSERT_EQ(9u, Ring.Read(Values, 16));
+    ASSERT_EQ(8u, Values[8]);
+}
+
+TEST(TraceRingTest, DecodeWrappedRing)
+{
+    TraceRingTestRing Ring;
+    const uint32_t WriteCount = 4000;
+    for (uint32_t i = 0; i < WriteCount; ++i) {
+        Ring.Append(i);
+    }
+    Ring.File.Head = Ring.Head;
+
+    //
+    // The thread kept writing while the buffer was copied, overwriting the
+    // oldest records of the copy. Only intact records after those must be
+    // returned, in order, up to the head read before the copy.
+    //
+    for (uint32_t i = 0; i < 5; ++i) {
+        Ring.Append(WriteCount + i);
+    }
+    Ring.File.HeadAfterCopy = Ring.Head;
+
+    const uint64_t RecordSize = QUIC_TRACE_RING_ALIGN(sizeof(QUIC_TRACE_RING_RECORD) + 4);
+    uint32_t Values[TraceRingTestRing::Size / 24];
+    const uint32_t Count = Ring.Read(Values, ARRAYSIZE(Values));
+    ASSERT_NE(0u, Count);
+    ASSERT_LE(Count, ARRAYSIZE(Values));
+    ASSERT_LT(
+        (uint64_t)Count * RecordSize,
+        TraceRingTestRing::Size - 2 * QUIC_TRACE_RING_MAX_RECORD);
+    for (uint32_t i = 0; i < Count; ++i) {
+        ASSERT_EQ(WriteCount - Count + i, Values[i]);
+    }
+}
+
+#endif // QUIC_EVENTS_RING
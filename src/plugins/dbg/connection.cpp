@@ -78,6 +78,21 @@ EXT_COMMAND(
         "\n");
 
     bool HasAtLeastOneStream = false;
+    for (UCHAR Type = 0; Type < 4; ++Type) {
+        auto TypeInfo = Conn.GetStreams().GetType(Type);
+        ULONG WindowSize = TypeInfo.WindowSize();
+        for (ULONG Slot = 0; !CheckControlC() && Slot < WindowSize; ++Slot) {
+            ULONG64 StreamAddr = TypeInfo.GetWindowStream(Slot);
+            if (StreamAddr != 0) {
+                Stream Strm(StreamAddr);
+                Dml("\t<link cmd=\"!quicstream 0x%I64X\">Stream %I64u</link>\n",
+                    Strm.Addr,
+                    Strm.ID());
+                HasAtLeastOneStream = true;
+            }
+        }
+    }
+
     ULONG64 HashPtr = Conn.GetStreams().GetStreamTable();
     if (HashPtr != 0) {
         HashTable Streams(HashPtr);
@@ -219,6 +234,30 @@ EXT_COMMAND(
         Dml("\n");
     }
 
+    Dml("\tBlocked Streams      ");
+
+    HasAtLeastOneStream = false;
+    auto BlockedStreams = Send.GetBlockedStreams();
+    while (!CheckControlC()) {
+        auto StreamSendLinkAddr = BlockedStreams.Next();
+        if (StreamSendLinkAddr == 0) {
+            break;
+        }
+
+        auto Strm = Stream::FromSendLink(StreamSendLinkAddr);
+        Dml("<link cmd=\"!quicstream 0x%I64X\">Stream %I64u</link>\n"
+            "\t                     ",
+            Strm.Addr,
+            Strm.ID());
+        HasAtLeastOneStream = true;
+    }
+
+    if (!HasAtLeastOneStream) {
+        Dml("NONE\n");
+    } else {
+        Dml("\n");
+    }
+
     Dml("\tOutstanding Packets  ");
 
     auto Loss = Conn.GetLossDetection();
@@ -59,6 +59,8 @@ typedef union QUIC_STREAM_FLAGS {
         BOOLEAN ReceiveDataPending      : 1;    // Data (or FIN) is queued and ready for delivery.
         BOOLEAN ReceiveCallPending      : 1;    // There is an uncompleted receive to the app.
         BOOLEAN SendDelayed             : 1;    // A delayed send is currently queued.
+        BOOLEAN SendFlowBlocked         : 1;    // Parked on the blocked list until the peer
+                                                // raises a stream flow control limit.
 
         BOOLEAN HandleSendShutdown      : 1;    // Send shutdown complete callback delivered.
         BOOLEAN HandleShutdown          : 1;    // Shutdown callback delivered.
@@ -737,6 +739,10 @@ struct Send : Struct {
     LinkedList GetSendStreams() {
         return LinkedList(AddrOf("SendStreams"));
     }
+
+    LinkedList GetBlockedStreams() {
+        return LinkedList(AddrOf("BlockedStreams"));
+    }
 };
 
 typedef enum QUIC_FRAME_TYPE {
@@ -960,6 +966,7 @@ typedef enum QUIC_API_TYPE {
     QUIC_API_TYPE_GET_PARAM,
 
     QUIC_API_TYPE_DATAGRAM_SEND,
+    QUIC_API_TYPE_STRM_SEND_BATCH,
 
 } QUIC_API_TYPE;
 
@@ -1001,6 +1008,8 @@ struct ApiCall : Struct {
             return "API_GET_PARAM";
         case QUIC_API_TYPE_DATAGRAM_SEND:
             return "API_TYPE_DATAGRAM_SEND";
+        case QUIC_API_TYPE_STRM_SEND_BATCH:
+            return "API_TYPE_STRM_SEND_BATCH";
         default:
             return "INVALID API";
         }
@@ -1082,10 +1091,36 @@ struct OperQueue : Struct {
     }
 };
 
+struct StreamTypeInfo : Struct {
+
+    StreamTypeInfo(ULONG64 Addr) : Struct("msquic!QUIC_STREAM_TYPE_INFO", Addr) { }
+
+    ULONG WindowSize() {
+        return ReadType<ULONG>("WindowSize");
+    }
+
+    //
+    // Returns the stream in the given window slot, or 0 if the slot is empty.
+    //
+    ULONG64 GetWindowStream(ULONG Slot) {
+        ULONG64 StreamAddr = 0;
+        ReadPointerAtAddr(
+            ReadPointer("Window") + Slot * g_ExtInstance.m_PtrSize,
+            &StreamAddr);
+        return StreamAddr;
+    }
+};
+
 struct StreamSet : Struct {
 
     StreamSet(ULONG64 Addr) : Struct("msquic!QUIC_STREAM_SET", Addr) { }
 
+    StreamTypeInfo GetType(UCHAR Type) {
+        ULONG64 ArrayAddr = AddrOf("Types");
+        ULONG TypeSize = GetTypeSize("msquic!QUIC_STREAM_TYPE_INFO");
+        return StreamTypeInfo(ArrayAddr + Type * TypeSize);
+    }
+
     ULONG64 GetStreamTable() {
         return ReadPointer("StreamTable");
     }
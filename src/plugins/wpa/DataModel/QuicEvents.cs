@@ -39,7 +39,8 @@ namespace MsQuicTracing.DataModel
         StreamSend,
         StreamReceiveComplete,
         StreamReceiveSetEnabled,
-        StreamDatagramSend
+        StreamDatagramSend,
+        StreamSendBatch
     }
 
     public enum QuicConnectionState
@@ -111,6 +112,7 @@ namespace MsQuicTracing.DataModel
         ApiSetParam,
         ApiGetParam,
         ApiDatagramSend,
+        ApiStreamSendBatch,
 
         TimerPacing,
         TimerAckDelay,
@@ -35,6 +35,7 @@ void QuicTestValidateListener();
 void QuicTestValidateConnection();
 void QuicTestValidateStream(bool Connect);
 void QuicTestGetPerfCounters();
+void QuicTestGetLatencyHistograms();
 void QuicTestDesiredVersionSettings();
 
 //
@@ -139,6 +140,21 @@ QuicTestConnectClientCertificate(
     _In_ bool UseClientCertificate
     );
 
+void
+QuicTestConnectTlsOffload(
+    _In_ int Family
+    );
+
+void
+QuicTestHandshakeTimingStatistics(
+    _In_ int Family
+    );
+
+void
+QuicTestWorkerAndBindingStatistics(
+    _In_ int Family
+    );
+
 void
 QuicTestValidAlpnLengths(
     void
@@ -312,6 +328,41 @@ QuicTestAckSendDelay(
     _In_ int Family
     );
 
+void
+QuicTestStreamSendNoBuffering(
+    _In_ int Family
+    );
+
+typedef enum QUIC_RECV_IN_PLACE_TYPE {
+    RecvInPlaceConsumeAll,
+    RecvInPlacePend,
+    RecvInPlaceConsumePartial,
+    RecvInPlaceCloseWhilePended
+} QUIC_RECV_IN_PLACE_TYPE;
+
+void
+QuicTestStreamRecvInPlace(
+    _In_ int Family,
+    _In_ QUIC_RECV_IN_PLACE_TYPE Type
+    );
+
+void
+QuicTestStreamPriorityScheduling(
+    _In_ int Family
+    );
+
+void
+QuicTestStreamRecvLargeIndication(
+    _In_ int Family
+    );
+
+#ifdef QUIC_QLOG_SUPPORT
+void
+QuicTestQlog(
+    _In_ int Family
+    );
+#endif
+
 //
 // QuicDrill tests
 //
@@ -728,4 +779,40 @@ typedef struct {
 #define IOCTL_QUIC_RUN_INVALID_ALPN_LENGTHS \
     QUIC_CTL_CODE(58, METHOD_BUFFERED, FILE_WRITE_DATA)
 
-#define QUIC_MAX_IOCTL_FUNC_CODE 58
+#define IOCTL_QUIC_RUN_STREAM_SEND_NO_BUFFERING \
+    QUIC_CTL_CODE(59, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+typedef struct {
+    int Family;
+    QUIC_RECV_IN_PLACE_TYPE Type;
+} QUIC_RUN_STREAM_RECV_IN_PLACE_PARAMS;
+
+#define IOCTL_QUIC_RUN_STREAM_RECV_IN_PLACE \
+    QUIC_CTL_CODE(60, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // QUIC_RUN_STREAM_RECV_IN_PLACE_PARAMS
+
+#define IOCTL_QUIC_RUN_CONNECT_TLS_OFFLOAD \
+    QUIC_CTL_CODE(61, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_HANDSHAKE_TIMING_STATISTICS \
+    QUIC_CTL_CODE(62, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_VALIDATE_GET_LATENCY_HISTOGRAMS \
+    QUIC_CTL_CODE(63, METHOD_BUFFERED, FILE_WRITE_DATA)
+
+#define IOCTL_QUIC_RUN_WORKER_AND_BINDING_STATISTICS \
+    QUIC_CTL_CODE(64, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_STREAM_PRIORITY_SCHEDULING \
+    QUIC_CTL_CODE(65, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define IOCTL_QUIC_RUN_STREAM_RECV_LARGE_INDICATION \
+    QUIC_CTL_CODE(66, METHOD_BUFFERED, FILE_WRITE_DATA)
+    // int - Family
+
+#define QUIC_MAX_IOCTL_FUNC_CODE 66
@@ -189,6 +189,15 @@ TEST(ParameterValidation, ValidateGetPerfCounters) {
     }
 }
 
+TEST(ParameterValidation, ValidateGetLatencyHistograms) {
+    TestLogger Logger("QuicTestGetLatencyHistograms");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_VALIDATE_GET_LATENCY_HISTOGRAMS));
+    } else {
+        QuicTestGetLatencyHistograms();
+    }
+}
+
 TEST(ParameterValidation, ValidateConfiguration) {
     TestLogger Logger("QuicTestValidateConfiguration");
     if (TestingKernelMode) {
@@ -567,6 +576,33 @@ TEST_P(WithHandshakeArgs6, ConnectClientCertificate) {
 }
 #endif
 
+TEST_P(WithFamilyArgs, ConnectTlsOffload) {
+    TestLoggerT<ParamType> Logger("QuicTestConnectTlsOffload", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_CONNECT_TLS_OFFLOAD, GetParam().Family));
+    } else {
+        QuicTestConnectTlsOffload(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, HandshakeTimingStatistics) {
+    TestLoggerT<ParamType> Logger("QuicTestHandshakeTimingStatistics", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_HANDSHAKE_TIMING_STATISTICS, GetParam().Family));
+    } else {
+        QuicTestHandshakeTimingStatistics(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, WorkerAndBindingStatistics) {
+    TestLoggerT<ParamType> Logger("QuicTestWorkerAndBindingStatistics", GetParam());
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_WORKER_AND_BINDING_STATISTICS, GetParam().Family));
+    } else {
+        QuicTestWorkerAndBindingStatistics(GetParam().Family);
+    }
+}
+
 #if QUIC_TEST_DATAPATH_HOOKS_ENABLED
 TEST_P(WithHandshakeArgs4, RandomLoss) {
     TestLoggerT<ParamType> Logger("QuicTestConnect-RandomLoss", GetParam());
@@ -996,6 +1032,56 @@ TEST_P(WithFamilyArgs, AckSendDelay) {
     }
 }
 
+TEST_P(WithFamilyArgs, StreamSendNoBuffering) {
+    TestLogger Logger("QuicTestStreamSendNoBuffering");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_SEND_NO_BUFFERING, GetParam().Family));
+    } else {
+        QuicTestStreamSendNoBuffering(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, StreamPriorityScheduling) {
+    TestLogger Logger("QuicTestStreamPriorityScheduling");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_PRIORITY_SCHEDULING, GetParam().Family));
+    } else {
+        QuicTestStreamPriorityScheduling(GetParam().Family);
+    }
+}
+
+TEST_P(WithFamilyArgs, StreamRecvLargeIndication) {
+    TestLogger Logger("QuicTestStreamRecvLargeIndication");
+    if (TestingKernelMode) {
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_RECV_LARGE_INDICATION, GetParam().Family));
+    } else {
+        QuicTestStreamRecvLargeIndication(GetParam().Family);
+    }
+}
+
+TEST_P(WithStreamRecvInPlaceArgs, StreamRecvInPlace) {
+    TestLoggerT<ParamType> Logger("QuicTestStreamRecvInPlace", GetParam());
+    if (TestingKernelMode) {
+        QUIC_RUN_STREAM_RECV_IN_PLACE_PARAMS Params = {
+            GetParam().Family,
+            GetParam().Type
+        };
+        ASSERT_TRUE(DriverClient.Run(IOCTL_QUIC_RUN_STREAM_RECV_IN_PLACE, Params));
+    } else {
+        QuicTestStreamRecvInPlace(GetParam().Family, GetParam().Type);
+    }
+}
+
+#if defined(QUIC_QLOG_SUPPORT) && QUIC_TEST_DATAPATH_HOOKS_ENABLED
+TEST_P(WithFamilyArgs, Qlog) {
+    TestLogger Logger("QuicTestQlog");
+    if (TestingKernelMode) {
+        GTEST_SKIP() << "qlog is only supported in user mode";
+    }
+    QuicTestQlog(GetParam().Family);
+}
+#endif
+
 TEST(Drill, VarIntEncoder) {
     TestLogger Logger("QuicDrillTestVarIntEncoder");
     if (TestingKernelMode) {
@@ -1160,6 +1246,11 @@ INSTANTIATE_TEST_SUITE_P(
     WithReceiveResumeNoDataArgs,
     testing::ValuesIn(ReceiveResumeNoDataArgs::Generate()));
 
+INSTANTIATE_TEST_SUITE_P(
+    Misc,
+    WithStreamRecvInPlaceArgs,
+    testing::ValuesIn(StreamRecvInPlaceArgs::Generate()));
+
 INSTANTIATE_TEST_SUITE_P(
     Misc,
     WithDatagramNegotiationArgs,
@@ -514,6 +514,29 @@ class WithReceiveResumeNoDataArgs : public testing::Test,
     public testing::WithParamInterface<ReceiveResumeNoDataArgs> {
 };
 
+struct StreamRecvInPlaceArgs {
+    int Family;
+    QUIC_RECV_IN_PLACE_TYPE Type;
+    static ::std::vector<StreamRecvInPlaceArgs> Generate() {
+        ::std::vector<StreamRecvInPlaceArgs> list;
+        for (int Family : { 4, 6 })
+        for (QUIC_RECV_IN_PLACE_TYPE Type : { RecvInPlaceConsumeAll, RecvInPlacePend, RecvInPlaceConsumePartial, RecvInPlaceCloseWhilePended })
+            list.push_back({ Family, Type });
+        return list;
+    }
+};
+
+std::ostream& operator << (std::ostream& o, const StreamRecvInPlaceArgs& args) {
+    static const char* TypeNames[] = { "ConsumeAll", "Pend", "ConsumePartial", "CloseWhilePended" };
+    return o <<
+        (args.Family == 4 ? "v4" : "v6") << "/" <<
+        TypeNames[args.Type];
+}
+
+class WithStreamRecvInPlaceArgs : public testing::Test,
+    public testing::WithParamInterface<StreamRecvInPlaceArgs> {
+};
+
 struct DatagramNegotiationArgs {
     int Family;
     bool DatagramReceiveEnabled;
@@ -427,7 +427,15 @@ size_t QUIC_IOCTL_BUFFER_SIZES[] =
     0,
     sizeof(QUIC_RUN_CONNECT_CLIENT_CERT),
     0,
-    0
+    0,
+    sizeof(INT32),
+    sizeof(QUIC_RUN_STREAM_RECV_IN_PLACE_PARAMS),
+    sizeof(INT32),
+    sizeof(INT32),
+    0,
+    sizeof(INT32),
+    sizeof(INT32),
+    sizeof(INT32)
 };
 
 CXPLAT_STATIC_ASSERT(
@@ -452,6 +460,7 @@ typedef union {
     QUIC_RUN_CUSTOM_CERT_VALIDATION CustomCertValidationParams;
     QUIC_RUN_VERSION_NEGOTIATION_EXT VersionNegotiationExtParams;
     QUIC_RUN_CONNECT_CLIENT_CERT ConnectClientCertParams;
+    QUIC_RUN_STREAM_RECV_IN_PLACE_PARAMS StreamRecvInPlaceParams;
 
 } QUIC_IOCTL_PARAMS;
 
@@ -921,6 +930,48 @@ QuicTestCtlEvtIoDeviceControl(
         QuicTestCtlRun(QuicTestInvalidAlpnLengths());
         break;
 
+    case IOCTL_QUIC_RUN_STREAM_SEND_NO_BUFFERING:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestStreamSendNoBuffering(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_RECV_IN_PLACE:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(
+            QuicTestStreamRecvInPlace(
+                Params->StreamRecvInPlaceParams.Family,
+                Params->StreamRecvInPlaceParams.Type));
+        break;
+
+    case IOCTL_QUIC_RUN_CONNECT_TLS_OFFLOAD:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestConnectTlsOffload(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_HANDSHAKE_TIMING_STATISTICS:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestHandshakeTimingStatistics(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_VALIDATE_GET_LATENCY_HISTOGRAMS:
+        QuicTestCtlRun(QuicTestGetLatencyHistograms());
+        break;
+
+    case IOCTL_QUIC_RUN_WORKER_AND_BINDING_STATISTICS:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestWorkerAndBindingStatistics(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_PRIORITY_SCHEDULING:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestStreamPriorityScheduling(Params->Family));
+        break;
+
+    case IOCTL_QUIC_RUN_STREAM_RECV_LARGE_INDICATION:
+        CXPLAT_FRE_ASSERT(Params != nullptr);
+        QuicTestCtlRun(QuicTestStreamRecvLargeIndication(Params->Family));
+        break;
+
     default:
         Status = STATUS_NOT_IMPLEMENTED;
         break;
@@ -1139,6 +1139,32 @@ ShutdownStreamCallback(
     return QUIC_STATUS_SUCCESS;
 }
 
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+ShutdownEventStreamCallback(
+    _In_ HQUIC /*Stream*/,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    switch (Event->Type) {
+
+    case QUIC_STREAM_EVENT_RECEIVE:
+        TEST_FAILURE("QUIC_STREAM_EVENT_RECEIVE should never be called!");
+        break;
+
+    case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+        CxPlatEventSet(*(CXPLAT_EVENT*)Context);
+        break;
+
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
 _Function_class_(QUIC_STREAM_CALLBACK)
 static
 QUIC_STATUS
@@ -1383,6 +1409,106 @@ void QuicTestValidateStream(bool Connect)
                         0));
             }
 
+            //
+            // Stream priority.
+            //
+            {
+                TestScopeLogger logScope("Stream priority");
+                StreamScope Stream;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_NONE,
+                        DummyStreamCallback,
+                        nullptr,
+                        &Stream.Handle));
+
+                uint16_t Priority = 0;
+                uint32_t BufferLength = sizeof(Priority);
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_PRIORITY,
+                        &BufferLength,
+                        &Priority));
+                TEST_EQUAL(0x7FFF, Priority);
+
+                uint32_t InvalidPriority = 0;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_PRIORITY,
+                        sizeof(InvalidPriority),
+                        &InvalidPriority));
+
+                Priority = 0xFFFF;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->SetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_PRIORITY,
+                        sizeof(Priority),
+                        &Priority));
+
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamStart(
+                        Stream.Handle,
+                        QUIC_STREAM_START_FLAG_NONE));
+
+                Priority = 0;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_PRIORITY,
+                        &BufferLength,
+                        &Priority));
+                TEST_EQUAL(0xFFFF, Priority);
+
+                uint8_t Weight = 0;
+                BufferLength = sizeof(Weight);
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_WEIGHT,
+                        &BufferLength,
+                        &Weight));
+                TEST_EQUAL(1, Weight);
+
+                Weight = 0;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->SetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_WEIGHT,
+                        sizeof(Weight),
+                        &Weight));
+
+                Weight = 3;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->SetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_WEIGHT,
+                        sizeof(Weight),
+                        &Weight));
+
+                Weight = 0;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->GetParam(
+                        Stream.Handle,
+                        QUIC_PARAM_LEVEL_STREAM,
+                        QUIC_PARAM_STREAM_WEIGHT,
+                        &BufferLength,
+                        &Weight));
+                TEST_EQUAL(3, Weight);
+            }
+
             //
             // Null buffer.
             //
@@ -1538,6 +1664,149 @@ void QuicTestValidateStream(bool Connect)
                         QUIC_TEST_NO_ERROR));
             }
 
+            //
+            // Batch send null or empty entries.
+            //
+            {
+                TestScopeLogger logScope("Batch send null or empty entries");
+                QUIC_STREAM_SEND_BATCH_ENTRY Entries[1] = {};
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(nullptr, 1));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(Entries, 0));
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(Entries, ARRAYSIZE(Entries)));
+                TEST_QUIC_STATUS(QUIC_STATUS_INVALID_PARAMETER, Entries[0].Status);
+            }
+
+            //
+            // Batch send across connections.
+            //
+            {
+                TestScopeLogger logScope("Batch send across connections");
+                TestConnection Client2(Registration);
+                TEST_TRUE(Client2.IsValid());
+                StreamScope Stream1, Stream2;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_NONE,
+                        DummyStreamCallback,
+                        nullptr,
+                        &Stream1.Handle));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client2.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_NONE,
+                        DummyStreamCallback,
+                        nullptr,
+                        &Stream2.Handle));
+
+                QUIC_STREAM_SEND_BATCH_ENTRY Entries[2] = {};
+                Entries[0].Stream = Stream1.Handle;
+                Entries[1].Stream = Stream2.Handle;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_PARAMETER,
+                    MsQuic->StreamSendBatch(Entries, ARRAYSIZE(Entries)));
+                TEST_QUIC_STATUS(QUIC_STATUS_INVALID_PARAMETER, Entries[0].Status);
+                TEST_QUIC_STATUS(QUIC_STATUS_INVALID_PARAMETER, Entries[1].Status);
+            }
+
+            //
+            // Batch send with start.
+            //
+            {
+                TestScopeLogger logScope("Batch send with start");
+                StreamScope Stream1, Stream2;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                        AllowSendCompleteStreamCallback,
+                        nullptr,
+                        &Stream1.Handle));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                        AllowSendCompleteStreamCallback,
+                        nullptr,
+                        &Stream2.Handle));
+
+                QUIC_STREAM_SEND_BATCH_ENTRY Entries[3] = {};
+                Entries[0].Stream = Stream1.Handle;
+                Entries[0].Buffers = Buffers;
+                Entries[0].BufferCount = ARRAYSIZE(Buffers);
+                Entries[0].Flags = QUIC_SEND_FLAG_START;
+                Entries[1].Stream = Stream2.Handle;
+                Entries[1].Buffers = Buffers;
+                Entries[1].BufferCount = ARRAYSIZE(Buffers);
+                Entries[1].Flags = QUIC_SEND_FLAG_START;
+                Entries[2].Stream = Stream1.Handle;
+                Entries[2].Buffers = Buffers;
+                Entries[2].BufferCount = ARRAYSIZE(Buffers);
+                Entries[2].Flags = QUIC_SEND_FLAG_FIN;
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_PENDING,
+                    MsQuic->StreamSendBatch(Entries, ARRAYSIZE(Entries)));
+                for (uint32_t i = 0; i < ARRAYSIZE(Entries); ++i) {
+                    TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[i].Status);
+                }
+            }
+
+            //
+            // Batch send with a shutdown stream.
+            //
+            {
+                TestScopeLogger logScope("Batch send with a shutdown stream");
+                EventScope Stream2ShutdownComplete;
+                StreamScope Stream1, Stream2;
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                        AllowSendCompleteStreamCallback,
+                        nullptr,
+                        &Stream1.Handle));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamOpen(
+                        Client.GetConnection(),
+                        QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                        ShutdownEventStreamCallback,
+                        &Stream2ShutdownComplete,
+                        &Stream2.Handle));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamStart(
+                        Stream1.Handle,
+                        QUIC_STREAM_START_FLAG_NONE));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamStart(
+                        Stream2.Handle,
+                        QUIC_STREAM_START_FLAG_NONE));
+                TEST_QUIC_SUCCEEDED(
+                    MsQuic->StreamShutdown(
+                        Stream2.Handle,
+                        QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
+                        QUIC_TEST_NO_ERROR));
+                TEST_TRUE(CxPlatEventWaitWithTimeout(Stream2ShutdownComplete, TestWaitTimeout));
+
+                QUIC_STREAM_SEND_BATCH_ENTRY Entries[2] = {};
+                Entries[0].Stream = Stream1.Handle;
+                Entries[0].Buffers = Buffers;
+                Entries[0].BufferCount = ARRAYSIZE(Buffers);
+                Entries[1].Stream = Stream2.Handle;
+                Entries[1].Buffers = Buffers;
+                Entries[1].BufferCount = ARRAYSIZE(Buffers);
+                TEST_QUIC_STATUS(
+                    QUIC_STATUS_INVALID_STATE,
+                    MsQuic->StreamSendBatch(Entries, ARRAYSIZE(Entries)));
+                TEST_QUIC_STATUS(QUIC_STATUS_PENDING, Entries[0].Status);
+                TEST_QUIC_STATUS(QUIC_STATUS_INVALID_STATE, Entries[1].Status);
+            }
+
             //
             // Shutdown null handle.
             //
@@ -1644,6 +1913,62 @@ QuicTestGetPerfCounters()
     TEST_EQUAL(BufferLength, (sizeof(uint64_t) * (QUIC_PERF_COUNTER_MAX - 4)));
 }
 
+void
+QuicTestGetLatencyHistograms()
+{
+    //
+    // Test getting the correct size.
+    //
+    uint32_t BufferLength = 0;
+    TEST_EQUAL(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS,
+            &BufferLength,
+            nullptr),
+        QUIC_STATUS_BUFFER_TOO_SMALL);
+
+    TEST_EQUAL(BufferLength, sizeof(QUIC_LATENCY_HISTOGRAM) * QUIC_LATENCY_HISTOGRAM_MAX);
+
+    //
+    // Test getting all the histograms, which must be self-consistent.
+    //
+    QUIC_LATENCY_HISTOGRAM Histograms[QUIC_LATENCY_HISTOGRAM_MAX];
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS,
+            &BufferLength,
+            Histograms));
+
+    for (uint32_t i = 0; i < QUIC_LATENCY_HISTOGRAM_MAX; ++i) {
+        uint64_t Count = 0;
+        for (uint32_t j = 0; j < QUIC_LATENCY_HISTOGRAM_BUCKET_COUNT; ++j) {
+            Count += Histograms[i].Buckets[j];
+        }
+        TEST_EQUAL(Count, Histograms[i].Count);
+        if (Count == 0) {
+            TEST_EQUAL(Histograms[i].Sum, 0);
+        }
+    }
+
+    //
+    // Test a smaller buffer will be rounded to the nearest histogram and filled.
+    //
+    BufferLength = (sizeof(QUIC_LATENCY_HISTOGRAM) * (QUIC_LATENCY_HISTOGRAM_MAX - 2)) + 1;
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_LATENCY_HISTOGRAMS,
+            &BufferLength,
+            Histograms));
+
+    TEST_EQUAL(BufferLength, (sizeof(QUIC_LATENCY_HISTOGRAM) * (QUIC_LATENCY_HISTOGRAM_MAX - 2)));
+}
+
 void
 QuicTestDesiredVersionSettings()
 {
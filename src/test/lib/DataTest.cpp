@@ -2163,3 +2163,1603 @@ QuicTestAckSendDelay(
         TEST_EQUAL(TestContext.AckCountStop - TestContext.AckCountStart, 1);
     }
 }
+
+struct SendNoBufferingTestContext {
+    SendNoBufferingTestContext(_In_ HQUIC ServerConfiguration) :
+        ServerConfiguration(ServerConfiguration)
+    { }
+    HQUIC ServerConfiguration;
+    EventScope ClientConnectedEvent;
+    EventScope ServerStreamEvent;
+    EventScope PeerSendShutdownEvent;
+    EventScope SendCompleteEvent;
+    ConnectionScope ServerConnection;
+    StreamScope ServerStream;
+    int64_t ServerReceivedLength {0};
+    int64_t ReceivedAtFirstComplete {-1};
+    uint32_t SendCompleteCount {0};
+    bool OutOfOrder {false};
+    bool Canceled {false};
+};
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicSendNoBufferingServerStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    SendNoBufferingTestContext* TestContext = (SendNoBufferingTestContext*)Context;
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_RECEIVE:
+        InterlockedExchangeAdd64(
+            &TestContext->ServerReceivedLength,
+            (int64_t)Event->RECEIVE.TotalBufferLength);
+        break;
+    case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
+        CxPlatEventSet(TestContext->PeerSendShutdownEvent.Handle);
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicSendNoBufferingClientStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    SendNoBufferingTestContext* TestContext = (SendNoBufferingTestContext*)Context;
+    if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE) {
+        //
+        // The client send context is the index of the send on the stream.
+        //
+        if ((uintptr_t)Event->SEND_COMPLETE.ClientContext != TestContext->SendCompleteCount) {
+            TestContext->OutOfOrder = true;
+        }
+        if (Event->SEND_COMPLETE.Canceled) {
+            TestContext->Canceled = true;
+        }
+        if (TestContext->SendCompleteCount++ == 0) {
+            TestContext->ReceivedAtFirstComplete =
+                InterlockedExchangeAdd64(&TestContext->ServerReceivedLength, 0);
+        } else {
+            CxPlatEventSet(TestContext->SendCompleteEvent.Handle);
+        }
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_CONNECTION_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicSendNoBufferingConnectionHandler(
+    _In_ HQUIC QuicConnection,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    )
+{
+    SendNoBufferingTestContext* TestContext = (SendNoBufferingTestContext*)Context;
+    if (QuicConnection != TestContext->ServerConnection.Handle &&
+        Event->Type == QUIC_CONNECTION_EVENT_CONNECTED) {
+        CxPlatEventSet(TestContext->ClientConnectedEvent.Handle);
+    } else if (QuicConnection == TestContext->ServerConnection.Handle &&
+        Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        MsQuic->SetCallbackHandler(
+            Event->PEER_STREAM_STARTED.Stream,
+            (void*)QuicSendNoBufferingServerStreamHandler,
+            Context);
+        TestContext->ServerStream.Handle = Event->PEER_STREAM_STARTED.Stream;
+        CxPlatEventSet(TestContext->ServerStreamEvent.Handle);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_LISTENER_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicSendNoBufferingListenerHandler(
+    _In_ HQUIC /* QuicListener */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_LISTENER_EVENT* Event
+    )
+{
+    SendNoBufferingTestContext* TestContext = (SendNoBufferingTestContext*)Context;
+    switch (Event->Type) {
+        case QUIC_LISTENER_EVENT_NEW_CONNECTION:
+            TestContext->ServerConnection.Handle = Event->NEW_CONNECTION.Connection;
+            MsQuic->SetCallbackHandler(TestContext->ServerConnection.Handle, (void*) QuicSendNoBufferingConnectionHandler, Context);
+            return MsQuic->ConnectionSetConfiguration(Event->NEW_CONNECTION.Connection, TestContext->ServerConfiguration);
+        default:
+            TEST_FAILURE(
+                "Invalid listener event! Context: 0x%p, Event: %d",
+                Context,
+                Event->Type);
+            return QUIC_STATUS_INVALID_STATE;
+    }
+}
+
+void
+QuicTestStreamSendNoBuffering(
+    _In_ int Family
+    )
+{
+    const uint32_t TimeoutMs = 2000;
+    const uint32_t SendLength = 128 * 1024;
+
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerUnidiStreamCount(1);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetSendBufferingEnabled(true);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientSettings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr;
+
+    QuicBufferScope UnbufferedData(SendLength);
+    QuicBufferScope BufferedData(SendLength);
+
+    SendNoBufferingTestContext TestContext(ServerConfiguration);
+
+    {
+        ListenerScope Listener;
+        QUIC_STATUS Status =
+            MsQuic->ListenerOpen(
+                Registration,
+                QuicSendNoBufferingListenerHandler,
+                &TestContext,
+                &Listener.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status = MsQuic->ListenerStart(Listener.Handle, Alpn, Alpn.Length(), nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerStart failed, 0x%x.", Status);
+            return;
+        }
+
+        uint32_t Size = sizeof(ServerLocalAddr.SockAddr);
+        Status =
+            MsQuic->GetParam(
+                Listener.Handle,
+                QUIC_PARAM_LEVEL_LISTENER,
+                QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                &Size,
+                &ServerLocalAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->GetParam failed, 0x%x.", Status);
+            return;
+        }
+
+        ConnectionScope ClientConnection;
+        Status =
+            MsQuic->ConnectionOpen(
+                Registration,
+                QuicSendNoBufferingConnectionHandler,
+                &TestContext,
+                &ClientConnection.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->ConnectionStart(
+                ClientConnection.Handle,
+                ClientConfiguration,
+                QuicAddrFamily,
+                QUIC_LOCALHOST_FOR_AF(QuicAddrFamily),
+                ServerLocalAddr.GetPort());
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionStart failed, 0x%x.", Status);
+            return;
+        }
+
+        //
+        // Only send once connected, on an already started stream, so that a
+        // buffered send would be completed as soon as it is queued.
+        //
+        if (!CxPlatEventWaitWithTimeout(TestContext.ClientConnectedEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Client failed to connect before timeout!");
+            return;
+        }
+
+        StreamScope ClientStream;
+        Status =
+            MsQuic->StreamOpen(
+                ClientConnection.Handle,
+                QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                QuicSendNoBufferingClientStreamHandler,
+                &TestContext,
+                &ClientStream.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status = MsQuic->StreamStart(ClientStream.Handle, QUIC_STREAM_START_FLAG_NONE);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamStart failed, 0x%x.", Status);
+            return;
+        }
+
+        //
+        // The first send bypasses the send buffer, so it must not complete
+        // until the peer has acknowledged, and therefore received, all of it.
+        // The second send is buffered as usual, but may not complete ahead
+        // of the first.
+        //
+        Status =
+            MsQuic->StreamSend(
+                ClientStream.Handle,
+                UnbufferedData,
+                1,
+                QUIC_SEND_FLAG_NO_BUFFERING,
+                (void*)(uintptr_t)0);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamSend failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->StreamSend(
+                ClientStream.Handle,
+                BufferedData,
+                1,
+                QUIC_SEND_FLAG_FIN,
+                (void*)(uintptr_t)1);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamSend failed, 0x%x.", Status);
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.SendCompleteEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Client sends failed to complete before timeout!");
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.PeerSendShutdownEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to receive all data before timeout!");
+            return;
+        }
+
+        TEST_FALSE(TestContext.OutOfOrder);
+        TEST_FALSE(TestContext.Canceled);
+        TEST_TRUE(TestContext.ReceivedAtFirstComplete >= (int64_t)SendLength);
+        TEST_EQUAL(TestContext.ServerReceivedLength, (int64_t)(2 * SendLength));
+    }
+}
+
+struct RecvInPlaceTestContext {
+    RecvInPlaceTestContext(
+        _In_ HQUIC ServerConfiguration,
+        _In_ QUIC_RECV_IN_PLACE_TYPE Type) :
+            ServerConfiguration(ServerConfiguration),
+            Type(Type)
+    { }
+    HQUIC ServerConfiguration;
+    QUIC_RECV_IN_PLACE_TYPE Type;
+    EventScope ServerStreamEvent;
+    EventScope ReceiveEvent;
+    EventScope PeerSendShutdownEvent;
+    EventScope ClientStreamShutdownEvent;
+    ConnectionScope ServerConnection;
+    StreamScope ServerStream;
+    uint64_t NextOffset {0};
+    QUIC_BUFFER PendedBuffers[64 * 1024 / 4096 + 1]; // A whole send in 4 KB chunks.
+    uint32_t PendedBufferCount {0};
+    uint64_t PendedLength {0};
+    bool PendedFin {false};
+    bool Failed {false};
+};
+
+//
+// The payload's bytes are the low byte of their stream offset.
+//
+static
+bool
+QuicRecvInPlaceValidate(
+    _In_ uint64_t Offset,
+    _In_reads_(BufferCount) const QUIC_BUFFER* Buffers,
+    _In_ uint32_t BufferCount
+    )
+{
+    for (uint32_t i = 0; i < BufferCount; ++i) {
+        for (uint32_t j = 0; j < Buffers[i].Length; ++j, ++Offset) {
+            if (Buffers[i].Buffer[j] != (uint8_t)Offset) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvInPlaceServerStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    RecvInPlaceTestContext* TestContext = (RecvInPlaceTestContext*)Context;
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_RECEIVE:
+        if (Event->RECEIVE.AbsoluteOffset != TestContext->NextOffset ||
+            Event->RECEIVE.BufferCount > ARRAYSIZE(TestContext->PendedBuffers) ||
+            !QuicRecvInPlaceValidate(
+                Event->RECEIVE.AbsoluteOffset,
+                Event->RECEIVE.Buffers,
+                Event->RECEIVE.BufferCount)) {
+            TEST_FAILURE("Received unexpected data at offset %llu",
+                Event->RECEIVE.AbsoluteOffset);
+            TestContext->Failed = true;
+            return QUIC_STATUS_SUCCESS;
+        }
+
+        if (TestContext->Type == RecvInPlaceConsumeAll) {
+            TestContext->NextOffset += Event->RECEIVE.TotalBufferLength;
+
+        } else if (TestContext->Type == RecvInPlaceConsumePartial) {
+            //
+            // Take half, and have the rest indicated again.
+            //
+            if (Event->RECEIVE.TotalBufferLength > 1) {
+                Event->RECEIVE.TotalBufferLength /= 2;
+            }
+            TestContext->NextOffset += Event->RECEIVE.TotalBufferLength;
+            return QUIC_STATUS_CONTINUE;
+
+        } else {
+            //
+            // Hold on to the buffers. The QUIC_BUFFER array itself is only
+            // valid for the duration of the callback.
+            //
+            CxPlatCopyMemory(
+                TestContext->PendedBuffers,
+                Event->RECEIVE.Buffers,
+                Event->RECEIVE.BufferCount * sizeof(QUIC_BUFFER));
+            TestContext->PendedBufferCount = Event->RECEIVE.BufferCount;
+            TestContext->PendedLength = Event->RECEIVE.TotalBufferLength;
+            TestContext->PendedFin = !!(Event->RECEIVE.Flags & QUIC_RECEIVE_FLAG_FIN);
+            CxPlatEventSet(TestContext->ReceiveEvent.Handle);
+            return QUIC_STATUS_PENDING;
+        }
+        break;
+    case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
+        CxPlatEventSet(TestContext->PeerSendShutdownEvent.Handle);
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvInPlaceClientStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    RecvInPlaceTestContext* TestContext = (RecvInPlaceTestContext*)Context;
+    if (Event->Type == QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE) {
+        CxPlatEventSet(TestContext->ClientStreamShutdownEvent.Handle);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_CONNECTION_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvInPlaceConnectionHandler(
+    _In_ HQUIC QuicConnection,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    )
+{
+    RecvInPlaceTestContext* TestContext = (RecvInPlaceTestContext*)Context;
+    if (QuicConnection == TestContext->ServerConnection.Handle &&
+        Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        MsQuic->SetCallbackHandler(
+            Event->PEER_STREAM_STARTED.Stream,
+            (void*)QuicRecvInPlaceServerStreamHandler,
+            Context);
+        TestContext->ServerStream.Handle = Event->PEER_STREAM_STARTED.Stream;
+        CxPlatEventSet(TestContext->ServerStreamEvent.Handle);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_LISTENER_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvInPlaceListenerHandler(
+    _In_ HQUIC /* QuicListener */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_LISTENER_EVENT* Event
+    )
+{
+    RecvInPlaceTestContext* TestContext = (RecvInPlaceTestContext*)Context;
+    switch (Event->Type) {
+        case QUIC_LISTENER_EVENT_NEW_CONNECTION:
+            TestContext->ServerConnection.Handle = Event->NEW_CONNECTION.Connection;
+            MsQuic->SetCallbackHandler(TestContext->ServerConnection.Handle, (void*) QuicRecvInPlaceConnectionHandler, Context);
+            return MsQuic->ConnectionSetConfiguration(Event->NEW_CONNECTION.Connection, TestContext->ServerConfiguration);
+        default:
+            TEST_FAILURE(
+                "Invalid listener event! Context: 0x%p, Event: %d",
+                Context,
+                Event->Type);
+            return QUIC_STATUS_INVALID_STATE;
+    }
+}
+
+void
+QuicTestStreamRecvInPlace(
+    _In_ int Family,
+    _In_ QUIC_RECV_IN_PLACE_TYPE Type
+    )
+{
+    const uint32_t TimeoutMs = 2000;
+    const uint32_t SendLength = 64 * 1024;
+
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerUnidiStreamCount(1);
+    ServerSettings.SetStreamRecvInPlaceEnabled(true);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr;
+
+    QuicBufferScope Buffer(SendLength);
+    for (uint32_t i = 0; i < SendLength; ++i) {
+        Buffer.Buffer->Buffer[i] = (uint8_t)i;
+    }
+
+    RecvInPlaceTestContext TestContext(ServerConfiguration, Type);
+
+    {
+        ListenerScope Listener;
+        QUIC_STATUS Status =
+            MsQuic->ListenerOpen(
+                Registration,
+                QuicRecvInPlaceListenerHandler,
+                &TestContext,
+                &Listener.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status = MsQuic->ListenerStart(Listener.Handle, Alpn, Alpn.Length(), nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerStart failed, 0x%x.", Status);
+            return;
+        }
+
+        uint32_t Size = sizeof(ServerLocalAddr.SockAddr);
+        Status =
+            MsQuic->GetParam(
+                Listener.Handle,
+                QUIC_PARAM_LEVEL_LISTENER,
+                QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                &Size,
+                &ServerLocalAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->GetParam failed, 0x%x.", Status);
+            return;
+        }
+
+        ConnectionScope ClientConnection;
+        Status =
+            MsQuic->ConnectionOpen(
+                Registration,
+                QuicRecvInPlaceConnectionHandler,
+                &TestContext,
+                &ClientConnection.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->ConnectionStart(
+                ClientConnection.Handle,
+                ClientConfiguration,
+                QuicAddrFamily,
+                QUIC_LOCALHOST_FOR_AF(QuicAddrFamily),
+                ServerLocalAddr.GetPort());
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionStart failed, 0x%x.", Status);
+            return;
+        }
+
+        StreamScope ClientStream;
+        Status =
+            MsQuic->StreamOpen(
+                ClientConnection.Handle,
+                QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                QuicRecvInPlaceClientStreamHandler,
+                &TestContext,
+                &ClientStream.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->StreamSend(
+                ClientStream.Handle,
+                Buffer,
+                1,
+                QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN,
+                nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamSend failed, 0x%x.", Status);
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.ServerStreamEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to get stream before timeout!");
+            return;
+        }
+
+        if (Type == RecvInPlaceCloseWhilePended) {
+            //
+            // Close the stream while the app still holds a receive, so the
+            // stream is freed with the packet still held.
+            //
+            if (!CxPlatEventWaitWithTimeout(TestContext.ReceiveEvent.Handle, TimeoutMs)) {
+                TEST_FAILURE("Server failed to receive data before timeout!");
+                return;
+            }
+            MsQuic->StreamShutdown(
+                TestContext.ServerStream.Handle,
+                QUIC_STREAM_SHUTDOWN_FLAG_ABORT | QUIC_STREAM_SHUTDOWN_FLAG_IMMEDIATE,
+                0);
+            MsQuic->StreamClose(TestContext.ServerStream.Handle);
+            TestContext.ServerStream.Handle = nullptr;
+
+            //
+            // The connection must still be processing packets afterwards.
+            //
+            if (!CxPlatEventWaitWithTimeout(TestContext.ClientStreamShutdownEvent.Handle, TimeoutMs)) {
+                TEST_FAILURE("Client stream failed to shut down before timeout!");
+            }
+            return;
+        }
+
+        if (Type == RecvInPlacePend) {
+            bool Fin = false;
+            while (!Fin) {
+                if (!CxPlatEventWaitWithTimeout(TestContext.ReceiveEvent.Handle, TimeoutMs)) {
+                    TEST_FAILURE("Server failed to receive data before timeout!");
+                    return;
+                }
+
+                //
+                // The pended buffers must still be intact, even though the
+                // connection has moved on to other packets.
+                //
+                if (!QuicRecvInPlaceValidate(
+                        TestContext.NextOffset,
+                        TestContext.PendedBuffers,
+                        TestContext.PendedBufferCount)) {
+                    TEST_FAILURE("Pended data at offset %llu changed!", TestContext.NextOffset);
+                    return;
+                }
+
+                Fin = TestContext.PendedFin;
+                TestContext.NextOffset += TestContext.PendedLength;
+                Status =
+                    MsQuic->StreamReceiveComplete(
+                        TestContext.ServerStream.Handle,
+                        TestContext.PendedLength);
+                if (QUIC_FAILED(Status)) {
+                    TEST_FAILURE("MsQuic->StreamReceiveComplete failed, 0x%x.", Status);
+                    return;
+                }
+            }
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.PeerSendShutdownEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to receive all data before timeout!");
+            return;
+        }
+
+        TEST_FALSE(TestContext.Failed);
+        TEST_EQUAL(TestContext.NextOffset, SendLength);
+    }
+}
+
+struct RecvIndicationTestContext {
+    RecvIndicationTestContext(_In_ HQUIC ServerConfiguration) :
+        ServerConfiguration(ServerConfiguration)
+    { }
+    HQUIC ServerConfiguration;
+    EventScope FirstReceiveEvent;
+    EventScope SecondReceiveEvent;
+    EventScope ClientSendCompleteEvent;
+    ConnectionScope ServerConnection;
+    HQUIC ServerStream {nullptr};
+    uint32_t ReceiveCount {0};
+    uint64_t FirstLength {0};
+    uint64_t SecondOffset {0};
+    uint64_t SecondLength {0};
+    uint32_t SecondBufferCount {0};
+    bool SecondFin {false};
+    bool Failed {false};
+};
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvIndicationServerStreamHandler(
+    _In_ HQUIC QuicStream,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    RecvIndicationTestContext* TestContext = (RecvIndicationTestContext*)Context;
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_RECEIVE: {
+        uint64_t Length = 0;
+        for (uint32_t i = 0; i < Event->RECEIVE.BufferCount; ++i) {
+            Length += Event->RECEIVE.Buffers[i].Length;
+        }
+        if (Length != Event->RECEIVE.TotalBufferLength) {
+            TestContext->Failed = true;
+        }
+
+        if (++TestContext->ReceiveCount == 1) {
+            //
+            // Hold on to the first receive, so everything else the client
+            // sends is buffered.
+            //
+            TestContext->FirstLength = Event->RECEIVE.TotalBufferLength;
+            CxPlatEventSet(TestContext->FirstReceiveEvent.Handle);
+            return QUIC_STATUS_PENDING;
+        }
+
+        if (TestContext->ReceiveCount == 2) {
+            TestContext->SecondOffset = Event->RECEIVE.AbsoluteOffset;
+            TestContext->SecondLength = Event->RECEIVE.TotalBufferLength;
+            TestContext->SecondBufferCount = Event->RECEIVE.BufferCount;
+            TestContext->SecondFin = !!(Event->RECEIVE.Flags & QUIC_RECEIVE_FLAG_FIN);
+            CxPlatEventSet(TestContext->SecondReceiveEvent.Handle);
+        }
+        break;
+    }
+    case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+        MsQuic->StreamClose(QuicStream);
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvIndicationClientStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    RecvIndicationTestContext* TestContext = (RecvIndicationTestContext*)Context;
+    if (Event->Type == QUIC_STREAM_EVENT_SEND_COMPLETE) {
+        CxPlatEventSet(TestContext->ClientSendCompleteEvent.Handle);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_CONNECTION_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvIndicationConnectionHandler(
+    _In_ HQUIC QuicConnection,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    )
+{
+    RecvIndicationTestContext* TestContext = (RecvIndicationTestContext*)Context;
+    if (QuicConnection == TestContext->ServerConnection.Handle &&
+        Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        MsQuic->SetCallbackHandler(
+            Event->PEER_STREAM_STARTED.Stream,
+            (void*)QuicRecvIndicationServerStreamHandler,
+            Context);
+        TestContext->ServerStream = Event->PEER_STREAM_STARTED.Stream;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_LISTENER_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicRecvIndicationListenerHandler(
+    _In_ HQUIC /* QuicListener */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_LISTENER_EVENT* Event
+    )
+{
+    RecvIndicationTestContext* TestContext = (RecvIndicationTestContext*)Context;
+    switch (Event->Type) {
+        case QUIC_LISTENER_EVENT_NEW_CONNECTION:
+            TestContext->ServerConnection.Handle = Event->NEW_CONNECTION.Connection;
+            MsQuic->SetCallbackHandler(TestContext->ServerConnection.Handle, (void*) QuicRecvIndicationConnectionHandler, Context);
+            return MsQuic->ConnectionSetConfiguration(Event->NEW_CONNECTION.Connection, TestContext->ServerConfiguration);
+        default:
+            TEST_FAILURE(
+                "Invalid listener event! Context: 0x%p, Event: %d",
+                Context,
+                Event->Type);
+            return QUIC_STATUS_INVALID_STATE;
+    }
+}
+
+void
+QuicTestStreamRecvLargeIndication(
+    _In_ int Family
+    )
+{
+    const uint32_t SendLength = 256 * 1024;
+    const uint32_t TimeoutMs = EstimateTimeoutMs(SendLength) + 2000;
+
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    //
+    // The stream window is large enough to buffer everything the client sends
+    // while the first receive is pending.
+    //
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerUnidiStreamCount(1);
+    ServerSettings.StreamRecvWindowDefault = 2 * SendLength;
+    ServerSettings.IsSet.StreamRecvWindowDefault = TRUE;
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    //
+    // Without send buffering, the send only completes once the server has
+    // acknowledged (so buffered) all of it.
+    //
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetSendBufferingEnabled(false);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientSettings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr;
+
+    QuicBufferScope Buffer(SendLength);
+
+    RecvIndicationTestContext TestContext(ServerConfiguration);
+
+    {
+        ListenerScope Listener;
+        QUIC_STATUS Status =
+            MsQuic->ListenerOpen(
+                Registration,
+                QuicRecvIndicationListenerHandler,
+                &TestContext,
+                &Listener.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status = MsQuic->ListenerStart(Listener.Handle, Alpn, Alpn.Length(), nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerStart failed, 0x%x.", Status);
+            return;
+        }
+
+        uint32_t Size = sizeof(ServerLocalAddr.SockAddr);
+        Status =
+            MsQuic->GetParam(
+                Listener.Handle,
+                QUIC_PARAM_LEVEL_LISTENER,
+                QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                &Size,
+                &ServerLocalAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->GetParam failed, 0x%x.", Status);
+            return;
+        }
+
+        ConnectionScope ClientConnection;
+        Status =
+            MsQuic->ConnectionOpen(
+                Registration,
+                QuicRecvIndicationConnectionHandler,
+                &TestContext,
+                &ClientConnection.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        QuicAddr RemoteAddr(QuicAddrFamily, true);
+        Status =
+            MsQuic->SetParam(
+                ClientConnection.Handle,
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                sizeof(RemoteAddr.SockAddr),
+                &RemoteAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->SetParam(CONN_REMOTE_ADDRESS) failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->ConnectionStart(
+                ClientConnection.Handle,
+                ClientConfiguration,
+                QuicAddrFamily,
+                nullptr,
+                ServerLocalAddr.GetPort());
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionStart failed, 0x%x.", Status);
+            return;
+        }
+
+        StreamScope ClientStream;
+        Status =
+            MsQuic->StreamOpen(
+                ClientConnection.Handle,
+                QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                QuicRecvIndicationClientStreamHandler,
+                &TestContext,
+                &ClientStream.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->StreamSend(
+                ClientStream.Handle,
+                Buffer,
+                1,
+                QUIC_SEND_FLAG_START | QUIC_SEND_FLAG_FIN,
+                nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->StreamSend failed, 0x%x.", Status);
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.FirstReceiveEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to receive data before timeout!");
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.ClientSendCompleteEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Client send failed to complete before timeout!");
+            return;
+        }
+
+        //
+        // Everything after the first receive is now buffered, across many
+        // more chunks than fit in a receive event without allocating. It must
+        // all be indicated at once.
+        //
+        MsQuic->StreamReceiveComplete(TestContext.ServerStream, TestContext.FirstLength);
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.SecondReceiveEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to receive the buffered data before timeout!");
+            return;
+        }
+
+        TEST_FALSE(TestContext.Failed);
+        TEST_EQUAL(TestContext.SecondOffset, TestContext.FirstLength);
+        TEST_EQUAL(TestContext.SecondLength, SendLength - TestContext.FirstLength);
+        TEST_TRUE(TestContext.SecondFin);
+        TEST_TRUE(TestContext.SecondBufferCount > 8); // More than fit on the stack.
+    }
+}
+
+//
+// The streams of the priority scheduling test, in the order they are started
+// (so stream i has ID 4 * i + 2). Streams 1 and 2 share a priority, with
+// weights 3 and 1. The lowest priority streams are started in ascending
+// priority order, which rebalances the scheduler's tree of priority levels.
+//
+#define PRIORITY_TEST_STREAM_COUNT 7
+
+static const uint16_t PriorityTestPriorities[PRIORITY_TEST_STREAM_COUNT] = {
+    0xF000, 0x8000, 0x8000, 0x1000, 0x2000, 0x3000, 0x4000
+};
+
+static const uint8_t PriorityTestWeights[PRIORITY_TEST_STREAM_COUNT] = {
+    1, 3, 1, 1, 1, 1, 1
+};
+
+static const uint32_t PriorityTestLengths[PRIORITY_TEST_STREAM_COUNT] = {
+    48 * 1024, 1024 * 1024, 1024 * 1024, 16 * 1024, 16 * 1024, 16 * 1024, 16 * 1024
+};
+
+struct PrioritySchedulingTestContext {
+    PrioritySchedulingTestContext(_In_ HQUIC ServerConfiguration) :
+        ServerConfiguration(ServerConfiguration)
+    { }
+    HQUIC ServerConfiguration;
+    EventScope AllReceivedEvent;
+    ConnectionScope ServerConnection;
+    uint64_t ReceivedLength[PRIORITY_TEST_STREAM_COUNT] {0};
+    uint64_t ReceivedAtFin[PRIORITY_TEST_STREAM_COUNT][PRIORITY_TEST_STREAM_COUNT] {{0}};
+    uint32_t FinCount {0};
+    bool Failed {false};
+};
+
+//
+// All the server stream events run on the server connection's worker, so
+// the counters need no synchronization.
+//
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicPrioritySchedulingServerStreamHandler(
+    _In_ HQUIC QuicStream,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_STREAM_EVENT* Event
+    )
+{
+    PrioritySchedulingTestContext* TestContext = (PrioritySchedulingTestContext*)Context;
+
+    uint64_t StreamId = 0;
+    uint32_t Size = sizeof(StreamId);
+    if (QUIC_FAILED(
+        MsQuic->GetParam(
+            QuicStream,
+            QUIC_PARAM_LEVEL_STREAM,
+            QUIC_PARAM_STREAM_ID,
+            &Size,
+            &StreamId)) ||
+        (StreamId >> 2) >= PRIORITY_TEST_STREAM_COUNT) {
+        TestContext->Failed = true;
+        return QUIC_STATUS_SUCCESS;
+    }
+    const uint32_t Index = (uint32_t)(StreamId >> 2);
+
+    switch (Event->Type) {
+    case QUIC_STREAM_EVENT_RECEIVE:
+        TestContext->ReceivedLength[Index] += Event->RECEIVE.TotalBufferLength;
+        break;
+    case QUIC_STREAM_EVENT_PEER_SEND_SHUTDOWN:
+        CxPlatCopyMemory(
+            TestContext->ReceivedAtFin[Index],
+            TestContext->ReceivedLength,
+            sizeof(TestContext->ReceivedLength));
+        if (++TestContext->FinCount == PRIORITY_TEST_STREAM_COUNT) {
+            CxPlatEventSet(TestContext->AllReceivedEvent.Handle);
+        }
+        break;
+    case QUIC_STREAM_EVENT_SHUTDOWN_COMPLETE:
+        MsQuic->StreamClose(QuicStream);
+        break;
+    default:
+        break;
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_STREAM_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicPrioritySchedulingClientStreamHandler(
+    _In_ HQUIC /* QuicStream */,
+    _In_opt_ void* /* Context */,
+    _Inout_ QUIC_STREAM_EVENT* /* Event */
+    )
+{
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_CONNECTION_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicPrioritySchedulingConnectionHandler(
+    _In_ HQUIC QuicConnection,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_CONNECTION_EVENT* Event
+    )
+{
+    PrioritySchedulingTestContext* TestContext = (PrioritySchedulingTestContext*)Context;
+    if (QuicConnection == TestContext->ServerConnection.Handle &&
+        Event->Type == QUIC_CONNECTION_EVENT_PEER_STREAM_STARTED) {
+        MsQuic->SetCallbackHandler(
+            Event->PEER_STREAM_STARTED.Stream,
+            (void*)QuicPrioritySchedulingServerStreamHandler,
+            Context);
+    }
+    return QUIC_STATUS_SUCCESS;
+}
+
+_IRQL_requires_max_(PASSIVE_LEVEL)
+_Function_class_(QUIC_LISTENER_CALLBACK)
+static
+QUIC_STATUS
+QUIC_API
+QuicPrioritySchedulingListenerHandler(
+    _In_ HQUIC /* QuicListener */,
+    _In_opt_ void* Context,
+    _Inout_ QUIC_LISTENER_EVENT* Event
+    )
+{
+    PrioritySchedulingTestContext* TestContext = (PrioritySchedulingTestContext*)Context;
+    switch (Event->Type) {
+        case QUIC_LISTENER_EVENT_NEW_CONNECTION:
+            TestContext->ServerConnection.Handle = Event->NEW_CONNECTION.Connection;
+            MsQuic->SetCallbackHandler(TestContext->ServerConnection.Handle, (void*) QuicPrioritySchedulingConnectionHandler, Context);
+            return MsQuic->ConnectionSetConfiguration(Event->NEW_CONNECTION.Connection, TestContext->ServerConfiguration);
+        default:
+            TEST_FAILURE(
+                "Invalid listener event! Context: 0x%p, Event: %d",
+                Context,
+                Event->Type);
+            return QUIC_STATUS_INVALID_STATE;
+    }
+}
+
+void
+QuicTestStreamPriorityScheduling(
+    _In_ int Family
+    )
+{
+    const uint32_t TimeoutMs = EstimateTimeoutMs(3 * 1024 * 1024);
+
+    //
+    // A packet that finishes one stream may be filled up with the next one's
+    // data, so a few packets' worth of lower priority data may arrive before
+    // a stream's FIN.
+    //
+    const uint64_t Slack = 4 * 1500;
+
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    //
+    // The stream windows are larger than the streams, so no stream is ever
+    // flow control blocked and the schedule is only up to the sender. The
+    // connection window is small though: the server processes all the
+    // datagrams queued on the connection before it indicates any of them, so
+    // the sender must not get far ahead of what the server has indicated.
+    //
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetPeerUnidiStreamCount(PRIORITY_TEST_STREAM_COUNT);
+    ServerSettings.StreamRecvWindowDefault = 4 * 1024 * 1024;
+    ServerSettings.IsSet.StreamRecvWindowDefault = TRUE;
+    ServerSettings.ConnFlowControlWindow = 64 * 1024;
+    ServerSettings.IsSet.ConnFlowControlWindow = TRUE;
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    //
+    // Without send buffering, every stream always has all its data ready to
+    // send, instead of however much the send buffer has taken in so far.
+    //
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetSendBufferingEnabled(false);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientSettings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+    QuicAddr ServerLocalAddr;
+
+    //
+    // Every stream sends (a prefix of) the same data.
+    //
+    QuicBufferScope Data(1024 * 1024);
+    QUIC_BUFFER Buffers[PRIORITY_TEST_STREAM_COUNT];
+    for (uint32_t i = 0; i < PRIORITY_TEST_STREAM_COUNT; ++i) {
+        Buffers[i].Length = PriorityTestLengths[i];
+        Buffers[i].Buffer = Data.Buffer->Buffer;
+    }
+
+    PrioritySchedulingTestContext TestContext(ServerConfiguration);
+
+    {
+        ListenerScope Listener;
+        QUIC_STATUS Status =
+            MsQuic->ListenerOpen(
+                Registration,
+                QuicPrioritySchedulingListenerHandler,
+                &TestContext,
+                &Listener.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        Status = MsQuic->ListenerStart(Listener.Handle, Alpn, Alpn.Length(), nullptr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ListenerStart failed, 0x%x.", Status);
+            return;
+        }
+
+        uint32_t Size = sizeof(ServerLocalAddr.SockAddr);
+        Status =
+            MsQuic->GetParam(
+                Listener.Handle,
+                QUIC_PARAM_LEVEL_LISTENER,
+                QUIC_PARAM_LISTENER_LOCAL_ADDRESS,
+                &Size,
+                &ServerLocalAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->GetParam failed, 0x%x.", Status);
+            return;
+        }
+
+        ConnectionScope ClientConnection;
+        Status =
+            MsQuic->ConnectionOpen(
+                Registration,
+                QuicPrioritySchedulingConnectionHandler,
+                &TestContext,
+                &ClientConnection.Handle);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionOpen failed, 0x%x.", Status);
+            return;
+        }
+
+        QUIC_STREAM_SCHEDULING_SCHEME Scheme = QUIC_STREAM_SCHEDULING_SCHEME_ROUND_ROBIN;
+        Status =
+            MsQuic->SetParam(
+                ClientConnection.Handle,
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_STREAM_SCHEDULING_SCHEME,
+                sizeof(Scheme),
+                &Scheme);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->SetParam(STREAM_SCHEDULING_SCHEME) failed, 0x%x.", Status);
+            return;
+        }
+
+        //
+        // Queue all the data before the handshake, so the scheduler has every
+        // stream to choose from once it can send 1-RTT data.
+        //
+        StreamScope ClientStreams[PRIORITY_TEST_STREAM_COUNT];
+        for (uint32_t i = 0; i < PRIORITY_TEST_STREAM_COUNT; ++i) {
+            Status =
+                MsQuic->StreamOpen(
+                    ClientConnection.Handle,
+                    QUIC_STREAM_OPEN_FLAG_UNIDIRECTIONAL,
+                    QuicPrioritySchedulingClientStreamHandler,
+                    &TestContext,
+                    &ClientStreams[i].Handle);
+            if (QUIC_FAILED(Status)) {
+                TEST_FAILURE("MsQuic->StreamOpen failed, 0x%x.", Status);
+                return;
+            }
+
+            Status =
+                MsQuic->SetParam(
+                    ClientStreams[i].Handle,
+                    QUIC_PARAM_LEVEL_STREAM,
+                    QUIC_PARAM_STREAM_PRIORITY,
+                    sizeof(PriorityTestPriorities[i]),
+                    &PriorityTestPriorities[i]);
+            if (QUIC_FAILED(Status)) {
+                TEST_FAILURE("MsQuic->SetParam(STREAM_PRIORITY) failed, 0x%x.", Status);
+                return;
+            }
+
+            Status =
+                MsQuic->SetParam(
+                    ClientStreams[i].Handle,
+                    QUIC_PARAM_LEVEL_STREAM,
+                    QUIC_PARAM_STREAM_WEIGHT,
+                    sizeof(PriorityTestWeights[i]),
+                    &PriorityTestWeights[i]);
+            if (QUIC_FAILED(Status)) {
+                TEST_FAILURE("MsQuic->SetParam(STREAM_WEIGHT) failed, 0x%x.", Status);
+                return;
+            }
+
+            Status = MsQuic->StreamStart(ClientStreams[i].Handle, QUIC_STREAM_START_FLAG_NONE);
+            if (QUIC_FAILED(Status)) {
+                TEST_FAILURE("MsQuic->StreamStart failed, 0x%x.", Status);
+                return;
+            }
+
+            Status =
+                MsQuic->StreamSend(
+                    ClientStreams[i].Handle,
+                    &Buffers[i],
+                    1,
+                    QUIC_SEND_FLAG_FIN,
+                    nullptr);
+            if (QUIC_FAILED(Status)) {
+                TEST_FAILURE("MsQuic->StreamSend failed, 0x%x.", Status);
+                return;
+            }
+        }
+
+        QuicAddr RemoteAddr(QuicAddrFamily, true);
+        Status =
+            MsQuic->SetParam(
+                ClientConnection.Handle,
+                QUIC_PARAM_LEVEL_CONNECTION,
+                QUIC_PARAM_CONN_REMOTE_ADDRESS,
+                sizeof(RemoteAddr.SockAddr),
+                &RemoteAddr.SockAddr);
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->SetParam(CONN_REMOTE_ADDRESS) failed, 0x%x.", Status);
+            return;
+        }
+
+        Status =
+            MsQuic->ConnectionStart(
+                ClientConnection.Handle,
+                ClientConfiguration,
+                QuicAddrFamily,
+                nullptr,
+                ServerLocalAddr.GetPort());
+        if (QUIC_FAILED(Status)) {
+            TEST_FAILURE("MsQuic->ConnectionStart failed, 0x%x.", Status);
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(TestContext.AllReceivedEvent.Handle, TimeoutMs)) {
+            TEST_FAILURE("Server failed to receive all streams before timeout!");
+            return;
+        }
+
+        TEST_FALSE(TestContext.Failed);
+
+        for (uint32_t i = 0; i < PRIORITY_TEST_STREAM_COUNT; ++i) {
+            TEST_EQUAL(TestContext.ReceivedLength[i], PriorityTestLengths[i]);
+
+            //
+            // Higher priority streams are drained first.
+            //
+            uint64_t LowerReceived = 0;
+            for (uint32_t j = 0; j < PRIORITY_TEST_STREAM_COUNT; ++j) {
+                if (PriorityTestPriorities[j] < PriorityTestPriorities[i]) {
+                    LowerReceived += TestContext.ReceivedAtFin[i][j];
+                }
+            }
+            if (LowerReceived > Slack) {
+                TEST_FAILURE(
+                    "%llu bytes of lower priority streams received before stream %u finished.",
+                    (unsigned long long)LowerReceived,
+                    i);
+            }
+        }
+
+        //
+        // Streams 1 and 2 have the same priority and length, but weights 3 and
+        // 1, so stream 2 should have about a third of its data when stream 1
+        // finishes.
+        //
+        const uint64_t WeightedReceived = TestContext.ReceivedAtFin[1][2];
+        if (WeightedReceived < PriorityTestLengths[2] / 6 ||
+            WeightedReceived > PriorityTestLengths[2] / 2) {
+            TEST_FAILURE(
+                "Stream 2 (weight 1) had %llu of %u bytes when stream 1 (weight 3) finished.",
+                (unsigned long long)WeightedReceived,
+                PriorityTestLengths[2]);
+        }
+    }
+}
+
+#if defined(QUIC_QLOG_SUPPORT) && QUIC_TEST_DATAPATH_HOOKS_ENABLED
+
+struct QlogPingStats : public PingStats {
+    QlogPingStats(uint64_t Length) :
+        PingStats(Length, 1, 1, false, true, false, false)
+    { }
+    uint64_t ServerCorrelationId {UINT64_MAX};
+};
+
+_Function_class_(NEW_CONNECTION_CALLBACK)
+static
+bool
+ListenerAcceptQlogConnection(
+    _In_ TestListener* Listener,
+    _In_ HQUIC ConnectionHandle
+    )
+{
+    QUIC_STATISTICS Stats;
+    uint32_t StatsSize = sizeof(Stats);
+    if (QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            ConnectionHandle,
+            QUIC_PARAM_LEVEL_CONNECTION,
+            QUIC_PARAM_CONN_STATISTICS,
+            &StatsSize,
+            &Stats))) {
+        ((QlogPingStats*)Listener->Context)->ServerCorrelationId = Stats.CorrelationId;
+    }
+    return ListenerAcceptPingConnection(Listener, ConnectionHandle);
+}
+
+static
+void
+QuicQlogTestPath(
+    _In_z_ const char* Dir,
+    _In_ uint64_t CorrelationId,
+    _In_ bool IsServer,
+    _Out_writes_(256) char* Path
+    )
+{
+#ifdef _WIN32
+    const uint32_t ProcessId = GetCurrentProcessId();
+#else
+    const uint32_t ProcessId = (uint32_t)getpid();
+#endif
+    snprintf(
+        Path,
+        256,
+        "%s/%u_%llu_%s.sqlog",
+        Dir,
+        ProcessId,
+        (unsigned long long)CorrelationId,
+        IsServer ? "server" : "client");
+}
+
+//
+// Returns the contents of the file, NUL-terminated, or nullptr if it can't be
+// read.
+//
+static
+char*
+QuicQlogTestReadFile(
+    _In_z_ const char* Path
+    )
+{
+    FILE* File = fopen(Path, "rb");
+    if (File == nullptr) {
+        return nullptr;
+    }
+    char* Contents = nullptr;
+    if (fseek(File, 0, SEEK_END) == 0) {
+        long Length = ftell(File);
+        if (Length >= 0 && fseek(File, 0, SEEK_SET) == 0) {
+            Contents = (char*)CXPLAT_ALLOC_NONPAGED((size_t)Length + 1, QUIC_POOL_TEST);
+            if (Contents != nullptr) {
+                Contents[fread(Contents, 1, (size_t)Length, File)] = '\0';
+            }
+        }
+    }
+    fclose(File);
+    return Contents;
+}
+
+void
+QuicTestQlog(
+    _In_ int Family
+    )
+{
+    //
+    // Far more events than fit in a log's ring, so that some are dropped
+    // while the writer is paused.
+    //
+    const uint64_t Length = 4 * 1024 * 1024;
+    const uint32_t TimeoutMs = EstimateTimeoutMs(Length);
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+#ifdef _WIN32
+    const char* Dir = getenv("TEMP");
+    if (Dir == nullptr) {
+        Dir = ".";
+    }
+#else
+    const char* Dir = "/tmp";
+#endif
+
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_QLOG_DIR,
+            (uint32_t)strlen(Dir) + 1,
+            Dir));
+    BOOLEAN Paused = TRUE;
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_QLOG_WRITER_PAUSED,
+            sizeof(Paused),
+            &Paused));
+
+    QlogPingStats ServerStats(Length);
+    PingStats ClientStats(Length, 1, 1, false, true, false, false);
+    uint64_t ClientCorrelationId = UINT64_MAX;
+
+    {
+        RandomLossHelper LossHelper(5);
+
+        MsQuicRegistration Registration(true);
+        TEST_TRUE(Registration.IsValid());
+
+        MsQuicAlpn Alpn("MsQuicTest");
+
+        MsQuicSettings Settings;
+        Settings.SetPeerUnidiStreamCount(1);
+
+        MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+        TEST_TRUE(ServerConfiguration.IsValid());
+
+        MsQuicCredentialConfig ClientCredConfig;
+        MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientCredConfig);
+        TEST_TRUE(ClientConfiguration.IsValid());
+
+        TestListener Listener(
+            Registration,
+            ListenerAcceptQlogConnection,
+            ServerConfiguration);
+        TEST_TRUE(Listener.IsValid());
+        TEST_QUIC_SUCCEEDED(Listener.Start(Alpn));
+        Listener.Context = &ServerStats;
+
+        QuicAddr ServerLocalAddr;
+        TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+        TestConnection* Connection = NewPingConnection(Registration, &ClientStats, false);
+        if (Connection == nullptr) {
+            return;
+        }
+        Connection->SetHasRandomLoss(true);
+        ClientCorrelationId = Connection->GetStatistics().CorrelationId;
+        if (!SendPingBurst(Connection, 1, Length)) {
+            return;
+        }
+        QuicAddr RemoteAddr(QuicAddrFamily, true);
+        TEST_QUIC_SUCCEEDED(Connection->SetRemoteAddr(RemoteAddr));
+        TEST_QUIC_SUCCEEDED(
+            Connection->Start(
+                ClientConfiguration,
+                QuicAddrFamily,
+                nullptr,
+                ServerLocalAddr.GetPort()));
+
+        if (!CxPlatEventWaitWithTimeout(ClientStats.CompletionEvent, TimeoutMs)) {
+            TEST_FAILURE("Wait for client to complete timed out after %u ms.", TimeoutMs);
+            return;
+        }
+
+        if (!CxPlatEventWaitWithTimeout(ServerStats.CompletionEvent, TimeoutMs)) {
+            TEST_FAILURE("Wait for server to complete timed out after %u ms.", TimeoutMs);
+            return;
+        }
+    }
+
+    //
+    // Closing the registration closed both connections, and with them their
+    // logs. Once the writer resumes, it writes them out, ending with the
+    // warning for the events dropped while it was paused.
+    //
+    Paused = FALSE;
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_QLOG_WRITER_PAUSED,
+            sizeof(Paused),
+            &Paused));
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->SetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_QLOG_DIR,
+            1,
+            ""));
+
+    char ClientPath[256], ServerPath[256];
+    QuicQlogTestPath(Dir, ClientCorrelationId, false, ClientPath);
+    QuicQlogTestPath(Dir, ServerStats.ServerCorrelationId, true, ServerPath);
+
+    char* Log = nullptr;
+    for (uint32_t i = 0; i < 50; ++i) {
+        Log = QuicQlogTestReadFile(ClientPath);
+        if (Log != nullptr && strstr(Log, "\"name\":\"loglevel:warning\"") != nullptr) {
+            break;
+        }
+        if (Log != nullptr) {
+            CXPLAT_FREE(Log, QUIC_POOL_TEST);
+            Log = nullptr;
+        }
+        CxPlatSleep(100);
+    }
+
+    if (Log == nullptr) {
+        TEST_FAILURE("%s doesn't have the dropped events warning.", ClientPath);
+    } else {
+        const char Header[] = "\x1e{\"qlog_version\":\"0.3\",\"qlog_format\":\"JSON-SEQ\"";
+        TEST_TRUE(strncmp(Log, Header, sizeof(Header) - 1) == 0);
+        TEST_NOT_EQUAL(nullptr, strstr(Log, "\"vantage_point\":{\"name\":\"msquic\",\"type\":\"client\"}"));
+        TEST_NOT_EQUAL(nullptr, strstr(Log, "\"name\":\"transport:packet_sent\""));
+        TEST_NOT_EQUAL(nullptr, strstr(Log, "\"name\":\"recovery:packet_lost\""));
+        TEST_NOT_EQUAL(nullptr, strstr(Log, "\"name\":\"recovery:metrics_updated\""));
+        TEST_NOT_EQUAL(nullptr, strstr(Log, "events dropped, the qlog writer fell behind"));
+        CXPLAT_FREE(Log, QUIC_POOL_TEST);
+    }
+
+    remove(ClientPath);
+    remove(ServerPath);
+}
+
+#endif // QUIC_QLOG_SUPPORT && QUIC_TEST_DATAPATH_HOOKS_ENABLED
@@ -2076,6 +2076,376 @@ QuicTestConnectClientCertificate(
     }
 }
 
+void
+QuicTestConnectTlsOffload(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings ServerSettings;
+    ServerSettings.SetIdleTimeoutMs(3000).SetTlsOffloadEnabled(true);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, ServerSettings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicSettings ClientSettings;
+    ClientSettings.SetIdleTimeoutMs(3000);
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, ClientSettings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+    TEST_TRUE(Listener.IsValid());
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    //
+    // Run several handshakes through the same listener so the offload pool is
+    // reused after it's started.
+    //
+    for (uint32_t i = 0; i < 4; ++i) {
+        UniquePtr<TestConnection> Server;
+        ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+        Listener.Context = &ServerAcceptCtx;
+
+        {
+            TestConnection Client(Registration);
+            TEST_TRUE(Client.IsValid());
+
+            TEST_QUIC_SUCCEEDED(
+                Client.Start(
+                    ClientConfiguration,
+                    QuicAddrFamily,
+                    QUIC_LOCALHOST_FOR_AF(
+                        QuicAddrGetFamily(&ServerLocalAddr.SockAddr)),
+                    ServerLocalAddr.GetPort()));
+
+            if (!Client.WaitForConnectionComplete()) {
+                return;
+            }
+            TEST_TRUE(Client.GetIsConnected());
+
+            TEST_NOT_EQUAL(nullptr, Server);
+            if (!Server->WaitForConnectionComplete()) {
+                return;
+            }
+            TEST_TRUE(Server->GetIsConnected());
+
+#ifdef QUIC_TLS_OPENSSL
+            //
+            // OpenSSL is the only provider that offloads, and it always does
+            // for the server's first flight when enabled.
+            //
+            TEST_NOT_EQUAL(0, Server->GetStatisticsV2().HandshakeTiming.TlsOffloadTime);
+#endif
+        }
+    }
+
+    //
+    // Close server connections as soon as they're accepted, while their first
+    // flight is likely still queued to or running on the offload pool. The
+    // pending call must be canceled without waiting for it.
+    //
+    for (uint32_t i = 0; i < 4; ++i) {
+        UniquePtr<TestConnection> Server;
+        ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+        Listener.Context = &ServerAcceptCtx;
+
+        TestConnection Client(Registration);
+        TEST_TRUE(Client.IsValid());
+
+        TEST_QUIC_SUCCEEDED(
+            Client.Start(
+                ClientConfiguration,
+                QuicAddrFamily,
+                QUIC_LOCALHOST_FOR_AF(
+                    QuicAddrGetFamily(&ServerLocalAddr.SockAddr)),
+                ServerLocalAddr.GetPort()));
+
+        if (!CxPlatEventWaitWithTimeout(ServerAcceptCtx.NewConnectionReady, TestWaitTimeout)) {
+            TEST_FAILURE("Timed out waiting for server accept.");
+            return;
+        }
+        TEST_NOT_EQUAL(nullptr, Server);
+        Server.reset(nullptr);
+    }
+}
+
+static
+void
+QuicTestValidateHandshakeTiming(
+    _In_ TestConnection* Connection,
+    _In_ uint64_t ElapsedUs
+    )
+{
+    QUIC_STATISTICS_V2 Stats = Connection->GetStatisticsV2();
+    TEST_EQUAL(Connection->GetStatistics().CorrelationId, Stats.V1.CorrelationId);
+    TEST_NOT_EQUAL(0, Stats.V1.Recv.TotalPackets);
+
+    //
+    // The phases overlap at most with cert validation, which is also counted
+    // in TLS processing, and none can take longer than the whole handshake.
+    //
+    const uint64_t Total =
+        Stats.HandshakeTiming.TlsProcessTime +
+        Stats.HandshakeTiming.TlsOffloadTime +
+        Stats.HandshakeTiming.KeyDeriveTime +
+        Stats.HandshakeTiming.QueueWaitTime;
+    if (Total > ElapsedUs) {
+        TEST_FAILURE("Handshake timings (%llu us) exceed the handshake (%llu us)", Total, ElapsedUs);
+    }
+    TEST_TRUE(Stats.HandshakeTiming.CertValidationTime <= Stats.HandshakeTiming.TlsProcessTime);
+    TEST_TRUE(Stats.HandshakeTiming.PacingBlockedTime <= ElapsedUs);
+    TEST_TRUE(Stats.HandshakeTiming.AmplificationBlockedTime <= ElapsedUs);
+
+    uint32_t BufferLength = sizeof(QUIC_STATISTICS);
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        MsQuic->GetParam(
+            Connection->GetConnection(),
+            QUIC_PARAM_LEVEL_CONNECTION,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &BufferLength,
+            &Stats));
+    TEST_EQUAL(sizeof(QUIC_STATISTICS_V2), BufferLength);
+}
+
+void
+QuicTestHandshakeTimingStatistics(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetIdleTimeoutMs(3000);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+    TEST_TRUE(Listener.IsValid());
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    UniquePtr<TestConnection> Server;
+    ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+    Listener.Context = &ServerAcceptCtx;
+
+    TestConnection Client(Registration);
+    TEST_TRUE(Client.IsValid());
+
+    const uint64_t StartTime = CxPlatTimeUs64();
+    TEST_QUIC_SUCCEEDED(
+        Client.Start(
+            ClientConfiguration,
+            QuicAddrFamily,
+            QUIC_LOCALHOST_FOR_AF(
+                QuicAddrGetFamily(&ServerLocalAddr.SockAddr)),
+            ServerLocalAddr.GetPort()));
+
+    if (!Client.WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Client.GetIsConnected());
+
+    TEST_NOT_EQUAL(nullptr, Server);
+    if (!Server->WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Server->GetIsConnected());
+
+    CxPlatSleep(100); // Let the handshake be confirmed.
+
+    const uint64_t ElapsedUs = CxPlatTimeDiff64(StartTime, CxPlatTimeUs64());
+    QuicTestValidateHandshakeTiming(&Client, ElapsedUs);
+    QuicTestValidateHandshakeTiming(Server.get(), ElapsedUs);
+}
+
+void
+QuicTestWorkerAndBindingStatistics(
+    _In_ int Family
+    )
+{
+    MsQuicRegistration Registration;
+    TEST_TRUE(Registration.IsValid());
+
+    MsQuicAlpn Alpn("MsQuicTest");
+
+    MsQuicSettings Settings;
+    Settings.SetIdleTimeoutMs(3000);
+
+    MsQuicConfiguration ServerConfiguration(Registration, Alpn, Settings, ServerSelfSignedCredConfig);
+    TEST_TRUE(ServerConfiguration.IsValid());
+
+    MsQuicCredentialConfig ClientCredConfig;
+    MsQuicConfiguration ClientConfiguration(Registration, Alpn, Settings, ClientCredConfig);
+    TEST_TRUE(ClientConfiguration.IsValid());
+
+    QUIC_ADDRESS_FAMILY QuicAddrFamily = (Family == 4) ? QUIC_ADDRESS_FAMILY_INET : QUIC_ADDRESS_FAMILY_INET6;
+
+    TestListener Listener(Registration, ListenerAcceptConnection, ServerConfiguration);
+    TEST_TRUE(Listener.IsValid());
+    QuicAddr ServerLocalAddr(QuicAddrFamily);
+    TEST_QUIC_SUCCEEDED(Listener.Start(Alpn, &ServerLocalAddr.SockAddr));
+    TEST_QUIC_SUCCEEDED(Listener.GetLocalAddr(ServerLocalAddr));
+
+    UniquePtr<TestConnection> Server;
+    ServerAcceptContext ServerAcceptCtx((TestConnection**)&Server);
+    Listener.Context = &ServerAcceptCtx;
+
+    TestConnection Client(Registration);
+    TEST_TRUE(Client.IsValid());
+
+    TEST_QUIC_SUCCEEDED(
+        Client.Start(
+            ClientConfiguration,
+            QuicAddrFamily,
+            QUIC_LOCALHOST_FOR_AF(
+                QuicAddrGetFamily(&ServerLocalAddr.SockAddr)),
+            ServerLocalAddr.GetPort()));
+
+    if (!Client.WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Client.GetIsConnected());
+
+    TEST_NOT_EQUAL(nullptr, Server);
+    if (!Server->WaitForConnectionComplete()) {
+        return;
+    }
+    TEST_TRUE(Server->GetIsConnected());
+
+    //
+    // The registration's workers own both connections and processed their
+    // handshakes.
+    //
+    uint32_t BufferLength = 0;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        MsQuic->GetParam(
+            Registration,
+            QUIC_PARAM_LEVEL_REGISTRATION,
+            QUIC_PARAM_REGISTRATION_WORKER_STATISTICS,
+            &BufferLength,
+            nullptr));
+    TEST_NOT_EQUAL(0u, BufferLength);
+    TEST_EQUAL(0u, BufferLength % sizeof(QUIC_WORKER_STATISTICS));
+
+    const uint32_t WorkerCount = BufferLength / sizeof(QUIC_WORKER_STATISTICS);
+    UniquePtr<QUIC_WORKER_STATISTICS[]> WorkerStats(new(std::nothrow) QUIC_WORKER_STATISTICS[WorkerCount]);
+    TEST_NOT_EQUAL(nullptr, WorkerStats.get());
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            Registration,
+            QUIC_PARAM_LEVEL_REGISTRATION,
+            QUIC_PARAM_REGISTRATION_WORKER_STATISTICS,
+            &BufferLength,
+            WorkerStats.get()));
+    TEST_EQUAL(WorkerCount * sizeof(QUIC_WORKER_STATISTICS), BufferLength);
+
+    uint32_t ConnectionCount = 0;
+    uint64_t ConnectionOperations = 0;
+    for (uint32_t i = 0; i < WorkerCount; ++i) {
+        ConnectionCount += WorkerStats[i].ConnectionCount;
+        ConnectionOperations += WorkerStats[i].ConnectionOperations;
+        TEST_TRUE(WorkerStats[i].ActiveTimeUs <= WorkerStats[i].TotalTimeUs);
+        TEST_TRUE(WorkerStats[i].TimerTimeUs <= WorkerStats[i].TotalTimeUs);
+    }
+    TEST_TRUE(ConnectionCount >= 2);
+    TEST_NOT_EQUAL(0u, ConnectionOperations);
+
+    //
+    // The listener's binding received the client's datagrams.
+    //
+    BufferLength = 0;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_BINDING_STATISTICS,
+            &BufferLength,
+            nullptr));
+    TEST_NOT_EQUAL(0u, BufferLength);
+
+    //
+    // Leave room for bindings created by other tests in the meantime.
+    //
+    const uint32_t BindingCount = BufferLength / sizeof(QUIC_BINDING_STATISTICS) + 8;
+    UniquePtr<QUIC_BINDING_STATISTICS[]> BindingStats(new(std::nothrow) QUIC_BINDING_STATISTICS[BindingCount]);
+    TEST_NOT_EQUAL(nullptr, BindingStats.get());
+    BufferLength = BindingCount * sizeof(QUIC_BINDING_STATISTICS);
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_BINDING_STATISTICS,
+            &BufferLength,
+            BindingStats.get()));
+
+    bool FoundListenerBinding = false;
+    for (uint32_t i = 0; i < BufferLength / sizeof(QUIC_BINDING_STATISTICS); ++i) {
+        if (BindingStats[i].ServerOwned &&
+            QuicAddrGetPort(&BindingStats[i].LocalAddress) == ServerLocalAddr.GetPort()) {
+            TEST_NOT_EQUAL(0u, BindingStats[i].Recv.Datagrams);
+            TEST_TRUE(BindingStats[i].Recv.Bytes >= BindingStats[i].Recv.Datagrams);
+            FoundListenerBinding = true;
+        }
+    }
+    TEST_TRUE(FoundListenerBinding);
+
+    //
+    // Each processor's counters add up to at least the two connections.
+    //
+    BufferLength = 0;
+    TEST_QUIC_STATUS(
+        QUIC_STATUS_BUFFER_TOO_SMALL,
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_PROCESSOR_PERF_COUNTERS,
+            &BufferLength,
+            nullptr));
+    TEST_EQUAL(0u, BufferLength % (sizeof(int64_t) * QUIC_PERF_COUNTER_MAX));
+
+    const uint32_t ProcessorCount = BufferLength / (sizeof(int64_t) * QUIC_PERF_COUNTER_MAX);
+    TEST_NOT_EQUAL(0u, ProcessorCount);
+    UniquePtr<int64_t[]> Counters(new(std::nothrow) int64_t[ProcessorCount * QUIC_PERF_COUNTER_MAX]);
+    TEST_NOT_EQUAL(nullptr, Counters.get());
+    TEST_QUIC_SUCCEEDED(
+        MsQuic->GetParam(
+            nullptr,
+            QUIC_PARAM_LEVEL_GLOBAL,
+            QUIC_PARAM_GLOBAL_PROCESSOR_PERF_COUNTERS,
+            &BufferLength,
+            Counters.get()));
+
+    int64_t ConnectionsCreated = 0;
+    for (uint32_t i = 0; i < ProcessorCount; ++i) {
+        ConnectionsCreated += Counters[i * QUIC_PERF_COUNTER_MAX + QUIC_PERF_COUNTER_CONN_CREATED];
+    }
+    TEST_TRUE(ConnectionsCreated >= 2);
+}
+
 void
 QuicTestInvalidAlpnLengths(
     void
@@ -542,6 +542,24 @@ TestConnection::GetStatistics()
     return value;
 }
 
+QUIC_STATISTICS_V2
+TestConnection::GetStatisticsV2()
+{
+    QUIC_STATISTICS_V2 value = {};
+    uint32_t valueSize = sizeof(value);
+    QUIC_STATUS Status =
+        MsQuic->GetParam(
+            QuicConnection,
+            QUIC_PARAM_LEVEL_CONNECTION,
+            QUIC_PARAM_CONN_STATISTICS_V2,
+            &valueSize,
+            &value);
+    if (QUIC_FAILED(Status)) {
+        TEST_FAILURE("MsQuic->GetParam(CONN_STATISTICS_V2) failed, 0x%x.", Status);
+    }
+    return value;
+}
+
 bool
 TestConnection::GetUseSendBuffer()
 {
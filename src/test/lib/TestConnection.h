@@ -250,6 +250,7 @@ public:
     uint16_t GetLocalUnidiStreamCount();
 
     QUIC_STATISTICS GetStatistics();
+    QUIC_STATISTICS_V2 GetStatisticsV2();
 
     bool GetUseSendBuffer();
     QUIC_STATUS SetUseSendBuffer(bool value);
@@ -35,12 +35,14 @@ static const char* IpAddress;
 static QUIC_ADDR ServerAddress;
 static uint64_t TimeoutMs = ATTACK_TIMEOUT_DEFAULT_MS;
 static uint32_t ThreadCount = ATTACK_THREADS_DEFAULT;
+static uint32_t ServerProcCount; // 0 unless -procs is specified.
 static const char* Alpn = "h3-29";
 static uint32_t Version = QUIC_VERSION_DRAFT_29;
 
 static uint64_t TimeStart;
 static int64_t TotalPacketCount;
 static int64_t TotalByteCount;
+static int64_t TotalResponseCount;
 
 void PrintUsage()
 {
@@ -48,7 +50,7 @@ void PrintUsage()
 
     printf("Usage:\n");
     printf("  quicattack.exe -list\n\n");
-    printf("  quicattack.exe -type:<number> -ip:<ip_address_and_port> [-alpn:<protocol_name>] [-sni:<host_name>] [-timeout:<ms>] [-threads:<count>]\n\n");
+    printf("  quicattack.exe -type:<number> -ip:<ip_address_and_port> [-alpn:<protocol_name>] [-sni:<host_name>] [-timeout:<ms>] [-threads:<count>] [-procs:<server_core_count>]\n\n");
 }
 
 void PrintUsageList()
@@ -59,6 +61,7 @@ void PrintUsageList()
     printf("#2 - Random UDP full length UDP packets.\n");
     printf("#3 - Random QUIC Initial packets.\n");
     printf("#4 - Valid QUIC initial packets.\n");
+    printf("#5 - Valid QUIC initial packets, measuring the server's response rate (also per core with -procs).\n");
 }
 
 struct StrBuffer
@@ -90,6 +93,19 @@ UdpRecvCallback(
     _In_ CXPLAT_RECV_DATA* RecvBufferChain
     )
 {
+    //
+    // Every long header packet back from the server (Retry, or Initial when
+    // retry isn't in use) means it processed one of our Initial packets.
+    //
+    int64_t ResponseCount = 0;
+    for (CXPLAT_RECV_DATA* Datagram = RecvBufferChain; Datagram != nullptr; Datagram = Datagram->Next) {
+        if (Datagram->BufferLength != 0 && (Datagram->Buffer[0] & 0x80)) {
+            ++ResponseCount;
+        }
+    }
+    if (ResponseCount != 0) {
+        InterlockedExchangeAdd64(&TotalResponseCount, ResponseCount);
+    }
     CxPlatRecvDataReturn(RecvBufferChain);
 }
 
@@ -322,6 +338,7 @@ CXPLAT_THREAD_CALLBACK(RunAttackThread, /* Context */)
         RunAttackRandom(Binding, QUIC_MIN_INITIAL_LENGTH, true);
         break;
     case 4:
+    case 5:
         RunAttackValidInitial(Binding);
         break;
     default:
@@ -362,6 +379,13 @@ void RunAttack()
     uint64_t TimeEnd = CxPlatTimeMs64();
     printf("Packet Rate: %llu KHz\n", (unsigned long long)(TotalPacketCount) / CxPlatTimeDiff64(TimeStart, TimeEnd));
     printf("Bit Rate: %llu mbps\n", (unsigned long long)(8 * TotalByteCount) / (1000 * CxPlatTimeDiff64(TimeStart, TimeEnd)));
+    if (AttackType == 5) {
+        uint64_t ResponseRate = (uint64_t)(1000 * TotalResponseCount) / CxPlatTimeDiff64(TimeStart, TimeEnd);
+        printf("Response Rate: %llu packets/s\n", (unsigned long long)ResponseRate);
+        if (ServerProcCount != 0) {
+            printf("Response Rate Per Server Core: %llu packets/s (%u cores)\n", (unsigned long long)(ResponseRate / ServerProcCount), ServerProcCount);
+        }
+    }
     CXPLAT_FREE(Threads, QUIC_POOL_TOOL);
 
     delete Writer;
@@ -403,7 +427,7 @@ main(
             goto Error;
         }
 
-        if (AttackType < 1 || AttackType > 4) {
+        if (AttackType < 1 || AttackType > 5) {
             printf("Invalid -type:'%u' specified!\n", AttackType);
             goto Error;
         }
@@ -413,6 +437,11 @@ main(
         TryGetValue(argc, argv, "sni", &ServerName);
         TryGetValue(argc, argv, "timeout", &TimeoutMs);
         TryGetValue(argc, argv, "threads", &ThreadCount);
+        if (TryGetValue(argc, argv, "procs", &ServerProcCount) &&
+            ServerProcCount == 0) {
+            printf("Invalid -procs:'%u' specified!\n", ServerProcCount);
+            goto Error;
+        }
 
         if (IpAddress == nullptr) {
             if (ServerName == nullptr) {
@@ -52,7 +52,7 @@ struct TlsContext
             CxPlatTlsSecConfigCreate(
                 &CredConfig, &TlsCallbacks, &SecConfig, OnSecConfigCreateComplete));
 
-        QUIC_CONNECTION Connection = {0};
+        QUIC_CONNECTION Connection = {};
 
         QUIC_TRANSPORT_PARAMETERS TP = {0};
         TP.Flags |= QUIC_TP_FLAG_INITIAL_MAX_DATA;
@@ -135,7 +135,8 @@ private:
                 &State);
         if (Result & CXPLAT_TLS_RESULT_PENDING) {
             CxPlatEventWaitForever(ProcessCompleteEvent);
-            Result = CxPlatTlsProcessDataComplete(Ptr, BufferLength);
+            uint32_t ProcessTimeUs;
+            Result = CxPlatTlsProcessDataComplete(Ptr, BufferLength, &ProcessTimeUs);
         }
 
         if (Result & CXPLAT_TLS_RESULT_ERROR) {
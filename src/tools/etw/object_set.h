@@ -11,15 +11,23 @@ Abstract:
     currently using the pointer address; otherwise it's 'inactive' meaning it is
     no longer using that pointer (because it was freed).
 
+    Shared by quicetw and quicring.
+
 --*/
 
 #include <quic_platform.h>
+#include <quic_hashtable.h>
 #include <stdio.h>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#define __cdecl
+#endif
 
-inline ULONG HashPtr(ULONG64 ObjPtr)
+inline uint32_t HashPtr(uint64_t ObjPtr)
 {
-    ULONG H = 0;
-    for (ULONG i = 0; i < sizeof(ObjPtr); i++) {
+    uint32_t H = 0;
+    for (uint32_t i = 0; i < sizeof(ObjPtr); i++) {
         H = (H<<5) + (H<<2) + H + ((ObjPtr>>i)&0xff); // H*37 + NextByte
     }
     return H|0x80000000;
@@ -28,8 +36,8 @@ inline ULONG HashPtr(ULONG64 ObjPtr)
 typedef struct _OBJECT {
     CXPLAT_HASHTABLE_ENTRY ActiveEntry;
     struct _OBJECT* InactiveNext;
-    ULONG Id;
-    ULONG64 Ptr;
+    uint32_t Id;
+    uint64_t Ptr;
 } OBJECT;
 
 typedef
@@ -42,7 +50,7 @@ typedef struct _OBJECT_SET {
     OBJECT_FREE_FN FreeFn;
     CXPLAT_HASHTABLE* Active;
     OBJECT* Inactive;
-    ULONG NextId;
+    uint32_t NextId;
 } OBJECT_SET;
 
 inline void ObjectSetCreate(_Inout_ OBJECT_SET* Set)
@@ -74,7 +82,7 @@ inline void ObjectSetDestroy(_Inout_ OBJECT_SET* Set)
             CxPlatHashtableEnumerateEnd(Set->Active, &Enumerator);
             break;
         }
-        Obj = CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
+        Obj = CXPLAT_CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
         CxPlatHashtableRemove(Set->Active, &Obj->ActiveEntry, NULL);
         Set->FreeFn(Obj);
     }
@@ -85,7 +93,7 @@ inline void ObjectSetDestroy(_Inout_ OBJECT_SET* Set)
         Set->FreeFn(Obj);
     }
 
-    ZeroMemory(Set, sizeof(*Set));
+    CxPlatZeroMemory(Set, sizeof(*Set));
 }
 
 inline void ObjectSetReset(_Inout_ OBJECT_SET* Set)
@@ -94,7 +102,7 @@ inline void ObjectSetReset(_Inout_ OBJECT_SET* Set)
     ObjectSetCreate(Set);
 }
 
-inline OBJECT* ObjectSetGetActive(_Inout_ OBJECT_SET* Set, ULONG64 ObjPtr)
+inline OBJECT* ObjectSetGetActive(_Inout_ OBJECT_SET* Set, uint64_t ObjPtr)
 {
     CXPLAT_HASHTABLE_ENTRY* Entry;
     CXPLAT_HASHTABLE_LOOKUP_CONTEXT Ctx;
@@ -102,7 +110,7 @@ inline OBJECT* ObjectSetGetActive(_Inout_ OBJECT_SET* Set, ULONG64 ObjPtr)
 
     Entry = CxPlatHashtableLookup(Set->Active, HashPtr(ObjPtr), &Ctx);
     while (Entry != NULL) {
-        OBJECT* o = CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
+        OBJECT* o = CXPLAT_CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
         if (o->Ptr == ObjPtr) {
             Obj = o;
             break;
@@ -117,7 +125,7 @@ inline void ObjectSetAddActive(_Inout_ OBJECT_SET* Set, _In_ OBJECT* Obj)
     CxPlatHashtableInsert(Set->Active, &Obj->ActiveEntry, HashPtr(Obj->Ptr), NULL);
 }
 
-inline OBJECT* ObjectSetRemoveActive(_Inout_ OBJECT_SET* Set, ULONG64 ObjPtr)
+inline OBJECT* ObjectSetRemoveActive(_Inout_ OBJECT_SET* Set, uint64_t ObjPtr)
 {
     OBJECT* Obj = ObjectSetGetActive(Set, ObjPtr);
     if (Obj != NULL) {
@@ -128,7 +136,7 @@ inline OBJECT* ObjectSetRemoveActive(_Inout_ OBJECT_SET* Set, ULONG64 ObjPtr)
     return Obj;
 }
 
-inline OBJECT* ObjectSetGetId(_Inout_ OBJECT_SET* Set, ULONG Id)
+inline OBJECT* ObjectSetGetId(_Inout_ OBJECT_SET* Set, uint32_t Id)
 {
     CXPLAT_HASHTABLE_ENUMERATOR Enumerator;
     CXPLAT_HASHTABLE_ENTRY* Entry;
@@ -140,7 +148,7 @@ inline OBJECT* ObjectSetGetId(_Inout_ OBJECT_SET* Set, ULONG Id)
             CxPlatHashtableEnumerateEnd(Set->Active, &Enumerator);
             break;
         }
-        OBJECT* Obj = CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
+        OBJECT* Obj = CXPLAT_CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
         if (Obj->Id == Id) {
             CxPlatHashtableEnumerateEnd(Set->Active, &Enumerator);
             return Obj;
@@ -170,7 +178,7 @@ inline OBJECT** ObjectSetSort(_Inout_ OBJECT_SET* Set, _In_opt_ int (__cdecl * C
     // default sort is by ID, which is cheap (O(n)), and then we re-sort if the
     // user requested a different sort order.
 
-    ObjArray = malloc(Set->NextId * sizeof(OBJECT*));
+    ObjArray = (OBJECT**)malloc(Set->NextId * sizeof(OBJECT*));
     if (ObjArray == NULL) {
         printf("Out of memory\n");
         exit(1);
@@ -183,7 +191,7 @@ inline OBJECT** ObjectSetSort(_Inout_ OBJECT_SET* Set, _In_opt_ int (__cdecl * C
             CxPlatHashtableEnumerateEnd(Set->Active, &Enumerator);
             break;
         }
-        Obj = CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
+        Obj = CXPLAT_CONTAINING_RECORD(Entry, OBJECT, ActiveEntry);
         ObjArray[Obj->Id] = Obj;
     }
 
@@ -91,7 +91,8 @@ const char* ApiTypeStr[] = {
     "STREAM_SEND",
     "STREAM_RECEIVE_COMPLETE",
     "STREAM_RECEIVE_SET_ENABLED",
-    "DATAGRAM_SEND"
+    "DATAGRAM_SEND",
+    "STREAM_SEND_BATCH"
 };
 
 CXPLAT_STATIC_ASSERT(ARRAYSIZE(ApiTypeStr) == QUIC_API_COUNT, "Keep the count in sync with array");
@@ -296,6 +297,18 @@ QuicTraceGlobalEvent(
             case QUIC_PERF_COUNTER_WORK_OPER_COMPLETED:
                 printf("    Total worker operations processed ever:             ");
                 break;
+            case QUIC_PERF_COUNTER_CONN_ADMIT_RETRY:
+                printf("    Total connection attempts retried by admission:     ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_ADMIT_LIMITED:
+                printf("    Total connection attempts prefix rate limited:      ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_ADMIT_DROPPED:
+                printf("    Total connection attempts dropped by admission:     ");
+                break;
+            case QUIC_PERF_COUNTER_CONN_0RTT_REPLAY_REJECT:
+                printf("    Total tickets rejected by 0-RTT anti-replay:        ");
+                break;
             default:
                 printf("    Unknown:                                            ");
                 break;
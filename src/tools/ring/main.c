@@ -0,0 +1,661 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+--*/
+
+#include "quicring.h"
+
+#define USAGE \
+"QUIC Event Ring Analyzer\n" \
+"\n" \
+"quicring <f.ring> [--csv] [command]\n" \
+"\n" \
+"Options:\n" \
+"  --csv, Outputs lists and samples in comma separated vector format\n" \
+"\n" \
+"General Commands:\n" \
+"  --help, Shows the help text\n" \
+"  --summary, Shows general dump and event information (default)\n" \
+"  --report, Generates a report of the system in the trace\n" \
+"  --trace [--ptr <hex>|--thread <tid>] [--top <num>], Converts all events to text\n" \
+"\n" \
+"Connection Commands:\n" \
+"  --conn [--sort <type>|--id <num>] [--top <num>]\n" \
+"  --conn_list [--sort <type>] [--top <num>]\n" \
+"  --conn_tput [--sort <type>|--id <num>] [--reso <ms>] [--top <num>]\n" \
+"\n" \
+"Stream Commands:\n" \
+"  --stream_list [--top <num>]\n" \
+"\n" \
+"Worker Commands:\n" \
+"  --worker [--sort <type>|--id <num>] [--top <num>]\n" \
+"  --worker_list [--sort <type>] [--top <num>]\n" \
+"  --worker_queue [--sort <type>|--id <num>] [--reso <ms>] [--top <num>]\n" \
+"  --flame [--id <num>], Worker time per operation type, as collapsed stacks\n" \
+"\n" \
+"Command Options:\n" \
+"  --sort <type>, Specifies a sorting order\n" \
+"         {age,cpu_active,cpu_queued,cpu_idle,tx,rx,lost,conn_count}\n" \
+"  --id <num>, Number from the output of --conn_list or --worker_list\n" \
+"  --ptr <hex>, Only events about the object at this address\n" \
+"  --thread <tid>, Only events raised by this thread\n" \
+"  --top <num>, Limits the number of output lines\n" \
+"  --reso <ms>, Sample resolution in milliseconds (default 100)\n" \
+"\n" \
+"Dumps are written by processes built with QUIC_ENABLE_RING_TRACING, on\n" \
+"assert or when QUIC_PARAM_GLOBAL_TRACE_RING_DUMP is set.\n"
+
+RING_CMD_ARGS Cmd = {
+    COMMAND_SUMMARY,
+    SORT_NONE,
+    FALSE,
+    0,
+    0,
+    0,
+    UINT64_MAX,
+    100 * NS_PER_MS
+};
+
+static const char* const SortTypeNames[] = {
+    NULL, "age", "cpu_active", "cpu_queued", "cpu_idle", "tx", "rx", "lost", "conn_count"
+};
+
+RING_TRACE Trace;
+
+void
+PrintTime(
+    _In_ uint64_t TimeNs
+    )
+{
+    printf("%llu.%03llu ms",
+        (unsigned long long)(TimeNs / NS_PER_MS),
+        (unsigned long long)((TimeNs / 1000) % 1000));
+}
+
+void
+PrintCpuTime(
+    _In_ const RING_CPU_TIME* Time
+    )
+{
+    PrintTime(Time->TotalNs);
+    printf(" (avg %llu us, min %llu us, max %llu us)\n",
+        (unsigned long long)(Time->Count == 0 ? 0 : Time->TotalNs / Time->Count / NS_PER_US),
+        (unsigned long long)(Time->MinNs / NS_PER_US),
+        (unsigned long long)(Time->MaxNs / NS_PER_US));
+}
+
+uint64_t
+ObjectAge(
+    _In_ const RING_OBJECT* Obj
+    )
+{
+    return
+        (Obj->DestroyedTimeNs != 0 ? Obj->DestroyedTimeNs : Trace.StopTimeNs) -
+        Obj->FirstTimeNs;
+}
+
+static
+void
+PrintEvent(
+    _In_ const RING_EVENT* Event
+    )
+{
+    char Message[2048];
+    RingEventFormat(Event, Message, sizeof(Message));
+    printf("[%6u][", Event->ThreadId);
+    PrintTime(Event->TimeNs - Trace.StartTimeNs);
+    printf("] %s\n", Message);
+}
+
+static
+void
+CommandSummary(
+    void
+    )
+{
+    printf("Process:     %u\n", Trace.Header.ProcessId);
+    printf("Events:      %llu\n", (unsigned long long)Trace.EventCount);
+    printf("Duration:    ");
+    PrintTime(Trace.StopTimeNs - Trace.StartTimeNs);
+    printf("\nDump delay:  ");
+    PrintTime(Trace.Header.DumpTimeNs > Trace.StopTimeNs ? Trace.Header.DumpTimeNs - Trace.StopTimeNs : 0);
+    printf(" (after the last event)\n");
+
+    printf("\n  Thread   Ring KB    Events  Covers\n");
+    for (uint32_t i = 0; i < Trace.ThreadCount; ++i) {
+        const RING_THREAD* Thread = &Trace.Threads[i];
+        if (Thread->EventCount == 0) {
+            continue;
+        }
+        printf("%8u %9u %9llu  ", Thread->ThreadId, Thread->RingSize / 1024,
+            (unsigned long long)Thread->EventCount);
+        PrintTime(Thread->LastTimeNs - Thread->FirstTimeNs);
+        printf("\n");
+    }
+
+    printf("\n   Count  Event\n");
+    for (uint32_t i = 0; i <= UINT16_MAX; ++i) {
+        const RING_EVENT_TYPE* Type = Trace.TypeById[i];
+        if (Type != NULL && Type->Count != 0) {
+            printf("%8llu  %s\n", (unsigned long long)Type->Count, Type->Name);
+        }
+    }
+
+    printf("\nConnections: %u\nStreams:     %u\nWorkers:     %u\n",
+        RingObjectSetCount(&Conns), RingObjectSetCount(&Streams), RingObjectSetCount(&Workers));
+}
+
+static
+void
+CommandTrace(
+    void
+    )
+{
+    uint64_t Count = 0;
+    for (uint64_t i = 0; i < Trace.EventCount && Count < Cmd.Top; ++i) {
+        const RING_EVENT* Event = &Trace.Events[i];
+        if ((Cmd.ThreadId != 0 && Event->ThreadId != Cmd.ThreadId) ||
+            (Cmd.Ptr != 0 && RingEventGetObject(Event) != Cmd.Ptr)) {
+            continue;
+        }
+        PrintEvent(Event);
+        Count++;
+    }
+}
+
+static
+int
+CompareConns(
+    const void* Conn1,
+    const void* Conn2
+    )
+{
+    const RING_CONN* a = *(const RING_CONN**)Conn1;
+    const RING_CONN* b = *(const RING_CONN**)Conn2;
+    uint64_t A, B;
+    switch (Cmd.Sort) {
+    case SORT_AGE:
+        A = ObjectAge(&a->Obj); B = ObjectAge(&b->Obj); break;
+    case SORT_CPU_ACTIVE:
+        A = a->SchedulingStats[RING_SCHEDULE_PROCESSING].TotalNs;
+        B = b->SchedulingStats[RING_SCHEDULE_PROCESSING].TotalNs; break;
+    case SORT_CPU_QUEUED:
+        A = a->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs;
+        B = b->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs; break;
+    case SORT_CPU_IDLE:
+        A = a->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs;
+        B = b->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs; break;
+    case SORT_TX:
+        A = a->BytesSent; B = b->BytesSent; break;
+    case SORT_RX:
+        A = a->BytesRecv; B = b->BytesRecv; break;
+    case SORT_LOST:
+        A = a->PacketsLost; B = b->PacketsLost; break;
+    default:
+        A = b->Obj.Base.Id; B = a->Obj.Base.Id; break;
+    }
+    return (A > B) ? -1 : ((A == B) ? 0 : 1);
+}
+
+static
+int
+CompareWorkers(
+    const void* Worker1,
+    const void* Worker2
+    )
+{
+    const RING_WORKER* a = *(const RING_WORKER**)Worker1;
+    const RING_WORKER* b = *(const RING_WORKER**)Worker2;
+    uint64_t A, B;
+    switch (Cmd.Sort) {
+    case SORT_AGE:
+        A = ObjectAge(&a->Obj); B = ObjectAge(&b->Obj); break;
+    case SORT_CPU_ACTIVE:
+        A = a->ActiveNs; B = b->ActiveNs; break;
+    case SORT_CPU_QUEUED:
+        A = a->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs;
+        B = b->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs; break;
+    case SORT_CPU_IDLE:
+        A = a->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs;
+        B = b->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs; break;
+    case SORT_CONN_COUNT:
+        A = a->TotalCxnCount; B = b->TotalCxnCount; break;
+    default:
+        A = b->Obj.Base.Id; B = a->Obj.Base.Id; break;
+    }
+    return (A > B) ? -1 : ((A == B) ? 0 : 1);
+}
+
+//
+// Returns the objects in the requested sort order (NULL terminated).
+//
+static
+RING_OBJECT**
+SortObjects(
+    _In_ const RING_OBJECT_SET* Set,
+    _In_ int (*CompareFn)(const void*, const void*)
+    )
+{
+    RING_OBJECT** Array = RingObjectSetToArray(Set);
+    qsort(Array, RingObjectSetCount(Set), sizeof(RING_OBJECT*), CompareFn);
+    return Array;
+}
+
+static
+const char*
+ConnState(
+    _In_ const RING_CONN* Conn
+    )
+{
+    if (Conn->ShutdownSeen) {
+        return "shutdown";
+    } else if (Conn->HandshakeTimeNs != 0) {
+        return "connected";
+    } else if (Conn->HandshakeStarted) {
+        return "handshake";
+    } else if (Conn->CreateSeen) {
+        return "created";
+    }
+    return "unknown";
+}
+
+static
+void
+PrintShutdown(
+    _In_ const RING_CONN* Conn
+    )
+{
+    if (!Conn->ShutdownSeen) {
+        printf("-");
+    } else {
+        printf("%s %s 0x%llx",
+            Conn->ShutdownByPeer ? "peer" : "local",
+            Conn->ShutdownByApp ? "app" : "transport",
+            (unsigned long long)Conn->ShutdownErrorCode);
+    }
+}
+
+static
+void
+CommandConnList(
+    void
+    )
+{
+    RING_OBJECT** Array = SortObjects(&Conns, CompareConns);
+
+    if (Cmd.FormatCSV) {
+        printf("ID,Type,State,Age(us),Active(us),Queued(us),Idle(us),TX,RX,SRtt(us),PktsSent,PktsLost\n");
+    } else {
+        printf("     ID  Type    State        Age (ms)  Active (us)  Queued (us)    Idle (us)      Tx (B)      Rx (B)  SRtt (us)  Pkts Sent  Pkts Lost  Shutdown\n");
+    }
+    for (uint32_t i = 0; Array[i] != NULL && i < Cmd.Top; ++i) {
+        const RING_CONN* Conn = (const RING_CONN*)Array[i];
+        const uint64_t Age = ObjectAge(&Conn->Obj);
+        if (Cmd.FormatCSV) {
+            printf("%u,%s,%s,%llu,%llu,%llu,%llu,%llu,%llu,%u,%llu,%llu\n",
+                Conn->Obj.Base.Id,
+                Conn->IsServer ? "server" : "client",
+                ConnState(Conn),
+                (unsigned long long)(Age / NS_PER_US),
+                (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_PROCESSING].TotalNs / NS_PER_US),
+                (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs / NS_PER_US),
+                (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs / NS_PER_US),
+                (unsigned long long)Conn->BytesSent,
+                (unsigned long long)Conn->BytesRecv,
+                Conn->SmoothedRttUs,
+                (unsigned long long)Conn->PacketsSent,
+                (unsigned long long)Conn->PacketsLost);
+            continue;
+        }
+        printf("%7u  %-6s  %-9s %11llu %12llu %12llu %12llu %11llu %11llu %10u %10llu %10llu  ",
+            Conn->Obj.Base.Id,
+            Conn->IsServer ? "server" : "client",
+            ConnState(Conn),
+            (unsigned long long)(Age / NS_PER_MS),
+            (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_PROCESSING].TotalNs / NS_PER_US),
+            (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs / NS_PER_US),
+            (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_IDLE].TotalNs / NS_PER_US),
+            (unsigned long long)Conn->BytesSent,
+            (unsigned long long)Conn->BytesRecv,
+            Conn->SmoothedRttUs,
+            (unsigned long long)Conn->PacketsSent,
+            (unsigned long long)Conn->PacketsLost);
+        PrintShutdown(Conn);
+        printf("\n");
+    }
+
+    free(Array);
+}
+
+static
+void
+CommandConn(
+    void
+    )
+{
+    const RING_CONN* Conn = (const RING_CONN*)RingObjectSetGetId(&Conns, Cmd.Id);
+    if (Conn == NULL) {
+        printf("No connection with ID %u\n", Cmd.Id);
+        return;
+    }
+
+    printf("Connection %u (0x%llx)\n", Conn->Obj.Base.Id, (unsigned long long)Conn->Obj.Base.Ptr);
+    printf("  Type:            %s\n", Conn->IsServer ? "server" : "client");
+    printf("  State:           %s\n", ConnState(Conn));
+    printf("  CorrelationId:   %llu\n", (unsigned long long)Conn->CorrelationId);
+    printf("  Created:         %s\n", Conn->CreateSeen ? "yes" : "before the trace");
+    printf("  Destroyed:       %s\n", Conn->Obj.DestroyedTimeNs != 0 ? "yes" : "no");
+    printf("  Age:             ");
+    PrintTime(ObjectAge(&Conn->Obj));
+    printf("\n  Handshake:       ");
+    if (Conn->HandshakeTimeNs != 0) {
+        PrintTime(Conn->HandshakeTimeNs);
+    } else {
+        printf("not complete");
+    }
+    printf("\n  Worker:          0x%llx", (unsigned long long)Conn->WorkerPtr);
+    if (Conn->Worker != NULL) {
+        printf(" (id %u)", Conn->Worker->Obj.Base.Id);
+    }
+    printf("\n  Operations:      %llu\n", (unsigned long long)Conn->Operations);
+    printf("  CPU\n");
+    printf("    Processing     "); PrintCpuTime(&Conn->SchedulingStats[RING_SCHEDULE_PROCESSING]);
+    printf("    Queued         "); PrintCpuTime(&Conn->SchedulingStats[RING_SCHEDULE_QUEUED]);
+    printf("    Idle           "); PrintCpuTime(&Conn->SchedulingStats[RING_SCHEDULE_IDLE]);
+    printf("  Tx:              %llu bytes, %llu packets, %llu lost\n",
+        (unsigned long long)Conn->BytesSent,
+        (unsigned long long)Conn->PacketsSent,
+        (unsigned long long)Conn->PacketsLost);
+    printf("  Rx:              %llu bytes, %llu packets, %llu dropped\n",
+        (unsigned long long)Conn->BytesRecv,
+        (unsigned long long)Conn->PacketsRecv,
+        (unsigned long long)Conn->PacketsDropped);
+    printf("  SRtt:            %u us\n", Conn->SmoothedRttUs);
+    printf("  CWnd:            %u bytes\n", Conn->CongestionWindow);
+    printf("  Congestion:      %llu events | %llu (persistent)\n",
+        (unsigned long long)Conn->CongestionEvents,
+        (unsigned long long)Conn->PersistentCongestionEvents);
+    printf("  Shutdown:        ");
+    PrintShutdown(Conn);
+    printf("\n\n");
+
+    const uint64_t EndTimeNs =
+        Conn->Obj.DestroyedTimeNs != 0 ? Conn->Obj.DestroyedTimeNs : Trace.StopTimeNs;
+    uint64_t Count = 0;
+    for (uint64_t i = 0; i < Trace.EventCount && Count < Cmd.Top; ++i) {
+        const RING_EVENT* Event = &Trace.Events[i];
+        if (Event->TimeNs >= Conn->Obj.FirstTimeNs &&
+            Event->TimeNs <= EndTimeNs &&
+            RingEventGetObject(Event) == Conn->Obj.Base.Ptr) {
+            PrintEvent(Event);
+            Count++;
+        }
+    }
+}
+
+static
+void
+CommandStreamList(
+    void
+    )
+{
+    printf("     ID  Stream ID  Local      Age (ms)  Events  Conn\n");
+    uint64_t Count = 0;
+    for (const RING_OBJECT* Obj = Streams.First; Obj != NULL && Count < Cmd.Top; Obj = Obj->Next) {
+        const RING_STREAM* Stream = (const RING_STREAM*)Obj;
+        printf("%7u %10llu  %-5s %13llu %7llu  0x%llx\n",
+            Obj->Base.Id,
+            (unsigned long long)Stream->StreamId,
+            Stream->IsLocal ? "yes" : "no",
+            (unsigned long long)(ObjectAge(Obj) / NS_PER_MS),
+            (unsigned long long)Obj->EventCount,
+            (unsigned long long)Stream->ConnPtr);
+        Count++;
+    }
+}
+
+static
+void
+PrintWorker(
+    _In_ const RING_WORKER* Worker
+    )
+{
+    const uint64_t Age = ObjectAge(&Worker->Obj);
+    printf(
+        Cmd.FormatCSV ?
+            "%u,%u,%hu,%u,%llu,%llu,%llu,%llu,%llu,%u\n" :
+            "%7u %8u %6hu %6u %12llu %7llu%% %11llu %11llu %10llu %10u\n",
+        Worker->Obj.Base.Id,
+        Worker->ThreadId,
+        Worker->IdealProcessor,
+        Worker->TotalCxnCount,
+        (unsigned long long)(Age / NS_PER_MS),
+        (unsigned long long)(Age == 0 ? 0 : (100 * Worker->ActiveNs) / Age),
+        (unsigned long long)Worker->Operations,
+        (unsigned long long)(Worker->SchedulingStats[RING_SCHEDULE_QUEUED].TotalNs / NS_PER_US),
+        (unsigned long long)(Worker->QueueDelayCount == 0 ? 0 : Worker->QueueDelaySumUs / Worker->QueueDelayCount),
+        Worker->QueueDelayMaxUs);
+}
+
+static
+void
+PrintWorkerHeader(
+    void
+    )
+{
+    if (Cmd.FormatCSV) {
+        printf("ID,Thread,IdealProc,CxnCount,Age(ms),Active(%%),Operations,ConnQueued(us),AvgDelay(us),MaxDelay(us)\n");
+    } else {
+        printf("     ID   Thread   Proc  Conns     Age (ms)  Active  Operations  Queued (us)  Delay (us)  Max (us)\n");
+    }
+}
+
+static
+void
+CommandWorkerList(
+    void
+    )
+{
+    RING_OBJECT** Array = SortObjects(&Workers, CompareWorkers);
+    PrintWorkerHeader();
+    for (uint32_t i = 0; Array[i] != NULL && i < Cmd.Top; ++i) {
+        PrintWorker((const RING_WORKER*)Array[i]);
+    }
+    free(Array);
+}
+
+static
+void
+CommandWorker(
+    void
+    )
+{
+    const RING_WORKER* Worker = (const RING_WORKER*)RingObjectSetGetId(&Workers, Cmd.Id);
+    if (Worker == NULL) {
+        printf("No worker with ID %u\n", Cmd.Id);
+        return;
+    }
+
+    printf("Worker %u (0x%llx)\n\n", Worker->Obj.Base.Id, (unsigned long long)Worker->Obj.Base.Ptr);
+    PrintWorkerHeader();
+    PrintWorker(Worker);
+
+    printf("\nConnection CPU\n");
+    printf("  Processing  "); PrintCpuTime(&Worker->SchedulingStats[RING_SCHEDULE_PROCESSING]);
+    printf("  Queued      "); PrintCpuTime(&Worker->SchedulingStats[RING_SCHEDULE_QUEUED]);
+    printf("  Idle        "); PrintCpuTime(&Worker->SchedulingStats[RING_SCHEDULE_IDLE]);
+
+    //
+    // Where the worker's active time went.
+    //
+    uint64_t OperNs = 0;
+    for (uint32_t i = RING_OPER_NONE + 1; i < RING_OPER_COUNT; ++i) {
+        OperNs += Worker->OperNs[i];
+    }
+    printf("\nActive time by operation\n");
+    printf("        Count     Time (us)  Share  Operation\n");
+    for (uint32_t i = RING_OPER_NONE + 1; i < RING_OPER_COUNT; ++i) {
+        if (Worker->OperCount[i] == 0) {
+            continue;
+        }
+        printf("%13llu %13llu %5llu%%  %s\n",
+            (unsigned long long)Worker->OperCount[i],
+            (unsigned long long)(Worker->OperNs[i] / NS_PER_US),
+            (unsigned long long)(Worker->ActiveNs == 0 ? 0 : (100 * Worker->OperNs[i]) / Worker->ActiveNs),
+            RingOperName(i));
+    }
+    const uint64_t OtherNs = Worker->ActiveNs > OperNs ? Worker->ActiveNs - OperNs : 0;
+    printf("%13s %13llu %5llu%%  %s\n", "-",
+        (unsigned long long)(OtherNs / NS_PER_US),
+        (unsigned long long)(Worker->ActiveNs == 0 ? 0 : (100 * OtherNs) / Worker->ActiveNs),
+        RingOperName(RING_OPER_NONE));
+
+    printf("\nConnections assigned to the worker:\n");
+    printf("     ID  Type    Operations  Active (us)\n");
+    uint64_t Count = 0;
+    for (const RING_OBJECT* Obj = Conns.First; Obj != NULL && Count < Cmd.Top; Obj = Obj->Next) {
+        const RING_CONN* Conn = (const RING_CONN*)Obj;
+        if (Conn->WorkerPtr == Worker->Obj.Base.Ptr) {
+            printf("%7u  %-6s %11llu %12llu\n",
+                Obj->Base.Id,
+                Conn->IsServer ? "server" : "client",
+                (unsigned long long)Conn->Operations,
+                (unsigned long long)(Conn->SchedulingStats[RING_SCHEDULE_PROCESSING].TotalNs / NS_PER_US));
+            Count++;
+        }
+    }
+}
+
+//
+// For the single object commands, picks the first object in the requested
+// sort order if no ID was given.
+//
+static
+BOOLEAN
+SelectObject(
+    void
+    )
+{
+    const BOOLEAN IsConn =
+        Cmd.Command == COMMAND_CONN || Cmd.Command == COMMAND_CONN_TPUT;
+    const BOOLEAN IsWorker =
+        Cmd.Command == COMMAND_WORKER || Cmd.Command == COMMAND_WORKER_QUEUE;
+    if ((!IsConn && !IsWorker) || Cmd.Id != 0) {
+        return TRUE;
+    }
+    if (Cmd.Sort == SORT_NONE) {
+        printf("--id or --sort is required\n");
+        return FALSE;
+    }
+
+    const RING_OBJECT_SET* Set = IsConn ? &Conns : &Workers;
+    if (RingObjectSetCount(Set) == 0) {
+        printf("No %s found in the trace\n", IsConn ? "connections" : "workers");
+        return FALSE;
+    }
+    RING_OBJECT** Array = SortObjects(Set, IsConn ? CompareConns : CompareWorkers);
+    Cmd.Id = Array[0]->Base.Id;
+    free(Array);
+    return TRUE;
+}
+
+int
+main(
+    _In_ int argc,
+    _In_reads_(argc) _Null_terminated_ char* argv[]
+    )
+{
+    if (argc < 2 || strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-?") == 0) {
+        printf(USAGE);
+        return 0;
+    }
+
+    for (int i = 2; i < argc; ++i) {
+        const char* Arg = argv[i];
+        const char* Value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(Arg, "--csv") == 0) {
+            Cmd.FormatCSV = TRUE;
+        } else if (strcmp(Arg, "--summary") == 0) {
+            Cmd.Command = COMMAND_SUMMARY;
+        } else if (strcmp(Arg, "--report") == 0) {
+            Cmd.Command = COMMAND_REPORT;
+        } else if (strcmp(Arg, "--trace") == 0) {
+            Cmd.Command = COMMAND_TRACE;
+        } else if (strcmp(Arg, "--conn") == 0) {
+            Cmd.Command = COMMAND_CONN;
+        } else if (strcmp(Arg, "--conn_list") == 0) {
+            Cmd.Command = COMMAND_CONN_LIST;
+        } else if (strcmp(Arg, "--conn_tput") == 0) {
+            Cmd.Command = COMMAND_CONN_TPUT;
+        } else if (strcmp(Arg, "--stream_list") == 0) {
+            Cmd.Command = COMMAND_STREAM_LIST;
+        } else if (strcmp(Arg, "--worker") == 0) {
+            Cmd.Command = COMMAND_WORKER;
+        } else if (strcmp(Arg, "--worker_list") == 0) {
+            Cmd.Command = COMMAND_WORKER_LIST;
+        } else if (strcmp(Arg, "--worker_queue") == 0) {
+            Cmd.Command = COMMAND_WORKER_QUEUE;
+        } else if (strcmp(Arg, "--flame") == 0) {
+            Cmd.Command = COMMAND_FLAME;
+        } else if (Value == NULL) {
+            printf("Invalid or incomplete option: %s\n", Arg);
+            return 1;
+        } else if (strcmp(Arg, "--sort") == 0) {
+            Cmd.Sort = SORT_NONE;
+            for (uint32_t j = SORT_AGE; j < ARRAYSIZE(SortTypeNames); ++j) {
+                if (strcmp(Value, SortTypeNames[j]) == 0) {
+                    Cmd.Sort = (RING_SORT_TYPE)j;
+                }
+            }
+            if (Cmd.Sort == SORT_NONE) {
+                printf("Invalid sort type: %s\n", Value);
+                return 1;
+            }
+            ++i;
+        } else if (strcmp(Arg, "--id") == 0) {
+            Cmd.Id = (uint32_t)strtoul(Value, NULL, 10);
+            ++i;
+        } else if (strcmp(Arg, "--ptr") == 0) {
+            Cmd.Ptr = strtoull(Value, NULL, 16);
+            ++i;
+        } else if (strcmp(Arg, "--thread") == 0) {
+            Cmd.ThreadId = (uint32_t)strtoul(Value, NULL, 10);
+            ++i;
+        } else if (strcmp(Arg, "--top") == 0) {
+            Cmd.Top = strtoull(Value, NULL, 10);
+            ++i;
+        } else if (strcmp(Arg, "--reso") == 0) {
+            Cmd.ResolutionNs = strtoull(Value, NULL, 10) * NS_PER_MS;
+            ++i;
+        } else {
+            printf("Invalid option: %s\n", Arg);
+            return 1;
+        }
+    }
+
+    if (!RingTraceOpen(argv[1], &Trace)) {
+        return 1;
+    }
+    RingObjectsProcess(&Trace);
+
+    if (SelectObject()) {
+        switch (Cmd.Command) {
+        case COMMAND_SUMMARY:       CommandSummary(); break;
+        case COMMAND_REPORT:        CommandReport(); break;
+        case COMMAND_TRACE:         CommandTrace(); break;
+        case COMMAND_CONN:          CommandConn(); break;
+        case COMMAND_CONN_LIST:     CommandConnList(); break;
+        case COMMAND_CONN_TPUT:     CommandConnTput(); break;
+        case COMMAND_STREAM_LIST:   CommandStreamList(); break;
+        case COMMAND_WORKER:        CommandWorker(); break;
+        case COMMAND_WORKER_LIST:   CommandWorkerList(); break;
+        case COMMAND_WORKER_QUEUE:  CommandWorkerQueue(); break;
+        case COMMAND_FLAME:         CommandFlame(); break;
+        }
+    }
+
+    RingTraceClose(&Trace);
+    return 0;
+}
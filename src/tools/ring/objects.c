@@ -0,0 +1,626 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Connection, stream and worker models, built from the events in the trace.
+
+    Objects are identified by pointers, which are reused once an object is
+    freed, so a creation event always starts a new object. Objects whose
+    creation was already overwritten in the ring (or happened before the
+    trace) start at their first event instead.
+
+    Worker time is attributed to the operation the worker thread was last
+    seen executing (ConnExec*Oper), until the next one starts, the connection
+    leaves the processing state or the worker goes idle.
+
+--*/
+
+#include "quicring.h"
+
+//
+// External definitions of the object_set.h inline functions (C99 requires
+// one, see src/platform/inline.c).
+//
+
+uint32_t
+HashPtr(
+    uint64_t ObjPtr
+    );
+
+void
+ObjectSetCreate(
+    _Inout_ OBJECT_SET* Set
+    );
+
+OBJECT*
+ObjectSetGetActive(
+    _Inout_ OBJECT_SET* Set,
+    uint64_t ObjPtr
+    );
+
+void
+ObjectSetAddActive(
+    _Inout_ OBJECT_SET* Set,
+    _In_ OBJECT* Obj
+    );
+
+OBJECT*
+ObjectSetRemoveActive(
+    _Inout_ OBJECT_SET* Set,
+    uint64_t ObjPtr
+    );
+
+OBJECT*
+ObjectSetGetId(
+    _Inout_ OBJECT_SET* Set,
+    uint32_t Id
+    );
+
+RING_OBJECT_SET Conns = { sizeof(RING_CONN) };
+RING_OBJECT_SET Streams = { sizeof(RING_STREAM) };
+RING_OBJECT_SET Workers = { sizeof(RING_WORKER) };
+
+static const RING_TRACE* CurrentTrace;
+
+//
+// The counts are asserted against the core's enums (see operation.c), so a
+// new operation, API call or timer type fails the build until it's named here.
+//
+static const char* const OperNames[] = {
+    "OTHER",
+    // QUIC_OPERATION_TYPE
+    "API_CALL",
+    "FLUSH_RECV",
+    "UNREACHABLE",
+    "FLUSH_STREAM_RECV",
+    "FLUSH_SEND",
+    "TLS_COMPLETE",
+    "TIMER_EXPIRED",
+    "TRACE_RUNDOWN",
+    "VERSION_NEGOTIATION",
+    "STATELESS_RESET",
+    "RETRY",
+    // QUIC_API_TYPE
+    "API_CALL;CONN_CLOSE",
+    "API_CALL;CONN_SHUTDOWN",
+    "API_CALL;CONN_START",
+    "API_CALL;CONN_SET_CONFIGURATION",
+    "API_CALL;CONN_SEND_RESUMPTION_TICKET",
+    "API_CALL;STRM_CLOSE",
+    "API_CALL;STRM_SHUTDOWN",
+    "API_CALL;STRM_START",
+    "API_CALL;STRM_SEND",
+    "API_CALL;STRM_RECV_COMPLETE",
+    "API_CALL;STRM_RECV_SET_ENABLED",
+    "API_CALL;SET_PARAM",
+    "API_CALL;GET_PARAM",
+    "API_CALL;DATAGRAM_SEND",
+    "API_CALL;STRM_SEND_BATCH",
+    // QUIC_CONN_TIMER_TYPE
+    "TIMER_EXPIRED;PACING",
+    "TIMER_EXPIRED;ACK_DELAY",
+    "TIMER_EXPIRED;LOSS_DETECTION",
+    "TIMER_EXPIRED;KEEP_ALIVE",
+    "TIMER_EXPIRED;IDLE",
+    "TIMER_EXPIRED;SHUTDOWN",
+};
+
+CXPLAT_STATIC_ASSERT(
+    ARRAYSIZE(OperNames) == RING_OPER_COUNT,
+    "Every operation needs a name");
+
+const char*
+RingOperName(
+    _In_ uint32_t Oper
+    )
+{
+    return Oper < RING_OPER_COUNT ? OperNames[Oper] : OperNames[RING_OPER_NONE];
+}
+
+static
+void
+RingCpuTimeAdd(
+    _Inout_ RING_CPU_TIME* Time,
+    _In_ uint64_t TimeNs
+    )
+{
+    if (Time->Count == 0 || TimeNs < Time->MinNs) {
+        Time->MinNs = TimeNs;
+    }
+    if (TimeNs > Time->MaxNs) {
+        Time->MaxNs = TimeNs;
+    }
+    Time->TotalNs += TimeNs;
+    Time->Count++;
+}
+
+static
+void
+RingObjectSetInitialize(
+    _Inout_ RING_OBJECT_SET* Set
+    )
+{
+    ObjectSetCreate(&Set->Set);
+    Set->First = NULL;
+    Set->Last = &Set->First;
+}
+
+//
+// Returns the active object using Ptr, creating one if there isn't any or if
+// Create is set (a creation event).
+//
+static
+RING_OBJECT*
+RingObjectSetGet(
+    _Inout_ RING_OBJECT_SET* Set,
+    _In_ uint64_t Ptr,
+    _In_ const RING_EVENT* Event,
+    _In_ BOOLEAN Create
+    )
+{
+    RING_OBJECT* Obj = (RING_OBJECT*)ObjectSetGetActive(&Set->Set, Ptr);
+    if (Obj != NULL && Create) {
+        ObjectSetRemoveActive(&Set->Set, Ptr);
+        Obj = NULL;
+    }
+
+    if (Obj == NULL) {
+        Obj = calloc(1, Set->ObjectSize);
+        if (Obj == NULL) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+        Obj->Base.Id = Set->Set.NextId++;
+        Obj->Base.Ptr = Ptr;
+        Obj->FirstTimeNs = Event->TimeNs;
+        *Set->Last = Obj;
+        Set->Last = &Obj->Next;
+        ObjectSetAddActive(&Set->Set, &Obj->Base);
+    }
+
+    Obj->LastTimeNs = Event->TimeNs;
+    Obj->EventCount++;
+    return Obj;
+}
+
+static
+void
+RingObjectDestroyed(
+    _Inout_ RING_OBJECT_SET* Set,
+    _In_ RING_OBJECT* Obj,
+    _In_ const RING_EVENT* Event
+    )
+{
+    Obj->DestroyedTimeNs = Event->TimeNs;
+    ObjectSetRemoveActive(&Set->Set, Obj->Base.Ptr);
+}
+
+RING_OBJECT**
+RingObjectSetToArray(
+    _In_ const RING_OBJECT_SET* Set
+    )
+{
+    RING_OBJECT** Array = malloc((RingObjectSetCount(Set) + 1) * sizeof(RING_OBJECT*));
+    if (Array == NULL) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    uint32_t Count = 0;
+    for (RING_OBJECT* Obj = Set->First; Obj != NULL; Obj = Obj->Next) {
+        Array[Count++] = Obj;
+    }
+    Array[Count] = NULL;
+    return Array;
+}
+
+RING_OBJECT*
+RingObjectSetGetId(
+    _In_ RING_OBJECT_SET* Set,
+    _In_ uint32_t Id
+    )
+{
+    return (RING_OBJECT*)ObjectSetGetId(&Set->Set, Id);
+}
+
+uint64_t
+RingEventGetObject(
+    _In_ const RING_EVENT* Event
+    )
+{
+    if (Event->Type == NULL ||
+        strlen(Event->Type->Format) < 10 ||
+        Event->Type->Format[0] != '[' ||
+        Event->Type->Format[5] != ']' ||
+        strncmp(Event->Type->Format + 6, "[%p]", 4) != 0) {
+        return 0;
+    }
+    RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+    if (RingEventGetArgs(Event, Args) == 0) {
+        return 0;
+    }
+    return Args[0].Value;
+}
+
+uint64_t
+RingWorkerFirstTimeNs(
+    _In_ const RING_WORKER* Worker
+    )
+{
+    const RING_THREAD* Thread = RingTraceGetThread(CurrentTrace, Worker->ThreadId);
+    if (Thread == NULL || Thread->FirstTimeNs < Worker->Obj.FirstTimeNs) {
+        return Worker->Obj.FirstTimeNs;
+    }
+    return Thread->FirstTimeNs;
+}
+
+static
+RING_WORKER*
+RingWorkerFromThread(
+    _In_ uint32_t ThreadId
+    )
+{
+    for (RING_OBJECT* Obj = Workers.First; Obj != NULL; Obj = Obj->Next) {
+        RING_WORKER* Worker = (RING_WORKER*)Obj;
+        if (Worker->ThreadId == ThreadId && Obj->DestroyedTimeNs == 0) {
+            return Worker;
+        }
+    }
+    return NULL;
+}
+
+static
+void
+RingWorkerOperEnd(
+    _Inout_ RING_WORKER* Worker,
+    _In_ uint64_t TimeNs
+    )
+{
+    if (Worker->CurrentOper != RING_OPER_NONE) {
+        Worker->OperNs[Worker->CurrentOper] += TimeNs - Worker->OperStartNs;
+        Worker->CurrentOper = RING_OPER_NONE;
+    }
+}
+
+static
+void
+RingWorkerOperStart(
+    _Inout_ RING_WORKER* Worker,
+    _In_ uint32_t Oper,
+    _In_ uint64_t TimeNs
+    )
+{
+    RingWorkerOperEnd(Worker, TimeNs);
+    Worker->Operations++;
+    Worker->OperCount[Oper]++;
+    Worker->CurrentOper = Oper;
+    Worker->OperStartNs = TimeNs;
+}
+
+static
+void
+RingConnSetWorker(
+    _Inout_ RING_CONN* Conn,
+    _In_opt_ RING_WORKER* Worker
+    )
+{
+    if (Conn->Worker == Worker) {
+        return;
+    }
+    if (Conn->Worker != NULL) {
+        Conn->Worker->CxnCount--;
+    }
+    Conn->Worker = Worker;
+    if (Worker != NULL) {
+        Conn->WorkerPtr = Worker->Obj.Base.Ptr;
+        Worker->CxnCount++;
+        Worker->TotalCxnCount++;
+    }
+}
+
+static
+void
+RingConnEvent(
+    _In_ const RING_EVENT* Event,
+    _In_reads_(ArgCount) const RING_ARG* Args,
+    _In_ uint8_t ArgCount
+    )
+{
+    const RING_KNOWN_EVENT Known = Event->Type->Known;
+    RING_CONN* Conn =
+        (RING_CONN*)RingObjectSetGet(
+            &Conns, Args[0].Value, Event, Known == RingEventConnCreated);
+
+#define ARG(i) (i < ArgCount ? Args[i].Value : 0)
+
+    switch (Known) {
+    case RingEventConnCreated:
+        Conn->CreateSeen = TRUE;
+        Conn->IsServer = (BOOLEAN)ARG(1);
+        Conn->CorrelationId = ARG(2);
+        break;
+    case RingEventConnRundown:
+        //
+        // Describes a connection that is still alive when the dump is taken.
+        //
+        Conn->IsServer = (BOOLEAN)ARG(1);
+        Conn->CorrelationId = ARG(2);
+        break;
+    case RingEventConnDestroyed:
+        RingConnSetWorker(Conn, NULL);
+        RingObjectDestroyed(&Conns, &Conn->Obj, Event);
+        break;
+    case RingEventConnHandshakeStart:
+        Conn->HandshakeStarted = TRUE;
+        break;
+    case RingEventConnHandshakeComplete:
+        Conn->HandshakeStarted = TRUE;
+        if (Conn->CreateSeen) {
+            Conn->HandshakeTimeNs = Event->TimeNs - Conn->Obj.FirstTimeNs;
+        }
+        break;
+    case RingEventConnTransportShutdown:
+    case RingEventConnAppShutdown:
+        if (!Conn->ShutdownSeen) {
+            Conn->ShutdownSeen = TRUE;
+            Conn->ShutdownByApp = Known == RingEventConnAppShutdown;
+            Conn->ShutdownErrorCode = ARG(1);
+            Conn->ShutdownByPeer = (BOOLEAN)ARG(2);
+        }
+        break;
+    case RingEventConnAssignWorker:
+        RingConnSetWorker(Conn, (RING_WORKER*)ObjectSetGetActive(&Workers.Set, ARG(1)));
+        Conn->WorkerPtr = ARG(1);
+        break;
+    case RingEventConnScheduleState: {
+        const uint8_t State = (uint8_t)ARG(1);
+        if (State >= RING_SCHEDULE_COUNT) {
+            break;
+        }
+        //
+        // The processing state changes are raised by the worker thread, and
+        // bracket the operations it executes for the connection.
+        //
+        RING_WORKER* Worker = NULL;
+        if (State == RING_SCHEDULE_PROCESSING ||
+            (Conn->ScheduleStateTimeNs != 0 && Conn->ScheduleState == RING_SCHEDULE_PROCESSING)) {
+            Worker = RingWorkerFromThread(Event->ThreadId);
+            if (Worker != NULL) {
+                RingWorkerOperEnd(Worker, Event->TimeNs);
+                if (Conn->Worker == NULL) {
+                    RingConnSetWorker(Conn, Worker);
+                }
+            }
+        }
+        if (Conn->ScheduleStateTimeNs != 0) {
+            const uint64_t TimeNs = Event->TimeNs - Conn->ScheduleStateTimeNs;
+            RingCpuTimeAdd(&Conn->SchedulingStats[Conn->ScheduleState], TimeNs);
+            if (Conn->Worker != NULL) {
+                RingCpuTimeAdd(&Conn->Worker->SchedulingStats[Conn->ScheduleState], TimeNs);
+            }
+        }
+        Conn->ScheduleState = State;
+        Conn->ScheduleStateTimeNs = Event->TimeNs;
+        break;
+    }
+    case RingEventConnExecOper:
+    case RingEventConnExecApiOper:
+    case RingEventConnExecTimerOper: {
+        Conn->Operations++;
+        const uint64_t Type = ARG(1);
+        uint32_t Oper = RING_OPER_NONE;
+        if (Known == RingEventConnExecOper && Type < RING_OPER_TYPE_COUNT) {
+            Oper = RING_OPER_BASE + (uint32_t)Type;
+        } else if (Known == RingEventConnExecApiOper && Type < RING_API_TYPE_COUNT) {
+            Oper = RING_OPER_API_BASE + (uint32_t)Type;
+        } else if (Known == RingEventConnExecTimerOper && Type < RING_TIMER_TYPE_COUNT) {
+            Oper = RING_OPER_TIMER_BASE + (uint32_t)Type;
+        }
+        RING_WORKER* Worker = RingWorkerFromThread(Event->ThreadId);
+        if (Worker != NULL) {
+            RingWorkerOperStart(Worker, Oper, Event->TimeNs);
+        }
+        break;
+    }
+    case RingEventConnStats:
+        Conn->StatsSeen = TRUE;
+        Conn->SmoothedRttUs = (uint32_t)ARG(1);
+        Conn->BytesSent = ARG(4);
+        Conn->BytesRecv = ARG(5);
+        break;
+    case RingEventConnPacketStats:
+        //
+        // Totals from the connection's own statistics, which cover packets
+        // whose events were overwritten in the ring.
+        //
+        Conn->StatsSeen = TRUE;
+        if (ARG(1) > Conn->PacketsSent) {
+            Conn->PacketsSent = ARG(1);
+        }
+        if (ARG(2) > Conn->PacketsLost) {
+            Conn->PacketsLost = ARG(2);
+        }
+        if (ARG(4) > Conn->PacketsRecv) {
+            Conn->PacketsRecv = ARG(4);
+        }
+        Conn->PacketsDropped = ARG(6);
+        break;
+    case RingEventConnOutFlowStats:
+        Conn->BytesSent = ARG(1);
+        Conn->CongestionWindow = (uint32_t)ARG(4);
+        Conn->SmoothedRttUs = (uint32_t)ARG(9);
+        break;
+    case RingEventConnInFlowStats:
+        Conn->BytesRecv = ARG(1);
+        break;
+    case RingEventConnPacketSent:
+        Conn->PacketsSent++;
+        break;
+    case RingEventConnPacketRecv:
+        Conn->PacketsRecv++;
+        break;
+    case RingEventConnPacketLost:
+        Conn->PacketsLost++;
+        break;
+    case RingEventConnCongestion:
+        Conn->CongestionEvents++;
+        break;
+    case RingEventConnPersistentCongestion:
+        Conn->PersistentCongestionEvents++;
+        break;
+    default:
+        break;
+    }
+
+#undef ARG
+}
+
+static
+void
+RingStreamEvent(
+    _In_ const RING_EVENT* Event,
+    _In_reads_(ArgCount) const RING_ARG* Args,
+    _In_ uint8_t ArgCount
+    )
+{
+    const RING_KNOWN_EVENT Known = Event->Type->Known;
+    RING_STREAM* Stream =
+        (RING_STREAM*)RingObjectSetGet(
+            &Streams, Args[0].Value, Event, Known == RingEventStreamCreated);
+
+    if ((Known == RingEventStreamCreated || Known == RingEventStreamRundown) &&
+        ArgCount >= 4) {
+        Stream->CreateSeen |= Known == RingEventStreamCreated;
+        Stream->ConnPtr = Args[1].Value;
+        Stream->StreamId = Args[2].Value;
+        Stream->IsLocal = (BOOLEAN)Args[3].Value;
+    } else if (Known == RingEventStreamDestroyed) {
+        RingObjectDestroyed(&Streams, &Stream->Obj, Event);
+    }
+}
+
+static
+void
+RingWorkerEvent(
+    _In_ const RING_EVENT* Event,
+    _In_reads_(ArgCount) const RING_ARG* Args,
+    _In_ uint8_t ArgCount
+    )
+{
+    const RING_KNOWN_EVENT Known = Event->Type->Known;
+    RING_WORKER* Worker =
+        (RING_WORKER*)RingObjectSetGet(
+            &Workers, Args[0].Value, Event, Known == RingEventWorkerCreated);
+
+    switch (Known) {
+    case RingEventWorkerCreated:
+        if (ArgCount >= 2) {
+            Worker->IdealProcessor = (uint16_t)Args[1].Value;
+        }
+        break;
+    case RingEventWorkerStart:
+        //
+        // The worker thread starts out active.
+        //
+        Worker->ThreadId = Event->ThreadId;
+        Worker->ActivitySeen = TRUE;
+        if (!Worker->IsActive) {
+            Worker->IsActive = TRUE;
+            Worker->ActiveStartNs = Event->TimeNs;
+        }
+        break;
+    case RingEventWorkerDestroyed:
+        RingWorkerOperEnd(Worker, Event->TimeNs);
+        if (Worker->IsActive) {
+            Worker->ActiveNs += Event->TimeNs - Worker->ActiveStartNs;
+            Worker->IsActive = FALSE;
+        }
+        RingObjectDestroyed(&Workers, &Worker->Obj, Event);
+        break;
+    case RingEventWorkerActivityStateUpdated:
+        //
+        // Raised by the worker thread itself.
+        //
+        Worker->ThreadId = Event->ThreadId;
+        if (ArgCount >= 2) {
+            const BOOLEAN IsActive = Args[1].Value != 0;
+            if (!IsActive && !Worker->ActivitySeen) {
+                //
+                // The start of the thread was overwritten in the ring, so it
+                // has been active since (at least) its first event.
+                //
+                Worker->IsActive = TRUE;
+                Worker->ActiveStartNs = RingWorkerFirstTimeNs(Worker);
+            }
+            Worker->ActivitySeen = TRUE;
+            if (IsActive && !Worker->IsActive) {
+                Worker->ActiveStartNs = Event->TimeNs;
+            } else if (!IsActive && Worker->IsActive) {
+                Worker->ActiveNs += Event->TimeNs - Worker->ActiveStartNs;
+            }
+            if (!IsActive) {
+                RingWorkerOperEnd(Worker, Event->TimeNs);
+            }
+            Worker->IsActive = IsActive;
+        }
+        break;
+    case RingEventWorkerQueueDelayUpdated:
+        Worker->ThreadId = Event->ThreadId;
+        if (ArgCount >= 2) {
+            const uint32_t DelayUs = (uint32_t)Args[1].Value;
+            Worker->QueueDelaySumUs += DelayUs;
+            Worker->QueueDelayCount++;
+            if (DelayUs > Worker->QueueDelayMaxUs) {
+                Worker->QueueDelayMaxUs = DelayUs;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void
+RingObjectsProcess(
+    _In_ const RING_TRACE* Trace
+    )
+{
+    CurrentTrace = Trace;
+    RingObjectSetInitialize(&Conns);
+    RingObjectSetInitialize(&Streams);
+    RingObjectSetInitialize(&Workers);
+
+    for (uint64_t i = 0; i < Trace->EventCount; ++i) {
+        const RING_EVENT* Event = &Trace->Events[i];
+        if (Event->Type == NULL || Event->Type->Known == RingEventUnknown) {
+            continue;
+        }
+
+        RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+        const uint8_t ArgCount = RingEventGetArgs(Event, Args);
+        if (ArgCount == 0) {
+            continue;
+        }
+
+        if (Event->Type->Known < RingEventStreamCreated) {
+            RingConnEvent(Event, Args, ArgCount);
+        } else if (Event->Type->Known < RingEventWorkerCreated) {
+            RingStreamEvent(Event, Args, ArgCount);
+        } else {
+            RingWorkerEvent(Event, Args, ArgCount);
+        }
+    }
+
+    //
+    // Workers still active at the end of the trace.
+    //
+    for (RING_OBJECT* Obj = Workers.First; Obj != NULL; Obj = Obj->Next) {
+        RING_WORKER* Worker = (RING_WORKER*)Obj;
+        RingWorkerOperEnd(Worker, Trace->StopTimeNs);
+        if (Worker->IsActive) {
+            Worker->ActiveNs += Trace->StopTimeNs - Worker->ActiveStartNs;
+        }
+    }
+}
@@ -0,0 +1,395 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Offline decoder for event ring dumps (QUIC_EVENTS_RING).
+
+--*/
+
+#include <quic_platform.h>
+#include <quic_hashtable.h>
+#include <quic_trace_ring.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "object_set.h"
+
+#define NS_PER_US 1000ull
+#define NS_PER_MS 1000000ull
+
+//
+// Events the object models look at. Everything else is only counted and
+// printed.
+//
+typedef enum RING_KNOWN_EVENT {
+    RingEventUnknown,
+    RingEventConnCreated,
+    RingEventConnRundown,
+    RingEventConnDestroyed,
+    RingEventConnHandshakeComplete,
+    RingEventConnTransportShutdown,
+    RingEventConnAppShutdown,
+    RingEventConnAssignWorker,
+    RingEventConnHandshakeStart,
+    RingEventConnScheduleState,
+    RingEventConnExecOper,
+    RingEventConnExecApiOper,
+    RingEventConnExecTimerOper,
+    RingEventConnStats,
+    RingEventConnOutFlowStats,
+    RingEventConnInFlowStats,
+    RingEventConnPacketStats,
+    RingEventConnPacketSent,
+    RingEventConnPacketRecv,
+    RingEventConnPacketLost,
+    RingEventConnCongestion,
+    RingEventConnPersistentCongestion,
+    RingEventStreamCreated,
+    RingEventStreamRundown,
+    RingEventStreamDestroyed,
+    RingEventWorkerCreated,
+    RingEventWorkerStart,
+    RingEventWorkerDestroyed,
+    RingEventWorkerActivityStateUpdated,
+    RingEventWorkerQueueDelayUpdated,
+    RingEventKnownCount
+} RING_KNOWN_EVENT;
+
+typedef struct RING_EVENT_TYPE {
+    char* Name;
+    char* Format;
+    RING_KNOWN_EVENT Known;
+    uint8_t ArgCount;
+    uint8_t ArgTypes[QUIC_TRACE_RING_MAX_ARGS];
+    uint64_t Count;
+} RING_EVENT_TYPE;
+
+typedef struct RING_EVENT {
+    uint64_t TimeNs;
+    uint32_t ThreadId;
+    const RING_EVENT_TYPE* Type; // NULL if missing from the event table.
+    const QUIC_TRACE_RING_RECORD* Record;
+} RING_EVENT;
+
+typedef struct RING_ARG {
+    uint8_t Type;           // QUIC_TRACE_RING_ARG_TYPE
+    uint8_t Length;         // Of Data.
+    uint64_t Value;         // Integers and pointers.
+    const uint8_t* Data;    // Strings and byte arrays.
+} RING_ARG;
+
+typedef struct RING_THREAD {
+    uint32_t ThreadId;
+    uint32_t RingSize;
+    uint64_t EventCount;
+    uint64_t FirstTimeNs;
+    uint64_t LastTimeNs;
+} RING_THREAD;
+
+typedef struct RING_TRACE {
+    QUIC_TRACE_RING_FILE_HEADER Header;
+    uint8_t* FileData;
+    RING_EVENT_TYPE* TypeById[UINT16_MAX + 1];
+    RING_THREAD* Threads;
+    uint32_t ThreadCount;
+    RING_EVENT* Events;     // Sorted by time.
+    uint64_t EventCount;
+    uint64_t StartTimeNs;
+    uint64_t StopTimeNs;
+} RING_TRACE;
+
+typedef enum RING_COMMAND {
+    COMMAND_SUMMARY,
+    COMMAND_REPORT,
+    COMMAND_TRACE,
+    COMMAND_CONN,
+    COMMAND_CONN_LIST,
+    COMMAND_CONN_TPUT,
+    COMMAND_STREAM_LIST,
+    COMMAND_WORKER,
+    COMMAND_WORKER_LIST,
+    COMMAND_WORKER_QUEUE,
+    COMMAND_FLAME
+} RING_COMMAND;
+
+typedef enum RING_SORT_TYPE {
+    SORT_NONE,
+    SORT_AGE,
+    SORT_CPU_ACTIVE,
+    SORT_CPU_QUEUED,
+    SORT_CPU_IDLE,
+    SORT_TX,
+    SORT_RX,
+    SORT_LOST,
+    SORT_CONN_COUNT
+} RING_SORT_TYPE;
+
+typedef struct RING_CMD_ARGS {
+    RING_COMMAND Command;
+    RING_SORT_TYPE Sort;
+    BOOLEAN FormatCSV;
+    uint32_t Id;
+    uint64_t Ptr;
+    uint32_t ThreadId;
+    uint64_t Top;
+    uint64_t ResolutionNs;
+} RING_CMD_ARGS;
+
+extern RING_CMD_ARGS Cmd;
+extern RING_TRACE Trace;
+
+//
+// reader.c
+//
+
+BOOLEAN
+RingTraceOpen(
+    _In_z_ const char* FileName,
+    _Out_ RING_TRACE* Trace
+    );
+
+void
+RingTraceClose(
+    _In_ RING_TRACE* Trace
+    );
+
+//
+// Returns the ring of a thread, or NULL if it has no events.
+//
+const RING_THREAD*
+RingTraceGetThread(
+    _In_ const RING_TRACE* Trace,
+    _In_ uint32_t ThreadId
+    );
+
+//
+// Returns the number of arguments that were recorded; trailing ones may have
+// been dropped if the record was full.
+//
+uint8_t
+RingEventGetArgs(
+    _In_ const RING_EVENT* Event,
+    _Out_writes_to_(QUIC_TRACE_RING_MAX_ARGS, return)
+        RING_ARG* Args
+    );
+
+//
+// Formats the event's message, the way the format string would have.
+//
+void
+RingEventFormat(
+    _In_ const RING_EVENT* Event,
+    _Out_writes_(BufferLength) char* Buffer,
+    _In_ size_t BufferLength
+    );
+
+//
+// objects.c
+//
+
+//
+// Time spent in one scheduling state (QUIC_SCHEDULE_STATE).
+//
+typedef struct RING_CPU_TIME {
+    uint64_t TotalNs;
+    uint64_t MinNs;
+    uint64_t MaxNs;
+    uint32_t Count;
+} RING_CPU_TIME;
+
+typedef enum RING_SCHEDULE_STATE {
+    RING_SCHEDULE_IDLE,         // QUIC_SCHEDULE_IDLE
+    RING_SCHEDULE_QUEUED,       // QUIC_SCHEDULE_QUEUED
+    RING_SCHEDULE_PROCESSING,   // QUIC_SCHEDULE_PROCESSING
+    RING_SCHEDULE_COUNT
+} RING_SCHEDULE_STATE;
+
+//
+// Worker time is broken down by what the worker thread executes: connection
+// operations (QUIC_OPERATION_TYPE), with API calls and expired timers split
+// further by QUIC_API_TYPE and QUIC_CONN_TIMER_TYPE.
+//
+#define RING_OPER_TYPE_COUNT    QUIC_TRACE_RING_OPER_TYPE_COUNT
+#define RING_API_TYPE_COUNT     QUIC_TRACE_RING_API_TYPE_COUNT
+#define RING_TIMER_TYPE_COUNT   QUIC_TRACE_RING_TIMER_TYPE_COUNT
+
+#define RING_OPER_NONE          0
+#define RING_OPER_BASE          1
+#define RING_OPER_API_BASE      (RING_OPER_BASE + RING_OPER_TYPE_COUNT)
+#define RING_OPER_TIMER_BASE    (RING_OPER_API_BASE + RING_API_TYPE_COUNT)
+#define RING_OPER_COUNT         (RING_OPER_TIMER_BASE + RING_TIMER_TYPE_COUNT)
+
+//
+// Returns the "type;subtype" frames for an operation index, as used in the
+// flame graph output.
+//
+const char*
+RingOperName(
+    _In_ uint32_t Oper
+    );
+
+typedef struct RING_OBJECT {
+    OBJECT Base;                // Id and Ptr.
+    struct RING_OBJECT* Next;   // In order of first appearance.
+    uint64_t FirstTimeNs;
+    uint64_t LastTimeNs;
+    uint64_t DestroyedTimeNs;   // 0 if still alive at the end of the trace.
+    uint64_t EventCount;
+} RING_OBJECT;
+
+typedef struct RING_WORKER RING_WORKER;
+
+typedef struct RING_CONN {
+    RING_OBJECT Obj;
+    BOOLEAN IsServer;
+    BOOLEAN CreateSeen;
+    BOOLEAN HandshakeStarted;
+    BOOLEAN StatsSeen;
+    BOOLEAN ShutdownSeen;
+    BOOLEAN ShutdownByApp;
+    BOOLEAN ShutdownByPeer;
+    uint64_t ShutdownErrorCode;
+    uint64_t CorrelationId;
+    uint64_t HandshakeTimeNs;   // Since creation. 0 if not complete.
+    uint64_t WorkerPtr;
+    RING_WORKER* Worker;
+    uint64_t Operations;
+    uint8_t ScheduleState;
+    uint64_t ScheduleStateTimeNs;
+    RING_CPU_TIME SchedulingStats[RING_SCHEDULE_COUNT];
+    uint64_t BytesSent;
+    uint64_t BytesRecv;
+    uint32_t SmoothedRttUs;
+    uint32_t CongestionWindow;
+    uint64_t PacketsSent;
+    uint64_t PacketsRecv;
+    uint64_t PacketsLost;
+    uint64_t PacketsDropped;
+    uint64_t CongestionEvents;
+    uint64_t PersistentCongestionEvents;
+} RING_CONN;
+
+typedef struct RING_STREAM {
+    RING_OBJECT Obj;
+    uint64_t ConnPtr;
+    uint64_t StreamId;
+    BOOLEAN IsLocal;
+    BOOLEAN CreateSeen;
+} RING_STREAM;
+
+typedef struct RING_WORKER {
+    RING_OBJECT Obj;
+    uint16_t IdealProcessor;
+    uint32_t ThreadId;          // 0 until the worker thread raises an event.
+    BOOLEAN IsActive;
+    BOOLEAN ActivitySeen;
+    uint64_t ActiveStartNs;
+    uint64_t ActiveNs;
+    uint64_t Operations;
+    uint64_t QueueDelaySumUs;
+    uint32_t QueueDelayCount;
+    uint32_t QueueDelayMaxUs;
+    uint32_t CxnCount;          // Currently assigned.
+    uint32_t TotalCxnCount;     // Ever assigned.
+    RING_CPU_TIME SchedulingStats[RING_SCHEDULE_COUNT];
+    uint32_t CurrentOper;       // RING_OPER_NONE if not executing one.
+    uint64_t OperStartNs;
+    uint64_t OperNs[RING_OPER_COUNT];
+    uint64_t OperCount[RING_OPER_COUNT];
+} RING_WORKER;
+
+typedef struct RING_OBJECT_SET {
+    size_t ObjectSize;
+    OBJECT_SET Set;
+    RING_OBJECT* First;
+    RING_OBJECT** Last;
+} RING_OBJECT_SET;
+
+#define RingObjectSetCount(RingSet) ((RingSet)->Set.NextId - 1)
+
+extern RING_OBJECT_SET Conns;
+extern RING_OBJECT_SET Streams;
+extern RING_OBJECT_SET Workers;
+
+void
+RingObjectsProcess(
+    _In_ const RING_TRACE* Trace
+    );
+
+//
+// Returns the objects in order of appearance (NULL terminated).
+//
+RING_OBJECT**
+RingObjectSetToArray(
+    _In_ const RING_OBJECT_SET* Set
+    );
+
+RING_OBJECT*
+RingObjectSetGetId(
+    _In_ RING_OBJECT_SET* Set,
+    _In_ uint32_t Id
+    );
+
+//
+// Returns the pointer of the object an event is about (the first argument
+// of "[xxxx][%p] ..." events), or 0.
+//
+uint64_t
+RingEventGetObject(
+    _In_ const RING_EVENT* Event
+    );
+
+//
+// Returns when the worker's thread was first seen in the trace: the start
+// of its ring, which may have wrapped long after the worker was created.
+//
+uint64_t
+RingWorkerFirstTimeNs(
+    _In_ const RING_WORKER* Worker
+    );
+
+//
+// main.c
+//
+
+void
+PrintTime(
+    _In_ uint64_t TimeNs
+    );
+
+void
+PrintCpuTime(
+    _In_ const RING_CPU_TIME* Time
+    );
+
+uint64_t
+ObjectAge(
+    _In_ const RING_OBJECT* Obj
+    );
+
+//
+// report.c
+//
+
+void
+CommandReport(
+    void
+    );
+
+void
+CommandConnTput(
+    void
+    );
+
+void
+CommandWorkerQueue(
+    void
+    );
+
+void
+CommandFlame(
+    void
+    );
@@ -0,0 +1,433 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    Loads an event ring dump and decodes its records.
+
+--*/
+
+#include "quicring.h"
+
+static const char* const KnownEventNames[RingEventKnownCount] = {
+    NULL,
+    "ConnCreated",
+    "ConnRundown",
+    "ConnDestroyed",
+    "ConnHandshakeComplete",
+    "ConnTransportShutdown",
+    "ConnAppShutdown",
+    "ConnAssignWorker",
+    "ConnHandshakeStart",
+    "ConnScheduleState",
+    "ConnExecOper",
+    "ConnExecApiOper",
+    "ConnExecTimerOper",
+    "ConnStats",
+    "ConnOutFlowStats",
+    "ConnInFlowStats",
+    "ConnPacketStats",
+    "ConnPacketSent",
+    "ConnPacketRecv",
+    "ConnPacketLost",
+    "ConnCongestion",
+    "ConnPersistentCongestion",
+    "StreamCreated",
+    "StreamRundown",
+    "StreamDestroyed",
+    "WorkerCreated",
+    "WorkerStart",
+    "WorkerDestroyed",
+    "WorkerActivityStateUpdated",
+    "WorkerQueueDelayUpdated",
+};
+
+static
+char*
+CopyString(
+    _In_reads_(Length) const uint8_t* Data,
+    _In_ uint16_t Length
+    )
+{
+    char* String = malloc(Length + 1);
+    if (String == NULL) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+    memcpy(String, Data, Length);
+    String[Length] = '\0';
+    return String;
+}
+
+static
+int
+CompareEvents(
+    const void* Event1,
+    const void* Event2
+    )
+{
+    const RING_EVENT* a = (const RING_EVENT*)Event1;
+    const RING_EVENT* b = (const RING_EVENT*)Event2;
+    if (a->TimeNs != b->TimeNs) {
+        return a->TimeNs < b->TimeNs ? -1 : 1;
+    }
+    //
+    // Keep each thread's records in the order they were written.
+    //
+    if (a->Record != b->Record) {
+        return a->Record < b->Record ? -1 : 1;
+    }
+    return 0;
+}
+
+BOOLEAN
+RingTraceOpen(
+    _In_z_ const char* FileName,
+    _Out_ RING_TRACE* Trace
+    )
+{
+    memset(Trace, 0, sizeof(*Trace));
+
+    FILE* File = fopen(FileName, "rb");
+    if (File == NULL) {
+        printf("Failed to open %s\n", FileName);
+        return FALSE;
+    }
+    fseek(File, 0, SEEK_END);
+    const long FileLength = ftell(File);
+    fseek(File, 0, SEEK_SET);
+    if (FileLength < (long)sizeof(QUIC_TRACE_RING_FILE_HEADER)) {
+        printf("%s is not an event ring dump\n", FileName);
+        fclose(File);
+        return FALSE;
+    }
+    Trace->FileData = malloc((size_t)FileLength);
+    if (Trace->FileData == NULL ||
+        fread(Trace->FileData, (size_t)FileLength, 1, File) != 1) {
+        printf("Failed to read %s\n", FileName);
+        fclose(File);
+        return FALSE;
+    }
+    fclose(File);
+
+    const uint8_t* Data = Trace->FileData;
+    const uint8_t* End = Data + FileLength;
+    memcpy(&Trace->Header, Data, sizeof(Trace->Header));
+    Data += sizeof(Trace->Header);
+    if (memcmp(Trace->Header.Signature, QUIC_TRACE_RING_FILE_SIGNATURE, sizeof(Trace->Header.Signature)) != 0 ||
+        Trace->Header.Version != QUIC_TRACE_RING_FILE_VERSION) {
+        printf("%s is not a version %u event ring dump\n", FileName, QUIC_TRACE_RING_FILE_VERSION);
+        return FALSE;
+    }
+
+    for (uint32_t i = 0; i < Trace->Header.EventCount; ++i) {
+        QUIC_TRACE_RING_FILE_EVENT FileEvent;
+        if (Data + sizeof(FileEvent) > End) {
+            goto Truncated;
+        }
+        memcpy(&FileEvent, Data, sizeof(FileEvent));
+        Data += sizeof(FileEvent);
+        if (Data + FileEvent.NameLength + FileEvent.FormatLength > End) {
+            goto Truncated;
+        }
+
+        RING_EVENT_TYPE* Type = calloc(1, sizeof(RING_EVENT_TYPE));
+        if (Type == NULL) {
+            printf("Out of memory\n");
+            exit(1);
+        }
+        Type->Name = CopyString(Data, FileEvent.NameLength);
+        Data += FileEvent.NameLength;
+        Type->Format = CopyString(Data, FileEvent.FormatLength);
+        Data += FileEvent.FormatLength;
+        Type->ArgCount = QuicTraceRingParseFormat(Type->Format, Type->ArgTypes);
+        for (uint32_t j = 1; j < RingEventKnownCount; ++j) {
+            if (strcmp(Type->Name, KnownEventNames[j]) == 0) {
+                Type->Known = (RING_KNOWN_EVENT)j;
+                break;
+            }
+        }
+        Trace->TypeById[FileEvent.EventId] = Type;
+    }
+
+    Trace->Threads = calloc(Trace->Header.RingCount + 1, sizeof(RING_THREAD));
+    if (Trace->Threads == NULL) {
+        printf("Out of memory\n");
+        exit(1);
+    }
+
+    uint64_t EventCapacity = 0;
+    for (uint32_t i = 0; i < Trace->Header.RingCount; ++i) {
+        QUIC_TRACE_RING_FILE_RING FileRing;
+        if (Data + sizeof(FileRing) > End) {
+            goto Truncated;
+        }
+        memcpy(&FileRing, Data, sizeof(FileRing));
+        Data += sizeof(FileRing);
+        if (FileRing.Size == 0 || (FileRing.Size & (FileRing.Size - 1)) != 0 ||
+            Data + FileRing.Size > End) {
+            goto Truncated;
+        }
+        const uint8_t* Buffer = Data;
+        Data += FileRing.Size;
+
+        RING_THREAD* Thread = &Trace->Threads[Trace->ThreadCount++];
+        Thread->ThreadId = FileRing.ThreadId;
+        Thread->RingSize = FileRing.Size;
+
+        uint64_t Offset = 0;
+        const QUIC_TRACE_RING_RECORD* Record;
+        while ((Record = QuicTraceRingNextRecord(&FileRing, Buffer, &Offset)) != NULL) {
+            if (Trace->EventCount == EventCapacity) {
+                EventCapacity = EventCapacity == 0 ? 65536 : EventCapacity * 2;
+                Trace->Events = realloc(Trace->Events, EventCapacity * sizeof(RING_EVENT));
+                if (Trace->Events == NULL) {
+                    printf("Out of memory\n");
+                    exit(1);
+                }
+            }
+            RING_EVENT* Event = &Trace->Events[Trace->EventCount++];
+            Event->TimeNs = Record->TimeNs;
+            Event->ThreadId = FileRing.ThreadId;
+            Event->Type = Trace->TypeById[Record->EventId];
+            Event->Record = Record;
+
+            if (Thread->EventCount++ == 0) {
+                Thread->FirstTimeNs = Record->TimeNs;
+            }
+            Thread->LastTimeNs = Record->TimeNs;
+            if (Event->Type != NULL) {
+                ((RING_EVENT_TYPE*)Event->Type)->Count++;
+            }
+        }
+    }
+
+    qsort(Trace->Events, Trace->EventCount, sizeof(RING_EVENT), CompareEvents);
+    if (Trace->EventCount != 0) {
+        Trace->StartTimeNs = Trace->Events[0].TimeNs;
+        Trace->StopTimeNs = Trace->Events[Trace->EventCount - 1].TimeNs;
+    }
+
+    return TRUE;
+
+Truncated:
+    printf("%s is truncated\n", FileName);
+    return FALSE;
+}
+
+const RING_THREAD*
+RingTraceGetThread(
+    _In_ const RING_TRACE* Trace,
+    _In_ uint32_t ThreadId
+    )
+{
+    for (uint32_t i = 0; i < Trace->ThreadCount; ++i) {
+        if (Trace->Threads[i].ThreadId == ThreadId && Trace->Threads[i].EventCount != 0) {
+            return &Trace->Threads[i];
+        }
+    }
+    return NULL;
+}
+
+void
+RingTraceClose(
+    _In_ RING_TRACE* Trace
+    )
+{
+    for (uint32_t i = 0; i <= UINT16_MAX; ++i) {
+        if (Trace->TypeById[i] != NULL) {
+            free(Trace->TypeById[i]->Name);
+            free(Trace->TypeById[i]->Format);
+            free(Trace->TypeById[i]);
+        }
+    }
+    free(Trace->Threads);
+    free(Trace->Events);
+    free(Trace->FileData);
+    memset(Trace, 0, sizeof(*Trace));
+}
+
+uint8_t
+RingEventGetArgs(
+    _In_ const RING_EVENT* Event,
+    _Out_writes_to_(QUIC_TRACE_RING_MAX_ARGS, return)
+        RING_ARG* Args
+    )
+{
+    if (Event->Type == NULL) {
+        return 0;
+    }
+
+    const uint8_t* Data = (const uint8_t*)(Event->Record + 1);
+    const uint8_t* End = (const uint8_t*)Event->Record + Event->Record->Length;
+    uint8_t ArgCount = 0;
+    for (; ArgCount < Event->Type->ArgCount; ++ArgCount) {
+        RING_ARG* Arg = &Args[ArgCount];
+        Arg->Type = Event->Type->ArgTypes[ArgCount];
+        Arg->Value = 0;
+        Arg->Data = NULL;
+        Arg->Length = 0;
+
+        uint8_t Size;
+        switch (Arg->Type) {
+        case QUIC_TRACE_RING_ARG_U8:  Size = 1; break;
+        case QUIC_TRACE_RING_ARG_U16: Size = 2; break;
+        case QUIC_TRACE_RING_ARG_U32: Size = 4; break;
+        case QUIC_TRACE_RING_ARG_U64:
+        case QUIC_TRACE_RING_ARG_PTR: Size = 8; break;
+        default:                      Size = 0; break;
+        }
+
+        if (Size != 0) {
+            if (Data + Size > End) {
+                break;
+            }
+            memcpy(&Arg->Value, Data, Size); // Little endian.
+            Data += Size;
+        } else {
+            if (Data + 1 > End || Data + 1 + Data[0] > End) {
+                break;
+            }
+            Arg->Length = Data[0];
+            Arg->Data = Data + 1;
+            Data += 1 + Arg->Length;
+        }
+    }
+    return ArgCount;
+}
+
+static
+void
+FormatBytes(
+    _In_ const RING_ARG* Arg,
+    _In_reads_(NameLength) const char* Name,
+    _In_ size_t NameLength,
+    _Out_writes_(BufferLength) char* Buffer,
+    _In_ size_t BufferLength
+    )
+{
+    if (NameLength == 4 && memcmp(Name, "ADDR", 4) == 0 && Arg->Length == sizeof(QUIC_ADDR)) {
+        QUIC_ADDR Addr;
+        QUIC_ADDR_STR AddrStr;
+        memcpy(&Addr, Arg->Data, sizeof(Addr));
+        if (QuicAddrToString(&Addr, &AddrStr)) {
+            snprintf(Buffer, BufferLength, "%s", AddrStr.Address);
+            return;
+        }
+    }
+
+    size_t Offset = 0;
+    Buffer[0] = '\0';
+    for (uint8_t i = 0; i < Arg->Length && Offset + 3 <= BufferLength; ++i) {
+        Offset += (size_t)snprintf(Buffer + Offset, BufferLength - Offset, "%02x", Arg->Data[i]);
+    }
+}
+
+void
+RingEventFormat(
+    _In_ const RING_EVENT* Event,
+    _Out_writes_(BufferLength) char* Buffer,
+    _In_ size_t BufferLength
+    )
+{
+    if (Event->Type == NULL) {
+        snprintf(Buffer, BufferLength, "<unknown event %hu>", Event->Record->EventId);
+        return;
+    }
+
+    RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+    const uint8_t ArgCount = RingEventGetArgs(Event, Args);
+    uint8_t ArgIndex = 0;
+
+    size_t Offset = 0;
+    Buffer[0] = '\0';
+    for (const char* p = Event->Type->Format; *p != '\0' && Offset + 1 < BufferLength; ++p) {
+        if (*p != '%' || p[1] == '%') {
+            Buffer[Offset++] = *p;
+            Buffer[Offset] = '\0';
+            if (*p == '%') {
+                ++p;
+            }
+            continue;
+        }
+
+        const char* SpecStart = p++;
+        const char* ModifierStart = p;
+        const char* Name = NULL;
+        size_t NameLength = 0;
+        if (*p == '!') {
+            Name = ++p;
+            while (*p != '\0' && *p != '!') {
+                ++p;
+            }
+            NameLength = (size_t)(p - Name);
+        } else {
+            while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '.' ||
+                   (*p >= '0' && *p <= '9')) {
+                ++p;
+            }
+            ModifierStart = p;
+            while (*p == 'h' || *p == 'l' || *p == 'z' || *p == 'j' ||
+                   (p[0] == 'I' && p[1] == '6' && p[2] == '4')) {
+                p += (*p == 'I') ? 3 : 1;
+            }
+        }
+        if (*p == '\0') {
+            break;
+        }
+
+        char Value[QUIC_TRACE_RING_MAX_BYTES * 2 + 1];
+        if (ArgIndex >= ArgCount) {
+            snprintf(Value, sizeof(Value), "<?>");
+        } else {
+            const RING_ARG* Arg = &Args[ArgIndex++];
+            if (Name != NULL) {
+                FormatBytes(Arg, Name, NameLength, Value, sizeof(Value));
+            } else if (Arg->Type == QUIC_TRACE_RING_ARG_STRING) {
+                snprintf(Value, sizeof(Value), "%.*s", (int)Arg->Length, (const char*)Arg->Data);
+            } else if (Arg->Type == QUIC_TRACE_RING_ARG_PTR) {
+                snprintf(Value, sizeof(Value), "0x%llx", (unsigned long long)Arg->Value);
+            } else if (*p == 'c') {
+                snprintf(Value, sizeof(Value), "%c", (char)Arg->Value);
+            } else {
+                //
+                // Reuse the flags, width and precision of the specifier, with
+                // the value widened to 64 bits.
+                //
+                char Spec[32];
+                size_t SpecLength = (size_t)(ModifierStart - SpecStart);
+                if (SpecLength > sizeof(Spec) - 4) {
+                    SpecLength = 1;
+                }
+                memcpy(Spec, SpecStart, SpecLength);
+                Spec[SpecLength++] = 'l';
+                Spec[SpecLength++] = 'l';
+                Spec[SpecLength++] = strchr("diouxX", *p) != NULL ? *p : 'u';
+                Spec[SpecLength] = '\0';
+
+                long long Signed;
+                switch (Arg->Type) {
+                case QUIC_TRACE_RING_ARG_U8:  Signed = (int8_t)Arg->Value; break;
+                case QUIC_TRACE_RING_ARG_U16: Signed = (int16_t)Arg->Value; break;
+                case QUIC_TRACE_RING_ARG_U32: Signed = (int32_t)Arg->Value; break;
+                default:                      Signed = (long long)Arg->Value; break;
+                }
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+                if (*p == 'd' || *p == 'i') {
+                    snprintf(Value, sizeof(Value), Spec, Signed);
+                } else {
+                    snprintf(Value, sizeof(Value), Spec, (unsigned long long)Arg->Value);
+                }
+#pragma GCC diagnostic pop
+            }
+        }
+
+        Offset += (size_t)snprintf(Buffer + Offset, BufferLength - Offset, "%s", Value);
+        if (Offset >= BufferLength) {
+            Offset = BufferLength - 1;
+        }
+    }
+}
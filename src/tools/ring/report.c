@@ -0,0 +1,425 @@
+/*++
+
+    Copyright (c) Microsoft Corporation.
+    Licensed under the MIT License.
+
+Abstract:
+
+    System report, time series and flame graph output, computed the same way
+    as the quicetw reports on Windows.
+
+--*/
+
+#include "quicring.h"
+
+#define UNHEALTHY_QUEUE_DELAY_US            (25 * 1000)
+#define MOSTLY_IDLE_PROCESSING_PERCENT      (5)
+#define REALLY_ACTIVE_PROCESSING_PERCENT    (80)
+
+void
+CommandReport(
+    void
+    )
+{
+    printf("\nREPORT (Elapsed time: ");
+    PrintTime(Trace.StopTimeNs - Trace.StartTimeNs);
+    printf(")\n\n");
+
+    if (RingObjectSetCount(&Workers) == 0) {
+        printf("No workers found.\n\n");
+
+    } else {
+        printf("WORKERS (%u)\n\n", RingObjectSetCount(&Workers));
+
+        uint32_t UnhealthyWorkers = 0;
+        uint32_t MostlyIdleWorkers = 0;
+        uint32_t ReallyActiveWorkers = 0;
+        for (RING_OBJECT* Obj = Workers.First; Obj != NULL; Obj = Obj->Next) {
+            const RING_WORKER* Worker = (const RING_WORKER*)Obj;
+            const RING_CPU_TIME* Queued = &Worker->SchedulingStats[RING_SCHEDULE_QUEUED];
+            if (Queued->Count != 0 &&
+                Queued->TotalNs / Queued->Count / NS_PER_US >= UNHEALTHY_QUEUE_DELAY_US) {
+                UnhealthyWorkers++;
+            }
+            const uint64_t Age = ObjectAge(Obj);
+            const uint64_t ActivePercent = Age == 0 ? 0 : (100 * Worker->ActiveNs) / Age;
+            if (ActivePercent <= MOSTLY_IDLE_PROCESSING_PERCENT) {
+                MostlyIdleWorkers++;
+            } else if (ActivePercent >= REALLY_ACTIVE_PROCESSING_PERCENT) {
+                ReallyActiveWorkers++;
+            }
+        }
+
+        if (UnhealthyWorkers == 0) {
+            printf("  All workers healthy.\n");
+        } else {
+            printf("  %u workers unhealthy.\n  {", UnhealthyWorkers);
+            UnhealthyWorkers = 0;
+            for (RING_OBJECT* Obj = Workers.First; Obj != NULL; Obj = Obj->Next) {
+                const RING_CPU_TIME* Queued =
+                    &((const RING_WORKER*)Obj)->SchedulingStats[RING_SCHEDULE_QUEUED];
+                if (Queued->Count != 0 &&
+                    Queued->TotalNs / Queued->Count / NS_PER_US >= UNHEALTHY_QUEUE_DELAY_US) {
+                    printf(UnhealthyWorkers++ == 0 ? "#%u" : ", #%u", Obj->Base.Id);
+                }
+            }
+            printf("}\n");
+        }
+        printf("  %u workers mostly idle.\n", MostlyIdleWorkers);
+        printf("  %u workers really active.\n\n", ReallyActiveWorkers);
+    }
+
+    if (RingObjectSetCount(&Conns) == 0) {
+        printf("No connections found.\n");
+        return;
+    }
+
+    printf("CONNECTIONS (%u)\n\n", RingObjectSetCount(&Conns));
+
+    uint32_t StillActiveCxns = 0;
+    uint32_t TransportShutdownCxns = 0;
+    uint32_t AppNonZeroShutdownCxns = 0;
+    uint32_t SuccessAppShutdownCxns = 0;
+    uint32_t UnknownShutdownCxns = 0;
+    uint32_t CxnsFailedHandshake = 0;
+    uint32_t CxnsWithStats = 0;
+    uint64_t TotalCongEvents = 0;
+    uint64_t TotalPerCongEvents = 0;
+    uint64_t TotalSentPackets = 0;
+    uint64_t TotalLostPackets = 0;
+    uint64_t TotalReceivedPackets = 0;
+    uint64_t TotalDroppedPackets = 0;
+
+    for (RING_OBJECT* Obj = Conns.First; Obj != NULL; Obj = Obj->Next) {
+        const RING_CONN* Conn = (const RING_CONN*)Obj;
+        if (Conn->StatsSeen) {
+            CxnsWithStats++;
+        }
+        TotalCongEvents += Conn->CongestionEvents;
+        TotalPerCongEvents += Conn->PersistentCongestionEvents;
+        TotalSentPackets += Conn->PacketsSent;
+        TotalLostPackets += Conn->PacketsLost;
+        TotalReceivedPackets += Conn->PacketsRecv;
+        TotalDroppedPackets += Conn->PacketsDropped;
+
+        if (!Conn->ShutdownSeen) {
+            if (Obj->DestroyedTimeNs != 0) {
+                UnknownShutdownCxns++;
+            } else {
+                StillActiveCxns++;
+            }
+        } else if (Conn->ShutdownByApp) {
+            if (Conn->ShutdownErrorCode == 0) {
+                SuccessAppShutdownCxns++;
+            } else {
+                AppNonZeroShutdownCxns++;
+            }
+        } else {
+            TransportShutdownCxns++;
+        }
+        if (Conn->CreateSeen && Conn->HandshakeTimeNs == 0 &&
+            (Conn->ShutdownSeen || Obj->DestroyedTimeNs != 0)) {
+            CxnsFailedHandshake++;
+        }
+    }
+
+    if (StillActiveCxns == 0) {
+        printf("  No active connections.\n");
+    } else {
+        printf("  %u connections still active.\n", StillActiveCxns);
+    }
+    if (CxnsFailedHandshake != 0) {
+        printf("\n  %u connections failed the handshake.\n", CxnsFailedHandshake);
+    }
+
+    printf("\n");
+    if (SuccessAppShutdownCxns != 0) {
+        printf("  %u connections successfully shutdown by the app.\n", SuccessAppShutdownCxns);
+    }
+    if (AppNonZeroShutdownCxns != 0) {
+        printf("  %u connections errored by the app.\n", AppNonZeroShutdownCxns);
+    }
+    if (TransportShutdownCxns != 0) {
+        printf("  %u connections shutdown by the transport.\n", TransportShutdownCxns);
+    }
+    if (UnknownShutdownCxns != 0) {
+        printf("  %u connections destroyed without a shutdown in the trace.\n", UnknownShutdownCxns);
+    }
+
+    printf("\n");
+    if (CxnsWithStats == 0) {
+        printf("  WARNING - No connection statistics events found.\n\n");
+    }
+
+    printf("  %llu total congestion events.\n", (unsigned long long)TotalCongEvents);
+    printf("  %llu total persistent congestion events.\n\n", (unsigned long long)TotalPerCongEvents);
+
+    printf("  %llu total packets sent.\n", (unsigned long long)TotalSentPackets);
+    printf("  %llu total packets lost.\n\n", (unsigned long long)TotalLostPackets);
+
+    printf("  %llu total packets received.\n", (unsigned long long)TotalReceivedPackets);
+    printf("  %llu total packets dropped.\n", (unsigned long long)TotalDroppedPackets);
+}
+
+//
+// Replays a connection's flow events and prints a sample every resolution
+// interval.
+//
+void
+CommandConnTput(
+    void
+    )
+{
+    const RING_CONN* Conn = (const RING_CONN*)RingObjectSetGetId(&Conns, Cmd.Id);
+    if (Conn == NULL) {
+        printf("No connection with ID %u\n", Cmd.Id);
+        return;
+    }
+
+    if (Cmd.FormatCSV) {
+        printf("ms,TxMbps,RxMbps,RttUs,CongEvents,Lost,InFlight,Cwnd,TxBufBytes,FlowAvailConn,SsThresh\n");
+    } else {
+        printf("  Time      TX      RX      Rtt   Cong   Lost    InFlight        Cwnd       TxBuf         CFC    SsThresh\n");
+        printf("  (ms)  (mbps)  (mbps)     (us)  Event  (pkt)         (B)         (B)         (B)         (B)         (B)\n");
+    }
+
+    const uint64_t EndTimeNs =
+        Conn->Obj.DestroyedTimeNs != 0 ? Conn->Obj.DestroyedTimeNs : Trace.StopTimeNs;
+    uint64_t BytesSent = 0, BytesRecv = 0, LastBytesSent = 0, LastBytesRecv = 0;
+    uint64_t ConnFlowAvailable = 0, PostedBytes = 0;
+    uint32_t BytesInFlight = 0, CongestionWindow = 0, SlowStartThreshold = 0, SmoothedRtt = 0;
+    uint32_t CongestionEvents = 0, LostPackets = 0;
+    uint64_t LastSampleNs = 0; // The first flow event, as earlier ones may be overwritten.
+    uint64_t Count = 0;
+
+    for (uint64_t i = 0; i < Trace.EventCount && Count < Cmd.Top; ++i) {
+        const RING_EVENT* Event = &Trace.Events[i];
+        if (Event->TimeNs < Conn->Obj.FirstTimeNs || Event->TimeNs > EndTimeNs ||
+            Event->Type == NULL || RingEventGetObject(Event) != Conn->Obj.Base.Ptr) {
+            continue;
+        }
+
+        RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+        const uint8_t ArgCount = RingEventGetArgs(Event, Args);
+#define ARG(i) (i < ArgCount ? Args[i].Value : 0)
+
+        switch (Event->Type->Known) {
+        case RingEventConnOutFlowStats:
+            BytesSent = ARG(1);
+            BytesInFlight = (uint32_t)ARG(2);
+            CongestionWindow = (uint32_t)ARG(4);
+            SlowStartThreshold = (uint32_t)ARG(5);
+            ConnFlowAvailable = ARG(6);
+            PostedBytes = ARG(8);
+            SmoothedRtt = (uint32_t)ARG(9);
+            break;
+        case RingEventConnInFlowStats:
+            BytesRecv = ARG(1);
+            break;
+        case RingEventConnCongestion:
+            CongestionEvents++;
+            continue;
+        case RingEventConnPacketLost:
+            LostPackets++;
+            continue;
+        default:
+            continue;
+        }
+
+#undef ARG
+
+        if (LastSampleNs == 0) {
+            LastSampleNs = Event->TimeNs;
+            LastBytesSent = BytesSent;
+            LastBytesRecv = BytesRecv;
+            continue;
+        }
+        if (Event->TimeNs < LastSampleNs + Cmd.ResolutionNs) {
+            continue;
+        }
+
+        const uint64_t ElapsedUs = (Event->TimeNs - LastSampleNs) / NS_PER_US;
+        const uint64_t TxMbps = ElapsedUs == 0 ? 0 : (8 * (BytesSent - LastBytesSent)) / ElapsedUs;
+        const uint64_t RxMbps = ElapsedUs == 0 ? 0 : (8 * (BytesRecv - LastBytesRecv)) / ElapsedUs;
+        printf(
+            Cmd.FormatCSV ?
+                "%llu,%llu,%llu,%u,%u,%u,%u,%u,%llu,%llu,%u\n" :
+                "%6llu %7llu %7llu %8u %6u %6u %11u %11u %11llu %11llu %11u\n",
+            (unsigned long long)((Event->TimeNs - Conn->Obj.FirstTimeNs) / NS_PER_MS),
+            (unsigned long long)TxMbps,
+            (unsigned long long)RxMbps,
+            SmoothedRtt,
+            CongestionEvents,
+            LostPackets,
+            BytesInFlight,
+            CongestionWindow,
+            (unsigned long long)PostedBytes,
+            (unsigned long long)ConnFlowAvailable,
+            SlowStartThreshold);
+        Count++;
+
+        LastSampleNs = Event->TimeNs;
+        LastBytesSent = BytesSent;
+        LastBytesRecv = BytesRecv;
+        CongestionEvents = 0;
+        LostPackets = 0;
+    }
+}
+
+//
+// Replays a worker's events and prints its load every resolution interval.
+//
+void
+CommandWorkerQueue(
+    void
+    )
+{
+    const RING_WORKER* Worker = (const RING_WORKER*)RingObjectSetGetId(&Workers, Cmd.Id);
+    if (Worker == NULL) {
+        printf("No worker with ID %u\n", Cmd.Id);
+        return;
+    }
+
+    if (Cmd.FormatCSV) {
+        printf("ms,Active(%%),Operations,ConnsProcessed,AvgQueueDelay(us),MaxQueueDelay(us)\n");
+    } else {
+        printf("       Time  Active  Operations  Conns  QueueDelay  MaxDelay\n");
+        printf("       (ms)     (%%)                          (us)      (us)\n");
+    }
+
+    const uint64_t StartTimeNs = RingWorkerFirstTimeNs(Worker);
+    const uint64_t EndTimeNs =
+        Worker->Obj.DestroyedTimeNs != 0 ? Worker->Obj.DestroyedTimeNs : Trace.StopTimeNs;
+    BOOLEAN IsActive = FALSE;
+    uint64_t ActiveStartNs = 0, ActiveNs = 0;
+
+    //
+    // The worker starts out active, so if the first state change seen is to
+    // inactive, it was already active when the replay starts.
+    //
+    for (uint64_t i = 0; i < Trace.EventCount; ++i) {
+        const RING_EVENT* Event = &Trace.Events[i];
+        RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+        if (Event->TimeNs < StartTimeNs || Event->Type == NULL ||
+            (Event->Type->Known != RingEventWorkerStart &&
+             Event->Type->Known != RingEventWorkerActivityStateUpdated) ||
+            RingEventGetArgs(Event, Args) == 0 || Args[0].Value != Worker->Obj.Base.Ptr) {
+            continue;
+        }
+        if (Event->Type->Known == RingEventWorkerActivityStateUpdated && Args[1].Value == 0) {
+            IsActive = TRUE;
+            ActiveStartNs = StartTimeNs;
+        }
+        break;
+    }
+    uint64_t Operations = 0, ConnsProcessed = 0;
+    uint64_t QueueDelaySumUs = 0, QueueDelayCount = 0, QueueDelayMaxUs = 0;
+    uint64_t SampleStartNs = StartTimeNs;
+    uint64_t Count = 0;
+
+    for (uint64_t i = 0; i < Trace.EventCount && Count < Cmd.Top; ++i) {
+        const RING_EVENT* Event = &Trace.Events[i];
+        if (Event->TimeNs < StartTimeNs || Event->TimeNs > EndTimeNs || Event->Type == NULL) {
+            continue;
+        }
+
+        if (Event->TimeNs >= SampleStartNs + Cmd.ResolutionNs) {
+            if (IsActive) {
+                ActiveNs += Event->TimeNs - ActiveStartNs;
+                ActiveStartNs = Event->TimeNs;
+            }
+            const uint64_t ElapsedNs = Event->TimeNs - SampleStartNs;
+            printf(
+                Cmd.FormatCSV ?
+                    "%llu,%llu,%llu,%llu,%llu,%llu\n" :
+                    "%11llu %6llu%% %11llu %6llu %11llu %9llu\n",
+                (unsigned long long)((Event->TimeNs - StartTimeNs) / NS_PER_MS),
+                (unsigned long long)((100 * ActiveNs) / ElapsedNs),
+                (unsigned long long)Operations,
+                (unsigned long long)ConnsProcessed,
+                (unsigned long long)(QueueDelayCount == 0 ? 0 : QueueDelaySumUs / QueueDelayCount),
+                (unsigned long long)QueueDelayMaxUs);
+            Count++;
+            SampleStartNs = Event->TimeNs;
+            ActiveNs = Operations = ConnsProcessed = 0;
+            QueueDelaySumUs = QueueDelayCount = QueueDelayMaxUs = 0;
+        }
+
+        RING_ARG Args[QUIC_TRACE_RING_MAX_ARGS];
+        switch (Event->Type->Known) {
+        case RingEventWorkerStart:
+            if (RingEventGetArgs(Event, Args) >= 1 && Args[0].Value == Worker->Obj.Base.Ptr && !IsActive) {
+                IsActive = TRUE;
+                ActiveStartNs = Event->TimeNs;
+            }
+            break;
+        case RingEventWorkerActivityStateUpdated:
+        case RingEventWorkerQueueDelayUpdated: {
+            const uint8_t ArgCount = RingEventGetArgs(Event, Args);
+            if (ArgCount < 2 || Args[0].Value != Worker->Obj.Base.Ptr) {
+                break;
+            }
+            if (Event->Type->Known == RingEventWorkerQueueDelayUpdated) {
+                QueueDelaySumUs += Args[1].Value;
+                QueueDelayCount++;
+                if (Args[1].Value > QueueDelayMaxUs) {
+                    QueueDelayMaxUs = Args[1].Value;
+                }
+            } else if (Args[1].Value != 0 && !IsActive) {
+                IsActive = TRUE;
+                ActiveStartNs = Event->TimeNs;
+            } else if (Args[1].Value == 0 && IsActive) {
+                IsActive = FALSE;
+                ActiveNs += Event->TimeNs - ActiveStartNs;
+            }
+            break;
+        }
+        case RingEventConnExecOper:
+        case RingEventConnExecApiOper:
+        case RingEventConnExecTimerOper:
+            if (Event->ThreadId == Worker->ThreadId) {
+                Operations++;
+            }
+            break;
+        case RingEventConnScheduleState:
+            if (Event->ThreadId == Worker->ThreadId &&
+                RingEventGetArgs(Event, Args) >= 2 &&
+                Args[1].Value == RING_SCHEDULE_PROCESSING) {
+                ConnsProcessed++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+//
+// Writes the worker time per operation type as collapsed stacks
+// ("frame;frame;... value", in microseconds), the input format of
+// flamegraph.pl and speedscope.
+//
+void
+CommandFlame(
+    void
+    )
+{
+    for (const RING_OBJECT* Obj = Workers.First; Obj != NULL; Obj = Obj->Next) {
+        if (Cmd.Id != 0 && Obj->Base.Id != Cmd.Id) {
+            continue;
+        }
+        const RING_WORKER* Worker = (const RING_WORKER*)Obj;
+        uint64_t OperNs = 0;
+        for (uint32_t i = RING_OPER_NONE + 1; i < RING_OPER_COUNT; ++i) {
+            if (Worker->OperNs[i] / NS_PER_US != 0) {
+                printf("worker#%u;%s %llu\n", Obj->Base.Id, RingOperName(i),
+                    (unsigned long long)(Worker->OperNs[i] / NS_PER_US));
+            }
+            OperNs += Worker->OperNs[i];
+        }
+        if (Worker->ActiveNs > OperNs && (Worker->ActiveNs - OperNs) / NS_PER_US != 0) {
+            printf("worker#%u;%s %llu\n", Obj->Base.Id, RingOperName(RING_OPER_NONE),
+                (unsigned long long)((Worker->ActiveNs - OperNs) / NS_PER_US));
+        }
+    }
+}